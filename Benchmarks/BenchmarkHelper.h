@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// 헤드리스 벤치마크 공용, 에디터 버튼과 같은 방식(1, 2, 4 ... 최대 스레드)으로 잼
+// 반복해서 잰 값의 중앙값을 씀
+typedef std::chrono::steady_clock BenchmarkClock;
+typedef std::chrono::duration<float, std::milli> BenchmarkMilliseconds;
+
+static inline uint32_t GetBenchmarkArgument(const int argc, const char* const* const argv, const int index, const uint32_t defaultValue)
+{
+	if (index < argc)
+	{
+		return static_cast<uint32_t>(strtoul(argv[index], nullptr, 10));
+	}
+
+	return defaultValue;
+}
+
+static inline std::vector<uint32_t> MakeBenchmarkThreadCounts(const uint32_t maxThreadCount)
+{
+	std::vector<uint32_t> threadCounts;
+
+	for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+
+	threadCounts.push_back(maxThreadCount);
+
+	return threadCounts;
+}
+
+template<typename FUNC>
+static float MeasureMedianMs(const uint32_t repeatCount, FUNC func)
+{
+	std::vector<float> times;
+	times.reserve(repeatCount);
+
+	for (uint32_t i = 0; i < repeatCount; ++i)
+	{
+		const BenchmarkClock::time_point start = BenchmarkClock::now();
+
+		func();
+
+		const BenchmarkClock::time_point end = BenchmarkClock::now();
+
+		times.push_back(BenchmarkMilliseconds(end - start).count());
+	}
+
+	std::sort(times.begin(), times.end());
+
+	return times[times.size() / 2];
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "BenchmarkHelper.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "Renderer/RHI/RHITypes.h"
+#include "Resources/BlockCompression.h"
+
+// BC 형식마다 합성 이미지를 압축하고 풀어서 PSNR과 처리량을 잼
+// 처리량은 원본 RGBA8 바이트 기준, 한 스레드
+// 사용법: BlockCompressionBenchmark [이미지 크기] [반복 수]
+enum
+{
+	DEFAULT_IMAGE_SIZE = 1024,
+	DEFAULT_REPEAT_COUNT = 3,
+
+	RGBA_BYTES_PER_PIXEL = 4,
+
+	// 손실이 없을 때 표시용 상한
+	LOSSLESS_PSNR = 99
+};
+
+typedef void (*BlockFunction)(const uint8_t* const, uint8_t* const);
+
+enum class EImage : uint8_t
+{
+	OPAQUE_COLOR,
+	ALPHA_COLOR,
+	NORMAL_MAP
+};
+
+struct FormatCase
+{
+	const char* name;
+	RHI::EFormat format;
+	BlockFunction encode;
+	BlockFunction decode;
+	EImage eImage;
+
+	// BC1은 알파를, BC5는 B와 알파를 담지 않음
+	uint32_t compareChannelCount;
+};
+
+static uint8_t ToByte(const float value)
+{
+	const float clamped = value < 0.f ? 0.f : (value > 1.f ? 1.f : value);
+
+	return static_cast<uint8_t>(clamped * 255.f + 0.5f);
+}
+
+// 부드러운 그라디언트, 줄무늬, 잡음, 가장자리를 섞은 이미지
+static void MakeImage(const EImage eImage, const uint32_t size, std::vector<uint8_t>& outPixels)
+{
+	outPixels.resize(static_cast<size_t>(size) * size * RGBA_BYTES_PER_PIXEL);
+
+	uint32_t seed = 12345;
+
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			const float u = static_cast<float>(x) / size;
+			const float v = static_cast<float>(y) / size;
+
+			seed = seed * 1664525u + 1013904223u;
+			const float noise = (static_cast<float>(seed >> 24) / 255.f - 0.5f) * 0.06f;
+
+			uint8_t* const pPixel = &outPixels[(static_cast<size_t>(y) * size + x) * RGBA_BYTES_PER_PIXEL];
+
+			if (eImage == EImage::NORMAL_MAP)
+			{
+				// 잔물결 높이에 잡음을 더한 노멀을 [0, 1]로
+				const float dx = 0.6f * cosf(u * 250.f) * sinf(v * 170.f) + noise * 4.f;
+				const float dy = 0.6f * sinf(u * 250.f) * cosf(v * 170.f) - noise * 4.f;
+				const float invLength = 1.f / sqrtf(dx * dx + dy * dy + 1.f);
+
+				pPixel[0] = ToByte(-dx * invLength * 0.5f + 0.5f);
+				pPixel[1] = ToByte(-dy * invLength * 0.5f + 0.5f);
+				pPixel[2] = ToByte(invLength * 0.5f + 0.5f);
+				pPixel[3] = 255;
+
+				continue;
+			}
+
+			const bool bEdge = ((x / 37) + (y / 53)) % 2 == 0;
+
+			pPixel[0] = ToByte(u + noise);
+			pPixel[1] = ToByte(0.5f + 0.4f * sinf(v * 31.f) + noise);
+			pPixel[2] = ToByte(bEdge ? 0.8f - 0.3f * u : 0.2f + 0.3f * v);
+			pPixel[3] = eImage == EImage::ALPHA_COLOR ? ToByte(0.5f + 0.5f * sinf((u + v) * 9.f)) : 255;
+		}
+	}
+}
+
+static void ReadBlock(const uint8_t* const pImage, const uint32_t size, const uint32_t blockX, const uint32_t blockY, uint8_t* const pOutPixels)
+{
+	const size_t rowPitch = static_cast<size_t>(size) * RGBA_BYTES_PER_PIXEL;
+	const uint8_t* pRow = pImage + static_cast<size_t>(blockY) * 4 * rowPitch + static_cast<size_t>(blockX) * 4 * RGBA_BYTES_PER_PIXEL;
+
+	for (uint32_t y = 0; y < 4; ++y)
+	{
+		memcpy(pOutPixels + y * 4 * RGBA_BYTES_PER_PIXEL, pRow, 4 * RGBA_BYTES_PER_PIXEL);
+
+		pRow += rowPitch;
+	}
+}
+
+static void WriteBlock(const uint8_t* const pPixels, const uint32_t size, const uint32_t blockX, const uint32_t blockY, uint8_t* const pImage)
+{
+	const size_t rowPitch = static_cast<size_t>(size) * RGBA_BYTES_PER_PIXEL;
+	uint8_t* pRow = pImage + static_cast<size_t>(blockY) * 4 * rowPitch + static_cast<size_t>(blockX) * 4 * RGBA_BYTES_PER_PIXEL;
+
+	for (uint32_t y = 0; y < 4; ++y)
+	{
+		memcpy(pRow, pPixels + y * 4 * RGBA_BYTES_PER_PIXEL, 4 * RGBA_BYTES_PER_PIXEL);
+
+		pRow += rowPitch;
+	}
+}
+
+static float ComputePSNR(const std::vector<uint8_t>& source, const std::vector<uint8_t>& decoded, const uint32_t channelCount)
+{
+	uint64_t squaredErrorSum = 0;
+	uint64_t sampleCount = 0;
+
+	for (size_t i = 0; i < source.size(); i += RGBA_BYTES_PER_PIXEL)
+	{
+		for (uint32_t channel = 0; channel < channelCount; ++channel)
+		{
+			const int32_t diff = static_cast<int32_t>(source[i + channel]) - static_cast<int32_t>(decoded[i + channel]);
+
+			squaredErrorSum += static_cast<uint64_t>(diff * diff);
+			++sampleCount;
+		}
+	}
+
+	if (squaredErrorSum == 0)
+	{
+		return static_cast<float>(LOSSLESS_PSNR);
+	}
+
+	const double mse = static_cast<double>(squaredErrorSum) / static_cast<double>(sampleCount);
+
+	return static_cast<float>(10.0 * log10(255.0 * 255.0 / mse));
+}
+
+int main(int argc, char** argv)
+{
+	// 블록 단위라 4의 배수로 맞춤
+	const uint32_t imageSize = (GetBenchmarkArgument(argc, argv, 1, DEFAULT_IMAGE_SIZE) + 3) & ~3u;
+	const uint32_t repeatCount = GetBenchmarkArgument(argc, argv, 2, DEFAULT_REPEAT_COUNT);
+
+	if (imageSize == 0 || repeatCount == 0)
+	{
+		return 1;
+	}
+
+	const FormatCase formatCases[] =
+	{
+		{ "BC1", RHI::EFormat::BC1_UNORM, EncodeBC1Block, DecodeBC1Block, EImage::OPAQUE_COLOR, 3 },
+		{ "BC3", RHI::EFormat::BC3_UNORM, EncodeBC3Block, DecodeBC3Block, EImage::ALPHA_COLOR, 4 },
+		{ "BC5", RHI::EFormat::BC5_UNORM, EncodeBC5Block, DecodeBC5Block, EImage::NORMAL_MAP, 2 },
+		{ "BC7", RHI::EFormat::BC7_UNORM, EncodeBC7Block, DecodeBC7Block, EImage::ALPHA_COLOR, 4 }
+	};
+
+	const uint32_t blockCount = imageSize / 4;
+	const float sourceMegabytes = static_cast<float>(static_cast<uint64_t>(imageSize) * imageSize * RGBA_BYTES_PER_PIXEL) / (1024.f * 1024.f);
+
+	printf("image: %ux%u RGBA8 / repeat: %u\n", imageSize, imageSize, repeatCount);
+	printf("format, channels, PSNR dB, encode MB/s, decode MB/s, ratio\n");
+
+	std::vector<uint8_t> source;
+	std::vector<uint8_t> decoded(static_cast<size_t>(imageSize) * imageSize * RGBA_BYTES_PER_PIXEL);
+	std::vector<uint8_t> blocks;
+
+	bool bValid = true;
+
+	for (const FormatCase& formatCase : formatCases)
+	{
+		const uint32_t blockBytes = RHI::GetFormatByteSize(formatCase.format);
+
+		MakeImage(formatCase.eImage, imageSize, source);
+		blocks.resize(static_cast<size_t>(blockCount) * blockCount * blockBytes);
+
+		const float encodeMs = MeasureMedianMs(repeatCount, [&]()
+			{
+				uint8_t pixels[BLOCK_RGBA_BYTE_SIZE];
+
+				for (uint32_t blockY = 0; blockY < blockCount; ++blockY)
+				{
+					for (uint32_t blockX = 0; blockX < blockCount; ++blockX)
+					{
+						ReadBlock(source.data(), imageSize, blockX, blockY, pixels);
+						formatCase.encode(pixels, &blocks[(static_cast<size_t>(blockY) * blockCount + blockX) * blockBytes]);
+					}
+				}
+			});
+
+		const float decodeMs = MeasureMedianMs(repeatCount, [&]()
+			{
+				uint8_t pixels[BLOCK_RGBA_BYTE_SIZE];
+
+				for (uint32_t blockY = 0; blockY < blockCount; ++blockY)
+				{
+					for (uint32_t blockX = 0; blockX < blockCount; ++blockX)
+					{
+						formatCase.decode(&blocks[(static_cast<size_t>(blockY) * blockCount + blockX) * blockBytes], pixels);
+						WriteBlock(pixels, imageSize, blockX, blockY, decoded.data());
+					}
+				}
+			});
+
+		const float psnr = ComputePSNR(source, decoded, formatCase.compareChannelCount);
+
+		// 합성 이미지에서 이보다 낮으면 인코더가 망가진 것
+		bValid = bValid && psnr > 25.f;
+
+		printf(
+			"%s, %u, %.2f, %.1f, %.1f, %.1f:1\n",
+			formatCase.name,
+			formatCase.compareChannelCount,
+			psnr,
+			encodeMs > 0.f ? sourceMegabytes * 1000.f / encodeMs : 0.f,
+			decodeMs > 0.f ? sourceMegabytes * 1000.f / decodeMs : 0.f,
+			static_cast<float>(source.size()) / static_cast<float>(blocks.size())
+		);
+	}
+
+	return bValid ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "BenchmarkHelper.h"
+
+#include <cmath>
+#include <cstdio>
+
+#include "Resources/MeshOptimizer.h"
+
+// 합성 메쉬를 OptimizeMesh로 처리하고 정점 캐시 ACMR, ATVR과 처리 시간을 잼
+// 캐시는 VERTEX_CACHE_SIZE 크기의 FIFO로 흉내냄
+// 사용법: MeshOptimizerBenchmark [격자 한 변의 사각형 수] [반복 수]
+enum
+{
+	DEFAULT_GRID_SIZE = 256,
+	DEFAULT_REPEAT_COUNT = 3
+};
+
+enum class EMesh : uint8_t
+{
+	// 행 순서로 그리는 격자
+	GRID,
+
+	// 삼각형 순서를 섞은 격자, 내보내기 도구가 순서를 망가뜨린 경우
+	SHUFFLED_GRID,
+
+	// 극과 이음매에 정점이 겹친 UV 구
+	SPHERE
+};
+
+static void MakeGrid(const uint32_t gridSize, std::vector<Vertex::PosNormalUV>& outVertices, std::vector<uint32_t>& outIndices)
+{
+	const uint32_t rowVertexCount = gridSize + 1;
+
+	outVertices.resize(static_cast<size_t>(rowVertexCount) * rowVertexCount);
+	outIndices.clear();
+	outIndices.reserve(static_cast<size_t>(gridSize) * gridSize * 6);
+
+	for (uint32_t y = 0; y < rowVertexCount; ++y)
+	{
+		for (uint32_t x = 0; x < rowVertexCount; ++x)
+		{
+			Vertex::PosNormalUV& vertex = outVertices[y * rowVertexCount + x];
+
+			vertex.pos = Vector3(static_cast<float>(x), 0.f, static_cast<float>(y));
+			vertex.normal = Vector3(0.f, 1.f, 0.f);
+			vertex.uv = Vector2(static_cast<float>(x) / gridSize, static_cast<float>(y) / gridSize);
+		}
+	}
+
+	for (uint32_t y = 0; y < gridSize; ++y)
+	{
+		for (uint32_t x = 0; x < gridSize; ++x)
+		{
+			const uint32_t topLeft = y * rowVertexCount + x;
+			const uint32_t bottomLeft = topLeft + rowVertexCount;
+
+			outIndices.insert(outIndices.end(), { topLeft, bottomLeft, topLeft + 1, topLeft + 1, bottomLeft, bottomLeft + 1 });
+		}
+	}
+}
+
+static void ShuffleTriangles(std::vector<uint32_t>& inOutIndices)
+{
+	const uint32_t triangleCount = static_cast<uint32_t>(inOutIndices.size() / 3);
+
+	uint32_t seed = 12345;
+
+	for (uint32_t i = triangleCount - 1; i > 0; --i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+
+		const uint32_t j = seed % (i + 1);
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			std::swap(inOutIndices[i * 3 + k], inOutIndices[j * 3 + k]);
+		}
+	}
+}
+
+static void MakeSphere(const uint32_t ringCount, std::vector<Vertex::PosNormalUV>& outVertices, std::vector<uint32_t>& outIndices)
+{
+	constexpr float PI = 3.14159265f;
+
+	const uint32_t segmentCount = ringCount * 2;
+	const uint32_t rowVertexCount = segmentCount + 1;
+
+	outVertices.resize(static_cast<size_t>(ringCount + 1) * rowVertexCount);
+	outIndices.clear();
+	outIndices.reserve(static_cast<size_t>(ringCount) * segmentCount * 6);
+
+	for (uint32_t ring = 0; ring <= ringCount; ++ring)
+	{
+		const float v = static_cast<float>(ring) / ringCount;
+		const float theta = v * PI;
+
+		for (uint32_t segment = 0; segment <= segmentCount; ++segment)
+		{
+			const float u = static_cast<float>(segment) / segmentCount;
+			const float phi = u * 2.f * PI;
+
+			Vertex::PosNormalUV& vertex = outVertices[ring * rowVertexCount + segment];
+
+			vertex.normal = Vector3(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+			vertex.pos = vertex.normal;
+			vertex.uv = Vector2(u, v);
+		}
+	}
+
+	for (uint32_t ring = 0; ring < ringCount; ++ring)
+	{
+		for (uint32_t segment = 0; segment < segmentCount; ++segment)
+		{
+			const uint32_t topLeft = ring * rowVertexCount + segment;
+			const uint32_t bottomLeft = topLeft + rowVertexCount;
+
+			outIndices.insert(outIndices.end(), { topLeft, bottomLeft, topLeft + 1, topLeft + 1, bottomLeft, bottomLeft + 1 });
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t gridSize = GetBenchmarkArgument(argc, argv, 1, DEFAULT_GRID_SIZE);
+	const uint32_t repeatCount = GetBenchmarkArgument(argc, argv, 2, DEFAULT_REPEAT_COUNT);
+
+	if (gridSize < 2 || repeatCount == 0)
+	{
+		return 1;
+	}
+
+	const struct
+	{
+		const char* name;
+		EMesh eMesh;
+	} meshCases[] =
+	{
+		{ "grid", EMesh::GRID },
+		{ "shuffled_grid", EMesh::SHUFFLED_GRID },
+		{ "sphere", EMesh::SPHERE }
+	};
+
+	printf("grid: %ux%u quads / cache: %u / repeat: %u\n", gridSize, gridSize, VERTEX_CACHE_SIZE, repeatCount);
+	printf("mesh, triangles, ACMR before, ACMR after, ATVR before, ATVR after, clusters, degenerate, ms\n");
+
+	std::vector<Vertex::PosNormalUV> sourceVertices;
+	std::vector<uint32_t> sourceIndices;
+
+	bool bValid = true;
+
+	for (const auto& meshCase : meshCases)
+	{
+		if (meshCase.eMesh == EMesh::SPHERE)
+		{
+			// 격자의 절반쯤 되는 삼각형 수
+			MakeSphere(gridSize / 2 + 1, sourceVertices, sourceIndices);
+		}
+		else
+		{
+			MakeGrid(gridSize, sourceVertices, sourceIndices);
+		}
+
+		if (meshCase.eMesh == EMesh::SHUFFLED_GRID)
+		{
+			ShuffleTriangles(sourceIndices);
+		}
+
+		MeshOptimizeStats stats = {};
+
+		const float optimizeMs = MeasureMedianMs(repeatCount, [&]()
+			{
+				std::vector<Vertex::PosNormalUV> vertices = sourceVertices;
+				std::vector<uint32_t> indices = sourceIndices;
+
+				OptimizeMesh(vertices, indices, stats);
+			});
+
+		// 넓이가 없어진 삼각형 말고는 잃지 않아야 하고 캐시 효율이 나빠지면 안 됨
+		bValid = bValid
+			&& stats.after.triangleCount + stats.degenerateTriangleCount == stats.before.triangleCount
+			&& GetACMR(stats.after) <= GetACMR(stats.before);
+
+		printf(
+			"%s, %u, %.3f, %.3f, %.3f, %.3f, %u, %u, %.2f\n",
+			meshCase.name,
+			stats.before.triangleCount,
+			GetACMR(stats.before),
+			GetACMR(stats.after),
+			GetATVR(stats.before),
+			GetATVR(stats.after),
+			stats.clusterCount,
+			stats.degenerateTriangleCount,
+			optimizeMs
+		);
+	}
+
+	return bValid ? 0 : 1;
+}
\ No newline at end of file
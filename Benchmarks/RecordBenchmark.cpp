@@ -0,0 +1,214 @@
+#include "BenchmarkHelper.h"
+
+#include <cstdio>
+
+#include "Core/JobSystem.h"
+#include "Renderer/RHI/NullDevice.h"
+
+// Renderer::RunRecordBenchmark의 헤드리스 버전
+// 메쉬와 머티리얼 몇 개를 돌려 쓰는 그리기를 Renderer::recordDraw와 같은 순서로 기록
+// 사용법: RecordBenchmark [그리기 수] [반복 수]
+enum
+{
+	DEFAULT_DRAW_COUNT = 50000,
+	DEFAULT_REPEAT_COUNT = 5,
+
+	MESH_COUNT = 16,
+	MATERIAL_COUNT = 8,
+	MIN_DRAWS_PER_COMMAND_LIST = 64
+};
+
+struct BenchmarkDraw
+{
+	uint32_t mesh;
+	uint32_t material;
+	float worldMatrix[16];
+};
+
+struct BenchmarkScene
+{
+	RHI::BufferHandle vertexBuffers[MESH_COUNT];
+	RHI::BufferHandle indexBuffers[MESH_COUNT];
+	RHI::TextureHandle textures[MATERIAL_COUNT];
+	RHI::BufferHandle worldMatrixBuffer;
+	RHI::VertexShaderHandle vertexShader;
+	RHI::PixelShaderHandle pixelShader;
+	RHI::InputLayoutHandle inputLayout;
+	RHI::RasterizerStateHandle rasterizerState;
+	RHI::DepthStencilStateHandle depthStencilState;
+	RHI::SamplerStateHandle samplerState;
+};
+
+static BenchmarkScene CreateBenchmarkScene(RHI::Device& device)
+{
+	const uint8_t bytecode[] = { 'v', 's' };
+
+	BenchmarkScene scene;
+
+	RHI::BufferDesc bufferDesc = {};
+	bufferDesc.usage = RHI::EUsage::DEFAULT;
+	bufferDesc.byteWidth = 4096;
+
+	for (uint32_t i = 0; i < MESH_COUNT; ++i)
+	{
+		bufferDesc.bindFlags = RHI::BIND_VERTEX_BUFFER;
+		scene.vertexBuffers[i] = device.CreateBuffer(bufferDesc, nullptr);
+
+		bufferDesc.bindFlags = RHI::BIND_INDEX_BUFFER;
+		scene.indexBuffers[i] = device.CreateBuffer(bufferDesc, nullptr);
+	}
+
+	RHI::TextureDesc textureDesc = {};
+	textureDesc.width = 64;
+	textureDesc.height = 64;
+	textureDesc.mipLevels = 1;
+	textureDesc.arraySize = 1;
+	textureDesc.sampleCount = 1;
+	textureDesc.bindFlags = RHI::BIND_SHADER_RESOURCE;
+	textureDesc.format = RHI::EFormat::R8G8B8A8_UNORM;
+	textureDesc.usage = RHI::EUsage::DEFAULT;
+
+	for (uint32_t i = 0; i < MATERIAL_COUNT; ++i)
+	{
+		scene.textures[i] = device.CreateTexture(textureDesc, nullptr);
+	}
+
+	bufferDesc.byteWidth = sizeof(float) * 16;
+	bufferDesc.bindFlags = RHI::BIND_CONSTANT_BUFFER;
+	scene.worldMatrixBuffer = device.CreateBuffer(bufferDesc, nullptr);
+
+	scene.vertexShader = device.CreateVertexShader(bytecode, sizeof(bytecode));
+	scene.pixelShader = device.CreatePixelShader(bytecode, sizeof(bytecode));
+
+	const RHI::InputElementDesc element = { "POSITION", 0, RHI::EFormat::R32G32B32_FLOAT, 0, 0 };
+	scene.inputLayout = device.CreateInputLayout(&element, 1, bytecode, sizeof(bytecode));
+
+	scene.rasterizerState = device.CreateRasterizerState({ RHI::EFillMode::SOLID, RHI::ECullMode::BACK, true });
+	scene.depthStencilState = device.CreateDepthStencilState({ true, true, RHI::EComparison::LESS_EQUAL });
+	scene.samplerState = device.CreateSamplerState({ RHI::EFilter::LINEAR, RHI::EAddressMode::WRAP, 16.f });
+
+	return scene;
+}
+
+static void RecordChunk(RHI::CommandList& commandList, const RHI::Device& device, const BenchmarkScene& scene, const BenchmarkDraw* const pDraws, const uint32_t begin, const uint32_t end)
+{
+	const RHI::Viewport viewport = { 0.f, 0.f, 1280.f, 720.f, 0.f, 1.f };
+
+	// 목록마다 상태를 처음부터 기록
+	commandList.SetViewport(viewport);
+	commandList.SetRenderTarget(device.GetBackBuffer(), { 0 });
+	commandList.SetPrimitiveTopology(RHI::EPrimitiveTopology::TRIANGLE_LIST);
+	commandList.SetInputLayout(scene.inputLayout);
+	commandList.SetVertexShader(scene.vertexShader);
+	commandList.SetVSConstantBuffer(1, scene.worldMatrixBuffer);
+
+	uint32_t boundMesh = MESH_COUNT;
+	uint32_t boundMaterial = MATERIAL_COUNT;
+
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const BenchmarkDraw& draw = pDraws[i];
+
+		if (draw.mesh != boundMesh)
+		{
+			commandList.SetVertexBuffer(0, scene.vertexBuffers[draw.mesh], sizeof(float) * 8, 0);
+			commandList.SetIndexBuffer(scene.indexBuffers[draw.mesh], RHI::EFormat::R16_UINT, 0);
+
+			boundMesh = draw.mesh;
+		}
+
+		if (draw.material != boundMaterial)
+		{
+			commandList.SetPixelShader(scene.pixelShader);
+			commandList.SetPSTexture(0, scene.textures[draw.material]);
+			commandList.SetPSSampler(0, scene.samplerState);
+			commandList.SetRasterizerState(scene.rasterizerState);
+			commandList.SetDepthStencilState(scene.depthStencilState);
+
+			boundMaterial = draw.material;
+		}
+
+		commandList.UpdateBuffer(scene.worldMatrixBuffer, draw.worldMatrix, sizeof(draw.worldMatrix));
+		commandList.DrawIndexed(36, 0, 0);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const uint32_t drawCount = GetBenchmarkArgument(argc, argv, 1, DEFAULT_DRAW_COUNT);
+	const uint32_t repeatCount = GetBenchmarkArgument(argc, argv, 2, DEFAULT_REPEAT_COUNT);
+
+	JobSystem::Initialize();
+
+	JobSystem& jobSystem = JobSystem::GetInstance();
+	const uint32_t maxThreadCount = jobSystem.GetWorkerCount() + 1;
+
+	RHI::NullDevice device(1280, 720);
+	device.SetRecording(false);
+
+	const BenchmarkScene scene = CreateBenchmarkScene(device);
+
+	// 머티리얼 순으로 정렬된 큐처럼 같은 조합이 이어지게 배치
+	std::vector<BenchmarkDraw> draws(drawCount);
+
+	for (uint32_t i = 0; i < drawCount; ++i)
+	{
+		BenchmarkDraw& draw = draws[i];
+		draw.material = static_cast<uint32_t>(static_cast<uint64_t>(i) * MATERIAL_COUNT / drawCount);
+		draw.mesh = (i / 4) % MESH_COUNT;
+
+		for (uint32_t j = 0; j < 16; ++j)
+		{
+			draw.worldMatrix[j] = j % 5 == 0 ? 1.f : 0.f;
+		}
+
+		draw.worldMatrix[12] = static_cast<float>(i % 256);
+		draw.worldMatrix[14] = static_cast<float>(i / 256);
+	}
+
+	std::vector<RHI::CommandList> commandLists(maxThreadCount);
+
+	printf("draws: %u / repeat: %u / max threads: %u\n", drawCount, repeatCount, maxThreadCount);
+	printf("threads, lists, record ms, submit ms, speedup\n");
+
+	float singleThreadMs = 0.f;
+
+	for (const uint32_t threadCount : MakeBenchmarkThreadCounts(maxThreadCount))
+	{
+		const uint32_t maxListCount = (drawCount + MIN_DRAWS_PER_COMMAND_LIST - 1) / MIN_DRAWS_PER_COMMAND_LIST;
+		const uint32_t listCount = threadCount < maxListCount ? threadCount : maxListCount;
+
+		const float recordMs = MeasureMedianMs(repeatCount, [&]()
+			{
+				for (uint32_t i = 0; i < listCount; ++i)
+				{
+					commandLists[i].Reset();
+				}
+
+				jobSystem.ParallelFor(drawCount, listCount, [&](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
+					{
+						RecordChunk(commandLists[chunkIndex], device, scene, draws.data(), begin, end);
+					});
+			});
+
+		// NullDevice가 검사하는 시간, 기록과 따로 잼
+		const float submitMs = MeasureMedianMs(1, [&]()
+			{
+				device.Submit(commandLists.data(), listCount);
+				device.Present(false);
+			});
+
+		if (threadCount == 1)
+		{
+			singleThreadMs = recordMs;
+		}
+
+		printf("%u, %u, %.3f, %.3f, %.2fx\n", threadCount, listCount, recordMs, submitMs, recordMs > 0.f ? singleThreadMs / recordMs : 0.f);
+	}
+
+	const bool bValid = device.GetWorkStats().invalidCommandCount == 0 && device.GetWorkStats().incompleteDrawCount == 0;
+
+	JobSystem::Destroy();
+
+	return bValid ? 0 : 1;
+}
\ No newline at end of file
@@ -1,17 +1,22 @@
 #pragma once
 
-#define WIN32_LEAN_AND_MEAN
-
 #include <cassert>
 #include <iostream>
-#include <Windows.h>
 
 #if defined(_DEBUG) || defined(DEBUG)
 
+// Windows.h 없이 멈출 수 있도록 컴파일러 내장 함수를 씀
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define DEBUG_BREAK() __debugbreak()
+#else
+#define DEBUG_BREAK() __builtin_trap()
+#endif
+
 #define ASSERT_DEFAULT(expr) \
     if (!(expr))             \
     {                        \
-        DebugBreak();        \
+        DEBUG_BREAK();       \
         std::terminate();    \
     }                        \
 
@@ -19,7 +24,7 @@
     if (!(expr))                         \
     {                                    \
         std::cerr << __FILE__ << ' ' << __LINE__ << "\n: " << (msg) << std::endl; \
-        DebugBreak();                    \
+        DEBUG_BREAK();                   \
         std::terminate();                \
     }                                    \
 
@@ -0,0 +1,209 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+
+#include "LogHelper.h"
+
+enum
+{
+	NOTIFY_BUFFER_SIZE = 16 * 1024,
+	PATH_BUFFER_SIZE = 1024
+};
+
+FileWatcher::FileWatcher()
+	: mDirectory()
+	, mhDirectory(INVALID_HANDLE_VALUE)
+	, mhStopEvent(nullptr)
+	, mThread()
+	, mMutex()
+	, mChangedPaths()
+{
+
+}
+
+FileWatcher::~FileWatcher()
+{
+	Stop();
+}
+
+bool FileWatcher::TryStart(const char* const directory)
+{
+	ASSERT(directory != nullptr);
+	ASSERT(!IsWatching());
+
+	mDirectory = directory;
+
+	mhDirectory = CreateFileA(
+		directory,
+		FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+		nullptr
+	);
+
+	if (mhDirectory == INVALID_HANDLE_VALUE)
+	{
+		LOG_SYSTEM_ERROR(GetLastError(), "FileWatcher - CreateFile");
+
+		return false;
+	}
+
+	mhStopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+
+	if (mhStopEvent == nullptr)
+	{
+		LOG_SYSTEM_ERROR(GetLastError(), "FileWatcher - CreateEvent");
+
+		CloseHandle(mhDirectory);
+		mhDirectory = INVALID_HANDLE_VALUE;
+
+		return false;
+	}
+
+	mThread = std::thread(&FileWatcher::watchLoop, this);
+
+	return true;
+}
+
+void FileWatcher::Stop()
+{
+	if (mThread.joinable())
+	{
+		SetEvent(mhStopEvent);
+
+		mThread.join();
+	}
+
+	if (mhStopEvent != nullptr)
+	{
+		CloseHandle(mhStopEvent);
+		mhStopEvent = nullptr;
+	}
+
+	if (mhDirectory != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(mhDirectory);
+		mhDirectory = INVALID_HANDLE_VALUE;
+	}
+}
+
+void FileWatcher::PollChangedFiles(std::vector<std::string>& outPaths)
+{
+	outPaths.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		outPaths.swap(mChangedPaths);
+	}
+
+	// 에디터는 한 번 저장할 때 여러 알림을 보냄
+	std::sort(outPaths.begin(), outPaths.end());
+	outPaths.erase(std::unique(outPaths.begin(), outPaths.end()), outPaths.end());
+}
+
+void FileWatcher::watchLoop()
+{
+	// FILE_NOTIFY_INFORMATION은 DWORD 정렬이어야 함
+	DWORD buffer[NOTIFY_BUFFER_SIZE / sizeof(DWORD)];
+
+	OVERLAPPED overlapped = {};
+	overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+
+	if (overlapped.hEvent == nullptr)
+	{
+		LOG_SYSTEM_ERROR(GetLastError(), "FileWatcher - CreateEvent");
+
+		return;
+	}
+
+	const HANDLE waitHandles[] = { overlapped.hEvent, mhStopEvent };
+
+	while (true)
+	{
+		ResetEvent(overlapped.hEvent);
+
+		const BOOL bRead = ReadDirectoryChangesW(
+			mhDirectory,
+			buffer,
+			sizeof(buffer),
+			TRUE,
+			FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+			nullptr,
+			&overlapped,
+			nullptr
+		);
+
+		if (!bRead)
+		{
+			LOG_SYSTEM_ERROR(GetLastError(), "FileWatcher - ReadDirectoryChanges");
+
+			break;
+		}
+
+		const DWORD waitResult = WaitForMultipleObjects(ARRAYSIZE(waitHandles), waitHandles, FALSE, INFINITE);
+
+		if (waitResult != WAIT_OBJECT_0)
+		{
+			CancelIoEx(mhDirectory, &overlapped);
+
+			DWORD ignored;
+			GetOverlappedResult(mhDirectory, &overlapped, &ignored, TRUE);
+
+			break;
+		}
+
+		DWORD byteCount = 0;
+
+		// 0이면 버퍼가 넘친 것, 이번 알림은 버림
+		if (!GetOverlappedResult(mhDirectory, &overlapped, &byteCount, FALSE) || byteCount == 0)
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(buffer);
+
+		while (true)
+		{
+			const FILE_NOTIFY_INFORMATION* const pInfo = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(pBytes);
+
+			// 지워진 파일이나 이름 바꾸기 전 이름은 다시 읽을 수 없음
+			if (pInfo->Action != FILE_ACTION_REMOVED && pInfo->Action != FILE_ACTION_RENAMED_OLD_NAME)
+			{
+				char path[PATH_BUFFER_SIZE];
+
+				const int length = WideCharToMultiByte(
+					CP_ACP,
+					0,
+					pInfo->FileName,
+					static_cast<int>(pInfo->FileNameLength / sizeof(WCHAR)),
+					path,
+					PATH_BUFFER_SIZE - 1,
+					nullptr,
+					nullptr
+				);
+
+				if (length > 0)
+				{
+					std::string changedPath = mDirectory + '/' + std::string(path, length);
+					std::replace(changedPath.begin(), changedPath.end(), '\\', '/');
+
+					mChangedPaths.push_back(std::move(changedPath));
+				}
+			}
+
+			if (pInfo->NextEntryOffset == 0)
+			{
+				break;
+			}
+
+			pBytes += pInfo->NextEntryOffset;
+		}
+	}
+
+	CloseHandle(overlapped.hEvent);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <Windows.h>
+
+#include "Assert.h"
+
+// 폴더(하위 폴더 포함)의 파일 변경을 별도 스레드에서 감시
+// 변경된 경로는 모아뒀다가 PollChangedFiles로 한 번에 가져감
+class FileWatcher final
+{
+public:
+	FileWatcher();
+	~FileWatcher();
+
+	bool TryStart(const char* const directory);
+	void Stop();
+
+	// 마지막 호출 이후 바뀐 파일, "directory/상대 경로" 형태로 중복 없이 채움
+	void PollChangedFiles(std::vector<std::string>& outPaths);
+
+	inline bool IsWatching() const
+	{
+		return mThread.joinable();
+	}
+
+private:
+	std::string mDirectory;
+
+	HANDLE mhDirectory;
+	HANDLE mhStopEvent;
+
+	std::thread mThread;
+
+	std::mutex mMutex;
+	std::vector<std::string> mChangedPaths;
+
+private:
+	void watchLoop();
+
+private:
+	FileWatcher(const FileWatcher& other) = delete;
+	FileWatcher(FileWatcher&& other) = delete;
+	FileWatcher& operator=(const FileWatcher& other) = delete;
+	FileWatcher& operator=(FileWatcher&& other) = delete;
+};
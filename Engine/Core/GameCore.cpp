@@ -1,11 +1,17 @@
 #include "GameCore.h"
 
+#include <cctype>
+#include <fstream>
+
 #include "UI/ImGuiHeaders.h"
+#include "UI/ImGuiD3D11Backend.h"
 
 #include "LogHelper.h"
 #include "FileDialog.h"
+#include "JobSystem.h"
 
 #include "Renderer/Renderer.h"
+#include "Renderer/RHI/D3D11Device.h"
 #include "Scene/Scene.h"
 #include "Scene/SceneManager.h"
 #include "Scene/Actor.h"
@@ -18,6 +24,7 @@
 #include "Resources/TextureManager.h"
 #include "InteractionSystem.h"
 #include "Resources/ModelManager.h"
+#include "Resources/ModelCooker.h"
 
 enum
 {
@@ -25,8 +32,39 @@ enum
 };
 
 static const TCHAR* const CLASS_NAME = TEXT("GyulEngine");
+static const char* const BENCHMARK_RESULT_PATH = "BenchmarkResults.csv";
 
 static LRESULT WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+// WIC와 DDS 로더가 읽는 확장자
+static bool IsTexturePath(const std::string& path)
+{
+	static const char* const extensions[] = { "dds", "png", "jpg", "jpeg", "bmp", "tif", "tiff", "gif" };
+
+	const size_t dotPosition = path.find_last_of('.');
+
+	if (dotPosition == std::string::npos)
+	{
+		return false;
+	}
+
+	std::string extension = path.substr(dotPosition + 1);
+
+	for (char& c : extension)
+	{
+		c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	}
+
+	for (const char* const candidate : extensions)
+	{
+		if (extension == candidate)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
 LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 GameCore* GameCore::spInstance = nullptr;
@@ -52,6 +90,7 @@ GameCore::~GameCore()
 	InteractionSystem::Destroy();
 	InputSystem::Destroy();
 	Renderer::Destroy();
+	JobSystem::Destroy();
 	FileDialog::Destroy();
 
 	UnregisterClass(CLASS_NAME, mhInstance);
@@ -162,6 +201,117 @@ int GameCore::Run()
 	return (int)msg.wParam;
 }
 
+int GameCore::RunBenchmarks(const std::vector<std::string>& assetPaths)
+{
+	std::ofstream file(BENCHMARK_RESULT_PATH, std::ios::trunc);
+
+	if (!file)
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, BENCHMARK_RESULT_PATH);
+
+		return -1;
+	}
+
+	// 카메라가 넘겨주는 클러스터 카메라 등을 채우려고 한 프레임 그림
+	mpEditorCameraActor->Update(0.f);
+
+	Renderer& renderer = Renderer::GetInstance();
+
+	renderer.BeginFrame();
+	{
+		renderer.RenderScene(mpCurrentScene->GetName());
+	}
+	renderer.EndFrame();
+
+	// value, unit은 시간 말고 따로 재는 값이 있을 때만 채움
+	file << "benchmark,threads,ms,value,unit\n";
+
+	renderer.RunRecordBenchmark(50000);
+
+	for (const Renderer::BenchmarkResult& result : renderer.GetRecordBenchmarkResults())
+	{
+		file << "record_50000_draws," << result.threadCount << ',' << result.timeMs << ",,\n";
+	}
+
+	renderer.RunLightBinningBenchmark(4096);
+
+	for (const Renderer::BenchmarkResult& result : renderer.GetLightBinningBenchmarkResults())
+	{
+		file << "light_binning_4096," << result.threadCount << ',' << result.timeMs << ",,\n";
+	}
+
+	// 디코딩 측정은 등록된 경로에서 다시 읽으므로 백그라운드 불러오기를 기다리지 않음
+	TextureManager& textureManager = TextureManager::GetInstance();
+	ModelManager& modelManager = ModelManager::GetInstance();
+
+	uint32_t textureCount = 0;
+	bool bCookNeeded = false;
+
+	for (const std::string& path : assetPaths)
+	{
+		if (IsTexturePath(path))
+		{
+			textureManager.LoadTexture(path);
+
+			++textureCount;
+
+			continue;
+		}
+
+		modelManager.Load(path);
+
+		bCookNeeded = bCookNeeded || !IsCookedModelUpToDate(path);
+	}
+
+	// 쿠킹된 파일을 다시 쓰기 전에 그 파일을 매핑한 불러오기가 끝나야 함
+	while (modelManager.IsLoading())
+	{
+		modelManager.UpdateLoading();
+
+		Sleep(1);
+	}
+
+	// 쿠킹된 파일과 Assimp 불러오기를 같은 모델로 비교
+	if (bCookNeeded)
+	{
+		modelManager.CookLoadedModels();
+	}
+
+	modelManager.MeasureLoadTimes();
+
+	for (const ModelManager::LoadBenchmark& result : modelManager.GetLoadBenchmarks())
+	{
+		// 변환을 스레드 하나로 돌린 것과 비교한 배율
+		const float importSpeedup = result.importTimeMs > 0.f ? result.serialImportTimeMs / result.importTimeMs : 0.f;
+
+		file << "model_assimp_serial[" << result.path << "],1," << result.serialImportTimeMs << ",,\n";
+		file << "model_assimp[" << result.path << "]," << result.threadCount << ',' << result.importTimeMs << ',' << importSpeedup << ",x\n";
+
+		// Assimp 기본 입출력과 매핑한 파일로 읽었을 때의 최대 메모리
+		constexpr float BYTES_PER_MB = 1024.f * 1024.f;
+
+		file << "model_io_default[" << result.path << "]," << result.threadCount << ',' << result.defaultIOImportTimeMs << ',' << static_cast<float>(result.defaultIOPeakMemoryBytes) / BYTES_PER_MB << ",MB\n";
+		file << "model_io_mapped[" << result.path << "]," << result.threadCount << ',' << result.importTimeMs << ',' << static_cast<float>(result.peakMemoryBytes) / BYTES_PER_MB << ",MB\n";
+
+		if (result.cookedTimeMs >= 0.f)
+		{
+			file << "model_cooked[" << result.path << "],1," << result.cookedTimeMs << ",,\n";
+		}
+	}
+
+	if (textureCount > 0)
+	{
+		textureManager.MeasureDecodeThroughput();
+
+		for (const TextureManager::DecodeBenchmark& result : textureManager.GetDecodeBenchmarks())
+		{
+			file << "texture_decode_" << textureCount << ',' << result.threadCount << ',' << result.timeMs << ',' << result.megapixelsPerSecond << ",MP/s\n";
+		}
+	}
+
+	return 0;
+}
+
 void GameCore::DrawEditorUI()
 {
 	// Use class name as ID scope
@@ -170,23 +320,23 @@ void GameCore::DrawEditorUI()
 	// Main menu bar with File -> Exit (localized)
 	if (ImGui::BeginMainMenuBar())
 	{
-		if (ImGui::BeginMenu(UTF8_TEXT("")))
+		if (ImGui::BeginMenu(UTF8_TEXT("파일")))
 		{
-			if (ImGui::MenuItem(UTF8_TEXT(""), "Alt+F4"))
+			if (ImGui::MenuItem(UTF8_TEXT("종료"), "Alt+F4"))
 			{
 				PostQuitMessage(0);
 			}
 			ImGui::EndMenu();
 		}
 
-		//  ޴: ҽ â 
-		if (ImGui::BeginMenu(UTF8_TEXT("")))
+		// 보기 메뉴: 리소스 창 토글
+		if (ImGui::BeginMenu(UTF8_TEXT("보기")))
 		{
-			ImGui::MenuItem(UTF8_TEXT("ҽ â"), nullptr, &mbShowResources);
+			ImGui::MenuItem(UTF8_TEXT("리소스 창"), nullptr, &mbShowResources);
 			ImGui::EndMenu();
 		}
 
-		ImGui::MenuItem(UTF8_TEXT(" (F5)"), nullptr, nullptr, false);
+		ImGui::MenuItem(UTF8_TEXT("모드 변경(F5)"), nullptr, nullptr, false);
 
 		ImGui::EndMainMenuBar();
 	}
@@ -206,50 +356,50 @@ void GameCore::DrawEditorUI()
 		ImGui::End();
 	}
 
-	// ϴ ҽ   - 켱  Ŵ Ǹ 
+	// 하단 리소스 탭 영역 - 우선 씬 매니저 탭만 구현
 	if (mbShowResources)
 	{
 		const ImGuiViewport* vp = ImGui::GetMainViewport();
-		const float resourceHeight = 180.f; // ⺻ 
+		const float resourceHeight = 180.f; // 기본 높이
 		ImGui::SetNextWindowPos(ImVec2(vp->WorkPos.x, vp->WorkPos.y + vp->WorkSize.y - resourceHeight), ImGuiCond_Always);
 		ImGui::SetNextWindowSize(ImVec2(vp->WorkSize.x, resourceHeight));
 
 		ImGuiWindowFlags winFlags = ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoBringToFrontOnFocus;
-		if (ImGui::Begin(UTF8_TEXT("ҽ"), nullptr, winFlags))
+		if (ImGui::Begin(UTF8_TEXT("리소스"), nullptr, winFlags))
 		{
 			if (ImGui::BeginTabBar("ResourceTabs"))
 			{
-				if (ImGui::BeginTabItem(UTF8_TEXT("")))
+				if (ImGui::BeginTabItem(UTF8_TEXT("씬")))
 				{
 					SceneManager::GetInstance().DrawEditorUI();
 					ImGui::EndTabItem();
 				}
 
-				if (ImGui::BeginTabItem(UTF8_TEXT("޽")))
+				if (ImGui::BeginTabItem(UTF8_TEXT("메쉬")))
 				{
 					MeshManager::GetInstance().DrawEditorUI();
 					ImGui::EndTabItem();
 				}
 
-				if (ImGui::BeginTabItem(UTF8_TEXT("Ƽ")))
+				if (ImGui::BeginTabItem(UTF8_TEXT("머티리얼")))
 				{
 					MaterialManager::GetInstance().DrawEditorUI();
 					ImGui::EndTabItem();
 				}
 
-				if (ImGui::BeginTabItem(UTF8_TEXT("̴")))
+				if (ImGui::BeginTabItem(UTF8_TEXT("셰이더")))
 				{
 					ShaderManager::GetInstance().DrawEditorUI();
 					ImGui::EndTabItem();
 				}
 
-				if (ImGui::BeginTabItem(UTF8_TEXT("ؽó")))
+				if (ImGui::BeginTabItem(UTF8_TEXT("텍스처")))
 				{
 					TextureManager::GetInstance().DrawEditorUI();
 					ImGui::EndTabItem();
 				}
 
-				if (ImGui::BeginTabItem(UTF8_TEXT("")))
+				if (ImGui::BeginTabItem(UTF8_TEXT("모델")))
 				{
 					ModelManager::GetInstance().DrawEditorUI();
 					ImGui::EndTabItem();
@@ -261,7 +411,7 @@ void GameCore::DrawEditorUI()
 		ImGui::End();
 	}
 
-	const char* const settingsId = UTF8_TEXT("");
+	const char* const settingsId = UTF8_TEXT("설정");
 	if (mbShowSettingsPopup)
 	{
 		ImGui::OpenPopup(settingsId, ImGuiPopupFlags_NoReopen);
@@ -277,7 +427,7 @@ void GameCore::DrawEditorUI()
 
 		// GameCore target frame rate slider
 		int frameRate = static_cast<int>(mTargetFrameRate);
-		if (ImGui::SliderInt(UTF8_TEXT("ǥ ӷƮ"), &frameRate, 30, renderer.GetRefreshRate()))
+		if (ImGui::SliderInt(UTF8_TEXT("목표 프레임레이트"), &frameRate, 30, renderer.GetRefreshRate()))
 		{
 			mTargetFrameRate = static_cast<UINT>(frameRate);
 		}
@@ -347,13 +497,31 @@ bool GameCore::TryInitialize(const HINSTANCE hInstance, const int nShowCmd)
 		return false;
 	}
 
-	if (!Renderer::TryInitialize(hWnd))
+	JobSystem::Initialize();
+
+	// 장치 선택은 여기서, 렌더러는 RHI::Device만 씀
+	RHI::D3D11Device* const pDevice = RHI::D3D11Device::CreateDeviceAllocOrNull(hWnd);
+
+	if (pDevice == nullptr)
 	{
 		ASSERT(false);
 
 		return false;
 	}
 
+	ImGuiD3D11Backend* const pUIBackend = ImGuiD3D11Backend::CreateBackendAllocOrNull(hWnd, *pDevice);
+
+	if (pUIBackend == nullptr)
+	{
+		delete pDevice;
+
+		ASSERT(false);
+
+		return false;
+	}
+
+	Renderer::Initialize(pDevice, pUIBackend, pDevice->GetRefreshRate());
+
 	InputSystem::Initialize();
 	InteractionSystem::Initialize();
 	SceneManager::Initialize();
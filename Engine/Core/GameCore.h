@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <string>
 #include <wtypes.h>
 #include <memory>
 
@@ -19,6 +20,10 @@ class GameCore final : public IEditorUIDrawable
 public:
 	int Run();
 
+	// 에디터의 벤치마크 버튼들을 차례로 실행하고 결과를 BenchmarkResults.csv로 남김
+	// assetPaths의 텍스처는 디코딩 처리량, 나머지는 모델로 보고 Assimp와 쿠킹된 파일 불러오기 비교에 씀
+	int RunBenchmarks(const std::vector<std::string>& assetPaths);
+
 	virtual void DrawEditorUI() override;
 
 	inline void SetCurrentScene(Scene* const pScene)
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// 64비트 FNV-1a, 캐시 키와 내용 비교용
+enum : uint64_t
+{
+	FNV_OFFSET_BASIS = 14695981039346656037ull,
+	FNV_PRIME = 1099511628211ull,
+
+	// HashBytesMix, MurmurHash3의 fmix64 상수
+	MIX_SEED = 0x9E3779B97F4A7C15ull,
+	MIX_MULTIPLIER_0 = 0xFF51AFD7ED558CCDull,
+	MIX_MULTIPLIER_1 = 0xC4CEB9FE1A85EC53ull
+};
+
+inline uint64_t HashBytes(const void* const pData, const size_t byteSize, const uint64_t seed = FNV_OFFSET_BASIS)
+{
+	const uint8_t* const pBytes = static_cast<const uint8_t*>(pData);
+
+	uint64_t hash = seed;
+
+	for (size_t i = 0; i < byteSize; ++i)
+	{
+		hash ^= pBytes[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+// 끝의 '\0'까지 넣어서 "ab" + "c"와 "a" + "bc"가 구분되게 함
+inline uint64_t HashString(const char* const str, const uint64_t seed = FNV_OFFSET_BASIS)
+{
+	return HashBytes(str, strlen(str) + 1, seed);
+}
+
+inline uint64_t HashCombine(const uint64_t seed, const uint64_t value)
+{
+	return HashBytes(&value, sizeof(value), seed);
+}
+
+inline uint64_t MixBits(uint64_t value)
+{
+	value ^= value >> 33;
+	value *= MIX_MULTIPLIER_0;
+	value ^= value >> 33;
+	value *= MIX_MULTIPLIER_1;
+	value ^= value >> 33;
+
+	return value;
+}
+
+// FNV-1a와 구조가 다른 두 번째 해시, 8바이트씩 섞음
+inline uint64_t HashBytesMix(const void* const pData, const size_t byteSize, const uint64_t seed = MIX_SEED)
+{
+	const uint8_t* const pBytes = static_cast<const uint8_t*>(pData);
+
+	uint64_t hash = MixBits(seed ^ static_cast<uint64_t>(byteSize));
+
+	size_t i = 0;
+
+	for (; i + sizeof(uint64_t) <= byteSize; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, pBytes + i, sizeof(word));
+
+		hash = MixBits(hash ^ word) + MIX_SEED;
+	}
+
+	if (i < byteSize)
+	{
+		uint64_t word = 0;
+		memcpy(&word, pBytes + i, byteSize - i);
+
+		hash = MixBits(hash ^ word) + MIX_SEED;
+	}
+
+	return hash;
+}
+
+// 내용 중복 제거용, 64비트 하나로는 충돌을 알아챌 수 없어서 두 해시를 같이 비교함
+struct Hash128
+{
+	// HashBytes
+	uint64_t low;
+	// HashBytesMix
+	uint64_t high;
+
+	bool operator==(const Hash128& other) const
+	{
+		return low == other.low && high == other.high;
+	}
+};
+
+inline Hash128 HashBytes128(const void* const pData, const size_t byteSize, const Hash128& seed = { FNV_OFFSET_BASIS, MIX_SEED })
+{
+	return { HashBytes(pData, byteSize, seed.low), HashBytesMix(pData, byteSize, seed.high) };
+}
+
+inline Hash128 HashCombine128(const Hash128& seed, const uint64_t value)
+{
+	return HashBytes128(&value, sizeof(value), seed);
+}
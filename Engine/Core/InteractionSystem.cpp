@@ -229,9 +229,9 @@ void InteractionSystem::updateInteractionInfo()
 {
 	Renderer& renderer = Renderer::GetInstance();
 
-	const D3D11_VIEWPORT& viewport = renderer.GetViewport();
+	const RHI::Viewport& viewport = renderer.GetViewport();
 
-	const Vector2 screenSize(viewport.Width, viewport.Height);
+	const Vector2 screenSize(viewport.width, viewport.height);
 
 	InputSystem& inputSystem = InputSystem::GetInstance();
 	const Vector2 mouseCoord = inputSystem.GetMousePosition();
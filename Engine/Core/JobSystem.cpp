@@ -0,0 +1,175 @@
+#include "JobSystem.h"
+
+#include <atomic>
+
+JobSystem* JobSystem::spInstance = nullptr;
+
+JobSystem::JobSystem(const uint32_t workerCount)
+	: mWorkers()
+	, mMutex()
+	, mCondition()
+	, mParallelJobs()
+	, mBackgroundJobs()
+	, mbQuit(false)
+{
+	mWorkers.reserve(workerCount);
+
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		mWorkers.emplace_back(&JobSystem::workerLoop, this);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mbQuit = true;
+	}
+	mCondition.notify_all();
+
+	for (std::thread& worker : mWorkers)
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::ParallelFor(const uint32_t count, const uint32_t chunkCount, const ChunkFunction& function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	uint32_t clampedChunkCount = chunkCount < count ? chunkCount : count;
+
+	if (clampedChunkCount == 0)
+	{
+		clampedChunkCount = 1;
+	}
+
+	if (clampedChunkCount == 1 || mWorkers.empty())
+	{
+		function(0, count, 0);
+
+		return;
+	}
+
+	const uint32_t chunkSize = (count + clampedChunkCount - 1) / clampedChunkCount;
+
+	// 빈 청크가 생기지 않도록 다시 계산
+	clampedChunkCount = (count + chunkSize - 1) / chunkSize;
+
+	std::atomic<uint32_t> remainingCount(clampedChunkCount - 1);
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		for (uint32_t i = 1; i < clampedChunkCount; ++i)
+		{
+			const uint32_t begin = i * chunkSize < count ? i * chunkSize : count;
+			const uint32_t end = count - begin > chunkSize ? begin + chunkSize : count;
+
+			mParallelJobs.push_back([&function, &remainingCount, begin, end, i]()
+				{
+					function(begin, end, i);
+
+					remainingCount.fetch_sub(1, std::memory_order_release);
+				});
+		}
+	}
+	mCondition.notify_all();
+
+	// 첫 청크는 호출 스레드에서
+	function(0, chunkSize < count ? chunkSize : count, 0);
+
+	// 남은 작업을 도우면서 대기
+	while (remainingCount.load(std::memory_order_acquire) > 0)
+	{
+		if (!tryRunParallelJob())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::Submit(std::function<void()> job)
+{
+	ASSERT(job != nullptr);
+
+	if (mWorkers.empty())
+	{
+		job();
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mBackgroundJobs.push_back(std::move(job));
+	}
+	mCondition.notify_one();
+}
+
+void JobSystem::Initialize()
+{
+	ASSERT(spInstance == nullptr);
+
+	// 메인 스레드 몫 하나는 제외
+	const uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+	const uint32_t workerCount = hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+
+	spInstance = new JobSystem(workerCount);
+}
+
+bool JobSystem::tryRunParallelJob()
+{
+	std::function<void()> job;
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (mParallelJobs.empty())
+		{
+			return false;
+		}
+
+		job = std::move(mParallelJobs.front());
+		mParallelJobs.pop_front();
+	}
+
+	job();
+
+	return true;
+}
+
+void JobSystem::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> job;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+
+			mCondition.wait(lock, [this]()
+				{
+					return mbQuit || !mParallelJobs.empty() || !mBackgroundJobs.empty();
+				});
+
+			if (mbQuit)
+			{
+				return;
+			}
+
+			std::deque<std::function<void()>>& jobs = !mParallelJobs.empty() ? mParallelJobs : mBackgroundJobs;
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+
+		job();
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "Assert.h"
+
+// 워커 스레드 풀
+// ParallelFor 작업은 백그라운드 작업보다 먼저 처리되고 호출 스레드도 함께 실행함
+class JobSystem final
+{
+public:
+	// begin, end, chunk index
+	typedef std::function<void(const uint32_t, const uint32_t, const uint32_t)> ChunkFunction;
+
+public:
+	// [0, count)를 chunkCount개로 나눠 병렬 실행, 모두 끝나야 반환
+	void ParallelFor(const uint32_t count, const uint32_t chunkCount, const ChunkFunction& function);
+
+	// 완료를 기다리지 않는 백그라운드 작업
+	void Submit(std::function<void()> job);
+
+	inline uint32_t GetWorkerCount() const
+	{
+		return static_cast<uint32_t>(mWorkers.size());
+	}
+
+	// static
+	static void Initialize();
+
+	static inline JobSystem& GetInstance()
+	{
+		ASSERT(spInstance != nullptr);
+
+		return *spInstance;
+	}
+
+	static inline bool IsInitialized()
+	{
+		return spInstance != nullptr;
+	}
+
+	static inline void Destroy()
+	{
+		delete spInstance;
+		spInstance = nullptr;
+	}
+
+private:
+	static JobSystem* spInstance;
+
+	std::vector<std::thread> mWorkers;
+
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+
+	std::deque<std::function<void()>> mParallelJobs;
+	std::deque<std::function<void()>> mBackgroundJobs;
+
+	bool mbQuit;
+
+private:
+	JobSystem(const uint32_t workerCount);
+	~JobSystem();
+
+	bool tryRunParallelJob();
+	void workerLoop();
+
+private:
+	JobSystem(const JobSystem& other) = delete;
+	JobSystem(JobSystem&& other) = delete;
+	JobSystem& operator=(const JobSystem& other) = delete;
+	JobSystem& operator=(JobSystem&& other) = delete;
+};
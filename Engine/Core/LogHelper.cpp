@@ -1,8 +1,12 @@
 #include "LogHelper.h"
 
+#include "Assert.h"
+
+#ifdef _WIN32
 #include <comdef.h>
 
 #include "StringHelper.h"
+#endif
 
 enum
 {
@@ -13,6 +17,7 @@ void LogSystemError(const char* const filename, const int line, const long error
 {
 	ASSERT(msg != nullptr);
 
+#ifdef _WIN32
 	const HRESULT hr = HRESULT_FROM_WIN32(errorCode);
 
 	_com_error err(hr);
@@ -29,4 +34,12 @@ void LogSystemError(const char* const filename, const int line, const long error
 		<< msg << ' '
 		<< buffer
 		<< std::endl;
+#else
+	std::cerr
+		<< filename << ' '
+		<< line << "\n: "
+		<< msg << " 0x"
+		<< std::hex << static_cast<unsigned long>(errorCode) << std::dec
+		<< std::endl;
+#endif
 }
\ No newline at end of file
@@ -1,4 +1,11 @@
 #pragma once
 
+#ifdef _WIN32
+#include <winerror.h>
+#else
+// 헤드리스 빌드에는 winerror.h가 없으므로 쓰는 코드만 같은 값으로 둠
+#define E_FAIL static_cast<long>(0x80004005L)
+#endif
+
 #define LOG_SYSTEM_ERROR(errorCode, msg) LogSystemError(__FILE__, __LINE__, errorCode, msg)
 void LogSystemError(const char* const filename, const int line, const long errorCode, const char* const msg);
\ No newline at end of file
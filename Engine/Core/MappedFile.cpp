@@ -0,0 +1,164 @@
+#include "MappedFile.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "LogHelper.h"
+
+MappedFile::MappedFile()
+#ifdef _WIN32
+	: mhFile(INVALID_HANDLE_VALUE)
+	, mhMapping(nullptr)
+#else
+	: mFile(-1)
+#endif
+	, mpData(nullptr)
+	, mSize(0)
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::TryOpen(const char* const path)
+{
+	ASSERT(path != nullptr);
+
+	Close();
+
+	// 없는 파일은 호출자가 처리하므로 로그를 남기지 않음
+	mhFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (mhFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+
+	// 크기가 0인 파일은 매핑할 수 없음
+	if (!GetFileSizeEx(mhFile, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+
+		return false;
+	}
+
+	mhMapping = CreateFileMappingA(mhFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mhMapping == nullptr)
+	{
+		LOG_SYSTEM_ERROR(GetLastError(), "CreateFileMapping");
+
+		Close();
+
+		return false;
+	}
+
+	mpData = static_cast<const uint8_t*>(MapViewOfFile(mhMapping, FILE_MAP_READ, 0, 0, 0));
+
+	if (mpData == nullptr)
+	{
+		LOG_SYSTEM_ERROR(GetLastError(), "MapViewOfFile");
+
+		Close();
+
+		return false;
+	}
+
+	mSize = static_cast<size_t>(fileSize.QuadPart);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mpData != nullptr)
+	{
+		UnmapViewOfFile(mpData);
+		mpData = nullptr;
+	}
+
+	if (mhMapping != nullptr)
+	{
+		CloseHandle(mhMapping);
+		mhMapping = nullptr;
+	}
+
+	if (mhFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(mhFile);
+		mhFile = INVALID_HANDLE_VALUE;
+	}
+
+	mSize = 0;
+}
+
+#else
+bool MappedFile::TryOpen(const char* const path)
+{
+	ASSERT(path != nullptr);
+
+	Close();
+
+	// 없는 파일은 호출자가 처리하므로 로그를 남기지 않음
+	mFile = open(path, O_RDONLY);
+
+	if (mFile < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+
+	// 크기가 0인 파일은 매핑할 수 없음
+	if (fstat(mFile, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		Close();
+
+		return false;
+	}
+
+	void* const pData = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, mFile, 0);
+
+	if (pData == MAP_FAILED)
+	{
+		LOG_SYSTEM_ERROR(errno, "mmap");
+
+		Close();
+
+		return false;
+	}
+
+	mpData = static_cast<const uint8_t*>(pData);
+	mSize = static_cast<size_t>(fileStat.st_size);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mpData != nullptr)
+	{
+		munmap(const_cast<uint8_t*>(mpData), mSize);
+		mpData = nullptr;
+	}
+
+	if (mFile >= 0)
+	{
+		close(mFile);
+		mFile = -1;
+	}
+
+	mSize = 0;
+}
+#endif
\ No newline at end of file
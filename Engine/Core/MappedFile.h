@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include "Assert.h"
+
+// 읽기 전용 메모리 매핑 파일
+// 복사 없이 파일 내용을 바로 읽을 때 사용
+class MappedFile final
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool TryOpen(const char* const path);
+	void Close();
+
+	inline bool IsOpen() const
+	{
+		return mpData != nullptr;
+	}
+
+	inline const uint8_t* GetData() const
+	{
+		return mpData;
+	}
+
+	inline size_t GetSize() const
+	{
+		return mSize;
+	}
+
+private:
+#ifdef _WIN32
+	HANDLE mhFile;
+	HANDLE mhMapping;
+#else
+	// 헤드리스 빌드용 POSIX mmap
+	int mFile;
+#endif
+
+	const uint8_t* mpData;
+	size_t mSize;
+
+private:
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile(MappedFile&& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+	MappedFile& operator=(MappedFile&& other) = delete;
+};
@@ -1,6 +1,220 @@
 #pragma once
 
+#ifdef _WIN32
 #include <SimpleMath.h>
+#else
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// 헤드리스 빌드에는 DirectXMath가 없으므로 CPU 메쉬 처리에 쓰는 만큼만 같은 이름으로 둠
+namespace DirectX
+{
+	namespace SimpleMath
+	{
+		struct Vector2
+		{
+			float x;
+			float y;
+
+			Vector2() noexcept : x(0.f), y(0.f) {}
+			constexpr Vector2(const float ix, const float iy) noexcept : x(ix), y(iy) {}
+		};
+
+		struct Vector3
+		{
+			float x;
+			float y;
+			float z;
+
+			Vector3() noexcept : x(0.f), y(0.f), z(0.f) {}
+			constexpr Vector3(const float ix, const float iy, const float iz) noexcept : x(ix), y(iy), z(iz) {}
+
+			inline Vector3 operator+(const Vector3& other) const
+			{
+				return Vector3(x + other.x, y + other.y, z + other.z);
+			}
+
+			inline Vector3 operator-(const Vector3& other) const
+			{
+				return Vector3(x - other.x, y - other.y, z - other.z);
+			}
+
+			inline Vector3 operator*(const Vector3& other) const
+			{
+				return Vector3(x * other.x, y * other.y, z * other.z);
+			}
+
+			inline Vector3 operator*(const float scalar) const
+			{
+				return Vector3(x * scalar, y * scalar, z * scalar);
+			}
+
+			inline Vector3 operator/(const float scalar) const
+			{
+				return Vector3(x / scalar, y / scalar, z / scalar);
+			}
+
+			inline Vector3& operator+=(const Vector3& other)
+			{
+				x += other.x;
+				y += other.y;
+				z += other.z;
+
+				return *this;
+			}
+
+			inline Vector3& operator-=(const Vector3& other)
+			{
+				x -= other.x;
+				y -= other.y;
+				z -= other.z;
+
+				return *this;
+			}
+
+			inline Vector3& operator*=(const float scalar)
+			{
+				x *= scalar;
+				y *= scalar;
+				z *= scalar;
+
+				return *this;
+			}
+
+			inline Vector3& operator/=(const float scalar)
+			{
+				x /= scalar;
+				y /= scalar;
+				z /= scalar;
+
+				return *this;
+			}
+
+			inline float Dot(const Vector3& other) const
+			{
+				return x * other.x + y * other.y + z * other.z;
+			}
+
+			inline Vector3 Cross(const Vector3& other) const
+			{
+				return Vector3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+			}
+
+			inline float LengthSquared() const
+			{
+				return Dot(*this);
+			}
+
+			inline float Length() const
+			{
+				return std::sqrt(LengthSquared());
+			}
+
+			// XMVector3Normalize처럼 길이가 0이면 그대로 둠
+			inline void Normalize()
+			{
+				const float length = Length();
+				if (length > 0.f)
+				{
+					*this /= length;
+				}
+			}
+
+			// static
+			static inline float Distance(const Vector3& lhs, const Vector3& rhs)
+			{
+				return (lhs - rhs).Length();
+			}
+
+			static const Vector3 Zero;
+		};
+
+		inline const Vector3 Vector3::Zero(0.f, 0.f, 0.f);
+	}
+
+	namespace PackedVector
+	{
+		typedef uint16_t HALF;
+
+		// XMConvertFloatToHalf의 소프트웨어 경로와 같게 가장 가까운 짝수로 반올림
+		inline HALF XMConvertFloatToHalf(const float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			const uint32_t sign = (bits >> 16) & 0x8000;
+			bits &= 0x7FFFFFFF;
+
+			uint32_t result;
+
+			if ((bits & 0x7F800000) == 0x7F800000)
+			{
+				result = (bits & 0x7FFFFF) != 0 ? 0x7FFF : 0x7C00;
+			}
+			else if (bits > 0x477FE000)
+			{
+				result = 0x7C00;
+			}
+			else
+			{
+				if (bits < 0x38800000)
+				{
+					// half로는 비정규 수
+					const uint32_t shift = 113 - (bits >> 23);
+					bits = shift < 24 ? (0x800000 | (bits & 0x7FFFFF)) >> shift : 0;
+				}
+				else
+				{
+					bits += 0xC8000000;
+				}
+
+				result = ((bits + 0x0FFF + ((bits >> 13) & 1)) >> 13) & 0x7FFF;
+			}
+
+			return static_cast<HALF>(result | sign);
+		}
+
+		inline float XMConvertHalfToFloat(const HALF value)
+		{
+			uint32_t mantissa = value & 0x03FF;
+			uint32_t exponent = value & 0x7C00;
+
+			if (exponent == 0x7C00)
+			{
+				exponent = 0x8F;
+			}
+			else if (exponent != 0)
+			{
+				exponent = (value >> 10) & 0x1F;
+			}
+			else if (mantissa != 0)
+			{
+				exponent = 1;
+
+				do
+				{
+					--exponent;
+					mantissa <<= 1;
+				} while ((mantissa & 0x0400) == 0);
+
+				mantissa &= 0x03FF;
+			}
+			else
+			{
+				exponent = static_cast<uint32_t>(-112);
+			}
+
+			const uint32_t bits = ((value & 0x8000) << 16) | ((exponent + 112) << 23) | (mantissa << 13);
+
+			float result;
+			std::memcpy(&result, &bits, sizeof(result));
+
+			return result;
+		}
+	}
+}
+#endif
 
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
\ No newline at end of file
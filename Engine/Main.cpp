@@ -3,9 +3,47 @@
 #include <crtdbg.h>
 #endif
 
+#include <cwchar>
+#include <string>
+#include <vector>
 #include <Windows.h>
+#include <shellapi.h>
 #include <Core/GameCore.h>
 
+// "-benchmark [에셋 경로...]"면 true, 경로는 ANSI로 바꿔서 돌려줌
+static bool TryParseBenchmarkArguments(std::vector<std::string>& outAssetPaths)
+{
+	int argumentCount = 0;
+	LPWSTR* const ppArguments = CommandLineToArgvW(GetCommandLineW(), &argumentCount);
+
+	if (ppArguments == nullptr)
+	{
+		return false;
+	}
+
+	// 0번은 실행 파일 경로
+	const bool bBenchmark = argumentCount > 1 && wcscmp(ppArguments[1], L"-benchmark") == 0;
+
+	for (int i = 2; bBenchmark && i < argumentCount; ++i)
+	{
+		const int byteLength = WideCharToMultiByte(CP_ACP, 0, ppArguments[i], -1, nullptr, 0, nullptr, nullptr);
+
+		if (byteLength <= 1)
+		{
+			continue;
+		}
+
+		std::string path(static_cast<size_t>(byteLength - 1), '\0');
+		WideCharToMultiByte(CP_ACP, 0, ppArguments[i], -1, path.data(), byteLength, nullptr, nullptr);
+
+		outAssetPaths.push_back(path);
+	}
+
+	LocalFree(ppArguments);
+
+	return bBenchmark;
+}
+
 int WINAPI wWinMain(
 	_In_ HINSTANCE hInstance,
 	_In_opt_ HINSTANCE hPrevInstance,
@@ -24,7 +62,10 @@ int WINAPI wWinMain(
 	{
 		GameCore& gameCore = GameCore::GetInstance();
 		{
-			code = gameCore.Run();
+			// -benchmark: 에디터 대신 측정만 하고 종료
+			std::vector<std::string> assetPaths;
+
+			code = TryParseBenchmarkArguments(assetPaths) ? gameCore.RunBenchmarks(assetPaths) : gameCore.Run();
 		}
 		gameCore.Destroy();
 	}
@@ -0,0 +1,402 @@
+#include "FrameGraph.h"
+
+#include <algorithm>
+
+enum
+{
+	DEFAULT_PASS_COUNT = 8,
+	DEFAULT_RESOURCE_COUNT = 16
+};
+
+static bool IsSameTextureDesc(const RHI::TextureDesc& lhs, const RHI::TextureDesc& rhs)
+{
+	return lhs.width == rhs.width
+		&& lhs.height == rhs.height
+		&& lhs.mipLevels == rhs.mipLevels
+		&& lhs.arraySize == rhs.arraySize
+		&& lhs.sampleCount == rhs.sampleCount
+		&& lhs.bindFlags == rhs.bindFlags
+		&& lhs.miscFlags == rhs.miscFlags
+		&& lhs.format == rhs.format
+		&& lhs.usage == rhs.usage;
+}
+
+TransientTexturePool::TransientTexturePool(RHI::Device& device)
+	: mDevice(device)
+	, mEntries()
+{
+	mEntries.reserve(DEFAULT_RESOURCE_COUNT);
+}
+
+TransientTexturePool::~TransientTexturePool()
+{
+	Clear();
+}
+
+RHI::TextureHandle TransientTexturePool::Acquire(const RHI::TextureDesc& desc)
+{
+	for (Entry& entry : mEntries)
+	{
+		if (!entry.bInUse && IsSameTextureDesc(entry.desc, desc))
+		{
+			entry.bInUse = true;
+			entry.unusedFrameCount = 0;
+
+			return entry.texture;
+		}
+	}
+
+	const RHI::TextureHandle texture = mDevice.CreateTexture(desc, nullptr);
+	ASSERT(texture.IsValid());
+
+	mEntries.push_back({ desc, texture, 0, true });
+
+	return texture;
+}
+
+void TransientTexturePool::EndFrame()
+{
+	for (size_t i = 0; i < mEntries.size();)
+	{
+		Entry& entry = mEntries[i];
+
+		if (entry.bInUse)
+		{
+			entry.bInUse = false;
+			entry.unusedFrameCount = 0;
+		}
+		else if (++entry.unusedFrameCount > MAX_UNUSED_FRAME_COUNT)
+		{
+			// 크기 변경 등으로 더 이상 맞는 요청이 없는 텍스처
+			mDevice.DestroyTexture(entry.texture);
+
+			entry = mEntries.back();
+			mEntries.pop_back();
+
+			continue;
+		}
+
+		++i;
+	}
+}
+
+void TransientTexturePool::Clear()
+{
+	for (const Entry& entry : mEntries)
+	{
+		mDevice.DestroyTexture(entry.texture);
+	}
+
+	mEntries.clear();
+}
+
+FrameGraph::PassBuilder::PassBuilder(FrameGraph& frameGraph, const uint32_t passIndex)
+	: mFrameGraph(frameGraph)
+	, mPassIndex(passIndex)
+{
+	ASSERT(passIndex < frameGraph.mPasses.size());
+}
+
+void FrameGraph::PassBuilder::Read(const ResourceHandle resource)
+{
+	ASSERT(resource.id < mFrameGraph.mResources.size());
+
+	mFrameGraph.mPasses[mPassIndex].reads.push_back(resource.id);
+}
+
+void FrameGraph::PassBuilder::Write(const ResourceHandle resource)
+{
+	ASSERT(resource.id < mFrameGraph.mResources.size());
+
+	Pass& pass = mFrameGraph.mPasses[mPassIndex];
+	pass.writes.push_back(resource.id);
+
+	// 외부 리소스에 쓰는 패스는 항상 남김
+	if (mFrameGraph.mResources[resource.id].bImported)
+	{
+		pass.bSideEffect = true;
+	}
+}
+
+void FrameGraph::PassBuilder::SetSideEffect()
+{
+	mFrameGraph.mPasses[mPassIndex].bSideEffect = true;
+}
+
+FrameGraph::FrameGraph()
+	: mResources()
+	, mPasses()
+	, mPhysicalDescs()
+	, mPhysicalTextures()
+	, mbCompiled(false)
+	, mCompileStats{}
+{
+	mResources.reserve(DEFAULT_RESOURCE_COUNT);
+	mPasses.reserve(DEFAULT_PASS_COUNT);
+}
+
+void FrameGraph::Reset()
+{
+	mResources.clear();
+	mPasses.clear();
+	mPhysicalDescs.clear();
+	mPhysicalTextures.clear();
+
+	mbCompiled = false;
+	mCompileStats = {};
+}
+
+FrameGraph::ResourceHandle FrameGraph::CreateTexture(const char* const name, const RHI::TextureDesc& desc)
+{
+	ASSERT(name != nullptr);
+	ASSERT(desc.width > 0 && desc.height > 0);
+	ASSERT(!mbCompiled);
+
+	Resource resource = {};
+	resource.name = name;
+	resource.desc = desc;
+	resource.importedTexture = { 0 };
+	resource.bImported = false;
+	resource.firstPass = INVALID_ID;
+	resource.lastPass = INVALID_ID;
+	resource.physicalIndex = INVALID_ID;
+
+	mResources.push_back(resource);
+
+	return { static_cast<uint32_t>(mResources.size() - 1) };
+}
+
+FrameGraph::ResourceHandle FrameGraph::ImportTexture(const char* const name, const RHI::TextureHandle texture)
+{
+	ASSERT(name != nullptr);
+	ASSERT(texture.IsValid());
+	ASSERT(!mbCompiled);
+
+	Resource resource = {};
+	resource.name = name;
+	resource.desc = {};
+	resource.importedTexture = texture;
+	resource.bImported = true;
+	resource.firstPass = INVALID_ID;
+	resource.lastPass = INVALID_ID;
+	resource.physicalIndex = INVALID_ID;
+
+	mResources.push_back(resource);
+
+	return { static_cast<uint32_t>(mResources.size() - 1) };
+}
+
+FrameGraph::PassBuilder FrameGraph::AddPass(const char* const name, ExecuteFunction execute)
+{
+	ASSERT(name != nullptr);
+	ASSERT(execute != nullptr);
+	ASSERT(!mbCompiled);
+
+	Pass pass;
+	pass.name = name;
+	pass.execute = std::move(execute);
+	pass.bSideEffect = false;
+	pass.bCulled = false;
+
+	mPasses.push_back(std::move(pass));
+
+	return PassBuilder(*this, static_cast<uint32_t>(mPasses.size() - 1));
+}
+
+bool FrameGraph::Compile()
+{
+	ASSERT(!mbCompiled);
+
+	mCompileStats = {};
+	mCompileStats.passCount = static_cast<uint32_t>(mPasses.size());
+
+	// 뒤에서부터 필요한 리소스를 쓰는 패스만 남김
+	std::vector<bool> resourceNeeded(mResources.size(), false);
+
+	for (size_t i = mPasses.size(); i > 0; --i)
+	{
+		Pass& pass = mPasses[i - 1];
+
+		bool bNeeded = pass.bSideEffect;
+
+		for (const uint32_t resourceId : pass.writes)
+		{
+			bNeeded = bNeeded || resourceNeeded[resourceId];
+		}
+
+		pass.bCulled = !bNeeded;
+
+		if (pass.bCulled)
+		{
+			++mCompileStats.culledPassCount;
+
+			continue;
+		}
+
+		for (const uint32_t resourceId : pass.reads)
+		{
+			resourceNeeded[resourceId] = true;
+		}
+	}
+
+	// 남은 패스 기준으로 수명 계산
+	for (uint32_t passIndex = 0; passIndex < mPasses.size(); ++passIndex)
+	{
+		const Pass& pass = mPasses[passIndex];
+
+		if (pass.bCulled)
+		{
+			continue;
+		}
+
+		for (const uint32_t resourceId : pass.reads)
+		{
+			Resource& resource = mResources[resourceId];
+
+			// 쓰기 전에 읽는 임시 리소스
+			if (!resource.bImported && resource.firstPass == INVALID_ID)
+			{
+				ASSERT(false, resource.name);
+
+				return false;
+			}
+
+			resource.lastPass = passIndex;
+		}
+
+		for (const uint32_t resourceId : pass.writes)
+		{
+			Resource& resource = mResources[resourceId];
+
+			if (resource.firstPass == INVALID_ID)
+			{
+				resource.firstPass = passIndex;
+			}
+
+			resource.lastPass = passIndex;
+		}
+	}
+
+	// 시작 순서대로 수명이 끝난 같은 설명의 텍스처에 배정
+	std::vector<uint32_t> transientIds;
+	transientIds.reserve(mResources.size());
+
+	for (uint32_t i = 0; i < mResources.size(); ++i)
+	{
+		if (!mResources[i].bImported && mResources[i].firstPass != INVALID_ID)
+		{
+			transientIds.push_back(i);
+		}
+	}
+
+	std::stable_sort(transientIds.begin(), transientIds.end(), [this](const uint32_t lhs, const uint32_t rhs)
+		{
+			return mResources[lhs].firstPass < mResources[rhs].firstPass;
+		});
+
+	std::vector<uint32_t> physicalLastPass;
+	physicalLastPass.reserve(transientIds.size());
+
+	for (const uint32_t resourceId : transientIds)
+	{
+		Resource& resource = mResources[resourceId];
+
+		for (uint32_t i = 0; i < mPhysicalDescs.size(); ++i)
+		{
+			if (physicalLastPass[i] < resource.firstPass && IsSameTextureDesc(mPhysicalDescs[i], resource.desc))
+			{
+				resource.physicalIndex = i;
+				physicalLastPass[i] = resource.lastPass;
+
+				break;
+			}
+		}
+
+		if (resource.physicalIndex == INVALID_ID)
+		{
+			resource.physicalIndex = static_cast<uint32_t>(mPhysicalDescs.size());
+
+			mPhysicalDescs.push_back(resource.desc);
+			physicalLastPass.push_back(resource.lastPass);
+
+			mCompileStats.allocatedBytes += GetTextureByteSize(resource.desc);
+		}
+
+		mCompileStats.requestedBytes += GetTextureByteSize(resource.desc);
+	}
+
+	mCompileStats.transientCount = static_cast<uint32_t>(transientIds.size());
+	mCompileStats.physicalCount = static_cast<uint32_t>(mPhysicalDescs.size());
+
+	mbCompiled = true;
+
+	return true;
+}
+
+void FrameGraph::Execute(RHI::Device& device, TransientTexturePool& pool, RHI::CommandList& commandList)
+{
+	ASSERT(mbCompiled);
+
+	mPhysicalTextures.resize(mPhysicalDescs.size());
+
+	for (size_t i = 0; i < mPhysicalDescs.size(); ++i)
+	{
+		mPhysicalTextures[i] = pool.Acquire(mPhysicalDescs[i]);
+	}
+
+	for (const Pass& pass : mPasses)
+	{
+		if (pass.bCulled)
+		{
+			continue;
+		}
+
+		commandList.Reset();
+
+		pass.execute(commandList, *this);
+
+		device.Submit(commandList);
+		commandList.Reset();
+	}
+
+	pool.EndFrame();
+}
+
+RHI::TextureHandle FrameGraph::GetTexture(const ResourceHandle resource) const
+{
+	ASSERT(resource.id < mResources.size());
+
+	const Resource& res = mResources[resource.id];
+
+	if (res.bImported)
+	{
+		return res.importedTexture;
+	}
+
+	ASSERT(res.physicalIndex < mPhysicalTextures.size());
+
+	return mPhysicalTextures[res.physicalIndex];
+}
+
+bool FrameGraph::IsPassCulled(const uint32_t passIndex) const
+{
+	ASSERT(mbCompiled);
+	ASSERT(passIndex < mPasses.size());
+
+	return mPasses[passIndex].bCulled;
+}
+
+uint32_t FrameGraph::GetPhysicalIndex(const ResourceHandle resource) const
+{
+	ASSERT(mbCompiled);
+	ASSERT(resource.id < mResources.size());
+
+	return mResources[resource.id].physicalIndex;
+}
+
+uint64_t FrameGraph::GetTextureByteSize(const RHI::TextureDesc& desc)
+{
+	const uint64_t sampleCount = desc.sampleCount > 0 ? desc.sampleCount : 1;
+
+	return static_cast<uint64_t>(desc.width) * desc.height * RHI::GetFormatByteSize(desc.format) * sampleCount;
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "Core/Assert.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/RHICommandList.h"
+
+// 프레임 사이에 유지되는 임시 렌더 타겟 풀
+// 같은 설명의 텍스처를 다시 쓰고 오래 안 쓰인 것은 해제함
+class TransientTexturePool final
+{
+public:
+	TransientTexturePool(RHI::Device& device);
+	~TransientTexturePool();
+
+	RHI::TextureHandle Acquire(const RHI::TextureDesc& desc);
+
+	// 이번 프레임에 빌려간 텍스처를 돌려받고 오래된 텍스처 해제
+	void EndFrame();
+	void Clear();
+
+	inline uint32_t GetTextureCount() const
+	{
+		return static_cast<uint32_t>(mEntries.size());
+	}
+
+private:
+	enum
+	{
+		MAX_UNUSED_FRAME_COUNT = 4
+	};
+
+	struct Entry
+	{
+		RHI::TextureDesc desc;
+		RHI::TextureHandle texture;
+		uint32_t unusedFrameCount;
+		bool bInUse;
+	};
+
+private:
+	RHI::Device& mDevice;
+
+	std::vector<Entry> mEntries;
+
+private:
+	TransientTexturePool(const TransientTexturePool& other) = delete;
+	TransientTexturePool(TransientTexturePool&& other) = delete;
+	TransientTexturePool& operator=(const TransientTexturePool& other) = delete;
+	TransientTexturePool& operator=(TransientTexturePool&& other) = delete;
+};
+
+// 패스가 읽고 쓰는 리소스를 선언하면 Compile에서
+// 안 쓰이는 패스를 제거하고 수명이 겹치지 않는 임시 타겟을 한 텍스처로 합침
+// Compile은 디바이스를 건드리지 않으므로 CPU만으로 검증할 수 있음
+class FrameGraph final
+{
+public:
+	enum
+	{
+		INVALID_ID = 0xFFFFFFFF
+	};
+
+	struct ResourceHandle
+	{
+		uint32_t id;
+
+		constexpr bool IsValid() const
+		{
+			return id != INVALID_ID;
+		}
+	};
+
+	typedef std::function<void(RHI::CommandList&, const FrameGraph&)> ExecuteFunction;
+
+	class PassBuilder final
+	{
+	public:
+		PassBuilder(FrameGraph& frameGraph, const uint32_t passIndex);
+
+		void Read(const ResourceHandle resource);
+		void Write(const ResourceHandle resource);
+
+		// 출력이 없어도 제거되지 않음
+		void SetSideEffect();
+
+	private:
+		FrameGraph& mFrameGraph;
+		uint32_t mPassIndex;
+	};
+
+	struct CompileStats
+	{
+		uint32_t passCount;
+		uint32_t culledPassCount;
+		uint32_t transientCount;
+		uint32_t physicalCount;
+		uint64_t requestedBytes;
+		uint64_t allocatedBytes;
+	};
+
+public:
+	FrameGraph();
+	~FrameGraph() = default;
+
+	void Reset();
+
+	ResourceHandle CreateTexture(const char* const name, const RHI::TextureDesc& desc);
+	ResourceHandle ImportTexture(const char* const name, const RHI::TextureHandle texture);
+
+	PassBuilder AddPass(const char* const name, ExecuteFunction execute);
+
+	bool Compile();
+
+	// 패스마다 commandList에 기록하고 제출
+	void Execute(RHI::Device& device, TransientTexturePool& pool, RHI::CommandList& commandList);
+
+	RHI::TextureHandle GetTexture(const ResourceHandle resource) const;
+
+	bool IsPassCulled(const uint32_t passIndex) const;
+	uint32_t GetPhysicalIndex(const ResourceHandle resource) const;
+
+	inline uint32_t GetPassCount() const
+	{
+		return static_cast<uint32_t>(mPasses.size());
+	}
+
+	inline const char* GetPassName(const uint32_t passIndex) const
+	{
+		ASSERT(passIndex < mPasses.size());
+
+		return mPasses[passIndex].name;
+	}
+
+	inline const CompileStats& GetCompileStats() const
+	{
+		return mCompileStats;
+	}
+
+	// static
+	static uint64_t GetTextureByteSize(const RHI::TextureDesc& desc);
+
+private:
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct Resource
+	{
+		const char* name;
+		RHI::TextureDesc desc;
+		RHI::TextureHandle importedTexture;
+		bool bImported;
+
+		uint32_t firstPass;
+		uint32_t lastPass;
+		uint32_t physicalIndex;
+	};
+
+	struct Pass
+	{
+		const char* name;
+		ExecuteFunction execute;
+
+		std::vector<uint32_t> reads;
+		std::vector<uint32_t> writes;
+
+		bool bSideEffect;
+		bool bCulled;
+	};
+#pragma warning(pop)
+
+private:
+	std::vector<Resource> mResources;
+	std::vector<Pass> mPasses;
+
+	std::vector<RHI::TextureDesc> mPhysicalDescs;
+	std::vector<RHI::TextureHandle> mPhysicalTextures;
+
+	bool mbCompiled;
+	CompileStats mCompileStats;
+
+private:
+	FrameGraph(const FrameGraph& other) = delete;
+	FrameGraph(FrameGraph&& other) = delete;
+	FrameGraph& operator=(const FrameGraph& other) = delete;
+	FrameGraph& operator=(FrameGraph&& other) = delete;
+};
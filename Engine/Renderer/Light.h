@@ -2,11 +2,6 @@
 
 #include "Core/MathHelper.h"
 
-enum
-{
-	MAX_LIGHTS = 8
-};
-
 struct Light
 {
 	Vector3 position;
@@ -0,0 +1,262 @@
+#include "LightClusterer.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Core/Assert.h"
+#include "Core/JobSystem.h"
+
+enum
+{
+	MIN_LIGHTS_PER_CHUNK = 256
+};
+
+LightClusterer::LightClusterer()
+	: mLightBounds()
+	, mClusterLightCounts(CLUSTER_COUNT, 0)
+	, mClusterLightSlots(CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER, 0)
+	, mSliceOverflowCounts{ 0, }
+	, mClusterRanges(CLUSTER_COUNT, { 0, 0 })
+	, mLightIndices()
+	, mVisibleLightIndices()
+	, mSliceScale(0.f)
+	, mSliceBias(0.f)
+	, mStats{}
+{
+
+}
+
+void LightClusterer::Build(const Light* const pLights, const uint32_t lightCount, const Camera& camera, const uint32_t threadCount)
+{
+	ASSERT(pLights != nullptr || lightCount == 0);
+	ASSERT(camera.nearZ > 0.f);
+	ASSERT(camera.farZ > camera.nearZ);
+	ASSERT(threadCount >= 1);
+
+	mStats = {};
+	mStats.lightCount = lightCount;
+
+	// 지수 분할: slice = Z * log(z / near) / log(far / near)
+	const float logDepthRange = logf(camera.farZ / camera.nearZ);
+
+	mSliceScale = CLUSTER_COUNT_Z / logDepthRange;
+	mSliceBias = -CLUSTER_COUNT_Z * logf(camera.nearZ) / logDepthRange;
+
+	mLightBounds.resize(lightCount);
+
+	const bool bParallel = threadCount > 1 && JobSystem::IsInitialized();
+
+	// 1. 빛마다 닿는 클러스터 범위
+	if (bParallel)
+	{
+		const uint32_t maxChunkCount = (lightCount + MIN_LIGHTS_PER_CHUNK - 1) / MIN_LIGHTS_PER_CHUNK;
+
+		JobSystem::GetInstance().ParallelFor(lightCount, threadCount < maxChunkCount ? threadCount : maxChunkCount, [this, pLights, &camera](const uint32_t begin, const uint32_t end, const uint32_t)
+			{
+				computeLightBounds(pLights, begin, end, camera);
+			});
+	}
+	else
+	{
+		computeLightBounds(pLights, 0, lightCount, camera);
+	}
+
+	// 2. 슬라이스마다 한 스레드가 맡아서 기록하므로 원자 연산이 필요 없음
+	if (bParallel)
+	{
+		JobSystem::GetInstance().ParallelFor(CLUSTER_COUNT_Z, threadCount, [this, lightCount](const uint32_t begin, const uint32_t end, const uint32_t)
+			{
+				binSlices(lightCount, begin, end);
+			});
+	}
+	else
+	{
+		binSlices(lightCount, 0, CLUSTER_COUNT_Z);
+	}
+
+	// 3. 업로드할 연속된 목록으로 압축
+	mLightIndices.clear();
+
+	for (uint32_t i = 0; i < CLUSTER_COUNT; ++i)
+	{
+		const uint32_t count = mClusterLightCounts[i];
+
+		mClusterRanges[i].offset = static_cast<uint32_t>(mLightIndices.size());
+		mClusterRanges[i].count = count;
+
+		const uint32_t* const pSlots = &mClusterLightSlots[i * MAX_LIGHTS_PER_CLUSTER];
+		mLightIndices.insert(mLightIndices.end(), pSlots, pSlots + count);
+
+		if (count > mStats.maxLightsPerCluster)
+		{
+			mStats.maxLightsPerCluster = count;
+		}
+	}
+
+	for (uint32_t i = 0; i < CLUSTER_COUNT_Z; ++i)
+	{
+		mStats.overflowCount += mSliceOverflowCounts[i];
+	}
+
+	mVisibleLightIndices.clear();
+
+	for (uint32_t i = 0; i < lightCount; ++i)
+	{
+		if (mLightBounds[i].minZ <= mLightBounds[i].maxZ)
+		{
+			mVisibleLightIndices.push_back(i);
+		}
+	}
+
+	mStats.visibleLightCount = static_cast<uint32_t>(mVisibleLightIndices.size());
+
+	mStats.indexCount = static_cast<uint32_t>(mLightIndices.size());
+}
+
+void LightClusterer::computeLightBounds(const Light* const pLights, const uint32_t begin, const uint32_t end, const Camera& camera)
+{
+	const XMMATRIX view = camera.view;
+
+	// (minX, maxX, minY, maxY) 순서로 네 성분을 한 번에 계산
+	const XMVECTOR projScale = XMVectorSet(camera.projScaleX, camera.projScaleX, camera.projScaleY, camera.projScaleY);
+	const XMVECTOR tileScale = XMVectorSet(0.5f * CLUSTER_COUNT_X, 0.5f * CLUSTER_COUNT_X, -0.5f * CLUSTER_COUNT_Y, -0.5f * CLUSTER_COUNT_Y);
+	const XMVECTOR tileBias = XMVectorSet(0.5f * CLUSTER_COUNT_X, 0.5f * CLUSTER_COUNT_X, 0.5f * CLUSTER_COUNT_Y, 0.5f * CLUSTER_COUNT_Y);
+	const XMVECTOR maxComponentMask = XMVectorSelectControl(0, 1, 0, 1);
+
+	const LightBounds invisible = { 0, -1, 0, -1, 0, -1 };
+
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const Light& light = pLights[i];
+		LightBounds& bounds = mLightBounds[i];
+
+		const XMVECTOR centerView = XMVector3TransformCoord(XMLoadFloat3(&light.position), view);
+		const float radius = light.falloffEnd;
+
+		const float centerZ = XMVectorGetZ(centerView);
+		const float minZ = centerZ - radius;
+		const float maxZ = centerZ + radius;
+
+		if (maxZ < camera.nearZ || minZ > camera.farZ)
+		{
+			bounds = invisible;
+
+			continue;
+		}
+
+		bounds.minZ = getSlice(minZ > camera.nearZ ? minZ : camera.nearZ);
+		bounds.maxZ = getSlice(maxZ < camera.farZ ? maxZ : camera.farZ);
+
+		// 카메라가 구 안쪽이나 근평면에 걸치면 화면 전체
+		if (!camera.bOrthographic && minZ <= camera.nearZ)
+		{
+			bounds.minX = 0;
+			bounds.maxX = CLUSTER_COUNT_X - 1;
+			bounds.minY = 0;
+			bounds.maxY = CLUSTER_COUNT_Y - 1;
+
+			continue;
+		}
+
+		XMVECTOR edges = XMVectorAdd(
+			XMVectorSwizzle<0, 0, 1, 1>(centerView),
+			XMVectorSet(-radius, radius, -radius, radius)
+		);
+
+		if (!camera.bOrthographic)
+		{
+			// 가장 넓게 투영되도록 바깥쪽 가장자리는 가까운 z로 나눔
+			const XMVECTOR bNegative = XMVectorLess(edges, XMVectorZero());
+			const XMVECTOR bUseNearZ = XMVectorXorInt(bNegative, maxComponentMask);
+
+			edges = XMVectorDivide(edges, XMVectorSelect(XMVectorReplicate(maxZ), XMVectorReplicate(minZ), bUseNearZ));
+		}
+
+		// NDC -> 타일, y는 화면 아래 방향이라 min/max가 뒤바뀜
+		const XMVECTOR tiles = XMVectorFloor(XMVectorMultiplyAdd(XMVectorMultiply(edges, projScale), tileScale, tileBias));
+
+		XMFLOAT4 tileRange;
+		XMStoreFloat4(&tileRange, tiles);
+
+		if (tileRange.y < 0.f || tileRange.x >= CLUSTER_COUNT_X || tileRange.z < 0.f || tileRange.w >= CLUSTER_COUNT_Y)
+		{
+			bounds = invisible;
+
+			continue;
+		}
+
+		const XMVECTOR clamped = XMVectorClamp(
+			tiles,
+			XMVectorZero(),
+			XMVectorSet(CLUSTER_COUNT_X - 1.f, CLUSTER_COUNT_X - 1.f, CLUSTER_COUNT_Y - 1.f, CLUSTER_COUNT_Y - 1.f)
+		);
+
+		XMINT4 tileIndices;
+		XMStoreSInt4(&tileIndices, XMConvertVectorFloatToInt(clamped, 0));
+
+		bounds.minX = tileIndices.x;
+		bounds.maxX = tileIndices.y;
+		bounds.minY = tileIndices.w;
+		bounds.maxY = tileIndices.z;
+	}
+}
+
+void LightClusterer::binSlices(const uint32_t lightCount, const uint32_t beginSlice, const uint32_t endSlice)
+{
+	constexpr uint32_t CLUSTERS_PER_SLICE = CLUSTER_COUNT_X * CLUSTER_COUNT_Y;
+
+	for (uint32_t slice = beginSlice; slice < endSlice; ++slice)
+	{
+		uint32_t* const pCounts = &mClusterLightCounts[slice * CLUSTERS_PER_SLICE];
+		memset(pCounts, 0, sizeof(uint32_t) * CLUSTERS_PER_SLICE);
+
+		uint32_t overflowCount = 0;
+
+		const int32_t sliceIndex = static_cast<int32_t>(slice);
+
+		for (uint32_t i = 0; i < lightCount; ++i)
+		{
+			const LightBounds& bounds = mLightBounds[i];
+
+			if (sliceIndex < bounds.minZ || sliceIndex > bounds.maxZ)
+			{
+				continue;
+			}
+
+			for (int32_t y = bounds.minY; y <= bounds.maxY; ++y)
+			{
+				for (int32_t x = bounds.minX; x <= bounds.maxX; ++x)
+				{
+					const uint32_t localIndex = y * CLUSTER_COUNT_X + x;
+					const uint32_t clusterIndex = slice * CLUSTERS_PER_SLICE + localIndex;
+
+					uint32_t& count = pCounts[localIndex];
+
+					if (count < MAX_LIGHTS_PER_CLUSTER)
+					{
+						mClusterLightSlots[clusterIndex * MAX_LIGHTS_PER_CLUSTER + count] = i;
+						++count;
+					}
+					else
+					{
+						++overflowCount;
+					}
+				}
+			}
+		}
+
+		mSliceOverflowCounts[slice] = overflowCount;
+	}
+}
+
+int32_t LightClusterer::getSlice(const float viewZ) const
+{
+	const int32_t slice = static_cast<int32_t>(floorf(logf(viewZ) * mSliceScale + mSliceBias));
+
+	if (slice < 0)
+	{
+		return 0;
+	}
+
+	return slice < CLUSTER_COUNT_Z ? slice : CLUSTER_COUNT_Z - 1;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+
+#include "Core/MathHelper.h"
+#include "Light.h"
+
+// 뷰 절두체를 화면 타일 x 지수 깊이 슬라이스 격자로 나누고
+// 클러스터마다 닿을 수 있는 빛의 인덱스 목록을 만듦
+class LightClusterer final
+{
+public:
+	enum
+	{
+		CLUSTER_COUNT_X = 16,
+		CLUSTER_COUNT_Y = 8,
+		CLUSTER_COUNT_Z = 24,
+		CLUSTER_COUNT = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z,
+
+		MAX_LIGHTS_PER_CLUSTER = 128
+	};
+
+	// 셰이더의 uint2와 같은 배치
+	struct ClusterRange
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct Camera
+	{
+		Matrix view;
+
+		// 투영 행렬의 _11, _22
+		float projScaleX;
+		float projScaleY;
+
+		float nearZ;
+		float farZ;
+
+		bool bOrthographic;
+	};
+#pragma warning(pop)
+
+	struct Stats
+	{
+		uint32_t lightCount;
+		uint32_t visibleLightCount;
+		uint32_t indexCount;
+		uint32_t maxLightsPerCluster;
+		uint32_t overflowCount;
+	};
+
+public:
+	LightClusterer();
+	~LightClusterer() = default;
+
+	// threadCount가 1보다 크면 JobSystem으로 나눠서 처리
+	void Build(const Light* const pLights, const uint32_t lightCount, const Camera& camera, const uint32_t threadCount);
+
+	inline const std::vector<ClusterRange>& GetClusterRanges() const
+	{
+		return mClusterRanges;
+	}
+
+	inline const std::vector<uint32_t>& GetLightIndices() const
+	{
+		return mLightIndices;
+	}
+
+	// 절두체에 걸치는 빛의 인덱스
+	inline const std::vector<uint32_t>& GetVisibleLightIndices() const
+	{
+		return mVisibleLightIndices;
+	}
+
+	// slice = log(viewZ) * scale + bias
+	inline float GetSliceScale() const
+	{
+		return mSliceScale;
+	}
+
+	inline float GetSliceBias() const
+	{
+		return mSliceBias;
+	}
+
+	inline const Stats& GetStats() const
+	{
+		return mStats;
+	}
+
+private:
+	// 빛이 닿는 클러스터 범위, minZ > maxZ면 보이지 않음
+	struct LightBounds
+	{
+		int32_t minX;
+		int32_t maxX;
+		int32_t minY;
+		int32_t maxY;
+		int32_t minZ;
+		int32_t maxZ;
+	};
+
+private:
+	std::vector<LightBounds> mLightBounds;
+
+	// 클러스터마다 MAX_LIGHTS_PER_CLUSTER칸씩 잡아둔 임시 목록
+	std::vector<uint32_t> mClusterLightCounts;
+	std::vector<uint32_t> mClusterLightSlots;
+	uint32_t mSliceOverflowCounts[CLUSTER_COUNT_Z];
+
+	std::vector<ClusterRange> mClusterRanges;
+	std::vector<uint32_t> mLightIndices;
+	std::vector<uint32_t> mVisibleLightIndices;
+
+	float mSliceScale;
+	float mSliceBias;
+
+	Stats mStats;
+
+private:
+	void computeLightBounds(const Light* const pLights, const uint32_t begin, const uint32_t end, const Camera& camera);
+	void binSlices(const uint32_t lightCount, const uint32_t beginSlice, const uint32_t endSlice);
+
+	int32_t getSlice(const float viewZ) const;
+
+private:
+	LightClusterer(const LightClusterer& other) = delete;
+	LightClusterer(LightClusterer&& other) = delete;
+	LightClusterer& operator=(const LightClusterer& other) = delete;
+	LightClusterer& operator=(LightClusterer&& other) = delete;
+};
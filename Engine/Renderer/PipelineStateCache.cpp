@@ -0,0 +1,325 @@
+#include "PipelineStateCache.h"
+
+#include <cstring>
+
+#include "Core/HashHelper.h"
+
+enum
+{
+	DEFAULT_BUFFER_SIZE = 16
+};
+
+// 설명 구조체에 패딩이 있어서 바이트 대신 필드 단위로 해시
+static uint64_t HashDesc(const RHI::RasterizerDesc& desc)
+{
+	uint64_t hash = FNV_OFFSET_BASIS;
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.fillMode));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.cullMode));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.bDepthClipEnable));
+
+	return hash;
+}
+
+static uint64_t HashDesc(const RHI::SamplerDesc& desc)
+{
+	uint32_t maxLODBits;
+	memcpy(&maxLODBits, &desc.maxLOD, sizeof(maxLODBits));
+
+	uint64_t hash = FNV_OFFSET_BASIS;
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.filter));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.addressMode));
+	hash = HashCombine(hash, static_cast<uint64_t>(maxLODBits));
+
+	return hash;
+}
+
+static uint64_t HashDesc(const RHI::BlendDesc& desc)
+{
+	uint64_t hash = FNV_OFFSET_BASIS;
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.bBlendEnable));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.srcBlend));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.destBlend));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.blendOp));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.srcBlendAlpha));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.destBlendAlpha));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.blendOpAlpha));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.renderTargetWriteMask));
+
+	return hash;
+}
+
+static uint64_t HashDesc(const RHI::DepthStencilDesc& desc)
+{
+	uint64_t hash = FNV_OFFSET_BASIS;
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.bDepthEnable));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.bDepthWriteEnable));
+	hash = HashCombine(hash, static_cast<uint64_t>(desc.depthFunc));
+
+	return hash;
+}
+
+static bool IsSameDesc(const RHI::RasterizerDesc& a, const RHI::RasterizerDesc& b)
+{
+	return a.fillMode == b.fillMode
+		&& a.cullMode == b.cullMode
+		&& a.bDepthClipEnable == b.bDepthClipEnable;
+}
+
+static bool IsSameDesc(const RHI::SamplerDesc& a, const RHI::SamplerDesc& b)
+{
+	return a.filter == b.filter
+		&& a.addressMode == b.addressMode
+		&& memcmp(&a.maxLOD, &b.maxLOD, sizeof(float)) == 0;
+}
+
+static bool IsSameDesc(const RHI::BlendDesc& a, const RHI::BlendDesc& b)
+{
+	return a.bBlendEnable == b.bBlendEnable
+		&& a.srcBlend == b.srcBlend
+		&& a.destBlend == b.destBlend
+		&& a.blendOp == b.blendOp
+		&& a.srcBlendAlpha == b.srcBlendAlpha
+		&& a.destBlendAlpha == b.destBlendAlpha
+		&& a.blendOpAlpha == b.blendOpAlpha
+		&& a.renderTargetWriteMask == b.renderTargetWriteMask;
+}
+
+static bool IsSameDesc(const RHI::DepthStencilDesc& a, const RHI::DepthStencilDesc& b)
+{
+	return a.bDepthEnable == b.bDepthEnable
+		&& a.bDepthWriteEnable == b.bDepthWriteEnable
+		&& a.depthFunc == b.depthFunc;
+}
+
+// 네 종류가 같은 흐름이라 생성 함수만 받아서 처리
+template<typename TDesc, typename THandle, typename TCreateFunction>
+static PipelineStateCache::StateID FindOrCreateState(
+	std::vector<TDesc>& descs,
+	std::vector<THandle>& handles,
+	std::unordered_map<uint64_t, PipelineStateCache::StateID>& idMap,
+	PipelineStateCache::Stats& stats,
+	const TDesc& desc,
+	const TCreateFunction& create
+)
+{
+	++stats.stateRequestCount;
+
+	const uint64_t hash = HashDesc(desc);
+
+	const std::unordered_map<uint64_t, PipelineStateCache::StateID>::const_iterator iter = idMap.find(hash);
+
+	if (iter != idMap.end())
+	{
+		if (IsSameDesc(descs[iter->second], desc))
+		{
+			++stats.stateHitCount;
+
+			return iter->second;
+		}
+
+		// 해시 충돌, 드물어서 전부 비교
+		for (size_t i = 0; i < descs.size(); ++i)
+		{
+			if (IsSameDesc(descs[i], desc))
+			{
+				++stats.stateHitCount;
+
+				return static_cast<PipelineStateCache::StateID>(i);
+			}
+		}
+	}
+
+	if (descs.size() >= PipelineStateCache::INVALID_STATE_ID)
+	{
+		ASSERT(false, "too many pipeline states");
+
+		return PipelineStateCache::INVALID_STATE_ID;
+	}
+
+	const THandle handle = create(desc);
+
+	if (!handle.IsValid())
+	{
+		return PipelineStateCache::INVALID_STATE_ID;
+	}
+
+	const PipelineStateCache::StateID id = static_cast<PipelineStateCache::StateID>(descs.size());
+
+	descs.push_back(desc);
+	handles.push_back(handle);
+
+	// 충돌한 설명은 맵에 넣지 않음, 먼저 들어간 쪽이 빠른 경로를 가짐
+	idMap.insert(std::make_pair(hash, id));
+
+	return id;
+}
+
+PipelineStateCache::PipelineStateCache(RHI::Device& device)
+	: mDevice(device)
+	, mRasterizerDescs()
+	, mRasterizerStates()
+	, mRasterizerIDMap()
+	, mSamplerDescs()
+	, mSamplerStates()
+	, mSamplerIDMap()
+	, mBlendDescs()
+	, mBlendStates()
+	, mBlendIDMap()
+	, mDepthStencilDescs()
+	, mDepthStencilStates()
+	, mDepthStencilIDMap()
+	, mPipelineDescs()
+	, mPipelineStates()
+	, mPipelineIDMap()
+	, mStats{}
+{
+	mPipelineDescs.reserve(DEFAULT_BUFFER_SIZE);
+	mPipelineStates.reserve(DEFAULT_BUFFER_SIZE);
+	mPipelineIDMap.reserve(DEFAULT_BUFFER_SIZE);
+}
+
+PipelineStateCache::~PipelineStateCache()
+{
+	Clear();
+}
+
+PipelineStateCache::StateID PipelineStateCache::GetRasterizerStateID(const RHI::RasterizerDesc& desc)
+{
+	const StateID id = FindOrCreateState(mRasterizerDescs, mRasterizerStates, mRasterizerIDMap, mStats, desc,
+		[this](const RHI::RasterizerDesc& stateDesc)
+		{
+			return mDevice.CreateRasterizerState(stateDesc);
+		});
+
+	mStats.rasterizerCount = static_cast<uint32_t>(mRasterizerStates.size());
+
+	return id;
+}
+
+PipelineStateCache::StateID PipelineStateCache::GetSamplerStateID(const RHI::SamplerDesc& desc)
+{
+	const StateID id = FindOrCreateState(mSamplerDescs, mSamplerStates, mSamplerIDMap, mStats, desc,
+		[this](const RHI::SamplerDesc& stateDesc)
+		{
+			return mDevice.CreateSamplerState(stateDesc);
+		});
+
+	mStats.samplerCount = static_cast<uint32_t>(mSamplerStates.size());
+
+	return id;
+}
+
+PipelineStateCache::StateID PipelineStateCache::GetBlendStateID(const RHI::BlendDesc& desc)
+{
+	const StateID id = FindOrCreateState(mBlendDescs, mBlendStates, mBlendIDMap, mStats, desc,
+		[this](const RHI::BlendDesc& stateDesc)
+		{
+			return mDevice.CreateBlendState(stateDesc);
+		});
+
+	mStats.blendCount = static_cast<uint32_t>(mBlendStates.size());
+
+	return id;
+}
+
+PipelineStateCache::StateID PipelineStateCache::GetDepthStencilStateID(const RHI::DepthStencilDesc& desc)
+{
+	const StateID id = FindOrCreateState(mDepthStencilDescs, mDepthStencilStates, mDepthStencilIDMap, mStats, desc,
+		[this](const RHI::DepthStencilDesc& stateDesc)
+		{
+			return mDevice.CreateDepthStencilState(stateDesc);
+		});
+
+	mStats.depthStencilCount = static_cast<uint32_t>(mDepthStencilStates.size());
+
+	return id;
+}
+
+PipelineStateCache::PipelineID PipelineStateCache::GetPipelineID(const PipelineDesc& desc)
+{
+	ASSERT(desc.rasterizer < mRasterizerStates.size());
+	ASSERT(desc.sampler < mSamplerStates.size());
+	ASSERT(desc.blend < mBlendStates.size());
+	ASSERT(desc.depthStencil < mDepthStencilStates.size());
+
+	const uint64_t key = static_cast<uint64_t>(desc.rasterizer)
+		| (static_cast<uint64_t>(desc.sampler) << 16)
+		| (static_cast<uint64_t>(desc.blend) << 32)
+		| (static_cast<uint64_t>(desc.depthStencil) << 48);
+
+	++mStats.pipelineRequestCount;
+
+#define MAP_ITER std::unordered_map<uint64_t, PipelineID>::const_iterator
+
+	MAP_ITER iter = mPipelineIDMap.find(key);
+
+	if (iter != mPipelineIDMap.end())
+	{
+		++mStats.pipelineHitCount;
+
+		return iter->second;
+	}
+
+#undef MAP_ITER
+
+	const PipelineID id = static_cast<PipelineID>(mPipelineDescs.size());
+
+	PipelineState state;
+	state.rasterizer = mRasterizerStates[desc.rasterizer];
+	state.sampler = mSamplerStates[desc.sampler];
+	state.blend = mBlendStates[desc.blend];
+	state.depthStencil = mDepthStencilStates[desc.depthStencil];
+
+	mPipelineDescs.push_back(desc);
+	mPipelineStates.push_back(state);
+	mPipelineIDMap.insert(std::make_pair(key, id));
+
+	mStats.pipelineCount = static_cast<uint32_t>(mPipelineStates.size());
+
+	return id;
+}
+
+void PipelineStateCache::Clear()
+{
+	for (const RHI::DepthStencilStateHandle state : mDepthStencilStates)
+	{
+		mDevice.DestroyDepthStencilState(state);
+	}
+
+	for (const RHI::BlendStateHandle state : mBlendStates)
+	{
+		mDevice.DestroyBlendState(state);
+	}
+
+	for (const RHI::SamplerStateHandle state : mSamplerStates)
+	{
+		mDevice.DestroySamplerState(state);
+	}
+
+	for (const RHI::RasterizerStateHandle state : mRasterizerStates)
+	{
+		mDevice.DestroyRasterizerState(state);
+	}
+
+	mRasterizerDescs.clear();
+	mRasterizerStates.clear();
+	mRasterizerIDMap.clear();
+
+	mSamplerDescs.clear();
+	mSamplerStates.clear();
+	mSamplerIDMap.clear();
+
+	mBlendDescs.clear();
+	mBlendStates.clear();
+	mBlendIDMap.clear();
+
+	mDepthStencilDescs.clear();
+	mDepthStencilStates.clear();
+	mDepthStencilIDMap.clear();
+
+	mPipelineDescs.clear();
+	mPipelineStates.clear();
+	mPipelineIDMap.clear();
+
+	mStats = {};
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "Core/Assert.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/RHICommandList.h"
+
+// 상태 설명을 해시로 중복 제거하고 처음 요청될 때 만들어서 작은 ID로 돌려줌
+// ID로 핸들을 찾는 것은 배열 인덱싱, 해시는 설명을 등록할 때만 계산
+// 등록은 메인 스레드에서만, 조회는 기록 스레드에서 동시에 해도 됨
+class PipelineStateCache final
+{
+public:
+	using StateID = uint16_t;
+	using PipelineID = uint32_t;
+
+	enum : uint32_t
+	{
+		INVALID_STATE_ID = 0xFFFF,
+		INVALID_PIPELINE_ID = 0xFFFFFFFF
+	};
+
+	// 네 상태 ID의 조합, 같은 조합은 같은 PipelineID
+	struct PipelineDesc
+	{
+		StateID rasterizer;
+		StateID sampler;
+		StateID blend;
+		StateID depthStencil;
+	};
+
+	struct PipelineState
+	{
+		RHI::RasterizerStateHandle rasterizer;
+		RHI::SamplerStateHandle sampler;
+		RHI::BlendStateHandle blend;
+		RHI::DepthStencilStateHandle depthStencil;
+	};
+
+	struct Stats
+	{
+		uint32_t rasterizerCount;
+		uint32_t samplerCount;
+		uint32_t blendCount;
+		uint32_t depthStencilCount;
+		uint32_t pipelineCount;
+
+		// 상태 객체(Get*StateID) 요청 수와 그중 이미 있던 설명 수
+		uint32_t stateRequestCount;
+		uint32_t stateHitCount;
+
+		// 파이프라인(GetPipelineID) 요청 수와 그중 이미 있던 조합 수
+		uint32_t pipelineRequestCount;
+		uint32_t pipelineHitCount;
+	};
+
+public:
+	PipelineStateCache(RHI::Device& device);
+	~PipelineStateCache();
+
+	// 없으면 만듦, 실패하면 INVALID_STATE_ID
+	StateID GetRasterizerStateID(const RHI::RasterizerDesc& desc);
+	StateID GetSamplerStateID(const RHI::SamplerDesc& desc);
+	StateID GetBlendStateID(const RHI::BlendDesc& desc);
+	StateID GetDepthStencilStateID(const RHI::DepthStencilDesc& desc);
+
+	PipelineID GetPipelineID(const PipelineDesc& desc);
+
+	inline RHI::RasterizerStateHandle GetRasterizerState(const StateID id) const
+	{
+		ASSERT(id < mRasterizerStates.size());
+
+		return mRasterizerStates[id];
+	}
+
+	inline RHI::SamplerStateHandle GetSamplerState(const StateID id) const
+	{
+		ASSERT(id < mSamplerStates.size());
+
+		return mSamplerStates[id];
+	}
+
+	inline RHI::BlendStateHandle GetBlendState(const StateID id) const
+	{
+		ASSERT(id < mBlendStates.size());
+
+		return mBlendStates[id];
+	}
+
+	inline RHI::DepthStencilStateHandle GetDepthStencilState(const StateID id) const
+	{
+		ASSERT(id < mDepthStencilStates.size());
+
+		return mDepthStencilStates[id];
+	}
+
+	inline const PipelineDesc& GetPipelineDesc(const PipelineID id) const
+	{
+		ASSERT(id < mPipelineDescs.size());
+
+		return mPipelineDescs[id];
+	}
+
+	inline const PipelineState& GetPipelineState(const PipelineID id) const
+	{
+		ASSERT(id < mPipelineStates.size());
+
+		return mPipelineStates[id];
+	}
+
+	// 네 상태를 한 번에 바인딩
+	inline void Bind(RHI::CommandList& commandList, const PipelineID id) const
+	{
+		const PipelineState& state = GetPipelineState(id);
+
+		commandList.SetRasterizerState(state.rasterizer);
+		commandList.SetPSSampler(0, state.sampler);
+		commandList.SetBlendState(state.blend);
+		commandList.SetDepthStencilState(state.depthStencil);
+	}
+
+	inline const Stats& GetStats() const
+	{
+		return mStats;
+	}
+
+	void Clear();
+
+private:
+	RHI::Device& mDevice;
+
+	// 해시가 같아도 설명을 비교해서 확인함
+	std::vector<RHI::RasterizerDesc> mRasterizerDescs;
+	std::vector<RHI::RasterizerStateHandle> mRasterizerStates;
+	std::unordered_map<uint64_t, StateID> mRasterizerIDMap;
+
+	std::vector<RHI::SamplerDesc> mSamplerDescs;
+	std::vector<RHI::SamplerStateHandle> mSamplerStates;
+	std::unordered_map<uint64_t, StateID> mSamplerIDMap;
+
+	std::vector<RHI::BlendDesc> mBlendDescs;
+	std::vector<RHI::BlendStateHandle> mBlendStates;
+	std::unordered_map<uint64_t, StateID> mBlendIDMap;
+
+	std::vector<RHI::DepthStencilDesc> mDepthStencilDescs;
+	std::vector<RHI::DepthStencilStateHandle> mDepthStencilStates;
+	std::unordered_map<uint64_t, StateID> mDepthStencilIDMap;
+
+	// 네 ID를 이어 붙인 64비트 키라 충돌이 없음
+	std::vector<PipelineDesc> mPipelineDescs;
+	std::vector<PipelineState> mPipelineStates;
+	std::unordered_map<uint64_t, PipelineID> mPipelineIDMap;
+
+	Stats mStats;
+
+private:
+	PipelineStateCache(const PipelineStateCache& other) = delete;
+	PipelineStateCache(PipelineStateCache&& other) = delete;
+	PipelineStateCache& operator=(const PipelineStateCache& other) = delete;
+	PipelineStateCache& operator=(PipelineStateCache&& other) = delete;
+};
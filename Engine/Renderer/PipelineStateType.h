@@ -117,6 +117,7 @@ constexpr const char* const GetBlendTypeName(const EBlendStateType type)
 #define DEPTH_STENCIL_STATE_LIST \
 	DEPTH_STENCIL_STATE_ENTRY(DEPTH_ENABLED, DepthEnabled) \
 	DEPTH_STENCIL_STATE_ENTRY(DEPTH_DISABLED, DepthDisabled) \
+	DEPTH_STENCIL_STATE_ENTRY(DEPTH_READ_ONLY, DepthReadOnly) \
 
 enum class EDepthStencilType : uint8_t
 {
@@ -0,0 +1,1401 @@
+#include "D3D11Device.h"
+
+#include <cstring>
+
+#include <d3dcompiler.h>
+#include <DDSTextureLoader.h>
+#include <WICTextureLoader.h>
+
+#include "Core/LogHelper.h"
+#include "Core/StringHelper.h"
+#include "Core/JobSystem.h"
+
+namespace RHI
+{
+	// RHI_FORMAT_LIST 순서와 같아야 함
+	static constexpr DXGI_FORMAT DXGI_FORMATS[] =
+	{
+		DXGI_FORMAT_UNKNOWN,
+		DXGI_FORMAT_R8G8B8A8_UNORM,
+		DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+		DXGI_FORMAT_R16G16B16A16_FLOAT,
+		DXGI_FORMAT_R16G16B16A16_UNORM,
+		DXGI_FORMAT_R32G32B32A32_FLOAT,
+		DXGI_FORMAT_R32G32B32_FLOAT,
+		DXGI_FORMAT_R32G32_FLOAT,
+		DXGI_FORMAT_R16G16_FLOAT,
+		DXGI_FORMAT_R16G16_SNORM,
+		DXGI_FORMAT_R32_FLOAT,
+		DXGI_FORMAT_R16_UINT,
+		DXGI_FORMAT_R32_UINT,
+		DXGI_FORMAT_D24_UNORM_S8_UINT,
+		DXGI_FORMAT_BC1_UNORM,
+		DXGI_FORMAT_BC3_UNORM,
+		DXGI_FORMAT_BC5_UNORM,
+		DXGI_FORMAT_BC7_UNORM,
+	};
+	static_assert(ARRAYSIZE(DXGI_FORMATS) == GetFormatCount());
+
+	static DXGI_FORMAT ToDXGIFormat(const EFormat format)
+	{
+		return DXGI_FORMATS[static_cast<int>(format)];
+	}
+
+	static EFormat FromDXGIFormat(const DXGI_FORMAT format)
+	{
+		for (int i = 0; i < GetFormatCount(); ++i)
+		{
+			if (DXGI_FORMATS[i] == format)
+			{
+				return static_cast<EFormat>(i);
+			}
+		}
+
+		// 목록에 없는 포맷(BC2, BC4 등)은 읽기 전용으로만 쓰임
+		return EFormat::UNKNOWN;
+	}
+
+	static UINT ToD3D11BindFlags(const uint32_t bindFlags)
+	{
+		UINT ret = 0;
+
+		ret |= (bindFlags & BIND_VERTEX_BUFFER) ? D3D11_BIND_VERTEX_BUFFER : 0;
+		ret |= (bindFlags & BIND_INDEX_BUFFER) ? D3D11_BIND_INDEX_BUFFER : 0;
+		ret |= (bindFlags & BIND_CONSTANT_BUFFER) ? D3D11_BIND_CONSTANT_BUFFER : 0;
+		ret |= (bindFlags & BIND_SHADER_RESOURCE) ? D3D11_BIND_SHADER_RESOURCE : 0;
+		ret |= (bindFlags & BIND_RENDER_TARGET) ? D3D11_BIND_RENDER_TARGET : 0;
+		ret |= (bindFlags & BIND_DEPTH_STENCIL) ? D3D11_BIND_DEPTH_STENCIL : 0;
+
+		return ret;
+	}
+
+	static D3D11_USAGE ToD3D11Usage(const EUsage usage)
+	{
+		switch (usage)
+		{
+		case EUsage::DEFAULT:
+			return D3D11_USAGE_DEFAULT;
+
+		case EUsage::IMMUTABLE:
+			return D3D11_USAGE_IMMUTABLE;
+
+		case EUsage::DYNAMIC:
+			return D3D11_USAGE_DYNAMIC;
+
+		default:
+			ASSERT(false);
+			return D3D11_USAGE_DEFAULT;
+		}
+	}
+
+	static D3D11_BLEND ToD3D11Blend(const EBlend blend)
+	{
+		switch (blend)
+		{
+		case EBlend::ZERO:
+			return D3D11_BLEND_ZERO;
+
+		case EBlend::ONE:
+			return D3D11_BLEND_ONE;
+
+		case EBlend::SRC_ALPHA:
+			return D3D11_BLEND_SRC_ALPHA;
+
+		case EBlend::INV_SRC_ALPHA:
+			return D3D11_BLEND_INV_SRC_ALPHA;
+
+		default:
+			ASSERT(false);
+			return D3D11_BLEND_ONE;
+		}
+	}
+
+	static D3D11_COMPARISON_FUNC ToD3D11Comparison(const EComparison comparison)
+	{
+		switch (comparison)
+		{
+		case EComparison::NEVER:
+			return D3D11_COMPARISON_NEVER;
+
+		case EComparison::LESS:
+			return D3D11_COMPARISON_LESS;
+
+		case EComparison::LESS_EQUAL:
+			return D3D11_COMPARISON_LESS_EQUAL;
+
+		case EComparison::EQUAL:
+			return D3D11_COMPARISON_EQUAL;
+
+		case EComparison::ALWAYS:
+			return D3D11_COMPARISON_ALWAYS;
+
+		default:
+			ASSERT(false);
+			return D3D11_COMPARISON_ALWAYS;
+		}
+	}
+
+	D3D11Device::D3D11Device(
+		ID3D11Device* const pDevice,
+		ID3D11DeviceContext* const pDeviceContext,
+		IDXGISwapChain1* const pSwapChain,
+		const UINT refreshRate
+	)
+		: Device()
+		, mpDevice(pDevice)
+		, mpDeviceContext(pDeviceContext)
+		, mpSwapChain(pSwapChain)
+		, mRefreshRate(refreshRate)
+		, mBuffers()
+		, mTextures()
+		, mVertexShaders()
+		, mPixelShaders()
+		, mInputLayouts()
+		, mRasterizerStates()
+		, mSamplerStates()
+		, mBlendStates()
+		, mDepthStencilStates()
+		, mBackBuffer{ 0 }
+		, mDeferredContexts()
+		, mNativeCommandLists()
+	{
+		ASSERT(pDevice != nullptr);
+		ASSERT(pDeviceContext != nullptr);
+		ASSERT(pSwapChain != nullptr);
+	}
+
+	D3D11Device::~D3D11Device()
+	{
+		mpDeviceContext->ClearState();
+
+		mNativeCommandLists.clear();
+		mDeferredContexts.clear();
+
+		if (mBackBuffer.IsValid())
+		{
+			mTextures.Free(mBackBuffer.id);
+		}
+
+		SafeRelease(mpSwapChain);
+		SafeRelease(mpDeviceContext);
+		SafeRelease(mpDevice);
+	}
+
+	BufferHandle D3D11Device::CreateBuffer(const BufferDesc& desc, const void* const pInitialDataOrNull)
+	{
+		ASSERT(desc.byteWidth > 0);
+
+		D3D11_BUFFER_DESC bufferDesc;
+		ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+
+		bufferDesc.Usage = ToD3D11Usage(desc.usage);
+		bufferDesc.ByteWidth = desc.byteWidth;
+		bufferDesc.BindFlags = ToD3D11BindFlags(desc.bindFlags);
+		bufferDesc.StructureByteStride = desc.structureByteStride;
+		bufferDesc.CPUAccessFlags = desc.usage == EUsage::DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0;
+
+		// 셰이더에서 읽는 버퍼는 구조적 버퍼로
+		const bool bStructured = (desc.bindFlags & BIND_SHADER_RESOURCE) && desc.structureByteStride > 0;
+
+		if (bStructured)
+		{
+			ASSERT(desc.byteWidth % desc.structureByteStride == 0);
+
+			bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+		}
+
+		D3D11_SUBRESOURCE_DATA initData;
+		ZeroMemory(&initData, sizeof(D3D11_SUBRESOURCE_DATA));
+
+		initData.pSysMem = pInitialDataOrNull;
+
+		BufferResource resource;
+		resource.desc = desc;
+
+		HRESULT hr = mpDevice->CreateBuffer(
+			&bufferDesc,
+			pInitialDataOrNull != nullptr ? &initData : nullptr,
+			resource.buffer.GetAddressOf()
+		);
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "CreateBuffer");
+
+			ASSERT(false);
+
+			return { 0 };
+		}
+
+		if (bStructured)
+		{
+			D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc;
+			ZeroMemory(&shaderResourceViewDesc, sizeof(shaderResourceViewDesc));
+
+			shaderResourceViewDesc.Format = DXGI_FORMAT_UNKNOWN;
+			shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+			shaderResourceViewDesc.Buffer.FirstElement = 0;
+			shaderResourceViewDesc.Buffer.NumElements = desc.byteWidth / desc.structureByteStride;
+
+			hr = mpDevice->CreateShaderResourceView(resource.buffer.Get(), &shaderResourceViewDesc, resource.shaderResourceView.GetAddressOf());
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "CreateShaderResourceView");
+
+				ASSERT(false);
+
+				return { 0 };
+			}
+		}
+
+		return { mBuffers.Allocate(std::move(resource)) };
+	}
+
+	void D3D11Device::DestroyBuffer(const BufferHandle buffer)
+	{
+		mBuffers.Free(buffer.id);
+	}
+
+	TextureHandle D3D11Device::CreateTexture(const TextureDesc& desc, const SubresourceData* const pInitialDataOrNull)
+	{
+		ASSERT(desc.width > 0);
+		ASSERT(desc.height > 0);
+		ASSERT(desc.format != EFormat::UNKNOWN);
+
+		D3D11_TEXTURE2D_DESC textureDesc;
+		ZeroMemory(&textureDesc, sizeof(D3D11_TEXTURE2D_DESC));
+
+		textureDesc.Width = desc.width;
+		textureDesc.Height = desc.height;
+		textureDesc.MipLevels = desc.mipLevels;
+		textureDesc.ArraySize = desc.arraySize;
+		textureDesc.Format = ToDXGIFormat(desc.format);
+		textureDesc.SampleDesc.Count = desc.sampleCount;
+		textureDesc.SampleDesc.Quality = 0;
+		textureDesc.Usage = ToD3D11Usage(desc.usage);
+		textureDesc.BindFlags = ToD3D11BindFlags(desc.bindFlags);
+
+		// 밉/배열 수만큼 초기 데이터가 연속으로 들어옴
+		std::vector<D3D11_SUBRESOURCE_DATA> initData;
+
+		if (pInitialDataOrNull != nullptr)
+		{
+			const uint32_t subresourceCount = desc.mipLevels * desc.arraySize;
+
+			initData.resize(subresourceCount);
+
+			for (uint32_t i = 0; i < subresourceCount; ++i)
+			{
+				initData[i].pSysMem = pInitialDataOrNull[i].pData;
+				initData[i].SysMemPitch = pInitialDataOrNull[i].rowPitch;
+				initData[i].SysMemSlicePitch = pInitialDataOrNull[i].slicePitch;
+			}
+		}
+
+		TextureResource resource;
+		resource.desc = desc;
+
+		HRESULT hr = mpDevice->CreateTexture2D(
+			&textureDesc,
+			initData.empty() ? nullptr : initData.data(),
+			resource.texture.GetAddressOf()
+		);
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "CreateTexture2D");
+
+			ASSERT(false);
+
+			return { 0 };
+		}
+
+		if (!tryCreateTextureViews(resource))
+		{
+			return { 0 };
+		}
+
+		return { mTextures.Allocate(std::move(resource)) };
+	}
+
+	TextureHandle D3D11Device::CreateTextureFromFile(const char* const path)
+	{
+		using namespace DirectX;
+
+		ASSERT(path != nullptr);
+
+		char extension[MAX_PATH];
+		GetExtension(path, extension);
+
+		for (char& c : extension)
+		{
+			c = static_cast<char>(tolower(c));
+		}
+
+		TCHAR widePath[MAX_PATH];
+		ConvertMultiToWide(widePath, path);
+
+		TextureResource resource;
+		ID3D11Resource* pResource = nullptr;
+
+		HRESULT hr;
+		if (strcmp(extension, "dds") == 0)
+		{
+			hr = CreateDDSTextureFromFile(mpDevice, widePath, &pResource, resource.shaderResourceView.GetAddressOf());
+		}
+		else
+		{
+			hr = CreateWICTextureFromFile(mpDevice, widePath, &pResource, resource.shaderResourceView.GetAddressOf());
+		}
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "CreateTextureFromFile");
+
+			return { 0 };
+		}
+
+		hr = pResource->QueryInterface(IID_PPV_ARGS(resource.texture.GetAddressOf()));
+		SafeRelease(pResource);
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "QueryInterface - ID3D11Texture2D");
+
+			ASSERT(false);
+
+			return { 0 };
+		}
+
+		D3D11_TEXTURE2D_DESC textureDesc;
+		resource.texture->GetDesc(&textureDesc);
+
+		resource.desc.width = textureDesc.Width;
+		resource.desc.height = textureDesc.Height;
+		resource.desc.mipLevels = textureDesc.MipLevels;
+		resource.desc.arraySize = textureDesc.ArraySize;
+		resource.desc.sampleCount = textureDesc.SampleDesc.Count;
+		resource.desc.bindFlags = BIND_SHADER_RESOURCE;
+		resource.desc.miscFlags = TEXTURE_MISC_NONE;
+		resource.desc.format = FromDXGIFormat(textureDesc.Format);
+		resource.desc.usage = EUsage::IMMUTABLE;
+
+		return { mTextures.Allocate(std::move(resource)) };
+	}
+
+	void D3D11Device::DestroyTexture(const TextureHandle texture)
+	{
+		ASSERT(texture != mBackBuffer);
+
+		mTextures.Free(texture.id);
+	}
+
+	TextureDesc D3D11Device::GetTextureDesc(const TextureHandle texture) const
+	{
+		return mTextures.Get(texture.id).desc;
+	}
+
+	bool D3D11Device::TryCompileShaderFromFile(
+		const char* const path,
+		const char* const entryPoint,
+		const char* const target,
+		const ShaderDefine* const pDefinesOrNull,
+		const uint32_t defineCount,
+		std::vector<uint8_t>& outBytecode
+	)
+	{
+		ASSERT(path != nullptr);
+		ASSERT(entryPoint != nullptr);
+		ASSERT(target != nullptr);
+
+		UINT shaderCompileFlags = 0;
+
+#if defined(DEBUG) || defined(_DEBUG)
+		shaderCompileFlags |= D3DCOMPILE_DEBUG;
+		shaderCompileFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+
+		ASSERT(pDefinesOrNull != nullptr || defineCount == 0);
+
+		// 끝은 { nullptr, nullptr }
+		std::vector<D3D_SHADER_MACRO> macros;
+		macros.reserve(defineCount + 1);
+
+		for (uint32_t i = 0; i < defineCount; ++i)
+		{
+			macros.push_back({ pDefinesOrNull[i].name, pDefinesOrNull[i].value });
+		}
+
+		macros.push_back({ nullptr, nullptr });
+
+		TCHAR widePath[MAX_PATH];
+		ConvertMultiToWide(widePath, path);
+
+		ID3DBlob* pBlob = nullptr;
+		ID3DBlob* pErrorBlob = nullptr;
+
+		const HRESULT hr = D3DCompileFromFile(
+			widePath,
+			macros.data(),
+			D3D_COMPILE_STANDARD_FILE_INCLUDE,
+			entryPoint,
+			target,
+			shaderCompileFlags,
+			0,
+			&pBlob,
+			&pErrorBlob
+		);
+
+		if (FAILED(hr))
+		{
+			if (pErrorBlob != nullptr)
+			{
+				LOG_SYSTEM_ERROR(hr, reinterpret_cast<const char*>(pErrorBlob->GetBufferPointer()));
+			}
+			else
+			{
+				LOG_SYSTEM_ERROR(hr, "D3DCompileFromFile");
+			}
+
+			SafeRelease(pErrorBlob);
+			SafeRelease(pBlob);
+
+			return false;
+		}
+
+		const uint8_t* const pBytes = reinterpret_cast<const uint8_t*>(pBlob->GetBufferPointer());
+
+		outBytecode.assign(pBytes, pBytes + pBlob->GetBufferSize());
+
+		SafeRelease(pErrorBlob);
+		SafeRelease(pBlob);
+
+		return true;
+	}
+
+	VertexShaderHandle D3D11Device::CreateVertexShader(const void* const pBytecode, const size_t byteSize)
+	{
+		ComPtr<ID3D11VertexShader> shaderPtr;
+
+		const HRESULT hr = mpDevice->CreateVertexShader(pBytecode, byteSize, nullptr, shaderPtr.GetAddressOf());
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "CreateVertexShader");
+
+			ASSERT(false);
+
+			return { 0 };
+		}
+
+		return { mVertexShaders.Allocate(std::move(shaderPtr)) };
+	}
+
+	PixelShaderHandle D3D11Device::CreatePixelShader(const void* const pBytecode, const size_t byteSize)
+	{
+		ComPtr<ID3D11PixelShader> shaderPtr;
+
+		const HRESULT hr = mpDevice->CreatePixelShader(pBytecode, byteSize, nullptr, shaderPtr.GetAddressOf());
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "CreatePixelShader");
+
+			ASSERT(false);
+
+			return { 0 };
+		}
+
+		return { mPixelShaders.Allocate(std::move(shaderPtr)) };
+	}
+
+	InputLayoutHandle D3D11Device::CreateInputLayout(
+		const InputElementDesc* const pElements,
+		const uint32_t elementCount,
+		const void* const pBytecode,
+		const size_t byteSize
+	)
+	{
+		ASSERT(pElements != nullptr);
+		ASSERT(elementCount > 0);
+
+		std::vector<D3D11_INPUT_ELEMENT_DESC> inputDescs(elementCount);
+
+		for (uint32_t i = 0; i < elementCount; ++i)
+		{
+			const InputElementDesc& element = pElements[i];
+
+			inputDescs[i] =
+			{
+				element.semanticName,
+				element.semanticIndex,
+				ToDXGIFormat(element.format),
+				element.inputSlot,
+				element.alignedByteOffset,
+				D3D11_INPUT_PER_VERTEX_DATA,
+				0
+			};
+		}
+
+		ComPtr<ID3D11InputLayout> inputLayoutPtr;
+
+		const HRESULT hr = mpDevice->CreateInputLayout(
+			inputDescs.data(),
+			elementCount,
+			pBytecode,
+			byteSize,
+			inputLayoutPtr.GetAddressOf()
+		);
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "CreateInputLayout");
+
+			ASSERT(false);
+
+			return { 0 };
+		}
+
+		return { mInputLayouts.Allocate(std::move(inputLayoutPtr)) };
+	}
+
+	void D3D11Device::DestroyVertexShader(const VertexShaderHandle shader)
+	{
+		mVertexShaders.Free(shader.id);
+	}
+
+	void D3D11Device::DestroyPixelShader(const PixelShaderHandle shader)
+	{
+		mPixelShaders.Free(shader.id);
+	}
+
+	void D3D11Device::DestroyInputLayout(const InputLayoutHandle inputLayout)
+	{
+		mInputLayouts.Free(inputLayout.id);
+	}
+
+	RasterizerStateHandle D3D11Device::CreateRasterizerState(const RasterizerDesc& desc)
+	{
+		D3D11_RASTERIZER_DESC rd;
+		ZeroMemory(&rd, sizeof(rd));
+
+		rd.FillMode = desc.fillMode == EFillMode::WIREFRAME ? D3D11_FILL_WIREFRAME : D3D11_FILL_SOLID;
+
+		switch (desc.cullMode)
+		{
+		case ECullMode::NONE:
+			rd.CullMode = D3D11_CULL_NONE;
+			break;
+
+		case ECullMode::FRONT:
+			rd.CullMode = D3D11_CULL_FRONT;
+			break;
+
+		case ECullMode::BACK:
+			rd.CullMode = D3D11_CULL_BACK;
+			break;
+
+		default:
+			ASSERT(false);
+			break;
+		}
+
+		rd.DepthClipEnable = desc.bDepthClipEnable;
+
+		ComPtr<ID3D11RasterizerState> statePtr;
+
+		const HRESULT hr = mpDevice->CreateRasterizerState(&rd, statePtr.GetAddressOf());
+		ASSERT(SUCCEEDED(hr));
+
+		return { mRasterizerStates.Allocate(std::move(statePtr)) };
+	}
+
+	SamplerStateHandle D3D11Device::CreateSamplerState(const SamplerDesc& desc)
+	{
+		D3D11_SAMPLER_DESC sd;
+		ZeroMemory(&sd, sizeof(sd));
+
+		switch (desc.filter)
+		{
+		case EFilter::POINT:
+			sd.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+			break;
+
+		case EFilter::LINEAR:
+			sd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+			break;
+
+		case EFilter::ANISOTROPIC:
+			sd.Filter = D3D11_FILTER_ANISOTROPIC;
+			sd.MaxAnisotropy = D3D11_MAX_MAXANISOTROPY;
+			break;
+
+		default:
+			ASSERT(false);
+			break;
+		}
+
+		const D3D11_TEXTURE_ADDRESS_MODE addressMode = desc.addressMode == EAddressMode::CLAMP
+			? D3D11_TEXTURE_ADDRESS_CLAMP
+			: D3D11_TEXTURE_ADDRESS_WRAP;
+
+		sd.AddressU = addressMode;
+		sd.AddressV = addressMode;
+		sd.AddressW = addressMode;
+		sd.MaxLOD = desc.maxLOD;
+
+		ComPtr<ID3D11SamplerState> statePtr;
+
+		const HRESULT hr = mpDevice->CreateSamplerState(&sd, statePtr.GetAddressOf());
+		ASSERT(SUCCEEDED(hr));
+
+		return { mSamplerStates.Allocate(std::move(statePtr)) };
+	}
+
+	BlendStateHandle D3D11Device::CreateBlendState(const BlendDesc& desc)
+	{
+		D3D11_BLEND_DESC bd;
+		ZeroMemory(&bd, sizeof(bd));
+
+		bd.AlphaToCoverageEnable = FALSE;
+		bd.IndependentBlendEnable = FALSE;
+
+		D3D11_RENDER_TARGET_BLEND_DESC& rtb = bd.RenderTarget[0];
+
+		rtb.BlendEnable = desc.bBlendEnable;
+		rtb.SrcBlend = ToD3D11Blend(desc.srcBlend);
+		rtb.DestBlend = ToD3D11Blend(desc.destBlend);
+		rtb.BlendOp = D3D11_BLEND_OP_ADD;
+		rtb.SrcBlendAlpha = ToD3D11Blend(desc.srcBlendAlpha);
+		rtb.DestBlendAlpha = ToD3D11Blend(desc.destBlendAlpha);
+		rtb.BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		rtb.RenderTargetWriteMask = desc.renderTargetWriteMask;
+
+		ComPtr<ID3D11BlendState> statePtr;
+
+		const HRESULT hr = mpDevice->CreateBlendState(&bd, statePtr.GetAddressOf());
+		ASSERT(SUCCEEDED(hr));
+
+		return { mBlendStates.Allocate(std::move(statePtr)) };
+	}
+
+	DepthStencilStateHandle D3D11Device::CreateDepthStencilState(const DepthStencilDesc& desc)
+	{
+		D3D11_DEPTH_STENCIL_DESC dd;
+		ZeroMemory(&dd, sizeof(dd));
+
+		dd.DepthEnable = desc.bDepthEnable;
+		dd.DepthWriteMask = desc.bDepthWriteEnable ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO;
+		dd.DepthFunc = ToD3D11Comparison(desc.depthFunc);
+		dd.StencilEnable = FALSE;
+
+		ComPtr<ID3D11DepthStencilState> statePtr;
+
+		const HRESULT hr = mpDevice->CreateDepthStencilState(&dd, statePtr.GetAddressOf());
+		ASSERT(SUCCEEDED(hr));
+
+		return { mDepthStencilStates.Allocate(std::move(statePtr)) };
+	}
+
+	void D3D11Device::DestroyRasterizerState(const RasterizerStateHandle state)
+	{
+		mRasterizerStates.Free(state.id);
+	}
+
+	void D3D11Device::DestroySamplerState(const SamplerStateHandle state)
+	{
+		mSamplerStates.Free(state.id);
+	}
+
+	void D3D11Device::DestroyBlendState(const BlendStateHandle state)
+	{
+		mBlendStates.Free(state.id);
+	}
+
+	void D3D11Device::DestroyDepthStencilState(const DepthStencilStateHandle state)
+	{
+		mDepthStencilStates.Free(state.id);
+	}
+
+	TextureHandle D3D11Device::GetBackBuffer() const
+	{
+		return mBackBuffer;
+	}
+
+	bool D3D11Device::TryResizeBackBuffer(const uint32_t width, const uint32_t height)
+	{
+		ASSERT(width > 0);
+		ASSERT(height > 0);
+
+		mpDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+
+		if (mBackBuffer.IsValid())
+		{
+			mTextures.Free(mBackBuffer.id);
+			mBackBuffer = { 0 };
+		}
+
+		const HRESULT hr = mpSwapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, 0);
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "SwapChain - ResizeBuffers");
+
+			ASSERT(false);
+
+			return false;
+		}
+
+		return tryCreateBackBuffer();
+	}
+
+	void D3D11Device::Present(const bool bVSync)
+	{
+		mpSwapChain->Present(bVSync ? 1 : 0, 0);
+	}
+
+	uint32_t D3D11Device::GetSupportedSampleCount(const EFormat format, const uint32_t desiredSampleCount) const
+	{
+		UINT quality = 0;
+		const HRESULT hr = mpDevice->CheckMultisampleQualityLevels(ToDXGIFormat(format), desiredSampleCount, &quality);
+
+		if (SUCCEEDED(hr) && quality > 0)
+		{
+			return desiredSampleCount;
+		}
+
+		return 1;
+	}
+
+	ResourceStats D3D11Device::GetResourceStats() const
+	{
+		ResourceStats stats;
+		stats.bufferCount = mBuffers.GetLiveCount();
+		stats.textureCount = mTextures.GetLiveCount();
+		stats.shaderCount = mVertexShaders.GetLiveCount() + mPixelShaders.GetLiveCount();
+		stats.stateCount = mRasterizerStates.GetLiveCount()
+			+ mSamplerStates.GetLiveCount()
+			+ mBlendStates.GetLiveCount()
+			+ mDepthStencilStates.GetLiveCount();
+
+		return stats;
+	}
+
+	void D3D11Device::executeCommandList(const CommandList& commandList)
+	{
+		recordCommands(*mpDeviceContext, commandList);
+	}
+
+	void D3D11Device::executeCommandLists(const CommandList* const pCommandLists, const uint32_t count)
+	{
+		if (count <= 1 || !JobSystem::IsInitialized() || !tryReserveDeferredContexts(count))
+		{
+			Device::executeCommandLists(pCommandLists, count);
+
+			return;
+		}
+
+		// 목록마다 지연 컨텍스트에 병렬로 기록
+		JobSystem::GetInstance().ParallelFor(count, count, [this, pCommandLists](const uint32_t begin, const uint32_t end, const uint32_t)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					if (pCommandLists[i].IsEmpty())
+					{
+						continue;
+					}
+
+					ID3D11DeviceContext* const pDeferredContext = mDeferredContexts[i].Get();
+
+					recordCommands(*pDeferredContext, pCommandLists[i]);
+
+					const HRESULT hr = pDeferredContext->FinishCommandList(FALSE, mNativeCommandLists[i].ReleaseAndGetAddressOf());
+
+					if (FAILED(hr))
+					{
+						LOG_SYSTEM_ERROR(hr, "FinishCommandList");
+
+						ASSERT(false);
+					}
+				}
+			});
+
+		// 실행은 제출 스레드에서 순서대로
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (mNativeCommandLists[i] != nullptr)
+			{
+				mpDeviceContext->ExecuteCommandList(mNativeCommandLists[i].Get(), FALSE);
+
+				mNativeCommandLists[i].Reset();
+			}
+		}
+	}
+
+	bool D3D11Device::tryReserveDeferredContexts(const uint32_t count)
+	{
+		while (mDeferredContexts.size() < count)
+		{
+			ComPtr<ID3D11DeviceContext> deferredContextPtr;
+
+			const HRESULT hr = mpDevice->CreateDeferredContext(0, deferredContextPtr.GetAddressOf());
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "CreateDeferredContext");
+
+				return false;
+			}
+
+			mDeferredContexts.push_back(deferredContextPtr);
+		}
+
+		if (mNativeCommandLists.size() < count)
+		{
+			mNativeCommandLists.resize(count);
+		}
+
+		return true;
+	}
+
+	bool D3D11Device::tryCreateTextureViews(TextureResource& resource)
+	{
+		const TextureDesc& desc = resource.desc;
+		const bool bMultiSample = desc.sampleCount > 1;
+
+		HRESULT hr;
+
+		if (desc.bindFlags & BIND_RENDER_TARGET)
+		{
+			hr = mpDevice->CreateRenderTargetView(resource.texture.Get(), nullptr, resource.renderTargetView.GetAddressOf());
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "CreateRenderTargetView");
+
+				ASSERT(false);
+
+				return false;
+			}
+		}
+
+		if (desc.bindFlags & BIND_DEPTH_STENCIL)
+		{
+			D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc;
+			ZeroMemory(&depthStencilViewDesc, sizeof(depthStencilViewDesc));
+
+			depthStencilViewDesc.Format = ToDXGIFormat(desc.format);
+			depthStencilViewDesc.ViewDimension = bMultiSample ? D3D11_DSV_DIMENSION_TEXTURE2DMS : D3D11_DSV_DIMENSION_TEXTURE2D;
+
+			hr = mpDevice->CreateDepthStencilView(resource.texture.Get(), &depthStencilViewDesc, resource.depthStencilView.GetAddressOf());
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "CreateDepthStencilView");
+
+				ASSERT(false);
+
+				return false;
+			}
+		}
+
+		if (desc.bindFlags & BIND_SHADER_RESOURCE)
+		{
+			// desc 없이 만들면 한 장짜리 배열은 Texture2D 뷰가 됨
+			D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc;
+			ZeroMemory(&shaderResourceViewDesc, sizeof(shaderResourceViewDesc));
+
+			const bool bArray = (desc.miscFlags & TEXTURE_MISC_ARRAY) != 0;
+
+			if (bArray)
+			{
+				shaderResourceViewDesc.Format = ToDXGIFormat(desc.format);
+				shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+				shaderResourceViewDesc.Texture2DArray.MostDetailedMip = 0;
+				shaderResourceViewDesc.Texture2DArray.MipLevels = desc.mipLevels;
+				shaderResourceViewDesc.Texture2DArray.FirstArraySlice = 0;
+				shaderResourceViewDesc.Texture2DArray.ArraySize = desc.arraySize;
+			}
+
+			hr = mpDevice->CreateShaderResourceView(resource.texture.Get(), bArray ? &shaderResourceViewDesc : nullptr, resource.shaderResourceView.GetAddressOf());
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "CreateShaderResourceView");
+
+				ASSERT(false);
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool D3D11Device::tryCreateBackBuffer()
+	{
+		TextureResource resource;
+
+		HRESULT hr = mpSwapChain->GetBuffer(0, IID_PPV_ARGS(resource.texture.GetAddressOf()));
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "GetBuffer");
+
+			ASSERT(false);
+
+			return false;
+		}
+
+		D3D11_TEXTURE2D_DESC textureDesc;
+		resource.texture->GetDesc(&textureDesc);
+
+		resource.desc.width = textureDesc.Width;
+		resource.desc.height = textureDesc.Height;
+		resource.desc.mipLevels = 1;
+		resource.desc.arraySize = 1;
+		resource.desc.sampleCount = 1;
+		resource.desc.bindFlags = BIND_RENDER_TARGET;
+		resource.desc.miscFlags = TEXTURE_MISC_NONE;
+		resource.desc.format = FromDXGIFormat(textureDesc.Format);
+		resource.desc.usage = EUsage::DEFAULT;
+
+		if (!tryCreateTextureViews(resource))
+		{
+			return false;
+		}
+
+		mBackBuffer = { mTextures.Allocate(std::move(resource)) };
+
+		return true;
+	}
+
+	void D3D11Device::recordCommands(ID3D11DeviceContext& deviceContext, const CommandList& commandList)
+	{
+		for (const Command& command : commandList.GetCommands())
+		{
+			switch (command.type)
+			{
+			case ECommandType::SET_VIEWPORT:
+				{
+					const Viewport* const pViewport = reinterpret_cast<const Viewport*>(commandList.GetPayload(command.arg0));
+
+					const D3D11_VIEWPORT viewport =
+					{
+						pViewport->topLeftX,
+						pViewport->topLeftY,
+						pViewport->width,
+						pViewport->height,
+						pViewport->minDepth,
+						pViewport->maxDepth
+					};
+
+					deviceContext.RSSetViewports(1, &viewport);
+				}
+				break;
+
+			case ECommandType::SET_RENDER_TARGET:
+				{
+					ID3D11RenderTargetView* const pRenderTargetView = command.handle != 0
+						? mTextures.Get(command.handle).renderTargetView.Get()
+						: nullptr;
+
+					ID3D11DepthStencilView* const pDepthStencilView = command.arg0 != 0
+						? mTextures.Get(command.arg0).depthStencilView.Get()
+						: nullptr;
+
+					if (pRenderTargetView != nullptr)
+					{
+						deviceContext.OMSetRenderTargets(1, &pRenderTargetView, pDepthStencilView);
+					}
+					else
+					{
+						deviceContext.OMSetRenderTargets(0, nullptr, pDepthStencilView);
+					}
+				}
+				break;
+
+			case ECommandType::CLEAR_RENDER_TARGET:
+				{
+					const float* const pColor = reinterpret_cast<const float*>(commandList.GetPayload(command.arg0));
+
+					deviceContext.ClearRenderTargetView(mTextures.Get(command.handle).renderTargetView.Get(), pColor);
+				}
+				break;
+
+			case ECommandType::CLEAR_DEPTH_STENCIL:
+				{
+					float depth;
+					memcpy(&depth, &command.arg0, sizeof(float));
+
+					deviceContext.ClearDepthStencilView(
+						mTextures.Get(command.handle).depthStencilView.Get(),
+						D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL,
+						depth,
+						static_cast<UINT8>(command.arg1)
+					);
+				}
+				break;
+
+			case ECommandType::SET_INPUT_LAYOUT:
+				deviceContext.IASetInputLayout(command.handle != 0 ? mInputLayouts.Get(command.handle).Get() : nullptr);
+				break;
+
+			case ECommandType::SET_VERTEX_BUFFER:
+				{
+					ID3D11Buffer* const pBuffer = command.handle != 0 ? mBuffers.Get(command.handle).buffer.Get() : nullptr;
+					const UINT stride = command.arg0;
+					const UINT offset = command.arg1;
+
+					deviceContext.IASetVertexBuffers(command.slot, 1, &pBuffer, &stride, &offset);
+				}
+				break;
+
+			case ECommandType::SET_INDEX_BUFFER:
+				deviceContext.IASetIndexBuffer(
+					command.handle != 0 ? mBuffers.Get(command.handle).buffer.Get() : nullptr,
+					ToDXGIFormat(static_cast<EFormat>(command.arg0)),
+					command.arg1
+				);
+				break;
+
+			case ECommandType::SET_PRIMITIVE_TOPOLOGY:
+				ASSERT(static_cast<EPrimitiveTopology>(command.arg0) == EPrimitiveTopology::TRIANGLE_LIST);
+
+				deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+				break;
+
+			case ECommandType::SET_VERTEX_SHADER:
+				deviceContext.VSSetShader(command.handle != 0 ? mVertexShaders.Get(command.handle).Get() : nullptr, nullptr, 0);
+				break;
+
+			case ECommandType::SET_PIXEL_SHADER:
+				deviceContext.PSSetShader(command.handle != 0 ? mPixelShaders.Get(command.handle).Get() : nullptr, nullptr, 0);
+				break;
+
+			case ECommandType::SET_VS_CONSTANT_BUFFER:
+				{
+					ID3D11Buffer* const pBuffer = command.handle != 0 ? mBuffers.Get(command.handle).buffer.Get() : nullptr;
+
+					deviceContext.VSSetConstantBuffers(command.slot, 1, &pBuffer);
+				}
+				break;
+
+			case ECommandType::SET_PS_CONSTANT_BUFFER:
+				{
+					ID3D11Buffer* const pBuffer = command.handle != 0 ? mBuffers.Get(command.handle).buffer.Get() : nullptr;
+
+					deviceContext.PSSetConstantBuffers(command.slot, 1, &pBuffer);
+				}
+				break;
+
+			case ECommandType::SET_PS_TEXTURE:
+				{
+					ID3D11ShaderResourceView* const pView = command.handle != 0
+						? mTextures.Get(command.handle).shaderResourceView.Get()
+						: nullptr;
+
+					deviceContext.PSSetShaderResources(command.slot, 1, &pView);
+				}
+				break;
+
+			case ECommandType::SET_PS_BUFFER:
+				{
+					ID3D11ShaderResourceView* const pView = command.handle != 0
+						? mBuffers.Get(command.handle).shaderResourceView.Get()
+						: nullptr;
+
+					deviceContext.PSSetShaderResources(command.slot, 1, &pView);
+				}
+				break;
+
+			case ECommandType::SET_PS_SAMPLER:
+				{
+					ID3D11SamplerState* const pSampler = command.handle != 0 ? mSamplerStates.Get(command.handle).Get() : nullptr;
+
+					deviceContext.PSSetSamplers(command.slot, 1, &pSampler);
+				}
+				break;
+
+			case ECommandType::SET_RASTERIZER_STATE:
+				deviceContext.RSSetState(command.handle != 0 ? mRasterizerStates.Get(command.handle).Get() : nullptr);
+				break;
+
+			case ECommandType::SET_BLEND_STATE:
+				deviceContext.OMSetBlendState(
+					command.handle != 0 ? mBlendStates.Get(command.handle).Get() : nullptr,
+					nullptr,
+					0xFFFFFFFF
+				);
+				break;
+
+			case ECommandType::SET_DEPTH_STENCIL_STATE:
+				deviceContext.OMSetDepthStencilState(
+					command.handle != 0 ? mDepthStencilStates.Get(command.handle).Get() : nullptr,
+					0
+				);
+				break;
+
+			case ECommandType::UPDATE_BUFFER:
+				{
+					const BufferResource& resource = mBuffers.Get(command.handle);
+
+					// 상수 버퍼는 전체만 갱신 가능, 나머지는 arg2부터 일부만 갱신
+					const bool bPartial = (command.arg2 > 0 || command.arg1 < resource.desc.byteWidth)
+						&& !(resource.desc.bindFlags & BIND_CONSTANT_BUFFER);
+
+					const D3D11_BOX box = { command.arg2, 0, 0, command.arg2 + command.arg1, 1, 1 };
+
+					deviceContext.UpdateSubresource(
+						resource.buffer.Get(),
+						0,
+						bPartial ? &box : nullptr,
+						commandList.GetPayload(command.arg0),
+						0,
+						0
+					);
+				}
+				break;
+
+			case ECommandType::DRAW:
+				deviceContext.Draw(command.arg0, command.arg1);
+				break;
+
+			case ECommandType::DRAW_INDEXED:
+				deviceContext.DrawIndexed(command.arg0, command.arg1, static_cast<INT>(command.arg2));
+				break;
+
+			case ECommandType::RESOLVE_TEXTURE:
+				deviceContext.ResolveSubresource(
+					mTextures.Get(command.handle).texture.Get(),
+					0,
+					mTextures.Get(command.arg0).texture.Get(),
+					0,
+					ToDXGIFormat(static_cast<EFormat>(command.arg1))
+				);
+				break;
+
+			case ECommandType::COPY_TEXTURE:
+				deviceContext.CopyResource(
+					mTextures.Get(command.handle).texture.Get(),
+					mTextures.Get(command.arg0).texture.Get()
+				);
+				break;
+
+			case ECommandType::COPY_BUFFER:
+				{
+					const uint32_t* const pRegion = static_cast<const uint32_t*>(commandList.GetPayload(command.arg1));
+
+					const D3D11_BOX srcBox = { pRegion[1], 0, 0, pRegion[1] + pRegion[2], 1, 1 };
+
+					deviceContext.CopySubresourceRegion(
+						mBuffers.Get(command.handle).buffer.Get(),
+						0,
+						pRegion[0],
+						0,
+						0,
+						mBuffers.Get(command.arg0).buffer.Get(),
+						0,
+						&srcBox
+					);
+				}
+				break;
+
+			default:
+				ASSERT(false);
+				break;
+			}
+		}
+	}
+
+	D3D11Device* D3D11Device::CreateDeviceAllocOrNull(const HWND hWnd)
+	{
+		ASSERT(hWnd != nullptr);
+
+		UINT creationFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+
+#if defined(DEBUG) || defined(_DEBUG)
+		creationFlags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+
+		const D3D_FEATURE_LEVEL featureLevels[] = {
+			D3D_FEATURE_LEVEL_11_1,
+			D3D_FEATURE_LEVEL_11_0
+		};
+
+		ID3D11Device* pDevice = nullptr;
+		ID3D11DeviceContext* pDeviceContext = nullptr;
+
+		HRESULT hr = D3D11CreateDevice(
+			nullptr,
+			D3D_DRIVER_TYPE_HARDWARE,
+			nullptr,
+			creationFlags,
+			featureLevels,
+			ARRAYSIZE(featureLevels),
+			D3D11_SDK_VERSION,
+			&pDevice,
+			nullptr,
+			&pDeviceContext
+		);
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "D3D11CreateDevice");
+
+			ASSERT(false);
+
+			return nullptr;
+		}
+
+		// 주사율 조사 및 스왑체인 생성
+		IDXGIDevice* pDXGIDevice = nullptr;
+		IDXGIAdapter* pAdapter = nullptr;
+		IDXGIOutput* pOutput = nullptr;
+
+		IDXGISwapChain1* pSwapChain = nullptr;
+		UINT refreshRate = 60;
+		{
+			hr = pDevice->QueryInterface(__uuidof(IDXGIDevice), reinterpret_cast<void**>(&pDXGIDevice));
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "QueryInterface - IDXGIDevice");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			hr = pDXGIDevice->GetAdapter(&pAdapter);
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "GetAdapter - IDXGIAdapter");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			// 첫 번째 모니터 획득
+			hr = pAdapter->EnumOutputs(0, &pOutput);
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "EnumOutput");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			DXGI_OUTPUT_DESC outputDesc;
+			hr = pOutput->GetDesc(&outputDesc);
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "GetDesc");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			DEVMODEW dm;
+			ZeroMemory(&dm, sizeof(dm));
+
+			dm.dmSize = sizeof(dm);
+			if (!EnumDisplaySettings(outputDesc.DeviceName, ENUM_CURRENT_SETTINGS, &dm))
+			{
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			refreshRate = dm.dmDisplayFrequency;
+
+			IDXGIFactory* pBaseFactory = nullptr;
+			hr = pAdapter->GetParent(IID_PPV_ARGS(&pBaseFactory));
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "GetParent - IDXGIFactory");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			IDXGIFactory2* pDXGIFactory = nullptr;
+			hr = pBaseFactory->QueryInterface(IID_PPV_ARGS(&pDXGIFactory));
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "QueryInterface - IDXGIFactory2");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			DXGI_SWAP_CHAIN_DESC1 sd;
+			ZeroMemory(&sd, sizeof(sd));
+
+			sd.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+			sd.Stereo = false;
+			sd.SampleDesc.Count = 1;
+			sd.SampleDesc.Quality = 0;
+			sd.BufferCount = 2;
+			sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+			sd.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+			sd.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+
+			DXGI_SWAP_CHAIN_FULLSCREEN_DESC scfd;
+			ZeroMemory(&scfd, sizeof(scfd));
+
+			scfd.Windowed = true;
+
+			hr = pDXGIFactory->CreateSwapChainForHwnd(
+				pDevice,
+				hWnd,
+				&sd,
+				&scfd,
+				nullptr,
+				&pSwapChain
+			);
+
+			if (FAILED(hr))
+			{
+				LOG_SYSTEM_ERROR(hr, "CreateSwapChainForHwnd");
+
+				ASSERT(false);
+
+				return nullptr;
+			}
+
+			SafeRelease(pDXGIFactory);
+			SafeRelease(pBaseFactory);
+		}
+		SafeRelease(pOutput);
+		SafeRelease(pAdapter);
+		SafeRelease(pDXGIDevice);
+
+		D3D11Device* const pRet = new D3D11Device(
+			pDevice,
+			pDeviceContext,
+			pSwapChain,
+			refreshRate
+		);
+
+		if (!pRet->tryCreateBackBuffer())
+		{
+			delete pRet;
+
+			return nullptr;
+		}
+
+		return pRet;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <d3d11.h>
+#include <dxgi1_2.h>
+
+#include "Core/ComHelper.h"
+#include "RHIDevice.h"
+#include "ResourcePool.h"
+
+namespace RHI
+{
+	class D3D11Device final : public Device
+	{
+	public:
+		virtual ~D3D11Device();
+
+		virtual BufferHandle CreateBuffer(const BufferDesc& desc, const void* const pInitialDataOrNull) override;
+		virtual void DestroyBuffer(const BufferHandle buffer) override;
+
+		virtual TextureHandle CreateTexture(const TextureDesc& desc, const SubresourceData* const pInitialDataOrNull) override;
+		virtual TextureHandle CreateTextureFromFile(const char* const path) override;
+		virtual void DestroyTexture(const TextureHandle texture) override;
+		virtual TextureDesc GetTextureDesc(const TextureHandle texture) const override;
+
+		virtual bool TryCompileShaderFromFile(
+			const char* const path,
+			const char* const entryPoint,
+			const char* const target,
+			const ShaderDefine* const pDefinesOrNull,
+			const uint32_t defineCount,
+			std::vector<uint8_t>& outBytecode
+		) override;
+
+		virtual VertexShaderHandle CreateVertexShader(const void* const pBytecode, const size_t byteSize) override;
+		virtual PixelShaderHandle CreatePixelShader(const void* const pBytecode, const size_t byteSize) override;
+		virtual InputLayoutHandle CreateInputLayout(
+			const InputElementDesc* const pElements,
+			const uint32_t elementCount,
+			const void* const pBytecode,
+			const size_t byteSize
+		) override;
+
+		virtual void DestroyVertexShader(const VertexShaderHandle shader) override;
+		virtual void DestroyPixelShader(const PixelShaderHandle shader) override;
+		virtual void DestroyInputLayout(const InputLayoutHandle inputLayout) override;
+
+		virtual RasterizerStateHandle CreateRasterizerState(const RasterizerDesc& desc) override;
+		virtual SamplerStateHandle CreateSamplerState(const SamplerDesc& desc) override;
+		virtual BlendStateHandle CreateBlendState(const BlendDesc& desc) override;
+		virtual DepthStencilStateHandle CreateDepthStencilState(const DepthStencilDesc& desc) override;
+
+		virtual void DestroyRasterizerState(const RasterizerStateHandle state) override;
+		virtual void DestroySamplerState(const SamplerStateHandle state) override;
+		virtual void DestroyBlendState(const BlendStateHandle state) override;
+		virtual void DestroyDepthStencilState(const DepthStencilStateHandle state) override;
+
+		virtual TextureHandle GetBackBuffer() const override;
+		virtual bool TryResizeBackBuffer(const uint32_t width, const uint32_t height) override;
+		virtual void Present(const bool bVSync) override;
+
+		virtual uint32_t GetSupportedSampleCount(const EFormat format, const uint32_t desiredSampleCount) const override;
+
+		virtual ResourceStats GetResourceStats() const override;
+
+		virtual const char* GetName() const override
+		{
+			return "Direct3D 11";
+		}
+
+		// ImGui 백엔드 초기화용
+		inline ID3D11Device* GetNativeDevice() const
+		{
+			return mpDevice;
+		}
+
+		inline ID3D11DeviceContext* GetNativeDeviceContext() const
+		{
+			return mpDeviceContext;
+		}
+
+		inline UINT GetRefreshRate() const
+		{
+			return mRefreshRate;
+		}
+
+		// static
+		static D3D11Device* CreateDeviceAllocOrNull(const HWND hWnd);
+
+	protected:
+		virtual void executeCommandList(const CommandList& commandList) override;
+		virtual void executeCommandLists(const CommandList* const pCommandLists, const uint32_t count) override;
+
+	private:
+		struct BufferResource
+		{
+			ComPtr<ID3D11Buffer> buffer;
+			ComPtr<ID3D11ShaderResourceView> shaderResourceView;
+
+			BufferDesc desc;
+		};
+
+		struct TextureResource
+		{
+			ComPtr<ID3D11Texture2D> texture;
+			ComPtr<ID3D11RenderTargetView> renderTargetView;
+			ComPtr<ID3D11DepthStencilView> depthStencilView;
+			ComPtr<ID3D11ShaderResourceView> shaderResourceView;
+
+			TextureDesc desc;
+		};
+
+	private:
+		ID3D11Device* mpDevice;
+		ID3D11DeviceContext* mpDeviceContext;
+		IDXGISwapChain1* mpSwapChain;
+
+		UINT mRefreshRate;
+
+		ResourcePool<BufferResource> mBuffers;
+		ResourcePool<TextureResource> mTextures;
+		ResourcePool<ComPtr<ID3D11VertexShader>> mVertexShaders;
+		ResourcePool<ComPtr<ID3D11PixelShader>> mPixelShaders;
+		ResourcePool<ComPtr<ID3D11InputLayout>> mInputLayouts;
+		ResourcePool<ComPtr<ID3D11RasterizerState>> mRasterizerStates;
+		ResourcePool<ComPtr<ID3D11SamplerState>> mSamplerStates;
+		ResourcePool<ComPtr<ID3D11BlendState>> mBlendStates;
+		ResourcePool<ComPtr<ID3D11DepthStencilState>> mDepthStencilStates;
+
+		TextureHandle mBackBuffer;
+
+		// 목록마다 하나씩 써서 병렬로 번역
+		std::vector<ComPtr<ID3D11DeviceContext>> mDeferredContexts;
+		std::vector<ComPtr<ID3D11CommandList>> mNativeCommandLists;
+
+	private:
+		D3D11Device(
+			ID3D11Device* const pDevice,
+			ID3D11DeviceContext* const pDeviceContext,
+			IDXGISwapChain1* const pSwapChain,
+			const UINT refreshRate
+		);
+
+		bool tryCreateTextureViews(TextureResource& resource);
+		bool tryCreateBackBuffer();
+		bool tryReserveDeferredContexts(const uint32_t count);
+
+		void recordCommands(ID3D11DeviceContext& deviceContext, const CommandList& commandList);
+	};
+}
\ No newline at end of file
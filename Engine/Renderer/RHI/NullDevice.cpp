@@ -0,0 +1,476 @@
+#include "NullDevice.h"
+
+#include <cstring>
+#include <fstream>
+
+enum
+{
+	DEFAULT_FRAME_COMMAND_SIZE = 4096
+};
+
+namespace RHI
+{
+	NullDevice::NullDevice(const uint32_t backBufferWidth, const uint32_t backBufferHeight)
+		: Device()
+		, mBuffers()
+		, mTextures()
+		, mVertexShaders()
+		, mPixelShaders()
+		, mInputLayouts()
+		, mRasterizerStates()
+		, mSamplerStates()
+		, mBlendStates()
+		, mDepthStencilStates()
+		, mBackBuffer{ 0 }
+		, mbRecording(true)
+		, mFrameCommands()
+		, mLastFrameCommands()
+		, mWorkStats{}
+	{
+		mFrameCommands.reserve(DEFAULT_FRAME_COMMAND_SIZE);
+		mLastFrameCommands.reserve(DEFAULT_FRAME_COMMAND_SIZE);
+
+		TryResizeBackBuffer(backBufferWidth, backBufferHeight);
+	}
+
+	BufferHandle NullDevice::CreateBuffer(const BufferDesc& desc, const void* const pInitialDataOrNull)
+	{
+		ASSERT(desc.byteWidth > 0);
+		ASSERT(desc.usage != EUsage::IMMUTABLE || pInitialDataOrNull != nullptr);
+
+		BufferDesc bufferDesc = desc;
+
+		return { mBuffers.Allocate(std::move(bufferDesc)) };
+	}
+
+	void NullDevice::DestroyBuffer(const BufferHandle buffer)
+	{
+		mBuffers.Free(buffer.id);
+	}
+
+	TextureHandle NullDevice::CreateTexture(const TextureDesc& desc, const SubresourceData* const pInitialDataOrNull)
+	{
+		ASSERT(desc.width > 0);
+		ASSERT(desc.height > 0);
+		ASSERT(desc.format != EFormat::UNKNOWN);
+		ASSERT(desc.usage != EUsage::IMMUTABLE || pInitialDataOrNull != nullptr);
+
+		TextureDesc textureDesc = desc;
+
+		return { mTextures.Allocate(std::move(textureDesc)) };
+	}
+
+	TextureHandle NullDevice::CreateTextureFromFile(const char* const path)
+	{
+		ASSERT(path != nullptr);
+
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file.is_open())
+		{
+			return { 0 };
+		}
+
+		uint8_t header[32];
+		file.read(reinterpret_cast<char*>(header), sizeof(header));
+
+		const size_t readSize = static_cast<size_t>(file.gcount());
+
+		TextureDesc desc = {};
+		desc.width = 1;
+		desc.height = 1;
+		desc.mipLevels = 1;
+		desc.arraySize = 1;
+		desc.sampleCount = 1;
+		desc.bindFlags = BIND_SHADER_RESOURCE;
+		desc.format = EFormat::R8G8B8A8_UNORM;
+		desc.usage = EUsage::IMMUTABLE;
+
+		// 헤더만 읽고 픽셀은 읽지 않음
+		if (readSize >= 32 && memcmp(header, "DDS ", 4) == 0)
+		{
+			memcpy(&desc.height, header + 12, sizeof(uint32_t));
+			memcpy(&desc.width, header + 16, sizeof(uint32_t));
+			memcpy(&desc.mipLevels, header + 28, sizeof(uint32_t));
+
+			if (desc.mipLevels == 0)
+			{
+				desc.mipLevels = 1;
+			}
+		}
+		else if (readSize >= 24 && memcmp(header + 1, "PNG", 3) == 0)
+		{
+			desc.width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+			desc.height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+		}
+
+		return { mTextures.Allocate(std::move(desc)) };
+	}
+
+	void NullDevice::DestroyTexture(const TextureHandle texture)
+	{
+		ASSERT(texture != mBackBuffer);
+
+		mTextures.Free(texture.id);
+	}
+
+	TextureDesc NullDevice::GetTextureDesc(const TextureHandle texture) const
+	{
+		return mTextures.Get(texture.id);
+	}
+
+	bool NullDevice::TryCompileShaderFromFile(
+		const char* const path,
+		const char* const entryPoint,
+		const char* const target,
+		const ShaderDefine* const pDefinesOrNull,
+		const uint32_t defineCount,
+		std::vector<uint8_t>& outBytecode
+	)
+	{
+		ASSERT(path != nullptr);
+		ASSERT(entryPoint != nullptr);
+		ASSERT(target != nullptr);
+		ASSERT(pDefinesOrNull != nullptr || defineCount == 0);
+
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		// 컴파일하지 않음, "바이트코드"는 요청을 구별하는 용도
+		const size_t targetLength = strlen(target);
+
+		outBytecode.assign(target, target + targetLength);
+
+		return true;
+	}
+
+	VertexShaderHandle NullDevice::CreateVertexShader(const void* const pBytecode, const size_t byteSize)
+	{
+		ASSERT(pBytecode != nullptr);
+		ASSERT(byteSize > 0);
+
+		size_t size = byteSize;
+
+		return { mVertexShaders.Allocate(std::move(size)) };
+	}
+
+	PixelShaderHandle NullDevice::CreatePixelShader(const void* const pBytecode, const size_t byteSize)
+	{
+		ASSERT(pBytecode != nullptr);
+		ASSERT(byteSize > 0);
+
+		size_t size = byteSize;
+
+		return { mPixelShaders.Allocate(std::move(size)) };
+	}
+
+	InputLayoutHandle NullDevice::CreateInputLayout(
+		const InputElementDesc* const pElements,
+		const uint32_t elementCount,
+		const void* const pBytecode,
+		const size_t byteSize
+	)
+	{
+		ASSERT(pElements != nullptr);
+		ASSERT(elementCount > 0);
+		ASSERT(pBytecode != nullptr);
+		ASSERT(byteSize > 0);
+
+		uint32_t count = elementCount;
+
+		return { mInputLayouts.Allocate(std::move(count)) };
+	}
+
+	void NullDevice::DestroyVertexShader(const VertexShaderHandle shader)
+	{
+		mVertexShaders.Free(shader.id);
+	}
+
+	void NullDevice::DestroyPixelShader(const PixelShaderHandle shader)
+	{
+		mPixelShaders.Free(shader.id);
+	}
+
+	void NullDevice::DestroyInputLayout(const InputLayoutHandle inputLayout)
+	{
+		mInputLayouts.Free(inputLayout.id);
+	}
+
+	RasterizerStateHandle NullDevice::CreateRasterizerState(const RasterizerDesc& desc)
+	{
+		RasterizerDesc stateDesc = desc;
+
+		return { mRasterizerStates.Allocate(std::move(stateDesc)) };
+	}
+
+	SamplerStateHandle NullDevice::CreateSamplerState(const SamplerDesc& desc)
+	{
+		SamplerDesc stateDesc = desc;
+
+		return { mSamplerStates.Allocate(std::move(stateDesc)) };
+	}
+
+	BlendStateHandle NullDevice::CreateBlendState(const BlendDesc& desc)
+	{
+		BlendDesc stateDesc = desc;
+
+		return { mBlendStates.Allocate(std::move(stateDesc)) };
+	}
+
+	DepthStencilStateHandle NullDevice::CreateDepthStencilState(const DepthStencilDesc& desc)
+	{
+		DepthStencilDesc stateDesc = desc;
+
+		return { mDepthStencilStates.Allocate(std::move(stateDesc)) };
+	}
+
+	void NullDevice::DestroyRasterizerState(const RasterizerStateHandle state)
+	{
+		mRasterizerStates.Free(state.id);
+	}
+
+	void NullDevice::DestroySamplerState(const SamplerStateHandle state)
+	{
+		mSamplerStates.Free(state.id);
+	}
+
+	void NullDevice::DestroyBlendState(const BlendStateHandle state)
+	{
+		mBlendStates.Free(state.id);
+	}
+
+	void NullDevice::DestroyDepthStencilState(const DepthStencilStateHandle state)
+	{
+		mDepthStencilStates.Free(state.id);
+	}
+
+	TextureHandle NullDevice::GetBackBuffer() const
+	{
+		return mBackBuffer;
+	}
+
+	bool NullDevice::TryResizeBackBuffer(const uint32_t width, const uint32_t height)
+	{
+		ASSERT(width > 0);
+		ASSERT(height > 0);
+
+		if (mBackBuffer.IsValid())
+		{
+			mTextures.Free(mBackBuffer.id);
+		}
+
+		TextureDesc desc = {};
+		desc.width = width;
+		desc.height = height;
+		desc.mipLevels = 1;
+		desc.arraySize = 1;
+		desc.sampleCount = 1;
+		desc.bindFlags = BIND_RENDER_TARGET;
+		desc.format = EFormat::R8G8B8A8_UNORM;
+		desc.usage = EUsage::DEFAULT;
+
+		mBackBuffer = { mTextures.Allocate(std::move(desc)) };
+
+		return true;
+	}
+
+	void NullDevice::Present(const bool bVSync)
+	{
+		(void)bVSync;
+
+		++mWorkStats.presentCount;
+
+		mLastFrameCommands.swap(mFrameCommands);
+		mFrameCommands.clear();
+	}
+
+	uint32_t NullDevice::GetSupportedSampleCount(const EFormat format, const uint32_t desiredSampleCount) const
+	{
+		(void)format;
+
+		return desiredSampleCount;
+	}
+
+	ResourceStats NullDevice::GetResourceStats() const
+	{
+		ResourceStats stats;
+		stats.bufferCount = mBuffers.GetLiveCount();
+		stats.textureCount = mTextures.GetLiveCount();
+		stats.shaderCount = mVertexShaders.GetLiveCount() + mPixelShaders.GetLiveCount();
+		stats.stateCount = mRasterizerStates.GetLiveCount()
+			+ mSamplerStates.GetLiveCount()
+			+ mBlendStates.GetLiveCount()
+			+ mDepthStencilStates.GetLiveCount();
+
+		return stats;
+	}
+
+	void NullDevice::executeCommandList(const CommandList& commandList)
+	{
+		const std::vector<Command>& commands = commandList.GetCommands();
+
+		// 지연 컨텍스트처럼 목록마다 기본 상태에서 시작하므로
+		// 앞 목록에서 설정한 상태에 기대는 드로우는 잘못된 것
+		bool bViewportSet = false;
+		bool bRenderTargetSet = false;
+		bool bDepthTargetSet = false;
+		bool bInputLayoutSet = false;
+		bool bIndexBufferSet = false;
+		bool bVertexShaderSet = false;
+		bool bPixelShaderSet = false;
+
+		for (const Command& command : commands)
+		{
+			if (!isHandleAlive(command))
+			{
+				++mWorkStats.invalidCommandCount;
+
+				ASSERT(false, GetCommandTypeName(command.type));
+			}
+
+			switch (command.type)
+			{
+			case ECommandType::SET_VIEWPORT:
+				bViewportSet = true;
+				break;
+
+			case ECommandType::SET_RENDER_TARGET:
+				bRenderTargetSet = command.handle != 0;
+				bDepthTargetSet = command.arg0 != 0;
+				break;
+
+			case ECommandType::SET_INPUT_LAYOUT:
+				bInputLayoutSet = command.handle != 0;
+				break;
+
+			case ECommandType::SET_INDEX_BUFFER:
+				bIndexBufferSet = command.handle != 0;
+				break;
+
+			case ECommandType::SET_VERTEX_SHADER:
+				bVertexShaderSet = command.handle != 0;
+				break;
+
+			case ECommandType::SET_PIXEL_SHADER:
+				bPixelShaderSet = command.handle != 0;
+				break;
+
+			case ECommandType::DRAW:
+			case ECommandType::DRAW_INDEXED:
+				{
+					++mWorkStats.drawCount;
+					mWorkStats.triangleCount += command.arg0 / 3;
+
+					const bool bIndexed = command.type == ECommandType::DRAW_INDEXED;
+					// 깊이만 그리면 픽셀 셰이더가 없어도 됨
+					const bool bComplete = bViewportSet && bVertexShaderSet
+						&& (bRenderTargetSet ? bPixelShaderSet : bDepthTargetSet)
+						&& (!bIndexed || (bInputLayoutSet && bIndexBufferSet));
+
+					if (!bComplete)
+					{
+						++mWorkStats.incompleteDrawCount;
+
+						ASSERT(false, "draw without complete pipeline state in its command list");
+					}
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		if (mbRecording)
+		{
+			mFrameCommands.insert(mFrameCommands.end(), commands.begin(), commands.end());
+		}
+	}
+
+	bool NullDevice::isHandleAlive(const Command& command) const
+	{
+		// 0은 슬롯 해제라 항상 허용
+		if (command.handle == 0)
+		{
+			switch (command.type)
+			{
+			case ECommandType::CLEAR_RENDER_TARGET:
+			case ECommandType::CLEAR_DEPTH_STENCIL:
+			case ECommandType::UPDATE_BUFFER:
+			case ECommandType::RESOLVE_TEXTURE:
+			case ECommandType::COPY_TEXTURE:
+			case ECommandType::COPY_BUFFER:
+				return false;
+
+			// 깊이 타겟만 있음
+			case ECommandType::SET_RENDER_TARGET:
+				return command.arg0 == 0 || mTextures.IsAlive(command.arg0);
+
+			default:
+				return true;
+			}
+		}
+
+		switch (command.type)
+		{
+		case ECommandType::SET_RENDER_TARGET:
+			return mTextures.IsAlive(command.handle) && (command.arg0 == 0 || mTextures.IsAlive(command.arg0));
+
+		case ECommandType::CLEAR_RENDER_TARGET:
+		case ECommandType::CLEAR_DEPTH_STENCIL:
+		case ECommandType::SET_PS_TEXTURE:
+			return mTextures.IsAlive(command.handle);
+
+		case ECommandType::RESOLVE_TEXTURE:
+		case ECommandType::COPY_TEXTURE:
+			return mTextures.IsAlive(command.handle) && mTextures.IsAlive(command.arg0);
+
+		case ECommandType::SET_INPUT_LAYOUT:
+			return mInputLayouts.IsAlive(command.handle);
+
+		case ECommandType::SET_VERTEX_BUFFER:
+		case ECommandType::SET_INDEX_BUFFER:
+		case ECommandType::SET_VS_CONSTANT_BUFFER:
+		case ECommandType::SET_PS_CONSTANT_BUFFER:
+			return mBuffers.IsAlive(command.handle);
+
+		case ECommandType::SET_PS_BUFFER:
+			return mBuffers.IsAlive(command.handle)
+				&& (mBuffers.Get(command.handle).bindFlags & BIND_SHADER_RESOURCE)
+				&& mBuffers.Get(command.handle).structureByteStride > 0;
+
+		case ECommandType::UPDATE_BUFFER:
+			return mBuffers.IsAlive(command.handle)
+				&& command.arg2 + command.arg1 <= mBuffers.Get(command.handle).byteWidth
+				&& (command.arg2 == 0 || !(mBuffers.Get(command.handle).bindFlags & BIND_CONSTANT_BUFFER));
+
+		case ECommandType::COPY_BUFFER:
+			return mBuffers.IsAlive(command.handle) && mBuffers.IsAlive(command.arg0) && command.handle != command.arg0;
+
+		case ECommandType::SET_VERTEX_SHADER:
+			return mVertexShaders.IsAlive(command.handle);
+
+		case ECommandType::SET_PIXEL_SHADER:
+			return mPixelShaders.IsAlive(command.handle);
+
+		case ECommandType::SET_PS_SAMPLER:
+			return mSamplerStates.IsAlive(command.handle);
+
+		case ECommandType::SET_RASTERIZER_STATE:
+			return mRasterizerStates.IsAlive(command.handle);
+
+		case ECommandType::SET_BLEND_STATE:
+			return mBlendStates.IsAlive(command.handle);
+
+		case ECommandType::SET_DEPTH_STENCIL_STATE:
+			return mDepthStencilStates.IsAlive(command.handle);
+
+		default:
+			return true;
+		}
+	}
+}
\ No newline at end of file
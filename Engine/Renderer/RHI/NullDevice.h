@@ -0,0 +1,120 @@
+#pragma once
+
+#include "RHIDevice.h"
+#include "ResourcePool.h"
+
+namespace RHI
+{
+	// 헤드리스 백엔드, 리소스 설명만 가지고 제출된 명령을 모두 검사하고 기록함
+	// GPU 없이 렌더 경로를 돌릴 때 씀
+	class NullDevice final : public Device
+	{
+	public:
+		struct WorkStats
+		{
+			uint64_t triangleCount;
+			uint32_t drawCount;
+			uint32_t invalidCommandCount;
+			uint32_t incompleteDrawCount;
+			uint32_t presentCount;
+		};
+
+	public:
+		NullDevice(const uint32_t backBufferWidth, const uint32_t backBufferHeight);
+		virtual ~NullDevice() = default;
+
+		virtual BufferHandle CreateBuffer(const BufferDesc& desc, const void* const pInitialDataOrNull) override;
+		virtual void DestroyBuffer(const BufferHandle buffer) override;
+
+		virtual TextureHandle CreateTexture(const TextureDesc& desc, const SubresourceData* const pInitialDataOrNull) override;
+		virtual TextureHandle CreateTextureFromFile(const char* const path) override;
+		virtual void DestroyTexture(const TextureHandle texture) override;
+		virtual TextureDesc GetTextureDesc(const TextureHandle texture) const override;
+
+		virtual bool TryCompileShaderFromFile(
+			const char* const path,
+			const char* const entryPoint,
+			const char* const target,
+			const ShaderDefine* const pDefinesOrNull,
+			const uint32_t defineCount,
+			std::vector<uint8_t>& outBytecode
+		) override;
+
+		virtual VertexShaderHandle CreateVertexShader(const void* const pBytecode, const size_t byteSize) override;
+		virtual PixelShaderHandle CreatePixelShader(const void* const pBytecode, const size_t byteSize) override;
+		virtual InputLayoutHandle CreateInputLayout(
+			const InputElementDesc* const pElements,
+			const uint32_t elementCount,
+			const void* const pBytecode,
+			const size_t byteSize
+		) override;
+
+		virtual void DestroyVertexShader(const VertexShaderHandle shader) override;
+		virtual void DestroyPixelShader(const PixelShaderHandle shader) override;
+		virtual void DestroyInputLayout(const InputLayoutHandle inputLayout) override;
+
+		virtual RasterizerStateHandle CreateRasterizerState(const RasterizerDesc& desc) override;
+		virtual SamplerStateHandle CreateSamplerState(const SamplerDesc& desc) override;
+		virtual BlendStateHandle CreateBlendState(const BlendDesc& desc) override;
+		virtual DepthStencilStateHandle CreateDepthStencilState(const DepthStencilDesc& desc) override;
+
+		virtual void DestroyRasterizerState(const RasterizerStateHandle state) override;
+		virtual void DestroySamplerState(const SamplerStateHandle state) override;
+		virtual void DestroyBlendState(const BlendStateHandle state) override;
+		virtual void DestroyDepthStencilState(const DepthStencilStateHandle state) override;
+
+		virtual TextureHandle GetBackBuffer() const override;
+		virtual bool TryResizeBackBuffer(const uint32_t width, const uint32_t height) override;
+		virtual void Present(const bool bVSync) override;
+
+		virtual uint32_t GetSupportedSampleCount(const EFormat format, const uint32_t desiredSampleCount) const override;
+
+		virtual ResourceStats GetResourceStats() const override;
+
+		virtual const char* GetName() const override
+		{
+			return "Null";
+		}
+
+		// 마지막으로 Present한 프레임의 명령
+		inline const std::vector<Command>& GetLastFrameCommands() const
+		{
+			return mLastFrameCommands;
+		}
+
+		inline const WorkStats& GetWorkStats() const
+		{
+			return mWorkStats;
+		}
+
+		inline void SetRecording(const bool bRecording)
+		{
+			mbRecording = bRecording;
+		}
+
+	protected:
+		virtual void executeCommandList(const CommandList& commandList) override;
+
+	private:
+		ResourcePool<BufferDesc> mBuffers;
+		ResourcePool<TextureDesc> mTextures;
+		ResourcePool<size_t> mVertexShaders;
+		ResourcePool<size_t> mPixelShaders;
+		ResourcePool<uint32_t> mInputLayouts;
+		ResourcePool<RasterizerDesc> mRasterizerStates;
+		ResourcePool<SamplerDesc> mSamplerStates;
+		ResourcePool<BlendDesc> mBlendStates;
+		ResourcePool<DepthStencilDesc> mDepthStencilStates;
+
+		TextureHandle mBackBuffer;
+
+		bool mbRecording;
+		std::vector<Command> mFrameCommands;
+		std::vector<Command> mLastFrameCommands;
+
+		WorkStats mWorkStats;
+
+	private:
+		bool isHandleAlive(const Command& command) const;
+	};
+}
\ No newline at end of file
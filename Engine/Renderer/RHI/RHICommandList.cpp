@@ -0,0 +1,242 @@
+#include "RHICommandList.h"
+
+#include <cstring>
+
+enum
+{
+	DEFAULT_COMMAND_BUFFER_SIZE = 1024,
+	DEFAULT_PAYLOAD_BUFFER_SIZE = 16 * 1024,
+	PAYLOAD_ALIGNMENT = 16
+};
+
+namespace RHI
+{
+	CommandList::CommandList()
+		: mCommands()
+		, mPayload()
+		, mDrawCount(0)
+	{
+		mCommands.reserve(DEFAULT_COMMAND_BUFFER_SIZE);
+		mPayload.reserve(DEFAULT_PAYLOAD_BUFFER_SIZE);
+	}
+
+	void CommandList::Reset()
+	{
+		mCommands.clear();
+		mPayload.clear();
+		mDrawCount = 0;
+	}
+
+	void CommandList::SetViewport(const Viewport& viewport)
+	{
+		const uint32_t offset = pushPayload(&viewport, sizeof(Viewport));
+
+		push(ECommandType::SET_VIEWPORT, 0, 0, offset, 0, 0);
+	}
+
+	void CommandList::SetRenderTarget(const TextureHandle color, const TextureHandle depth)
+	{
+		push(ECommandType::SET_RENDER_TARGET, 0, color.id, depth.id, 0, 0);
+	}
+
+	void CommandList::ClearRenderTarget(const TextureHandle texture, const float color[4])
+	{
+		ASSERT(texture.IsValid());
+		ASSERT(color != nullptr);
+
+		const uint32_t offset = pushPayload(color, sizeof(float) * 4);
+
+		push(ECommandType::CLEAR_RENDER_TARGET, 0, texture.id, offset, 0, 0);
+	}
+
+	void CommandList::ClearDepthStencil(const TextureHandle texture, const float depth, const uint8_t stencil)
+	{
+		ASSERT(texture.IsValid());
+
+		uint32_t depthBits;
+		memcpy(&depthBits, &depth, sizeof(float));
+
+		push(ECommandType::CLEAR_DEPTH_STENCIL, 0, texture.id, depthBits, stencil, 0);
+	}
+
+	void CommandList::SetInputLayout(const InputLayoutHandle inputLayout)
+	{
+		push(ECommandType::SET_INPUT_LAYOUT, 0, inputLayout.id, 0, 0, 0);
+	}
+
+	void CommandList::SetVertexBuffer(const uint32_t slot, const BufferHandle buffer, const uint32_t stride, const uint32_t offset)
+	{
+		ASSERT(slot < MAX_VERTEX_BUFFER_SLOTS);
+
+		push(ECommandType::SET_VERTEX_BUFFER, slot, buffer.id, stride, offset, 0);
+	}
+
+	void CommandList::SetIndexBuffer(const BufferHandle buffer, const EFormat format, const uint32_t offset)
+	{
+		ASSERT(format == EFormat::R16_UINT || format == EFormat::R32_UINT);
+
+		push(ECommandType::SET_INDEX_BUFFER, 0, buffer.id, static_cast<uint32_t>(format), offset, 0);
+	}
+
+	void CommandList::SetPrimitiveTopology(const EPrimitiveTopology topology)
+	{
+		push(ECommandType::SET_PRIMITIVE_TOPOLOGY, 0, 0, static_cast<uint32_t>(topology), 0, 0);
+	}
+
+	void CommandList::SetVertexShader(const VertexShaderHandle shader)
+	{
+		push(ECommandType::SET_VERTEX_SHADER, 0, shader.id, 0, 0, 0);
+	}
+
+	void CommandList::SetPixelShader(const PixelShaderHandle shader)
+	{
+		push(ECommandType::SET_PIXEL_SHADER, 0, shader.id, 0, 0, 0);
+	}
+
+	void CommandList::SetVSConstantBuffer(const uint32_t slot, const BufferHandle buffer)
+	{
+		ASSERT(slot < MAX_CONSTANT_BUFFER_SLOTS);
+
+		push(ECommandType::SET_VS_CONSTANT_BUFFER, slot, buffer.id, 0, 0, 0);
+	}
+
+	void CommandList::SetPSConstantBuffer(const uint32_t slot, const BufferHandle buffer)
+	{
+		ASSERT(slot < MAX_CONSTANT_BUFFER_SLOTS);
+
+		push(ECommandType::SET_PS_CONSTANT_BUFFER, slot, buffer.id, 0, 0, 0);
+	}
+
+	void CommandList::SetPSTexture(const uint32_t slot, const TextureHandle texture)
+	{
+		ASSERT(slot < MAX_SHADER_RESOURCE_SLOTS);
+
+		push(ECommandType::SET_PS_TEXTURE, slot, texture.id, 0, 0, 0);
+	}
+
+	void CommandList::SetPSBuffer(const uint32_t slot, const BufferHandle buffer)
+	{
+		ASSERT(slot < MAX_SHADER_RESOURCE_SLOTS);
+
+		push(ECommandType::SET_PS_BUFFER, slot, buffer.id, 0, 0, 0);
+	}
+
+	void CommandList::SetPSSampler(const uint32_t slot, const SamplerStateHandle sampler)
+	{
+		ASSERT(slot < MAX_SAMPLER_SLOTS);
+
+		push(ECommandType::SET_PS_SAMPLER, slot, sampler.id, 0, 0, 0);
+	}
+
+	void CommandList::SetRasterizerState(const RasterizerStateHandle state)
+	{
+		push(ECommandType::SET_RASTERIZER_STATE, 0, state.id, 0, 0, 0);
+	}
+
+	void CommandList::SetBlendState(const BlendStateHandle state)
+	{
+		push(ECommandType::SET_BLEND_STATE, 0, state.id, 0, 0, 0);
+	}
+
+	void CommandList::SetDepthStencilState(const DepthStencilStateHandle state)
+	{
+		push(ECommandType::SET_DEPTH_STENCIL_STATE, 0, state.id, 0, 0, 0);
+	}
+
+	void CommandList::UpdateBuffer(const BufferHandle buffer, const void* const pData, const uint32_t byteSize)
+	{
+		ASSERT(buffer.IsValid());
+		ASSERT(pData != nullptr);
+		ASSERT(byteSize > 0);
+
+		const uint32_t offset = pushPayload(pData, byteSize);
+
+		push(ECommandType::UPDATE_BUFFER, 0, buffer.id, offset, byteSize, 0);
+	}
+
+	void CommandList::UpdateBufferRegion(const BufferHandle buffer, const uint32_t destOffset, const void* const pData, const uint32_t byteSize)
+	{
+		ASSERT(buffer.IsValid());
+		ASSERT(pData != nullptr);
+		ASSERT(byteSize > 0);
+
+		const uint32_t offset = pushPayload(pData, byteSize);
+
+		push(ECommandType::UPDATE_BUFFER, 0, buffer.id, offset, byteSize, destOffset);
+	}
+
+	void CommandList::Draw(const uint32_t vertexCount, const uint32_t startVertex)
+	{
+		push(ECommandType::DRAW, 0, 0, vertexCount, startVertex, 0);
+
+		++mDrawCount;
+	}
+
+	void CommandList::DrawIndexed(const uint32_t indexCount, const uint32_t startIndex, const int32_t baseVertex)
+	{
+		push(ECommandType::DRAW_INDEXED, 0, 0, indexCount, startIndex, static_cast<uint32_t>(baseVertex));
+
+		++mDrawCount;
+	}
+
+	void CommandList::ResolveTexture(const TextureHandle dest, const TextureHandle src, const EFormat format)
+	{
+		ASSERT(dest.IsValid());
+		ASSERT(src.IsValid());
+
+		push(ECommandType::RESOLVE_TEXTURE, 0, dest.id, src.id, static_cast<uint32_t>(format), 0);
+	}
+
+	void CommandList::CopyTexture(const TextureHandle dest, const TextureHandle src)
+	{
+		ASSERT(dest.IsValid());
+		ASSERT(src.IsValid());
+
+		push(ECommandType::COPY_TEXTURE, 0, dest.id, src.id, 0, 0);
+	}
+
+	void CommandList::CopyBuffer(const BufferHandle dest, const uint32_t destOffset, const BufferHandle src, const uint32_t srcOffset, const uint32_t byteSize)
+	{
+		ASSERT(dest.IsValid());
+		ASSERT(src.IsValid());
+		ASSERT(dest != src);
+		ASSERT(byteSize > 0);
+
+		const uint32_t region[3] = { destOffset, srcOffset, byteSize };
+
+		const uint32_t offset = pushPayload(region, sizeof(region));
+
+		push(ECommandType::COPY_BUFFER, 0, dest.id, src.id, offset, 0);
+	}
+
+	void CommandList::push(
+		const ECommandType type,
+		const uint32_t slot,
+		const uint32_t handle,
+		const uint32_t arg0,
+		const uint32_t arg1,
+		const uint32_t arg2
+	)
+	{
+		Command command;
+		command.type = type;
+		command.slot = static_cast<uint8_t>(slot);
+		command.handle = handle;
+		command.arg0 = arg0;
+		command.arg1 = arg1;
+		command.arg2 = arg2;
+
+		mCommands.push_back(command);
+	}
+
+	uint32_t CommandList::pushPayload(const void* const pData, const uint32_t byteSize)
+	{
+		// 상수 버퍼 데이터를 그대로 읽을 수 있도록 16바이트 정렬
+		const size_t offset = (mPayload.size() + PAYLOAD_ALIGNMENT - 1) & ~static_cast<size_t>(PAYLOAD_ALIGNMENT - 1);
+
+		mPayload.resize(offset + byteSize);
+		memcpy(mPayload.data() + offset, pData, byteSize);
+
+		return static_cast<uint32_t>(offset);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <vector>
+
+#include "Core/Assert.h"
+#include "RHITypes.h"
+
+namespace RHI
+{
+	// 종류, handle / arg0 / arg1 / arg2의 의미
+#define RHI_COMMAND_LIST \
+	RHI_COMMAND_ENTRY(SET_VIEWPORT)            /* -, payload offset, -, - */ \
+	RHI_COMMAND_ENTRY(SET_RENDER_TARGET)       /* color texture, depth texture, -, - */ \
+	RHI_COMMAND_ENTRY(CLEAR_RENDER_TARGET)     /* texture, payload offset(float4), -, - */ \
+	RHI_COMMAND_ENTRY(CLEAR_DEPTH_STENCIL)     /* texture, depth bits, stencil, - */ \
+	RHI_COMMAND_ENTRY(SET_INPUT_LAYOUT)        /* input layout, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_VERTEX_BUFFER)       /* buffer, stride, offset, - */ \
+	RHI_COMMAND_ENTRY(SET_INDEX_BUFFER)        /* buffer, EFormat, offset, - */ \
+	RHI_COMMAND_ENTRY(SET_PRIMITIVE_TOPOLOGY)  /* -, EPrimitiveTopology, -, - */ \
+	RHI_COMMAND_ENTRY(SET_VERTEX_SHADER)       /* shader, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_PIXEL_SHADER)        /* shader, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_VS_CONSTANT_BUFFER)  /* buffer, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_PS_CONSTANT_BUFFER)  /* buffer, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_PS_TEXTURE)          /* texture, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_PS_BUFFER)           /* structured buffer, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_PS_SAMPLER)          /* sampler, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_RASTERIZER_STATE)    /* state, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_BLEND_STATE)         /* state, -, -, - */ \
+	RHI_COMMAND_ENTRY(SET_DEPTH_STENCIL_STATE) /* state, -, -, - */ \
+	RHI_COMMAND_ENTRY(UPDATE_BUFFER)           /* buffer, payload offset, byte size, dest offset */ \
+	RHI_COMMAND_ENTRY(DRAW)                    /* -, vertex count, start vertex, - */ \
+	RHI_COMMAND_ENTRY(DRAW_INDEXED)            /* -, index count, start index, base vertex */ \
+	RHI_COMMAND_ENTRY(RESOLVE_TEXTURE)         /* dest texture, src texture, EFormat, - */ \
+	RHI_COMMAND_ENTRY(COPY_TEXTURE)            /* dest texture, src texture, -, - */ \
+	RHI_COMMAND_ENTRY(COPY_BUFFER)             /* dest buffer, src buffer, payload offset(dest offset, src offset, byte size), - */ \
+
+	enum class ECommandType : uint8_t
+	{
+#define RHI_COMMAND_ENTRY(type) type,
+		RHI_COMMAND_LIST
+#undef RHI_COMMAND_ENTRY
+
+		COUNT
+	};
+
+	consteval int GetCommandTypeCount()
+	{
+		return static_cast<int>(ECommandType::COUNT);
+	}
+
+	constexpr const char* const GetCommandTypeName(const ECommandType type)
+	{
+		constexpr const char* const names[] =
+		{
+		#define RHI_COMMAND_ENTRY(type) #type,
+			RHI_COMMAND_LIST
+		#undef RHI_COMMAND_ENTRY
+		};
+
+		return names[static_cast<int>(type)];
+	}
+
+	struct Command
+	{
+		ECommandType type;
+		uint8_t slot;
+		uint32_t handle;
+		uint32_t arg0;
+		uint32_t arg1;
+		uint32_t arg2;
+	};
+	static_assert(sizeof(Command) == 20);
+
+	// GPU 작업을 기록만 함, 기록할 때 디바이스를 건드리지 않으므로
+	// GPU 없이도 렌더 경로를 돌리고 목록을 검사할 수 있음
+	class CommandList final
+	{
+	public:
+		CommandList();
+		~CommandList() = default;
+
+		CommandList(CommandList&& other) noexcept = default;
+		CommandList& operator=(CommandList&& other) noexcept = default;
+
+		void Reset();
+
+		void SetViewport(const Viewport& viewport);
+		void SetRenderTarget(const TextureHandle color, const TextureHandle depth);
+		void ClearRenderTarget(const TextureHandle texture, const float color[4]);
+		void ClearDepthStencil(const TextureHandle texture, const float depth, const uint8_t stencil);
+
+		void SetInputLayout(const InputLayoutHandle inputLayout);
+		void SetVertexBuffer(const uint32_t slot, const BufferHandle buffer, const uint32_t stride, const uint32_t offset);
+		void SetIndexBuffer(const BufferHandle buffer, const EFormat format, const uint32_t offset);
+		void SetPrimitiveTopology(const EPrimitiveTopology topology);
+
+		void SetVertexShader(const VertexShaderHandle shader);
+		void SetPixelShader(const PixelShaderHandle shader);
+
+		void SetVSConstantBuffer(const uint32_t slot, const BufferHandle buffer);
+		void SetPSConstantBuffer(const uint32_t slot, const BufferHandle buffer);
+		void SetPSTexture(const uint32_t slot, const TextureHandle texture);
+		void SetPSBuffer(const uint32_t slot, const BufferHandle buffer);
+		void SetPSSampler(const uint32_t slot, const SamplerStateHandle sampler);
+
+		void SetRasterizerState(const RasterizerStateHandle state);
+		void SetBlendState(const BlendStateHandle state);
+		void SetDepthStencilState(const DepthStencilStateHandle state);
+
+		void UpdateBuffer(const BufferHandle buffer, const void* const pData, const uint32_t byteSize);
+
+		// 상수 버퍼가 아닌 버퍼의 destOffset 바이트부터 일부만 씀
+		void UpdateBufferRegion(const BufferHandle buffer, const uint32_t destOffset, const void* const pData, const uint32_t byteSize);
+
+		void Draw(const uint32_t vertexCount, const uint32_t startVertex);
+		void DrawIndexed(const uint32_t indexCount, const uint32_t startIndex, const int32_t baseVertex);
+
+		void ResolveTexture(const TextureHandle dest, const TextureHandle src, const EFormat format);
+		void CopyTexture(const TextureHandle dest, const TextureHandle src);
+
+		// dest와 src는 다른 버퍼여야 함
+		void CopyBuffer(const BufferHandle dest, const uint32_t destOffset, const BufferHandle src, const uint32_t srcOffset, const uint32_t byteSize);
+
+		inline const std::vector<Command>& GetCommands() const
+		{
+			return mCommands;
+		}
+
+		inline const void* GetPayload(const uint32_t offset) const
+		{
+			ASSERT(offset < mPayload.size());
+
+			return mPayload.data() + offset;
+		}
+
+		inline uint32_t GetPayloadSize() const
+		{
+			return static_cast<uint32_t>(mPayload.size());
+		}
+
+		inline uint32_t GetDrawCount() const
+		{
+			return mDrawCount;
+		}
+
+		inline bool IsEmpty() const
+		{
+			return mCommands.empty();
+		}
+
+	private:
+		std::vector<Command> mCommands;
+		std::vector<uint8_t> mPayload;
+
+		uint32_t mDrawCount;
+
+	private:
+		void push(const ECommandType type, const uint32_t slot, const uint32_t handle, const uint32_t arg0, const uint32_t arg1, const uint32_t arg2);
+		uint32_t pushPayload(const void* const pData, const uint32_t byteSize);
+
+	private:
+		CommandList(const CommandList& other) = delete;
+		CommandList& operator=(const CommandList& other) = delete;
+	};
+}
\ No newline at end of file
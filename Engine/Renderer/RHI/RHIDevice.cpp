@@ -0,0 +1,94 @@
+#include "RHIDevice.h"
+
+namespace RHI
+{
+	Device::Device()
+		: mFrameStats{}
+	{
+	}
+
+	void Device::Submit(const CommandList& commandList)
+	{
+		if (commandList.IsEmpty())
+		{
+			return;
+		}
+
+		accumulateFrameStats(commandList);
+
+		executeCommandList(commandList);
+	}
+
+	void Device::Submit(const CommandList* const pCommandLists, const uint32_t count)
+	{
+		ASSERT(pCommandLists != nullptr || count == 0);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			accumulateFrameStats(pCommandLists[i]);
+		}
+
+		executeCommandLists(pCommandLists, count);
+	}
+
+	void Device::executeCommandLists(const CommandList* const pCommandLists, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (!pCommandLists[i].IsEmpty())
+			{
+				executeCommandList(pCommandLists[i]);
+			}
+		}
+	}
+
+	void Device::accumulateFrameStats(const CommandList& commandList)
+	{
+		if (commandList.IsEmpty())
+		{
+			return;
+		}
+
+		// 백엔드마다 같은 수치가 나오도록 통계는 여기서 모음
+		const std::vector<Command>& commands = commandList.GetCommands();
+
+		++mFrameStats.submitCount;
+		mFrameStats.commandCount += static_cast<uint32_t>(commands.size());
+
+		for (const Command& command : commands)
+		{
+			switch (command.type)
+			{
+			case ECommandType::DRAW:
+			case ECommandType::DRAW_INDEXED:
+				++mFrameStats.drawCount;
+				mFrameStats.indexCount += command.arg0;
+				break;
+
+			case ECommandType::UPDATE_BUFFER:
+				++mFrameStats.bufferUpdateCount;
+				mFrameStats.uploadBytes += command.arg1;
+				break;
+
+			case ECommandType::SET_INPUT_LAYOUT:
+			case ECommandType::SET_VERTEX_BUFFER:
+			case ECommandType::SET_INDEX_BUFFER:
+			case ECommandType::SET_VERTEX_SHADER:
+			case ECommandType::SET_PIXEL_SHADER:
+			case ECommandType::SET_VS_CONSTANT_BUFFER:
+			case ECommandType::SET_PS_CONSTANT_BUFFER:
+			case ECommandType::SET_PS_TEXTURE:
+			case ECommandType::SET_PS_BUFFER:
+			case ECommandType::SET_PS_SAMPLER:
+			case ECommandType::SET_RASTERIZER_STATE:
+			case ECommandType::SET_BLEND_STATE:
+			case ECommandType::SET_DEPTH_STENCIL_STATE:
+				++mFrameStats.bindCount;
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
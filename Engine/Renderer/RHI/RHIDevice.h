@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+
+#include "RHITypes.h"
+#include "RHICommandList.h"
+
+namespace RHI
+{
+	struct FrameStats
+	{
+		uint32_t submitCount;
+		uint32_t commandCount;
+		uint32_t drawCount;
+		uint64_t indexCount;
+		uint32_t bindCount;
+		uint32_t bufferUpdateCount;
+		uint64_t uploadBytes;
+	};
+
+	struct ResourceStats
+	{
+		uint32_t bufferCount;
+		uint32_t textureCount;
+		uint32_t shaderCount;
+		uint32_t stateCount;
+	};
+
+	// 얇은 디바이스 추상화, 리소스는 바로 만들고
+	// GPU 작업은 Submit으로만 백엔드에 전달됨
+	class Device
+	{
+	public:
+		Device();
+		virtual ~Device() = default;
+
+		// buffers
+		virtual BufferHandle CreateBuffer(const BufferDesc& desc, const void* const pInitialDataOrNull) = 0;
+		virtual void DestroyBuffer(const BufferHandle buffer) = 0;
+
+		// textures
+		virtual TextureHandle CreateTexture(const TextureDesc& desc, const SubresourceData* const pInitialDataOrNull) = 0;
+		virtual TextureHandle CreateTextureFromFile(const char* const path) = 0;
+		virtual void DestroyTexture(const TextureHandle texture) = 0;
+		virtual TextureDesc GetTextureDesc(const TextureHandle texture) const = 0;
+
+		// shaders
+		virtual bool TryCompileShaderFromFile(
+			const char* const path,
+			const char* const entryPoint,
+			const char* const target,
+			const ShaderDefine* const pDefinesOrNull,
+			const uint32_t defineCount,
+			std::vector<uint8_t>& outBytecode
+		) = 0;
+
+		virtual VertexShaderHandle CreateVertexShader(const void* const pBytecode, const size_t byteSize) = 0;
+		virtual PixelShaderHandle CreatePixelShader(const void* const pBytecode, const size_t byteSize) = 0;
+		virtual InputLayoutHandle CreateInputLayout(
+			const InputElementDesc* const pElements,
+			const uint32_t elementCount,
+			const void* const pBytecode,
+			const size_t byteSize
+		) = 0;
+
+		virtual void DestroyVertexShader(const VertexShaderHandle shader) = 0;
+		virtual void DestroyPixelShader(const PixelShaderHandle shader) = 0;
+		virtual void DestroyInputLayout(const InputLayoutHandle inputLayout) = 0;
+
+		// pipeline states
+		virtual RasterizerStateHandle CreateRasterizerState(const RasterizerDesc& desc) = 0;
+		virtual SamplerStateHandle CreateSamplerState(const SamplerDesc& desc) = 0;
+		virtual BlendStateHandle CreateBlendState(const BlendDesc& desc) = 0;
+		virtual DepthStencilStateHandle CreateDepthStencilState(const DepthStencilDesc& desc) = 0;
+
+		virtual void DestroyRasterizerState(const RasterizerStateHandle state) = 0;
+		virtual void DestroySamplerState(const SamplerStateHandle state) = 0;
+		virtual void DestroyBlendState(const BlendStateHandle state) = 0;
+		virtual void DestroyDepthStencilState(const DepthStencilStateHandle state) = 0;
+
+		// swap chain
+		virtual TextureHandle GetBackBuffer() const = 0;
+		virtual bool TryResizeBackBuffer(const uint32_t width, const uint32_t height) = 0;
+		virtual void Present(const bool bVSync) = 0;
+
+		virtual uint32_t GetSupportedSampleCount(const EFormat format, const uint32_t desiredSampleCount) const = 0;
+
+		virtual ResourceStats GetResourceStats() const = 0;
+
+		virtual const char* GetName() const = 0;
+
+		void Submit(const CommandList& commandList);
+
+		// 목록은 주어진 순서대로 실행, 번역은 백엔드가 병렬로 할 수 있음
+		void Submit(const CommandList* const pCommandLists, const uint32_t count);
+
+		inline const FrameStats& GetFrameStats() const
+		{
+			return mFrameStats;
+		}
+
+		inline void ResetFrameStats()
+		{
+			mFrameStats = {};
+		}
+
+	protected:
+		virtual void executeCommandList(const CommandList& commandList) = 0;
+		virtual void executeCommandLists(const CommandList* const pCommandLists, const uint32_t count);
+
+	private:
+		FrameStats mFrameStats;
+
+	private:
+		void accumulateFrameStats(const CommandList& commandList);
+
+	private:
+		Device(const Device& other) = delete;
+		Device& operator=(const Device& other) = delete;
+		Device(Device&& other) = delete;
+		Device& operator=(Device&& other) = delete;
+	};
+}
\ No newline at end of file
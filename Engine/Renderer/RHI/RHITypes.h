@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// 모든 RHI 구현이 같이 쓰는 백엔드 중립 리소스 설명
+namespace RHI
+{
+	// 핸들 id 0은 "리소스 없음"
+#define RHI_HANDLE_LIST \
+	RHI_HANDLE_ENTRY(BufferHandle) \
+	RHI_HANDLE_ENTRY(TextureHandle) \
+	RHI_HANDLE_ENTRY(VertexShaderHandle) \
+	RHI_HANDLE_ENTRY(PixelShaderHandle) \
+	RHI_HANDLE_ENTRY(InputLayoutHandle) \
+	RHI_HANDLE_ENTRY(RasterizerStateHandle) \
+	RHI_HANDLE_ENTRY(SamplerStateHandle) \
+	RHI_HANDLE_ENTRY(BlendStateHandle) \
+	RHI_HANDLE_ENTRY(DepthStencilStateHandle) \
+
+#define RHI_HANDLE_ENTRY(name) \
+	struct name \
+	{ \
+		uint32_t id; \
+		\
+		constexpr bool IsValid() const \
+		{ \
+			return id != 0; \
+		} \
+		\
+		constexpr bool operator==(const name& other) const = default; \
+	};
+
+	RHI_HANDLE_LIST
+#undef RHI_HANDLE_ENTRY
+
+	// 이름, 원소 하나의 바이트 수(압축 포맷은 블록 크기)
+#define RHI_FORMAT_LIST \
+	RHI_FORMAT_ENTRY(UNKNOWN, 0) \
+	RHI_FORMAT_ENTRY(R8G8B8A8_UNORM, 4) \
+	RHI_FORMAT_ENTRY(R8G8B8A8_UNORM_SRGB, 4) \
+	RHI_FORMAT_ENTRY(R16G16B16A16_FLOAT, 8) \
+	RHI_FORMAT_ENTRY(R16G16B16A16_UNORM, 8) \
+	RHI_FORMAT_ENTRY(R32G32B32A32_FLOAT, 16) \
+	RHI_FORMAT_ENTRY(R32G32B32_FLOAT, 12) \
+	RHI_FORMAT_ENTRY(R32G32_FLOAT, 8) \
+	RHI_FORMAT_ENTRY(R16G16_FLOAT, 4) \
+	RHI_FORMAT_ENTRY(R16G16_SNORM, 4) \
+	RHI_FORMAT_ENTRY(R32_FLOAT, 4) \
+	RHI_FORMAT_ENTRY(R16_UINT, 2) \
+	RHI_FORMAT_ENTRY(R32_UINT, 4) \
+	RHI_FORMAT_ENTRY(D24_UNORM_S8_UINT, 4) \
+	RHI_FORMAT_ENTRY(BC1_UNORM, 8) \
+	RHI_FORMAT_ENTRY(BC3_UNORM, 16) \
+	RHI_FORMAT_ENTRY(BC5_UNORM, 16) \
+	RHI_FORMAT_ENTRY(BC7_UNORM, 16) \
+
+	enum class EFormat : uint8_t
+	{
+#define RHI_FORMAT_ENTRY(name, bytes) name,
+		RHI_FORMAT_LIST
+#undef RHI_FORMAT_ENTRY
+
+		COUNT
+	};
+
+	consteval int GetFormatCount()
+	{
+		return static_cast<int>(EFormat::COUNT);
+	}
+
+	constexpr uint32_t GetFormatByteSize(const EFormat format)
+	{
+		constexpr uint32_t sizes[] =
+		{
+		#define RHI_FORMAT_ENTRY(name, bytes) bytes,
+			RHI_FORMAT_LIST
+		#undef RHI_FORMAT_ENTRY
+		};
+
+		return sizes[static_cast<int>(format)];
+	}
+
+	// 4x4 픽셀 블록
+	constexpr bool IsBlockCompressedFormat(const EFormat format)
+	{
+		return format == EFormat::BC1_UNORM
+			|| format == EFormat::BC3_UNORM
+			|| format == EFormat::BC5_UNORM
+			|| format == EFormat::BC7_UNORM;
+	}
+
+	constexpr uint32_t GetRowPitch(const EFormat format, const uint32_t width)
+	{
+		if (IsBlockCompressedFormat(format))
+		{
+			return ((width + 3) / 4) * GetFormatByteSize(format);
+		}
+
+		return width * GetFormatByteSize(format);
+	}
+
+	// 2D 서브리소스 하나의 바이트 수
+	constexpr uint64_t GetSurfaceByteSize(const EFormat format, const uint32_t width, const uint32_t height)
+	{
+		const uint64_t rowCount = IsBlockCompressedFormat(format) ? (height + 3) / 4 : height;
+
+		return static_cast<uint64_t>(GetRowPitch(format, width)) * rowCount;
+	}
+
+	constexpr const char* const GetFormatName(const EFormat format)
+	{
+		constexpr const char* const names[] =
+		{
+		#define RHI_FORMAT_ENTRY(name, bytes) #name,
+			RHI_FORMAT_LIST
+		#undef RHI_FORMAT_ENTRY
+		};
+
+		return names[static_cast<int>(format)];
+	}
+
+	enum EBindFlag : uint32_t
+	{
+		BIND_NONE = 0,
+		BIND_VERTEX_BUFFER = 1 << 0,
+		BIND_INDEX_BUFFER = 1 << 1,
+		BIND_CONSTANT_BUFFER = 1 << 2,
+		BIND_SHADER_RESOURCE = 1 << 3,
+		BIND_RENDER_TARGET = 1 << 4,
+		BIND_DEPTH_STENCIL = 1 << 5
+	};
+
+	enum ETextureMiscFlag : uint32_t
+	{
+		TEXTURE_MISC_NONE = 0,
+
+		// arraySize가 1이어도 셰이더 리소스 뷰를 Texture2DArray로 만듦
+		TEXTURE_MISC_ARRAY = 1 << 0
+	};
+
+	enum class EUsage : uint8_t
+	{
+		DEFAULT,
+		IMMUTABLE,
+		DYNAMIC
+	};
+
+	enum class EPrimitiveTopology : uint8_t
+	{
+		TRIANGLE_LIST
+	};
+
+	struct BufferDesc
+	{
+		uint32_t byteWidth;
+		uint32_t bindFlags;
+		uint32_t structureByteStride;
+		EUsage usage;
+	};
+
+	struct TextureDesc
+	{
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipLevels;
+		uint32_t arraySize;
+		uint32_t sampleCount;
+		uint32_t bindFlags;
+		uint32_t miscFlags;
+		EFormat format;
+		EUsage usage;
+	};
+
+	struct SubresourceData
+	{
+		const void* pData;
+		uint32_t rowPitch;
+		uint32_t slicePitch;
+	};
+
+	// 셰이더 컴파일러에 넘기는 전처리기 매크로
+	struct ShaderDefine
+	{
+		const char* name;
+		const char* value;
+	};
+
+	struct InputElementDesc
+	{
+		const char* semanticName;
+		uint32_t semanticIndex;
+		EFormat format;
+		uint32_t inputSlot;
+		uint32_t alignedByteOffset;
+	};
+
+	struct Viewport
+	{
+		float topLeftX;
+		float topLeftY;
+		float width;
+		float height;
+		float minDepth;
+		float maxDepth;
+	};
+
+	// 파이프라인 상태 설명
+	enum class EFillMode : uint8_t
+	{
+		SOLID,
+		WIREFRAME
+	};
+
+	enum class ECullMode : uint8_t
+	{
+		NONE,
+		FRONT,
+		BACK
+	};
+
+	enum class EFilter : uint8_t
+	{
+		POINT,
+		LINEAR,
+		ANISOTROPIC
+	};
+
+	enum class EAddressMode : uint8_t
+	{
+		WRAP,
+		CLAMP
+	};
+
+	enum class EBlend : uint8_t
+	{
+		ZERO,
+		ONE,
+		SRC_ALPHA,
+		INV_SRC_ALPHA
+	};
+
+	enum class EBlendOp : uint8_t
+	{
+		ADD
+	};
+
+	enum class EComparison : uint8_t
+	{
+		NEVER,
+		LESS,
+		LESS_EQUAL,
+		EQUAL,
+		ALWAYS
+	};
+
+	struct RasterizerDesc
+	{
+		EFillMode fillMode;
+		ECullMode cullMode;
+		bool bDepthClipEnable;
+	};
+
+	struct SamplerDesc
+	{
+		EFilter filter;
+		EAddressMode addressMode;
+		float maxLOD;
+	};
+
+	struct BlendDesc
+	{
+		bool bBlendEnable;
+		EBlend srcBlend;
+		EBlend destBlend;
+		EBlendOp blendOp;
+		EBlend srcBlendAlpha;
+		EBlend destBlendAlpha;
+		EBlendOp blendOpAlpha;
+		uint8_t renderTargetWriteMask;
+	};
+
+	struct DepthStencilDesc
+	{
+		bool bDepthEnable;
+		bool bDepthWriteEnable;
+		EComparison depthFunc;
+	};
+
+	enum
+	{
+		COLOR_WRITE_ENABLE_ALL = 0x0F,
+		MAX_VERTEX_BUFFER_SLOTS = 4,
+		MAX_CONSTANT_BUFFER_SLOTS = 8,
+		MAX_SHADER_RESOURCE_SLOTS = 8,
+		MAX_SAMPLER_SLOTS = 4
+	};
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "Core/Assert.h"
+
+namespace RHI
+{
+	// RHI 핸들 뒤의 슬롯 저장소, id = 인덱스 + 1이라 0은 항상 무효
+	template<typename T>
+	class ResourcePool final
+	{
+	public:
+		ResourcePool()
+			: mSlots()
+			, mbAlive()
+			, mFreeIds()
+			, mLiveCount(0)
+		{
+		}
+		~ResourcePool() = default;
+
+		uint32_t Allocate(T&& resource)
+		{
+			uint32_t id;
+
+			if (!mFreeIds.empty())
+			{
+				id = mFreeIds.back();
+				mFreeIds.pop_back();
+
+				mSlots[id - 1] = std::move(resource);
+				mbAlive[id - 1] = true;
+			}
+			else
+			{
+				mSlots.push_back(std::move(resource));
+				mbAlive.push_back(true);
+
+				id = static_cast<uint32_t>(mSlots.size());
+			}
+
+			++mLiveCount;
+
+			return id;
+		}
+
+		void Free(const uint32_t id)
+		{
+			ASSERT(IsAlive(id));
+
+			mSlots[id - 1] = T();
+			mbAlive[id - 1] = false;
+			mFreeIds.push_back(id);
+
+			--mLiveCount;
+		}
+
+		inline bool IsAlive(const uint32_t id) const
+		{
+			return id != 0 && id <= mSlots.size() && mbAlive[id - 1];
+		}
+
+		inline T& Get(const uint32_t id)
+		{
+			ASSERT(IsAlive(id));
+
+			return mSlots[id - 1];
+		}
+
+		inline const T& Get(const uint32_t id) const
+		{
+			ASSERT(IsAlive(id));
+
+			return mSlots[id - 1];
+		}
+
+		inline uint32_t GetLiveCount() const
+		{
+			return mLiveCount;
+		}
+
+		template<typename FUNC>
+		void ForEachAlive(FUNC func)
+		{
+			for (uint32_t i = 0; i < static_cast<uint32_t>(mSlots.size()); ++i)
+			{
+				if (mbAlive[i])
+				{
+					func(i + 1, mSlots[i]);
+				}
+			}
+		}
+
+	private:
+		std::vector<T> mSlots;
+		std::vector<bool> mbAlive;
+		std::vector<uint32_t> mFreeIds;
+
+		uint32_t mLiveCount;
+
+	private:
+		ResourcePool(const ResourcePool& other) = delete;
+		ResourcePool& operator=(const ResourcePool& other) = delete;
+		ResourcePool(ResourcePool&& other) = delete;
+		ResourcePool& operator=(ResourcePool&& other) = delete;
+	};
+}
\ No newline at end of file
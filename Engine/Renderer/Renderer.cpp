@@ -1,9 +1,15 @@
 #include "Renderer.h"
 
+#include <cfloat>
+#include <cmath>
+#include <chrono>
+#include <cstring>
+
 #include "UI/ImGuiHeaders.h"
+#include "UI/IEditorUIBackend.h"
 
-#include "Core/ComHelper.h"
 #include "Core/LogHelper.h"
+#include "Core/JobSystem.h"
 #include "Resources/TextureManager.h"
 #include "Resources/ShaderManager.h"
 #include "Resources/MeshManager.h"
@@ -21,10 +27,13 @@
 enum
 {
 	DEFAULT_COMMAND_QUEUE_SIZE = 256,
-	DEFAULT_BUFFER_SIZE = 32
+	DEFAULT_BUFFER_SIZE = 32,
+	MIN_DRAWS_PER_COMMAND_LIST = 64,
+	MIN_DRAWS_PER_LIGHT_CHUNK = 256,
+	DEFAULT_LIGHT_CAPACITY = 64
 };
 
-// ü ؼ ʱȭ  
+// 구조체에 대해서 초기화 경고 끄기
 #pragma warning(push)
 #pragma warning(disable : 26495)
 struct CBFrame
@@ -38,213 +47,284 @@ struct CBWorldMatrix
 {
 	Matrix world;
 	Matrix invTrans;
+	uint32_t lightCount;
+	uint32_t dummy[3];
+	uint32_t lightIndices[Renderer::MAX_OBJECT_LIGHTS]; // uint4 두 개로 묶임
+	Vector4 positionScale; // 양자화된 메쉬만 씀
+	Vector4 positionOffset;
 };
+static_assert(sizeof(CBWorldMatrix) % 16 == 0);
+static_assert(Renderer::MAX_OBJECT_LIGHTS <= 8); // 셰이더 변형의 빛 개수 구간
+
+struct CBCluster
+{
+	Vector3 cameraForward;
+	uint32_t lightCount;
+	uint32_t clusterCountX;
+	uint32_t clusterCountY;
+	uint32_t clusterCountZ;
+	float sliceScale;
+	float tileSizeX;
+	float tileSizeY;
+	float sliceBias;
+	float dummy;
+};
+static_assert(sizeof(CBCluster) % 16 == 0);
 #pragma warning(pop)
 
+// 물체에서 가장 가까운 점의 감쇠 * 밝기, 닿지 않으면 0
+static float EstimateLightImportance(const Light& light, const BoundingSphere& sphere)
+{
+	const Vector3 toObject = sphere.Center - light.position;
+	const float centerDist = toObject.Length();
+
+	const float dist = centerDist > sphere.Radius ? centerDist - sphere.Radius : 0.f;
+
+	if (dist >= light.falloffEnd)
+	{
+		return 0.f;
+	}
+
+	const float falloffRange = light.falloffEnd - light.falloffStart;
+	float attenuation = falloffRange > 0.f ? (light.falloffEnd - dist) / falloffRange : 1.f;
+	attenuation = attenuation < 1.f ? attenuation : 1.f;
+
+	// 스포트라이트는 중심 방향으로 추정, 물체가 빛을 감싸면 그대로 둠
+	float spotFactor = 1.f;
+
+	if (light.spotPower > 0.f && centerDist > sphere.Radius)
+	{
+		const float cosAngle = toObject.Dot(light.direction) / (centerDist * light.direction.Length());
+
+		spotFactor = cosAngle > 0.f ? powf(cosAngle, light.spotPower) : 0.f;
+	}
+
+	const float luminance = 0.2126f * light.strength.x + 0.7152f * light.strength.y + 0.0722f * light.strength.z;
+
+	// 뒤쪽 스포트라이트도 범위 안이면 목록 끝에 남도록 최소값 유지
+	return luminance * attenuation * spotFactor + FLT_MIN;
+}
+
+// 1, 2, 4, ... maxThreadCount
+static std::vector<uint32_t> MakeBenchmarkThreadCounts(const uint32_t maxThreadCount)
+{
+	std::vector<uint32_t> threadCounts;
+
+	for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+
+	threadCounts.push_back(maxThreadCount);
+
+	return threadCounts;
+}
+
 Renderer* Renderer::spInstance = nullptr;
 
 Renderer::Renderer(
-	ID3D11Device* const pDevice,
-	ID3D11DeviceContext* const pDeviceContext,
-	IDXGISwapChain1* const pSwapChain,
+	RHI::Device* const pDevice,
+	IEditorUIBackend* const pUIBackendOrNull,
 	const UINT refreshRate
 )
 	: mpDevice(pDevice)
-	, mpDeviceContext(pDeviceContext)
-	, mpSwapChain(pSwapChain)
-	, mpBackBufferViewGPU(nullptr)
-	, mpMultiSampleRenderTargetViewGPU(nullptr)
-	, mpMultiSampleDepthStencilViewGPU(nullptr)
-	, mpHDRRenderTargetViewGPU(nullptr)
-	, mpHDRResourceViewGPU(nullptr)
-	, mpSDRRenderTargetViewGPU(nullptr)
-	, mpCommonDepthStencilViewGPU(nullptr)
+	, mCommandList()
+	, mDrawCommandLists()
+	, mThreadCount(1)
+	, mMaxThreadCount(1)
+	, mpUIBackend(pUIBackendOrNull)
+	, mFrameGraph()
+	, mTransientTexturePool(*pDevice)
+	, mSceneColorTarget{ 0 }
+	, mSceneDepthTarget{ 0 }
+	, mMultiSampleCount(1)
 	, mViewport{ 0.f, }
+	, mPipelineStateCache(*pDevice)
+	, mRasterizerStateIDs{}
+	, mSamplerStateIDs{}
+	, mBlendStateIDs{}
+	, mDepthStencilStateIDs{}
 	, mRefreshRate(refreshRate)
 	, mbVSync(false)
+	, mbMultiSampling(true)
+	, mbViewFrustumCulling(true)
+	, mbWireframeMode(false)
+	, mbObjectLightLists(true)
+	, mbDepthPrePass(true)
+	, mbDepthPrePassActive(false)
 	, mClearColor{ 1.f, 1.f, 1.f, 1.f }
 	, mRenderCommandQueue()
-	, mpCBFrameGPU(nullptr)
-	, mpCBWorldMatrixGPU(nullptr)
+	, mDepthPrePassQueue()
+	, mCBFrame{ 0 }
+	, mCBWorldMatrix{ 0 }
+	, mCBCluster{ 0 }
+	, mLightBuffer{ 0 }
+	, mClusterRangeBuffer{ 0 }
+	, mLightIndexBuffer{ 0 }
+	, mLightBufferCapacity(0)
+	, mLightIndexBufferCapacity(0)
 	, mpEditorCameraComponent(nullptr)
 	, mpMainCameraComponent(nullptr)
 	, mSceneComponents()
 	, mDebugSphereRenderCommand{}
 	, mbOnDebugSphere(false)
-	, mLightPool{}
-	, mLightCount(0)
+	, mLights()
+	, mLightClusterer()
+	, mClusterCamera{}
+	, mCameraForward(Vector3::UnitZ)
+	, mLastFrameStats{}
+	, mCullTimeMs(0.f)
+	, mRecordTimeMs(0.f)
+	, mGraphTimeMs(0.f)
+	, mLightBinningTimeMs(0.f)
+	, mLightAssignTimeMs(0.f)
+	, mSubmitTimeMs(0.f)
+	, mVisibleCount(0)
+	, mDrawListCount(0)
+	, mObjectLightCount(0)
+	, mMaxObjectLightCount(0)
+	, mDroppedObjectLightCount(0)
+	, mShadingCost(0)
+	, mDepthPrePassRecordTimeMs(0.f)
+	, mDepthPrePassDrawCount(0)
+	, mDepthPrePassVertexBytes(0)
+	, mDepthPrePassFullVertexBytes(0)
+	, mRecordBenchmarkResults()
+	, mLightBinningBenchmarkResults()
 {
 	ASSERT(pDevice != nullptr);
-	ASSERT(pDeviceContext != nullptr);
-	ASSERT(pSwapChain != nullptr);
 
 	mRenderCommandQueue.reserve(DEFAULT_COMMAND_QUEUE_SIZE);
+	mDepthPrePassQueue.reserve(DEFAULT_COMMAND_QUEUE_SIZE);
 	mSceneComponents.reserve(DEFAULT_BUFFER_SIZE);
 
+	// 워커 + 호출 스레드
+	if (JobSystem::IsInitialized())
+	{
+		mMaxThreadCount = static_cast<int>(JobSystem::GetInstance().GetWorkerCount()) + 1;
+	}
+
+	mThreadCount = mMaxThreadCount;
+	mDrawCommandLists.resize(mMaxThreadCount);
+
 	// -----------------------------
 	// Pipeline state objects create
 	// -----------------------------
 	// Rasterizer States
 	{
-		D3D11_RASTERIZER_DESC rd;
-		ZeroMemory(&rd, sizeof(rd));
-
-		rd.FillMode = D3D11_FILL_SOLID;
-		rd.CullMode = D3D11_CULL_BACK;
-		rd.DepthClipEnable = TRUE;
-
-		ID3D11RasterizerState* pRS = nullptr;
-		HRESULT hr = mpDevice->CreateRasterizerState(&rd, &pRS);
-		ASSERT(SUCCEEDED(hr));
-
-		mRasterizerStateMap[ERasterizerType::SOLID] = pRS;
+		RHI::RasterizerDesc rd = {};
+		rd.fillMode = RHI::EFillMode::SOLID;
+		rd.cullMode = RHI::ECullMode::BACK;
+		rd.bDepthClipEnable = true;
 
-		rd.FillMode = D3D11_FILL_WIREFRAME;
-		rd.CullMode = D3D11_CULL_NONE;
+		mRasterizerStateIDs[GetRasterizerTypeInt(ERasterizerType::SOLID)] = mPipelineStateCache.GetRasterizerStateID(rd);
 
-		pRS = nullptr;
-		hr = mpDevice->CreateRasterizerState(&rd, &pRS);
-		ASSERT(SUCCEEDED(hr));
+		rd.fillMode = RHI::EFillMode::WIREFRAME;
+		rd.cullMode = RHI::ECullMode::NONE;
 
-		mRasterizerStateMap[ERasterizerType::WIREFRAME] = pRS;
+		mRasterizerStateIDs[GetRasterizerTypeInt(ERasterizerType::WIREFRAME)] = mPipelineStateCache.GetRasterizerStateID(rd);
 	}
 
 	// Sampler States
 	{
-		D3D11_SAMPLER_DESC sd;
-		ZeroMemory(&sd, sizeof(sd));
+		RHI::SamplerDesc sd = {};
+		sd.filter = RHI::EFilter::LINEAR;
+		sd.addressMode = RHI::EAddressMode::WRAP;
+		sd.maxLOD = FLT_MAX;
 
-		sd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-		sd.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
-		sd.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
-		sd.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-		sd.MaxLOD = D3D11_FLOAT32_MAX;
-
-		ID3D11SamplerState* pSampler = nullptr;
-		HRESULT hr = mpDevice->CreateSamplerState(&sd, &pSampler);
-		ASSERT(SUCCEEDED(hr));
-
-		mSamplerStateMap[ESamplerType::LINEAR_WRAP] = pSampler;
+		mSamplerStateIDs[GetSamplerTypeInt(ESamplerType::LINEAR_WRAP)] = mPipelineStateCache.GetSamplerStateID(sd);
 	}
 
 	// Blend States
 	{
 		// Opaque
-		D3D11_BLEND_DESC bd;
-		ZeroMemory(&bd, sizeof(bd));
-
-		bd.AlphaToCoverageEnable = FALSE;
-		bd.IndependentBlendEnable = FALSE;
-
-		D3D11_RENDER_TARGET_BLEND_DESC& rtb = bd.RenderTarget[0];
+		RHI::BlendDesc bd = {};
+		bd.bBlendEnable = false;
+		bd.srcBlend = RHI::EBlend::ONE;
+		bd.destBlend = RHI::EBlend::ZERO;
+		bd.srcBlendAlpha = RHI::EBlend::ONE;
+		bd.destBlendAlpha = RHI::EBlend::ZERO;
+		bd.renderTargetWriteMask = RHI::COLOR_WRITE_ENABLE_ALL;
 
-		rtb.BlendEnable = FALSE;
-		rtb.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-
-		ID3D11BlendState* pBlend = nullptr;
-		HRESULT hr = mpDevice->CreateBlendState(&bd, &pBlend);
-		ASSERT(SUCCEEDED(hr));
-
-		mBlendStateMap[EBlendStateType::OPAQUE] = pBlend;
+		mBlendStateIDs[GetBlendTypeInt(EBlendStateType::OPAQUE)] = mPipelineStateCache.GetBlendStateID(bd);
 
 		// Alpha blend (standard)
-		ZeroMemory(&bd, sizeof(bd));
-
-		rtb = bd.RenderTarget[0];
-		bd.IndependentBlendEnable = FALSE;
-		rtb.BlendEnable = TRUE;
-		rtb.SrcBlend = D3D11_BLEND_SRC_ALPHA;
-		rtb.DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-		rtb.BlendOp = D3D11_BLEND_OP_ADD;
-		rtb.SrcBlendAlpha = D3D11_BLEND_ONE;
-		rtb.DestBlendAlpha = D3D11_BLEND_ZERO;
-		rtb.BlendOpAlpha = D3D11_BLEND_OP_ADD;
-		rtb.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+		bd.bBlendEnable = true;
+		bd.srcBlend = RHI::EBlend::SRC_ALPHA;
+		bd.destBlend = RHI::EBlend::INV_SRC_ALPHA;
+		bd.blendOp = RHI::EBlendOp::ADD;
+		bd.srcBlendAlpha = RHI::EBlend::ONE;
+		bd.destBlendAlpha = RHI::EBlend::ZERO;
+		bd.blendOpAlpha = RHI::EBlendOp::ADD;
 
-		pBlend = nullptr;
-		hr = mpDevice->CreateBlendState(&bd, &pBlend);
-		ASSERT(SUCCEEDED(hr));
-
-		mBlendStateMap[EBlendStateType::ALPHA_BLEND] = pBlend;
+		mBlendStateIDs[GetBlendTypeInt(EBlendStateType::ALPHA_BLEND)] = mPipelineStateCache.GetBlendStateID(bd);
 
 		// Additive
-		ZeroMemory(&bd, sizeof(bd));
-
-		rtb = bd.RenderTarget[0];
-		bd.IndependentBlendEnable = FALSE;
-		rtb.BlendEnable = TRUE;
-		rtb.SrcBlend = D3D11_BLEND_ONE;
-		rtb.DestBlend = D3D11_BLEND_ONE;
-		rtb.BlendOp = D3D11_BLEND_OP_ADD;
-		rtb.SrcBlendAlpha = D3D11_BLEND_ONE;
-		rtb.DestBlendAlpha = D3D11_BLEND_ZERO;
-		rtb.BlendOpAlpha = D3D11_BLEND_OP_ADD;
-		rtb.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-
-		pBlend = nullptr;
-		hr = mpDevice->CreateBlendState(&bd, &pBlend);
-		ASSERT(SUCCEEDED(hr));
-
-		mBlendStateMap[EBlendStateType::ADDITIVE] = pBlend;
+		bd.srcBlend = RHI::EBlend::ONE;
+		bd.destBlend = RHI::EBlend::ONE;
+
+		mBlendStateIDs[GetBlendTypeInt(EBlendStateType::ADDITIVE)] = mPipelineStateCache.GetBlendStateID(bd);
 	}
 
 	// Depth Stencil States
 	{
 		// Enabled
-		D3D11_DEPTH_STENCIL_DESC dd;
-		ZeroMemory(&dd, sizeof(dd));
+		RHI::DepthStencilDesc dd = {};
+		dd.bDepthEnable = true;
+		dd.bDepthWriteEnable = true;
+		dd.depthFunc = RHI::EComparison::LESS;
 
-		dd.DepthEnable = TRUE;
-		dd.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-		dd.DepthFunc = D3D11_COMPARISON_LESS;
-		dd.StencilEnable = FALSE;
+		mDepthStencilStateIDs[GetDepthStencilTypeInt(EDepthStencilType::DEPTH_ENABLED)] = mPipelineStateCache.GetDepthStencilStateID(dd);
 
-		ID3D11DepthStencilState* pDS = nullptr;
-		HRESULT hr = mpDevice->CreateDepthStencilState(&dd, &pDS);
-		ASSERT(SUCCEEDED(hr));
+		// Disabled
+		dd.bDepthEnable = false;
+		dd.bDepthWriteEnable = false;
 
-		mDepthStencilStateMap[EDepthStencilType::DEPTH_ENABLED] = pDS;
+		mDepthStencilStateIDs[GetDepthStencilTypeInt(EDepthStencilType::DEPTH_DISABLED)] = mPipelineStateCache.GetDepthStencilStateID(dd);
 
-		// Disabled
-		ZeroMemory(&dd, sizeof(dd));
+		// Read only, 깊이 프리패스가 채운 값과 같은 면만 통과
+		dd.bDepthEnable = true;
+		dd.bDepthWriteEnable = false;
+		dd.depthFunc = RHI::EComparison::LESS_EQUAL;
 
-		dd.DepthEnable = FALSE;
-		dd.StencilEnable = FALSE;
+		mDepthStencilStateIDs[GetDepthStencilTypeInt(EDepthStencilType::DEPTH_READ_ONLY)] = mPipelineStateCache.GetDepthStencilStateID(dd);
+	}
 
-		pDS = nullptr;
-		hr = mpDevice->CreateDepthStencilState(&dd, &pDS);
-		ASSERT(SUCCEEDED(hr));
+	for (const PipelineStateCache::StateID id : mRasterizerStateIDs)
+	{
+		ASSERT(id != PipelineStateCache::INVALID_STATE_ID);
+	}
 
-		mDepthStencilStateMap[EDepthStencilType::DEPTH_DISABLED] = pDS;
+	for (const PipelineStateCache::StateID id : mBlendStateIDs)
+	{
+		ASSERT(id != PipelineStateCache::INVALID_STATE_ID);
+	}
+
+	for (const PipelineStateCache::StateID id : mDepthStencilStateIDs)
+	{
+		ASSERT(id != PipelineStateCache::INVALID_STATE_ID);
 	}
 
+	ASSERT(mSamplerStateIDs[0] != PipelineStateCache::INVALID_STATE_ID);
+
 	// CBFrame
 	{
 		CBFrame cbFrame;
 		cbFrame.cameraPos = Vector3(0.f, 0.f, 0.f);
 		cbFrame.viewProj = Matrix::Identity;
 
-		mpCBFrameGPU = createConstantBufferAlloc(&cbFrame, sizeof(CBFrame));
+		mCBFrame = createConstantBuffer(&cbFrame, sizeof(CBFrame));
 	}
 
 	// world matrix
 	{
-		CBWorldMatrix cbWorld;
+		CBWorldMatrix cbWorld = {};
 		cbWorld.world = Matrix::Identity;
 		cbWorld.invTrans = Matrix::Identity;
 
-		mpCBWorldMatrixGPU = createConstantBufferAlloc(&cbWorld, sizeof(CBWorldMatrix));
+		mCBWorldMatrix = createConstantBuffer(&cbWorld, sizeof(CBWorldMatrix));
 	}
 
-	ID3D11Buffer* const defaultBuffers[] = {
-		mpCBFrameGPU, mpCBWorldMatrixGPU
-	};
-
-	constexpr int ARRAY_SIZE = ARRAYSIZE(defaultBuffers);
-
-	mpDeviceContext->VSSetConstantBuffers(0, ARRAY_SIZE, defaultBuffers);
-	mpDeviceContext->PSSetConstantBuffers(0, ARRAY_SIZE, defaultBuffers);
-
 	// debug sphere
 	{
 		MeshManager& meshManager = MeshManager::GetInstance();
@@ -253,131 +333,338 @@ Renderer::Renderer(
 		mDebugSphereRenderCommand.pMesh = meshManager.GetMeshOrNull("Sphere");
 		mDebugSphereRenderCommand.pMaterial = materialManager.GetMaterialOrNull("DebugSphere");
 		mDebugSphereRenderCommand.worldMatrix = Matrix::Identity;
+		mDebugSphereRenderCommand.boundingSphereWorld = BoundingSphere(Vector3::Zero, 1.f);
+		mDebugSphereRenderCommand.lightCount = 0;
+		mDebugSphereRenderCommand.shaderFeatures = SHADER_FEATURE_NONE;
 	}
 
-	// light
+	// light clusters
 	{
-		mpCBLightGPU = createConstantBufferAlloc(mLightPool, sizeof(mLightPool));
+		const CBCluster cbCluster = {};
+		mCBCluster = createConstantBuffer(&cbCluster, sizeof(CBCluster));
+
+		mLights.reserve(DEFAULT_LIGHT_CAPACITY);
 
-		mpDeviceContext->PSSetConstantBuffers(CB_LIGHT_SLOT, 1, &mpCBLightGPU);
+		reserveStructuredBuffer(mLightBuffer, mLightBufferCapacity, sizeof(Light), DEFAULT_LIGHT_CAPACITY);
+		reserveStructuredBuffer(mLightIndexBuffer, mLightIndexBufferCapacity, sizeof(uint32_t), LightClusterer::CLUSTER_COUNT);
+
+		mClusterRangeBuffer = createStructuredBuffer(sizeof(LightClusterer::ClusterRange), LightClusterer::CLUSTER_COUNT);
 	}
 }
 
 Renderer::~Renderer()
 {
-	ImGui_ImplDX11_Shutdown();
-	ImGui_ImplWin32_Shutdown();
-	ImGui::DestroyContext();
+	// ImGui가 디바이스 리소스를 먼저 놓도록 가장 먼저 해제
+	delete mpUIBackend;
 
-	SafeRelease(mpCBLightGPU);
-	SafeRelease(mpCBWorldMatrixGPU);
-	SafeRelease(mpCBFrameGPU);
+	mpDevice->DestroyBuffer(mLightIndexBuffer);
+	mpDevice->DestroyBuffer(mClusterRangeBuffer);
+	mpDevice->DestroyBuffer(mLightBuffer);
+	mpDevice->DestroyBuffer(mCBCluster);
+	mpDevice->DestroyBuffer(mCBWorldMatrix);
+	mpDevice->DestroyBuffer(mCBFrame);
 
-	for (std::pair<const EDepthStencilType, ID3D11DepthStencilState*>& pair : mDepthStencilStateMap)
-	{
-		SafeRelease(pair.second);
-	}
+	mPipelineStateCache.Clear();
+
+	ModelManager::Destroy();
+	MaterialManager::Destroy();
+	MeshManager::Destroy();
+	ShaderManager::Destroy();
+	TextureManager::Destroy();
+
+	mFrameGraph.Reset();
+	mTransientTexturePool.Clear();
 
-	for (std::pair<const EBlendStateType, ID3D11BlendState*>& pair : mBlendStateMap)
+	delete mpDevice;
+}
+
+RHI::BufferHandle Renderer::createConstantBuffer(const void* const pData, const UINT byteWidth)
+{
+	RHI::BufferDesc bufferDesc = {};
+	bufferDesc.usage = RHI::EUsage::DEFAULT;
+	bufferDesc.byteWidth = byteWidth;
+	bufferDesc.bindFlags = RHI::BIND_CONSTANT_BUFFER;
+
+	const RHI::BufferHandle ret = mpDevice->CreateBuffer(bufferDesc, pData);
+	ASSERT(ret.IsValid());
+
+	return ret;
+}
+
+RHI::BufferHandle Renderer::createStructuredBuffer(const UINT stride, const UINT elementCount)
+{
+	RHI::BufferDesc bufferDesc = {};
+	bufferDesc.usage = RHI::EUsage::DEFAULT;
+	bufferDesc.byteWidth = stride * elementCount;
+	bufferDesc.bindFlags = RHI::BIND_SHADER_RESOURCE;
+	bufferDesc.structureByteStride = stride;
+
+	const RHI::BufferHandle ret = mpDevice->CreateBuffer(bufferDesc, nullptr);
+	ASSERT(ret.IsValid());
+
+	return ret;
+}
+
+void Renderer::reserveStructuredBuffer(RHI::BufferHandle& buffer, uint32_t& capacity, const UINT stride, const uint32_t elementCount)
+{
+	if (buffer.IsValid() && elementCount <= capacity)
 	{
-		SafeRelease(pair.second);
+		return;
 	}
 
-	for (std::pair<const ESamplerType, ID3D11SamplerState*>& pair : mSamplerStateMap)
+	uint32_t newCapacity = capacity > 0 ? capacity : DEFAULT_LIGHT_CAPACITY;
+
+	while (newCapacity < elementCount)
 	{
-		SafeRelease(pair.second);
+		newCapacity *= 2;
 	}
 
-	for (std::pair<const ERasterizerType, ID3D11RasterizerState*>& pair : mRasterizerStateMap)
+	if (buffer.IsValid())
 	{
-		SafeRelease(pair.second);
+		mpDevice->DestroyBuffer(buffer);
 	}
 
-	ModelManager::Destroy();
-	MaterialManager::Destroy();
-	MeshManager::Destroy();
-	ShaderManager::Destroy();
-	TextureManager::Destroy();
+	buffer = createStructuredBuffer(stride, newCapacity);
+	capacity = newCapacity;
+}
+
+void Renderer::updateLightClusters()
+{
+	const uint32_t lightCount = static_cast<uint32_t>(mLights.size());
 
-	SafeRelease(mpCommonDepthStencilViewGPU);
-	SafeRelease(mpSDRRenderTargetViewGPU);
+	mLightClusterer.Build(mLights.data(), lightCount, mClusterCamera, static_cast<uint32_t>(mThreadCount));
 
-	SafeRelease(mpHDRResourceViewGPU);
-	SafeRelease(mpHDRRenderTargetViewGPU);
+	const std::vector<LightClusterer::ClusterRange>& clusterRanges = mLightClusterer.GetClusterRanges();
+	const std::vector<uint32_t>& lightIndices = mLightClusterer.GetLightIndices();
 
-	SafeRelease(mpMultiSampleDepthStencilViewGPU);
-	SafeRelease(mpMultiSampleRenderTargetViewGPU);
+	const uint32_t indexCount = static_cast<uint32_t>(lightIndices.size());
 
-	SafeRelease(mpBackBufferViewGPU);
+	reserveStructuredBuffer(mLightBuffer, mLightBufferCapacity, sizeof(Light), lightCount);
+	reserveStructuredBuffer(mLightIndexBuffer, mLightIndexBufferCapacity, sizeof(uint32_t), indexCount);
 
-	SafeRelease(mpSwapChain);
-	SafeRelease(mpDeviceContext);
-	SafeRelease(mpDevice);
+	if (lightCount > 0)
+	{
+		mCommandList.UpdateBuffer(mLightBuffer, mLights.data(), lightCount * sizeof(Light));
+	}
+
+	if (indexCount > 0)
+	{
+		mCommandList.UpdateBuffer(mLightIndexBuffer, lightIndices.data(), indexCount * sizeof(uint32_t));
+	}
+
+	mCommandList.UpdateBuffer(
+		mClusterRangeBuffer,
+		clusterRanges.data(),
+		static_cast<uint32_t>(clusterRanges.size() * sizeof(LightClusterer::ClusterRange))
+	);
+
+	const CBCluster cbCluster =
+	{
+		mCameraForward,
+		lightCount,
+		LightClusterer::CLUSTER_COUNT_X,
+		LightClusterer::CLUSTER_COUNT_Y,
+		LightClusterer::CLUSTER_COUNT_Z,
+		mLightClusterer.GetSliceScale(),
+		mViewport.width / LightClusterer::CLUSTER_COUNT_X,
+		mViewport.height / LightClusterer::CLUSTER_COUNT_Y,
+		mLightClusterer.GetSliceBias(),
+		0.f
+	};
+
+	mCommandList.UpdateBuffer(mCBCluster, &cbCluster, sizeof(CBCluster));
 }
 
-ID3D11Buffer* Renderer::createConstantBufferAlloc(const void* const pData, const UINT byteWidth)
+void Renderer::assignObjectLights(RenderCommand* const pCommands, const uint32_t count, const uint32_t threadCount)
 {
-	D3D11_BUFFER_DESC bufferDesc;
-	ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+	ASSERT(pCommands != nullptr || count == 0);
+	ASSERT(threadCount >= 1);
 
-	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-	bufferDesc.ByteWidth = byteWidth;
-	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	mObjectLightCount = 0;
+	mMaxObjectLightCount = 0;
+	mDroppedObjectLightCount = 0;
+	mShadingCost = 0;
 
-	D3D11_SUBRESOURCE_DATA initialData;
-	ZeroMemory(&initialData, sizeof(D3D11_SUBRESOURCE_DATA));
+	if (count == 0)
+	{
+		return;
+	}
 
-	initialData.pSysMem = pData;
+	struct ChunkStats
+	{
+		uint32_t lightCount;
+		uint32_t maxLightCount;
+		uint32_t droppedCount;
+		uint64_t shadingCost;
+	};
 
-	ID3D11Buffer* pRet = nullptr;
-	HRESULT hr = mpDevice->CreateBuffer(&bufferDesc, &initialData, &pRet);
-	ASSERT(SUCCEEDED(hr));
+	const uint32_t maxChunkCount = (count + MIN_DRAWS_PER_LIGHT_CHUNK - 1) / MIN_DRAWS_PER_LIGHT_CHUNK;
+	uint32_t chunkCount = threadCount < maxChunkCount ? threadCount : maxChunkCount;
 
-	return pRet;
-}
+	if (!JobSystem::IsInitialized())
+	{
+		chunkCount = 1;
+	}
 
-void Renderer::BeginFrame() const
-{
-	mpDeviceContext->RSSetViewports(1, &mViewport);
+	std::vector<ChunkStats> chunkStats(chunkCount, { 0, 0, 0, 0 });
+
+	// 절두체 밖의 빛은 클러스터 분류에서 이미 걸러짐
+	const std::vector<uint32_t>& visibleLightIndices = mLightClusterer.GetVisibleLightIndices();
 
-	if (mbMultiSampling)
+	// 클러스터 경로는 프레임에 보이는 빛 종류로 변형을 고름
+	uint32_t clusterShaderFeatures = SHADER_FEATURE_NONE;
+
+	for (const uint32_t lightIndex : visibleLightIndices)
 	{
-		mpDeviceContext->ClearRenderTargetView(mpMultiSampleRenderTargetViewGPU, mClearColor);
-		mpDeviceContext->ClearDepthStencilView(mpMultiSampleDepthStencilViewGPU, D3D11_CLEAR_DEPTH, 1.f, 0xFF);
+		if (mLights[lightIndex].spotPower > 0.f)
+		{
+			clusterShaderFeatures = SHADER_FEATURE_SPOT_LIGHTS;
+
+			break;
+		}
+	}
+
+	const JobSystem::ChunkFunction assignChunk = [this, pCommands, &visibleLightIndices, clusterShaderFeatures, &chunkStats](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
+		{
+			ChunkStats& stats = chunkStats[chunkIndex];
+
+			float importances[MAX_OBJECT_LIGHTS];
+
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				RenderCommand& command = pCommands[i];
+				command.lightCount = 0;
+
+				// 중요도 내림차순 삽입 정렬, 넘치면 가장 약한 빛을 버림
+				for (const uint32_t lightIndex : visibleLightIndices)
+				{
+					const float importance = EstimateLightImportance(mLights[lightIndex], command.boundingSphereWorld);
+
+					if (importance <= 0.f)
+					{
+						continue;
+					}
+
+					if (command.lightCount == MAX_OBJECT_LIGHTS)
+					{
+						++stats.droppedCount;
+
+						if (importance <= importances[MAX_OBJECT_LIGHTS - 1])
+						{
+							continue;
+						}
+
+						--command.lightCount;
+					}
+
+					uint32_t slot = command.lightCount;
+
+					while (slot > 0 && importances[slot - 1] < importance)
+					{
+						importances[slot] = importances[slot - 1];
+						command.lightIndices[slot] = command.lightIndices[slot - 1];
+						--slot;
+					}
+
+					importances[slot] = importance;
+					command.lightIndices[slot] = lightIndex;
+					++command.lightCount;
+				}
+
+				// 스포트라이트가 없으면 pow 없는 변형
+				if (mbObjectLightLists)
+				{
+					command.shaderFeatures = SHADER_FEATURE_OBJECT_LIGHTS | GetLightBucketFeature(command.lightCount);
+
+					for (uint32_t j = 0; j < command.lightCount; ++j)
+					{
+						if (mLights[command.lightIndices[j]].spotPower > 0.f)
+						{
+							command.shaderFeatures |= SHADER_FEATURE_SPOT_LIGHTS;
+
+							break;
+						}
+					}
+				}
+				else
+				{
+					command.shaderFeatures = clusterShaderFeatures;
+				}
+
+				stats.lightCount += command.lightCount;
+				stats.shadingCost += static_cast<uint64_t>(command.lightCount) * (command.pMesh->GetIndexCount() / 3);
+
+				if (command.lightCount > stats.maxLightCount)
+				{
+					stats.maxLightCount = command.lightCount;
+				}
+			}
+		};
 
-		mpDeviceContext->OMSetRenderTargets(1, &mpMultiSampleRenderTargetViewGPU, mpMultiSampleDepthStencilViewGPU);
+	if (chunkCount == 1)
+	{
+		assignChunk(0, count, 0);
 	}
 	else
 	{
-		mpDeviceContext->ClearRenderTargetView(mpHDRRenderTargetViewGPU, mClearColor);
-		mpDeviceContext->ClearDepthStencilView(mpCommonDepthStencilViewGPU, D3D11_CLEAR_DEPTH, 1.f, 0xFF);
+		JobSystem::GetInstance().ParallelFor(count, chunkCount, assignChunk);
+	}
+
+	for (const ChunkStats& stats : chunkStats)
+	{
+		mObjectLightCount += stats.lightCount;
+		mDroppedObjectLightCount += stats.droppedCount;
+		mShadingCost += stats.shadingCost;
 
-		mpDeviceContext->OMSetRenderTargets(1, &mpHDRRenderTargetViewGPU, mpCommonDepthStencilViewGPU);
+		if (stats.maxLightCount > mMaxObjectLightCount)
+		{
+			mMaxObjectLightCount = stats.maxLightCount;
+		}
 	}
 }
 
-void Renderer::EndFrame() const
+void Renderer::BeginFrame()
 {
-	mpSwapChain->Present(mbVSync, 0);
+	mCommandList.Reset();
+
+	// 기록이 시작되기 전에만 셰이더와 텍스처, 모델을 교체하고 메쉬를 옮김
+	ShaderManager::GetInstance().ApplyShaderReloads();
+	TextureManager::GetInstance().ApplyTextureLoads();
+	ModelManager::GetInstance().UpdateLoading();
+
+	// 참조가 없는 자원 해제, 놓인 참조가 아래로 내려가도록 모델부터
+	ModelManager::GetInstance().UpdateResidency();
+	MaterialManager::GetInstance().UpdateResidency();
+	MeshManager::GetInstance().UpdateResidency();
+	MeshManager::GetInstance().UpdateDefragmentation();
+	TextureManager::GetInstance().UpdateResidency();
+}
+
+void Renderer::EndFrame()
+{
+	mpDevice->Present(mbVSync);
+
+	mLastFrameStats = mpDevice->GetFrameStats();
+	mpDevice->ResetFrameStats();
 }
 
 void Renderer::RenderScene(const std::string& sceneName)
 {
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
 	mpMainCameraComponent->UpdateCameraInfomation();
 
-	mpDeviceContext->UpdateSubresource(
-		mpCBLightGPU,
-		0,
-		nullptr,
-		mLightPool,
-		0,
-		0
-	);
+	// light clusters
+	const Clock::time_point binningStart = Clock::now();
+
+	updateLightClusters();
 
-	memset(mLightPool, 0, sizeof(mLightPool));
-	mLightCount = 0;
+	mLightBinningTimeMs = Milliseconds(Clock::now() - binningStart).count();
 
 	// frustum culling
+	const Clock::time_point cullStart = Clock::now();
+
 	const std::vector<MeshComponent*>& meshComponentList = mSceneComponents[sceneName];
 
 	for (MeshComponent* const pMeshComponent : meshComponentList)
@@ -390,448 +677,573 @@ void Renderer::RenderScene(const std::string& sceneName)
 		}
 	}
 
-	// draw call
+	mVisibleCount = static_cast<uint32_t>(mRenderCommandQueue.size());
+
+	// texture streaming
+	// UV가 텍스처를 한 번 덮는다고 보고 경계 구의 화면 지름을 원하는 해상도로 씀
+	const float halfViewportHeight = mViewport.height * 0.5f;
+
 	for (const RenderCommand& command : mRenderCommandQueue)
 	{
-		command.pMesh->Bind(*mpDeviceContext);
-		command.pMaterial->Bind(*mpDeviceContext);
-
-		const CBWorldMatrix cbWorldMat =
-		{
-			command.worldMatrix.Transpose(),
-			command.worldMatrix.Invert() // hlsl col-major ġ 
-		};
+		const BoundingSphere& boundingSphere = command.boundingSphereWorld;
 
-		mpDeviceContext->UpdateSubresource(
-			mpCBWorldMatrixGPU,
-			0,
-			nullptr,
-			&cbWorldMat,
-			0,
-			0
-		);
+		float screenPixels = 2.f * boundingSphere.Radius * mClusterCamera.projScaleY * halfViewportHeight;
 
-		if (mbWireframeMode)
+		if (!mClusterCamera.bOrthographic)
 		{
-			mpDeviceContext->RSSetState(mRasterizerStateMap[ERasterizerType::WIREFRAME]);
+			const float viewZ = Vector3::Transform(boundingSphere.Center, mClusterCamera.view).z;
+
+			// 카메라가 구 안에 있으면 가장 가까운 거리로 봄
+			screenPixels /= viewZ > mClusterCamera.nearZ ? viewZ : mClusterCamera.nearZ;
 		}
 
-		mpDeviceContext->DrawIndexed(
-			command.pMesh->GetIndexCount(),
-			0,
-			0
-		);
+		command.pMaterial->RequestTextureDetail(screenPixels);
 	}
-	mRenderCommandQueue.clear();
+
+	TextureManager::GetInstance().UpdateStreaming();
 
 	if (mbOnDebugSphere)
 	{
-		mDebugSphereRenderCommand.pMesh->Bind(*mpDeviceContext);
-		mDebugSphereRenderCommand.pMaterial->Bind(*mpDeviceContext);
+		mRenderCommandQueue.push_back(mDebugSphereRenderCommand);
+	}
 
-		const CBWorldMatrix cbWorldMat =
-		{
-			mDebugSphereRenderCommand.worldMatrix.Transpose(),
-			mDebugSphereRenderCommand.worldMatrix.Invert() // hlsl col-major ġ 
-		};
+	// per-object light lists
+	const Clock::time_point assignStart = Clock::now();
 
-		mpDeviceContext->UpdateSubresource(
-			mpCBWorldMatrixGPU,
-			0,
-			nullptr,
-			&cbWorldMat,
-			0,
-			0
-		);
+	assignObjectLights(
+		mRenderCommandQueue.data(),
+		static_cast<uint32_t>(mRenderCommandQueue.size()),
+		static_cast<uint32_t>(mThreadCount)
+	);
 
-		mpDeviceContext->DrawIndexed(
-			mDebugSphereRenderCommand.pMesh->GetIndexCount(),
-			0,
-			0
-		);
+	mLightAssignTimeMs = Milliseconds(Clock::now() - assignStart).count();
+
+	mLights.clear();
+
+	// 상수 버퍼 갱신은 모든 패스보다 먼저 실행
+	mpDevice->Submit(mCommandList);
+	mCommandList.Reset();
+
+	// frame graph
+	const Clock::time_point graphStart = Clock::now();
+
+	mFrameGraph.Reset();
+
+	RHI::TextureDesc textureDesc = {};
+	textureDesc.width = static_cast<uint32_t>(mViewport.width);
+	textureDesc.height = static_cast<uint32_t>(mViewport.height);
+	textureDesc.mipLevels = 1;
+	textureDesc.arraySize = 1;
+	textureDesc.sampleCount = 1;
+	textureDesc.usage = RHI::EUsage::DEFAULT;
+
+	textureDesc.format = RHI::EFormat::R16G16B16A16_FLOAT;
+	textureDesc.bindFlags = RHI::BIND_RENDER_TARGET | RHI::BIND_SHADER_RESOURCE;
+
+	const FrameGraph::ResourceHandle backBuffer = mFrameGraph.ImportTexture("BackBuffer", mpDevice->GetBackBuffer());
+	const FrameGraph::ResourceHandle hdrColor = mFrameGraph.CreateTexture("HDRColor", textureDesc);
+
+	const bool bMultiSampling = mbMultiSampling && mMultiSampleCount > 1;
+
+	FrameGraph::ResourceHandle sceneColor = hdrColor;
+
+	if (bMultiSampling)
+	{
+		textureDesc.sampleCount = mMultiSampleCount;
+		textureDesc.bindFlags = RHI::BIND_RENDER_TARGET;
+
+		sceneColor = mFrameGraph.CreateTexture("SceneColorMS", textureDesc);
 	}
 
-	// resolve multisample
-	if (mbMultiSampling)
+	textureDesc.format = RHI::EFormat::D24_UNORM_S8_UINT;
+	textureDesc.bindFlags = RHI::BIND_DEPTH_STENCIL;
+
+	const FrameGraph::ResourceHandle sceneDepth = mFrameGraph.CreateTexture("SceneDepth", textureDesc);
+
+	// 와이어프레임은 가려진 선도 보여야 하므로 끔
+	mbDepthPrePassActive = mbDepthPrePass && !mbWireframeMode;
+
+	mDepthPrePassQueue.clear();
+	mDepthPrePassVertexBytes = 0;
+	mDepthPrePassFullVertexBytes = 0;
+
+	if (mbDepthPrePassActive)
 	{
-		ID3D11Resource* pMultiSampleBuffer = nullptr;
-		mpMultiSampleRenderTargetViewGPU->GetResource(&pMultiSampleBuffer);
-
-		ID3D11Resource* pHDRBuffer = nullptr;
-		mpHDRRenderTargetViewGPU->GetResource(&pHDRBuffer);
-
-		mpDeviceContext->ResolveSubresource(
-			pHDRBuffer,
-			0,
-			pMultiSampleBuffer,
-			0,
-			DXGI_FORMAT_R16G16B16A16_FLOAT
-		);
+		for (const RenderCommand& command : mRenderCommandQueue)
+		{
+			if (isDepthPrePassMaterial(*command.pMaterial))
+			{
+				mDepthPrePassQueue.push_back(command);
 
-		SafeRelease(pHDRBuffer);
-		SafeRelease(pMultiSampleBuffer);
+				mDepthPrePassVertexBytes += command.pMesh->GetPositionOnlyBytes();
+				mDepthPrePassFullVertexBytes += command.pMesh->GetVertexBytes();
+			}
+		}
 	}
 
-	// HDR to SDR
+	mDepthPrePassDrawCount = static_cast<uint32_t>(mDepthPrePassQueue.size());
+	mDepthPrePassRecordTimeMs = 0.f;
+
+	// depth pre-pass
+	if (mbDepthPrePassActive)
 	{
-		mpDeviceContext->OMSetRenderTargets(1, &mpSDRRenderTargetViewGPU, nullptr);
+		FrameGraph::PassBuilder pass = mFrameGraph.AddPass("DepthPrePass", [this, sceneDepth](RHI::CommandList& commandList, const FrameGraph& frameGraph)
+			{
+				mSceneDepthTarget = frameGraph.GetTexture(sceneDepth);
 
-		ShaderManager& shaderManager = ShaderManager::GetInstance();
+				commandList.ClearDepthStencil(mSceneDepthTarget, 1.f, 0xFF);
 
-		ID3D11VertexShader* const pVSSprite = shaderManager.GetVertexShaderOrNull(SHADER_PATH("VSFullScreen.hlsl"));
-		ASSERT(pVSSprite != nullptr);
+				mpDevice->Submit(commandList);
+				commandList.Reset();
 
-		mpDeviceContext->VSSetShader(pVSSprite, nullptr, 0);
+				const Clock::time_point recordStart = Clock::now();
 
-		mpDeviceContext->RSSetState(mRasterizerStateMap[ERasterizerType::SOLID]);
+				const uint32_t listCount = recordDrawsParallel(
+					mDepthPrePassQueue.data(),
+					static_cast<uint32_t>(mDepthPrePassQueue.size()),
+					static_cast<uint32_t>(mThreadCount),
+					true
+				);
 
-		ID3D11PixelShader* const pPSSprite = shaderManager.GetPixelShaderOrNull(SHADER_PATH("PSFullScreen.hlsl"));
-		ASSERT(pPSSprite != nullptr);
+				mDepthPrePassRecordTimeMs = Milliseconds(Clock::now() - recordStart).count();
 
-		mpDeviceContext->PSSetShader(pPSSprite, nullptr, 0);
-		mpDeviceContext->PSSetSamplers(0, 1, &mSamplerStateMap[ESamplerType::LINEAR_WRAP]);
-		mpDeviceContext->PSSetShaderResources(0, 1, &mpHDRResourceViewGPU);
+				mpDevice->Submit(mDrawCommandLists.data(), listCount);
+			});
 
-		mpDeviceContext->OMSetDepthStencilState(mDepthStencilStateMap[EDepthStencilType::DEPTH_DISABLED], 0);
+		pass.Write(sceneDepth);
+	}
 
-		MeshManager& meshManager = MeshManager::GetInstance();
-		Mesh* const pSpriteMesh = meshManager.GetMeshOrNull("Square");
-		ASSERT(pSpriteMesh != nullptr);
+	// scene
+	{
+		FrameGraph::PassBuilder pass = mFrameGraph.AddPass("Scene", [this, sceneColor, sceneDepth](RHI::CommandList& commandList, const FrameGraph& frameGraph)
+			{
+				mSceneColorTarget = frameGraph.GetTexture(sceneColor);
+				mSceneDepthTarget = frameGraph.GetTexture(sceneDepth);
+
+				// 초기화는 그리기 목록보다 먼저 실행
+				commandList.ClearRenderTarget(mSceneColorTarget, mClearColor);
+
+				if (!mbDepthPrePassActive)
+				{
+					commandList.ClearDepthStencil(mSceneDepthTarget, 1.f, 0xFF);
+				}
+
+				mpDevice->Submit(commandList);
+				commandList.Reset();
+
+				const Clock::time_point recordStart = Clock::now();
+
+				mDrawListCount = recordDrawsParallel(
+					mRenderCommandQueue.data(),
+					static_cast<uint32_t>(mRenderCommandQueue.size()),
+					static_cast<uint32_t>(mThreadCount),
+					false
+				);
+
+				mRecordTimeMs = Milliseconds(Clock::now() - recordStart).count();
 
-		pSpriteMesh->Bind(*mpDeviceContext);
-		mpDeviceContext->DrawIndexed(pSpriteMesh->GetIndexCount(), 0, 0);
+				mpDevice->Submit(mDrawCommandLists.data(), mDrawListCount);
+			});
 
-		ID3D11ShaderResourceView* const pNullSRV = nullptr;
-		mpDeviceContext->PSSetShaderResources(0, 1, &pNullSRV);
+		if (mbDepthPrePassActive)
+		{
+			pass.Read(sceneDepth);
+		}
+
+		pass.Write(sceneColor);
+		pass.Write(sceneDepth);
 	}
 
-	// SDR to backbuffer
-	ID3D11Resource* pSDRBuffer = nullptr;
-	ID3D11Resource* pBackBuffer = nullptr;
+	// resolve multisample
+	if (bMultiSampling)
 	{
-		mpSDRRenderTargetViewGPU->GetResource(&pSDRBuffer);
-		mpBackBufferViewGPU->GetResource(&pBackBuffer);
+		FrameGraph::PassBuilder pass = mFrameGraph.AddPass("Resolve", [sceneColor, hdrColor](RHI::CommandList& commandList, const FrameGraph& frameGraph)
+			{
+				commandList.ResolveTexture(frameGraph.GetTexture(hdrColor), frameGraph.GetTexture(sceneColor), RHI::EFormat::R16G16B16A16_FLOAT);
+			});
 
-		mpDeviceContext->CopyResource(pBackBuffer, pSDRBuffer);
+		pass.Read(sceneColor);
+		pass.Write(hdrColor);
 	}
-	SafeRelease(pBackBuffer);
-	SafeRelease(pSDRBuffer);
+
+	// HDR to backbuffer
+	{
+		FrameGraph::PassBuilder pass = mFrameGraph.AddPass("Tonemap", [this, hdrColor, backBuffer](RHI::CommandList& commandList, const FrameGraph& frameGraph)
+			{
+				// 목록마다 상태가 초기화되므로 처음부터 바인딩
+				commandList.SetViewport(mViewport);
+				commandList.SetRenderTarget(frameGraph.GetTexture(backBuffer), { 0 });
+
+				ShaderManager& shaderManager = ShaderManager::GetInstance();
+
+				const RHI::VertexShaderHandle vsSprite = shaderManager.GetVertexShader(SHADER_PATH("VSFullScreen.hlsl"));
+				ASSERT(vsSprite.IsValid());
+
+				commandList.SetVertexShader(vsSprite);
+
+				commandList.SetRasterizerState(GetRasterizerState(ERasterizerType::SOLID));
+
+				const RHI::PixelShaderHandle psSprite = shaderManager.GetPixelShader(SHADER_PATH("PSFullScreen.hlsl"));
+				ASSERT(psSprite.IsValid());
+
+				commandList.SetPixelShader(psSprite);
+				commandList.SetPSSampler(0, GetSamplerState(ESamplerType::LINEAR_WRAP));
+				commandList.SetPSTexture(0, frameGraph.GetTexture(hdrColor));
+
+				commandList.SetBlendState(GetBlendState(EBlendStateType::OPAQUE));
+				commandList.SetDepthStencilState(GetDepthStencilState(EDepthStencilType::DEPTH_DISABLED));
+
+				MeshManager& meshManager = MeshManager::GetInstance();
+				Mesh* const pSpriteMesh = meshManager.GetMeshOrNull("Square");
+				ASSERT(pSpriteMesh != nullptr);
+
+				Mesh::BindState bindState = {};
+				pSpriteMesh->Bind(commandList, bindState);
+
+				commandList.DrawIndexed(pSpriteMesh->GetIndexCount(), pSpriteMesh->GetStartIndex(), pSpriteMesh->GetBaseVertex());
+
+				commandList.SetPSTexture(0, { 0 });
+			});
+
+		pass.Read(hdrColor);
+		pass.Write(backBuffer);
+	}
+
+	const bool bCompiled = mFrameGraph.Compile();
+	ASSERT(bCompiled);
+
+	const Clock::time_point executeStart = Clock::now();
+
+	mFrameGraph.Execute(*mpDevice, mTransientTexturePool, mCommandList);
+	mRenderCommandQueue.clear();
+
+	const Clock::time_point executeEnd = Clock::now();
+
+	mCullTimeMs = Milliseconds(assignStart - cullStart).count();
+	mGraphTimeMs = Milliseconds(executeStart - graphStart).count();
+	mSubmitTimeMs = Milliseconds(executeEnd - executeStart).count() - mRecordTimeMs - mDepthPrePassRecordTimeMs;
 }
 
-void Renderer::BeginUIFrame() const
+void Renderer::recordScenePassState(RHI::CommandList& commandList) const
 {
-	mpDeviceContext->OMSetRenderTargets(1, &mpBackBufferViewGPU, nullptr);
-
-	ImGui_ImplWin32_NewFrame();
-	ImGui_ImplDX11_NewFrame();
-	ImGui::NewFrame();
+	commandList.SetViewport(mViewport);
+	commandList.SetRenderTarget(mSceneColorTarget, mSceneDepthTarget);
+
+	commandList.SetVSConstantBuffer(CB_FRAME_SLOT, mCBFrame);
+	commandList.SetPSConstantBuffer(CB_FRAME_SLOT, mCBFrame);
+	commandList.SetVSConstantBuffer(CB_WORLD_MATRIX_SLOT, mCBWorldMatrix);
+	commandList.SetPSConstantBuffer(CB_WORLD_MATRIX_SLOT, mCBWorldMatrix);
+	commandList.SetPSConstantBuffer(CB_CLUSTER_SLOT, mCBCluster);
+	commandList.SetPSBuffer(SR_LIGHT_SLOT, mLightBuffer);
+	commandList.SetPSBuffer(SR_CLUSTER_RANGE_SLOT, mClusterRangeBuffer);
+	commandList.SetPSBuffer(SR_LIGHT_INDEX_SLOT, mLightIndexBuffer);
 }
 
-void Renderer::EndUIFrame() const
+void Renderer::recordDepthPassState(RHI::CommandList& commandList) const
 {
-	ImGui::Render();
-	ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+	commandList.SetViewport(mViewport);
+	commandList.SetRenderTarget({ 0 }, mSceneDepthTarget);
+
+	commandList.SetVSConstantBuffer(CB_FRAME_SLOT, mCBFrame);
+	commandList.SetVSConstantBuffer(CB_WORLD_MATRIX_SLOT, mCBWorldMatrix);
+
+	const RHI::VertexShaderHandle vsDepthOnly = ShaderManager::GetInstance().GetVertexShader(SHADER_PATH("VSDepthOnly.hlsl"));
+	ASSERT(vsDepthOnly.IsValid());
+
+	// 색을 쓰지 않으므로 픽셀 셰이더 없이 그림
+	commandList.SetVertexShader(vsDepthOnly);
+	commandList.SetPixelShader({ 0 });
+
+	commandList.SetRasterizerState(GetRasterizerState(ERasterizerType::SOLID));
+	commandList.SetBlendState(GetBlendState(EBlendStateType::OPAQUE));
+	commandList.SetDepthStencilState(GetDepthStencilState(EDepthStencilType::DEPTH_ENABLED));
 }
 
-void Renderer::OnResize(const int width, const int height)
+bool Renderer::isDepthPrePassMaterial(const Material& material) const
 {
-	ASSERT(width > 0);
-	ASSERT(height > 0);
-	ASSERT(mpDevice != nullptr);
-	ASSERT(mpDeviceContext != nullptr);
+	const PipelineStateCache::PipelineDesc& desc = material.GetPipelineDesc();
 
-	mpDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+	return desc.rasterizer == GetRasterizerStateID(ERasterizerType::SOLID)
+		&& desc.blend == GetBlendStateID(EBlendStateType::OPAQUE)
+		&& desc.depthStencil == GetDepthStencilStateID(EDepthStencilType::DEPTH_ENABLED);
+}
 
-	SafeRelease(mpBackBufferViewGPU);
+void Renderer::recordWorldMatrix(RHI::CommandList& commandList, const RenderCommand& command) const
+{
+	CBWorldMatrix cbWorldMat;
+	cbWorldMat.world = command.worldMatrix.Transpose();
+	cbWorldMat.invTrans = command.worldMatrix.Invert(); // hlsl이 col-major라 전치 생략
+	cbWorldMat.lightCount = command.lightCount;
+	cbWorldMat.dummy[0] = 0;
+	cbWorldMat.dummy[1] = 0;
+	cbWorldMat.dummy[2] = 0;
 
-	SafeRelease(mpMultiSampleRenderTargetViewGPU);
-	SafeRelease(mpMultiSampleDepthStencilViewGPU);
+	memcpy(cbWorldMat.lightIndices, command.lightIndices, sizeof(uint32_t) * command.lightCount);
 
-	SafeRelease(mpHDRRenderTargetViewGPU);
-	SafeRelease(mpHDRResourceViewGPU);
+	const Vector3& positionScale = command.pMesh->GetPositionScale();
+	const Vector3& positionOffset = command.pMesh->GetPositionOffset();
 
-	SafeRelease(mpSDRRenderTargetViewGPU);
-	SafeRelease(mpCommonDepthStencilViewGPU);
+	cbWorldMat.positionScale = Vector4(positionScale.x, positionScale.y, positionScale.z, 0.f);
+	cbWorldMat.positionOffset = Vector4(positionOffset.x, positionOffset.y, positionOffset.z, 0.f);
 
-	// backbuffer
-	HRESULT hr = mpSwapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, 0);
-	if (FAILED(hr))
-	{
-		LOG_SYSTEM_ERROR(hr, "SwapChain - ResizeBuffers");
+	commandList.UpdateBuffer(mCBWorldMatrix, &cbWorldMat, sizeof(CBWorldMatrix));
+}
 
-		ASSERT(false);
+void Renderer::recordDraw(RHI::CommandList& commandList, const RenderCommand& command, PipelineStateCache::PipelineID& inOutPipelineID, RHI::TextureHandle& inOutTexture, Mesh::BindState& inOutBindState) const
+{
+	command.pMesh->Bind(commandList, inOutBindState);
+	command.pMaterial->Bind(commandList, command.pMesh->GetVertexType(), command.shaderFeatures, inOutTexture);
 
-		return;
-	}
+	// 이전 그리기와 조합이 같으면 상태 바인딩을 통째로 건너뜀
+	const PipelineStateCache::PipelineID pipelineID = command.pMaterial->GetPipelineID();
 
-	ID3D11Texture2D* pBackBuffer = nullptr;
+	if (pipelineID != inOutPipelineID)
 	{
-		hr = mpSwapChain->GetBuffer(0, IID_PPV_ARGS(&pBackBuffer));
+		mPipelineStateCache.Bind(commandList, pipelineID);
 
-		if (FAILED(hr))
+		if (mbWireframeMode)
 		{
-			LOG_SYSTEM_ERROR(hr, "GetBuffer");
-
-			ASSERT(false);
+			commandList.SetRasterizerState(GetRasterizerState(ERasterizerType::WIREFRAME));
+		}
 
-			return;
+		// 프리패스가 깊이를 채웠으므로 다시 쓰지 않음
+		if (mbDepthPrePassActive && isDepthPrePassMaterial(*command.pMaterial))
+		{
+			commandList.SetDepthStencilState(GetDepthStencilState(EDepthStencilType::DEPTH_READ_ONLY));
 		}
 
-		hr = mpDevice->CreateRenderTargetView(pBackBuffer, nullptr, &mpBackBufferViewGPU);
+		inOutPipelineID = pipelineID;
+	}
 
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "CreateRenderTargetView - BackBuffer");
+	recordWorldMatrix(commandList, command);
 
-			ASSERT(false);
+	commandList.DrawIndexed(command.pMesh->GetIndexCount(), command.pMesh->GetStartIndex(), command.pMesh->GetBaseVertex());
+}
 
-			return;
-		}
-	}
-	SafeRelease(pBackBuffer);
+void Renderer::recordDepthDraw(RHI::CommandList& commandList, const RenderCommand& command, Mesh::BindState& inOutBindState) const
+{
+	command.pMesh->BindPositionOnly(commandList, inOutBindState);
+
+	recordWorldMatrix(commandList, command);
+
+	commandList.DrawIndexed(command.pMesh->GetIndexCount(), command.pMesh->GetStartIndex(), command.pMesh->GetBaseVertex());
+}
 
-	// multisample
+uint32_t Renderer::recordDrawsParallel(const RenderCommand* const pCommands, const uint32_t count, const uint32_t threadCount, const bool bDepthOnly)
+{
+	ASSERT(pCommands != nullptr || count == 0);
+	ASSERT(threadCount >= 1 && threadCount <= mDrawCommandLists.size());
+
+	if (count == 0)
 	{
-		D3D11_TEXTURE2D_DESC multisampleBufferDesc;
-		ZeroMemory(&multisampleBufferDesc, sizeof(multisampleBufferDesc));
-
-		multisampleBufferDesc.Width = width;
-		multisampleBufferDesc.Height = height;
-		multisampleBufferDesc.MipLevels = 1;
-		multisampleBufferDesc.ArraySize = 1;
-		multisampleBufferDesc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
-		multisampleBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		multisampleBufferDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-
-		UINT quality = 0;
-		UINT sampleCount = 1;
-		hr = mpDevice->CheckMultisampleQualityLevels(DXGI_FORMAT_R16G16B16A16_FLOAT, 4, &quality);
-
-		if (SUCCEEDED(hr) && quality > 0)
-		{
-			sampleCount = 4;
-			--quality;
-		}
+		return 0;
+	}
 
-		multisampleBufferDesc.SampleDesc.Count = sampleCount;
-		multisampleBufferDesc.SampleDesc.Quality = quality;
+	// 목록이 너무 잘게 쪼개지지 않도록 제한
+	const uint32_t maxListCount = (count + MIN_DRAWS_PER_COMMAND_LIST - 1) / MIN_DRAWS_PER_COMMAND_LIST;
+	const uint32_t listCount = threadCount < maxListCount ? threadCount : maxListCount;
 
-		ID3D11Texture2D* pMultisampleBuffer = nullptr;
+	for (uint32_t i = 0; i < listCount; ++i)
+	{
+		mDrawCommandLists[i].Reset();
+	}
+
+	// 목록마다 상태를 처음부터 기록해서 어느 스레드에서 기록되든 결과가 같음
+	const JobSystem::ChunkFunction recordChunk = [this, pCommands, bDepthOnly](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
 		{
-			hr = mpDevice->CreateTexture2D(&multisampleBufferDesc, nullptr, &pMultisampleBuffer);
+			RHI::CommandList& commandList = mDrawCommandLists[chunkIndex];
+
+			Mesh::BindState bindState = {};
 
-			if (FAILED(hr))
+			if (bDepthOnly)
 			{
-				LOG_SYSTEM_ERROR(hr, "CreateTexture2D - MultisampleBuffer");
+				recordDepthPassState(commandList);
 
-				ASSERT(false);
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					recordDepthDraw(commandList, pCommands[i], bindState);
+				}
 
 				return;
 			}
 
-			hr = mpDevice->CreateRenderTargetView(pMultisampleBuffer, nullptr, &mpMultiSampleRenderTargetViewGPU);
+			recordScenePassState(commandList);
+
+			PipelineStateCache::PipelineID pipelineID = PipelineStateCache::INVALID_PIPELINE_ID;
+			RHI::TextureHandle texture = { 0 };
 
-			if (FAILED(hr))
+			for (uint32_t i = begin; i < end; ++i)
 			{
-				LOG_SYSTEM_ERROR(hr, "CreateRenderTargetView - MultisampleView");
+				recordDraw(commandList, pCommands[i], pipelineID, texture, bindState);
+			}
+		};
 
-				ASSERT(false);
+	if (listCount == 1 || !JobSystem::IsInitialized())
+	{
+		recordChunk(0, count, 0);
 
-				return;
-			}
-		}
-		SafeRelease(pMultisampleBuffer);
-
-		D3D11_TEXTURE2D_DESC multisampleDepthStencilBufferDesc;
-		ZeroMemory(&multisampleDepthStencilBufferDesc, sizeof(multisampleDepthStencilBufferDesc));
-
-		multisampleDepthStencilBufferDesc.Width = width;
-		multisampleDepthStencilBufferDesc.Height = height;
-		multisampleDepthStencilBufferDesc.MipLevels = 1;
-		multisampleDepthStencilBufferDesc.ArraySize = 1;
-		multisampleDepthStencilBufferDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-		multisampleDepthStencilBufferDesc.SampleDesc.Count = sampleCount;
-		multisampleDepthStencilBufferDesc.SampleDesc.Quality = quality;
-		multisampleDepthStencilBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		multisampleDepthStencilBufferDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
-
-		ID3D11Texture2D* pMultisampleDepthStencilBuffer = nullptr;
-		{
-			hr = mpDevice->CreateTexture2D(&multisampleDepthStencilBufferDesc, nullptr, &pMultisampleDepthStencilBuffer);
+		return 1;
+	}
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateTexture2D - MultisampleDepthBuffer");
+	JobSystem::GetInstance().ParallelFor(count, listCount, recordChunk);
 
-				ASSERT(false);
+	return listCount;
+}
 
-				return;
-			}
+void Renderer::RunRecordBenchmark(const uint32_t drawCount)
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
 
-			D3D11_DEPTH_STENCIL_VIEW_DESC multisampleDepthStencilViewDesc;
-			ZeroMemory(&multisampleDepthStencilViewDesc, sizeof(multisampleDepthStencilViewDesc));
+	ASSERT(drawCount > 0);
 
-			multisampleDepthStencilViewDesc.Format = multisampleDepthStencilBufferDesc.Format;
-			multisampleDepthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DMS;
+	mRecordBenchmarkResults.clear();
 
-			hr = mpDevice->CreateDepthStencilView(pMultisampleDepthStencilBuffer, &multisampleDepthStencilViewDesc, &mpMultiSampleDepthStencilViewGPU);
+	// 디버그 구를 격자로 배치한 가상의 장면
+	std::vector<RenderCommand> commands;
+	commands.reserve(drawCount);
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateDepthStencilView - MultisampleDepthStencilBuffer");
+	const int gridSize = static_cast<int>(sqrtf(static_cast<float>(drawCount))) + 1;
 
-				ASSERT(false);
+	for (uint32_t i = 0; i < drawCount; ++i)
+	{
+		RenderCommand command = mDebugSphereRenderCommand;
+		command.worldMatrix = Matrix::CreateTranslation(
+			static_cast<float>(i % gridSize),
+			0.f,
+			static_cast<float>(i / gridSize)
+		);
+		command.boundingSphereWorld.Center = command.worldMatrix.Translation();
+		command.lightCount = 0;
 
-				return;
-			}
-		}
-		SafeRelease(pMultisampleDepthStencilBuffer);
+		commands.push_back(command);
 	}
 
-	// non multisample buffers
+	for (const uint32_t threadCount : MakeBenchmarkThreadCounts(static_cast<uint32_t>(mMaxThreadCount)))
 	{
-		D3D11_TEXTURE2D_DESC hdrBufferDesc;
-		ZeroMemory(&hdrBufferDesc, sizeof(hdrBufferDesc));
-
-		hdrBufferDesc.Width = width;
-		hdrBufferDesc.Height = height;
-		hdrBufferDesc.MipLevels = 1;
-		hdrBufferDesc.ArraySize = 1;
-		hdrBufferDesc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
-		hdrBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		hdrBufferDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-		hdrBufferDesc.SampleDesc.Count = 1;
-		hdrBufferDesc.SampleDesc.Quality = 0;
-
-		ID3D11Texture2D* pHDRBuffer = nullptr;
-		{
-			hr = mpDevice->CreateTexture2D(&hdrBufferDesc, nullptr, &pHDRBuffer);
+		const Clock::time_point recordStart = Clock::now();
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateTexture2D - HDRBuffer");
-
-				ASSERT(false);
+		recordDrawsParallel(commands.data(), drawCount, threadCount, false);
 
-				return;
-			}
+		const Clock::time_point recordEnd = Clock::now();
 
-			hr = mpDevice->CreateRenderTargetView(pHDRBuffer, nullptr, &mpHDRRenderTargetViewGPU);
+		mRecordBenchmarkResults.push_back({ threadCount, Milliseconds(recordEnd - recordStart).count() });
+	}
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateRenderTargetView - HDRBufferView");
+	// 기록만 하고 제출하지 않음
+	for (RHI::CommandList& commandList : mDrawCommandLists)
+	{
+		commandList.Reset();
+	}
+}
 
-				ASSERT(false);
+void Renderer::RunLightBinningBenchmark(const uint32_t lightCount)
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
 
-				return;
-			}
+	ASSERT(lightCount > 0);
 
-			hr = mpDevice->CreateShaderResourceView(pHDRBuffer, nullptr, &mpHDRResourceViewGPU);
+	mLightBinningBenchmarkResults.clear();
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateShaderResourceView");
+	if (mClusterCamera.farZ <= mClusterCamera.nearZ)
+	{
+		return;
+	}
 
-				ASSERT(false);
+	// 뷰 공간 상자 안에 고르게 흩뿌린 점광원
+	const Matrix invView = mClusterCamera.view.Invert();
+	const float depthRange = mClusterCamera.farZ - mClusterCamera.nearZ;
 
-				return;
-			}
-		}
-		SafeRelease(pHDRBuffer);
-
-		D3D11_TEXTURE2D_DESC sdrBufferDesc;
-		ZeroMemory(&sdrBufferDesc, sizeof(sdrBufferDesc));
-
-		sdrBufferDesc.Width = width;
-		sdrBufferDesc.Height = height;
-		sdrBufferDesc.MipLevels = 1;
-		sdrBufferDesc.ArraySize = 1;
-		sdrBufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-		sdrBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		sdrBufferDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-		sdrBufferDesc.SampleDesc.Count = 1;
-		sdrBufferDesc.SampleDesc.Quality = 0;
-
-		ID3D11Texture2D* pSDRBuffer = nullptr;
+	uint32_t seed = 12345;
+	const auto random01 = [&seed]()
 		{
-			hr = mpDevice->CreateTexture2D(&sdrBufferDesc, nullptr, &pSDRBuffer);
-
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateTexture2D - SDRBuffer");
-
-				ASSERT(false);
+			seed = seed * 1664525u + 1013904223u;
 
-				return;
-			}
+			return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+		};
 
-			hr = mpDevice->CreateRenderTargetView(pSDRBuffer, nullptr, &mpSDRRenderTargetViewGPU);
+	std::vector<Light> lights(lightCount);
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateRenderTargetView - SDRView");
+	for (Light& light : lights)
+	{
+		const float viewZ = mClusterCamera.nearZ + random01() * depthRange;
+		const Vector3 positionView(
+			(random01() * 2.f - 1.f) * viewZ,
+			(random01() * 2.f - 1.f) * viewZ,
+			viewZ
+		);
 
-				ASSERT(false);
+		light.position = Vector3::Transform(positionView, invView);
+		light.falloffStart = 0.f;
+		light.strength = Vector3(1.f, 1.f, 1.f);
+		light.falloffEnd = 1.f + random01() * depthRange * 0.05f;
+		light.direction = Vector3::UnitZ;
+		light.spotPower = 0.f;
+	}
 
-				return;
-			}
-		}
-		SafeRelease(pSDRBuffer);
+	for (const uint32_t threadCount : MakeBenchmarkThreadCounts(static_cast<uint32_t>(mMaxThreadCount)))
+	{
+		const Clock::time_point binningStart = Clock::now();
 
+		mLightClusterer.Build(lights.data(), lightCount, mClusterCamera, threadCount);
 
-		D3D11_TEXTURE2D_DESC depthStencilBufferDesc;
-		ZeroMemory(&depthStencilBufferDesc, sizeof(depthStencilBufferDesc));
+		const Clock::time_point binningEnd = Clock::now();
 
-		depthStencilBufferDesc.Width = width;
-		depthStencilBufferDesc.Height = height;
-		depthStencilBufferDesc.MipLevels = 1;
-		depthStencilBufferDesc.ArraySize = 1;
-		depthStencilBufferDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-		depthStencilBufferDesc.SampleDesc.Count = 1;
-		depthStencilBufferDesc.SampleDesc.Quality = 0;
-		depthStencilBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		depthStencilBufferDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+		mLightBinningBenchmarkResults.push_back({ threadCount, Milliseconds(binningEnd - binningStart).count() });
+	}
+}
 
-		ID3D11Texture2D* pDepthStencilBuffer = nullptr;
-		{
-			hr = mpDevice->CreateTexture2D(&depthStencilBufferDesc, nullptr, &pDepthStencilBuffer);
+void Renderer::BeginUIFrame()
+{
+	mCommandList.SetRenderTarget(mpDevice->GetBackBuffer(), { 0 });
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateTexture2D - CommonDepthStencilBuffer");
+	mpDevice->Submit(mCommandList);
+	mCommandList.Reset();
 
-				ASSERT(false);
+	if (mpUIBackend == nullptr)
+	{
+		return;
+	}
 
-				return;
-			}
+	mpUIBackend->NewFrame();
+}
 
-			D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc;
-			ZeroMemory(&depthStencilViewDesc, sizeof(depthStencilViewDesc));
+void Renderer::EndUIFrame() const
+{
+	if (mpUIBackend == nullptr)
+	{
+		return;
+	}
 
-			depthStencilViewDesc.Format = depthStencilBufferDesc.Format;
-			depthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+	mpUIBackend->Render();
+}
 
-			hr = mpDevice->CreateDepthStencilView(pDepthStencilBuffer, &depthStencilViewDesc, &mpCommonDepthStencilViewGPU);
+void Renderer::OnResize(const int width, const int height)
+{
+	ASSERT(width > 0);
+	ASSERT(height > 0);
+	ASSERT(mpDevice != nullptr);
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateDepthStencilView");
+	// 크기가 바뀐 임시 타겟은 다시 만들어야 함
+	mTransientTexturePool.Clear();
 
-				ASSERT(false);
+	// backbuffer
+	if (!mpDevice->TryResizeBackBuffer(width, height))
+	{
+		ASSERT(false);
 
-				return;
-			}
-		}
-		SafeRelease(pDepthStencilBuffer);
+		return;
 	}
 
-	mViewport.TopLeftX = 0.f;
-	mViewport.TopLeftY = 0.f;
-	mViewport.Width = static_cast<FLOAT>(width);
-	mViewport.Height = static_cast<FLOAT>(height);
-	mViewport.MinDepth = 0.f;
-	mViewport.MaxDepth = 1.f;
+	mMultiSampleCount = mpDevice->GetSupportedSampleCount(RHI::EFormat::R16G16B16A16_FLOAT, 4);
+
+	mViewport.topLeftX = 0.f;
+	mViewport.topLeftY = 0.f;
+	mViewport.width = static_cast<float>(width);
+	mViewport.height = static_cast<float>(height);
+	mViewport.minDepth = 0.f;
+	mViewport.maxDepth = 1.f;
 }
 
 void Renderer::UpdateCBFrame(const Vector3& cameraPos, const Matrix& viewProj)
@@ -843,14 +1255,20 @@ void Renderer::UpdateCBFrame(const Vector3& cameraPos, const Matrix& viewProj)
 		viewProj.Transpose()
 	};
 
-	mpDeviceContext->UpdateSubresource(
-		mpCBFrameGPU,
-		0,
-		nullptr,
-		&cbFrame,
-		0,
-		0
-	);
+	mCommandList.UpdateBuffer(mCBFrame, &cbFrame, sizeof(CBFrame));
+}
+
+void Renderer::UpdateClusterCamera(const Matrix& view, const Matrix& proj, const float nearZ, const float farZ, const bool bOrthographic)
+{
+	mClusterCamera.view = view;
+	mClusterCamera.projScaleX = proj._11;
+	mClusterCamera.projScaleY = proj._22;
+	mClusterCamera.nearZ = nearZ;
+	mClusterCamera.farZ = farZ;
+	mClusterCamera.bOrthographic = bOrthographic;
+
+	// 뷰 행렬의 세 번째 열이 월드 공간의 앞 방향
+	mCameraForward = Vector3(view._13, view._23, view._33);
 }
 
 void Renderer::AddMeshComponentList(const std::string& sceneName)
@@ -897,240 +1315,154 @@ void Renderer::RemoveMeshComponent(const std::string& sceneName, MeshComponent*
 #undef VECTOR_ITER
 }
 
-bool Renderer::TryInitialize(const HWND hWnd)
+void Renderer::Initialize(RHI::Device* const pDevice, IEditorUIBackend* const pUIBackendOrNull, const UINT refreshRate)
 {
-	ASSERT(hWnd != nullptr);
+	ASSERT(pDevice != nullptr);
 	ASSERT(spInstance == nullptr);
 
-	UINT creationFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
-
-#if defined(DEBUG) || defined(_DEBUG)
-	creationFlags |= D3D11_CREATE_DEVICE_DEBUG;
-#endif
-
-	const D3D_FEATURE_LEVEL featureLevels[] = {
-		D3D_FEATURE_LEVEL_11_1,
-		D3D_FEATURE_LEVEL_11_0
-	};
-
-	ID3D11Device* pDevice = nullptr;
-	ID3D11DeviceContext* pDeviceContext = nullptr;
-
-	HRESULT hr = D3D11CreateDevice(
-		nullptr,
-		D3D_DRIVER_TYPE_HARDWARE,
-		nullptr,
-		creationFlags,
-		featureLevels,
-		ARRAYSIZE(featureLevels),
-		D3D11_SDK_VERSION,
-		&pDevice,
-		nullptr,
-		&pDeviceContext
-	);
-
-	if (FAILED(hr))
-	{
-		LOG_SYSTEM_ERROR(hr, "D3D11CreateDevice");
-
-		ASSERT(false);
-
-		return false;
-	}
-
-	// ֻ   ü 
-	IDXGIDevice* pDXGIDevice = nullptr;
-	IDXGIAdapter* pAdapter = nullptr;
-	IDXGIOutput* pOutput = nullptr;
-
-	IDXGISwapChain1* pSwapChain = nullptr;
-	UINT refreshRate = 60;
-	{
-		hr = pDevice->QueryInterface(__uuidof(IDXGIDevice), reinterpret_cast<void**>(&pDXGIDevice));
-
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "QueryInterface - IDXGIDevice");
-
-			ASSERT(false);
-
-			return false;
-		}
+	initializeResourceManagers(*pDevice);
 
-		hr = pDXGIDevice->GetAdapter(&pAdapter);
-
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "GetAdapter - IDXGIAdapter");
-
-			ASSERT(false);
-
-			return false;
-		}
-
-		// ù °  ȹ
-		hr = pAdapter->EnumOutputs(0, &pOutput);
-
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "EnumOutput");
-
-			ASSERT(false);
-
-			return false;
-		}
-
-		DXGI_OUTPUT_DESC outputDesc;
-		hr = pOutput->GetDesc(&outputDesc);
+	spInstance = new Renderer(pDevice, pUIBackendOrNull, refreshRate);
+}
 
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "GetDesc");
+void Renderer::initializeResourceManagers(RHI::Device& device)
+{
+	TextureManager::Initialize(device);
+	ShaderManager::Initialize(device);
+	MeshManager::Initialize(device);
+	MaterialManager::Initialize(device);
+	ModelManager::Initialize();
+}
 
-			ASSERT(false);
+void Renderer::DrawEditorUI()
+{
+	ImGui::PushID("Renderer");
 
-			return false;
-		}
+	ImGui::Checkbox(UTF8_TEXT("수직동기화"), &mbVSync);
 
-		DEVMODEW dm;
-		ZeroMemory(&dm, sizeof(dm));
+	ImGui::Checkbox(UTF8_TEXT("멀티샘플링"), &mbMultiSampling);
 
-		dm.dmSize = sizeof(dm);
-		if (!EnumDisplaySettings(outputDesc.DeviceName, ENUM_CURRENT_SETTINGS, &dm))
-		{
-			ASSERT(false);
+	ImGui::Checkbox(UTF8_TEXT("절두체 컬링"), &mbViewFrustumCulling);
 
-			return false;
-		}
+	ImGui::Checkbox(UTF8_TEXT("와이어프레임(F4)"), &mbWireframeMode);
 
-		refreshRate = dm.dmDisplayFrequency;
+	ImGui::Checkbox(UTF8_TEXT("오브젝트별 조명 목록"), &mbObjectLightLists);
 
-		IDXGIFactory* pBaseFactory = nullptr;
-		hr = pAdapter->GetParent(IID_PPV_ARGS(&pBaseFactory));
+	ImGui::Checkbox(UTF8_TEXT("깊이 프리패스"), &mbDepthPrePass);
 
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "GetParent - IDXGIFactory");
+	ImGui::SliderFloat4(UTF8_TEXT("화면 초기화 색상"), mClearColor, 0.f, 1.f);
 
-			ASSERT(false);
+	ImGui::SeparatorText(UTF8_TEXT("통계"));
+	{
+		const RHI::ResourceStats resourceStats = mpDevice->GetResourceStats();
+
+		ImGui::Text("RHI: %s", mpDevice->GetName());
+		ImGui::Text("Visible: %u / Draw Calls: %u", mVisibleCount, mLastFrameStats.drawCount);
+		ImGui::Text("Indices: %llu", mLastFrameStats.indexCount);
+		ImGui::Text("Commands: %u (Submits: %u)", mLastFrameStats.commandCount, mLastFrameStats.submitCount);
+		ImGui::Text("Binds: %u", mLastFrameStats.bindCount);
+		ImGui::Text("Buffer Updates: %u (%.1f KB)", mLastFrameStats.bufferUpdateCount, mLastFrameStats.uploadBytes / 1024.f);
+		ImGui::Text("Cull: %.3f ms / Record: %.3f ms / Submit: %.3f ms", mCullTimeMs, mRecordTimeMs, mSubmitTimeMs);
+		ImGui::Text("Frame Graph Build: %.3f ms", mGraphTimeMs);
+		ImGui::Text("Draw Lists: %u", mDrawListCount);
+		ImGui::Text("Depth Pre-Pass: %u draws / Record: %.3f ms", mDepthPrePassDrawCount, mDepthPrePassRecordTimeMs);
+		ImGui::Text(
+			"Depth Pre-Pass Vertex Fetch: %.1f KB (Full Layout: %.1f KB)",
+			static_cast<float>(mDepthPrePassVertexBytes) / 1024.f,
+			static_cast<float>(mDepthPrePassFullVertexBytes) / 1024.f
+		);
+		ImGui::Text(
+			"Buffers: %u / Textures: %u / Shaders: %u / States: %u",
+			resourceStats.bufferCount,
+			resourceStats.textureCount,
+			resourceStats.shaderCount,
+			resourceStats.stateCount
+		);
+	}
 
-			return false;
-		}
+	ImGui::SeparatorText(UTF8_TEXT("클러스터 조명"));
+	{
+		const LightClusterer::Stats& clusterStats = mLightClusterer.GetStats();
 
-		IDXGIFactory2* pDXGIFactory = nullptr;
-		hr = pBaseFactory->QueryInterface(IID_PPV_ARGS(&pDXGIFactory));
+		ImGui::Text(
+			"Clusters: %d x %d x %d",
+			LightClusterer::CLUSTER_COUNT_X,
+			LightClusterer::CLUSTER_COUNT_Y,
+			LightClusterer::CLUSTER_COUNT_Z
+		);
+		ImGui::Text("Lights: %u (Visible: %u)", clusterStats.lightCount, clusterStats.visibleLightCount);
+		ImGui::Text("Light Indices: %u (Max / Cluster: %u)", clusterStats.indexCount, clusterStats.maxLightsPerCluster);
+		ImGui::Text("Overflow: %u", clusterStats.overflowCount);
+		ImGui::Text("Binning: %.3f ms", mLightBinningTimeMs);
 
-		if (FAILED(hr))
+		if (ImGui::Button(UTF8_TEXT("벤치마크(빛 4096개)")))
 		{
-			LOG_SYSTEM_ERROR(hr, "QueryInterface - IDXGIFactory2");
-
-			ASSERT(false);
-
-			return false;
+			RunLightBinningBenchmark(4096);
 		}
 
-		DXGI_SWAP_CHAIN_DESC1 sd;
-		ZeroMemory(&sd, sizeof(sd));
-
-		sd.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-		sd.Stereo = false;
-		sd.SampleDesc.Count = 1;
-		sd.SampleDesc.Quality = 0;
-		sd.BufferCount = 2;
-		sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-		sd.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
-		sd.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
-
-		DXGI_SWAP_CHAIN_FULLSCREEN_DESC scfd;
-		ZeroMemory(&scfd, sizeof(scfd));
-
-		scfd.Windowed = true;
-
-		hr = pDXGIFactory->CreateSwapChainForHwnd(
-			pDevice,
-			hWnd,
-			&sd,
-			&scfd,
-			nullptr,
-			&pSwapChain
-		);
-
-		if (FAILED(hr))
+		for (const BenchmarkResult& result : mLightBinningBenchmarkResults)
 		{
-			LOG_SYSTEM_ERROR(hr, "CreateSwapChainForHwnd");
-
-			ASSERT(false);
-
-			return false;
+			ImGui::Text("Threads %u: %.3f ms", result.threadCount, result.timeMs);
 		}
-
-		SafeRelease(pDXGIFactory);
-		SafeRelease(pBaseFactory);
 	}
-	SafeRelease(pOutput);
-	SafeRelease(pAdapter);
-	SafeRelease(pDXGIDevice);
-
-	TextureManager::Initialize(*pDevice);
-	ShaderManager::Initialize(*pDevice);
-	MeshManager::Initialize(*pDevice);
-	MaterialManager::Initialize(*pDevice);
-	ModelManager::Initialize();
-
-	spInstance = new Renderer(
-		pDevice,
-		pDeviceContext,
-		pSwapChain,
-		refreshRate
-	);
-
-	// ui
-	IMGUI_CHECKVERSION();
-	ImGuiContext* pImGuiContext = ImGui::CreateContext();
 
-	if (pImGuiContext == nullptr)
+	ImGui::SeparatorText(UTF8_TEXT("오브젝트별 조명"));
 	{
-		LOG_SYSTEM_ERROR(E_FAIL, "ImGui - CreateContext");
-
-		ASSERT(false);
+		ImGui::Text("Light Cull: %.3f ms (Binning: %.3f ms / Object Lists: %.3f ms)", mLightBinningTimeMs + mLightAssignTimeMs, mLightBinningTimeMs, mLightAssignTimeMs);
+		ImGui::Text("Object Lights: %u (Max / Object: %u, Dropped: %u)", mObjectLightCount, mMaxObjectLightCount, mDroppedObjectLightCount);
+		ImGui::Text("Lights / Draw: %.2f", mVisibleCount > 0 ? static_cast<float>(mObjectLightCount) / mVisibleCount : 0.f);
+		ImGui::Text("Shading Cost: %llu light x triangles", mShadingCost);
 	}
 
-	ImGuiIO& io = ImGui::GetIO();
-	io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-	io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
-	io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-	io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\malgun.ttf", 18.f, nullptr, io.Fonts->GetGlyphRangesKorean());
-
-	if (!ImGui_ImplWin32_Init(hWnd))
+	ImGui::SeparatorText(UTF8_TEXT("파이프라인 상태"));
 	{
-		LOG_SYSTEM_ERROR(E_FAIL, "ImGui - Win32_Init");
-
-		ASSERT(false);
+		const PipelineStateCache::Stats& pipelineStats = mPipelineStateCache.GetStats();
+
+		ImGui::Text(
+			"States: RS %u / SS %u / BS %u / DS %u",
+			pipelineStats.rasterizerCount,
+			pipelineStats.samplerCount,
+			pipelineStats.blendCount,
+			pipelineStats.depthStencilCount
+		);
+		ImGui::Text("Pipelines: %u", pipelineStats.pipelineCount);
+		ImGui::Text("State Requests: %u (Deduplicated: %u)", pipelineStats.stateRequestCount, pipelineStats.stateHitCount);
+		ImGui::Text("Pipeline Requests: %u (Deduplicated: %u)", pipelineStats.pipelineRequestCount, pipelineStats.pipelineHitCount);
 	}
 
-	if (!ImGui_ImplDX11_Init(pDevice, pDeviceContext))
+	ImGui::SeparatorText(UTF8_TEXT("프레임 그래프"));
 	{
-		LOG_SYSTEM_ERROR(E_FAIL, "ImGui - DX11_Init");
-
-		ASSERT(false);
-	}
+		const FrameGraph::CompileStats& compileStats = mFrameGraph.GetCompileStats();
 
-	return true;
-}
-
-void Renderer::DrawEditorUI()
-{
-	ImGui::PushID("Renderer");
-
-	ImGui::Checkbox(UTF8_TEXT("ȭ"), &mbVSync);
+		for (uint32_t i = 0; i < mFrameGraph.GetPassCount(); ++i)
+		{
+			ImGui::Text("%s%s", mFrameGraph.GetPassName(i), mFrameGraph.IsPassCulled(i) ? " (culled)" : "");
+		}
 
-	ImGui::Checkbox(UTF8_TEXT("Ƽø"), &mbMultiSampling);
+		ImGui::Text("Passes: %u (Culled: %u)", compileStats.passCount, compileStats.culledPassCount);
+		ImGui::Text("Transient Targets: %u -> Textures: %u", compileStats.transientCount, compileStats.physicalCount);
+		ImGui::Text(
+			"Target Memory: %.2f MB (%.2f MB without aliasing)",
+			compileStats.allocatedBytes / (1024.f * 1024.f),
+			compileStats.requestedBytes / (1024.f * 1024.f)
+		);
+		ImGui::Text("Pooled Textures: %u", mTransientTexturePool.GetTextureCount());
+	}
 
-	ImGui::Checkbox(UTF8_TEXT("ü ø"), &mbViewFrustumCulling);
+	ImGui::SeparatorText(UTF8_TEXT("병렬 기록"));
+	{
+		ImGui::SliderInt(UTF8_TEXT("작업 스레드 수"), &mThreadCount, 1, mMaxThreadCount);
 
-	ImGui::Checkbox(UTF8_TEXT("̾(F4)"), &mbWireframeMode);
+		if (ImGui::Button(UTF8_TEXT("벤치마크(50000 그리기)")))
+		{
+			RunRecordBenchmark(50000);
+		}
 
-	ImGui::SliderFloat4(UTF8_TEXT("ȭ ʱȭ "), mClearColor, 0.f, 1.f);
+		for (const BenchmarkResult& result : mRecordBenchmarkResults)
+		{
+			ImGui::Text("Threads %u: %.3f ms", result.threadCount, result.timeMs);
+		}
+	}
 
 	ImGui::PopID();
 }
@@ -3,17 +3,20 @@
 #include <vector>
 #include <unordered_map>
 
-#include <d3d11.h>
-#include <dxgi1_2.h>
-
 #include "Core/Assert.h"
 #include "Core/MathHelper.h"
 #include "PipelineStateType.h"
 #include "UI/IEditorUIDrawable.h"
 #include "Light.h"
+#include "LightClusterer.h"
+#include "FrameGraph.h"
+#include "PipelineStateCache.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/RHICommandList.h"
+#include "Resources/Mesh.h"
 
-class Mesh;
 class Material;
+class IEditorUIBackend;
 class CameraComponent;
 class MeshComponent;
 class ModelComponent;
@@ -27,10 +30,23 @@ public:
 		CB_FRAME_SLOT = 0,
 		CB_WORLD_MATRIX_SLOT = 1,
 		CB_MATERIAL_SLOT = 2,
-		CB_LIGHT_SLOT = 3
+		CB_CLUSTER_SLOT = 3
+	};
+
+	enum ShaderResourceSlot
+	{
+		SR_LIGHT_SLOT = 1,
+		SR_CLUSTER_RANGE_SLOT = 2,
+		SR_LIGHT_INDEX_SLOT = 3
+	};
+
+	enum
+	{
+		// 셰이더의 objectLightIndices 크기와 같아야 함
+		MAX_OBJECT_LIGHTS = 8
 	};
 
-	// ü ؼ ʱȭ  
+	// 구조체에 대해서 초기화 경고 끄기
 #pragma warning(push)
 #pragma warning(disable : 26495)
 	struct RenderCommand
@@ -39,20 +55,35 @@ public:
 		Material* pMaterial;
 
 		Matrix worldMatrix;
+		BoundingSphere boundingSphereWorld;
+
+		// 렌더러가 채움, 중요도 내림차순
+		uint32_t lightCount;
+		uint32_t lightIndices[MAX_OBJECT_LIGHTS];
+
+		// 렌더러가 채움, 조명에 맞는 픽셀 셰이더 변형 비트
+		uint32_t shaderFeatures;
+	};
+
+	struct BenchmarkResult
+	{
+		uint32_t threadCount;
+		float timeMs;
 	};
 #pragma warning(pop)
 
 public:
-	void BeginFrame() const;
-	void EndFrame() const;
+	void BeginFrame();
+	void EndFrame();
 
 	void RenderScene(const std::string& sceneName);
 
-	void BeginUIFrame() const;
+	void BeginUIFrame();
 	void EndUIFrame() const;
 
 	void OnResize(const int width, const int height);
 	void UpdateCBFrame(const Vector3& cameraPos, const Matrix& viewProj);
+	void UpdateClusterCamera(const Matrix& view, const Matrix& proj, const float nearZ, const float farZ, const bool bOrthographic);
 
 	void AddMeshComponentList(const std::string& sceneName);
 	void RemoveMeshComponentList(const std::string& sceneName);
@@ -62,6 +93,22 @@ public:
 
 	virtual void DrawEditorUI() override;
 
+	// drawCount개의 그리기 명령을 스레드 수를 바꿔가며 기록만 하고 시간 측정
+	void RunRecordBenchmark(const uint32_t drawCount);
+
+	inline const std::vector<BenchmarkResult>& GetRecordBenchmarkResults() const
+	{
+		return mRecordBenchmarkResults;
+	}
+
+	// 현재 카메라 앞에 lightCount개의 빛을 흩뿌리고 스레드 수별 분류 시간 측정
+	void RunLightBinningBenchmark(const uint32_t lightCount);
+
+	inline const std::vector<BenchmarkResult>& GetLightBinningBenchmarkResults() const
+	{
+		return mLightBinningBenchmarkResults;
+	}
+
 	Vector3 Unproject(const Vector3 v) const;
 
 	UINT GetRefreshRate() const
@@ -69,24 +116,62 @@ public:
 		return mRefreshRate;
 	}
 
-	inline ID3D11RasterizerState* GetRasterizerState(const ERasterizerType type)
+	// 기록 스레드에서 동시에 호출되므로 조회만 함
+	inline PipelineStateCache::StateID GetRasterizerStateID(const ERasterizerType type) const
+	{
+		return mRasterizerStateIDs[GetRasterizerTypeInt(type)];
+	}
+
+	inline PipelineStateCache::StateID GetSamplerStateID(const ESamplerType type) const
+	{
+		return mSamplerStateIDs[GetSamplerTypeInt(type)];
+	}
+
+	inline PipelineStateCache::StateID GetBlendStateID(const EBlendStateType type) const
+	{
+		return mBlendStateIDs[GetBlendTypeInt(type)];
+	}
+
+	inline PipelineStateCache::StateID GetDepthStencilStateID(const EDepthStencilType type) const
+	{
+		return mDepthStencilStateIDs[GetDepthStencilTypeInt(type)];
+	}
+
+	inline RHI::RasterizerStateHandle GetRasterizerState(const ERasterizerType type) const
+	{
+		return mPipelineStateCache.GetRasterizerState(GetRasterizerStateID(type));
+	}
+
+	inline RHI::SamplerStateHandle GetSamplerState(const ESamplerType type) const
+	{
+		return mPipelineStateCache.GetSamplerState(GetSamplerStateID(type));
+	}
+
+	inline RHI::BlendStateHandle GetBlendState(const EBlendStateType type) const
+	{
+		return mPipelineStateCache.GetBlendState(GetBlendStateID(type));
+	}
+
+	inline RHI::DepthStencilStateHandle GetDepthStencilState(const EDepthStencilType type) const
 	{
-		return mRasterizerStateMap[type];
+		return mPipelineStateCache.GetDepthStencilState(GetDepthStencilStateID(type));
 	}
 
-	inline ID3D11SamplerState* GetSamplerState(const ESamplerType type)
+	// 머터리얼이 자기 상태 조합을 등록할 때 사용, 메인 스레드 전용
+	inline PipelineStateCache& GetPipelineStateCache()
 	{
-		return mSamplerStateMap[type];
+		return mPipelineStateCache;
 	}
 
-	inline ID3D11BlendState* GetBlendState(const EBlendStateType type)
+	inline RHI::Device& GetDevice() const
 	{
-		return mBlendStateMap[type];
+		return *mpDevice;
 	}
 
-	inline ID3D11DepthStencilState* GetDepthStencilState(const EDepthStencilType type)
+	// 마지막으로 Present된 프레임의 통계
+	inline const RHI::FrameStats& GetLastFrameStats() const
 	{
-		return mDepthStencilStateMap[type];
+		return mLastFrameStats;
 	}
 
 	inline void EnqueueRenderCommand(const RenderCommand& command)
@@ -97,7 +182,7 @@ public:
 		mRenderCommandQueue.push_back(command);
 	}
 
-	inline const D3D11_VIEWPORT& GetViewport() const
+	inline const RHI::Viewport& GetViewport() const
 	{
 		return mViewport;
 	}
@@ -129,14 +214,12 @@ public:
 		const Matrix debugSphereScale = Matrix::CreateScale(radius);
 
 		mDebugSphereRenderCommand.worldMatrix = debugSphereScale * debugSphereTranslation;
+		mDebugSphereRenderCommand.boundingSphereWorld = BoundingSphere(mCenter, radius);
 	}
 
 	inline void EnqueueLight(const Light& light)
 	{
-		if (mLightCount < MAX_LIGHTS)
-		{
-			mLightPool[mLightCount++] = light;
-		}
+		mLights.push_back(light);
 	}
 
 	inline void SwitchWireframeMode()
@@ -145,7 +228,10 @@ public:
 	}
 
 	// static
-	static bool TryInitialize(const HWND hWnd);
+	// 디바이스와 UI 백엔드는 호출하는 쪽에서 골라 넘기고 렌더러가 소유함
+	// UI 백엔드가 nullptr이면 에디터 UI 없이 그림(NullDevice로 테스트, 배치 처리용)
+	// JobSystem이 먼저 초기화되어 있으면 병렬로 기록함
+	static void Initialize(RHI::Device* const pDevice, IEditorUIBackend* const pUIBackendOrNull, const UINT refreshRate);
 
 	inline static Renderer& GetInstance()
 	{
@@ -162,27 +248,34 @@ public:
 private:
 	static Renderer* spInstance;
 
-	ID3D11Device* mpDevice;
-	ID3D11DeviceContext* mpDeviceContext;
-	IDXGISwapChain1* mpSwapChain;
+	RHI::Device* mpDevice;
+	RHI::CommandList mCommandList;
+
+	// 스레드마다 하나씩 기록, 순서대로 제출
+	std::vector<RHI::CommandList> mDrawCommandLists;
+	int mThreadCount;
+	int mMaxThreadCount;
 
-	ID3D11RenderTargetView* mpBackBufferViewGPU;
+	// nullptr이면 헤드리스
+	IEditorUIBackend* mpUIBackend;
 
-	ID3D11RenderTargetView* mpMultiSampleRenderTargetViewGPU;
-	ID3D11DepthStencilView* mpMultiSampleDepthStencilViewGPU;
+	// 렌더 타겟은 프레임 그래프가 매 프레임 풀에서 할당
+	FrameGraph mFrameGraph;
+	TransientTexturePool mTransientTexturePool;
 
-	ID3D11RenderTargetView* mpHDRRenderTargetViewGPU;
-	ID3D11ShaderResourceView* mpHDRResourceViewGPU;
+	RHI::TextureHandle mSceneColorTarget;
+	RHI::TextureHandle mSceneDepthTarget;
 
-	ID3D11RenderTargetView* mpSDRRenderTargetViewGPU;
-	ID3D11DepthStencilView* mpCommonDepthStencilViewGPU;
+	uint32_t mMultiSampleCount;
 
-	D3D11_VIEWPORT mViewport;
+	RHI::Viewport mViewport;
 
-	std::unordered_map<ERasterizerType, ID3D11RasterizerState*> mRasterizerStateMap;
-	std::unordered_map<ESamplerType, ID3D11SamplerState*> mSamplerStateMap;
-	std::unordered_map<EBlendStateType, ID3D11BlendState*> mBlendStateMap;
-	std::unordered_map<EDepthStencilType, ID3D11DepthStencilState*> mDepthStencilStateMap;
+	// 기본 상태는 열거형으로 바로 찾고 그 밖의 조합은 캐시가 필요할 때 만듦
+	PipelineStateCache mPipelineStateCache;
+	PipelineStateCache::StateID mRasterizerStateIDs[GetRasterizerTypeCount()];
+	PipelineStateCache::StateID mSamplerStateIDs[GetSamplerTypeCount()];
+	PipelineStateCache::StateID mBlendStateIDs[GetBlendTypeCount()];
+	PipelineStateCache::StateID mDepthStencilStateIDs[GetDepthStencilTypeCount()];
 
 	UINT mRefreshRate;
 
@@ -190,14 +283,27 @@ private:
 	bool mbMultiSampling;
 	bool mbViewFrustumCulling;
 	bool mbWireframeMode;
+	bool mbObjectLightLists;
+
+	// 불투명한 그리기의 깊이를 위치만 읽어서 먼저 채우고 본 패스는 같은 깊이만 칠함
+	bool mbDepthPrePass;
+	bool mbDepthPrePassActive;
 
 	float mClearColor[4];
 
 	std::vector<RenderCommand> mRenderCommandQueue;
+	std::vector<RenderCommand> mDepthPrePassQueue;
+
+	RHI::BufferHandle mCBFrame;
+	RHI::BufferHandle mCBWorldMatrix;
+	RHI::BufferHandle mCBCluster;
 
-	ID3D11Buffer* mpCBFrameGPU;
-	ID3D11Buffer* mpCBWorldMatrixGPU;
-	ID3D11Buffer* mpCBLightGPU;
+	// 구조적 버퍼, 부족하면 두 배로 다시 만듦
+	RHI::BufferHandle mLightBuffer;
+	RHI::BufferHandle mClusterRangeBuffer;
+	RHI::BufferHandle mLightIndexBuffer;
+	uint32_t mLightBufferCapacity;
+	uint32_t mLightIndexBufferCapacity;
 
 	CameraComponent* mpEditorCameraComponent;
 	CameraComponent* mpMainCameraComponent;
@@ -206,19 +312,60 @@ private:
 	RenderCommand mDebugSphereRenderCommand;
 	bool mbOnDebugSphere;
 
-	Light mLightPool[MAX_LIGHTS];
-	int mLightCount;
+	std::vector<Light> mLights;
+
+	LightClusterer mLightClusterer;
+	LightClusterer::Camera mClusterCamera;
+	Vector3 mCameraForward;
+
+	// stats
+	RHI::FrameStats mLastFrameStats;
+	float mCullTimeMs;
+	float mRecordTimeMs;
+	float mGraphTimeMs;
+	float mLightBinningTimeMs;
+	float mLightAssignTimeMs;
+	float mSubmitTimeMs;
+	uint32_t mVisibleCount;
+	uint32_t mDrawListCount;
+	uint32_t mObjectLightCount;
+	uint32_t mMaxObjectLightCount;
+	uint32_t mDroppedObjectLightCount;
+	uint64_t mShadingCost;
+	float mDepthPrePassRecordTimeMs;
+	uint32_t mDepthPrePassDrawCount;
+	uint64_t mDepthPrePassVertexBytes;
+	uint64_t mDepthPrePassFullVertexBytes;
+
+	std::vector<BenchmarkResult> mRecordBenchmarkResults;
+	std::vector<BenchmarkResult> mLightBinningBenchmarkResults;
 
 private:
 	Renderer(
-		ID3D11Device* const pDevice,
-		ID3D11DeviceContext* const pDeviceContext,
-		IDXGISwapChain1* const pSwapChain,
+		RHI::Device* const pDevice,
+		IEditorUIBackend* const pUIBackendOrNull,
 		const UINT refreshRate
 	);
 	~Renderer();
 
-	ID3D11Buffer* createConstantBufferAlloc(const void* const pData, const UINT byteWidth);
+	RHI::BufferHandle createConstantBuffer(const void* const pData, const UINT byteWidth);
+	RHI::BufferHandle createStructuredBuffer(const UINT stride, const UINT elementCount);
+	void reserveStructuredBuffer(RHI::BufferHandle& buffer, uint32_t& capacity, const UINT stride, const uint32_t elementCount);
+
+	void updateLightClusters();
+	void assignObjectLights(RenderCommand* const pCommands, const uint32_t count, const uint32_t threadCount);
+
+	// 기본 상태를 쓰는 불투명 머터리얼만 깊이 프리패스에 넣음
+	bool isDepthPrePassMaterial(const Material& material) const;
+
+	void recordScenePassState(RHI::CommandList& commandList) const;
+	void recordDepthPassState(RHI::CommandList& commandList) const;
+	void recordWorldMatrix(RHI::CommandList& commandList, const RenderCommand& command) const;
+	void recordDraw(RHI::CommandList& commandList, const RenderCommand& command, PipelineStateCache::PipelineID& inOutPipelineID, RHI::TextureHandle& inOutTexture, Mesh::BindState& inOutBindState) const;
+	void recordDepthDraw(RHI::CommandList& commandList, const RenderCommand& command, Mesh::BindState& inOutBindState) const;
+	uint32_t recordDrawsParallel(const RenderCommand* const pCommands, const uint32_t count, const uint32_t threadCount, const bool bDepthOnly);
+
+	static void initializeResourceManagers(RHI::Device& device);
 
 private:
 	Renderer(const Renderer& other) = delete;
@@ -1,13 +1,17 @@
 #pragma once
 
-#include <d3d11.h>
+#include <vector>
 
 #include "Core/MathHelper.h"
 #include "Core/Assert.h"
+#include "RHI/RHITypes.h"
 
 #define VERTEX_LIST \
 	VERTEX_ENTRY(POS_UV, PosUV) \
 	VERTEX_ENTRY(POS_NORMAL_UV, PosNormalUV) \
+	VERTEX_ENTRY(POS_NORMAL_UV_QUANTIZED, PosNormalUVQuantized) \
+	VERTEX_ENTRY(POS, Pos) \
+	VERTEX_ENTRY(POS_NORMAL_UV_SPLIT, NormalUV) \
 
 namespace Vertex
 {
@@ -24,6 +28,35 @@ namespace Vertex
 		Vector2 uv;
 	};
 
+	// 위치는 메쉬 범위 안의 UNORM16(w는 비움), 법선은 8면체 SNORM16, UV는 half
+	// 정점 셰이더가 CBWorldMatrix의 positionScale, positionOffset으로 위치를 되돌림
+	struct PosNormalUVQuantized
+	{
+		uint16_t pos[4];
+		int16_t normal[2];
+		uint16_t uv[2];
+	};
+	static_assert(sizeof(PosNormalUVQuantized) * 2 == sizeof(PosNormalUV));
+
+	// 위치 스트림을 따로 둔 메쉬는 깊이만 쓰는 패스에서 위치만 읽음
+	// POS_NORMAL_UV_SPLIT은 슬롯 0에 Pos, 슬롯 1에 NormalUV
+	struct Pos
+	{
+		Vector3 pos;
+	};
+
+	struct NormalUV
+	{
+		Vector3 normal;
+		Vector2 uv;
+	};
+
+	enum
+	{
+		POSITION_STREAM_SLOT = 0,
+		ATTRIBUTE_STREAM_SLOT = 1
+	};
+
 	enum class EType : uint8_t
 	{
 #define VERTEX_ENTRY(type, name) type,
@@ -55,7 +88,7 @@ namespace Vertex
 		return names[GetTypeInt(type)];
 	}
 
-	constexpr std::vector<D3D11_INPUT_ELEMENT_DESC> GetInputLayoutDescs(const EType type)
+	constexpr std::vector<RHI::InputElementDesc> GetInputLayoutDescs(const EType type)
 	{
 		switch (type)
 		{
@@ -63,8 +96,8 @@ namespace Vertex
 			{
 				return
 				{
-					{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-					{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof(PosUV, uv), D3D11_INPUT_PER_VERTEX_DATA, 0},
+					{ "POSITION", 0, RHI::EFormat::R32G32B32_FLOAT, 0, 0 },
+					{ "TEXCOORD", 0, RHI::EFormat::R32G32_FLOAT, 0, offsetof(PosUV, uv) },
 				};
 			}
 			break;
@@ -73,9 +106,40 @@ namespace Vertex
 			{
 				return
 				{
-					{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-					{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(PosNormalUV, normal), D3D11_INPUT_PER_VERTEX_DATA, 0},
-					{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof(PosNormalUV, uv), D3D11_INPUT_PER_VERTEX_DATA, 0},
+					{ "POSITION", 0, RHI::EFormat::R32G32B32_FLOAT, 0, 0 },
+					{ "NORMAL", 0, RHI::EFormat::R32G32B32_FLOAT, 0, offsetof(PosNormalUV, normal) },
+					{ "TEXCOORD", 0, RHI::EFormat::R32G32_FLOAT, 0, offsetof(PosNormalUV, uv) },
+				};
+			}
+			break;
+
+		case EType::POS_NORMAL_UV_QUANTIZED:
+			{
+				return
+				{
+					{ "POSITION", 0, RHI::EFormat::R16G16B16A16_UNORM, 0, 0 },
+					{ "NORMAL", 0, RHI::EFormat::R16G16_SNORM, 0, offsetof(PosNormalUVQuantized, normal) },
+					{ "TEXCOORD", 0, RHI::EFormat::R16G16_FLOAT, 0, offsetof(PosNormalUVQuantized, uv) },
+				};
+			}
+			break;
+
+		case EType::POS:
+			{
+				return
+				{
+					{ "POSITION", 0, RHI::EFormat::R32G32B32_FLOAT, POSITION_STREAM_SLOT, 0 },
+				};
+			}
+			break;
+
+		case EType::POS_NORMAL_UV_SPLIT:
+			{
+				return
+				{
+					{ "POSITION", 0, RHI::EFormat::R32G32B32_FLOAT, POSITION_STREAM_SLOT, 0 },
+					{ "NORMAL", 0, RHI::EFormat::R32G32B32_FLOAT, ATTRIBUTE_STREAM_SLOT, offsetof(NormalUV, normal) },
+					{ "TEXCOORD", 0, RHI::EFormat::R32G32_FLOAT, ATTRIBUTE_STREAM_SLOT, offsetof(NormalUV, uv) },
 				};
 			}
 			break;
@@ -0,0 +1,769 @@
+#include "BlockCompression.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+#include "Core/Assert.h"
+
+enum
+{
+	POWER_ITERATION_COUNT = 8,
+
+	BC1_PALETTE_SIZE = 4,
+	BC4_PALETTE_SIZE = 8,
+	BC7_PALETTE_SIZE = 16,
+
+	BC7_MODE6_ANCHOR_INDEX_BITS = 3,
+	BC7_MODE6_INDEX_BITS = 4
+};
+
+// 끝점 1쪽으로의 가중치, 인덱스 순서대로
+static const float BC1_WEIGHTS[BC1_PALETTE_SIZE] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+static const uint32_t BC7_WEIGHTS[BC7_PALETTE_SIZE] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+// 채널별로 나눠 담아서 픽셀 4개를 한 레지스터로 읽음
+struct alignas(16) BlockChannels
+{
+	float values[4][BLOCK_PIXEL_COUNT];
+};
+#pragma warning(pop)
+
+static void LoadBlockChannels(const uint8_t* const pPixels, BlockChannels& outBlock)
+{
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			outBlock.values[c][i] = static_cast<float>(pPixels[i * 4 + c]);
+		}
+	}
+}
+
+static float ClampFloat(const float value, const float minValue, const float maxValue)
+{
+	return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+}
+
+// 평균을 지나는 주성분 축 위에서 가장 먼 두 점을 끝점으로 씀
+static void ComputeEndpoints(const BlockChannels& block, const uint32_t channelCount, const bool bInset, float outEndpoint0[4], float outEndpoint1[4])
+{
+	float mean[4] = { 0.f, };
+	float minValues[4];
+	float maxValues[4];
+
+	for (uint32_t c = 0; c < channelCount; ++c)
+	{
+		minValues[c] = FLT_MAX;
+		maxValues[c] = -FLT_MAX;
+
+		for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+		{
+			const float value = block.values[c][i];
+
+			mean[c] += value;
+			minValues[c] = value < minValues[c] ? value : minValues[c];
+			maxValues[c] = value > maxValues[c] ? value : maxValues[c];
+		}
+
+		mean[c] /= static_cast<float>(BLOCK_PIXEL_COUNT);
+	}
+
+	float covariance[4][4] = { { 0.f, }, };
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		for (uint32_t row = 0; row < channelCount; ++row)
+		{
+			const float rowDiff = block.values[row][i] - mean[row];
+
+			for (uint32_t col = row; col < channelCount; ++col)
+			{
+				covariance[row][col] += rowDiff * (block.values[col][i] - mean[col]);
+			}
+		}
+	}
+
+	for (uint32_t row = 0; row < channelCount; ++row)
+	{
+		for (uint32_t col = 0; col < row; ++col)
+		{
+			covariance[row][col] = covariance[col][row];
+		}
+	}
+
+	// 거듭제곱법, 시작 방향은 채널 범위
+	float axis[4] = { 0.f, };
+	float axisLengthSquared = 0.f;
+
+	for (uint32_t c = 0; c < channelCount; ++c)
+	{
+		axis[c] = maxValues[c] - minValues[c];
+		axisLengthSquared += axis[c] * axis[c];
+	}
+
+	// 단색 블록
+	if (axisLengthSquared == 0.f)
+	{
+		for (uint32_t c = 0; c < channelCount; ++c)
+		{
+			outEndpoint0[c] = mean[c];
+			outEndpoint1[c] = mean[c];
+		}
+
+		return;
+	}
+
+	for (uint32_t iteration = 0; iteration < POWER_ITERATION_COUNT; ++iteration)
+	{
+		float nextAxis[4] = { 0.f, };
+		float length = 0.f;
+
+		for (uint32_t row = 0; row < channelCount; ++row)
+		{
+			for (uint32_t col = 0; col < channelCount; ++col)
+			{
+				nextAxis[row] += covariance[row][col] * axis[col];
+			}
+
+			length += nextAxis[row] * nextAxis[row];
+		}
+
+		if (length < FLT_EPSILON)
+		{
+			break;
+		}
+
+		const float invLength = 1.f / sqrtf(length);
+
+		for (uint32_t c = 0; c < channelCount; ++c)
+		{
+			axis[c] = nextAxis[c] * invLength;
+		}
+	}
+
+	float minT = FLT_MAX;
+	float maxT = -FLT_MAX;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		float t = 0.f;
+
+		for (uint32_t c = 0; c < channelCount; ++c)
+		{
+			t += (block.values[c][i] - mean[c]) * axis[c];
+		}
+
+		minT = t < minT ? t : minT;
+		maxT = t > maxT ? t : maxT;
+	}
+
+	// 양자화 오차를 줄이려고 범위의 1/16만큼 안쪽으로
+	if (bInset)
+	{
+		const float inset = (maxT - minT) / 16.f;
+
+		minT += inset;
+		maxT -= inset;
+	}
+
+	for (uint32_t c = 0; c < channelCount; ++c)
+	{
+		outEndpoint0[c] = ClampFloat(mean[c] + axis[c] * minT, 0.f, 255.f);
+		outEndpoint1[c] = ClampFloat(mean[c] + axis[c] * maxT, 0.f, 255.f);
+	}
+}
+
+// 픽셀마다 가장 가까운 팔레트 색을 고르고 제곱 오차 합을 반환
+static float FitIndices(
+	const BlockChannels& block,
+	const float (*const pPalette)[4],
+	const uint32_t paletteCount,
+	const uint32_t channelCount,
+	uint8_t outIndices[BLOCK_PIXEL_COUNT]
+)
+{
+	float totalError = 0.f;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; i += 4)
+	{
+		__m128 bestError = _mm_set1_ps(FLT_MAX);
+		__m128i bestIndex = _mm_setzero_si128();
+
+		for (uint32_t p = 0; p < paletteCount; ++p)
+		{
+			__m128 error = _mm_setzero_ps();
+
+			for (uint32_t c = 0; c < channelCount; ++c)
+			{
+				const __m128 diff = _mm_sub_ps(_mm_load_ps(&block.values[c][i]), _mm_set1_ps(pPalette[p][c]));
+
+				error = _mm_add_ps(error, _mm_mul_ps(diff, diff));
+			}
+
+			const __m128i mask = _mm_castps_si128(_mm_cmplt_ps(error, bestError));
+
+			bestError = _mm_min_ps(error, bestError);
+			bestIndex = _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi32(static_cast<int>(p))), _mm_andnot_si128(mask, bestIndex));
+		}
+
+		alignas(16) float errors[4];
+		alignas(16) int32_t indices[4];
+
+		_mm_store_ps(errors, bestError);
+		_mm_store_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			outIndices[i + lane] = static_cast<uint8_t>(indices[lane]);
+			totalError += errors[lane];
+		}
+	}
+
+	return totalError;
+}
+
+// 인덱스를 고정하고 끝점을 최소제곱으로 다시 구함
+static bool TrySolveEndpoints(
+	const BlockChannels& block,
+	const uint32_t channelCount,
+	const uint8_t indices[BLOCK_PIXEL_COUNT],
+	const float* const pWeights,
+	float outEndpoint0[4],
+	float outEndpoint1[4]
+)
+{
+	float a = 0.f;
+	float b = 0.f;
+	float c = 0.f;
+
+	float x0[4] = { 0.f, };
+	float x1[4] = { 0.f, };
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		const float w1 = pWeights[indices[i]];
+		const float w0 = 1.f - w1;
+
+		a += w0 * w0;
+		b += w0 * w1;
+		c += w1 * w1;
+
+		for (uint32_t channel = 0; channel < channelCount; ++channel)
+		{
+			x0[channel] += w0 * block.values[channel][i];
+			x1[channel] += w1 * block.values[channel][i];
+		}
+	}
+
+	const float determinant = a * c - b * b;
+
+	if (fabsf(determinant) < FLT_EPSILON)
+	{
+		return false;
+	}
+
+	const float invDeterminant = 1.f / determinant;
+
+	for (uint32_t channel = 0; channel < channelCount; ++channel)
+	{
+		outEndpoint0[channel] = ClampFloat((c * x0[channel] - b * x1[channel]) * invDeterminant, 0.f, 255.f);
+		outEndpoint1[channel] = ClampFloat((a * x1[channel] - b * x0[channel]) * invDeterminant, 0.f, 255.f);
+	}
+
+	return true;
+}
+
+static void WriteBits(uint8_t* const pBlock, uint32_t& bitPosition, const uint32_t value, const uint32_t bitCount)
+{
+	for (uint32_t i = 0; i < bitCount; ++i, ++bitPosition)
+	{
+		if ((value >> i) & 1)
+		{
+			pBlock[bitPosition >> 3] |= static_cast<uint8_t>(1 << (bitPosition & 7));
+		}
+	}
+}
+
+static uint32_t ReadBits(const uint8_t* const pBlock, uint32_t& bitPosition, const uint32_t bitCount)
+{
+	uint32_t value = 0;
+
+	for (uint32_t i = 0; i < bitCount; ++i, ++bitPosition)
+	{
+		value |= static_cast<uint32_t>((pBlock[bitPosition >> 3] >> (bitPosition & 7)) & 1) << i;
+	}
+
+	return value;
+}
+
+// BC1
+static uint16_t PackRGB565(const float color[4])
+{
+	const uint32_t r = static_cast<uint32_t>(ClampFloat(color[0], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+	const uint32_t g = static_cast<uint32_t>(ClampFloat(color[1], 0.f, 255.f) * 63.f / 255.f + 0.5f);
+	const uint32_t b = static_cast<uint32_t>(ClampFloat(color[2], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(const uint16_t packed, float outColor[4])
+{
+	const uint32_t r = (packed >> 11) & 0x1F;
+	const uint32_t g = (packed >> 5) & 0x3F;
+	const uint32_t b = packed & 0x1F;
+
+	outColor[0] = static_cast<float>((r << 3) | (r >> 2));
+	outColor[1] = static_cast<float>((g << 2) | (g >> 4));
+	outColor[2] = static_cast<float>((b << 3) | (b >> 2));
+	outColor[3] = 255.f;
+}
+
+// 4색 모드가 되도록 color0 > color1로 정렬
+static float FitBC1(
+	const BlockChannels& block,
+	const float endpoint0[4],
+	const float endpoint1[4],
+	uint16_t& outColor0,
+	uint16_t& outColor1,
+	uint8_t outIndices[BLOCK_PIXEL_COUNT]
+)
+{
+	uint16_t color0 = PackRGB565(endpoint0);
+	uint16_t color1 = PackRGB565(endpoint1);
+
+	if (color0 < color1)
+	{
+		const uint16_t temp = color0;
+		color0 = color1;
+		color1 = temp;
+	}
+
+	float palette[BC1_PALETTE_SIZE][4];
+	UnpackRGB565(color0, palette[0]);
+	UnpackRGB565(color1, palette[1]);
+
+	for (uint32_t c = 0; c < 3; ++c)
+	{
+		palette[2][c] = (2.f * palette[0][c] + palette[1][c]) / 3.f;
+		palette[3][c] = (palette[0][c] + 2.f * palette[1][c]) / 3.f;
+	}
+
+	outColor0 = color0;
+	outColor1 = color1;
+
+	// 같으면 3색 모드가 되므로 0번만 씀
+	return FitIndices(block, palette, color0 == color1 ? 1 : BC1_PALETTE_SIZE, 3, outIndices);
+}
+
+static void EncodeBC1Color(const BlockChannels& block, uint8_t* const pOutBlock)
+{
+	float endpoint0[4];
+	float endpoint1[4];
+	ComputeEndpoints(block, 3, true, endpoint0, endpoint1);
+
+	uint16_t color0;
+	uint16_t color1;
+	uint8_t indices[BLOCK_PIXEL_COUNT];
+
+	const float error = FitBC1(block, endpoint0, endpoint1, color0, color1, indices);
+
+	float refined0[4];
+	float refined1[4];
+
+	if (error > 0.f && TrySolveEndpoints(block, 3, indices, BC1_WEIGHTS, refined0, refined1))
+	{
+		uint16_t refinedColor0;
+		uint16_t refinedColor1;
+		uint8_t refinedIndices[BLOCK_PIXEL_COUNT];
+
+		const float refinedError = FitBC1(block, refined0, refined1, refinedColor0, refinedColor1, refinedIndices);
+
+		if (refinedError < error)
+		{
+			color0 = refinedColor0;
+			color1 = refinedColor1;
+			memcpy(indices, refinedIndices, sizeof(indices));
+		}
+	}
+
+	uint32_t indexBits = 0;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		indexBits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+	}
+
+	memcpy(pOutBlock, &color0, sizeof(color0));
+	memcpy(pOutBlock + 2, &color1, sizeof(color1));
+	memcpy(pOutBlock + 4, &indexBits, sizeof(indexBits));
+}
+
+// BC4
+static void EncodeBC4Channel(const uint8_t* const pPixels, const uint32_t channel, uint8_t* const pOutBlock)
+{
+	uint8_t minValue = 255;
+	uint8_t maxValue = 0;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		const uint8_t value = pPixels[i * 4 + channel];
+
+		minValue = value < minValue ? value : minValue;
+		maxValue = value > maxValue ? value : maxValue;
+	}
+
+	memset(pOutBlock, 0, 8);
+
+	pOutBlock[0] = maxValue;
+	pOutBlock[1] = minValue;
+
+	if (maxValue == minValue)
+	{
+		return;
+	}
+
+	// 8값 모드는 간격이 고르므로 투영해서 반올림하면 가장 가까운 값
+	const float scale = 7.f / static_cast<float>(maxValue - minValue);
+
+	uint32_t bitPosition = 16;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		const uint32_t t = static_cast<uint32_t>((maxValue - pPixels[i * 4 + channel]) * scale + 0.5f);
+		const uint32_t index = t == 0 ? 0 : (t == 7 ? 1 : t + 1);
+
+		WriteBits(pOutBlock, bitPosition, index, 3);
+	}
+}
+
+static void DecodeBC4Channel(const uint8_t* const pBlock, const uint32_t channel, uint8_t* const pOutPixels)
+{
+	const uint32_t value0 = pBlock[0];
+	const uint32_t value1 = pBlock[1];
+
+	uint8_t palette[BC4_PALETTE_SIZE];
+	palette[0] = static_cast<uint8_t>(value0);
+	palette[1] = static_cast<uint8_t>(value1);
+
+	if (value0 > value1)
+	{
+		for (uint32_t i = 1; i <= 6; ++i)
+		{
+			palette[i + 1] = static_cast<uint8_t>(((7 - i) * value0 + i * value1 + 3) / 7);
+		}
+	}
+	else
+	{
+		for (uint32_t i = 1; i <= 4; ++i)
+		{
+			palette[i + 1] = static_cast<uint8_t>(((5 - i) * value0 + i * value1 + 2) / 5);
+		}
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint32_t bitPosition = 16;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		pOutPixels[i * 4 + channel] = palette[ReadBits(pBlock, bitPosition, 3)];
+	}
+}
+
+// BC7 모드 6
+// 끝점마다 P비트 두 경우를 모두 양자화해서 오차가 작은 쪽을 고름
+static void QuantizeBC7Endpoint(const float endpoint[4], uint32_t outValues[4], uint32_t& outPBit)
+{
+	float bestError = FLT_MAX;
+
+	for (uint32_t pBit = 0; pBit < 2; ++pBit)
+	{
+		uint32_t values[4];
+		float error = 0.f;
+
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			const float quantized = ClampFloat(floorf((endpoint[c] - pBit) * 0.5f + 0.5f), 0.f, 127.f);
+			const float diff = quantized * 2.f + pBit - endpoint[c];
+
+			values[c] = static_cast<uint32_t>(quantized);
+			error += diff * diff;
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+			outPBit = pBit;
+			memcpy(outValues, values, sizeof(values));
+		}
+	}
+}
+
+static float FitBC7Mode6(
+	const BlockChannels& block,
+	const float endpoint0[4],
+	const float endpoint1[4],
+	uint32_t outValues[2][4],
+	uint32_t outPBits[2],
+	uint8_t outIndices[BLOCK_PIXEL_COUNT]
+)
+{
+	QuantizeBC7Endpoint(endpoint0, outValues[0], outPBits[0]);
+	QuantizeBC7Endpoint(endpoint1, outValues[1], outPBits[1]);
+
+	float palette[BC7_PALETTE_SIZE][4];
+
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		const uint32_t value0 = (outValues[0][c] << 1) | outPBits[0];
+		const uint32_t value1 = (outValues[1][c] << 1) | outPBits[1];
+
+		for (uint32_t i = 0; i < BC7_PALETTE_SIZE; ++i)
+		{
+			palette[i][c] = static_cast<float>(((64 - BC7_WEIGHTS[i]) * value0 + BC7_WEIGHTS[i] * value1 + 32) >> 6);
+		}
+	}
+
+	return FitIndices(block, palette, BC7_PALETTE_SIZE, 4, outIndices);
+}
+
+void EncodeBC1Block(const uint8_t* const pPixels, uint8_t* const pOutBlock)
+{
+	ASSERT(pPixels != nullptr);
+	ASSERT(pOutBlock != nullptr);
+
+	BlockChannels block;
+	LoadBlockChannels(pPixels, block);
+
+	EncodeBC1Color(block, pOutBlock);
+}
+
+void EncodeBC3Block(const uint8_t* const pPixels, uint8_t* const pOutBlock)
+{
+	ASSERT(pPixels != nullptr);
+	ASSERT(pOutBlock != nullptr);
+
+	BlockChannels block;
+	LoadBlockChannels(pPixels, block);
+
+	EncodeBC4Channel(pPixels, 3, pOutBlock);
+	EncodeBC1Color(block, pOutBlock + 8);
+}
+
+void EncodeBC5Block(const uint8_t* const pPixels, uint8_t* const pOutBlock)
+{
+	ASSERT(pPixels != nullptr);
+	ASSERT(pOutBlock != nullptr);
+
+	EncodeBC4Channel(pPixels, 0, pOutBlock);
+	EncodeBC4Channel(pPixels, 1, pOutBlock + 8);
+}
+
+void EncodeBC7Block(const uint8_t* const pPixels, uint8_t* const pOutBlock)
+{
+	ASSERT(pPixels != nullptr);
+	ASSERT(pOutBlock != nullptr);
+
+	BlockChannels block;
+	LoadBlockChannels(pPixels, block);
+
+	float endpoint0[4];
+	float endpoint1[4];
+	ComputeEndpoints(block, 4, false, endpoint0, endpoint1);
+
+	uint32_t values[2][4];
+	uint32_t pBits[2];
+	uint8_t indices[BLOCK_PIXEL_COUNT];
+
+	const float error = FitBC7Mode6(block, endpoint0, endpoint1, values, pBits, indices);
+
+	float weights[BC7_PALETTE_SIZE];
+
+	for (uint32_t i = 0; i < BC7_PALETTE_SIZE; ++i)
+	{
+		weights[i] = BC7_WEIGHTS[i] / 64.f;
+	}
+
+	float refined0[4];
+	float refined1[4];
+
+	if (error > 0.f && TrySolveEndpoints(block, 4, indices, weights, refined0, refined1))
+	{
+		uint32_t refinedValues[2][4];
+		uint32_t refinedPBits[2];
+		uint8_t refinedIndices[BLOCK_PIXEL_COUNT];
+
+		const float refinedError = FitBC7Mode6(block, refined0, refined1, refinedValues, refinedPBits, refinedIndices);
+
+		if (refinedError < error)
+		{
+			memcpy(values, refinedValues, sizeof(values));
+			memcpy(pBits, refinedPBits, sizeof(pBits));
+			memcpy(indices, refinedIndices, sizeof(indices));
+		}
+	}
+
+	// 0번 픽셀 인덱스의 최상위 비트는 0이어야 하므로 끝점을 뒤집음
+	if (indices[0] >= BC7_PALETTE_SIZE / 2)
+	{
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			const uint32_t temp = values[0][c];
+			values[0][c] = values[1][c];
+			values[1][c] = temp;
+		}
+
+		const uint32_t tempPBit = pBits[0];
+		pBits[0] = pBits[1];
+		pBits[1] = tempPBit;
+
+		for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+		{
+			indices[i] = static_cast<uint8_t>(BC7_PALETTE_SIZE - 1 - indices[i]);
+		}
+	}
+
+	memset(pOutBlock, 0, 16);
+
+	uint32_t bitPosition = 0;
+
+	WriteBits(pOutBlock, bitPosition, 1 << 6, 7);
+
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		WriteBits(pOutBlock, bitPosition, values[0][c], 7);
+		WriteBits(pOutBlock, bitPosition, values[1][c], 7);
+	}
+
+	WriteBits(pOutBlock, bitPosition, pBits[0], 1);
+	WriteBits(pOutBlock, bitPosition, pBits[1], 1);
+
+	WriteBits(pOutBlock, bitPosition, indices[0], BC7_MODE6_ANCHOR_INDEX_BITS);
+
+	for (uint32_t i = 1; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		WriteBits(pOutBlock, bitPosition, indices[i], BC7_MODE6_INDEX_BITS);
+	}
+
+	ASSERT(bitPosition == 128);
+}
+
+void DecodeBC1Block(const uint8_t* const pBlock, uint8_t* const pOutPixels)
+{
+	ASSERT(pBlock != nullptr);
+	ASSERT(pOutPixels != nullptr);
+
+	uint16_t color0;
+	uint16_t color1;
+	uint32_t indexBits;
+
+	memcpy(&color0, pBlock, sizeof(color0));
+	memcpy(&color1, pBlock + 2, sizeof(color1));
+	memcpy(&indexBits, pBlock + 4, sizeof(indexBits));
+
+	float palette[BC1_PALETTE_SIZE][4];
+	UnpackRGB565(color0, palette[0]);
+	UnpackRGB565(color1, palette[1]);
+
+	for (uint32_t c = 0; c < 3; ++c)
+	{
+		if (color0 > color1)
+		{
+			palette[2][c] = (2.f * palette[0][c] + palette[1][c]) / 3.f;
+			palette[3][c] = (palette[0][c] + 2.f * palette[1][c]) / 3.f;
+		}
+		else
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) * 0.5f;
+			palette[3][c] = 0.f;
+		}
+	}
+
+	palette[2][3] = 255.f;
+	palette[3][3] = color0 > color1 ? 255.f : 0.f;
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		const uint32_t index = (indexBits >> (i * 2)) & 3;
+
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			pOutPixels[i * 4 + c] = static_cast<uint8_t>(palette[index][c] + 0.5f);
+		}
+	}
+}
+
+void DecodeBC3Block(const uint8_t* const pBlock, uint8_t* const pOutPixels)
+{
+	DecodeBC1Block(pBlock + 8, pOutPixels);
+	DecodeBC4Channel(pBlock, 3, pOutPixels);
+}
+
+void DecodeBC5Block(const uint8_t* const pBlock, uint8_t* const pOutPixels)
+{
+	ASSERT(pBlock != nullptr);
+	ASSERT(pOutPixels != nullptr);
+
+	DecodeBC4Channel(pBlock, 0, pOutPixels);
+	DecodeBC4Channel(pBlock + 8, 1, pOutPixels);
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		pOutPixels[i * 4 + 2] = 0;
+		pOutPixels[i * 4 + 3] = 255;
+	}
+}
+
+void DecodeBC7Block(const uint8_t* const pBlock, uint8_t* const pOutPixels)
+{
+	ASSERT(pBlock != nullptr);
+	ASSERT(pOutPixels != nullptr);
+
+	uint32_t bitPosition = 0;
+
+	if (ReadBits(pBlock, bitPosition, 7) != (1 << 6))
+	{
+		for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+		{
+			pOutPixels[i * 4 + 0] = 255;
+			pOutPixels[i * 4 + 1] = 0;
+			pOutPixels[i * 4 + 2] = 255;
+			pOutPixels[i * 4 + 3] = 255;
+		}
+
+		return;
+	}
+
+	uint32_t values[2][4];
+
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		values[0][c] = ReadBits(pBlock, bitPosition, 7) << 1;
+		values[1][c] = ReadBits(pBlock, bitPosition, 7) << 1;
+	}
+
+	const uint32_t pBit0 = ReadBits(pBlock, bitPosition, 1);
+	const uint32_t pBit1 = ReadBits(pBlock, bitPosition, 1);
+
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		values[0][c] |= pBit0;
+		values[1][c] |= pBit1;
+	}
+
+	for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+	{
+		const uint32_t index = ReadBits(pBlock, bitPosition, i == 0 ? BC7_MODE6_ANCHOR_INDEX_BITS : BC7_MODE6_INDEX_BITS);
+		const uint32_t weight = BC7_WEIGHTS[index];
+
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			pOutPixels[i * 4 + c] = static_cast<uint8_t>(((64 - weight) * values[0][c] + weight * values[1][c] + 32) >> 6);
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// 4x4 블록 하나를 BC 형식으로 압축하고 푸는 함수들
+// 픽셀은 RGBA8 16개를 행 우선으로 이어 붙인 64바이트
+// 끝점은 주성분 축으로 잡고 인덱스를 고른 뒤 최소제곱으로 한 번 다듬음
+// 인덱스 선택은 픽셀 4개씩 SSE로 계산
+
+enum
+{
+	BLOCK_PIXEL_COUNT = 16,
+	BLOCK_RGBA_BYTE_SIZE = BLOCK_PIXEL_COUNT * 4
+};
+
+// 항상 4색 모드, 알파는 무시
+void EncodeBC1Block(const uint8_t* const pPixels, uint8_t* const pOutBlock);
+
+// BC4 알파 + BC1 색
+void EncodeBC3Block(const uint8_t* const pPixels, uint8_t* const pOutBlock);
+
+// R, G 두 채널을 각각 BC4로, 노멀 맵용
+void EncodeBC5Block(const uint8_t* const pPixels, uint8_t* const pOutBlock);
+
+// 모드 6(단일 구역, RGBA 7비트 + P비트, 4비트 인덱스)만 사용
+void EncodeBC7Block(const uint8_t* const pPixels, uint8_t* const pOutBlock);
+
+void DecodeBC1Block(const uint8_t* const pBlock, uint8_t* const pOutPixels);
+void DecodeBC3Block(const uint8_t* const pBlock, uint8_t* const pOutPixels);
+void DecodeBC5Block(const uint8_t* const pBlock, uint8_t* const pOutPixels);
+
+// 모드 6이 아닌 블록은 자홍색으로 채움
+void DecodeBC7Block(const uint8_t* const pBlock, uint8_t* const pOutPixels);
@@ -0,0 +1,698 @@
+#include "GeometryPool.h"
+
+#include "Core/LogHelper.h"
+
+enum
+{
+	DEFRAG_SCRATCH_BYTE_SIZE = 1 << 20
+};
+
+RangeAllocator::RangeAllocator(const uint32_t capacity)
+	: mCapacity(capacity)
+	, mUsedSize(0)
+	, mFreeBlocks()
+	, mAllocations()
+	, mFreeBlocksBySize()
+{
+	ASSERT(capacity > 0);
+
+	insertFreeBlock(0, capacity);
+}
+
+uint32_t RangeAllocator::Allocate(const uint32_t size)
+{
+	ASSERT(size > 0);
+
+	std::multimap<uint32_t, uint32_t>::iterator bestIter = mFreeBlocksBySize.lower_bound(size);
+
+	if (bestIter == mFreeBlocksBySize.end())
+	{
+		return INVALID_OFFSET;
+	}
+
+	const uint32_t offset = bestIter->second;
+
+	allocateFromFreeBlock(mFreeBlocks.find(offset), size);
+
+	return offset;
+}
+
+void RangeAllocator::Free(const uint32_t offset)
+{
+#define MAP_ITER std::map<uint32_t, uint32_t>::iterator
+
+	MAP_ITER allocationIter = mAllocations.find(offset);
+	ASSERT(allocationIter != mAllocations.end());
+
+	uint32_t blockOffset = offset;
+	uint32_t blockSize = allocationIter->second;
+
+	mUsedSize -= blockSize;
+	mAllocations.erase(allocationIter);
+
+	// 바로 뒤와 바로 앞의 빈 블록을 합침
+	MAP_ITER nextIter = mFreeBlocks.lower_bound(offset);
+
+	if (nextIter != mFreeBlocks.end() && nextIter->first == blockOffset + blockSize)
+	{
+		blockSize += nextIter->second;
+
+		eraseFreeBlock(nextIter);
+
+		nextIter = mFreeBlocks.lower_bound(offset);
+	}
+
+	if (nextIter != mFreeBlocks.begin())
+	{
+		MAP_ITER prevIter = std::prev(nextIter);
+
+		if (prevIter->first + prevIter->second == blockOffset)
+		{
+			blockOffset = prevIter->first;
+			blockSize += prevIter->second;
+
+			eraseFreeBlock(prevIter);
+		}
+	}
+
+	insertFreeBlock(blockOffset, blockSize);
+
+#undef MAP_ITER
+}
+
+bool RangeAllocator::TryRelocate(const uint32_t maxSize, uint32_t& outOldOffset, uint32_t& outNewOffset, uint32_t& outSize)
+{
+#define MAP_ITER std::map<uint32_t, uint32_t>::iterator
+
+	if (mFreeBlocks.empty())
+	{
+		return false;
+	}
+
+	const MAP_ITER holeIter = mFreeBlocks.begin();
+
+	const uint32_t holeOffset = holeIter->first;
+	const uint32_t holeSize = holeIter->second;
+
+	// 빈 블록은 합쳐져 있으므로 바로 뒤가 할당이 아니면 끝까지 비어 있음
+	const MAP_ITER nextIter = mAllocations.find(holeOffset + holeSize);
+
+	if (nextIter == mAllocations.end())
+	{
+		return false;
+	}
+
+	// 맨 위 할당 중 구멍에 들어가는 것을 먼저 옮겨서 움직이는 양을 줄임
+	for (std::map<uint32_t, uint32_t>::reverse_iterator iter = mAllocations.rbegin(); iter != mAllocations.rend() && iter->first > holeOffset; ++iter)
+	{
+		const uint32_t size = iter->second;
+
+		if (size > holeSize || size > maxSize)
+		{
+			continue;
+		}
+
+		outOldOffset = iter->first;
+		outNewOffset = holeOffset;
+		outSize = size;
+
+		allocateFromFreeBlock(holeIter, size);
+		Free(outOldOffset);
+
+		return true;
+	}
+
+	// 없으면 바로 뒤 할당을 구멍 앞으로 당김
+	const uint32_t size = nextIter->second;
+
+	if (size > maxSize)
+	{
+		return false;
+	}
+
+	outOldOffset = nextIter->first;
+	outNewOffset = holeOffset;
+	outSize = size;
+
+	mAllocations.erase(nextIter);
+	eraseFreeBlock(holeIter);
+
+	mAllocations.insert(std::make_pair(holeOffset, size));
+
+	uint32_t freeSize = holeSize;
+
+	const MAP_ITER followingIter = mFreeBlocks.find(holeOffset + holeSize + size);
+
+	if (followingIter != mFreeBlocks.end())
+	{
+		freeSize += followingIter->second;
+
+		eraseFreeBlock(followingIter);
+	}
+
+	insertFreeBlock(holeOffset + size, freeSize);
+
+#undef MAP_ITER
+
+	return true;
+}
+
+bool RangeAllocator::Validate() const
+{
+#define MAP_ITER std::map<uint32_t, uint32_t>::const_iterator
+
+	if (mFreeBlocks.size() != mFreeBlocksBySize.size())
+	{
+		return false;
+	}
+
+	uint32_t usedSize = 0;
+	uint32_t cursor = 0;
+
+	MAP_ITER allocationIter = mAllocations.cbegin();
+	MAP_ITER freeIter = mFreeBlocks.cbegin();
+
+	bool bPrevFree = false;
+
+	// 오프셋 순으로 두 목록을 합쳐 가며 빈틈과 겹침을 찾음
+	while (allocationIter != mAllocations.cend() || freeIter != mFreeBlocks.cend())
+	{
+		const bool bFree = allocationIter == mAllocations.cend()
+			|| (freeIter != mFreeBlocks.cend() && freeIter->first < allocationIter->first);
+
+		MAP_ITER& iter = bFree ? freeIter : allocationIter;
+
+		if (iter->first != cursor || iter->second == 0)
+		{
+			return false;
+		}
+
+		if (bFree)
+		{
+			// 붙어 있는 빈 블록은 합쳐져 있어야 함
+			if (bPrevFree)
+			{
+				return false;
+			}
+
+			bool bIndexed = false;
+
+			typedef std::multimap<uint32_t, uint32_t>::const_iterator SizeIter;
+			const std::pair<SizeIter, SizeIter> range = mFreeBlocksBySize.equal_range(iter->second);
+
+			for (SizeIter sizeIter = range.first; sizeIter != range.second; ++sizeIter)
+			{
+				bIndexed = bIndexed || sizeIter->second == iter->first;
+			}
+
+			if (!bIndexed)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			usedSize += iter->second;
+		}
+
+		bPrevFree = bFree;
+		cursor += iter->second;
+
+		++iter;
+	}
+
+#undef MAP_ITER
+
+	return cursor == mCapacity && usedSize == mUsedSize;
+}
+
+void RangeAllocator::insertFreeBlock(const uint32_t offset, const uint32_t size)
+{
+	mFreeBlocks.insert(std::make_pair(offset, size));
+	mFreeBlocksBySize.insert(std::make_pair(size, offset));
+}
+
+void RangeAllocator::eraseFreeBlock(const std::map<uint32_t, uint32_t>::iterator iter)
+{
+	typedef std::multimap<uint32_t, uint32_t>::iterator SizeIter;
+	const std::pair<SizeIter, SizeIter> range = mFreeBlocksBySize.equal_range(iter->second);
+
+	for (SizeIter sizeIter = range.first; sizeIter != range.second; ++sizeIter)
+	{
+		if (sizeIter->second == iter->first)
+		{
+			mFreeBlocksBySize.erase(sizeIter);
+
+			break;
+		}
+	}
+
+	mFreeBlocks.erase(iter);
+}
+
+void RangeAllocator::allocateFromFreeBlock(const std::map<uint32_t, uint32_t>::iterator iter, const uint32_t size)
+{
+	ASSERT(iter != mFreeBlocks.end());
+	ASSERT(iter->second >= size);
+
+	const uint32_t offset = iter->first;
+	const uint32_t remainder = iter->second - size;
+
+	eraseFreeBlock(iter);
+
+	if (remainder > 0)
+	{
+		insertFreeBlock(offset + size, remainder);
+	}
+
+	mAllocations.insert(std::make_pair(offset, size));
+	mUsedSize += size;
+}
+
+GeometryPool::GeometryPool(
+	RHI::Device& device,
+	const char* const name,
+	const uint32_t bindFlags,
+	const uint32_t* const pStrides,
+	const uint32_t streamCount,
+	const uint32_t pageByteSize
+)
+	: mDevice(device)
+	, mName(name)
+	, mBindFlags(bindFlags)
+	, mStrides()
+	, mStreamCount(streamCount)
+	, mStrideSum(0)
+	, mPageCapacity(0)
+	, mPages()
+	, mScratchBuffer({ 0 })
+	, mScratchByteSize(DEFRAG_SCRATCH_BYTE_SIZE)
+	, mCommandList()
+	, mbBatching(false)
+	, mTotalRelocatedBytes(0)
+{
+	ASSERT(name != nullptr);
+	ASSERT(pStrides != nullptr);
+	ASSERT(streamCount > 0 && streamCount <= MAX_STREAM_COUNT);
+
+	for (uint32_t i = 0; i < streamCount; ++i)
+	{
+		ASSERT(pStrides[i] > 0);
+
+		mStrides[i] = pStrides[i];
+		mStrideSum += pStrides[i];
+	}
+
+	mPageCapacity = pageByteSize / mStrideSum;
+	ASSERT(mPageCapacity > 0);
+}
+
+GeometryPool::~GeometryPool()
+{
+	for (Page* const pPage : mPages)
+	{
+		if (pPage != nullptr)
+		{
+			destroyPage(pPage);
+		}
+	}
+
+	if (mScratchBuffer.IsValid())
+	{
+		mDevice.DestroyBuffer(mScratchBuffer);
+	}
+}
+
+bool GeometryPool::TryAllocate(const void* const* const ppStreamData, const uint32_t count, Allocation& outAllocation)
+{
+	ASSERT(ppStreamData != nullptr);
+	ASSERT(count > 0);
+
+	outAllocation.page = INVALID_PAGE;
+	outAllocation.offset = RangeAllocator::INVALID_OFFSET;
+	outAllocation.count = count;
+
+	uint32_t emptySlot = INVALID_PAGE;
+
+	for (uint32_t i = 0; i < mPages.size(); ++i)
+	{
+		if (mPages[i] == nullptr)
+		{
+			emptySlot = emptySlot == INVALID_PAGE ? i : emptySlot;
+
+			continue;
+		}
+
+		const uint32_t offset = mPages[i]->allocator.Allocate(count);
+
+		if (offset != RangeAllocator::INVALID_OFFSET)
+		{
+			outAllocation.page = i;
+			outAllocation.offset = offset;
+
+			break;
+		}
+	}
+
+	// 기본 크기보다 큰 메쉬는 딱 맞는 페이지를 따로 받음
+	if (!outAllocation.IsValid())
+	{
+		Page* const pPage = createPageAllocOrNull(count > mPageCapacity ? count : mPageCapacity);
+
+		if (pPage == nullptr)
+		{
+			return false;
+		}
+
+		if (emptySlot != INVALID_PAGE)
+		{
+			mPages[emptySlot] = pPage;
+		}
+		else
+		{
+			emptySlot = static_cast<uint32_t>(mPages.size());
+
+			mPages.push_back(pPage);
+		}
+
+		outAllocation.page = emptySlot;
+		outAllocation.offset = pPage->allocator.Allocate(count);
+		ASSERT(outAllocation.offset == 0);
+	}
+
+	const Page& page = *mPages[outAllocation.page];
+
+	if (!mbBatching)
+	{
+		mCommandList.Reset();
+	}
+
+	for (uint32_t i = 0; i < mStreamCount; ++i)
+	{
+		ASSERT(ppStreamData[i] != nullptr);
+
+		mCommandList.UpdateBufferRegion(page.buffers[i], outAllocation.offset * mStrides[i], ppStreamData[i], count * mStrides[i]);
+	}
+
+	if (!mbBatching)
+	{
+		mDevice.Submit(mCommandList);
+	}
+
+	return true;
+}
+
+void GeometryPool::BeginBatch()
+{
+	ASSERT(!mbBatching);
+
+	mbBatching = true;
+
+	mCommandList.Reset();
+}
+
+void GeometryPool::EndBatch()
+{
+	ASSERT(mbBatching);
+
+	mbBatching = false;
+
+	// 데이터는 명령 목록에 복사해 두었으므로 원본은 이미 없어도 됨
+	mDevice.Submit(mCommandList);
+
+	for (uint32_t i = 0; i < mPages.size(); ++i)
+	{
+		releasePageIfEmpty(i);
+	}
+}
+
+void GeometryPool::Free(const Allocation& allocation)
+{
+	ASSERT(allocation.IsValid());
+	ASSERT(allocation.page < mPages.size());
+	ASSERT(mPages[allocation.page] != nullptr);
+
+	mPages[allocation.page]->allocator.Free(allocation.offset);
+
+	if (!mbBatching)
+	{
+		releasePageIfEmpty(allocation.page);
+	}
+}
+
+void GeometryPool::Defragment(const uint32_t maxBytes, std::vector<Relocation>& outRelocations)
+{
+	ASSERT(!mbBatching);
+
+	const uint32_t budgetBytes = maxBytes < mScratchByteSize ? maxBytes : mScratchByteSize;
+
+	// 가장 큰 스트림이 임시 버퍼에 들어가야 옮길 수 있음
+	uint32_t maxStride = 0;
+	for (uint32_t i = 0; i < mStreamCount; ++i)
+	{
+		maxStride = mStrides[i] > maxStride ? mStrides[i] : maxStride;
+	}
+
+	uint32_t remainingBytes = budgetBytes;
+
+	const size_t relocationStart = outRelocations.size();
+
+	mCommandList.Reset();
+
+	for (uint32_t pageIndex = 0; pageIndex < mPages.size(); ++pageIndex)
+	{
+		if (mPages[pageIndex] == nullptr)
+		{
+			continue;
+		}
+
+		Page& page = *mPages[pageIndex];
+
+		uint32_t oldOffset;
+		uint32_t newOffset;
+		uint32_t size;
+
+		while (remainingBytes >= maxStride
+			&& page.allocator.TryRelocate(remainingBytes / maxStride, oldOffset, newOffset, size))
+		{
+			if (!mScratchBuffer.IsValid())
+			{
+				RHI::BufferDesc bufferDesc = {};
+				bufferDesc.usage = RHI::EUsage::DEFAULT;
+				bufferDesc.byteWidth = mScratchByteSize;
+				bufferDesc.bindFlags = mBindFlags;
+
+				mScratchBuffer = mDevice.CreateBuffer(bufferDesc, nullptr);
+				ASSERT(mScratchBuffer.IsValid());
+			}
+
+			// 구간이 겹쳐도 임시 버퍼로 통째로 뺐다가 다시 쓰므로 안전
+			for (uint32_t i = 0; i < mStreamCount; ++i)
+			{
+				const uint32_t byteSize = size * mStrides[i];
+
+				mCommandList.CopyBuffer(mScratchBuffer, 0, page.buffers[i], oldOffset * mStrides[i], byteSize);
+				mCommandList.CopyBuffer(page.buffers[i], newOffset * mStrides[i], mScratchBuffer, 0, byteSize);
+			}
+
+			Relocation relocation;
+			relocation.page = pageIndex;
+			relocation.oldOffset = oldOffset;
+			relocation.newOffset = newOffset;
+
+			outRelocations.push_back(relocation);
+
+			remainingBytes -= size * maxStride;
+			mTotalRelocatedBytes += size * mStrideSum;
+		}
+	}
+
+	mDevice.Submit(mCommandList);
+
+#if defined(DEBUG) || defined(_DEBUG)
+	ASSERT(outRelocations.size() == relocationStart || Validate());
+#endif
+}
+
+uint32_t GeometryPool::GetPageCount() const
+{
+	uint32_t pageCount = 0;
+
+	for (const Page* const pPage : mPages)
+	{
+		pageCount += pPage != nullptr ? 1 : 0;
+	}
+
+	return pageCount;
+}
+
+uint32_t GeometryPool::GetCapacity() const
+{
+	uint32_t capacity = 0;
+
+	for (const Page* const pPage : mPages)
+	{
+		if (pPage == nullptr)
+		{
+			continue;
+		}
+
+		capacity += pPage->allocator.GetCapacity();
+	}
+
+	return capacity;
+}
+
+uint32_t GeometryPool::GetUsedSize() const
+{
+	uint32_t usedSize = 0;
+
+	for (const Page* const pPage : mPages)
+	{
+		if (pPage == nullptr)
+		{
+			continue;
+		}
+
+		usedSize += pPage->allocator.GetUsedSize();
+	}
+
+	return usedSize;
+}
+
+uint32_t GeometryPool::GetFreeBlockCount() const
+{
+	uint32_t freeBlockCount = 0;
+
+	for (const Page* const pPage : mPages)
+	{
+		if (pPage == nullptr)
+		{
+			continue;
+		}
+
+		freeBlockCount += pPage->allocator.GetFreeBlockCount();
+	}
+
+	return freeBlockCount;
+}
+
+uint32_t GeometryPool::GetLargestFreeBlock() const
+{
+	uint32_t largestFreeBlock = 0;
+
+	for (const Page* const pPage : mPages)
+	{
+		if (pPage == nullptr)
+		{
+			continue;
+		}
+
+		const uint32_t largest = pPage->allocator.GetLargestFreeBlock();
+
+		largestFreeBlock = largest > largestFreeBlock ? largest : largestFreeBlock;
+	}
+
+	return largestFreeBlock;
+}
+
+float GeometryPool::GetFragmentation() const
+{
+	uint32_t freeSize = 0;
+	uint32_t largestFreeSum = 0;
+
+	for (const Page* const pPage : mPages)
+	{
+		if (pPage == nullptr)
+		{
+			continue;
+		}
+
+		freeSize += pPage->allocator.GetFreeSize();
+		largestFreeSum += pPage->allocator.GetLargestFreeBlock();
+	}
+
+	if (freeSize == 0)
+	{
+		return 0.f;
+	}
+
+	return 1.f - static_cast<float>(largestFreeSum) / static_cast<float>(freeSize);
+}
+
+bool GeometryPool::Validate() const
+{
+	for (const Page* const pPage : mPages)
+	{
+		if (pPage == nullptr)
+		{
+			continue;
+		}
+
+		if (!pPage->allocator.Validate())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+GeometryPool::Page* GeometryPool::createPageAllocOrNull(const uint32_t capacity)
+{
+	Page* const pPage = new Page(capacity);
+
+	for (uint32_t i = 0; i < mStreamCount; ++i)
+	{
+		// 올린 뒤에도 조각 모음으로 고쳐 쓰므로 IMMUTABLE이 아님
+		RHI::BufferDesc bufferDesc = {};
+		bufferDesc.usage = RHI::EUsage::DEFAULT;
+		bufferDesc.byteWidth = capacity * mStrides[i];
+		bufferDesc.bindFlags = mBindFlags;
+
+		pPage->buffers[i] = mDevice.CreateBuffer(bufferDesc, nullptr);
+
+		if (!pPage->buffers[i].IsValid())
+		{
+			LOG_SYSTEM_ERROR(E_FAIL, "CreateBuffer - GeometryPool");
+
+			destroyPage(pPage);
+
+			return nullptr;
+		}
+	}
+
+	return pPage;
+}
+
+void GeometryPool::destroyPage(Page* const pPage)
+{
+	ASSERT(pPage != nullptr);
+
+	for (uint32_t i = 0; i < mStreamCount; ++i)
+	{
+		if (pPage->buffers[i].IsValid())
+		{
+			mDevice.DestroyBuffer(pPage->buffers[i]);
+		}
+	}
+
+	delete pPage;
+}
+
+void GeometryPool::releasePageIfEmpty(const uint32_t page)
+{
+	ASSERT(!mbBatching);
+	ASSERT(page < mPages.size());
+
+	Page* const pPage = mPages[page];
+
+	if (pPage == nullptr || pPage->allocator.GetAllocationCount() > 0)
+	{
+		return;
+	}
+
+	destroyPage(pPage);
+
+	mPages[page] = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "Core/Assert.h"
+#include "Renderer/RHI/RHIDevice.h"
+#include "Renderer/RHI/RHICommandList.h"
+
+// 원소 단위 구간을 나눠 주는 free-list, 빈 블록은 해제할 때 이웃과 합침
+class RangeAllocator final
+{
+public:
+	enum
+	{
+		INVALID_OFFSET = 0xFFFFFFFF
+	};
+
+	RangeAllocator(const uint32_t capacity);
+	~RangeAllocator() = default;
+
+	// 가장 잘 맞는 빈 블록에서 자름, 자리가 없으면 INVALID_OFFSET
+	uint32_t Allocate(const uint32_t size);
+	void Free(const uint32_t offset);
+
+	// 가장 아래 빈 블록을 메우도록 할당 하나를 옮김, 더 옮길 것이 없으면 false
+	// 맞는 것이 없으면 바로 뒤 할당을 당겨서 옛 구간과 새 구간이 겹칠 수 있음
+	bool TryRelocate(const uint32_t maxSize, uint32_t& outOldOffset, uint32_t& outNewOffset, uint32_t& outSize);
+
+	// 할당과 빈 블록이 겹치지 않고 전체를 덮는지 확인
+	bool Validate() const;
+
+	inline uint32_t GetCapacity() const
+	{
+		return mCapacity;
+	}
+
+	inline uint32_t GetUsedSize() const
+	{
+		return mUsedSize;
+	}
+
+	inline uint32_t GetFreeSize() const
+	{
+		return mCapacity - mUsedSize;
+	}
+
+	inline uint32_t GetLargestFreeBlock() const
+	{
+		return mFreeBlocksBySize.empty() ? 0 : mFreeBlocksBySize.crbegin()->first;
+	}
+
+	inline uint32_t GetFreeBlockCount() const
+	{
+		return static_cast<uint32_t>(mFreeBlocks.size());
+	}
+
+	inline uint32_t GetAllocationCount() const
+	{
+		return static_cast<uint32_t>(mAllocations.size());
+	}
+
+private:
+	uint32_t mCapacity;
+	uint32_t mUsedSize;
+
+	// offset -> size
+	std::map<uint32_t, uint32_t> mFreeBlocks;
+	std::map<uint32_t, uint32_t> mAllocations;
+
+	// size -> offset, best fit 검색용
+	std::multimap<uint32_t, uint32_t> mFreeBlocksBySize;
+
+private:
+	void insertFreeBlock(const uint32_t offset, const uint32_t size);
+	void eraseFreeBlock(const std::map<uint32_t, uint32_t>::iterator iter);
+	void allocateFromFreeBlock(const std::map<uint32_t, uint32_t>::iterator iter, const uint32_t size);
+
+private:
+	RangeAllocator(const RangeAllocator& other) = delete;
+	RangeAllocator(RangeAllocator&& other) = delete;
+	RangeAllocator& operator=(const RangeAllocator& other) = delete;
+	RangeAllocator& operator=(RangeAllocator&& other) = delete;
+};
+
+// 같은 정점 배치의 메쉬들이 나눠 쓰는 큰 GPU 버퍼 묶음
+// 스트림들이 할당기 하나를 같이 써서 모든 스트림에서 원소 오프셋이 같음
+// 마지막 할당이 해제된 페이지는 버퍼를 바로 돌려주고 번호는 다음 새 페이지가 다시 씀
+class GeometryPool final
+{
+public:
+	enum
+	{
+		MAX_STREAM_COUNT = 2,
+		INVALID_PAGE = 0xFFFFFFFF
+	};
+
+	// 오프셋과 개수는 원소 단위
+	struct Allocation
+	{
+		uint32_t page;
+		uint32_t offset;
+		uint32_t count;
+
+		inline bool IsValid() const
+		{
+			return page != INVALID_PAGE;
+		}
+	};
+
+	struct Relocation
+	{
+		uint32_t page;
+		uint32_t oldOffset;
+		uint32_t newOffset;
+	};
+
+	GeometryPool(
+		RHI::Device& device,
+		const char* const name,
+		const uint32_t bindFlags,
+		const uint32_t* const pStrides,
+		const uint32_t streamCount,
+		const uint32_t pageByteSize
+	);
+	~GeometryPool();
+
+	// ppStreamData[i]는 count * 스트림 i의 stride 바이트, 맞는 페이지가 없으면 새로 만듦
+	bool TryAllocate(const void* const* const ppStreamData, const uint32_t count, Allocation& outAllocation);
+	void Free(const Allocation& allocation);
+
+	// 사이의 TryAllocate 업로드를 모아 두었다가 EndBatch에서 한 번에 제출
+	void BeginBatch();
+	void EndBatch();
+
+	// 뒤쪽 할당을 앞쪽 빈 곳으로 maxBytes만큼 옮기고 outRelocations에 덧붙임
+	void Defragment(const uint32_t maxBytes, std::vector<Relocation>& outRelocations);
+
+	inline const char* GetName() const
+	{
+		return mName;
+	}
+
+	inline RHI::BufferHandle GetBuffer(const uint32_t page, const uint32_t stream) const
+	{
+		ASSERT(page < mPages.size());
+		ASSERT(mPages[page] != nullptr);
+		ASSERT(stream < mStreamCount);
+
+		return mPages[page]->buffers[stream];
+	}
+
+	// 모든 스트림을 더한 원소 하나의 크기
+	inline uint32_t GetElementByteSize() const
+	{
+		return mStrideSum;
+	}
+
+	inline uint64_t GetTotalRelocatedBytes() const
+	{
+		return mTotalRelocatedBytes;
+	}
+
+	// 버퍼가 살아 있는 페이지 수
+	uint32_t GetPageCount() const;
+	uint32_t GetCapacity() const;
+	uint32_t GetUsedSize() const;
+	uint32_t GetFreeBlockCount() const;
+	uint32_t GetLargestFreeBlock() const;
+
+	// 1 - 페이지별 가장 큰 빈 블록의 합 / 전체 빈 공간, 페이지마다 한 덩어리면 0
+	float GetFragmentation() const;
+
+	bool Validate() const;
+
+private:
+	struct Page
+	{
+		RHI::BufferHandle buffers[MAX_STREAM_COUNT];
+		RangeAllocator allocator;
+
+		Page(const uint32_t capacity)
+			: buffers()
+			, allocator(capacity)
+		{
+		}
+	};
+
+	RHI::Device& mDevice;
+	const char* mName;
+
+	uint32_t mBindFlags;
+	uint32_t mStrides[MAX_STREAM_COUNT];
+	uint32_t mStreamCount;
+	uint32_t mStrideSum;
+	uint32_t mPageCapacity;
+
+	// 해제한 페이지는 nullptr로 남겨서 다른 할당의 페이지 번호가 바뀌지 않게 함
+	std::vector<Page*> mPages;
+
+	// 같은 버퍼 안의 복사는 안 되므로 여기를 거쳐서 옮김
+	RHI::BufferHandle mScratchBuffer;
+	uint32_t mScratchByteSize;
+
+	RHI::CommandList mCommandList;
+	bool mbBatching;
+
+	uint64_t mTotalRelocatedBytes;
+
+private:
+	Page* createPageAllocOrNull(const uint32_t capacity);
+	void destroyPage(Page* const pPage);
+
+	// 배치 중에는 아직 제출하지 않은 업로드가 버퍼를 가리킬 수 있어 EndBatch까지 미룸
+	void releasePageIfEmpty(const uint32_t page);
+
+private:
+	GeometryPool(const GeometryPool& other) = delete;
+	GeometryPool(GeometryPool&& other) = delete;
+	GeometryPool& operator=(const GeometryPool& other) = delete;
+	GeometryPool& operator=(GeometryPool&& other) = delete;
+};
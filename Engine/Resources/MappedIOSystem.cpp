@@ -0,0 +1,224 @@
+#include "MappedIOSystem.h"
+
+#include <cstring>
+#include <filesystem>
+
+MappedFileCache::MappedFileCache()
+	: mMutex()
+	, mFiles()
+	, mStats{}
+{
+
+}
+
+MappedFileCache::~MappedFileCache()
+{
+	Clear();
+}
+
+const MappedFile* MappedFileCache::AcquireOrNull(const char* const path)
+{
+	ASSERT(path != nullptr);
+
+	// 같은 파일을 "a/./b.bin", "a\\b.bin"처럼 다르게 불러도 하나로 봄
+	const std::string key = std::filesystem::path(path).lexically_normal().string();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+#define MAP_ITER std::unordered_map<std::string, MappedFile*>::iterator
+
+	MAP_ITER iter = mFiles.find(key);
+
+	if (iter != mFiles.end())
+	{
+		++mStats.reuseCount;
+
+		return iter->second;
+	}
+
+#undef MAP_ITER
+
+	MappedFile* const pFile = new MappedFile();
+
+	if (!pFile->TryOpen(key.c_str()))
+	{
+		delete pFile;
+
+		return nullptr;
+	}
+
+	mFiles.insert(std::make_pair(key, pFile));
+
+	++mStats.mapCount;
+	mStats.mappedBytes += pFile->GetSize();
+
+	return pFile;
+}
+
+void MappedFileCache::AddReadBytes(const uint64_t byteSize)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mStats.readBytes += byteSize;
+}
+
+void MappedFileCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	for (std::pair<const std::string, MappedFile*>& pair : mFiles)
+	{
+		delete pair.second;
+	}
+
+	mFiles.clear();
+}
+
+MappedFileCache::Stats MappedFileCache::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mStats;
+}
+
+MappedIOStream::MappedIOStream(MappedFileCache& cache, const MappedFile& file)
+	: mCache(cache)
+	, mpData(file.GetData())
+	, mSize(file.GetSize())
+	, mPosition(0)
+	, mReadBytes(0)
+{
+	ASSERT(mpData != nullptr);
+}
+
+MappedIOStream::~MappedIOStream()
+{
+	mCache.AddReadBytes(mReadBytes);
+}
+
+size_t MappedIOStream::Read(void* pvBuffer, size_t pSize, size_t pCount)
+{
+	ASSERT(pvBuffer != nullptr);
+
+	if (pSize == 0 || pCount == 0)
+	{
+		return 0;
+	}
+
+	// 남은 크기 안에서 원소 단위로만 읽음
+	const size_t availableCount = (mSize - mPosition) / pSize;
+	const size_t readCount = pCount < availableCount ? pCount : availableCount;
+	const size_t byteSize = readCount * pSize;
+
+	memcpy(pvBuffer, mpData + mPosition, byteSize);
+
+	mPosition += byteSize;
+	mReadBytes += byteSize;
+
+	return readCount;
+}
+
+size_t MappedIOStream::Write(const void*, size_t, size_t)
+{
+	// 읽기 전용
+	return 0;
+}
+
+aiReturn MappedIOStream::Seek(size_t pOffset, aiOrigin pOrigin)
+{
+	size_t position;
+
+	switch (pOrigin)
+	{
+	case aiOrigin_SET:
+		position = pOffset;
+		break;
+
+	case aiOrigin_CUR:
+		position = mPosition + pOffset;
+		break;
+
+	case aiOrigin_END:
+		if (pOffset > mSize)
+		{
+			return aiReturn_FAILURE;
+		}
+
+		position = mSize - pOffset;
+		break;
+
+	default:
+		ASSERT(false);
+		return aiReturn_FAILURE;
+	}
+
+	if (position > mSize)
+	{
+		return aiReturn_FAILURE;
+	}
+
+	mPosition = position;
+
+	return aiReturn_SUCCESS;
+}
+
+size_t MappedIOStream::Tell() const
+{
+	return mPosition;
+}
+
+size_t MappedIOStream::FileSize() const
+{
+	return mSize;
+}
+
+void MappedIOStream::Flush()
+{
+
+}
+
+MappedIOSystem::MappedIOSystem(MappedFileCache& cache)
+	: Assimp::IOSystem()
+	, mCache(cache)
+{
+
+}
+
+bool MappedIOSystem::Exists(const char* pFile) const
+{
+	ASSERT(pFile != nullptr);
+
+	std::error_code errorCode;
+
+	return std::filesystem::is_regular_file(pFile, errorCode);
+}
+
+char MappedIOSystem::getOsSeparator() const
+{
+	return '\\';
+}
+
+Assimp::IOStream* MappedIOSystem::Open(const char* pFile, const char* pMode)
+{
+	ASSERT(pFile != nullptr);
+	ASSERT(pMode != nullptr);
+
+	if (strchr(pMode, 'w') != nullptr || strchr(pMode, 'a') != nullptr || strchr(pMode, '+') != nullptr)
+	{
+		return nullptr;
+	}
+
+	const MappedFile* const pMappedFile = mCache.AcquireOrNull(pFile);
+
+	if (pMappedFile == nullptr)
+	{
+		return nullptr;
+	}
+
+	return new MappedIOStream(mCache, *pMappedFile);
+}
+
+void MappedIOSystem::Close(Assimp::IOStream* pFile)
+{
+	delete pFile;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+#include "Core/Assert.h"
+#include "Core/MappedFile.h"
+
+// 여러 번 불러오는 동안 같은 파일(모델, .bin, 텍스처 등)의 매핑을 다시 씀
+// 여러 불러오기 스레드에서 같이 써도 됨, 매핑은 Clear까지 유지
+class MappedFileCache final
+{
+public:
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct Stats
+	{
+		// 새로 매핑한 수와 이미 있던 매핑을 다시 쓴 수
+		uint32_t mapCount;
+		uint32_t reuseCount;
+
+		uint64_t mappedBytes;
+
+		// 불러오기가 스트림에서 실제로 읽어 간 바이트
+		uint64_t readBytes;
+	};
+#pragma warning(pop)
+
+public:
+	MappedFileCache();
+	~MappedFileCache();
+
+	// 없거나 빈 파일이면 nullptr
+	const MappedFile* AcquireOrNull(const char* const path);
+
+	void AddReadBytes(const uint64_t byteSize);
+
+	void Clear();
+
+	Stats GetStats() const;
+
+private:
+	mutable std::mutex mMutex;
+
+	// 정규화한 경로 -> 매핑
+	std::unordered_map<std::string, MappedFile*> mFiles;
+
+	Stats mStats;
+
+private:
+	MappedFileCache(const MappedFileCache& other) = delete;
+	MappedFileCache(MappedFileCache&& other) = delete;
+	MappedFileCache& operator=(const MappedFileCache& other) = delete;
+	MappedFileCache& operator=(MappedFileCache&& other) = delete;
+};
+
+// 매핑된 뷰에서 바로 읽는 스트림, stdio 버퍼를 거치지 않음
+class MappedIOStream final : public Assimp::IOStream
+{
+public:
+	MappedIOStream(MappedFileCache& cache, const MappedFile& file);
+	virtual ~MappedIOStream();
+
+	virtual size_t Read(void* pvBuffer, size_t pSize, size_t pCount) override;
+	virtual size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) override;
+	virtual aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+	virtual size_t Tell() const override;
+	virtual size_t FileSize() const override;
+	virtual void Flush() override;
+
+private:
+	MappedFileCache& mCache;
+
+	const uint8_t* mpData;
+	size_t mSize;
+	size_t mPosition;
+
+	// 닫을 때 한 번에 캐시 통계에 더함
+	uint64_t mReadBytes;
+
+private:
+	MappedIOStream(const MappedIOStream& other) = delete;
+	MappedIOStream(MappedIOStream&& other) = delete;
+	MappedIOStream& operator=(const MappedIOStream& other) = delete;
+	MappedIOStream& operator=(MappedIOStream&& other) = delete;
+};
+
+// 불러오기마다 하나씩 만들어 Importer에 넘김(Importer가 해제), 매핑은 캐시가 가짐
+// 읽기 전용이라 쓰기 모드로 열면 실패
+class MappedIOSystem final : public Assimp::IOSystem
+{
+public:
+	MappedIOSystem(MappedFileCache& cache);
+	virtual ~MappedIOSystem() = default;
+
+	virtual bool Exists(const char* pFile) const override;
+	virtual char getOsSeparator() const override;
+	virtual Assimp::IOStream* Open(const char* pFile, const char* pMode) override;
+	virtual void Close(Assimp::IOStream* pFile) override;
+
+private:
+	MappedFileCache& mCache;
+
+private:
+	MappedIOSystem(const MappedIOSystem& other) = delete;
+	MappedIOSystem(MappedIOSystem&& other) = delete;
+	MappedIOSystem& operator=(const MappedIOSystem& other) = delete;
+	MappedIOSystem& operator=(MappedIOSystem&& other) = delete;
+};
@@ -1,10 +1,12 @@
 #include "Material.h"
 
 #include "Core/Assert.h"
+#include "Core/HashHelper.h"
 #include "TextureManager.h"
 #include "Texture.h"
 #include "ShaderManager.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/RHI/RHICommandList.h"
 #include "UI/ImGuiHeaders.h"
 #include "Core/CommonDefs.h"
 
@@ -13,7 +15,7 @@ Material::Material(
 	const std::string& texturePath,
 	const std::string& vertexShaderPath,
 	const std::string& pixelShaderPath,
-	ComPtr<ID3D11Buffer>& pMaterialBufferGPU,
+	const RHI::BufferHandle materialBuffer,
 	const ERasterizerType rasterizerType,
 	const ESamplerType samplerType,
 	const EBlendStateType blendStateType,
@@ -24,77 +26,219 @@ Material::Material(
 	, mTexturePath(texturePath)
 	, mVertexShaderPath(vertexShaderPath)
 	, mPixelShaderPath(pixelShaderPath)
-	, mpMaterialBufferGPU(pMaterialBufferGPU)
-	, mRasterizerType(rasterizerType)
-	, mSamplerType(samplerType)
-	, mBlendStateType(blendStateType)
-	, mDepthStencilType(depthStencilType)
+	, mPixelShaderIndex(ShaderManager::GetInstance().GetPixelShaderIndex(pixelShaderPath))
+	, mbUseTexture(true)
+	, mMaterialBuffer(materialBuffer)
+	, mPipelineDesc{}
+	, mPipelineID(PipelineStateCache::INVALID_PIPELINE_ID)
 {
-	ASSERT(pMaterialBufferGPU != nullptr);
+	ASSERT(materialBuffer.IsValid());
+	ASSERT(mPixelShaderIndex != ShaderManager::INVALID_SHADER_INDEX);
+
+	Renderer& renderer = Renderer::GetInstance();
+
+	mPipelineDesc.rasterizer = renderer.GetRasterizerStateID(rasterizerType);
+	mPipelineDesc.sampler = renderer.GetSamplerStateID(samplerType);
+	mPipelineDesc.blend = renderer.GetBlendStateID(blendStateType);
+	mPipelineDesc.depthStencil = renderer.GetDepthStencilStateID(depthStencilType);
+
+	updatePipelineID();
 
-	mMaterialData.bUseTexture = true;
 	mMaterialData.diffuseColor = Vector3(1.f, 1.f, 1.f);
 	mMaterialData.specularColor = Vector3(1.f, 1.f, 1.f);
 }
 
-void Material::Bind(ID3D11DeviceContext& deviceContext) const
+Material::Material(const std::string& path, const Material& other, const RHI::BufferHandle materialBuffer)
+	: mMaterialData(other.mMaterialData)
+	, mPath(path)
+	, mTexturePath(other.mTexturePath)
+	, mMaterialBuffer(materialBuffer)
+	, mVertexShaderPath(other.mVertexShaderPath)
+	, mPixelShaderPath(other.mPixelShaderPath)
+	, mPixelShaderIndex(other.mPixelShaderIndex)
+	, mbUseTexture(other.mbUseTexture)
+	, mPipelineDesc(other.mPipelineDesc)
+	, mPipelineID(other.mPipelineID)
+{
+	ASSERT(materialBuffer.IsValid());
+}
+
+void Material::Bind(RHI::CommandList& commandList, const Vertex::EType eVertexType, const uint32_t shaderFeatures, RHI::TextureHandle& inOutTexture) const
 {
 	TextureManager& textureManager = TextureManager::GetInstance();
 
-	Texture* const pTexture = textureManager.GetTextureOrNull(mTexturePath);
+	// 여러 스레드에서 기록하므로 멤버 대신 복사본에 아틀라스 영역을 채움
+	CBMaterial materialData = mMaterialData;
+
+	RHI::TextureHandle texture = { 0 };
+	uint32_t textureFeatures = SHADER_FEATURE_NONE;
+
+	TextureAtlasRegion atlasRegion;
 
-	if (pTexture != nullptr)
+	if (mbUseTexture && textureManager.TryGetAtlasRegion(mTexturePath, atlasRegion, texture))
 	{
-		pTexture->Bind(deviceContext);
+		materialData.atlasRect = Vector4(atlasRegion.uvRect);
+		materialData.atlasSlice = static_cast<float>(atlasRegion.slice);
+
+		textureFeatures = SHADER_FEATURE_TEXTURED | SHADER_FEATURE_TEXTURE_ARRAY;
+	}
+	else
+	{
+		const Texture* const pTexture = textureManager.GetTextureOrNull(mTexturePath);
+
+		// 텍스처가 없으면 샘플링하지 않는 변형을 씀
+		if (pTexture != nullptr)
+		{
+			texture = pTexture->GetHandle();
+			textureFeatures = mbUseTexture ? SHADER_FEATURE_TEXTURED : SHADER_FEATURE_NONE;
+		}
+	}
+
+	if (texture.IsValid() && texture != inOutTexture)
+	{
+		commandList.SetPSTexture(0, texture);
+
+		inOutTexture = texture;
 	}
 
 	ShaderManager& shaderManager = ShaderManager::GetInstance();
 
-	ID3D11VertexShader* const pVS = shaderManager.GetVertexShaderOrNull(mVertexShaderPath);
-	ASSERT(pVS != nullptr);
+	// 양자화된 메쉬는 입력 형식이 맞는 변형을 씀
+	const RHI::VertexShaderHandle vertexShader = shaderManager.GetVertexShader(mVertexShaderPath, eVertexType);
+	ASSERT(vertexShader.IsValid());
 
-	deviceContext.VSSetShader(pVS, nullptr, 0);
+	commandList.SetVertexShader(vertexShader);
 
-	ID3D11PixelShader* const pPS = shaderManager.GetPixelShaderOrNull(mPixelShaderPath);
-	ASSERT(pPS != nullptr);
+	const uint32_t features = shaderFeatures | textureFeatures;
 
-	deviceContext.PSSetShader(pPS, nullptr, 0);
+	const RHI::PixelShaderHandle pixelShader = shaderManager.GetPixelShaderVariant(mPixelShaderIndex, features);
+	ASSERT(pixelShader.IsValid());
 
-	deviceContext.UpdateSubresource(
-		mpMaterialBufferGPU.Get(),
-		0,
-		nullptr,
-		&mMaterialData,
-		0,
-		0
-	);
+	commandList.SetPixelShader(pixelShader);
 
-	deviceContext.PSSetConstantBuffers(
-		Renderer::ConstantBufferSlot::CB_MATERIAL_SLOT,
-		1,
-		mpMaterialBufferGPU.GetAddressOf()
-	);
+	commandList.UpdateBuffer(mMaterialBuffer, &materialData, sizeof(CBMaterial));
+	commandList.SetPSConstantBuffer(Renderer::ConstantBufferSlot::CB_MATERIAL_SLOT, mMaterialBuffer);
+}
 
-	Renderer& renderer = Renderer::GetInstance();
+void Material::RequestTextureDetail(const float screenPixels) const
+{
+	if (mbUseTexture)
+	{
+		TextureManager::GetInstance().RequestTextureDetail(mTexturePath, screenPixels);
+	}
+}
+
+void Material::SetPixelShaderPath(const std::string& pixelShaderPath)
+{
+	mPixelShaderPath = pixelShaderPath;
+	mPixelShaderIndex = ShaderManager::GetInstance().GetPixelShaderIndex(pixelShaderPath);
+	ASSERT(mPixelShaderIndex != ShaderManager::INVALID_SHADER_INDEX);
+}
+
+void Material::SetRasterizerType(const ERasterizerType rasterizerType)
+{
+	mPipelineDesc.rasterizer = Renderer::GetInstance().GetRasterizerStateID(rasterizerType);
+
+	updatePipelineID();
+}
+
+void Material::SetSamplerType(const ESamplerType samplerType)
+{
+	mPipelineDesc.sampler = Renderer::GetInstance().GetSamplerStateID(samplerType);
+
+	updatePipelineID();
+}
+
+void Material::SetBlendStateType(const EBlendStateType blendStateType)
+{
+	mPipelineDesc.blend = Renderer::GetInstance().GetBlendStateID(blendStateType);
 
-	deviceContext.RSSetState(renderer.GetRasterizerState(mRasterizerType));
+	updatePipelineID();
+}
+
+void Material::SetDepthStencilType(const EDepthStencilType depthStencilType)
+{
+	mPipelineDesc.depthStencil = Renderer::GetInstance().GetDepthStencilStateID(depthStencilType);
+
+	updatePipelineID();
+}
+
+void Material::SetRasterizerDesc(const RHI::RasterizerDesc& desc)
+{
+	const PipelineStateCache::StateID id = Renderer::GetInstance().GetPipelineStateCache().GetRasterizerStateID(desc);
+
+	// 만들지 못하면 이전 상태 유지
+	if (id != PipelineStateCache::INVALID_STATE_ID)
+	{
+		mPipelineDesc.rasterizer = id;
+
+		updatePipelineID();
+	}
+}
 
-	ID3D11SamplerState* const samplerStates[] = {
-		renderer.GetSamplerState(mSamplerType)
-	};
+void Material::SetSamplerDesc(const RHI::SamplerDesc& desc)
+{
+	const PipelineStateCache::StateID id = Renderer::GetInstance().GetPipelineStateCache().GetSamplerStateID(desc);
+
+	if (id != PipelineStateCache::INVALID_STATE_ID)
+	{
+		mPipelineDesc.sampler = id;
 
-	deviceContext.PSSetSamplers(0, 1, samplerStates);
-	deviceContext.OMSetBlendState(renderer.GetBlendState(mBlendStateType), nullptr, 0xFFFFFFFF);
-	deviceContext.OMSetDepthStencilState(renderer.GetDepthStencilState(mDepthStencilType), 0);
+		updatePipelineID();
+	}
+}
+
+void Material::SetBlendDesc(const RHI::BlendDesc& desc)
+{
+	const PipelineStateCache::StateID id = Renderer::GetInstance().GetPipelineStateCache().GetBlendStateID(desc);
+
+	if (id != PipelineStateCache::INVALID_STATE_ID)
+	{
+		mPipelineDesc.blend = id;
+
+		updatePipelineID();
+	}
+}
+
+void Material::SetDepthStencilDesc(const RHI::DepthStencilDesc& desc)
+{
+	const PipelineStateCache::StateID id = Renderer::GetInstance().GetPipelineStateCache().GetDepthStencilStateID(desc);
+
+	if (id != PipelineStateCache::INVALID_STATE_ID)
+	{
+		mPipelineDesc.depthStencil = id;
+
+		updatePipelineID();
+	}
+}
+
+void Material::updatePipelineID()
+{
+	mPipelineID = Renderer::GetInstance().GetPipelineStateCache().GetPipelineID(mPipelineDesc);
+}
+
+uint64_t Material::CalculateStateHash() const
+{
+	uint64_t hash = HashString(mTexturePath.c_str());
+	hash = HashString(mVertexShaderPath.c_str(), hash);
+	hash = HashString(mPixelShaderPath.c_str(), hash);
+	hash = HashCombine(hash, static_cast<uint64_t>(mbUseTexture));
+	hash = HashCombine(hash, static_cast<uint64_t>(mPipelineID));
+
+	// 아틀라스 영역은 Bind에서 복사본에만 채우므로 항상 0
+	hash = HashBytes(&mMaterialData, sizeof(mMaterialData), hash);
+
+	return hash;
 }
 
 void Material::DrawEditorUI()
 {
-	ImGui::PushID(mPath.c_str());
+	// 편집하다 복사본으로 바뀌어도 잡고 있는 슬라이더가 풀리지 않게 경로 대신 부르는 쪽의 ID 아래에 둠
+	ImGui::PushID("Material");
 
-	ImGui::SeparatorText(UTF8_TEXT("͸"));
+	ImGui::SeparatorText(UTF8_TEXT("머터리얼"));
 
-	ImGui::Checkbox(UTF8_TEXT("ؽó "), &mMaterialData.bUseTexture);
+	ImGui::Checkbox(UTF8_TEXT("텍스처 사용"), &mbUseTexture);
 
 	ImGui::SliderFloat3(UTF8_TEXT("Ambient"), reinterpret_cast<float*>(&mMaterialData.ambientColor), 0.f, 1.f, "%.2f");
 	ImGui::SliderFloat3(UTF8_TEXT("Diffuse"), reinterpret_cast<float*>(&mMaterialData.diffuseColor), 0.f, 1.f, "%.2f");
@@ -107,10 +251,14 @@ void Material::DrawEditorUI()
 	ImGui::Text("VertexShader: %s", mVertexShaderPath.c_str());
 	ImGui::Text("PixelShader: %s", mPixelShaderPath.c_str());
 
-	ImGui::Text("Rasterizer: %s", GetRasterizerTypeName(mRasterizerType));
-	ImGui::Text("Sampler: %s", GetSamplerTypeName(mSamplerType));
-	ImGui::Text("Blend State: %s", GetBlendTypeName(mBlendStateType));
-	ImGui::Text("Depth Stencil: %s", GetDepthStencilTypeName(mDepthStencilType));
+	ImGui::Text(
+		"Pipeline: %u (RS %u / SS %u / BS %u / DS %u)",
+		mPipelineID,
+		mPipelineDesc.rasterizer,
+		mPipelineDesc.sampler,
+		mPipelineDesc.blend,
+		mPipelineDesc.depthStencil
+	);
 
 	ImGui::PopID();
 }
@@ -2,19 +2,25 @@
 
 #include <string>
 #include <vector>
-#include <d3d11.h>
 
-#include "Core/ComHelper.h"
 #include "Core/MathHelper.h"
 #include "Renderer/PipelineStateType.h"
+#include "Renderer/PipelineStateCache.h"
+#include "Renderer/RHI/RHITypes.h"
+#include "Renderer/Vertex.h"
 #include "UI/IEditorUIDrawable.h"
 
 class Texture;
 
+namespace RHI
+{
+	class CommandList;
+}
+
 class Material final : public IEditorUIDrawable
 {
 public:
-	// ü ؼ ʱȭ  
+	// 구조체에 대해서 초기화 경고 끄기
 #pragma warning(push)
 #pragma warning(disable : 26495)
 	struct CBMaterial
@@ -26,10 +32,19 @@ public:
 		Vector3 specularColor;
 		float dummy1;
 
-		bool bUseTexture;
-		uint8_t padding[16 - sizeof(bool)];
+		// 아틀라스 영역 u, v 오프셋과 크기, 아틀라스에 없으면 쓰지 않음
+		Vector4 atlasRect;
+		float atlasSlice;
+		Vector3 dummy2;
 	};
 	static_assert(sizeof(CBMaterial) % 16 == 0);
+
+	// 편집 UI가 바꾸는 값, 같이 쓰는 Material을 편집했을 때 되돌리는 데 씀
+	struct EditorState
+	{
+		CBMaterial materialData;
+		bool bUseTexture;
+	};
 #pragma warning(pop)
 
 public:
@@ -38,53 +53,84 @@ public:
 		const std::string& texturePath,
 		const std::string& vertexShaderPath,
 		const std::string& pixelShaderPath,
-		ComPtr<ID3D11Buffer>& pMaterialBufferGPU,
+		const RHI::BufferHandle materialBuffer,
 		const ERasterizerType rasterizerType,
 		const ESamplerType samplerType,
 		const EBlendStateType blendStateType,
 		const EDepthStencilType depthStencilType
 	);
+
+	// other의 지금 상태를 그대로 가진 복사본, 상수 버퍼만 따로 씀
+	Material(const std::string& path, const Material& other, const RHI::BufferHandle materialBuffer);
 	~Material() = default;
 
-	void Bind(ID3D11DeviceContext& deviceContext) const;
+	// shaderFeatures는 렌더러가 정한 조명 관련 비트, 텍스처 비트는 머터리얼이 더함
+	// inOutTexture와 같은 텍스처면 다시 바인딩하지 않음, 같은 아틀라스를 쓰는 그리기끼리 공유됨
+	void Bind(RHI::CommandList& commandList, const Vertex::EType eVertexType, const uint32_t shaderFeatures, RHI::TextureHandle& inOutTexture) const;
 
 	virtual void DrawEditorUI() override;
 
-	void SetTexturePath(const std::string& texturePath)
+	inline RHI::BufferHandle GetMaterialBuffer() const
 	{
-		mTexturePath = texturePath;
+		return mMaterialBuffer;
 	}
 
-	void SetVertexShaderPath(const std::string& vertexShaderPath)
+	// 렌더러가 이전 그리기와 비교해서 상태 바인딩을 건너뜀
+	inline PipelineStateCache::PipelineID GetPipelineID() const
 	{
-		mVertexShaderPath = vertexShaderPath;
+		return mPipelineID;
 	}
 
-	void SetPixelShaderPath(const std::string& pixelShaderPath)
+	inline const PipelineStateCache::PipelineDesc& GetPipelineDesc() const
 	{
-		mPixelShaderPath = pixelShaderPath;
+		return mPipelineDesc;
 	}
 
-	void SetRasterizerType(const ERasterizerType rasterizerType)
+	// 경로, 파이프라인, 상수 값을 모두 넣은 해시, 편집되면 값이 바뀜
+	uint64_t CalculateStateHash() const;
+
+	inline EditorState GetEditorState() const
 	{
-		mRasterizerType = rasterizerType;
+		return EditorState{ mMaterialData, mbUseTexture };
 	}
 
-	void SetSamplerType(const ESamplerType samplerType)
+	inline void SetEditorState(const EditorState& state)
 	{
-		mSamplerType = samplerType;
+		mMaterialData = state.materialData;
+		mbUseTexture = state.bUseTexture;
 	}
 
-	void SetBlendStateType(const EBlendStateType blendStateType)
+	inline const std::string& GetTexturePath() const
 	{
-		mBlendStateType = blendStateType;
+		return mTexturePath;
 	}
 
-	void SetDepthStencilType(const EDepthStencilType depthStencilType)
+	// 컬링에서 구한 화면 크기로 텍스처 밉을 요청
+	void RequestTextureDetail(const float screenPixels) const;
+
+	void SetTexturePath(const std::string& texturePath)
 	{
-		mDepthStencilType = depthStencilType;
+		mTexturePath = texturePath;
+	}
+
+	void SetVertexShaderPath(const std::string& vertexShaderPath)
+	{
+		mVertexShaderPath = vertexShaderPath;
 	}
 
+	void SetPixelShaderPath(const std::string& pixelShaderPath);
+
+	void SetRasterizerType(const ERasterizerType rasterizerType);
+	void SetSamplerType(const ESamplerType samplerType);
+	void SetBlendStateType(const EBlendStateType blendStateType);
+	void SetDepthStencilType(const EDepthStencilType depthStencilType);
+
+	// 기본 열거형에 없는 상태, 처음 쓰일 때 만들어짐
+	void SetRasterizerDesc(const RHI::RasterizerDesc& desc);
+	void SetSamplerDesc(const RHI::SamplerDesc& desc);
+	void SetBlendDesc(const RHI::BlendDesc& desc);
+	void SetDepthStencilDesc(const RHI::DepthStencilDesc& desc);
+
 private:
 	CBMaterial mMaterialData;
 
@@ -92,15 +138,19 @@ private:
 
 	std::string mTexturePath;
 
-	ComPtr<ID3D11Buffer> mpMaterialBufferGPU;
+	RHI::BufferHandle mMaterialBuffer;
 
 	std::string mVertexShaderPath;
 	std::string mPixelShaderPath;
+	uint32_t mPixelShaderIndex;
 
-	ERasterizerType mRasterizerType;
-	ESamplerType mSamplerType;
-	EBlendStateType mBlendStateType;
-	EDepthStencilType mDepthStencilType;
+	bool mbUseTexture;
+
+	PipelineStateCache::PipelineDesc mPipelineDesc;
+	PipelineStateCache::PipelineID mPipelineID;
+
+private:
+	void updatePipelineID();
 
 private:
 	Material(const Material& other) = delete;
@@ -1,22 +1,40 @@
 #include "MaterialManager.h"
 
 #include "Material.h"
+#include "TextureManager.h"
 #include "Core/LogHelper.h"
+#include "Core/HashHelper.h"
 #include "UI/ImGuiHeaders.h"
 #include "Core/CommonDefs.h"
 
 enum
 {
-	DEFAULT_BUFFER_SIZE = 32
+	DEFAULT_BUFFER_SIZE = 32,
+
+	DEFAULT_MAX_UNUSED_COUNT = 64,
+	MAX_UNUSED_COUNT_LIMIT = 1024
 };
 
 MaterialManager* MaterialManager::spInstance = nullptr;
 
-MaterialManager::MaterialManager(ID3D11Device& device)
+MaterialManager::MaterialManager(RHI::Device& device)
 	: mDevice(device)
 	, mMaterialMap()
+	, mMaterialsByContent()
+	, mPathRefCounts()
+	, mMaterialShares()
+	, mDedupLookupCount(0)
+	, mDedupHitCount(0)
+	, mDedupSavedBytes(0)
+	, mDetachCount(0)
+	, mUnusedMaterials()
+	, mMaxUnusedCount(DEFAULT_MAX_UNUSED_COUNT)
+	, mEvictCount(0)
 {
 	mMaterialMap.reserve(DEFAULT_BUFFER_SIZE);
+	mMaterialsByContent.reserve(DEFAULT_BUFFER_SIZE);
+	mPathRefCounts.reserve(DEFAULT_BUFFER_SIZE);
+	mMaterialShares.reserve(DEFAULT_BUFFER_SIZE);
 
 	CreateMaterial(
 		"Default",
@@ -46,9 +64,12 @@ MaterialManager::MaterialManager(ID3D11Device& device)
 
 MaterialManager::~MaterialManager()
 {
-	for (std::pair<const std::string, Material*>& pair : mMaterialMap)
+	// 경로 여러 개가 한 Material을 가리킬 수 있으므로 Material 기준으로 해제
+	for (std::pair<Material* const, MaterialShare>& pair : mMaterialShares)
 	{
-		delete pair.second;
+		mDevice.DestroyBuffer(pair.first->GetMaterialBuffer());
+
+		delete pair.first;
 	}
 }
 
@@ -69,43 +90,82 @@ Material* MaterialManager::CreateMaterial(
 
 	if (iter != mMaterialMap.end())
 	{
+		++mPathRefCounts[path];
+
 		return iter->second;
 	}
 
 #undef MAP_ITER
 
-	// Material constant buffer 
-	ComPtr<ID3D11Buffer> materialBufferGPU;
-	{
-		D3D11_BUFFER_DESC bufferDesc;
-		ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+	uint64_t contentHash = HashString(texturePath.c_str());
+	contentHash = HashString(vertexShaderPath.c_str(), contentHash);
+	contentHash = HashString(pixelShaderPath.c_str(), contentHash);
+	contentHash = HashCombine(contentHash, static_cast<uint64_t>(rasterizerType));
+	contentHash = HashCombine(contentHash, static_cast<uint64_t>(samplerType));
+	contentHash = HashCombine(contentHash, static_cast<uint64_t>(blendStateType));
+	contentHash = HashCombine(contentHash, static_cast<uint64_t>(depthStencilType));
+
+	++mDedupLookupCount;
+
+#define CONTENT_MAP_ITER std::unordered_map<uint64_t, Material*>::const_iterator
 
-		bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		bufferDesc.ByteWidth = sizeof(Material::CBMaterial);
-		bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	CONTENT_MAP_ITER contentIter = mMaterialsByContent.find(contentHash);
 
-		HRESULT hr = mDevice.CreateBuffer(&bufferDesc, nullptr, materialBufferGPU.GetAddressOf());
+	if (contentIter != mMaterialsByContent.end())
+	{
+		Material* const pMaterial = contentIter->second;
+
+		MaterialShare& share = mMaterialShares[pMaterial];
 
-		if (FAILED(hr))
+		// 편집된 Material은 같은 인자로 만든 것과 달라졌으므로 새로 만듦
+		if (share.stateHash == pMaterial->CalculateStateHash())
 		{
-			LOG_SYSTEM_ERROR(hr, "CreateBuffer - Material CB");
-			ASSERT(false);
+			// 참조가 없어 LRU에 있던 것이면 꺼냄
+			if (share.refCount == 0)
+			{
+				mUnusedMaterials.erase(share.lruIter);
+			}
+
+			++share.refCount;
+
+			++mDedupHitCount;
+			mDedupSavedBytes += sizeof(Material) + sizeof(Material::CBMaterial);
+
+			mMaterialMap.insert(std::make_pair(path, pMaterial));
+			mPathRefCounts.insert(std::make_pair(path, 1));
+
+			return pMaterial;
 		}
 	}
 
+#undef CONTENT_MAP_ITER
+
+	const RHI::BufferHandle materialBuffer = createMaterialBuffer();
+
 	Material* const pMaterial = new Material(
 		path,
 		texturePath,
 		vertexShaderPath,
 		pixelShaderPath,
-		materialBufferGPU,
+		materialBuffer,
 		rasterizerType,
 		samplerType,
 		blendStateType,
 		depthStencilType
 	);
 
+	// 텍스처는 Material이 살아 있는 동안 붙잡아 둠
+	if (!texturePath.empty())
+	{
+		TextureManager::GetInstance().LoadTexture(texturePath);
+	}
+
 	mMaterialMap.insert(std::make_pair(path, pMaterial));
+	mPathRefCounts.insert(std::make_pair(path, 1));
+	mMaterialShares.insert(std::make_pair(pMaterial, MaterialShare{ contentHash, pMaterial->CalculateStateHash(), texturePath, 1, mUnusedMaterials.end() }));
+
+	// 편집된 이전 것은 경로로만 찾을 수 있게 두고 새 것으로 바꿈
+	mMaterialsByContent[contentHash] = pMaterial;
 
 	return pMaterial;
 
@@ -147,7 +207,7 @@ Material* MaterialManager::GetMaterialOrNull(const std::string& path) const
 	return nullptr;
 }
 
-void MaterialManager::UnloadMaterial(const std::string& path)
+void MaterialManager::ReleaseMaterial(const std::string& path)
 {
 #define MAP_ITER std::unordered_map<std::string, Material*>::iterator
 
@@ -155,31 +215,186 @@ void MaterialManager::UnloadMaterial(const std::string& path)
 
 	if (iter != mMaterialMap.end())
 	{
-		delete iter->second;
+		uint32_t& pathRefCount = mPathRefCounts[path];
+		ASSERT(pathRefCount > 0);
+
+		--pathRefCount;
+
+		// 같은 경로로 얻은 다른 참조가 남아 있음
+		if (pathRefCount > 0)
+		{
+			return;
+		}
+
+		mPathRefCounts.erase(path);
+
+		Material* const pMaterial = iter->second;
 
 		mMaterialMap.erase(iter);
+
+		MaterialShare& share = mMaterialShares[pMaterial];
+		ASSERT(share.refCount > 0);
+
+		--share.refCount;
+
+		if (share.refCount == 0)
+		{
+			share.lruIter = mUnusedMaterials.insert(mUnusedMaterials.end(), pMaterial);
+		}
 	}
 
 #undef MAP_ITER
 }
 
+Material* MaterialManager::DetachMaterial(const std::string& path, Material* const pMaterial)
+{
+	ASSERT(pMaterial != nullptr);
+
+#define MAP_ITER std::unordered_map<std::string, Material*>::const_iterator
+
+	MAP_ITER iter = mMaterialMap.find(path);
+
+	const bool bRegistered = iter != mMaterialMap.end() && iter->second == pMaterial;
+
+#undef MAP_ITER
+
+	if (bRegistered && mMaterialShares[pMaterial].refCount == 1)
+	{
+		return pMaterial;
+	}
+
+	Material* const pCopy = new Material(path, *pMaterial, createMaterialBuffer());
+
+	// 복사본도 자기 텍스처 참조를 잡아서 원본과 따로 해제됨
+	const std::string& texturePath = pCopy->GetTexturePath();
+
+	if (!texturePath.empty())
+	{
+		TextureManager::GetInstance().LoadTexture(texturePath);
+	}
+
+	// path가 가리키던 것을 놓고 잡혀 있던 참조 수는 복사본으로 옮김, 다른 경로가 같이 쓰므로 LRU로 가지 않음
+	const uint32_t pathRefCount = bRegistered ? mPathRefCounts[path] : 1;
+
+	if (bRegistered)
+	{
+		mPathRefCounts[path] = 1;
+
+		ReleaseMaterial(path);
+	}
+
+	ASSERT(mMaterialMap.find(path) == mMaterialMap.end());
+
+	// 내용 표에는 넣지 않아서 같은 인자로 새로 만들 때 편집된 복사본과 합쳐지지 않음
+	const uint64_t contentHash = bRegistered ? mMaterialShares[pMaterial].contentHash : 0;
+
+	mMaterialMap.insert(std::make_pair(path, pCopy));
+	mPathRefCounts.insert(std::make_pair(path, pathRefCount));
+	mMaterialShares.insert(std::make_pair(pCopy, MaterialShare{ contentHash, pCopy->CalculateStateHash(), texturePath, 1, mUnusedMaterials.end() }));
+
+	++mDetachCount;
+
+	return pCopy;
+}
+
+void MaterialManager::UpdateResidency()
+{
+	while (mUnusedMaterials.size() > static_cast<size_t>(mMaxUnusedCount))
+	{
+		evictMaterial(mUnusedMaterials.front());
+	}
+}
+
 void MaterialManager::DrawEditorUI()
 {
 	ImGui::PushID("MaterialManager");
 
-	ImGui::Text(UTF8_TEXT("Ƽ "));
+	ImGui::Text(UTF8_TEXT("머티리얼 목록"));
 
 	for (const std::pair<const std::string, Material*>& pair : mMaterialMap)
 	{
 		ImGui::Text("%s", pair.first.c_str());
 	}
 
+	ImGui::SeparatorText(UTF8_TEXT("내용 중복 제거"));
+
+	ImGui::Text("Paths: %u / Unique Materials: %u", static_cast<uint32_t>(mMaterialMap.size()), static_cast<uint32_t>(mMaterialShares.size()));
+	ImGui::Text("Hits: %u / %u (%.1f%%)", mDedupHitCount, mDedupLookupCount, mDedupLookupCount > 0 ? 100.f * mDedupHitCount / mDedupLookupCount : 0.f);
+	ImGui::Text("Saved: %.1f KB", static_cast<float>(mDedupSavedBytes) / 1024.f);
+	ImGui::Text("Detached on Edit: %u", mDetachCount);
+
+	ImGui::SeparatorText(UTF8_TEXT("상주 메모리"));
+
+	ImGui::SliderInt("Max Unused", &mMaxUnusedCount, 0, MAX_UNUSED_COUNT_LIMIT);
+	ImGui::Text("Resident: %.1f KB", static_cast<float>(mMaterialShares.size() * (sizeof(Material) + sizeof(Material::CBMaterial))) / 1024.f);
+	ImGui::Text("Referenced: %u / Unused (LRU): %u / Evicted: %u",
+		static_cast<uint32_t>(mMaterialShares.size() - mUnusedMaterials.size()),
+		static_cast<uint32_t>(mUnusedMaterials.size()),
+		mEvictCount
+	);
+
 	ImGui::PopID();
 }
 
-void MaterialManager::Initialize(ID3D11Device& device)
+void MaterialManager::Initialize(RHI::Device& device)
 {
 	ASSERT(spInstance == nullptr);
 
 	spInstance = new MaterialManager(device);
+}
+
+RHI::BufferHandle MaterialManager::createMaterialBuffer()
+{
+	RHI::BufferDesc bufferDesc = {};
+	bufferDesc.usage = RHI::EUsage::DEFAULT;
+	bufferDesc.byteWidth = sizeof(Material::CBMaterial);
+	bufferDesc.bindFlags = RHI::BIND_CONSTANT_BUFFER;
+
+	const RHI::BufferHandle materialBuffer = mDevice.CreateBuffer(bufferDesc, nullptr);
+
+	if (!materialBuffer.IsValid())
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "CreateBuffer - Material CB");
+		ASSERT(false);
+	}
+
+	return materialBuffer;
+}
+
+void MaterialManager::evictMaterial(Material* const pMaterial)
+{
+#define SHARE_MAP_ITER std::unordered_map<Material*, MaterialShare>::iterator
+
+	SHARE_MAP_ITER shareIter = mMaterialShares.find(pMaterial);
+	ASSERT(shareIter != mMaterialShares.end());
+	ASSERT(shareIter->second.refCount == 0);
+
+	mUnusedMaterials.erase(shareIter->second.lruIter);
+
+	if (!shareIter->second.texturePath.empty())
+	{
+		TextureManager::GetInstance().ReleaseTexture(shareIter->second.texturePath);
+	}
+
+#define CONTENT_MAP_ITER std::unordered_map<uint64_t, Material*>::iterator
+
+	CONTENT_MAP_ITER contentIter = mMaterialsByContent.find(shareIter->second.contentHash);
+
+	// 편집되어 자리를 넘겨준 Material이면 내용 표에 없음
+	if (contentIter != mMaterialsByContent.end() && contentIter->second == pMaterial)
+	{
+		mMaterialsByContent.erase(contentIter);
+	}
+
+#undef CONTENT_MAP_ITER
+
+	mMaterialShares.erase(shareIter);
+
+#undef SHARE_MAP_ITER
+
+	mDevice.DestroyBuffer(pMaterial->GetMaterialBuffer());
+
+	delete pMaterial;
+
+	++mEvictCount;
 }
\ No newline at end of file
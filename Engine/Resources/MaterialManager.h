@@ -2,18 +2,22 @@
 
 #include <unordered_map>
 #include <string>
-
-#include <d3d11.h>
+#include <list>
 
 #include "Core/Assert.h"
 #include "UI/IEditorUIDrawable.h"
 #include "Renderer/PipelineStateType.h"
+#include "Renderer/RHI/RHIDevice.h"
 
 class Material;
 
+// CreateMaterial이 돌려준 포인터마다 경로의 참조가 하나, ReleaseMaterial로 하나씩 놓음
+// Material은 만들 때 텍스처 참조를 얻고 해제될 때 놓음
+// 참조가 없는 Material은 LRU에 두었다가 개수 예산을 넘으면 오래된 것부터 해제
 class MaterialManager final : public IEditorUIDrawable
 {
 public:
+	// 이미 있는 경로여도 참조를 하나 잡음, 부른 수만큼 ReleaseMaterial을 불러야 함
 	Material* CreateMaterial(
 		const std::string& path,
 		const std::string& texturePath,
@@ -32,12 +36,23 @@ public:
 		const std::string& pixelShaderPath
 	);
 	Material* GetMaterialOrNull(const std::string& path) const;
-	void UnloadMaterial(const std::string& path);
+
+	// 경로의 참조가 모두 놓이면 경로를 지우고, 다른 경로가 같이 쓰지 않으면 LRU로 옮김
+	void ReleaseMaterial(const std::string& path);
+
+	// 편집하기 직전에 부름, pMaterial이 path만의 것이면 그대로 돌려줌
+	// 다른 경로가 같이 쓰거나 path로 등록된 것이 아니면 지금 상태의 복사본을 path에 등록하고 돌려줌
+	// path의 참조는 그대로 복사본으로 옮겨짐, 등록된 것이 아니었으면 참조 하나로 등록됨
+	Material* DetachMaterial(const std::string& path, Material* const pMaterial);
+
+	// 프레임 경계에서 호출, 참조 없는 Material이 예산보다 많으면 오래된 것부터 해제
+	// GPU 메모리는 상수 버퍼뿐이라 개수로 제한하고 텍스처는 TextureManager 예산을 따름
+	void UpdateResidency();
 
 	virtual void DrawEditorUI() override;
 
 	// static
-	static void Initialize(ID3D11Device& device);
+	static void Initialize(RHI::Device& device);
 
 	static MaterialManager& GetInstance()
 	{
@@ -54,14 +69,55 @@ public:
 private:
 	static MaterialManager* spInstance;
 
-	ID3D11Device& mDevice;
+	RHI::Device& mDevice;
 
+	// 만들 때의 인자가 같고 그 뒤로 편집되지 않았으면 여러 경로가 같은 Material을 가리킴
+	// 편집하는 쪽이 DetachMaterial로 떼어 내서 같이 쓰는 다른 모델에는 보이지 않음
 	std::unordered_map<std::string, Material*> mMaterialMap;
+	std::unordered_map<uint64_t, Material*> mMaterialsByContent;
+
+	// 경로마다 CreateMaterial 수 - ReleaseMaterial 수, 0이 되면 mMaterialMap에서 지움
+	std::unordered_map<std::string, uint32_t> mPathRefCounts;
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct MaterialShare
+	{
+		// 만들 때의 인자 해시, mMaterialsByContent의 키
+		uint64_t contentHash;
+
+		// 만든 직후의 CalculateStateHash, 달라졌으면 편집된 것
+		uint64_t stateHash;
+
+		// 만들 때 얻은 텍스처 참조, 없으면 빈 문자열
+		std::string texturePath;
+
+		// 이 Material을 가리키는 경로 수, 0이면 lruIter가 유효
+		uint32_t refCount;
+		std::list<Material*>::iterator lruIter;
+	};
+#pragma warning(pop)
+
+	std::unordered_map<Material*, MaterialShare> mMaterialShares;
+
+	uint32_t mDedupLookupCount;
+	uint32_t mDedupHitCount;
+	uint64_t mDedupSavedBytes;
+	uint32_t mDetachCount;
+
+	// residency, 앞쪽이 가장 오래전에 놓인 것
+	std::list<Material*> mUnusedMaterials;
+	int mMaxUnusedCount;
+	uint32_t mEvictCount;
 
 private:
-	MaterialManager(ID3D11Device& device);
+	MaterialManager(RHI::Device& device);
 	~MaterialManager();
 
+	RHI::BufferHandle createMaterialBuffer();
+
+	void evictMaterial(Material* const pMaterial);
+
 private:
 	MaterialManager(const MaterialManager& other) = delete;
 	MaterialManager& operator=(const MaterialManager& other) = delete;
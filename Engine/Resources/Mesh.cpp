@@ -1,72 +1,155 @@
 #include "Mesh.h"
 
 #include "ShaderManager.h"
+#include "Renderer/RHI/RHICommandList.h"
 #include "UI/ImGuiHeaders.h"
 #include "Core/CommonDefs.h"
 
 Mesh::Mesh(
 	const std::string& path,
 	const Vertex::EType eVertexType,
-	ComPtr<ID3D11Buffer>& vertexBufferPtr,
+	const RHI::BufferHandle vertexBuffer,
 	const UINT vertexCount,
 	const UINT vertexStride,
-	ComPtr<ID3D11Buffer>& indexBufferPtr,
+	const RHI::BufferHandle positionBuffer,
+	const UINT baseVertex,
+	const RHI::BufferHandle indexBuffer,
 	const UINT indexCount,
-	const UINT indexStride
+	const UINT indexStride,
+	const UINT startIndex
 )
 	: mPath(path)
 	, mVertexType(eVertexType)
-	, mpVertexBuffer(vertexBufferPtr)
+	, mVertexBuffer(vertexBuffer)
 	, mVertexCount(vertexCount)
 	, mVertexStride(vertexStride)
-	, mpIndexBuffer(indexBufferPtr)
+	, mPositionBuffer(positionBuffer)
+	, mBaseVertex(baseVertex)
+	, mIndexBuffer(indexBuffer)
 	, mIndexCount(indexCount)
 	, mIndexStride(indexStride)
-	, mPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST)
+	, mStartIndex(startIndex)
+	, mPrimitiveTopology(RHI::EPrimitiveTopology::TRIANGLE_LIST)
+	, mPositionOffset(Vector3::Zero)
+	, mPositionScale(Vector3::One)
 {
-	ASSERT(vertexBufferPtr != nullptr);
-	ASSERT(indexBufferPtr != nullptr);
+	ASSERT(vertexBuffer.IsValid());
+	ASSERT(indexBuffer.IsValid());
+	ASSERT(positionBuffer.IsValid() == (eVertexType == Vertex::EType::POS_NORMAL_UV_SPLIT));
 }
 
-void Mesh::Bind(ID3D11DeviceContext& deviceContext) const
+void Mesh::Bind(RHI::CommandList& commandList, BindState& inOutState) const
 {
-	const UINT offset = 0;
+	ShaderManager& shaderManager = ShaderManager::GetInstance();
+
+	const RHI::InputLayoutHandle inputLayout = shaderManager.GetInputLayout(mVertexType);
+	ASSERT(inputLayout.IsValid());
+
+	if (inputLayout != inOutState.inputLayout)
+	{
+		commandList.SetInputLayout(inputLayout);
+
+		inOutState.inputLayout = inputLayout;
+	}
+
+	if (mPositionBuffer.IsValid())
+	{
+		if (mPositionBuffer != inOutState.vertexBuffers[Vertex::POSITION_STREAM_SLOT])
+		{
+			commandList.SetVertexBuffer(Vertex::POSITION_STREAM_SLOT, mPositionBuffer, sizeof(Vertex::Pos), 0);
+
+			inOutState.vertexBuffers[Vertex::POSITION_STREAM_SLOT] = mPositionBuffer;
+		}
+
+		if (mVertexBuffer != inOutState.vertexBuffers[Vertex::ATTRIBUTE_STREAM_SLOT])
+		{
+			commandList.SetVertexBuffer(Vertex::ATTRIBUTE_STREAM_SLOT, mVertexBuffer, mVertexStride, 0);
+
+			inOutState.vertexBuffers[Vertex::ATTRIBUTE_STREAM_SLOT] = mVertexBuffer;
+		}
+	}
+	else if (mVertexBuffer != inOutState.vertexBuffers[0])
+	{
+		commandList.SetVertexBuffer(0, mVertexBuffer, mVertexStride, 0);
+
+		inOutState.vertexBuffers[0] = mVertexBuffer;
+	}
+
+	bindIndexBuffer(commandList, inOutState);
+}
+
+void Mesh::BindPositionOnly(RHI::CommandList& commandList, BindState& inOutState) const
+{
+	if (!mPositionBuffer.IsValid())
+	{
+		Bind(commandList, inOutState);
+
+		return;
+	}
 
 	ShaderManager& shaderManager = ShaderManager::GetInstance();
 
-	ID3D11InputLayout* const pInputLayout = shaderManager.GetInputLayoutOrNull(mVertexType);
-	ASSERT(pInputLayout != nullptr);
+	const RHI::InputLayoutHandle inputLayout = shaderManager.GetInputLayout(Vertex::EType::POS);
+	ASSERT(inputLayout.IsValid());
+
+	if (inputLayout != inOutState.inputLayout)
+	{
+		commandList.SetInputLayout(inputLayout);
+
+		inOutState.inputLayout = inputLayout;
+	}
+
+	if (mPositionBuffer != inOutState.vertexBuffers[Vertex::POSITION_STREAM_SLOT])
+	{
+		commandList.SetVertexBuffer(Vertex::POSITION_STREAM_SLOT, mPositionBuffer, sizeof(Vertex::Pos), 0);
 
-	deviceContext.IASetInputLayout(pInputLayout);
-	deviceContext.IASetVertexBuffers(0, 1, mpVertexBuffer.GetAddressOf(), &mVertexStride, &offset);
+		inOutState.vertexBuffers[Vertex::POSITION_STREAM_SLOT] = mPositionBuffer;
+	}
+
+	bindIndexBuffer(commandList, inOutState);
+}
+
+void Mesh::bindIndexBuffer(RHI::CommandList& commandList, BindState& inOutState) const
+{
+	// 인덱스 크기마다 풀이 따로라서 버퍼가 같으면 형식과 토폴로지도 같음
+	if (mIndexBuffer == inOutState.indexBuffer)
+	{
+		return;
+	}
 
 	if (mIndexStride == sizeof(int16_t))
 	{
-		deviceContext.IASetIndexBuffer(mpIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0);
+		commandList.SetIndexBuffer(mIndexBuffer, RHI::EFormat::R16_UINT, 0);
 	}
 	else
 	{
-		deviceContext.IASetIndexBuffer(mpIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+		commandList.SetIndexBuffer(mIndexBuffer, RHI::EFormat::R32_UINT, 0);
 	}
 
-	deviceContext.IASetPrimitiveTopology(mPrimitiveTopology);
+	commandList.SetPrimitiveTopology(mPrimitiveTopology);
+
+	inOutState.indexBuffer = mIndexBuffer;
 }
 
 void Mesh::DrawEditorUI()
 {
 	ImGui::PushID(mPath.c_str());
 
-	ImGui::SeparatorText(UTF8_TEXT("޽"));
+	ImGui::SeparatorText(UTF8_TEXT("메쉬"));
 
 	ImGui::Text("Path: %s", mPath.c_str());
 	ImGui::Text("Vertex Type: %s", Vertex::GetTypeName(mVertexType));
 	ImGui::Text("Vertex Count: %u", mVertexCount);
 	ImGui::Text("Index Count: %u", mIndexCount);
+	ImGui::Text("Vertex Bytes: %u (Position Only: %u)", GetVertexBytes(), GetPositionOnlyBytes());
+	ImGui::Text("Position Stream: %s", mPositionBuffer.IsValid() ? "Split" : "Interleaved");
+	ImGui::Text("Index Bytes: %u", mIndexCount * mIndexStride);
+	ImGui::Text("Base Vertex: %u / Start Index: %u", mBaseVertex, mStartIndex);
 
 	const char* topologyName = "Unknown";
 	switch (mPrimitiveTopology)
 	{
-	case D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST:
+	case RHI::EPrimitiveTopology::TRIANGLE_LIST:
 		topologyName = "Triangle List";
 		break;
 
@@ -1,30 +1,49 @@
 #pragma once
 
 #include <string>
-#include <d3d11.h>
 
 #include "Core/MathHelper.h"
-#include "Core/ComHelper.h"
 #include "Core/Assert.h"
 #include "Renderer/Vertex.h"
+#include "Renderer/RHI/RHITypes.h"
 #include "UI/IEditorUIDrawable.h"
 
+namespace RHI
+{
+	class CommandList;
+}
+
 class Mesh final : public IEditorUIDrawable
 {
 public:
+	// 한 명령 목록 안에서 마지막으로 바인딩한 지오메트리
+	// 공유 풀에서 나눠 받은 메쉬끼리는 버퍼가 같아서 다시 바인딩하지 않음
+	struct BindState
+	{
+		RHI::InputLayoutHandle inputLayout;
+		RHI::BufferHandle vertexBuffers[2];
+		RHI::BufferHandle indexBuffer;
+	};
+
 	Mesh(
 		const std::string& path,
 		const Vertex::EType eVertexType,
-		ComPtr<ID3D11Buffer>& vertexBufferPtr,
+		const RHI::BufferHandle vertexBuffer,
 		const UINT vertexCount,
 		const UINT vertexStride,
-		ComPtr<ID3D11Buffer>& indexBufferPtr,
+		const RHI::BufferHandle positionBuffer,
+		const UINT baseVertex,
+		const RHI::BufferHandle indexBuffer,
 		const UINT indexCount,
-		const UINT indexStride
+		const UINT indexStride,
+		const UINT startIndex
 	);
 	~Mesh() = default;
 
-	void Bind(ID3D11DeviceContext& deviceContext) const;
+	void Bind(RHI::CommandList& commandList, BindState& inOutState) const;
+
+	// 깊이만 쓰는 패스용, 위치 스트림이 없으면 Bind와 같음
+	void BindPositionOnly(RHI::CommandList& commandList, BindState& inOutState) const;
 
 	virtual void DrawEditorUI() override;
 
@@ -38,20 +57,101 @@ public:
 		return mIndexCount;
 	}
 
+	// 공유 버퍼 안의 위치, 조각 모음으로 옮겨지면 MeshManager가 고침
+	inline UINT GetBaseVertex() const
+	{
+		return mBaseVertex;
+	}
+
+	inline UINT GetStartIndex() const
+	{
+		return mStartIndex;
+	}
+
+	inline void SetBaseVertex(const UINT baseVertex)
+	{
+		mBaseVertex = baseVertex;
+	}
+
+	inline void SetStartIndex(const UINT startIndex)
+	{
+		mStartIndex = startIndex;
+	}
+
+	inline Vertex::EType GetVertexType() const
+	{
+		return mVertexType;
+	}
+
+	// 양자화된 위치 = 정점 값 * scale + offset
+	inline void SetPositionDequantization(const Vector3& offset, const Vector3& scale)
+	{
+		mPositionOffset = offset;
+		mPositionScale = scale;
+	}
+
+	inline const Vector3& GetPositionOffset() const
+	{
+		return mPositionOffset;
+	}
+
+	inline const Vector3& GetPositionScale() const
+	{
+		return mPositionScale;
+	}
+
+	inline RHI::BufferHandle GetVertexBuffer() const
+	{
+		return mVertexBuffer;
+	}
+
+	inline RHI::BufferHandle GetIndexBuffer() const
+	{
+		return mIndexBuffer;
+	}
+
+	// 위치 스트림을 따로 두지 않았으면 무효
+	inline RHI::BufferHandle GetPositionBuffer() const
+	{
+		return mPositionBuffer;
+	}
+
+	inline UINT GetVertexBytes() const
+	{
+		return mVertexCount * (mVertexStride + (mPositionBuffer.IsValid() ? static_cast<UINT>(sizeof(Vertex::Pos)) : 0));
+	}
+
+	// BindPositionOnly로 그릴 때 읽는 정점 크기
+	inline UINT GetPositionOnlyBytes() const
+	{
+		return mPositionBuffer.IsValid() ? mVertexCount * static_cast<UINT>(sizeof(Vertex::Pos)) : GetVertexBytes();
+	}
+
 private:
 	std::string mPath;
 
 	Vertex::EType mVertexType;
 
-	ComPtr<ID3D11Buffer> mpVertexBuffer;
+	// 위치 스트림을 따로 두면 mVertexBuffer에는 나머지 속성만 있음
+	RHI::BufferHandle mVertexBuffer;
 	UINT mVertexCount;
 	UINT mVertexStride;
 
-	ComPtr<ID3D11Buffer> mpIndexBuffer;
+	RHI::BufferHandle mPositionBuffer;
+	UINT mBaseVertex;
+
+	RHI::BufferHandle mIndexBuffer;
 	UINT mIndexCount;
 	UINT mIndexStride;
+	UINT mStartIndex;
 
-	D3D11_PRIMITIVE_TOPOLOGY mPrimitiveTopology;
+	RHI::EPrimitiveTopology mPrimitiveTopology;
+
+	Vector3 mPositionOffset;
+	Vector3 mPositionScale;
+
+private:
+	void bindIndexBuffer(RHI::CommandList& commandList, BindState& inOutState) const;
 
 private:
 	Mesh(const Mesh& other) = delete;
@@ -4,27 +4,70 @@
 #include "Shape.h"
 #include "Core/LogHelper.h"
 #include "Core/CommonDefs.h"
+#include "Core/HashHelper.h"
 #include "UI/ImGuiHeaders.h"
 
 enum
 {
-	DEFAULT_BUFFER_SIZE = 32
+	DEFAULT_BUFFER_SIZE = 32,
+	GEOMETRY_PAGE_BYTE_SIZE = 16 << 20,
+	DEFRAG_BYTES_PER_FRAME = 256 << 10,
+
+	DEFAULT_BUDGET_MB = 256,
+	MIN_BUDGET_MB = 1,
+	MAX_BUDGET_MB = 2048
 };
 
 MeshManager* MeshManager::spInstance = nullptr;
 
-MeshManager::MeshManager(ID3D11Device& device)
+MeshManager::MeshManager(RHI::Device& device)
 	: mDevice(device)
 	, mMeshMap()
+	, mMeshesByContent()
+	, mPathRefCounts()
+	, mbSplitPositionStreams(true)
+	, mpVertexPools()
+	, mpIndexPools()
+	, mMeshAllocations()
+	, mDedupLookupCount(0)
+	, mDedupHitCount(0)
+	, mDedupSavedBytes(0)
+	, mUnusedMeshes()
+	, mResidentBytes(0)
+	, mBudgetMB(DEFAULT_BUDGET_MB)
+	, mEvictCount(0)
+	, mbBatching(false)
+	, mbDefragmentation(true)
+	, mLastRelocationCount(0)
+	, mRelocations()
 {
 	mMeshMap.reserve(DEFAULT_BUFFER_SIZE);
+	mMeshesByContent.reserve(DEFAULT_BUFFER_SIZE);
+	mPathRefCounts.reserve(DEFAULT_BUFFER_SIZE);
+	mMeshAllocations.reserve(DEFAULT_BUFFER_SIZE);
 }
 
 MeshManager::~MeshManager()
 {
-	for (std::pair<const std::string, Mesh*>& pair : mMeshMap)
+	// 경로 여러 개가 한 메쉬를 가리킬 수 있으므로 할당 기준으로 해제
+	for (std::pair<Mesh* const, MeshAllocation>& pair : mMeshAllocations)
+	{
+		const MeshAllocation& allocation = pair.second;
+
+		allocation.pVertexPool->Free(allocation.vertex);
+		allocation.pIndexPool->Free(allocation.index);
+
+		delete pair.first;
+	}
+
+	for (GeometryPool* const pPool : mpVertexPools)
+	{
+		delete pPool;
+	}
+
+	for (GeometryPool* const pPool : mpIndexPools)
 	{
-		delete pair.second;
+		delete pPool;
 	}
 }
 
@@ -34,6 +77,18 @@ Mesh* MeshManager::CreateMesh(
 	const std::vector<uint16_t>& indices
 )
 {
+	const Hash128 contentHash = CalculateContentHash(
+		Vertex::EType::POS_NORMAL_UV,
+		vertices.data(),
+		static_cast<UINT>(vertices.size()),
+		sizeof(Vertex::PosNormalUV),
+		indices.data(),
+		static_cast<UINT>(indices.size()),
+		sizeof(uint16_t),
+		Vector3::Zero,
+		Vector3::One
+	);
+
 	return createMeshAlloc(
 		path,
 		Vertex::EType::POS_NORMAL_UV,
@@ -42,7 +97,10 @@ Mesh* MeshManager::CreateMesh(
 		sizeof(Vertex::PosNormalUV),
 		indices.data(),
 		static_cast<UINT>(indices.size()),
-		sizeof(uint16_t)
+		sizeof(uint16_t),
+		Vector3::Zero,
+		Vector3::One,
+		contentHash
 	);
 }
 
@@ -52,6 +110,18 @@ Mesh* MeshManager::CreateMesh(
 	const std::vector<uint32_t>& indices
 )
 {
+	const Hash128 contentHash = CalculateContentHash(
+		Vertex::EType::POS_NORMAL_UV,
+		vertices.data(),
+		static_cast<UINT>(vertices.size()),
+		sizeof(Vertex::PosNormalUV),
+		indices.data(),
+		static_cast<UINT>(indices.size()),
+		sizeof(uint32_t),
+		Vector3::Zero,
+		Vector3::One
+	);
+
 	return createMeshAlloc(
 		path,
 		Vertex::EType::POS_NORMAL_UV,
@@ -60,7 +130,39 @@ Mesh* MeshManager::CreateMesh(
 		sizeof(Vertex::PosNormalUV),
 		indices.data(),
 		static_cast<UINT>(indices.size()),
-		sizeof(uint32_t)
+		sizeof(uint32_t),
+		Vector3::Zero,
+		Vector3::One,
+		contentHash
+	);
+}
+
+Mesh* MeshManager::CreateMesh(
+	const std::string& path,
+	const Vertex::EType eVertexType,
+	const void* pVertexData,
+	const UINT vertexCount,
+	const UINT vertexStride,
+	const void* pIndexData,
+	const UINT indexCount,
+	const UINT indexStride,
+	const Vector3& positionOffset,
+	const Vector3& positionScale,
+	const Hash128& contentHash
+)
+{
+	return createMeshAlloc(
+		path,
+		eVertexType,
+		pVertexData,
+		vertexCount,
+		vertexStride,
+		pIndexData,
+		indexCount,
+		indexStride,
+		positionOffset,
+		positionScale,
+		contentHash
 	);
 }
 
@@ -80,7 +182,7 @@ Mesh* MeshManager::GetMeshOrNull(const std::string& path) const
 	return nullptr;
 }
 
-void MeshManager::UnloadMesh(const std::string& path)
+void MeshManager::ReleaseMesh(const std::string& path)
 {
 #define MAP_ITER std::unordered_map<std::string, Mesh*>::iterator
 
@@ -88,34 +190,248 @@ void MeshManager::UnloadMesh(const std::string& path)
 
 	if (iter != mMeshMap.end())
 	{
-		delete iter->second;
+		uint32_t& pathRefCount = mPathRefCounts[path];
+		ASSERT(pathRefCount > 0);
+
+		--pathRefCount;
+
+		// 같은 경로로 얻은 다른 참조가 남아 있음
+		if (pathRefCount > 0)
+		{
+			return;
+		}
+
+		mPathRefCounts.erase(path);
+
+		Mesh* const pMesh = iter->second;
 
 		mMeshMap.erase(iter);
+
+		MeshAllocation& allocation = mMeshAllocations[pMesh];
+		ASSERT(allocation.refCount > 0);
+
+		--allocation.refCount;
+
+		// 내용 표에는 남겨서 다시 만들면 그대로 꺼내 씀
+		if (allocation.refCount == 0)
+		{
+			allocation.lruIter = mUnusedMeshes.insert(mUnusedMeshes.end(), pMesh);
+		}
 	}
 
 #undef MAP_ITER
 }
 
+void MeshManager::UpdateResidency()
+{
+	ASSERT(!mbBatching);
+
+	const uint64_t budgetBytes = static_cast<uint64_t>(mBudgetMB) * 1024 * 1024;
+
+	while (mResidentBytes > budgetBytes && !mUnusedMeshes.empty())
+	{
+		evictMesh(mUnusedMeshes.front());
+	}
+}
+
+Hash128 MeshManager::CalculateContentHash(
+	const Vertex::EType eVertexType,
+	const void* pVertexData,
+	const UINT vertexCount,
+	const UINT vertexStride,
+	const void* pIndexData,
+	const UINT indexCount,
+	const UINT indexStride,
+	const Vector3& positionOffset,
+	const Vector3& positionScale
+)
+{
+	// 압축 정점은 같아도 복원 값이 다르면 다른 메쉬
+	Hash128 hash = HashCombine128({ FNV_OFFSET_BASIS, MIX_SEED }, static_cast<uint64_t>(eVertexType));
+	hash = HashCombine128(hash, (static_cast<uint64_t>(vertexCount) << 32) | vertexStride);
+	hash = HashCombine128(hash, (static_cast<uint64_t>(indexCount) << 32) | indexStride);
+	hash = HashBytes128(&positionOffset, sizeof(positionOffset), hash);
+	hash = HashBytes128(&positionScale, sizeof(positionScale), hash);
+	hash = HashBytes128(pVertexData, static_cast<size_t>(vertexCount) * vertexStride, hash);
+	hash = HashBytes128(pIndexData, static_cast<size_t>(indexCount) * indexStride, hash);
+
+	return hash;
+}
+
+void MeshManager::BeginBatch()
+{
+	ASSERT(!mbBatching);
+
+	mbBatching = true;
+
+	for (GeometryPool* const pPool : mpVertexPools)
+	{
+		if (pPool != nullptr)
+		{
+			pPool->BeginBatch();
+		}
+	}
+
+	for (GeometryPool* const pPool : mpIndexPools)
+	{
+		if (pPool != nullptr)
+		{
+			pPool->BeginBatch();
+		}
+	}
+}
+
+void MeshManager::EndBatch()
+{
+	ASSERT(mbBatching);
+
+	mbBatching = false;
+
+	for (GeometryPool* const pPool : mpVertexPools)
+	{
+		if (pPool != nullptr)
+		{
+			pPool->EndBatch();
+		}
+	}
+
+	for (GeometryPool* const pPool : mpIndexPools)
+	{
+		if (pPool != nullptr)
+		{
+			pPool->EndBatch();
+		}
+	}
+}
+
+void MeshManager::UpdateDefragmentation()
+{
+	mLastRelocationCount = 0;
+
+	ASSERT(!mbBatching);
+
+	if (!mbDefragmentation)
+	{
+		return;
+	}
+
+	for (GeometryPool* const pPool : mpVertexPools)
+	{
+		if (pPool != nullptr)
+		{
+			mRelocations.clear();
+			pPool->Defragment(DEFRAG_BYTES_PER_FRAME, mRelocations);
+
+			applyRelocations(*pPool, true);
+		}
+	}
+
+	for (GeometryPool* const pPool : mpIndexPools)
+	{
+		if (pPool != nullptr)
+		{
+			mRelocations.clear();
+			pPool->Defragment(DEFRAG_BYTES_PER_FRAME, mRelocations);
+
+			applyRelocations(*pPool, false);
+		}
+	}
+}
+
 void MeshManager::DrawEditorUI()
 {
 	ImGui::PushID("MeshManager");
 
-	ImGui::Text(UTF8_TEXT("޽ "));
+	ImGui::Checkbox(UTF8_TEXT("위치 스트림 분리(새 메쉬부터)"), &mbSplitPositionStreams);
+
+	ImGui::Text(UTF8_TEXT("메쉬 목록"));
+
+	uint32_t splitCount = 0;
+	uint64_t vertexBytes = 0;
+	uint64_t positionOnlyBytes = 0;
 
 #define MAP_ITER std::unordered_map<std::string, Mesh*>::const_iterator
 
 	for (MAP_ITER iter = mMeshMap.cbegin(); iter != mMeshMap.cend(); ++iter)
 	{
 		const std::pair<const std::string, Mesh*>& pair = *iter;
-		ImGui::Text("%s", pair.first.c_str());
-	}
 
-	ImGui::PopID();
+		// 다른 경로와 같이 쓰는 메쉬는 처음 만든 경로를 같이 보여줌
+		if (pair.first != pair.second->GetPath())
+		{
+			ImGui::Text("%s = %s", pair.first.c_str(), pair.second->GetPath());
+		}
+		else
+		{
+			ImGui::Text("%s", pair.first.c_str());
+		}
+	}
 
 #undef MAP_ITER
+
+	for (const std::pair<Mesh* const, MeshAllocation>& pair : mMeshAllocations)
+	{
+		const Mesh& mesh = *pair.first;
+
+		if (mesh.GetPositionBuffer().IsValid())
+		{
+			++splitCount;
+		}
+
+		vertexBytes += mesh.GetVertexBytes();
+		positionOnlyBytes += mesh.GetPositionOnlyBytes();
+	}
+
+	ImGui::Text("Split Meshes: %u / %u", splitCount, static_cast<uint32_t>(mMeshAllocations.size()));
+	ImGui::Text("Vertex Bytes: %.1f KB / Position Only: %.1f KB", static_cast<float>(vertexBytes) / 1024.f, static_cast<float>(positionOnlyBytes) / 1024.f);
+
+	ImGui::SeparatorText(UTF8_TEXT("내용 중복 제거"));
+
+	ImGui::Text("Paths: %u / Unique Meshes: %u", static_cast<uint32_t>(mMeshMap.size()), static_cast<uint32_t>(mMeshAllocations.size()));
+	ImGui::Text("Hits: %u / %u (%.1f%%)", mDedupHitCount, mDedupLookupCount, mDedupLookupCount > 0 ? 100.f * mDedupHitCount / mDedupLookupCount : 0.f);
+	ImGui::Text("Saved: %.1f KB", static_cast<float>(mDedupSavedBytes) / 1024.f);
+
+	ImGui::SeparatorText(UTF8_TEXT("상주 메모리"));
+
+	ImGui::SliderInt("Budget (MB)", &mBudgetMB, MIN_BUDGET_MB, MAX_BUDGET_MB);
+	ImGui::Text("Resident: %.2f MB", static_cast<float>(mResidentBytes) / (1024.f * 1024.f));
+	ImGui::Text("Referenced: %u / Unused (LRU): %u / Evicted: %u",
+		static_cast<uint32_t>(mMeshAllocations.size() - mUnusedMeshes.size()),
+		static_cast<uint32_t>(mUnusedMeshes.size()),
+		mEvictCount
+	);
+
+	ImGui::SeparatorText(UTF8_TEXT("공유 지오메트리 버퍼"));
+
+	ImGui::Checkbox(UTF8_TEXT("조각 모음"), &mbDefragmentation);
+	ImGui::Text("Relocations (last frame): %u", mLastRelocationCount);
+
+	GeometryPool* const* const ppPoolLists[] = { mpVertexPools, mpIndexPools };
+	const uint32_t poolCounts[] = { static_cast<uint32_t>(Vertex::GetVertexTypeCount()), 2 };
+
+	for (uint32_t list = 0; list < 2; ++list)
+	{
+		for (uint32_t i = 0; i < poolCounts[list]; ++i)
+		{
+			const GeometryPool* const pPool = ppPoolLists[list][i];
+
+			if (pPool == nullptr)
+			{
+				continue;
+			}
+
+			const float elementKB = static_cast<float>(pPool->GetElementByteSize()) / 1024.f;
+
+			ImGui::Text("%s: %u pages, %.1f / %.1f KB", pPool->GetName(), pPool->GetPageCount(), pPool->GetUsedSize() * elementKB, pPool->GetCapacity() * elementKB);
+			ImGui::Text("  Free Blocks: %u, Largest: %.1f KB, Fragmentation: %.2f", pPool->GetFreeBlockCount(), pPool->GetLargestFreeBlock() * elementKB, pPool->GetFragmentation());
+			ImGui::Text("  Relocated: %.1f KB", static_cast<float>(pPool->GetTotalRelocatedBytes()) / 1024.f);
+		}
+	}
+
+	ImGui::PopID();
 }
 
-void MeshManager::Initialize(ID3D11Device& device)
+void MeshManager::Initialize(RHI::Device& device)
 {
 	ASSERT(spInstance == nullptr);
 
@@ -130,7 +446,10 @@ Mesh* MeshManager::createMeshAlloc(
 	const UINT vertexStride,
 	const void* pIndexData,
 	const UINT indexCount,
-	const UINT indexStride
+	const UINT indexStride,
+	const Vector3& positionOffset,
+	const Vector3& positionScale,
+	const Hash128& contentHash
 )
 {
 #define MAP_ITER std::unordered_map<std::string, Mesh*>::const_iterator
@@ -139,71 +458,288 @@ Mesh* MeshManager::createMeshAlloc(
 
 	if (iter != mMeshMap.end())
 	{
+		++mPathRefCounts[path];
+
 		return iter->second;
 	}
 
 #undef MAP_ITER
 
-	ComPtr<ID3D11Buffer> vertexBufferPtr;
-	{
-		D3D11_BUFFER_DESC bufferDesc;
-		ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+	++mDedupLookupCount;
 
-		bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-		bufferDesc.ByteWidth = vertexCount * vertexStride;
-		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+#define CONTENT_MAP_ITER std::unordered_map<uint64_t, Mesh*>::const_iterator
 
-		D3D11_SUBRESOURCE_DATA initData;
-		ZeroMemory(&initData, sizeof(D3D11_SUBRESOURCE_DATA));
+	CONTENT_MAP_ITER contentIter = mMeshesByContent.find(contentHash.low);
 
-		initData.pSysMem = pVertexData;
+	// 올린 바이트는 GPU에만 있어서 비교할 수 없음, 128비트 해시와 개수가 모두 같아야 같은 메쉬로 봄
+	if (contentIter != mMeshesByContent.end())
+	{
+		Mesh* const pMesh = contentIter->second;
 
-		HRESULT hr = mDevice.CreateBuffer(&bufferDesc, &initData, vertexBufferPtr.GetAddressOf());
+		MeshAllocation& allocation = mMeshAllocations[pMesh];
 
-		if (FAILED(hr))
+		if (allocation.contentHash == contentHash && allocation.vertex.count == vertexCount && allocation.index.count == indexCount)
 		{
-			LOG_SYSTEM_ERROR(hr, "CreateBuffer - VertexBuffer");
+			// 참조가 없어 LRU에 있던 것이면 꺼냄
+			if (allocation.refCount == 0)
+			{
+				mUnusedMeshes.erase(allocation.lruIter);
+			}
+
+			++allocation.refCount;
 
-			ASSERT(false);
+			++mDedupHitCount;
+			mDedupSavedBytes += static_cast<uint64_t>(allocation.vertex.count) * allocation.pVertexPool->GetElementByteSize()
+				+ static_cast<uint64_t>(allocation.index.count) * allocation.pIndexPool->GetElementByteSize();
+
+			mMeshMap.insert(std::make_pair(path, pMesh));
+			mPathRefCounts.insert(std::make_pair(path, 1));
+
+			return pMesh;
 		}
 	}
 
-	ComPtr<ID3D11Buffer> indexBufferPtr;
-	{
-		D3D11_BUFFER_DESC bufferDesc;
-		ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+#undef CONTENT_MAP_ITER
+
+	Vertex::EType eMeshVertexType = eVertexType;
+	UINT meshVertexStride = vertexStride;
 
-		bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-		bufferDesc.ByteWidth = indexCount * indexStride;
-		bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+	const void* streamData[GeometryPool::MAX_STREAM_COUNT] = { pVertexData, nullptr };
+	uint32_t streamStrides[GeometryPool::MAX_STREAM_COUNT] = { vertexStride, 0 };
+	uint32_t streamCount = 1;
 
-		D3D11_SUBRESOURCE_DATA initData;
-		ZeroMemory(&initData, sizeof(D3D11_SUBRESOURCE_DATA));
+	std::vector<Vertex::Pos> positions;
+	std::vector<Vertex::NormalUV> attributes;
 
-		initData.pSysMem = pIndexData;
+	// 위치와 나머지 속성을 두 스트림으로 나눔
+	if (mbSplitPositionStreams && eVertexType == Vertex::EType::POS_NORMAL_UV)
+	{
+		ASSERT(vertexStride == sizeof(Vertex::PosNormalUV));
 
-		HRESULT hr = mDevice.CreateBuffer(&bufferDesc, &initData, indexBufferPtr.GetAddressOf());
+		const Vertex::PosNormalUV* const pVertices = static_cast<const Vertex::PosNormalUV*>(pVertexData);
 
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "CreateBuffer - IndexBuffer");
+		positions.resize(vertexCount);
+		attributes.resize(vertexCount);
 
-			ASSERT(false);
+		for (UINT i = 0; i < vertexCount; ++i)
+		{
+			positions[i].pos = pVertices[i].pos;
+			attributes[i].normal = pVertices[i].normal;
+			attributes[i].uv = pVertices[i].uv;
 		}
+
+		eMeshVertexType = Vertex::EType::POS_NORMAL_UV_SPLIT;
+		meshVertexStride = sizeof(Vertex::NormalUV);
+
+		streamData[Vertex::POSITION_STREAM_SLOT] = positions.data();
+		streamData[Vertex::ATTRIBUTE_STREAM_SLOT] = attributes.data();
+		streamStrides[Vertex::POSITION_STREAM_SLOT] = sizeof(Vertex::Pos);
+		streamStrides[Vertex::ATTRIBUTE_STREAM_SLOT] = sizeof(Vertex::NormalUV);
+		streamCount = 2;
+	}
+
+	MeshAllocation allocation;
+	allocation.pVertexPool = &getVertexPool(eMeshVertexType, streamStrides, streamCount);
+	allocation.pIndexPool = &getIndexPool(indexStride);
+	allocation.contentHash = contentHash;
+	allocation.refCount = 1;
+	allocation.lruIter = mUnusedMeshes.end();
+
+	if (!allocation.pVertexPool->TryAllocate(streamData, vertexCount, allocation.vertex))
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "GeometryPool - VertexBuffer");
+
+		ASSERT(false);
+
+		return nullptr;
+	}
+
+	if (!allocation.pIndexPool->TryAllocate(&pIndexData, indexCount, allocation.index))
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "GeometryPool - IndexBuffer");
+
+		ASSERT(false);
+
+		allocation.pVertexPool->Free(allocation.vertex);
+
+		return nullptr;
+	}
+
+	RHI::BufferHandle vertexBuffer = { 0 };
+	RHI::BufferHandle positionBuffer = { 0 };
+
+	if (streamCount == 2)
+	{
+		positionBuffer = allocation.pVertexPool->GetBuffer(allocation.vertex.page, Vertex::POSITION_STREAM_SLOT);
+		vertexBuffer = allocation.pVertexPool->GetBuffer(allocation.vertex.page, Vertex::ATTRIBUTE_STREAM_SLOT);
+	}
+	else
+	{
+		vertexBuffer = allocation.pVertexPool->GetBuffer(allocation.vertex.page, 0);
 	}
 
 	Mesh* const pMesh = new Mesh(
 		path,
-		eVertexType,
-		vertexBufferPtr,
+		eMeshVertexType,
+		vertexBuffer,
 		vertexCount,
-		vertexStride,
-		indexBufferPtr,
+		meshVertexStride,
+		positionBuffer,
+		allocation.vertex.offset,
+		allocation.pIndexPool->GetBuffer(allocation.index.page, 0),
 		indexCount,
-		indexStride
+		indexStride,
+		allocation.index.offset
 	);
 
+	pMesh->SetPositionDequantization(positionOffset, positionScale);
+
+	mResidentBytes += static_cast<uint64_t>(allocation.vertex.count) * allocation.pVertexPool->GetElementByteSize()
+		+ static_cast<uint64_t>(allocation.index.count) * allocation.pIndexPool->GetElementByteSize();
+
 	mMeshMap.insert(std::make_pair(path, pMesh));
+	mPathRefCounts.insert(std::make_pair(path, 1));
+	mMeshAllocations.insert(std::make_pair(pMesh, allocation));
+
+	// 충돌한 이전 메쉬는 경로로만 찾을 수 있게 두고 새 것으로 바꿈
+	mMeshesByContent[contentHash.low] = pMesh;
 
 	return pMesh;
+}
+
+GeometryPool& MeshManager::getVertexPool(const Vertex::EType eVertexType, const uint32_t* const pStrides, const uint32_t streamCount)
+{
+	GeometryPool*& pPool = mpVertexPools[static_cast<int>(eVertexType)];
+
+	if (pPool == nullptr)
+	{
+		pPool = new GeometryPool(
+			mDevice,
+			Vertex::GetTypeName(eVertexType),
+			RHI::BIND_VERTEX_BUFFER,
+			pStrides,
+			streamCount,
+			GEOMETRY_PAGE_BYTE_SIZE
+		);
+
+		// 묶는 도중에 만든 풀도 같이 모음
+		if (mbBatching)
+		{
+			pPool->BeginBatch();
+		}
+	}
+
+	return *pPool;
+}
+
+GeometryPool& MeshManager::getIndexPool(const UINT indexStride)
+{
+	ASSERT(indexStride == sizeof(uint16_t) || indexStride == sizeof(uint32_t));
+
+	const uint32_t poolIndex = indexStride == sizeof(uint16_t) ? 0 : 1;
+
+	GeometryPool*& pPool = mpIndexPools[poolIndex];
+
+	if (pPool == nullptr)
+	{
+		const uint32_t stride = indexStride;
+
+		pPool = new GeometryPool(
+			mDevice,
+			poolIndex == 0 ? "INDEX16" : "INDEX32",
+			RHI::BIND_INDEX_BUFFER,
+			&stride,
+			1,
+			GEOMETRY_PAGE_BYTE_SIZE
+		);
+
+		if (mbBatching)
+		{
+			pPool->BeginBatch();
+		}
+	}
+
+	return *pPool;
+}
+
+void MeshManager::freeMeshGeometry(Mesh* const pMesh)
+{
+#define MAP_ITER std::unordered_map<Mesh*, MeshAllocation>::iterator
+
+	MAP_ITER iter = mMeshAllocations.find(pMesh);
+	ASSERT(iter != mMeshAllocations.end());
+
+	const MeshAllocation& allocation = iter->second;
+
+	mResidentBytes -= static_cast<uint64_t>(allocation.vertex.count) * allocation.pVertexPool->GetElementByteSize()
+		+ static_cast<uint64_t>(allocation.index.count) * allocation.pIndexPool->GetElementByteSize();
+
+	allocation.pVertexPool->Free(allocation.vertex);
+	allocation.pIndexPool->Free(allocation.index);
+
+	mMeshAllocations.erase(iter);
+
+#undef MAP_ITER
+}
+
+void MeshManager::evictMesh(Mesh* const pMesh)
+{
+	MeshAllocation& allocation = mMeshAllocations[pMesh];
+	ASSERT(allocation.refCount == 0);
+
+	mUnusedMeshes.erase(allocation.lruIter);
+
+#define CONTENT_MAP_ITER std::unordered_map<uint64_t, Mesh*>::iterator
+
+	CONTENT_MAP_ITER contentIter = mMeshesByContent.find(allocation.contentHash.low);
+
+	// 충돌로 자리를 넘겨준 메쉬면 내용 표에 없음
+	if (contentIter != mMeshesByContent.end() && contentIter->second == pMesh)
+	{
+		mMeshesByContent.erase(contentIter);
+	}
+
+#undef CONTENT_MAP_ITER
+
+	freeMeshGeometry(pMesh);
+
+	delete pMesh;
+
+	++mEvictCount;
+}
+
+void MeshManager::applyRelocations(const GeometryPool& pool, const bool bVertexPool)
+{
+	mLastRelocationCount += static_cast<uint32_t>(mRelocations.size());
+
+	// 순서대로 적용해야 한 프레임에 두 번 옮겨진 할당도 따라감
+	for (const GeometryPool::Relocation& relocation : mRelocations)
+	{
+		for (std::pair<Mesh* const, MeshAllocation>& pair : mMeshAllocations)
+		{
+			MeshAllocation& allocation = pair.second;
+
+			GeometryPool::Allocation& target = bVertexPool ? allocation.vertex : allocation.index;
+
+			if ((bVertexPool ? allocation.pVertexPool : allocation.pIndexPool) != &pool
+				|| target.page != relocation.page
+				|| target.offset != relocation.oldOffset)
+			{
+				continue;
+			}
+
+			target.offset = relocation.newOffset;
+
+			if (bVertexPool)
+			{
+				pair.first->SetBaseVertex(relocation.newOffset);
+			}
+			else
+			{
+				pair.first->SetStartIndex(relocation.newOffset);
+			}
+
+			break;
+		}
+	}
 }
\ No newline at end of file
@@ -2,18 +2,23 @@
 
 #include <string>
 #include <unordered_map>
+#include <list>
 
-#include <d3d11.h>
-
+#include "GeometryPool.h"
 #include "Core/Assert.h"
+#include "Core/HashHelper.h"
 #include "Renderer/Vertex.h"
+#include "Renderer/RHI/RHIDevice.h"
 #include "UI/IEditorUIDrawable.h"
 
 class Mesh;
 
+// CreateMesh가 돌려준 포인터마다 경로의 참조가 하나, ReleaseMesh로 하나씩 놓음
+// 참조가 없는 메쉬는 바로 해제하지 않고 LRU에 두었다가 예산을 넘으면 오래된 것부터 해제
 class MeshManager final : public IEditorUIDrawable
 {
 public:
+	// 이미 있는 경로여도 참조를 하나 잡음, 부른 수만큼 ReleaseMesh를 불러야 함
 	Mesh* CreateMesh(
 		const std::string& path,
 		const std::vector<Vertex::PosNormalUV>& vertices,
@@ -26,13 +31,55 @@ public:
 		const std::vector<uint32_t>& indices
 	);
 
+	// 쿠킹된 파일처럼 이미 GPU 배치인 메모리에서 바로 만듦
+	// contentHash는 CalculateContentHash로 미리 구한 값, 큰 메쉬는 불러오는 스레드에서 구해 둠
+	Mesh* CreateMesh(
+		const std::string& path,
+		const Vertex::EType eVertexType,
+		const void* pVertexData,
+		const UINT vertexCount,
+		const UINT vertexStride,
+		const void* pIndexData,
+		const UINT indexCount,
+		const UINT indexStride,
+		const Vector3& positionOffset,
+		const Vector3& positionScale,
+		const Hash128& contentHash
+	);
+
 	Mesh* GetMeshOrNull(const std::string& path) const;
-	void UnloadMesh(const std::string& path);
+
+	// 경로의 참조가 모두 놓이면 경로를 지우고, 다른 경로가 같이 쓰지 않으면 LRU로 옮김
+	// 같은 내용을 다시 만들면 LRU에서 꺼내 씀
+	void ReleaseMesh(const std::string& path);
+
+	// 올리는 정점/인덱스 바이트와 위치 복원 값으로 구함, 여러 스레드에서 불러도 됨
+	static Hash128 CalculateContentHash(
+		const Vertex::EType eVertexType,
+		const void* pVertexData,
+		const UINT vertexCount,
+		const UINT vertexStride,
+		const void* pIndexData,
+		const UINT indexCount,
+		const UINT indexStride,
+		const Vector3& positionOffset,
+		const Vector3& positionScale
+	);
+
+	// 사이에 만드는 메쉬의 업로드를 풀마다 모아 EndBatch에서 한 번씩 제출
+	void BeginBatch();
+	void EndBatch();
+
+	// 프레임 경계에서 호출, 올라간 크기가 예산을 넘으면 참조 없는 메쉬를 오래된 것부터 해제
+	void UpdateResidency();
+
+	// 프레임 경계에서 호출, 기록 전에 공유 버퍼의 빈틈을 조금씩 메움
+	void UpdateDefragmentation();
 
 	virtual void DrawEditorUI() override;
 
 	// static
-	static void Initialize(ID3D11Device& device);
+	static void Initialize(RHI::Device& device);
 
 	static MeshManager& GetInstance()
 	{
@@ -49,16 +96,69 @@ public:
 private:
 	static MeshManager* spInstance;
 
-	ID3D11Device& mDevice;
+	RHI::Device& mDevice;
 
+	// 내용이 같으면 여러 경로가 같은 Mesh를 가리킴
+	// 내용 표의 키는 해시의 low, 찾은 뒤 128비트 전체를 비교함
 	std::unordered_map<std::string, Mesh*> mMeshMap;
+	std::unordered_map<uint64_t, Mesh*> mMeshesByContent;
+
+	// 경로마다 CreateMesh 수 - ReleaseMesh 수, 0이 되면 mMeshMap에서 지움
+	std::unordered_map<std::string, uint32_t> mPathRefCounts;
+
+	// 켜져 있으면 이후에 만드는 POS_NORMAL_UV 메쉬의 위치를 따로 떼어 올림
+	bool mbSplitPositionStreams;
+
+	// 정점 배치마다 하나, 인덱스는 16/32비트마다 하나씩 처음 쓸 때 만듦
+	GeometryPool* mpVertexPools[Vertex::GetVertexTypeCount()];
+	GeometryPool* mpIndexPools[2];
+
+	struct MeshAllocation
+	{
+		GeometryPool* pVertexPool;
+		GeometryPool::Allocation vertex;
+		GeometryPool* pIndexPool;
+		GeometryPool::Allocation index;
+
+		Hash128 contentHash;
+
+		// 이 메쉬를 가리키는 경로 수, 0이면 lruIter가 유효
+		uint32_t refCount;
+		std::list<Mesh*>::iterator lruIter;
+	};
+
+	std::unordered_map<Mesh*, MeshAllocation> mMeshAllocations;
+
+	// residency, 앞쪽이 가장 오래전에 놓인 것
+	std::list<Mesh*> mUnusedMeshes;
+	uint64_t mResidentBytes;
+	int mBudgetMB;
+	uint32_t mEvictCount;
+
+	// 경로가 없어서 내용을 비교한 수와 그 중 같은 메쉬를 찾은 수
+	uint32_t mDedupLookupCount;
+	uint32_t mDedupHitCount;
+	uint64_t mDedupSavedBytes;
+
+	bool mbBatching;
+
+	bool mbDefragmentation;
+	uint32_t mLastRelocationCount;
+	std::vector<GeometryPool::Relocation> mRelocations;
 
 private:
-	MeshManager(ID3D11Device& device);
+	MeshManager(RHI::Device& device);
 	~MeshManager();
 
 	float calculateBoundingSphereLocalRadius(const std::vector<Vertex::PosNormalUV>& vertices);
 
+	GeometryPool& getVertexPool(const Vertex::EType eVertexType, const uint32_t* const pStrides, const uint32_t streamCount);
+	GeometryPool& getIndexPool(const UINT indexStride);
+
+	void freeMeshGeometry(Mesh* const pMesh);
+	void evictMesh(Mesh* const pMesh);
+	void applyRelocations(const GeometryPool& pool, const bool bVertexPool);
+
 	Mesh* createMeshAlloc(
 		const std::string& path,
 		const Vertex::EType eVertexType,
@@ -67,7 +167,10 @@ private:
 		const UINT vertexStride,
 		const void* pIndexData,
 		const UINT indexCount,
-		const UINT indexStride
+		const UINT indexStride,
+		const Vector3& positionOffset,
+		const Vector3& positionScale,
+		const Hash128& contentHash
 	);
 
 private:
@@ -0,0 +1,559 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+#include "Core/Assert.h"
+
+enum
+{
+	INVALID_VERTEX = 0xFFFFFFFF,
+
+	// 합치기 격자의 축마다 칸 수, 세 축을 64비트 키 하나에 담음
+	WELD_CELL_BITS = 21,
+	WELD_CELL_MAX = (1 << WELD_CELL_BITS) - 1
+};
+
+// 타임스탬프 기반 FIFO 캐시, 미스가 날 때마다 시간이 흐름
+static uint32_t SimulateTriangle(const uint32_t* const pTriangle, std::vector<uint32_t>& cacheTimes, uint32_t& timestamp)
+{
+	uint32_t missCount = 0;
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		const uint32_t vertex = pTriangle[i];
+
+		if (timestamp - cacheTimes[vertex] > VERTEX_CACHE_SIZE)
+		{
+			cacheTimes[vertex] = timestamp++;
+
+			++missCount;
+		}
+	}
+
+	return missCount;
+}
+
+static void FlushCache(uint32_t& timestamp)
+{
+	timestamp += VERTEX_CACHE_SIZE + 1;
+}
+
+static bool IsNearlyEqual(const Vertex::PosNormalUV& lhs, const Vertex::PosNormalUV& rhs, const float tolerance)
+{
+	const float* const pLhs = &lhs.pos.x;
+	const float* const pRhs = &rhs.pos.x;
+
+	static_assert(sizeof(Vertex::PosNormalUV) == sizeof(float) * 8);
+
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		if (fabsf(pLhs[i] - pRhs[i]) > tolerance)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// 범위 최소점에서 잰 칸 번호, 범위를 벗어나거나 NaN이면 끝 칸으로 붙임
+static int64_t GetWeldCell(const float value, const float minValue, const double inverseCellSize)
+{
+	const double cell = floor((static_cast<double>(value) - minValue) * inverseCellSize);
+
+	return static_cast<int64_t>(fmin(fmax(cell, 0.0), static_cast<double>(WELD_CELL_MAX)));
+}
+
+static uint64_t MakeWeldCellKey(const int64_t x, const int64_t y, const int64_t z)
+{
+	return static_cast<uint64_t>(x) | (static_cast<uint64_t>(y) << WELD_CELL_BITS) | (static_cast<uint64_t>(z) << (WELD_CELL_BITS * 2));
+}
+
+void AccumulateVertexCacheStats(VertexCacheStats& inOutTotal, const VertexCacheStats& stats)
+{
+	inOutTotal.triangleCount += stats.triangleCount;
+	inOutTotal.vertexCount += stats.vertexCount;
+	inOutTotal.cacheMissCount += stats.cacheMissCount;
+}
+
+void MeasureVertexCache(const std::vector<uint32_t>& indices, const uint32_t vertexCount, VertexCacheStats& outStats)
+{
+	ASSERT(indices.size() % 3 == 0);
+
+	std::vector<uint32_t> cacheTimes(vertexCount, 0);
+	uint32_t timestamp = VERTEX_CACHE_SIZE + 1;
+
+	outStats.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	outStats.vertexCount = vertexCount;
+	outStats.cacheMissCount = 0;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		outStats.cacheMissCount += SimulateTriangle(&indices[i], cacheTimes, timestamp);
+	}
+}
+
+uint32_t WeldVertices(std::vector<Vertex::PosNormalUV>& vertices, std::vector<uint32_t>& indices, const float tolerance)
+{
+	ASSERT(tolerance > 0.f);
+	ASSERT(indices.size() % 3 == 0);
+
+	// 위치를 범위 최소점 기준 격자로 나누고 이웃 칸까지 찾음
+	// 칸은 tolerance보다 작지 않아야 이웃 칸만 봐도 되고, 범위가 넓으면 칸 수가 WELD_CELL_MAX 안이 되도록 키움
+	Vector3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+	Vector3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (const Vertex::PosNormalUV& vertex : vertices)
+	{
+		boundsMin = Vector3(fminf(boundsMin.x, vertex.pos.x), fminf(boundsMin.y, vertex.pos.y), fminf(boundsMin.z, vertex.pos.z));
+		boundsMax = Vector3(fmaxf(boundsMax.x, vertex.pos.x), fmaxf(boundsMax.y, vertex.pos.y), fmaxf(boundsMax.z, vertex.pos.z));
+	}
+
+	double maxExtent = 0.0;
+
+	if (!vertices.empty())
+	{
+		maxExtent = fmax(static_cast<double>(boundsMax.x) - boundsMin.x, fmax(static_cast<double>(boundsMax.y) - boundsMin.y, static_cast<double>(boundsMax.z) - boundsMin.z));
+	}
+
+	const double cellSize = fmax(static_cast<double>(tolerance), maxExtent / static_cast<double>(WELD_CELL_MAX));
+	const double inverseCellSize = 1.0 / cellSize;
+
+	std::unordered_map<uint64_t, uint32_t> cellHeads;
+	cellHeads.reserve(vertices.size());
+
+	// 같은 칸에 들어간 합친 정점끼리 연결
+	std::vector<uint32_t> nextInCell;
+	nextInCell.reserve(vertices.size());
+
+	std::vector<Vertex::PosNormalUV> welded;
+	welded.reserve(vertices.size());
+
+	std::vector<uint32_t> remap(vertices.size());
+
+	for (uint32_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex::PosNormalUV& vertex = vertices[i];
+
+		const int64_t cellX = GetWeldCell(vertex.pos.x, boundsMin.x, inverseCellSize);
+		const int64_t cellY = GetWeldCell(vertex.pos.y, boundsMin.y, inverseCellSize);
+		const int64_t cellZ = GetWeldCell(vertex.pos.z, boundsMin.z, inverseCellSize);
+
+		uint32_t found = INVALID_VERTEX;
+
+		for (int64_t z = std::max<int64_t>(cellZ - 1, 0); z <= std::min<int64_t>(cellZ + 1, WELD_CELL_MAX) && found == INVALID_VERTEX; ++z)
+		{
+			for (int64_t y = std::max<int64_t>(cellY - 1, 0); y <= std::min<int64_t>(cellY + 1, WELD_CELL_MAX) && found == INVALID_VERTEX; ++y)
+			{
+				for (int64_t x = std::max<int64_t>(cellX - 1, 0); x <= std::min<int64_t>(cellX + 1, WELD_CELL_MAX) && found == INVALID_VERTEX; ++x)
+				{
+					std::unordered_map<uint64_t, uint32_t>::const_iterator iter = cellHeads.find(MakeWeldCellKey(x, y, z));
+
+					if (iter == cellHeads.end())
+					{
+						continue;
+					}
+
+					for (uint32_t candidate = iter->second; candidate != INVALID_VERTEX; candidate = nextInCell[candidate])
+					{
+						if (IsNearlyEqual(welded[candidate], vertex, tolerance))
+						{
+							found = candidate;
+
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		if (found == INVALID_VERTEX)
+		{
+			found = static_cast<uint32_t>(welded.size());
+
+			welded.push_back(vertex);
+
+			const std::pair<std::unordered_map<uint64_t, uint32_t>::iterator, bool> inserted = cellHeads.insert(std::make_pair(MakeWeldCellKey(cellX, cellY, cellZ), found));
+
+			nextInCell.push_back(inserted.second ? INVALID_VERTEX : inserted.first->second);
+			inserted.first->second = found;
+		}
+
+		remap[i] = found;
+	}
+
+	uint32_t degenerateCount = 0;
+	size_t writeIndex = 0;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		const uint32_t a = remap[indices[i]];
+		const uint32_t b = remap[indices[i + 1]];
+		const uint32_t c = remap[indices[i + 2]];
+
+		if (a == b || b == c || c == a)
+		{
+			++degenerateCount;
+
+			continue;
+		}
+
+		indices[writeIndex++] = a;
+		indices[writeIndex++] = b;
+		indices[writeIndex++] = c;
+	}
+
+	indices.resize(writeIndex);
+	vertices.swap(welded);
+
+	return degenerateCount;
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, const uint32_t vertexCount, std::vector<uint32_t>& outClusters)
+{
+	ASSERT(indices.size() % 3 == 0);
+
+	outClusters.clear();
+
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	// 정점마다 아직 그리지 않은 삼각형 수와 인접 삼각형 목록
+	std::vector<uint32_t> liveCounts(vertexCount, 0);
+
+	for (const uint32_t index : indices)
+	{
+		ASSERT(index < vertexCount);
+
+		++liveCounts[index];
+	}
+
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+
+	for (uint32_t i = 0; i < vertexCount; ++i)
+	{
+		adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveCounts[i];
+	}
+
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> writePositions(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+		for (uint32_t i = 0; i < indices.size(); ++i)
+		{
+			adjacency[writePositions[indices[i]]++] = i / 3;
+		}
+	}
+
+	std::vector<uint32_t> cacheTimes(vertexCount, 0);
+	std::vector<bool> emitted(triangleCount, false);
+
+	std::vector<uint32_t> deadEnds;
+	deadEnds.reserve(indices.size());
+
+	std::vector<uint32_t> candidates;
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	uint32_t timestamp = VERTEX_CACHE_SIZE + 1;
+	uint32_t scanCursor = 0;
+	uint32_t fanVertex = indices[0];
+
+	outClusters.push_back(0);
+
+	while (fanVertex != INVALID_VERTEX)
+	{
+		// 1. 중심 정점에 붙은 남은 삼각형을 모두 그림
+		candidates.clear();
+
+		for (uint32_t i = adjacencyOffsets[fanVertex]; i < adjacencyOffsets[fanVertex + 1]; ++i)
+		{
+			const uint32_t triangle = adjacency[i];
+
+			if (emitted[triangle])
+			{
+				continue;
+			}
+
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				const uint32_t vertex = indices[triangle * 3 + corner];
+
+				result.push_back(vertex);
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+
+				--liveCounts[vertex];
+
+				if (timestamp - cacheTimes[vertex] > VERTEX_CACHE_SIZE)
+				{
+					cacheTimes[vertex] = timestamp++;
+				}
+			}
+
+			emitted[triangle] = true;
+		}
+
+		// 2. 남은 삼각형을 그려도 캐시에 남아 있을 정점 중 가장 오래된 것을 다음 중심으로
+		fanVertex = INVALID_VERTEX;
+		uint32_t bestPriority = 0;
+
+		for (const uint32_t vertex : candidates)
+		{
+			if (liveCounts[vertex] == 0)
+			{
+				continue;
+			}
+
+			uint32_t priority = 1;
+
+			if (timestamp - cacheTimes[vertex] + 2 * liveCounts[vertex] <= VERTEX_CACHE_SIZE)
+			{
+				priority += timestamp - cacheTimes[vertex];
+			}
+
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				fanVertex = vertex;
+			}
+		}
+
+		if (fanVertex != INVALID_VERTEX)
+		{
+			continue;
+		}
+
+		// 3. 막히면 최근에 그린 정점에서 이어감
+		while (!deadEnds.empty())
+		{
+			const uint32_t vertex = deadEnds.back();
+			deadEnds.pop_back();
+
+			if (liveCounts[vertex] > 0)
+			{
+				fanVertex = vertex;
+
+				break;
+			}
+		}
+
+		if (fanVertex != INVALID_VERTEX)
+		{
+			continue;
+		}
+
+		// 4. 그것도 없으면 순서대로 찾음, 캐시가 비는 곳이므로 덩어리 경계
+		while (scanCursor < vertexCount && liveCounts[scanCursor] == 0)
+		{
+			++scanCursor;
+		}
+
+		if (scanCursor < vertexCount)
+		{
+			fanVertex = scanCursor;
+
+			outClusters.push_back(static_cast<uint32_t>(result.size() / 3));
+		}
+	}
+
+	ASSERT(result.size() == indices.size());
+
+	indices.swap(result);
+}
+
+uint32_t OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex::PosNormalUV>& vertices, const std::vector<uint32_t>& clusters, const float threshold)
+{
+	ASSERT(indices.size() % 3 == 0);
+
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	if (triangleCount == 0)
+	{
+		return 0;
+	}
+
+	// 1. 캐시 효율이 덩어리 평균의 threshold배 안으로 들어오는 곳마다 더 나눔
+	std::vector<uint32_t> cacheTimes(vertices.size(), 0);
+	uint32_t timestamp = VERTEX_CACHE_SIZE + 1;
+
+	std::vector<uint32_t> splits;
+	splits.reserve(clusters.size() * 4);
+
+	for (size_t c = 0; c < clusters.size(); ++c)
+	{
+		const uint32_t begin = clusters[c];
+		const uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+		FlushCache(timestamp);
+
+		uint32_t clusterMissCount = 0;
+
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			clusterMissCount += SimulateTriangle(&indices[i * 3], cacheTimes, timestamp);
+		}
+
+		const float splitACMR = threshold * clusterMissCount / (end - begin);
+
+		FlushCache(timestamp);
+
+		splits.push_back(begin);
+
+		uint32_t splitBegin = begin;
+		uint32_t splitMissCount = 0;
+
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			splitMissCount += SimulateTriangle(&indices[i * 3], cacheTimes, timestamp);
+
+			if (i + 1 < end && splitMissCount <= splitACMR * (i + 1 - splitBegin))
+			{
+				splits.push_back(i + 1);
+
+				splitBegin = i + 1;
+				splitMissCount = 0;
+
+				FlushCache(timestamp);
+			}
+		}
+	}
+
+	const uint32_t splitCount = static_cast<uint32_t>(splits.size());
+
+	// 2. 덩어리의 넓이 가중 중심과 법선을 구하고 메쉬 중심에서 바깥을 향하는 정도로 정렬
+	Vector3 meshCentroid = Vector3::Zero;
+	float meshArea = 0.f;
+
+	std::vector<Vector3> splitCentroids(splitCount, Vector3::Zero);
+	std::vector<Vector3> splitNormals(splitCount, Vector3::Zero);
+
+	for (uint32_t s = 0; s < splitCount; ++s)
+	{
+		const uint32_t begin = splits[s];
+		const uint32_t end = s + 1 < splitCount ? splits[s + 1] : triangleCount;
+
+		float splitArea = 0.f;
+
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			const Vector3& p0 = vertices[indices[i * 3]].pos;
+			const Vector3& p1 = vertices[indices[i * 3 + 1]].pos;
+			const Vector3& p2 = vertices[indices[i * 3 + 2]].pos;
+
+			const Vector3 normal = (p1 - p0).Cross(p2 - p0);
+			const float area = normal.Length();
+
+			const Vector3 centroid = (p0 + p1 + p2) * (area / 3.f);
+
+			splitCentroids[s] += centroid;
+			splitNormals[s] += normal;
+			splitArea += area;
+
+			meshCentroid += centroid;
+			meshArea += area;
+		}
+
+		if (splitArea > 0.f)
+		{
+			splitCentroids[s] /= splitArea;
+		}
+
+		splitNormals[s].Normalize();
+	}
+
+	if (meshArea > 0.f)
+	{
+		meshCentroid /= meshArea;
+	}
+
+	std::vector<float> sortKeys(splitCount);
+	std::vector<uint32_t> order(splitCount);
+
+	for (uint32_t s = 0; s < splitCount; ++s)
+	{
+		sortKeys[s] = (splitCentroids[s] - meshCentroid).Dot(splitNormals[s]);
+		order[s] = s;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&sortKeys](const uint32_t lhs, const uint32_t rhs)
+		{
+			return sortKeys[lhs] > sortKeys[rhs];
+		});
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	for (const uint32_t s : order)
+	{
+		const uint32_t begin = splits[s];
+		const uint32_t end = s + 1 < splitCount ? splits[s + 1] : triangleCount;
+
+		result.insert(result.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+	}
+
+	indices.swap(result);
+
+	return splitCount;
+}
+
+void OptimizeVertexFetch(std::vector<Vertex::PosNormalUV>& vertices, std::vector<uint32_t>& indices)
+{
+	std::vector<uint32_t> remap(vertices.size(), INVALID_VERTEX);
+
+	std::vector<Vertex::PosNormalUV> result;
+	result.reserve(vertices.size());
+
+	for (uint32_t& index : indices)
+	{
+		ASSERT(index < vertices.size());
+
+		if (remap[index] == INVALID_VERTEX)
+		{
+			remap[index] = static_cast<uint32_t>(result.size());
+
+			result.push_back(vertices[index]);
+		}
+
+		index = remap[index];
+	}
+
+	vertices.swap(result);
+}
+
+void OptimizeMesh(std::vector<Vertex::PosNormalUV>& vertices, std::vector<uint32_t>& indices, MeshOptimizeStats& outStats)
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	// 덩어리로 나눌 때 허용하는 ACMR 증가 비율
+	constexpr float OVERDRAW_THRESHOLD = 1.05f;
+
+	// 위치, 법선, UV 모두에 같이 씀
+	constexpr float WELD_TOLERANCE = 1e-5f;
+
+	const Clock::time_point optimizeStart = Clock::now();
+
+	MeasureVertexCache(indices, static_cast<uint32_t>(vertices.size()), outStats.before);
+
+	outStats.degenerateTriangleCount = WeldVertices(vertices, indices, WELD_TOLERANCE);
+
+	std::vector<uint32_t> clusters;
+
+	OptimizeVertexCache(indices, static_cast<uint32_t>(vertices.size()), clusters);
+	outStats.clusterCount = OptimizeOverdraw(indices, vertices, clusters, OVERDRAW_THRESHOLD);
+	OptimizeVertexFetch(vertices, indices);
+
+	MeasureVertexCache(indices, static_cast<uint32_t>(vertices.size()), outStats.after);
+
+	outStats.optimizeTimeMs = Milliseconds(Clock::now() - optimizeStart).count();
+}
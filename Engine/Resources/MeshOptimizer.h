@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/Vertex.h"
+
+// 불러온 삼각형 목록을 GPU가 처리하기 좋은 순서로 바꾸는 도구
+// 0. 허용 오차 안에서 같은 정점을 합치고
+// 1. Tipsify로 정점 캐시를 재사용하도록 삼각형 순서를 바꾸고
+// 2. 캐시 효율을 크게 잃지 않는 선에서 덩어리로 나눠 바깥쪽을 먼저 그리도록 정렬하고
+// 3. 정점을 처음 쓰이는 순서로 다시 배치함
+
+enum
+{
+	// 통계와 최적화에 쓰는 FIFO 정점 캐시 크기
+	VERTEX_CACHE_SIZE = 16
+};
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct VertexCacheStats
+{
+	uint32_t triangleCount;
+	uint32_t vertexCount;
+	uint32_t cacheMissCount;
+};
+
+struct MeshOptimizeStats
+{
+	VertexCacheStats before;
+	VertexCacheStats after;
+
+	uint32_t clusterCount;
+
+	// 정점을 합치면서 넓이가 없어져 버린 삼각형
+	uint32_t degenerateTriangleCount;
+
+	float optimizeTimeMs;
+};
+#pragma warning(pop)
+
+// 삼각형당 캐시 미스 수, 1에 가까울수록 좋음
+inline float GetACMR(const VertexCacheStats& stats)
+{
+	return stats.triangleCount > 0 ? static_cast<float>(stats.cacheMissCount) / stats.triangleCount : 0.f;
+}
+
+// 정점당 캐시 미스 수, 1이 최선
+inline float GetATVR(const VertexCacheStats& stats)
+{
+	return stats.vertexCount > 0 ? static_cast<float>(stats.cacheMissCount) / stats.vertexCount : 0.f;
+}
+
+// 여러 메쉬의 통계를 합침
+void AccumulateVertexCacheStats(VertexCacheStats& inOutTotal, const VertexCacheStats& stats);
+
+void MeasureVertexCache(const std::vector<uint32_t>& indices, const uint32_t vertexCount, VertexCacheStats& outStats);
+
+// 위치, 법선, UV가 모두 tolerance 안인 정점을 하나로 합치고 넓이가 없어진 삼각형을 버림
+// 버린 삼각형 수를 돌려줌
+uint32_t WeldVertices(std::vector<Vertex::PosNormalUV>& vertices, std::vector<uint32_t>& indices, const float tolerance);
+
+// 캐시를 비운 곳에서 나눈 덩어리의 시작 삼각형 번호를 outClusters에 채움
+void OptimizeVertexCache(std::vector<uint32_t>& indices, const uint32_t vertexCount, std::vector<uint32_t>& outClusters);
+
+// ACMR이 threshold배 넘게 나빠지지 않는 범위에서 덩어리를 나누고 바깥을 향하는 덩어리부터 그림
+// 나눈 덩어리 수를 돌려줌
+uint32_t OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex::PosNormalUV>& vertices, const std::vector<uint32_t>& clusters, const float threshold);
+
+// 쓰이지 않는 정점은 버림
+void OptimizeVertexFetch(std::vector<Vertex::PosNormalUV>& vertices, std::vector<uint32_t>& indices);
+
+// 위 단계를 차례로 적용, before는 합치기 전 기준
+void OptimizeMesh(std::vector<Vertex::PosNormalUV>& vertices, std::vector<uint32_t>& indices, MeshOptimizeStats& outStats);
@@ -0,0 +1,280 @@
+#include "MipGenerator.h"
+
+#include <cmath>
+#include <vector>
+#include <xmmintrin.h>
+
+#include "Core/Assert.h"
+
+enum
+{
+	RGBA_BYTES_PER_PIXEL = 4,
+
+	// 카이저 필터가 닿는 거리, 밉 픽셀 단위
+	KAISER_RADIUS = 3
+};
+
+// 한 축의 밉 픽셀마다 원본 픽셀 번호와 가중치를 tapCount개씩
+struct AxisFilter
+{
+	uint32_t tapCount;
+
+	std::vector<uint32_t> indices;
+	std::vector<float> weights;
+};
+
+const char* GetMipFilterName(const EMipFilter eFilter)
+{
+	static const char* const names[] =
+	{
+#define MIP_FILTER_ENTRY(type) #type,
+		MIP_FILTER_LIST
+#undef MIP_FILTER_ENTRY
+	};
+
+	ASSERT(static_cast<int>(eFilter) < GetMipFilterCount());
+
+	return names[static_cast<int>(eFilter)];
+}
+
+static uint32_t GetMipExtent(const uint32_t size, const uint32_t mip)
+{
+	const uint32_t extent = size >> mip;
+
+	return extent > 0 ? extent : 1;
+}
+
+static float SRGBToLinear(const float value)
+{
+	return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSRGB(const float value)
+{
+	return value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.f / 2.4f) - 0.055f;
+}
+
+static float Sinc(const float x)
+{
+	constexpr float PI = 3.14159265f;
+
+	if (fabsf(x) < 1e-5f)
+	{
+		return 1.f;
+	}
+
+	return sinf(PI * x) / (PI * x);
+}
+
+// 0차 수정 베셀 함수, 급수 전개
+static float BesselI0(const float x)
+{
+	const float quarterSquared = x * x * 0.25f;
+
+	float sum = 1.f;
+	float term = 1.f;
+
+	for (int k = 1; k < 32; ++k)
+	{
+		term *= quarterSquared / static_cast<float>(k * k);
+		sum += term;
+
+		if (term < sum * 1e-7f)
+		{
+			break;
+		}
+	}
+
+	return sum;
+}
+
+static float GetFilterWeight(const EMipFilter eFilter, const float distance)
+{
+	const float absDistance = fabsf(distance);
+
+	switch (eFilter)
+	{
+	case EMipFilter::BOX:
+		return absDistance <= 0.5f ? 1.f : 0.f;
+
+	case EMipFilter::KAISER:
+		{
+			constexpr float KAISER_ALPHA = 4.f;
+
+			if (absDistance >= static_cast<float>(KAISER_RADIUS))
+			{
+				return 0.f;
+			}
+
+			const float t = absDistance / KAISER_RADIUS;
+
+			return Sinc(distance) * BesselI0(KAISER_ALPHA * sqrtf(1.f - t * t)) / BesselI0(KAISER_ALPHA);
+		}
+
+	default:
+		ASSERT(false, "invalid mip filter");
+		return 0.f;
+	}
+}
+
+static void BuildAxisFilter(const uint32_t srcSize, const uint32_t dstSize, const EMipFilter eFilter, AxisFilter& outFilter)
+{
+	const float scale = static_cast<float>(srcSize) / dstSize;
+	const float radius = (eFilter == EMipFilter::KAISER ? static_cast<float>(KAISER_RADIUS) : 0.5f) * scale;
+
+	outFilter.tapCount = static_cast<uint32_t>(ceilf(radius * 2.f)) + 1;
+	outFilter.indices.resize(static_cast<size_t>(dstSize) * outFilter.tapCount);
+	outFilter.weights.resize(static_cast<size_t>(dstSize) * outFilter.tapCount);
+
+	for (uint32_t dst = 0; dst < dstSize; ++dst)
+	{
+		const float center = (dst + 0.5f) * scale;
+		const int first = static_cast<int>(floorf(center - radius));
+
+		uint32_t* const pIndices = outFilter.indices.data() + static_cast<size_t>(dst) * outFilter.tapCount;
+		float* const pWeights = outFilter.weights.data() + static_cast<size_t>(dst) * outFilter.tapCount;
+
+		float weightSum = 0.f;
+
+		for (uint32_t tap = 0; tap < outFilter.tapCount; ++tap)
+		{
+			const int src = first + static_cast<int>(tap);
+
+			// 가중치는 밉 픽셀 단위 거리로, 가장자리는 반복
+			pWeights[tap] = GetFilterWeight(eFilter, (src + 0.5f - center) / scale);
+			pIndices[tap] = src < 0 ? 0 : (src >= static_cast<int>(srcSize) ? srcSize - 1 : static_cast<uint32_t>(src));
+
+			weightSum += pWeights[tap];
+		}
+
+		ASSERT(weightSum > 0.f);
+
+		for (uint32_t tap = 0; tap < outFilter.tapCount; ++tap)
+		{
+			pWeights[tap] /= weightSum;
+		}
+	}
+}
+
+// 줄 width개짜리 src를 가로로 줄여 dst에
+static void FilterRows(const __m128* const pSrc, const uint32_t srcWidth, const uint32_t height, const AxisFilter& filter, const uint32_t dstWidth, __m128* const pDst)
+{
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const __m128* const pSrcRow = pSrc + static_cast<size_t>(y) * srcWidth;
+		__m128* const pDstRow = pDst + static_cast<size_t>(y) * dstWidth;
+
+		for (uint32_t x = 0; x < dstWidth; ++x)
+		{
+			const uint32_t* const pIndices = filter.indices.data() + static_cast<size_t>(x) * filter.tapCount;
+			const float* const pWeights = filter.weights.data() + static_cast<size_t>(x) * filter.tapCount;
+
+			__m128 sum = _mm_setzero_ps();
+
+			for (uint32_t tap = 0; tap < filter.tapCount; ++tap)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(pSrcRow[pIndices[tap]], _mm_set1_ps(pWeights[tap])));
+			}
+
+			pDstRow[x] = sum;
+		}
+	}
+}
+
+// 세로로 줄이면서 음수 로브로 생긴 범위 밖 값을 자름
+static void FilterColumns(const __m128* const pSrc, const uint32_t width, const AxisFilter& filter, const uint32_t dstHeight, __m128* const pDst)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (uint32_t y = 0; y < dstHeight; ++y)
+	{
+		const uint32_t* const pIndices = filter.indices.data() + static_cast<size_t>(y) * filter.tapCount;
+		const float* const pWeights = filter.weights.data() + static_cast<size_t>(y) * filter.tapCount;
+
+		__m128* const pDstRow = pDst + static_cast<size_t>(y) * width;
+
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			__m128 sum = _mm_setzero_ps();
+
+			for (uint32_t tap = 0; tap < filter.tapCount; ++tap)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(pSrc[static_cast<size_t>(pIndices[tap]) * width + x], _mm_set1_ps(pWeights[tap])));
+			}
+
+			pDstRow[x] = _mm_min_ps(_mm_max_ps(sum, zero), one);
+		}
+	}
+}
+
+void GenerateFilteredMips(TextureMipChain& mipChain, const EMipFilter eFilter, const bool bSRGB)
+{
+	ASSERT(mipChain.topMip == 0);
+	ASSERT(mipChain.format == RHI::EFormat::R8G8B8A8_UNORM);
+
+	float decodeTable[256];
+
+	for (int i = 0; i < 256; ++i)
+	{
+		decodeTable[i] = bSRGB ? SRGBToLinear(i / 255.f) : i / 255.f;
+	}
+
+	const size_t topPixelCount = static_cast<size_t>(mipChain.width) * mipChain.height;
+
+	// 각 밉은 양자화하기 전의 바로 위 밉에서 만듦
+	std::vector<__m128> level(topPixelCount);
+
+	for (size_t i = 0; i < topPixelCount; ++i)
+	{
+		const uint8_t* const pPixel = mipChain.data.data() + i * RGBA_BYTES_PER_PIXEL;
+
+		level[i] = _mm_setr_ps(decodeTable[pPixel[0]], decodeTable[pPixel[1]], decodeTable[pPixel[2]], pPixel[3] / 255.f);
+	}
+
+	// 0번 밉이 맨 앞이므로 크기만 늘려도 그대로 남음
+	mipChain.mipCount = GetFullMipCount(mipChain.width, mipChain.height);
+	ResizeTextureMips(mipChain);
+
+	std::vector<__m128> rows;
+	std::vector<__m128> nextLevel;
+
+	AxisFilter horizontalFilter;
+	AxisFilter verticalFilter;
+
+	for (uint32_t mip = 1; mip < mipChain.mipCount; ++mip)
+	{
+		const uint32_t srcWidth = GetMipExtent(mipChain.width, mip - 1);
+		const uint32_t srcHeight = GetMipExtent(mipChain.height, mip - 1);
+		const uint32_t dstWidth = GetMipExtent(mipChain.width, mip);
+		const uint32_t dstHeight = GetMipExtent(mipChain.height, mip);
+
+		BuildAxisFilter(srcWidth, dstWidth, eFilter, horizontalFilter);
+		BuildAxisFilter(srcHeight, dstHeight, eFilter, verticalFilter);
+
+		rows.resize(static_cast<size_t>(dstWidth) * srcHeight);
+		nextLevel.resize(static_cast<size_t>(dstWidth) * dstHeight);
+
+		FilterRows(level.data(), srcWidth, srcHeight, horizontalFilter, dstWidth, rows.data());
+		FilterColumns(rows.data(), dstWidth, verticalFilter, dstHeight, nextLevel.data());
+
+		uint8_t* const pDst = mipChain.data.data() + mipChain.mipOffsets[mip];
+
+		for (size_t i = 0; i < nextLevel.size(); ++i)
+		{
+			float values[4];
+			_mm_storeu_ps(values, nextLevel[i]);
+
+			uint8_t* const pPixel = pDst + i * RGBA_BYTES_PER_PIXEL;
+
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				pPixel[c] = static_cast<uint8_t>((bSRGB ? LinearToSRGB(values[c]) : values[c]) * 255.f + 0.5f);
+			}
+
+			pPixel[3] = static_cast<uint8_t>(values[3] * 255.f + 0.5f);
+		}
+
+		level.swap(nextLevel);
+	}
+}
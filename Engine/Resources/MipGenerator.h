@@ -0,0 +1,30 @@
+#pragma once
+
+#include "TextureLoader.h"
+
+// BOX: 밉 하나가 덮는 원본 픽셀의 평균
+// KAISER: 카이저 창을 씌운 sinc, 더 선명하지만 느림
+#define MIP_FILTER_LIST \
+	MIP_FILTER_ENTRY(BOX) \
+	MIP_FILTER_ENTRY(KAISER) \
+
+enum class EMipFilter : uint8_t
+{
+#define MIP_FILTER_ENTRY(type) type,
+	MIP_FILTER_LIST
+#undef MIP_FILTER_ENTRY
+
+	COUNT
+};
+
+consteval int GetMipFilterCount()
+{
+	return static_cast<int>(EMipFilter::COUNT);
+}
+
+const char* GetMipFilterName(const EMipFilter eFilter);
+
+// R8G8B8A8_UNORM 체인의 0번 밉만 남기고 나머지를 끝까지 다시 만듦
+// bSRGB면 RGB를 선형 공간으로 풀어서 거른 뒤 다시 감마를 입힘, 알파는 항상 선형
+// 가로, 세로를 따로 거르고 픽셀 하나를 SSE 레지스터 하나로 계산
+void GenerateFilteredMips(TextureMipChain& mipChain, const EMipFilter eFilter, const bool bSRGB);
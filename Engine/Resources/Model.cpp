@@ -13,6 +13,26 @@ Model::Model(
 	: mPath(path)
 	, mModelData(data)
 	, mBoundingSphereLocal(center, radius)
+	, mRevision(0)
+	, mbPlaceholder(false)
 {
 	ASSERT(radius > 0.f);
 }
+
+void Model::SetModelData(const ModelData& data, const Vector3 center, const float radius)
+{
+	ASSERT(radius > 0.f);
+
+	mModelData = data;
+	mBoundingSphereLocal = BoundingSphere(center, radius);
+
+	++mRevision;
+}
+
+void Model::SetSubmeshMaterial(const uint32_t submeshIndex, Material* const pMaterial)
+{
+	ASSERT(submeshIndex < mModelData.size());
+	ASSERT(pMaterial != nullptr);
+
+	mModelData[submeshIndex].second = pMaterial;
+}
\ No newline at end of file
@@ -36,11 +36,36 @@ public:
 		return mBoundingSphereLocal;
 	}
 
+	// 불러오기가 끝나면 대체 메쉬를 실제 메쉬로 교체, 프레임 경계에서만 호출
+	void SetModelData(const ModelData& data, const Vector3 center, const float radius);
+
+	// 경계가 그대로이므로 revision은 늘리지 않음
+	void SetSubmeshMaterial(const uint32_t submeshIndex, Material* const pMaterial);
+
+	// 바뀔 때마다 증가, 경계 구를 따로 들고 있는 쪽이 비교해서 갱신
+	uint32_t GetRevision() const
+	{
+		return mRevision;
+	}
+
+	bool IsPlaceholder() const
+	{
+		return mbPlaceholder;
+	}
+
+	void SetPlaceholder(const bool bPlaceholder)
+	{
+		mbPlaceholder = bPlaceholder;
+	}
+
 private:
 	std::string mPath;
 	ModelData mModelData;
 	BoundingSphere mBoundingSphereLocal;
 
+	uint32_t mRevision;
+	bool mbPlaceholder;
+
 private:
 	Model(const Model& other) = delete;
 	Model& operator=(const Model& other) = delete;
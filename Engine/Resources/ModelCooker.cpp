@@ -0,0 +1,996 @@
+#include "ModelCooker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <xmmintrin.h>
+
+#include <Windows.h>
+#include <Psapi.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include "Core/Assert.h"
+#include "Core/JobSystem.h"
+#include "MappedIOSystem.h"
+#include "MeshManager.h"
+
+enum
+{
+	// "GMDL"
+	COOKED_MODEL_MAGIC = 0x4C444D47,
+	// 2: 최적화된 인덱스 순서
+	// 3: 정점 합치기, 16비트 인덱스
+	// 4: 압축 정점과 위치 복원 값
+	// 5: 서브메쉬 내용 해시
+	// 6: 128비트 내용 해시
+	COOKED_MODEL_VERSION = 6,
+
+	// 정점/인덱스 덩어리 시작 위치 정렬
+	COOKED_BLOB_ALIGNMENT = 16,
+
+	COOKED_SUBMESH_TEXTURED = 1 << 0
+};
+
+#define COOKED_MODEL_SUFFIX ".cooked.mdl"
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct CookedModelHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t fileSize;
+
+	uint32_t submeshCount;
+	uint32_t stringTableSize;
+
+	float center[3];
+	float boundingRadius;
+};
+
+// 오프셋은 파일 시작 기준
+struct CookedSubmesh
+{
+	uint64_t vertexOffset;
+	uint64_t indexOffset;
+
+	uint32_t vertexType;
+	uint32_t vertexCount;
+	uint32_t vertexStride;
+
+	uint32_t indexCount;
+	uint32_t indexStride;
+
+	uint32_t flags;
+
+	// 문자열 표 안의 오프셋과 길이
+	uint32_t texturePathOffset;
+	uint32_t texturePathLength;
+
+	float boundsMin[3];
+	float boundsMax[3];
+
+	float positionOffset[3];
+	float positionScale[3];
+
+	// MeshManager::CalculateContentHash, 불러올 때 다시 구하지 않음
+	uint64_t contentHashLow;
+	uint64_t contentHashHigh;
+};
+#pragma warning(pop)
+
+static_assert(sizeof(CookedModelHeader) == 40);
+static_assert(sizeof(CookedSubmesh) == 112);
+
+static uint64_t AlignBlobOffset(const uint64_t offset)
+{
+	return (offset + COOKED_BLOB_ALIGNMENT - 1) / COOKED_BLOB_ALIGNMENT * COOKED_BLOB_ALIGNMENT;
+}
+
+static uint32_t GetVertexStride(const Vertex::EType eVertexType)
+{
+	switch (eVertexType)
+	{
+	case Vertex::EType::POS_UV:
+		return sizeof(Vertex::PosUV);
+
+	case Vertex::EType::POS_NORMAL_UV:
+		return sizeof(Vertex::PosNormalUV);
+
+	case Vertex::EType::POS_NORMAL_UV_QUANTIZED:
+		return sizeof(Vertex::PosNormalUVQuantized);
+
+	default:
+		return 0;
+	}
+}
+
+// 범위를 벗어난 인덱스는 GPU가 버퍼 밖을 읽게 하므로 올리기 전에 막음
+// 덩어리는 COOKED_BLOB_ALIGNMENT로 정렬되어 있어 그대로 읽어도 됨
+template<typename TIndex>
+static bool AreIndicesInRange(const void* const pIndexData, const uint32_t indexCount, const uint32_t vertexCount)
+{
+	const TIndex* const pIndices = static_cast<const TIndex*>(pIndexData);
+
+	// 분기 없이 최댓값만 구해서 벡터화되게 함
+	TIndex maxIndex = 0;
+
+	for (uint32_t i = 0; i < indexCount; ++i)
+	{
+		maxIndex = pIndices[i] > maxIndex ? pIndices[i] : maxIndex;
+	}
+
+	return maxIndex < vertexCount;
+}
+
+// 노드 변환을 누적해 둔 그릴 메쉬 하나, 서로 독립이라 병렬로 변환함
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct MeshWorkItem
+{
+	const aiMesh* pMesh;
+	Matrix transform;
+};
+
+struct ConvertedSubmesh
+{
+	ImportedSubmesh submesh;
+
+	// 합친 뒤 삼각형이 남지 않았으면 true, 중심과 범위에는 그대로 넣음
+	bool bEmpty;
+
+	Vector3 positionSum;
+	uint32_t sourceVertexCount;
+
+	MeshOptimizeStats optimizeStats;
+	uint64_t sourceBytes;
+	uint64_t geometryBytes;
+};
+#pragma warning(pop)
+
+static void CollectMeshWorkItems(
+	const aiNode* const pNode,
+	const aiScene* const pScene,
+	const Matrix& parentTransform,
+	std::vector<MeshWorkItem>& outItems
+)
+{
+	Matrix m;
+	const ai_real* pTmp = &pNode->mTransformation.a1;
+	float* pMTmp = &m._11;
+
+	for (int t = 0; t < 16; ++t)
+	{
+		pMTmp[t] = static_cast<float>(pTmp[t]);
+	}
+	m = m.Transpose() * parentTransform;
+
+	for (UINT i = 0; i < pNode->mNumMeshes; ++i)
+	{
+		const aiMesh* const pMesh = pScene->mMeshes[pNode->mMeshes[i]];
+
+		// 그릴 것이 없는 메쉬는 버퍼를 만들 수 없음
+		if (pMesh->mNumVertices == 0 || pMesh->mNumFaces == 0)
+		{
+			continue;
+		}
+
+		MeshWorkItem item;
+		item.pMesh = pMesh;
+		item.transform = m;
+
+		outItems.push_back(item);
+	}
+
+	for (UINT i = 0; i < pNode->mNumChildren; ++i)
+	{
+		CollectMeshWorkItems(pNode->mChildren[i], pScene, m, outItems);
+	}
+}
+
+// Vector3::Transform과 같은 계산을 정점 4개씩 SoA로 처리하며 범위와 합도 구함
+static void TransformPositionsSimd(
+	const aiVector3D* const pSrc,
+	const uint32_t count,
+	const Matrix& m,
+	Vertex::PosNormalUV* const pDst,
+	Vector3& outMin,
+	Vector3& outMax,
+	Vector3& outSum
+)
+{
+	const __m128 m11 = _mm_set1_ps(m._11), m12 = _mm_set1_ps(m._12), m13 = _mm_set1_ps(m._13), m14 = _mm_set1_ps(m._14);
+	const __m128 m21 = _mm_set1_ps(m._21), m22 = _mm_set1_ps(m._22), m23 = _mm_set1_ps(m._23), m24 = _mm_set1_ps(m._24);
+	const __m128 m31 = _mm_set1_ps(m._31), m32 = _mm_set1_ps(m._32), m33 = _mm_set1_ps(m._33), m34 = _mm_set1_ps(m._34);
+	const __m128 m41 = _mm_set1_ps(m._41), m42 = _mm_set1_ps(m._42), m43 = _mm_set1_ps(m._43), m44 = _mm_set1_ps(m._44);
+
+	const __m128 one = _mm_set1_ps(1.f);
+
+	__m128 minX = _mm_set1_ps(FLT_MAX), minY = minX, minZ = minX;
+	__m128 maxX = _mm_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;
+	__m128 sumX = _mm_setzero_ps(), sumY = sumX, sumZ = sumX;
+
+	alignas(16) float resultX[4];
+	alignas(16) float resultY[4];
+	alignas(16) float resultZ[4];
+
+	uint32_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x = _mm_setr_ps(pSrc[i].x, pSrc[i + 1].x, pSrc[i + 2].x, pSrc[i + 3].x);
+		const __m128 y = _mm_setr_ps(pSrc[i].y, pSrc[i + 1].y, pSrc[i + 2].y, pSrc[i + 3].y);
+		const __m128 z = _mm_setr_ps(pSrc[i].z, pSrc[i + 1].z, pSrc[i + 2].z, pSrc[i + 3].z);
+
+		const __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m14), _mm_mul_ps(y, m24)), _mm_add_ps(_mm_mul_ps(z, m34), m44));
+		const __m128 invW = _mm_div_ps(one, w);
+
+		const __m128 outX = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), _mm_add_ps(_mm_mul_ps(z, m31), m41)), invW);
+		const __m128 outY = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), _mm_add_ps(_mm_mul_ps(z, m32), m42)), invW);
+		const __m128 outZ = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13), _mm_mul_ps(y, m23)), _mm_add_ps(_mm_mul_ps(z, m33), m43)), invW);
+
+		minX = _mm_min_ps(minX, outX);
+		minY = _mm_min_ps(minY, outY);
+		minZ = _mm_min_ps(minZ, outZ);
+		maxX = _mm_max_ps(maxX, outX);
+		maxY = _mm_max_ps(maxY, outY);
+		maxZ = _mm_max_ps(maxZ, outZ);
+		sumX = _mm_add_ps(sumX, outX);
+		sumY = _mm_add_ps(sumY, outY);
+		sumZ = _mm_add_ps(sumZ, outZ);
+
+		_mm_store_ps(resultX, outX);
+		_mm_store_ps(resultY, outY);
+		_mm_store_ps(resultZ, outZ);
+
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			pDst[i + k].pos = Vector3(resultX[k], resultY[k], resultZ[k]);
+		}
+	}
+
+	// 레인을 하나로 모음
+	alignas(16) float lanes[9][4];
+	_mm_store_ps(lanes[0], minX);
+	_mm_store_ps(lanes[1], minY);
+	_mm_store_ps(lanes[2], minZ);
+	_mm_store_ps(lanes[3], maxX);
+	_mm_store_ps(lanes[4], maxY);
+	_mm_store_ps(lanes[5], maxZ);
+	_mm_store_ps(lanes[6], sumX);
+	_mm_store_ps(lanes[7], sumY);
+	_mm_store_ps(lanes[8], sumZ);
+
+	outMin = Vector3(lanes[0][0], lanes[1][0], lanes[2][0]);
+	outMax = Vector3(lanes[3][0], lanes[4][0], lanes[5][0]);
+	outSum = Vector3(lanes[6][0], lanes[7][0], lanes[8][0]);
+
+	for (uint32_t k = 1; k < 4; ++k)
+	{
+		outMin = Vector3::Min(outMin, Vector3(lanes[0][k], lanes[1][k], lanes[2][k]));
+		outMax = Vector3::Max(outMax, Vector3(lanes[3][k], lanes[4][k], lanes[5][k]));
+		outSum += Vector3(lanes[6][k], lanes[7][k], lanes[8][k]);
+	}
+
+	for (; i < count; ++i)
+	{
+		const Vector3 pos = Vector3::Transform(Vector3(pSrc[i].x, pSrc[i].y, pSrc[i].z), m);
+
+		pDst[i].pos = pos;
+
+		outMin = Vector3::Min(outMin, pos);
+		outMax = Vector3::Max(outMax, pos);
+		outSum += pos;
+	}
+}
+
+// 4개씩 SoA로 정규화, 길이가 0이면 0으로 둠
+static void NormalizeNormalsSimd(const aiVector3D* const pSrc, const uint32_t count, Vertex::PosNormalUV* const pDst)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	alignas(16) float resultX[4];
+	alignas(16) float resultY[4];
+	alignas(16) float resultZ[4];
+
+	uint32_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x = _mm_setr_ps(pSrc[i].x, pSrc[i + 1].x, pSrc[i + 2].x, pSrc[i + 3].x);
+		const __m128 y = _mm_setr_ps(pSrc[i].y, pSrc[i + 1].y, pSrc[i + 2].y, pSrc[i + 3].y);
+		const __m128 z = _mm_setr_ps(pSrc[i].z, pSrc[i + 1].z, pSrc[i + 2].z, pSrc[i + 3].z);
+
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+
+		// 0으로 나눈 레인은 마스크로 지움
+		const __m128 invLength = _mm_and_ps(_mm_div_ps(one, length), _mm_cmpgt_ps(length, zero));
+
+		_mm_store_ps(resultX, _mm_mul_ps(x, invLength));
+		_mm_store_ps(resultY, _mm_mul_ps(y, invLength));
+		_mm_store_ps(resultZ, _mm_mul_ps(z, invLength));
+
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			pDst[i + k].normal = Vector3(resultX[k], resultY[k], resultZ[k]);
+		}
+	}
+
+	for (; i < count; ++i)
+	{
+		Vector3 normal(pSrc[i].x, pSrc[i].y, pSrc[i].z);
+		normal.Normalize();
+
+		pDst[i].normal = normal;
+	}
+}
+
+static void ConvertSubmesh(const MeshWorkItem& item, const aiScene* const pScene, ConvertedSubmesh& outConverted)
+{
+	const aiMesh* const pMesh = item.pMesh;
+
+	ImportedSubmesh& submesh = outConverted.submesh;
+
+	outConverted.bEmpty = false;
+	outConverted.sourceVertexCount = pMesh->mNumVertices;
+	outConverted.sourceBytes = 0;
+	outConverted.geometryBytes = 0;
+
+	// Process Mesh
+	std::vector<Vertex::PosNormalUV>& vertices = submesh.vertices;
+	vertices.resize(pMesh->mNumVertices);
+
+	TransformPositionsSimd(pMesh->mVertices, pMesh->mNumVertices, item.transform, vertices.data(), submesh.boundsMin, submesh.boundsMax, outConverted.positionSum);
+
+	if (pMesh->mNormals != nullptr)
+	{
+		NormalizeNormalsSimd(pMesh->mNormals, pMesh->mNumVertices, vertices.data());
+	}
+	else
+	{
+		for (Vertex::PosNormalUV& vertex : vertices)
+		{
+			vertex.normal = Vector3::Zero;
+		}
+	}
+
+	const aiVector3D* const pTextureCoords = pMesh->mTextureCoords[0];
+
+	for (UINT j = 0; j < pMesh->mNumVertices; ++j)
+	{
+		if (pTextureCoords != nullptr)
+		{
+			vertices[j].uv.x = static_cast<float>(pTextureCoords[j].x);
+			vertices[j].uv.y = static_cast<float>(pTextureCoords[j].y);
+		}
+		else
+		{
+			vertices[j].uv = Vector2::Zero;
+		}
+	}
+
+	// 면마다 넣지 않고 크기를 먼저 세어 한 번에 채움
+	size_t indexCount = 0;
+
+	for (UINT j = 0; j < pMesh->mNumFaces; ++j)
+	{
+		indexCount += pMesh->mFaces[j].mNumIndices;
+	}
+
+	std::vector<uint32_t>& indices = submesh.indices;
+	indices.resize(indexCount);
+
+	uint32_t* pIndex = indices.data();
+
+	for (UINT j = 0; j < pMesh->mNumFaces; ++j)
+	{
+		const aiFace& face = pMesh->mFaces[j];
+
+		memcpy(pIndex, face.mIndices, sizeof(uint32_t) * face.mNumIndices);
+		pIndex += face.mNumIndices;
+	}
+
+	// Only use baseColor texture
+	std::string texturePath = "./Assets/";
+	submesh.bHasTexture = false;
+
+	if (pMesh->mMaterialIndex >= 0)
+	{
+		const aiMaterial* const pMaterial = pScene->mMaterials[pMesh->mMaterialIndex];
+
+		aiString aiMaterialName;
+
+		if (pMaterial->Get(AI_MATKEY_NAME, aiMaterialName) == AI_SUCCESS)
+		{
+			texturePath.append("miyako/textures/i_");
+			texturePath.append(aiMaterialName.C_Str());
+			texturePath.append("_BaseColor.png");
+		}
+
+		std::filesystem::path fsTexturePath(texturePath);
+		if (std::filesystem::exists(fsTexturePath))
+		{
+			texturePath = fsTexturePath.string();
+
+			submesh.bHasTexture = true;
+		}
+		else
+		{
+			texturePath.append("Default.dds");
+		}
+	}
+
+	submesh.texturePath = std::move(texturePath);
+
+	outConverted.sourceBytes = vertices.size() * sizeof(Vertex::PosNormalUV) + indices.size() * sizeof(uint32_t);
+
+	OptimizeMesh(submesh.vertices, submesh.indices, outConverted.optimizeStats);
+
+	// 합치고 나니 넓이 있는 삼각형이 없음
+	if (submesh.indices.empty())
+	{
+		outConverted.bEmpty = true;
+
+		return;
+	}
+
+	QuantizeVertices(vertices, submesh.boundsMin, submesh.boundsMax, submesh.quantizedVertices, submesh.positionOffset, submesh.positionScale);
+	MeasureQuantizationError(vertices, submesh.quantizedVertices, submesh.positionOffset, submesh.positionScale, submesh.quantizationError);
+
+	submesh.bQuantized = IsQuantizationErrorAcceptable(submesh.quantizationError);
+
+	size_t vertexStride = sizeof(Vertex::PosNormalUVQuantized);
+
+	if (!submesh.bQuantized)
+	{
+		submesh.quantizedVertices.clear();
+		submesh.positionOffset = Vector3::Zero;
+		submesh.positionScale = Vector3::One;
+
+		vertexStride = sizeof(Vertex::PosNormalUV);
+	}
+
+	const uint32_t indexStride = GetSubmeshIndexStride(vertices.size());
+
+	outConverted.geometryBytes = vertices.size() * vertexStride + indices.size() * indexStride;
+
+	// 올리는 배치 그대로 해시해야 쿠킹된 파일과 값이 같음
+	const void* pIndexData = indices.data();
+	std::vector<uint16_t> shortIndices;
+
+	if (indexStride == sizeof(uint16_t))
+	{
+		shortIndices.resize(indices.size());
+
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			shortIndices[i] = static_cast<uint16_t>(indices[i]);
+		}
+
+		pIndexData = shortIndices.data();
+	}
+
+	submesh.contentHash = MeshManager::CalculateContentHash(
+		submesh.bQuantized ? Vertex::EType::POS_NORMAL_UV_QUANTIZED : Vertex::EType::POS_NORMAL_UV,
+		submesh.bQuantized ? static_cast<const void*>(submesh.quantizedVertices.data()) : static_cast<const void*>(vertices.data()),
+		static_cast<UINT>(vertices.size()),
+		static_cast<UINT>(vertexStride),
+		pIndexData,
+		static_cast<UINT>(indices.size()),
+		indexStride,
+		submesh.positionOffset,
+		submesh.positionScale
+	);
+}
+
+static uint64_t GetProcessPrivateBytes()
+{
+	PROCESS_MEMORY_COUNTERS_EX counters = {};
+
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+	{
+		return 0;
+	}
+
+	return counters.PrivateUsage;
+}
+
+// Assimp가 단계마다 진행을 알릴 때 커밋 크기를 재서 가장 큰 값을 남김
+// 매핑한 파일 뷰는 커밋에 들어가지 않으므로 읽기 버퍼 차이가 그대로 보임
+class PeakMemoryProgressHandler final : public Assimp::ProgressHandler
+{
+public:
+	PeakMemoryProgressHandler(uint64_t& inOutPeakBytes)
+		: mPeakBytes(inOutPeakBytes)
+	{
+	}
+
+	virtual ~PeakMemoryProgressHandler() = default;
+
+	virtual bool Update(float) override
+	{
+		const uint64_t privateBytes = GetProcessPrivateBytes();
+
+		mPeakBytes = privateBytes > mPeakBytes ? privateBytes : mPeakBytes;
+
+		// 중간에 멈추지 않음
+		return true;
+	}
+
+private:
+	uint64_t& mPeakBytes;
+};
+
+bool TryImportModel(
+	const std::string& sourcePath,
+	ImportedModel& outModel,
+	const bool bParallel,
+	ImportProgress* const pProgress,
+	MappedFileCache* const pFileCache
+)
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point readStart = Clock::now();
+
+	const uint64_t startPrivateBytes = GetProcessPrivateBytes();
+	uint64_t peakPrivateBytes = startPrivateBytes;
+
+	Assimp::Importer importer;
+
+	// 둘 다 Importer가 해제함
+	importer.SetProgressHandler(new PeakMemoryProgressHandler(peakPrivateBytes));
+
+	if (pFileCache != nullptr)
+	{
+		importer.SetIOHandler(new MappedIOSystem(*pFileCache));
+	}
+
+	const aiScene* const pScene = importer.ReadFile(
+		sourcePath,
+		aiProcess_Triangulate | aiProcess_ConvertToLeftHanded
+	);
+
+	if (pScene == nullptr || pScene->mRootNode == nullptr)
+	{
+		return false;
+	}
+
+	const Clock::time_point convertStart = Clock::now();
+
+	outModel.submeshes.clear();
+	outModel.optimizeStats = {};
+	outModel.sourceBytes = 0;
+	outModel.geometryBytes = 0;
+	outModel.quantizedSubmeshCount = 0;
+	outModel.quantizationError = {};
+	outModel.convertThreadCount = 1;
+
+	std::vector<MeshWorkItem> items;
+	items.reserve(pScene->mNumMeshes);
+
+	Matrix tr;
+
+	CollectMeshWorkItems(pScene->mRootNode, pScene, tr, items);
+
+	const uint32_t itemCount = static_cast<uint32_t>(items.size());
+
+	if (pProgress != nullptr)
+	{
+		pProgress->convertedMeshCount = 0;
+		pProgress->meshCount = itemCount;
+	}
+
+	std::vector<ConvertedSubmesh> convertedSubmeshes(itemCount);
+
+	// 큰 메쉬부터 꺼내 가도록 정렬, 결과는 노드 순서 자리에 씀
+	std::vector<uint32_t> order(itemCount);
+
+	for (uint32_t i = 0; i < itemCount; ++i)
+	{
+		order[i] = i;
+	}
+
+	std::sort(order.begin(), order.end(), [&items](const uint32_t lhs, const uint32_t rhs)
+		{
+			return items[lhs].pMesh->mNumVertices > items[rhs].pMesh->mNumVertices;
+		});
+
+	const JobSystem::ChunkFunction convertChunk = [&items, &order, &convertedSubmeshes, pScene, pProgress](const uint32_t begin, const uint32_t end, const uint32_t)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				ConvertSubmesh(items[order[i]], pScene, convertedSubmeshes[order[i]]);
+
+				if (pProgress != nullptr)
+				{
+					++pProgress->convertedMeshCount;
+				}
+			}
+		};
+
+	if (bParallel && itemCount > 1 && JobSystem::IsInitialized())
+	{
+		JobSystem& jobSystem = JobSystem::GetInstance();
+
+		const uint32_t threadCount = jobSystem.GetWorkerCount() + 1;
+
+		outModel.convertThreadCount = threadCount < itemCount ? threadCount : itemCount;
+
+		// 메쉬 하나씩 꺼내 가서 크기가 달라도 고르게 나뉨
+		jobSystem.ParallelFor(itemCount, itemCount, convertChunk);
+	}
+	else
+	{
+		convertChunk(0, itemCount, 0);
+	}
+
+	// 노드 순서대로 합쳐서 결과가 스레드 수와 무관함
+	Vector3 center = Vector3::Zero;
+	uint32_t totalVertices = 0;
+
+	Vector3 minVector(FLT_MAX, FLT_MAX, FLT_MAX);
+	Vector3 maxVector = -minVector;
+
+	outModel.submeshes.reserve(itemCount);
+
+	for (ConvertedSubmesh& converted : convertedSubmeshes)
+	{
+		center += converted.positionSum;
+		totalVertices += converted.sourceVertexCount;
+
+		minVector = Vector3::Min(minVector, converted.submesh.boundsMin);
+		maxVector = Vector3::Max(maxVector, converted.submesh.boundsMax);
+
+		outModel.sourceBytes += converted.sourceBytes;
+
+		AccumulateVertexCacheStats(outModel.optimizeStats.before, converted.optimizeStats.before);
+		AccumulateVertexCacheStats(outModel.optimizeStats.after, converted.optimizeStats.after);
+		outModel.optimizeStats.clusterCount += converted.optimizeStats.clusterCount;
+		outModel.optimizeStats.degenerateTriangleCount += converted.optimizeStats.degenerateTriangleCount;
+		outModel.optimizeStats.optimizeTimeMs += converted.optimizeStats.optimizeTimeMs;
+
+		if (converted.bEmpty)
+		{
+			continue;
+		}
+
+		if (converted.submesh.bQuantized)
+		{
+			++outModel.quantizedSubmeshCount;
+			AccumulateQuantizationError(outModel.quantizationError, converted.submesh.quantizationError);
+		}
+
+		outModel.geometryBytes += converted.geometryBytes;
+
+		outModel.submeshes.push_back(std::move(converted.submesh));
+	}
+
+	if (totalVertices == 0 || outModel.submeshes.empty())
+	{
+		return false;
+	}
+
+	outModel.center = center / static_cast<float>(totalVertices);
+	outModel.boundingRadius = (maxVector - minVector).Length() * 0.5f;
+
+	outModel.readTimeMs = Milliseconds(convertStart - readStart).count();
+	outModel.convertTimeMs = Milliseconds(Clock::now() - convertStart).count();
+
+	// 변환 결과와 장면이 함께 살아 있는 지금이 보통 가장 큼
+	const uint64_t endPrivateBytes = GetProcessPrivateBytes();
+	peakPrivateBytes = endPrivateBytes > peakPrivateBytes ? endPrivateBytes : peakPrivateBytes;
+
+	outModel.peakMemoryBytes = peakPrivateBytes - startPrivateBytes;
+
+	return true;
+}
+
+uint32_t GetSubmeshIndexStride(const size_t vertexCount)
+{
+	return vertexCount <= 0x10000 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+std::string GetCookedModelPath(const std::string& sourcePath)
+{
+	const size_t separatorPosition = sourcePath.find_last_of("/\\");
+	const size_t dotPosition = sourcePath.find_last_of('.');
+
+	if (dotPosition == std::string::npos || (separatorPosition != std::string::npos && dotPosition < separatorPosition))
+	{
+		return sourcePath + COOKED_MODEL_SUFFIX;
+	}
+
+	return sourcePath.substr(0, dotPosition) + COOKED_MODEL_SUFFIX;
+}
+
+bool IsCookedModelUpToDate(const std::string& sourcePath)
+{
+	const std::string cookedPath = GetCookedModelPath(sourcePath);
+
+	std::error_code errorCode;
+
+	const std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedPath, errorCode);
+
+	if (errorCode)
+	{
+		return false;
+	}
+
+	const std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourcePath, errorCode);
+
+	return !errorCode && cookedTime >= sourceTime;
+}
+
+bool TrySaveCookedModel(const char* const path, const ImportedModel& model, uint64_t& outFileBytes)
+{
+	ASSERT(path != nullptr);
+
+	const uint32_t submeshCount = static_cast<uint32_t>(model.submeshes.size());
+
+	// 1. 문자열 표와 덩어리 위치를 먼저 정함
+	std::vector<CookedSubmesh> table(submeshCount);
+	std::string stringTable;
+
+	for (uint32_t i = 0; i < submeshCount; ++i)
+	{
+		const ImportedSubmesh& submesh = model.submeshes[i];
+		CookedSubmesh& entry = table[i];
+
+		entry.texturePathOffset = static_cast<uint32_t>(stringTable.size());
+		entry.texturePathLength = static_cast<uint32_t>(submesh.texturePath.size());
+
+		stringTable.append(submesh.texturePath);
+	}
+
+	uint64_t offset = sizeof(CookedModelHeader) + sizeof(CookedSubmesh) * static_cast<uint64_t>(submeshCount) + stringTable.size();
+
+	for (uint32_t i = 0; i < submeshCount; ++i)
+	{
+		const ImportedSubmesh& submesh = model.submeshes[i];
+		CookedSubmesh& entry = table[i];
+
+		const Vertex::EType eVertexType = submesh.bQuantized ? Vertex::EType::POS_NORMAL_UV_QUANTIZED : Vertex::EType::POS_NORMAL_UV;
+
+		entry.vertexType = static_cast<uint32_t>(eVertexType);
+		entry.vertexCount = static_cast<uint32_t>(submesh.vertices.size());
+		entry.vertexStride = GetVertexStride(eVertexType);
+		entry.vertexOffset = AlignBlobOffset(offset);
+
+		offset = entry.vertexOffset + static_cast<uint64_t>(entry.vertexCount) * entry.vertexStride;
+
+		entry.indexCount = static_cast<uint32_t>(submesh.indices.size());
+		entry.indexStride = GetSubmeshIndexStride(submesh.vertices.size());
+		entry.indexOffset = AlignBlobOffset(offset);
+
+		offset = entry.indexOffset + static_cast<uint64_t>(entry.indexCount) * entry.indexStride;
+
+		entry.flags = submesh.bHasTexture ? COOKED_SUBMESH_TEXTURED : 0;
+
+		memcpy(entry.boundsMin, &submesh.boundsMin, sizeof(entry.boundsMin));
+		memcpy(entry.boundsMax, &submesh.boundsMax, sizeof(entry.boundsMax));
+		memcpy(entry.positionOffset, &submesh.positionOffset, sizeof(entry.positionOffset));
+		memcpy(entry.positionScale, &submesh.positionScale, sizeof(entry.positionScale));
+		entry.contentHashLow = submesh.contentHash.low;
+		entry.contentHashHigh = submesh.contentHash.high;
+	}
+
+	CookedModelHeader header;
+	header.magic = COOKED_MODEL_MAGIC;
+	header.version = COOKED_MODEL_VERSION;
+	header.fileSize = offset;
+	header.submeshCount = submeshCount;
+	header.stringTableSize = static_cast<uint32_t>(stringTable.size());
+	memcpy(header.center, &model.center, sizeof(header.center));
+	header.boundingRadius = model.boundingRadius;
+
+	// 2. 순서대로 기록, 정렬 사이는 0으로 채움
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(sizeof(CookedSubmesh) * table.size()));
+	file.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+
+	const char padding[COOKED_BLOB_ALIGNMENT] = {};
+
+	std::vector<uint16_t> shortIndices;
+
+	uint64_t position = sizeof(CookedModelHeader) + sizeof(CookedSubmesh) * static_cast<uint64_t>(submeshCount) + stringTable.size();
+
+	for (uint32_t i = 0; i < submeshCount; ++i)
+	{
+		const ImportedSubmesh& submesh = model.submeshes[i];
+		const CookedSubmesh& entry = table[i];
+
+		file.write(padding, static_cast<std::streamsize>(entry.vertexOffset - position));
+		const void* const pVertexData = submesh.bQuantized
+			? static_cast<const void*>(submesh.quantizedVertices.data())
+			: static_cast<const void*>(submesh.vertices.data());
+
+		file.write(static_cast<const char*>(pVertexData), static_cast<std::streamsize>(entry.vertexCount) * entry.vertexStride);
+
+		position = entry.vertexOffset + static_cast<uint64_t>(entry.vertexCount) * entry.vertexStride;
+
+		file.write(padding, static_cast<std::streamsize>(entry.indexOffset - position));
+
+		if (entry.indexStride == sizeof(uint16_t))
+		{
+			shortIndices.resize(submesh.indices.size());
+
+			for (size_t j = 0; j < submesh.indices.size(); ++j)
+			{
+				shortIndices[j] = static_cast<uint16_t>(submesh.indices[j]);
+			}
+
+			file.write(reinterpret_cast<const char*>(shortIndices.data()), static_cast<std::streamsize>(entry.indexCount) * entry.indexStride);
+		}
+		else
+		{
+			file.write(reinterpret_cast<const char*>(submesh.indices.data()), static_cast<std::streamsize>(entry.indexCount) * entry.indexStride);
+		}
+
+		position = entry.indexOffset + static_cast<uint64_t>(entry.indexCount) * entry.indexStride;
+	}
+
+	ASSERT(position == header.fileSize);
+
+	const bool bSucceeded = file.good();
+
+	file.close();
+
+	if (!bSucceeded)
+	{
+		// 반쯤 쓴 파일이 최신으로 보이지 않게 지움
+		std::error_code errorCode;
+		std::filesystem::remove(path, errorCode);
+
+		return false;
+	}
+
+	outFileBytes = header.fileSize;
+
+	return true;
+}
+
+bool TryParseCookedModel(const uint8_t* const pData, const size_t size, CookedModelView& outView)
+{
+	ASSERT(pData != nullptr);
+
+	if (size < sizeof(CookedModelHeader))
+	{
+		return false;
+	}
+
+	CookedModelHeader header;
+	memcpy(&header, pData, sizeof(header));
+
+	if (header.magic != COOKED_MODEL_MAGIC || header.version != COOKED_MODEL_VERSION || header.fileSize != size)
+	{
+		return false;
+	}
+
+	const uint64_t stringTableOffset = sizeof(CookedModelHeader) + sizeof(CookedSubmesh) * static_cast<uint64_t>(header.submeshCount);
+
+	if (stringTableOffset + header.stringTableSize > size)
+	{
+		return false;
+	}
+
+	const char* const pStringTable = reinterpret_cast<const char*>(pData + stringTableOffset);
+
+	outView.submeshes.clear();
+	outView.submeshes.reserve(header.submeshCount);
+
+	for (uint32_t i = 0; i < header.submeshCount; ++i)
+	{
+		CookedSubmesh entry;
+		memcpy(&entry, pData + sizeof(CookedModelHeader) + sizeof(CookedSubmesh) * i, sizeof(entry));
+
+		const Vertex::EType eVertexType = static_cast<Vertex::EType>(entry.vertexType);
+
+		if (entry.vertexType >= static_cast<uint32_t>(Vertex::GetVertexTypeCount())
+			|| entry.vertexStride != GetVertexStride(eVertexType)
+			|| (entry.indexStride != sizeof(uint16_t) && entry.indexStride != sizeof(uint32_t))
+			|| entry.vertexCount == 0
+			|| entry.indexCount == 0
+			|| entry.vertexOffset % COOKED_BLOB_ALIGNMENT != 0
+			|| entry.indexOffset % COOKED_BLOB_ALIGNMENT != 0
+			|| entry.vertexOffset + static_cast<uint64_t>(entry.vertexCount) * entry.vertexStride > size
+			|| entry.indexOffset + static_cast<uint64_t>(entry.indexCount) * entry.indexStride > size
+			|| static_cast<uint64_t>(entry.texturePathOffset) + entry.texturePathLength > header.stringTableSize)
+		{
+			return false;
+		}
+
+		const bool bIndicesInRange = entry.indexStride == sizeof(uint16_t)
+			? AreIndicesInRange<uint16_t>(pData + entry.indexOffset, entry.indexCount, entry.vertexCount)
+			: AreIndicesInRange<uint32_t>(pData + entry.indexOffset, entry.indexCount, entry.vertexCount);
+
+		if (!bIndicesInRange)
+		{
+			return false;
+		}
+
+		CookedSubmeshView submesh;
+		submesh.eVertexType = eVertexType;
+		submesh.pVertexData = pData + entry.vertexOffset;
+		submesh.vertexCount = entry.vertexCount;
+		submesh.vertexStride = entry.vertexStride;
+		submesh.pIndexData = pData + entry.indexOffset;
+		submesh.indexCount = entry.indexCount;
+		submesh.indexStride = entry.indexStride;
+		submesh.texturePath.assign(pStringTable + entry.texturePathOffset, entry.texturePathLength);
+		submesh.bHasTexture = (entry.flags & COOKED_SUBMESH_TEXTURED) != 0;
+		submesh.boundsMin = Vector3(entry.boundsMin);
+		submesh.boundsMax = Vector3(entry.boundsMax);
+		submesh.positionOffset = Vector3(entry.positionOffset);
+		submesh.positionScale = Vector3(entry.positionScale);
+		submesh.contentHash = { entry.contentHashLow, entry.contentHashHigh };
+
+		outView.submeshes.push_back(std::move(submesh));
+	}
+
+	outView.center = Vector3(header.center);
+	outView.boundingRadius = header.boundingRadius;
+
+	return true;
+}
+
+bool TryCookModel(const std::string& sourcePath, MappedFileCache* const pFileCache, ModelCookStats& outStats)
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point importStart = Clock::now();
+
+	ImportedModel model;
+
+	if (!TryImportModel(sourcePath, model, true, nullptr, pFileCache))
+	{
+		return false;
+	}
+
+	const Clock::time_point writeStart = Clock::now();
+
+	uint64_t fileBytes;
+
+	if (!TrySaveCookedModel(GetCookedModelPath(sourcePath).c_str(), model, fileBytes))
+	{
+		return false;
+	}
+
+	outStats.submeshCount = static_cast<uint32_t>(model.submeshes.size());
+	outStats.vertexCount = 0;
+	outStats.indexCount = 0;
+
+	for (const ImportedSubmesh& submesh : model.submeshes)
+	{
+		outStats.vertexCount += static_cast<uint32_t>(submesh.vertices.size());
+		outStats.indexCount += static_cast<uint32_t>(submesh.indices.size());
+	}
+
+	outStats.cookedBytes = fileBytes;
+	outStats.optimizeStats = model.optimizeStats;
+	outStats.sourceBytes = model.sourceBytes;
+	outStats.geometryBytes = model.geometryBytes;
+	outStats.quantizedSubmeshCount = model.quantizedSubmeshCount;
+	outStats.quantizationError = model.quantizationError;
+	outStats.importTimeMs = Milliseconds(writeStart - importStart).count();
+	outStats.writeTimeMs = Milliseconds(Clock::now() - writeStart).count();
+
+	return true;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "Core/HashHelper.h"
+#include "Core/MathHelper.h"
+#include "Renderer/Vertex.h"
+#include "MeshOptimizer.h"
+#include "VertexQuantizer.h"
+
+// 원본 모델(FBX, glTF 등)을 Assimp로 읽어 엔진 전용 바이너리로 굽는 도구
+// 쿠킹된 파일은 GPU 배치 그대로인 정점/인덱스 덩어리와 서브메쉬 표, 범위, 재질 참조를 담음
+// 불러올 때는 매핑한 파일의 헤더만 검사하고 덩어리를 그대로 버퍼로 올림
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct ImportedSubmesh
+{
+	std::vector<Vertex::PosNormalUV> vertices;
+	std::vector<uint32_t> indices;
+
+	// 재질 참조, 텍스처가 없으면 bHasTexture가 false
+	std::string texturePath;
+	bool bHasTexture;
+
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+
+	// 오차가 기준 안이면 bQuantized가 true이고 quantizedVertices를 대신 올림
+	std::vector<Vertex::PosNormalUVQuantized> quantizedVertices;
+	bool bQuantized;
+
+	Vector3 positionOffset;
+	Vector3 positionScale;
+
+	VertexQuantizationError quantizationError;
+
+	// 메쉬 중복 제거용, 올리는 정점/인덱스 배치 기준
+	Hash128 contentHash;
+};
+
+struct ImportedModel
+{
+	std::vector<ImportedSubmesh> submeshes;
+
+	Vector3 center;
+	float boundingRadius;
+
+	// 서브메쉬 최적화 통계의 합
+	MeshOptimizeStats optimizeStats;
+
+	// 정점 하나씩, 32비트 인덱스로 올렸을 때와 실제로 올리는 크기
+	uint64_t sourceBytes;
+	uint64_t geometryBytes;
+
+	// 압축한 서브메쉬 수와 그 중 가장 큰 오차
+	uint32_t quantizedSubmeshCount;
+	VertexQuantizationError quantizationError;
+
+	// Assimp 파일 읽기와 노드별 메쉬 변환 시간, 변환에 쓴 스레드 수
+	float readTimeMs;
+	float convertTimeMs;
+	uint32_t convertThreadCount;
+
+	// 불러오는 동안 잰 프로세스 커밋 크기의 최대 증가량, 다른 스레드의 할당도 섞임
+	uint64_t peakMemoryBytes;
+};
+
+class MappedFileCache;
+
+// 불러오는 스레드가 쓰고 다른 스레드가 읽음, 메쉬 수가 0이면 아직 파일을 읽는 중
+struct ImportProgress
+{
+	std::atomic<uint32_t> meshCount;
+	std::atomic<uint32_t> convertedMeshCount;
+};
+
+// 매핑된 파일 안을 가리키므로 파일이 열려 있는 동안만 유효
+struct CookedSubmeshView
+{
+	Vertex::EType eVertexType;
+
+	const void* pVertexData;
+	uint32_t vertexCount;
+	uint32_t vertexStride;
+
+	const void* pIndexData;
+	uint32_t indexCount;
+	uint32_t indexStride;
+
+	std::string texturePath;
+	bool bHasTexture;
+
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+
+	// 압축하지 않은 정점이면 0과 1
+	Vector3 positionOffset;
+	Vector3 positionScale;
+
+	Hash128 contentHash;
+};
+
+struct CookedModelView
+{
+	std::vector<CookedSubmeshView> submeshes;
+
+	Vector3 center;
+	float boundingRadius;
+};
+
+struct ModelCookStats
+{
+	uint32_t submeshCount;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+
+	uint64_t cookedBytes;
+
+	uint64_t sourceBytes;
+	uint64_t geometryBytes;
+
+	uint32_t quantizedSubmeshCount;
+	VertexQuantizationError quantizationError;
+
+	float importTimeMs;
+	float writeTimeMs;
+
+	MeshOptimizeStats optimizeStats;
+};
+#pragma warning(pop)
+
+// 노드 변환을 적용한 정점으로 서브메쉬를 만들고 정점 캐시, 오버드로, 정점 읽기 순서를 최적화함
+// 압축 오차가 기준 안인 서브메쉬는 Vertex::PosNormalUVQuantized로 줄임
+// 실패하면 false
+// bParallel이면 노드를 메쉬 작업 목록으로 펼친 뒤 JobSystem으로 나눠 변환, 결과는 스레드 수와 무관함
+// pProgress가 있으면 변환한 메쉬 수를 알림
+// pFileCache가 있으면 모델과 딸린 파일을 매핑해서 읽고, 없으면 Assimp 기본 입출력을 씀
+bool TryImportModel(
+	const std::string& sourcePath,
+	ImportedModel& outModel,
+	const bool bParallel,
+	ImportProgress* const pProgress,
+	MappedFileCache* const pFileCache
+);
+
+// 정점이 65536개 이하면 16비트 인덱스
+uint32_t GetSubmeshIndexStride(const size_t vertexCount);
+
+// 원본 옆의 "<이름>.cooked.mdl"
+std::string GetCookedModelPath(const std::string& sourcePath);
+
+// 쿠킹된 파일이 있고 원본보다 새로우면 true
+bool IsCookedModelUpToDate(const std::string& sourcePath);
+
+bool TrySaveCookedModel(const char* const path, const ImportedModel& model, uint64_t& outFileBytes);
+
+// 헤더와 표의 범위, 인덱스가 정점 수 안인지 검사하고 덩어리는 복사하지 않음
+bool TryParseCookedModel(const uint8_t* const pData, const size_t size, CookedModelView& outView);
+
+// 원본을 읽어 GetCookedModelPath에 저장
+bool TryCookModel(const std::string& sourcePath, MappedFileCache* const pFileCache, ModelCookStats& outStats);
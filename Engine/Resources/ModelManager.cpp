@@ -1,27 +1,76 @@
 #include "ModelManager.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <functional>
 
 #include "Core/Assert.h"
+#include "Core/LogHelper.h"
+#include "Core/MappedFile.h"
+#include "Core/JobSystem.h"
 #include "UI/ImGuiHeaders.h"
 #include "Core/CommonDefs.h"
 #include "Core/FileDialog.h"
-#include "TextureManager.h"
 #include "MeshManager.h"
 #include "MaterialManager.h"
 #include "Shape.h"
 
 enum
 {
-	DEFAULT_BUFFER_SIZE = 32
+	DEFAULT_BUFFER_SIZE = 32,
+
+	DEFAULT_MAX_UNUSED_COUNT = 8,
+	MAX_UNUSED_COUNT_LIMIT = 128
 };
 
 ModelManager* ModelManager::spInstance = nullptr;
 
+static float GetSavedPercent(const uint64_t sourceBytes, const uint64_t resultBytes)
+{
+	if (sourceBytes == 0)
+	{
+		return 0.f;
+	}
+
+	return 100.f * (1.f - static_cast<float>(resultBytes) / static_cast<float>(sourceBytes));
+}
+
 ModelManager::ModelManager()
 	: mLoadedModels()
+	, mLastLoadTimeMs(0.f)
+	, mbLastLoadCooked(false)
+	, mLastOptimizeStats{}
+	, mLastSourceBytes(0)
+	, mLastGeometryBytes(0)
+	, mLastQuantizedSubmeshCount(0)
+	, mLastSubmeshCount(0)
+	, mLastQuantizationError{}
+	, mLastReadTimeMs(0.f)
+	, mLastConvertTimeMs(0.f)
+	, mLastConvertThreadCount(0)
+	, mLastUploadTimeMs(0.f)
+	, mCookResults()
+	, mLoadBenchmarks()
+	, mPendingLoads()
+	, mLoadMutex()
+	, mLoadCondition()
+	, mCompletedLoads()
+	, mInFlightLoadCount(0)
+	, mLoadFailCount(0)
+	, mImportFileCache()
+	, mUploadBudgetMs(2.f)
+	, mLastUploadSliceMs(0.f)
+	, mShortIndices()
+	, mModelResidency()
+	, mUnusedModels()
+	, mMaxUnusedCount(DEFAULT_MAX_UNUSED_COUNT)
+	, mEvictCount(0)
 {
 	mLoadedModels.reserve(DEFAULT_BUFFER_SIZE);
+	mModelResidency.reserve(DEFAULT_BUFFER_SIZE);
 
 	MeshManager& meshManager = MeshManager::GetInstance();
 	MaterialManager& materialManager = MaterialManager::GetInstance();
@@ -107,51 +156,138 @@ ModelManager::ModelManager()
 
 		mLoadedModels.insert(std::make_pair("Sphere", pSphereModel));
 	}
+
+	// 기본 도형은 매니저가 참조를 잡고 있어서 해제되지 않음
+	for (const std::pair<const std::string, Model*>& pair : mLoadedModels)
+	{
+		mModelResidency.insert(std::make_pair(pair.second, ModelResidency{ 1, mUnusedModels.end(), 0, false }));
+	}
 }
 
 ModelManager::~ModelManager()
 {
+	// 작업이 this를 참조하므로 모두 끝날 때까지 대기
+	{
+		std::unique_lock<std::mutex> lock(mLoadMutex);
+
+		mLoadCondition.wait(lock, [this]()
+			{
+				return mInFlightLoadCount == 0;
+			});
+	}
+
+	for (PendingLoad* const pLoad : mPendingLoads)
+	{
+		delete pLoad;
+	}
+
 	for (std::pair<const std::string, Model*>& pair : mLoadedModels)
 	{
 		delete pair.second;
 	}
 }
 
-void ModelManager::Load(const std::string& path)
+Model* ModelManager::Load(const std::string& path)
 {
-	Assimp::Importer importer;
+#define MAP_ITER std::unordered_map<std::string, Model*>::iterator
 
-	const aiScene* pScene = importer.ReadFile(
-		path,
-		aiProcess_Triangulate | aiProcess_ConvertToLeftHanded
-	);
+	MAP_ITER iter = mLoadedModels.find(path);
 
-	Matrix tr;
-	ModelData modelData;
+	if (iter != mLoadedModels.end())
+	{
+		Model* const pLoadedModel = iter->second;
+		ModelResidency& residency = mModelResidency[pLoadedModel];
 
-	Vector3 center = Vector3::Zero;
-	int totalVertices = 0;
+		if (!residency.bLoadFailed)
+		{
+			return pLoadedModel;
+		}
 
-	Vector3 minVector(D3D11_FLOAT32_MAX, D3D11_FLOAT32_MAX, D3D11_FLOAT32_MAX);
-	Vector3 maxVector = -minVector;
+		// 실패한 정육면체는 파일을 고쳤을 수 있으므로 같은 Model에 다시 불러옴
+		residency.bLoadFailed = false;
 
-	processNodeRecursive(
-		pScene->mRootNode,
-		pScene,
-		tr,
-		modelData,
-		center,
-		totalVertices,
-		minVector,
-		maxVector
-	);
+		AddRef(pLoadedModel);
+		beginLoad(pLoadedModel);
+
+		return pLoadedModel;
+	}
+
+#undef MAP_ITER
 
-	center /= static_cast<float>(totalVertices);
-	const float boundingRadius = (maxVector - minVector).Length() * 0.5f;
+	// 불러오는 동안 정육면체를 빌려 씀
+	const Model* const pCube = mLoadedModels["Cube"];
 
-	Model* pModel = new Model(path, modelData, center, boundingRadius);
+	Model* const pModel = new Model(path, pCube->GetModelData(), pCube->GetBoundingRadiusLocal().Center, pCube->GetBoundingRadiusLocal().Radius);
+	pModel->SetPlaceholder(true);
 
 	mLoadedModels.insert(std::make_pair(path, pModel));
+
+	// 불러오기가 참조 하나를 잡아서 읽거나 올리는 중에는 LRU에 들어가지 않음, 끝나면 UpdateLoading이 놓음
+	mModelResidency.insert(std::make_pair(pModel, ModelResidency{ 1, mUnusedModels.end(), 0, false }));
+
+	beginLoad(pModel);
+
+	return pModel;
+}
+
+void ModelManager::beginLoad(Model* const pModel)
+{
+	ASSERT(findPendingLoadOrNull(pModel->GetPath()) == nullptr);
+
+	PendingLoad* const pLoad = new PendingLoad();
+	pLoad->path = pModel->GetPath();
+	pLoad->pModel = pModel;
+	pLoad->requestTime = std::chrono::steady_clock::now();
+	pLoad->bSucceeded = false;
+	pLoad->bCooked = false;
+	pLoad->progress.meshCount = 0;
+	pLoad->progress.convertedMeshCount = 0;
+	pLoad->bUploading = false;
+	pLoad->uploadedCount = 0;
+	pLoad->uploadTimeMs = 0.f;
+
+	mPendingLoads.push_back(pLoad);
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		++mInFlightLoadCount;
+	}
+
+	// 작업은 pLoad만 건드리고 Model은 메인 스레드에서만 바꿈
+	std::function<void()> job = [this, pLoad]()
+		{
+			// 쿠킹된 파일은 매핑한 채로 두고 업로드할 때 덩어리를 그대로 올림
+			if (IsCookedModelUpToDate(pLoad->path)
+				&& pLoad->cookedFile.TryOpen(GetCookedModelPath(pLoad->path).c_str())
+				&& TryParseCookedModel(pLoad->cookedFile.GetData(), pLoad->cookedFile.GetSize(), pLoad->cookedModel))
+			{
+				pLoad->bCooked = true;
+				pLoad->bSucceeded = true;
+			}
+			else
+			{
+				pLoad->cookedFile.Close();
+
+				pLoad->bSucceeded = TryImportModel(pLoad->path, pLoad->importedModel, true, &pLoad->progress, &mImportFileCache);
+			}
+
+			std::lock_guard<std::mutex> lock(mLoadMutex);
+
+			mCompletedLoads.push_back(pLoad);
+			--mInFlightLoadCount;
+
+			mLoadCondition.notify_all();
+		};
+
+	if (JobSystem::IsInitialized())
+	{
+		JobSystem::GetInstance().Submit(std::move(job));
+	}
+	else
+	{
+		job();
+	}
 }
 
 Model* ModelManager::GetModelOrNull(const std::string& path)
@@ -164,154 +300,581 @@ Model* ModelManager::GetModelOrNull(const std::string& path)
 	return nullptr;
 }
 
-void ModelManager::Unload(const std::string& path)
+void ModelManager::AddRef(Model* const pModel)
 {
-	if (mLoadedModels.find(path) != mLoadedModels.end())
+	ASSERT(pModel != nullptr);
+
+	ModelResidency& residency = mModelResidency[pModel];
+
+	// 참조가 없어 LRU에 있던 것이면 꺼냄
+	if (residency.refCount == 0)
 	{
-		delete mLoadedModels[path];
+		mUnusedModels.erase(residency.lruIter);
+	}
+
+	++residency.refCount;
+}
+
+void ModelManager::Release(Model* const pModel)
+{
+	ASSERT(pModel != nullptr);
+
+	ModelResidency& residency = mModelResidency[pModel];
+	ASSERT(residency.refCount > 0);
+
+	--residency.refCount;
 
-		mLoadedModels.erase(path);
+	if (residency.refCount == 0)
+	{
+		residency.lruIter = mUnusedModels.insert(mUnusedModels.end(), pModel);
 	}
 }
 
-void ModelManager::processNodeRecursive(
-	aiNode* pNode,
-	const aiScene* pScene,
-	const Matrix tr,
-	ModelData& outModelData,
-	Vector3& outCenter,
-	int& totalVertices,
-	Vector3& outMinVector,
-	Vector3& outMaxVector
-)
+Material* ModelManager::DetachSubmeshMaterial(Model* const pModel, const uint32_t submeshIndex)
 {
-	Matrix m;
-	ai_real* pTmp = &pNode->mTransformation.a1;
-	float* pMTmp = &m._11;
+	ASSERT(pModel != nullptr);
+	ASSERT(!pModel->IsPlaceholder());
+	ASSERT(submeshIndex < pModel->GetModelData().size());
+
+	Material* const pMaterial = pModel->GetModelData()[submeshIndex].second;
+
+	// 기본 도형은 "Default"를 바로 가리키므로 여기서 처음 서브메쉬 이름으로 등록됨
+	Material* const pDetached = MaterialManager::GetInstance().DetachMaterial(getSubmeshKey(pModel->GetPath(), submeshIndex), pMaterial);
 
-	for (int t = 0; t < 16; ++t)
+	if (pDetached != pMaterial)
 	{
-		pMTmp[t] = static_cast<float>(pTmp[t]);
+		pModel->SetSubmeshMaterial(submeshIndex, pDetached);
 	}
-	m = m.Transpose() * tr;
 
-	for (UINT i = 0; i < pNode->mNumMeshes; ++i)
+	return pDetached;
+}
+
+void ModelManager::UpdateResidency()
+{
+	while (mUnusedModels.size() > static_cast<size_t>(mMaxUnusedCount))
 	{
-		aiMesh* pMesh = pScene->mMeshes[pNode->mMeshes[i]];
+		evictModel(mUnusedModels.front());
+	}
+}
 
-		// Process Mesh
-		std::vector<Vertex::PosNormalUV> vertices;
-		vertices.reserve(pMesh->mNumVertices);
+void ModelManager::evictModel(Model* const pModel)
+{
+	const std::string path = pModel->GetPath();
+
+#define RESIDENCY_MAP_ITER std::unordered_map<Model*, ModelResidency>::iterator
+
+	RESIDENCY_MAP_ITER residencyIter = mModelResidency.find(pModel);
+	ASSERT(residencyIter != mModelResidency.end());
+	ASSERT(residencyIter->second.refCount == 0);
+
+	mUnusedModels.erase(residencyIter->second.lruIter);
+
+	// 정육면체를 빌려 쓰는 중이면 잡은 참조가 없음
+	releaseSubmeshes(path, residencyIter->second.submeshCount);
+
+	mModelResidency.erase(residencyIter);
+
+#undef RESIDENCY_MAP_ITER
+
+	// 불러오는 동안은 참조가 남아 있어서 여기 오지 않음
+	ASSERT(findPendingLoadOrNull(path) == nullptr);
+
+	mLoadedModels.erase(path);
+
+	delete pModel;
+
+	++mEvictCount;
+}
 
-		totalVertices += pMesh->mNumVertices;
-		for (UINT j = 0; j < pMesh->mNumVertices; ++j)
+void ModelManager::releaseSubmeshes(const std::string& path, const uint32_t submeshCount)
+{
+	MeshManager& meshManager = MeshManager::GetInstance();
+	MaterialManager& materialManager = MaterialManager::GetInstance();
+
+	for (uint32_t i = 0; i < submeshCount; ++i)
+	{
+		const std::string key = getSubmeshKey(path, i);
+
+		meshManager.ReleaseMesh(key);
+		materialManager.ReleaseMaterial(key);
+	}
+}
+
+void ModelManager::UpdateLoading()
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point updateStart = Clock::now();
+
+	std::vector<PendingLoad*> completedLoads;
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		completedLoads.swap(mCompletedLoads);
+	}
+
+	MeshManager& meshManager = MeshManager::GetInstance();
+
+	// 요청 순서대로 보면서 끝난 것은 뺌
+	size_t keepCount = 0;
+	bool bUploaded = false;
+
+	for (size_t i = 0; i < mPendingLoads.size(); ++i)
+	{
+		PendingLoad* const pLoad = mPendingLoads[i];
+
+		bool bFinished = false;
+
+		if (std::find(completedLoads.begin(), completedLoads.end(), pLoad) != completedLoads.end())
+		{
+			// 실패했으면 정육면체를 빌려 쓰는 채로 두고 다음 Load에서 다시 시도
+			pLoad->bUploading = tryBeginUpload(*pLoad);
+			bFinished = !pLoad->bUploading;
+
+			mModelResidency[pLoad->pModel].bLoadFailed = !pLoad->bUploading;
+		}
+
+		// 최소 하나는 만들어서 예산이 작아도 끝은 나도록 함
+		if (!bFinished && pLoad->bUploading && (!bUploaded || Milliseconds(Clock::now() - updateStart).count() < mUploadBudgetMs))
 		{
-			Vertex::PosNormalUV vertex;
+			const Clock::time_point uploadStart = Clock::now();
 
-			vertex.pos.x = pMesh->mVertices[j].x;
-			vertex.pos.y = pMesh->mVertices[j].y;
-			vertex.pos.z = pMesh->mVertices[j].z;
+			meshManager.BeginBatch();
 
-			vertex.pos = Vector3::Transform(vertex.pos, m);
+			do
+			{
+				bFinished = uploadNextSubmesh(*pLoad);
+				bUploaded = true;
+			} while (!bFinished && Milliseconds(Clock::now() - updateStart).count() < mUploadBudgetMs);
 
-			outCenter += vertex.pos;
-			outMinVector = Vector3::Min(outMinVector, vertex.pos);
-			outMaxVector = Vector3::Max(outMaxVector, vertex.pos);
+			meshManager.EndBatch();
 
-			vertex.normal.x = pMesh->mNormals[j].x;
-			vertex.normal.y = pMesh->mNormals[j].y;
-			vertex.normal.z = pMesh->mNormals[j].z;
-			vertex.normal.Normalize();
+			pLoad->uploadTimeMs += Milliseconds(Clock::now() - uploadStart).count();
 
-			if (pMesh->mTextureCoords[0])
+			if (bFinished)
 			{
-				vertex.uv.x = static_cast<float>(pMesh->mTextureCoords[0][j].x);
-				vertex.uv.y = static_cast<float>(pMesh->mTextureCoords[0][j].y);
+				finishLoad(*pLoad);
 			}
+		}
+
+		if (bFinished)
+		{
+			// 불러오기가 잡고 있던 참조, 가져간 쪽이 없으면 여기서 LRU로 감
+			Release(pLoad->pModel);
+
+			delete pLoad;
+
+			continue;
+		}
+
+		mPendingLoads[keepCount] = pLoad;
+		++keepCount;
+	}
+
+	mPendingLoads.resize(keepCount);
+
+	// 남은 작업이 없으면 파일을 붙잡고 있지 않도록 닫음
+	if (mPendingLoads.empty())
+	{
+		mImportFileCache.Clear();
+	}
+
+	if (bUploaded)
+	{
+		mLastUploadSliceMs = Milliseconds(Clock::now() - updateStart).count();
+	}
+}
+
+void ModelManager::CookLoadedModels()
+{
+	mCookResults.clear();
 
-			vertices.push_back(vertex);
+	// 여러 모델이 같이 쓰는 파일은 한 번만 매핑
+	MappedFileCache fileCache;
+
+	for (const std::pair<const std::string, Model*>& pair : mLoadedModels)
+	{
+		const std::string& path = pair.first;
+
+		// 기본 도형은 원본 파일이 없음
+		if (!std::filesystem::exists(path))
+		{
+			continue;
 		}
 
-		std::vector<uint32_t> indices;
-		indices.reserve(pMesh->mNumVertices * 3);
+		CookResult result;
+		result.path = path;
+		result.bSucceeded = TryCookModel(path, &fileCache, result.stats);
+
+		mCookResults.push_back(result);
+	}
+}
+
+void ModelManager::MeasureLoadTimes()
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	mLoadBenchmarks.clear();
 
-		for (UINT j = 0; j < pMesh->mNumFaces; ++j)
+	MappedFileCache fileCache;
+
+	// 버퍼 생성은 두 경로가 같으므로 CPU에서 그릴 준비가 될 때까지만 잼
+	for (const std::pair<const std::string, Model*>& pair : mLoadedModels)
+	{
+		const std::string& path = pair.first;
+
+		if (!std::filesystem::exists(path))
 		{
-			aiFace face = pMesh->mFaces[j];
-			for (UINT k = 0; k < face.mNumIndices; ++k)
-			{
-				indices.push_back(face.mIndices[k]);
-			}
+			continue;
 		}
 
-		// Only use baseColor texture
-		std::string texturePath = "./Assets/";
-		if (pMesh->mMaterialIndex >= 0)
+		LoadBenchmark benchmark;
+		benchmark.path = path;
+		benchmark.cookedTimeMs = -1.f;
+
+		ImportedModel importedModel;
+
+		// 기본 입출력을 먼저 돌려서 매핑 쪽이 파일 캐시 덕을 따로 보지 않게 함
+		const Clock::time_point defaultIOImportStart = Clock::now();
+
+		if (!TryImportModel(path, importedModel, true, nullptr, nullptr))
 		{
-			aiMaterial* pMaterial = pScene->mMaterials[pMesh->mMaterialIndex];
+			continue;
+		}
 
-			aiString aiMaterialName;
+		benchmark.defaultIOImportTimeMs = Milliseconds(Clock::now() - defaultIOImportStart).count();
+		benchmark.defaultIOPeakMemoryBytes = importedModel.peakMemoryBytes;
 
-			if (pMaterial->Get(AI_MATKEY_NAME, aiMaterialName) == AI_SUCCESS)
-			{
-				texturePath.append("miyako/textures/i_");
-				texturePath.append(aiMaterialName.C_Str());
-				texturePath.append("_BaseColor.png");
-			}
+		const Clock::time_point importStart = Clock::now();
 
-			std::filesystem::path fsTexturePath(texturePath);
-			if (std::filesystem::exists(fsTexturePath))
-			{
-				texturePath = fsTexturePath.string();
+		if (!TryImportModel(path, importedModel, true, nullptr, &fileCache))
+		{
+			continue;
+		}
 
-				TextureManager& textureManager = TextureManager::GetInstance();
-				textureManager.LoadTexture(texturePath);
-			}
-			else
+		benchmark.importTimeMs = Milliseconds(Clock::now() - importStart).count();
+		benchmark.threadCount = importedModel.convertThreadCount;
+		benchmark.peakMemoryBytes = importedModel.peakMemoryBytes;
+
+		// 코어 수에 따라 얼마나 빨라지는지 보려고 같은 파일을 스레드 하나로도 읽음
+		const Clock::time_point serialImportStart = Clock::now();
+
+		if (!TryImportModel(path, importedModel, false, nullptr, &fileCache))
+		{
+			continue;
+		}
+
+		benchmark.serialImportTimeMs = Milliseconds(Clock::now() - serialImportStart).count();
+
+		if (IsCookedModelUpToDate(path))
+		{
+			const Clock::time_point cookedStart = Clock::now();
+
+			MappedFile file;
+			CookedModelView cookedModel;
+
+			if (file.TryOpen(GetCookedModelPath(path).c_str()) && TryParseCookedModel(file.GetData(), file.GetSize(), cookedModel))
 			{
-				texturePath.append("Default.dds");
+				benchmark.cookedTimeMs = Milliseconds(Clock::now() - cookedStart).count();
 			}
 		}
 
-		std::string key = texturePath;
+		mLoadBenchmarks.push_back(benchmark);
+	}
+}
 
-		key.append(std::to_string(outModelData.size()));
-		MeshManager& meshManager = MeshManager::GetInstance();
-		Mesh* pMeshGenerated = meshManager.CreateMesh(
-			key,
-			vertices,
-			indices
-		);
+ModelManager::PendingLoad* ModelManager::findPendingLoadOrNull(const std::string& path) const
+{
+	for (PendingLoad* const pLoad : mPendingLoads)
+	{
+		if (pLoad->path == path)
+		{
+			return pLoad;
+		}
+	}
 
-		MaterialManager& materialManager = MaterialManager::GetInstance();
-		Material* pMaterialGenerated = materialManager.CreateMaterial(
-			key,
-			texturePath,
-			"./Shaders/VSBasic.hlsl",
-			"./Shaders/PSBasic.hlsl"
-		);
+	return nullptr;
+}
+
+float ModelManager::getLoadProgress(const PendingLoad& load, const char*& outStage) const
+{
+	// 읽기, 변환, 업로드가 차지하는 비율
+	constexpr float READ_END = 0.1f;
+	constexpr float CONVERT_END = 0.8f;
+
+	if (load.bUploading)
+	{
+		outStage = "Uploading";
+
+		const uint32_t submeshCount = static_cast<uint32_t>(load.bCooked ? load.cookedModel.submeshes.size() : load.importedModel.submeshes.size());
+
+		return CONVERT_END + (1.f - CONVERT_END) * static_cast<float>(load.uploadedCount) / static_cast<float>(submeshCount);
+	}
+
+	const uint32_t meshCount = load.progress.meshCount;
+
+	if (meshCount == 0)
+	{
+		outStage = "Reading";
+
+		return 0.f;
+	}
+
+	outStage = "Converting";
+
+	const uint32_t convertedMeshCount = load.progress.convertedMeshCount;
+
+	return READ_END + (CONVERT_END - READ_END) * static_cast<float>(convertedMeshCount) / static_cast<float>(meshCount);
+}
+
+bool ModelManager::tryBeginUpload(PendingLoad& load)
+{
+	if (!load.bSucceeded)
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "ImportModel");
+
+		++mLoadFailCount;
+
+		return false;
+	}
+
+	Vector3 center;
+	float boundingRadius;
+	Vector3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+	Vector3 boundsMax = -boundsMin;
+
+	if (load.bCooked)
+	{
+		center = load.cookedModel.center;
+		boundingRadius = load.cookedModel.boundingRadius;
+
+		for (const CookedSubmeshView& submesh : load.cookedModel.submeshes)
+		{
+			boundsMin = Vector3::Min(boundsMin, submesh.boundsMin);
+			boundsMax = Vector3::Max(boundsMax, submesh.boundsMax);
+		}
+	}
+	else
+	{
+		center = load.importedModel.center;
+		boundingRadius = load.importedModel.boundingRadius;
+
+		for (const ImportedSubmesh& submesh : load.importedModel.submeshes)
+		{
+			boundsMin = Vector3::Min(boundsMin, submesh.boundsMin);
+			boundsMax = Vector3::Max(boundsMax, submesh.boundsMax);
+		}
+	}
+
+	const size_t submeshCount = load.bCooked ? load.cookedModel.submeshes.size() : load.importedModel.submeshes.size();
+
+	if (submeshCount == 0 || boundingRadius <= 0.f)
+	{
+		++mLoadFailCount;
+
+		return false;
+	}
+
+	// 버퍼를 다 만들 때까지 범위를 덮는 상자를 보여줌
+	std::vector<Vertex::PosNormalUV> vertices;
+	std::vector<uint16_t> indices;
+
+	Shape::CreateCubeDataAlloc(vertices, indices);
+
+	const Vector3 boxCenter = (boundsMin + boundsMax) * 0.5f;
+	const Vector3 boxHalfExtent = (boundsMax - boundsMin) * 0.5f;
+
+	for (Vertex::PosNormalUV& vertex : vertices)
+	{
+		vertex.pos = boxCenter + vertex.pos * boxHalfExtent;
+	}
+
+	load.boundsMeshKey = load.path;
+	load.boundsMeshKey.append("#Bounds");
+
+	Mesh* const pBoundsMesh = MeshManager::GetInstance().CreateMesh(load.boundsMeshKey, vertices, indices);
+	Material* const pDefaultMaterial = MaterialManager::GetInstance().GetMaterialOrNull("Default");
+
+	ModelData boundsModelData =
+	{
+		{ pBoundsMesh, pDefaultMaterial }
+	};
+
+	load.pModel->SetModelData(boundsModelData, center, boundingRadius);
+
+	load.modelData.reserve(submeshCount);
+
+	return true;
+}
+
+bool ModelManager::uploadNextSubmesh(PendingLoad& load)
+{
+	const uint32_t index = load.uploadedCount;
+
+	const std::string key = getSubmeshKey(load.path, index);
+
+	if (load.bCooked)
+	{
+		load.modelData.push_back(createCookedSubmesh(key, load.cookedModel.submeshes[index]));
+	}
+	else
+	{
+		load.modelData.push_back(createImportedSubmesh(key, load.importedModel.submeshes[index]));
+	}
+
+	++load.uploadedCount;
+
+	return load.uploadedCount == static_cast<uint32_t>(load.bCooked ? load.cookedModel.submeshes.size() : load.importedModel.submeshes.size());
+}
+
+void ModelManager::finishLoad(PendingLoad& load)
+{
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	ASSERT(load.pModel != nullptr);
+
+	const BoundingSphere boundingSphere = load.pModel->GetBoundingRadiusLocal();
+
+	load.pModel->SetModelData(load.modelData, boundingSphere.Center, boundingSphere.Radius);
+	load.pModel->SetPlaceholder(false);
+
+	mModelResidency[load.pModel].submeshCount = load.uploadedCount;
+
+	MeshManager::GetInstance().ReleaseMesh(load.boundsMeshKey);
+
+	mLastLoadTimeMs = Milliseconds(std::chrono::steady_clock::now() - load.requestTime).count();
+	mbLastLoadCooked = load.bCooked;
+	mLastUploadTimeMs = load.uploadTimeMs;
+
+	if (load.bCooked)
+	{
+		return;
+	}
+
+	const ImportedModel& importedModel = load.importedModel;
+
+	mLastOptimizeStats = importedModel.optimizeStats;
+	mLastSourceBytes = importedModel.sourceBytes;
+	mLastGeometryBytes = importedModel.geometryBytes;
+	mLastQuantizedSubmeshCount = importedModel.quantizedSubmeshCount;
+	mLastSubmeshCount = static_cast<uint32_t>(importedModel.submeshes.size());
+	mLastQuantizationError = importedModel.quantizationError;
+	mLastReadTimeMs = importedModel.readTimeMs;
+	mLastConvertTimeMs = importedModel.convertTimeMs;
+	mLastConvertThreadCount = importedModel.convertThreadCount;
+}
+
+std::pair<Mesh*, Material*> ModelManager::createImportedSubmesh(const std::string& key, const ImportedSubmesh& submesh)
+{
+	MeshManager& meshManager = MeshManager::GetInstance();
+
+	const uint32_t indexStride = GetSubmeshIndexStride(submesh.vertices.size());
+	const void* pIndexData = submesh.indices.data();
 
-		outModelData.push_back(std::make_pair(pMeshGenerated, pMaterialGenerated));
+	if (indexStride == sizeof(uint16_t))
+	{
+		mShortIndices.resize(submesh.indices.size());
+
+		for (size_t i = 0; i < submesh.indices.size(); ++i)
+		{
+			mShortIndices[i] = static_cast<uint16_t>(submesh.indices[i]);
+		}
+
+		pIndexData = mShortIndices.data();
 	}
 
-	for (UINT i = 0; i < pNode->mNumChildren; ++i)
+	Mesh* pMeshGenerated;
+
+	if (submesh.bQuantized)
 	{
-		processNodeRecursive(
-			pNode->mChildren[i],
-			pScene,
-			m,
-			outModelData,
-			outCenter,
-			totalVertices,
-			outMinVector,
-			outMaxVector
+		pMeshGenerated = meshManager.CreateMesh(
+			key,
+			Vertex::EType::POS_NORMAL_UV_QUANTIZED,
+			submesh.quantizedVertices.data(),
+			static_cast<uint32_t>(submesh.quantizedVertices.size()),
+			sizeof(Vertex::PosNormalUVQuantized),
+			pIndexData,
+			static_cast<uint32_t>(submesh.indices.size()),
+			indexStride,
+			submesh.positionOffset,
+			submesh.positionScale,
+			submesh.contentHash
+		);
+	}
+	else
+	{
+		pMeshGenerated = meshManager.CreateMesh(
+			key,
+			Vertex::EType::POS_NORMAL_UV,
+			submesh.vertices.data(),
+			static_cast<uint32_t>(submesh.vertices.size()),
+			sizeof(Vertex::PosNormalUV),
+			pIndexData,
+			static_cast<uint32_t>(submesh.indices.size()),
+			indexStride,
+			Vector3::Zero,
+			Vector3::One,
+			submesh.contentHash
 		);
 	}
+
+	Material* const pMaterialGenerated = createSubmeshMaterial(key, submesh.texturePath, submesh.bHasTexture);
+
+	return std::make_pair(pMeshGenerated, pMaterialGenerated);
+}
+
+std::pair<Mesh*, Material*> ModelManager::createCookedSubmesh(const std::string& key, const CookedSubmeshView& submesh)
+{
+	MeshManager& meshManager = MeshManager::GetInstance();
+
+	Mesh* const pMeshGenerated = meshManager.CreateMesh(
+		key,
+		submesh.eVertexType,
+		submesh.pVertexData,
+		submesh.vertexCount,
+		submesh.vertexStride,
+		submesh.pIndexData,
+		submesh.indexCount,
+		submesh.indexStride,
+		submesh.positionOffset,
+		submesh.positionScale,
+		submesh.contentHash
+	);
+
+	Material* const pMaterialGenerated = createSubmeshMaterial(key, submesh.texturePath, submesh.bHasTexture);
+
+	return std::make_pair(pMeshGenerated, pMaterialGenerated);
+}
+
+Material* ModelManager::createSubmeshMaterial(const std::string& key, const std::string& texturePath, const bool bHasTexture)
+{
+	MaterialManager& materialManager = MaterialManager::GetInstance();
+
+	// 텍스처 참조는 Material이 잡음, 텍스처가 없으면 경로를 비워서 불러오지 않게 함
+	return materialManager.CreateMaterial(
+		key,
+		bHasTexture ? texturePath : std::string(),
+		"./Shaders/VSBasic.hlsl",
+		"./Shaders/PSBasic.hlsl"
+	);
+}
+
+std::string ModelManager::getSubmeshKey(const std::string& path, const uint32_t index)
+{
+	// 모델마다 다른 이름, 내용이 같은 메쉬와 머티리얼은 매니저가 합침
+	std::string key = path;
+	key.append("#");
+	key.append(std::to_string(index));
+
+	return key;
 }
 
 float ModelManager::calculateBoundingSphereLocalRadius(const std::vector<Vertex::PosNormalUV>& vertices)
 {
-	Vector3 minVector(D3D11_FLOAT32_MAX, D3D11_FLOAT32_MAX, D3D11_FLOAT32_MAX);
+	Vector3 minVector(FLT_MAX, FLT_MAX, FLT_MAX);
 	Vector3 maxVector = -minVector;
 
 	for (const Vertex::PosNormalUV& vertex : vertices)
@@ -329,9 +892,9 @@ void ModelManager::DrawEditorUI()
 {
 	ImGui::PushID("ModelManager");
 
-	ImGui::Text(UTF8_TEXT(""));
+	ImGui::Text(UTF8_TEXT("모델"));
 
-	if (ImGui::Button(UTF8_TEXT(" ҷ")))
+	if (ImGui::Button(UTF8_TEXT("모델 불러오기")))
 	{
 		FileDialog& fileDialog = FileDialog::GetInstance();
 
@@ -344,7 +907,174 @@ void ModelManager::DrawEditorUI()
 
 	for (const std::pair<const std::string, Model*>& pair : mLoadedModels)
 	{
+		if (!pair.second->IsPlaceholder())
+		{
+			ImGui::Text(UTF8_TEXT("%s"), pair.first.c_str());
+
+			continue;
+		}
+
+		const PendingLoad* const pLoad = findPendingLoadOrNull(pair.first);
+
+		if (pLoad == nullptr)
+		{
+			ImGui::Text(UTF8_TEXT("%s Failed"), pair.first.c_str());
+
+			continue;
+		}
+
+		const char* stage;
+		const float progress = getLoadProgress(*pLoad, stage);
+
+		char overlay[DEFAULT_BUFFER_SIZE];
+		snprintf(overlay, DEFAULT_BUFFER_SIZE, "%s %.0f%%", stage, progress * 100.f);
+
 		ImGui::Text(UTF8_TEXT("%s"), pair.first.c_str());
+		ImGui::ProgressBar(progress, ImVec2(-1.f, 0.f), overlay);
+	}
+
+	ImGui::Text("Loading: %u / Failed: %u", static_cast<uint32_t>(mPendingLoads.size()), mLoadFailCount);
+
+	const MappedFileCache::Stats fileCacheStats = mImportFileCache.GetStats();
+
+	ImGui::Text("Mapped Files: %u (Reused: %u) / Mapped %.1f MB / Read %.1f MB",
+		fileCacheStats.mapCount,
+		fileCacheStats.reuseCount,
+		static_cast<float>(fileCacheStats.mappedBytes) / (1024.f * 1024.f),
+		static_cast<float>(fileCacheStats.readBytes) / (1024.f * 1024.f)
+	);
+	ImGui::SliderFloat("Upload Budget (ms)", &mUploadBudgetMs, 0.5f, 16.f);
+	ImGui::Text("Last Upload Slice: %.2f ms", mLastUploadSliceMs);
+
+	ImGui::Text("Last Load: %.2f ms (%s)", mLastLoadTimeMs, mbLastLoadCooked ? "Cooked" : "Assimp");
+
+	if (mLastOptimizeStats.before.triangleCount > 0)
+	{
+		ImGui::Text("Last Import ACMR: %.3f -> %.3f / ATVR: %.3f -> %.3f / Clusters: %u / %.2f ms",
+			GetACMR(mLastOptimizeStats.before),
+			GetACMR(mLastOptimizeStats.after),
+			GetATVR(mLastOptimizeStats.before),
+			GetATVR(mLastOptimizeStats.after),
+			mLastOptimizeStats.clusterCount,
+			mLastOptimizeStats.optimizeTimeMs
+		);
+		ImGui::Text("Last Import Vertices: %u -> %u / Geometry: %.1f KB -> %.1f KB (-%.1f%%)",
+			mLastOptimizeStats.before.vertexCount,
+			mLastOptimizeStats.after.vertexCount,
+			static_cast<float>(mLastSourceBytes) / 1024.f,
+			static_cast<float>(mLastGeometryBytes) / 1024.f,
+			GetSavedPercent(mLastSourceBytes, mLastGeometryBytes)
+		);
+		ImGui::Text("Last Import Quantized: %u / %u / Max Error: Pos %.2e / Normal %.3f deg / UV %.2e",
+			mLastQuantizedSubmeshCount,
+			mLastSubmeshCount,
+			mLastQuantizationError.maxPositionError,
+			mLastQuantizationError.maxNormalErrorDegrees,
+			mLastQuantizationError.maxUVError
+		);
+		ImGui::Text("Last Import Time: Read %.2f ms / Convert %.2f ms (%u threads) / Upload %.2f ms (sliced)",
+			mLastReadTimeMs,
+			mLastConvertTimeMs,
+			mLastConvertThreadCount,
+			mLastUploadTimeMs
+		);
+	}
+
+	ImGui::SeparatorText(UTF8_TEXT("상주 메모리"));
+
+	ImGui::SliderInt("Max Unused", &mMaxUnusedCount, 0, MAX_UNUSED_COUNT_LIMIT);
+	ImGui::Text("Referenced: %u / Unused (LRU): %u / Evicted: %u",
+		static_cast<uint32_t>(mModelResidency.size() - mUnusedModels.size()),
+		static_cast<uint32_t>(mUnusedModels.size()),
+		mEvictCount
+	);
+
+	ImGui::SeparatorText(UTF8_TEXT("쿠킹"));
+	{
+		if (ImGui::Button("Cook Loaded Models"))
+		{
+			CookLoadedModels();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Measure Load Times"))
+		{
+			MeasureLoadTimes();
+		}
+
+		ImGui::TextDisabled(UTF8_TEXT("쿠킹 결과는 다음에 불러올 때부터 적용"));
+
+		for (const CookResult& result : mCookResults)
+		{
+			if (!result.bSucceeded)
+			{
+				ImGui::Text("%s: Failed", result.path.c_str());
+
+				continue;
+			}
+
+			const ModelCookStats& stats = result.stats;
+
+			ImGui::Text("%s: Submeshes: %u / Vertices: %u / Indices: %u", result.path.c_str(), stats.submeshCount, stats.vertexCount, stats.indexCount);
+			ImGui::Text("    Import: %.2f ms / Write: %.2f ms / Size: %.1f KB",
+				stats.importTimeMs,
+				stats.writeTimeMs,
+				static_cast<float>(stats.cookedBytes) / 1024.f
+			);
+			ImGui::Text("    ACMR: %.3f -> %.3f / ATVR: %.3f -> %.3f / Optimize: %.2f ms",
+				GetACMR(stats.optimizeStats.before),
+				GetACMR(stats.optimizeStats.after),
+				GetATVR(stats.optimizeStats.before),
+				GetATVR(stats.optimizeStats.after),
+				stats.optimizeStats.optimizeTimeMs
+			);
+			ImGui::Text("    Vertices: %u -> %u / Geometry: %.1f KB -> %.1f KB (-%.1f%%)",
+				stats.optimizeStats.before.vertexCount,
+				stats.optimizeStats.after.vertexCount,
+				static_cast<float>(stats.sourceBytes) / 1024.f,
+				static_cast<float>(stats.geometryBytes) / 1024.f,
+				GetSavedPercent(stats.sourceBytes, stats.geometryBytes)
+			);
+			ImGui::Text("    Quantized: %u / %u / Max Error: Pos %.2e / Normal %.3f deg / UV %.2e",
+				stats.quantizedSubmeshCount,
+				stats.submeshCount,
+				stats.quantizationError.maxPositionError,
+				stats.quantizationError.maxNormalErrorDegrees,
+				stats.quantizationError.maxUVError
+			);
+		}
+
+		for (const LoadBenchmark& benchmark : mLoadBenchmarks)
+		{
+			ImGui::Text("%s: Assimp 1 thread %.2f ms / %u threads %.2f ms (x%.2f)",
+				benchmark.path.c_str(),
+				benchmark.serialImportTimeMs,
+				benchmark.threadCount,
+				benchmark.importTimeMs,
+				benchmark.serialImportTimeMs / (benchmark.importTimeMs > 0.f ? benchmark.importTimeMs : 1e-3f)
+			);
+			ImGui::Text("    IO: Default %.2f ms / Peak %.1f MB -> Mapped %.2f ms / Peak %.1f MB",
+				benchmark.defaultIOImportTimeMs,
+				static_cast<float>(benchmark.defaultIOPeakMemoryBytes) / (1024.f * 1024.f),
+				benchmark.importTimeMs,
+				static_cast<float>(benchmark.peakMemoryBytes) / (1024.f * 1024.f)
+			);
+
+			if (benchmark.cookedTimeMs < 0.f)
+			{
+				ImGui::Text("%s: Assimp %.2f ms / Cooked: -", benchmark.path.c_str(), benchmark.importTimeMs);
+
+				continue;
+			}
+
+			ImGui::Text("%s: Assimp %.2f ms / Cooked %.3f ms (x%.1f)",
+				benchmark.path.c_str(),
+				benchmark.importTimeMs,
+				benchmark.cookedTimeMs,
+				benchmark.importTimeMs / (benchmark.cookedTimeMs > 0.f ? benchmark.cookedTimeMs : 1e-3f)
+			);
+		}
 	}
 
 	ImGui::PopID();
@@ -354,7 +1084,7 @@ bool ModelManager::DrawModelSelectorPopupAndSelectModel(Model*& pOutSelectedMode
 {
 	ImGui::PushID("ModelManager");
 
-	const char* const popupName = UTF8_TEXT(" ");
+	const char* const popupName = UTF8_TEXT("모델 목록");
 
 	ImGui::OpenPopup(popupName);
 
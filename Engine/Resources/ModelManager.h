@@ -2,25 +2,89 @@
 
 #include <unordered_map>
 #include <string>
-
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
 
 #include "UI/IEditorUIDrawable.h"
 #include "Core/MathHelper.h"
+#include "Core/MappedFile.h"
+#include "MappedIOSystem.h"
 #include "Model.h"
+#include "ModelCooker.h"
 #include "Renderer/Vertex.h"
 
 class Mesh;
 class Material;
 
+// Model을 쓰는 쪽(MeshComponent)이 AddRef/Release로 참조를 잡음
+// Model은 서브메쉬마다 "<경로>#<번호>" 메쉬와 머티리얼 참조를 가지고 해제될 때 놓음
+// 참조가 없는 Model은 LRU에 두었다가 개수 예산을 넘으면 오래된 것부터 해제
 class ModelManager final : public IEditorUIDrawable
 {
 public:
-	void Load(const std::string& path);
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct LoadBenchmark
+	{
+		std::string path;
+		float importTimeMs;
+
+		// 변환을 스레드 하나로 돌렸을 때
+		float serialImportTimeMs;
+		uint32_t threadCount;
+
+		// Assimp 기본 입출력으로 읽었을 때와 비교
+		float defaultIOImportTimeMs;
+		uint64_t peakMemoryBytes;
+		uint64_t defaultIOPeakMemoryBytes;
+
+		// 쿠킹된 파일이 없으면 음수
+		float cookedTimeMs;
+	};
+#pragma warning(pop)
+
+public:
+	// 정육면체를 빌려 쓰는 Model을 바로 돌려주고 읽기와 변환은 백그라운드에서 함
+	// 이미 있거나 불러오는 중인 경로면 같은 Model을 돌려줌, 쓰는 쪽의 참조는 AddRef로 따로 잡음
+	// 불러오는 동안은 매니저가 참조 하나를 잡고 있다가 끝나거나 실패하면 놓음
+	// 실패한 경로를 다시 부르면 같은 Model에 새로 불러옴
+	Model* Load(const std::string& path);
 	Model* GetModelOrNull(const std::string& path);
-	void Unload(const std::string& path);
+
+	void AddRef(Model* const pModel);
+	void Release(Model* const pModel);
+
+	// 서브메쉬 머티리얼을 편집하기 직전에 부름, 다른 모델과 같이 쓰던 것이면 이 모델만의 복사본으로 바꿔서 돌려줌
+	// 정육면체를 빌려 쓰는 중인 Model은 불러오기가 끝나면 머티리얼이 바뀌므로 부르면 안 됨
+	Material* DetachSubmeshMaterial(Model* const pModel, const uint32_t submeshIndex);
+
+	// 프레임 경계에서 UpdateLoading 다음에 호출
+	// 메쉬와 머티리얼 매니저보다 먼저 불러야 놓인 참조가 같은 프레임에 반영됨
+	void UpdateResidency();
+
+	// 프레임 경계에서 호출, 변환이 끝난 모델은 경계 상자로 바꾼 뒤
+	// 서브메쉬 버퍼를 프레임마다 정해진 시간만큼만 만들고 다 되면 교체
+	void UpdateLoading();
+
+	// 원본 파일이 있는 모델을 다시 읽어 쿠킹, 다음 불러오기부터 쿠킹된 파일을 씀
+	void CookLoadedModels();
+
+	// 원본이 있는 모델마다 Assimp 불러오기와 쿠킹된 파일 해석 시간을 잼
+	void MeasureLoadTimes();
+
+	inline const std::vector<LoadBenchmark>& GetLoadBenchmarks() const
+	{
+		return mLoadBenchmarks;
+	}
+
+	// 백그라운드 읽기나 업로드가 남아 있으면 true
+	inline bool IsLoading() const
+	{
+		return !mPendingLoads.empty();
+	}
 
 	virtual void DrawEditorUI() override;
 
@@ -43,20 +107,123 @@ private:
 
 	std::unordered_map<std::string, Model*> mLoadedModels;
 
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct CookResult
+	{
+		std::string path;
+		bool bSucceeded;
+		ModelCookStats stats;
+	};
+
+	struct PendingLoad
+	{
+		std::string path;
+
+		// 끝날 때까지 참조 하나를 잡고 있음
+		Model* pModel;
+
+		std::chrono::steady_clock::time_point requestTime;
+
+		// 백그라운드 작업이 채움
+		bool bSucceeded;
+		bool bCooked;
+		ImportedModel importedModel;
+		MappedFile cookedFile;
+		CookedModelView cookedModel;
+		ImportProgress progress;
+
+		// 여기부터는 메인 스레드만 씀
+		bool bUploading;
+		uint32_t uploadedCount;
+		float uploadTimeMs;
+		ModelData modelData;
+		std::string boundsMeshKey;
+	};
+
+	struct ModelResidency
+	{
+		// 0이면 lruIter가 유효
+		uint32_t refCount;
+		std::list<Model*>::iterator lruIter;
+
+		// 불러오기가 끝나서 잡고 있는 서브메쉬 참조 수
+		uint32_t submeshCount;
+
+		// 마지막 불러오기가 실패해서 정육면체를 빌려 쓰는 중
+		bool bLoadFailed;
+	};
+#pragma warning(pop)
+
+	float mLastLoadTimeMs;
+	bool mbLastLoadCooked;
+
+	// Assimp로 불러왔을 때만 갱신
+	MeshOptimizeStats mLastOptimizeStats;
+	uint64_t mLastSourceBytes;
+	uint64_t mLastGeometryBytes;
+	uint32_t mLastQuantizedSubmeshCount;
+	uint32_t mLastSubmeshCount;
+	VertexQuantizationError mLastQuantizationError;
+	float mLastReadTimeMs;
+	float mLastConvertTimeMs;
+	uint32_t mLastConvertThreadCount;
+	float mLastUploadTimeMs;
+
+	std::vector<CookResult> mCookResults;
+	std::vector<LoadBenchmark> mLoadBenchmarks;
+
+	// async loading
+	std::vector<PendingLoad*> mPendingLoads;
+
+	std::mutex mLoadMutex;
+	std::condition_variable mLoadCondition;
+	std::vector<PendingLoad*> mCompletedLoads;
+	uint32_t mInFlightLoadCount;
+
+	uint32_t mLoadFailCount;
+
+	// 불러오는 것이 남아 있는 동안 매핑을 다시 쓰고 모두 끝나면 닫음
+	MappedFileCache mImportFileCache;
+
+	// 한 프레임에 버퍼를 만드는 데 쓸 시간, 최소 서브메쉬 하나는 만듦
+	float mUploadBudgetMs;
+	float mLastUploadSliceMs;
+
+	std::vector<uint16_t> mShortIndices;
+
+	// residency, 앞쪽이 가장 오래전에 놓인 것
+	std::unordered_map<Model*, ModelResidency> mModelResidency;
+	std::list<Model*> mUnusedModels;
+	int mMaxUnusedCount;
+	uint32_t mEvictCount;
+
 private:
 	ModelManager();
 	~ModelManager();
 
-	void processNodeRecursive(
-		aiNode* pNode,
-		const aiScene* pScene,
-		const Matrix tr,
-		ModelData& outModelData,
-		Vector3& outCenter,
-		int& totalVertices,
-		Vector3& outMinVector,
-		Vector3& outMaxVector
-	);
+	// 불러오기가 참조 하나를 잡은 Model을 백그라운드에서 읽기 시작
+	void beginLoad(Model* const pModel);
+	PendingLoad* findPendingLoadOrNull(const std::string& path) const;
+
+	// 메쉬와 머티리얼 참조를 놓고 Model을 지움
+	void evictModel(Model* const pModel);
+	void releaseSubmeshes(const std::string& path, const uint32_t submeshCount);
+	float getLoadProgress(const PendingLoad& load, const char*& outStage) const;
+
+	// 변환이 끝난 모델을 경계 상자 메쉬로 바꿔 보여줌, 실패했으면 false
+	bool tryBeginUpload(PendingLoad& load);
+
+	// 서브메쉬 하나씩 만들고 다 만들었으면 true
+	bool uploadNextSubmesh(PendingLoad& load);
+	void finishLoad(PendingLoad& load);
+
+	std::pair<Mesh*, Material*> createImportedSubmesh(const std::string& key, const ImportedSubmesh& submesh);
+	std::pair<Mesh*, Material*> createCookedSubmesh(const std::string& key, const CookedSubmeshView& submesh);
+
+	Material* createSubmeshMaterial(const std::string& key, const std::string& texturePath, const bool bHasTexture);
+
+	static std::string getSubmeshKey(const std::string& path, const uint32_t index);
 
 	float calculateBoundingSphereLocalRadius(const std::vector<Vertex::PosNormalUV>& vertices);
 
@@ -0,0 +1,518 @@
+#include "ShaderCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "Core/HashHelper.h"
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<float, std::milli>;
+
+// "#include "file"" 또는 "#include <file>"에서 파일 이름만 꺼냄
+static bool TryParseInclude(const std::string& line, std::string& outName)
+{
+	size_t pos = line.find_first_not_of(" \t");
+
+	if (pos == std::string::npos || line[pos] != '#')
+	{
+		return false;
+	}
+
+	pos = line.find_first_not_of(" \t", pos + 1);
+
+	if (pos == std::string::npos || line.compare(pos, 7, "include") != 0)
+	{
+		return false;
+	}
+
+	pos = line.find_first_not_of(" \t", pos + 7);
+
+	if (pos == std::string::npos || (line[pos] != '"' && line[pos] != '<'))
+	{
+		return false;
+	}
+
+	const char closing = line[pos] == '"' ? '"' : '>';
+	const size_t end = line.find(closing, pos + 1);
+
+	if (end == std::string::npos)
+	{
+		return false;
+	}
+
+	outName = line.substr(pos + 1, end - pos - 1);
+
+	return true;
+}
+
+static std::string NormalizePath(const std::filesystem::path& path)
+{
+	return path.lexically_normal().generic_string();
+}
+
+ShaderCache::ShaderCache(const char* const archivePath, const char* const salt, CompileFunction compile)
+	: mArchivePath(archivePath)
+	, mSaltHash(HashString(salt))
+	, mCompile(std::move(compile))
+	, mArchive()
+	, mpArchiveEntries(nullptr)
+	, mArchiveEntryCount(0)
+	, mFileHashes()
+	, mIncludeGraph()
+	, mCompiledBytecodes()
+	, mUncachedBytecodes()
+	, mUsedArchiveKeys()
+	, mStats{}
+{
+	ASSERT(archivePath != nullptr);
+	ASSERT(salt != nullptr);
+	ASSERT(mCompile != nullptr);
+
+	openArchive();
+}
+
+bool ShaderCache::TryGetBytecode(const Request& request, const uint8_t*& outBytecode, size_t& outSize)
+{
+	uint64_t key;
+
+	const bool bKeyValid = TryComputeKey(request, key);
+
+	if (bKeyValid && TryFindBytecode(key, outBytecode, outSize))
+	{
+		return true;
+	}
+
+	if (!bKeyValid)
+	{
+		++mStats.missCount;
+	}
+
+	std::vector<uint8_t> bytecode;
+
+	const Clock::time_point compileStart = Clock::now();
+
+	const bool bCompiled = mCompile(request, bytecode);
+
+	mStats.compileTimeMs += Milliseconds(Clock::now() - compileStart).count();
+
+	if (!bCompiled || bytecode.empty())
+	{
+		++mStats.failCount;
+
+		return false;
+	}
+
+	if (bKeyValid)
+	{
+		StoreBytecode(key, std::move(bytecode), outBytecode, outSize);
+
+		return true;
+	}
+
+	// 소스를 읽지 못해 키가 없으면 아카이브에 넣지 않고 이번만 씀
+	std::vector<uint8_t>& stored = mUncachedBytecodes.emplace_back(std::move(bytecode));
+
+	outBytecode = stored.data();
+	outSize = stored.size();
+
+	return true;
+}
+
+bool ShaderCache::TryFindBytecode(const uint64_t key, const uint8_t*& outBytecode, size_t& outSize)
+{
+	const ArchiveEntry* const pEntry = findArchiveEntry(key);
+
+	if (pEntry != nullptr)
+	{
+		mUsedArchiveKeys.insert(key);
+		++mStats.hitCount;
+
+		outBytecode = mArchive.GetData() + pEntry->offset;
+		outSize = static_cast<size_t>(pEntry->size);
+
+		return true;
+	}
+
+	std::unordered_map<uint64_t, std::vector<uint8_t>>::const_iterator iter = mCompiledBytecodes.find(key);
+
+	if (iter != mCompiledBytecodes.end())
+	{
+		++mStats.hitCount;
+
+		outBytecode = iter->second.data();
+		outSize = iter->second.size();
+
+		return true;
+	}
+
+	++mStats.missCount;
+
+	return false;
+}
+
+void ShaderCache::StoreBytecode(const uint64_t key, std::vector<uint8_t>&& bytecode, const uint8_t*& outBytecode, size_t& outSize)
+{
+	ASSERT(!bytecode.empty());
+
+	std::vector<uint8_t>& stored = mCompiledBytecodes[key];
+	stored = std::move(bytecode);
+
+	outBytecode = stored.data();
+	outSize = stored.size();
+}
+
+bool ShaderCache::Save()
+{
+	// 모두 아카이브에서 읽었고 정리할 항목도 없음
+	if (mCompiledBytecodes.empty() && mUsedArchiveKeys.size() == mArchiveEntryCount)
+	{
+		return true;
+	}
+
+	struct PendingEntry
+	{
+		uint64_t key;
+		const uint8_t* pData;
+		uint64_t size;
+	};
+
+	std::vector<PendingEntry> pendingEntries;
+	pendingEntries.reserve(mUsedArchiveKeys.size() + mCompiledBytecodes.size());
+
+	for (const uint64_t key : mUsedArchiveKeys)
+	{
+		const ArchiveEntry* const pEntry = findArchiveEntry(key);
+		ASSERT(pEntry != nullptr);
+
+		pendingEntries.push_back({ key, mArchive.GetData() + pEntry->offset, pEntry->size });
+	}
+
+	for (const std::pair<const uint64_t, std::vector<uint8_t>>& pair : mCompiledBytecodes)
+	{
+		pendingEntries.push_back({ pair.first, pair.second.data(), pair.second.size() });
+	}
+
+	std::sort(pendingEntries.begin(), pendingEntries.end(), [](const PendingEntry& lhs, const PendingEntry& rhs)
+		{
+			return lhs.key < rhs.key;
+		});
+
+	// 헤더, 항목 표, 정렬된 바이트코드 순서
+	const ArchiveHeader header = { ARCHIVE_MAGIC, ARCHIVE_VERSION, static_cast<uint32_t>(pendingEntries.size()), 0 };
+
+	std::vector<ArchiveEntry> entries;
+	entries.reserve(pendingEntries.size());
+
+	uint64_t offset = sizeof(ArchiveHeader) + sizeof(ArchiveEntry) * pendingEntries.size();
+
+	for (const PendingEntry& pending : pendingEntries)
+	{
+		offset = (offset + ARCHIVE_ALIGNMENT - 1) & ~static_cast<uint64_t>(ARCHIVE_ALIGNMENT - 1);
+
+		entries.push_back({ pending.key, offset, pending.size });
+
+		offset += pending.size;
+	}
+
+	// 매핑을 닫기 전에 기존 아카이브 내용을 옮겨 적어야 함
+	const std::string tempPath = mArchivePath + ".tmp";
+
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(std::filesystem::path(mArchivePath).parent_path(), errorCode);
+
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(ArchiveHeader));
+		file.write(reinterpret_cast<const char*>(entries.data()), sizeof(ArchiveEntry) * entries.size());
+
+		const char padding[ARCHIVE_ALIGNMENT] = { 0, };
+
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			const uint64_t position = static_cast<uint64_t>(file.tellp());
+			ASSERT(position <= entries[i].offset);
+
+			file.write(padding, static_cast<std::streamsize>(entries[i].offset - position));
+			file.write(reinterpret_cast<const char*>(pendingEntries[i].pData), static_cast<std::streamsize>(pendingEntries[i].size));
+		}
+
+		if (!file.good())
+		{
+			file.close();
+			std::remove(tempPath.c_str());
+
+			return false;
+		}
+	}
+
+	mArchive.Close();
+	mpArchiveEntries = nullptr;
+	mArchiveEntryCount = 0;
+
+	std::remove(mArchivePath.c_str());
+
+	if (std::rename(tempPath.c_str(), mArchivePath.c_str()) != 0)
+	{
+		std::remove(tempPath.c_str());
+
+		return false;
+	}
+
+	mCompiledBytecodes.clear();
+	mUncachedBytecodes.clear();
+	mUsedArchiveKeys.clear();
+
+	openArchive();
+
+	// 방금 기록한 항목은 모두 쓰인 것
+	for (uint32_t i = 0; i < mArchiveEntryCount; ++i)
+	{
+		mUsedArchiveKeys.insert(mpArchiveEntries[i].key);
+	}
+
+	return true;
+}
+
+bool ShaderCache::TryComputeKey(const Request& request, uint64_t& outKey)
+{
+	ASSERT(request.path != nullptr);
+	ASSERT(request.entryPoint != nullptr);
+	ASSERT(request.target != nullptr);
+	ASSERT(request.pDefines != nullptr || request.defineCount == 0);
+
+	std::unordered_set<std::string> visitingPaths;
+
+	uint64_t sourceHash;
+
+	const Clock::time_point hashStart = Clock::now();
+
+	const bool bHashed = tryHashFile(NormalizePath(request.path), visitingPaths, sourceHash);
+
+	mStats.hashTimeMs += Milliseconds(Clock::now() - hashStart).count();
+
+	if (!bHashed)
+	{
+		return false;
+	}
+
+	uint64_t key = HashCombine(mSaltHash, ARCHIVE_VERSION);
+	key = HashCombine(key, sourceHash);
+	key = HashString(request.entryPoint, key);
+	key = HashString(request.target, key);
+
+	// 같은 매크로라도 순서가 다르면 다른 키
+	for (uint32_t i = 0; i < request.defineCount; ++i)
+	{
+		const RHI::ShaderDefine& define = request.pDefines[i];
+		ASSERT(define.name != nullptr);
+
+		key = HashString(define.name, key);
+		key = HashString(define.value != nullptr ? define.value : "", key);
+	}
+
+	outKey = key;
+
+	return true;
+}
+
+void ShaderCache::InvalidateFileHashes()
+{
+	mFileHashes.clear();
+}
+
+bool ShaderCache::DependsOn(const std::string& shaderPath, const std::string& filePath) const
+{
+	const std::string target = NormalizePath(filePath);
+
+	std::vector<std::string> stack = { NormalizePath(shaderPath) };
+	std::unordered_set<std::string> visitedPaths;
+
+	while (!stack.empty())
+	{
+		const std::string path = std::move(stack.back());
+		stack.pop_back();
+
+		if (path == target)
+		{
+			return true;
+		}
+
+		if (!visitedPaths.insert(path).second)
+		{
+			continue;
+		}
+
+		std::unordered_map<std::string, std::vector<std::string>>::const_iterator iter = mIncludeGraph.find(path);
+
+		if (iter != mIncludeGraph.end())
+		{
+			stack.insert(stack.end(), iter->second.begin(), iter->second.end());
+		}
+	}
+
+	return false;
+}
+
+void ShaderCache::openArchive()
+{
+	mpArchiveEntries = nullptr;
+	mArchiveEntryCount = 0;
+
+	mStats.entryCount = 0;
+	mStats.archiveBytes = 0;
+
+	if (!mArchive.TryOpen(mArchivePath.c_str()))
+	{
+		return;
+	}
+
+	const uint8_t* const pData = mArchive.GetData();
+	const size_t size = mArchive.GetSize();
+
+	ArchiveHeader header;
+
+	if (size < sizeof(ArchiveHeader))
+	{
+		mArchive.Close();
+
+		return;
+	}
+
+	memcpy(&header, pData, sizeof(ArchiveHeader));
+
+	const uint64_t tableEnd = sizeof(ArchiveHeader) + static_cast<uint64_t>(header.entryCount) * sizeof(ArchiveEntry);
+
+	// 다른 버전이거나 잘린 파일은 버리고 다음 Save에서 다시 만듦
+	if (header.magic != ARCHIVE_MAGIC || header.version != ARCHIVE_VERSION || tableEnd > size)
+	{
+		mArchive.Close();
+
+		return;
+	}
+
+	const ArchiveEntry* const pEntries = reinterpret_cast<const ArchiveEntry*>(pData + sizeof(ArchiveHeader));
+
+	for (uint32_t i = 0; i < header.entryCount; ++i)
+	{
+		const ArchiveEntry& entry = pEntries[i];
+
+		const bool bSorted = i == 0 || pEntries[i - 1].key < entry.key;
+
+		if (!bSorted || entry.offset < tableEnd || entry.offset > size || entry.size > size - entry.offset)
+		{
+			mArchive.Close();
+
+			return;
+		}
+	}
+
+	mpArchiveEntries = pEntries;
+	mArchiveEntryCount = header.entryCount;
+
+	mStats.entryCount = header.entryCount;
+	mStats.archiveBytes = size;
+}
+
+const ShaderCache::ArchiveEntry* ShaderCache::findArchiveEntry(const uint64_t key) const
+{
+	const ArchiveEntry* const pEnd = mpArchiveEntries + mArchiveEntryCount;
+
+	const ArchiveEntry* const pEntry = std::lower_bound(mpArchiveEntries, pEnd, key, [](const ArchiveEntry& entry, const uint64_t value)
+		{
+			return entry.key < value;
+		});
+
+	if (pEntry == pEnd || pEntry->key != key)
+	{
+		return nullptr;
+	}
+
+	return pEntry;
+}
+
+bool ShaderCache::tryHashFile(const std::string& path, std::unordered_set<std::string>& visitingPaths, uint64_t& outHash)
+{
+	std::unordered_map<std::string, uint64_t>::const_iterator iter = mFileHashes.find(path);
+
+	if (iter != mFileHashes.end())
+	{
+		outHash = iter->second;
+
+		return true;
+	}
+
+	// 순환 include는 한 번만 셈(#pragma once와 같은 효과)
+	if (visitingPaths.find(path) != visitingPaths.end())
+	{
+		outHash = HashString(path.c_str());
+
+		return true;
+	}
+
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+
+	const std::string source = stream.str();
+
+	visitingPaths.insert(path);
+
+	uint64_t hash = HashBytes(source.data(), source.size());
+
+	// include는 포함하는 파일의 폴더 기준
+	const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+	std::vector<std::string> includePaths;
+
+	std::istringstream lines(source);
+	std::string line;
+	std::string includeName;
+
+	while (std::getline(lines, line))
+	{
+		if (TryParseInclude(line, includeName))
+		{
+			includePaths.push_back(NormalizePath(directory / includeName));
+		}
+	}
+
+	// 해시에 실패해도 관계는 남겨서 고쳐진 include를 감지할 수 있게 함
+	mIncludeGraph[path] = includePaths;
+
+	for (const std::string& includePath : includePaths)
+	{
+		uint64_t includeHash;
+
+		if (!tryHashFile(includePath, visitingPaths, includeHash))
+		{
+			visitingPaths.erase(path);
+
+			return false;
+		}
+
+		hash = HashCombine(hash, includeHash);
+	}
+
+	visitingPaths.erase(path);
+
+	mFileHashes[path] = hash;
+	outHash = hash;
+
+	return true;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+
+#include "Core/Assert.h"
+#include "Core/MappedFile.h"
+#include "Renderer/RHI/RHITypes.h"
+
+// 셰이더 바이트코드 캐시
+// 키는 소스와 #include로 따라 들어가는 모든 파일의 내용, 진입점, 타깃, 매크로로 만듦
+// 아카이브는 정렬된 항목 표 + 바이트코드를 이어 붙인 파일 하나로, 매핑해서 복사 없이 읽음
+// 컴파일은 CompileFunction으로 주입하므로 컴파일러 없이도 동작을 확인할 수 있음
+class ShaderCache final
+{
+public:
+	struct Request
+	{
+		const char* path;
+		const char* entryPoint;
+		const char* target;
+		const RHI::ShaderDefine* pDefines;
+		uint32_t defineCount;
+	};
+
+	typedef std::function<bool(const Request&, std::vector<uint8_t>&)> CompileFunction;
+
+	struct Stats
+	{
+		uint32_t hitCount;
+		uint32_t missCount;
+		uint32_t failCount;
+		uint32_t entryCount;
+		uint64_t archiveBytes;
+		float hashTimeMs;
+		float compileTimeMs;
+	};
+
+public:
+	// salt: 컴파일러, 빌드 구성처럼 소스 밖에서 결과를 바꾸는 값
+	ShaderCache(const char* const archivePath, const char* const salt, CompileFunction compile);
+	~ShaderCache() = default;
+
+	// 없으면 컴파일해서 채움, 반환된 포인터는 Save나 소멸 전까지 유효
+	bool TryGetBytecode(const Request& request, const uint8_t*& outBytecode, size_t& outSize);
+
+	// 이번 실행에서 요청된 항목만 새 아카이브로 기록(오래된 항목 정리)
+	bool Save();
+
+	bool TryComputeKey(const Request& request, uint64_t& outKey);
+
+	// 미리 계산한 키로 찾기/넣기(백그라운드 컴파일 결과용)
+	bool TryFindBytecode(const uint64_t key, const uint8_t*& outBytecode, size_t& outSize);
+	void StoreBytecode(const uint64_t key, std::vector<uint8_t>&& bytecode, const uint8_t*& outBytecode, size_t& outSize);
+
+	// 소스가 바뀌었을 때 파일 해시를 다시 읽게 함
+	void InvalidateFileHashes();
+
+	// 마지막으로 해시할 때 본 include 관계 기준으로 shaderPath가 filePath를 포함하는지
+	bool DependsOn(const std::string& shaderPath, const std::string& filePath) const;
+
+	inline const Stats& GetStats() const
+	{
+		return mStats;
+	}
+
+	inline const std::string& GetArchivePath() const
+	{
+		return mArchivePath;
+	}
+
+private:
+	enum : uint32_t
+	{
+		ARCHIVE_MAGIC = 0x43485347, // "GSHC"
+		ARCHIVE_VERSION = 1,
+		ARCHIVE_ALIGNMENT = 16
+	};
+
+	struct ArchiveHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t dummy;
+	};
+
+	// 키 오름차순
+	struct ArchiveEntry
+	{
+		uint64_t key;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+private:
+	std::string mArchivePath;
+	uint64_t mSaltHash;
+	CompileFunction mCompile;
+
+	MappedFile mArchive;
+	const ArchiveEntry* mpArchiveEntries;
+	uint32_t mArchiveEntryCount;
+
+	// 경로 -> 자신과 include 파일 전체의 해시
+	std::unordered_map<std::string, uint64_t> mFileHashes;
+
+	// 경로 -> 직접 include하는 파일, 해시를 지워도 남겨둠
+	std::unordered_map<std::string, std::vector<std::string>> mIncludeGraph;
+
+	std::unordered_map<uint64_t, std::vector<uint8_t>> mCompiledBytecodes;
+	std::vector<std::vector<uint8_t>> mUncachedBytecodes;
+	std::unordered_set<uint64_t> mUsedArchiveKeys;
+
+	Stats mStats;
+
+private:
+	void openArchive();
+	const ArchiveEntry* findArchiveEntry(const uint64_t key) const;
+
+	bool tryHashFile(const std::string& path, std::unordered_set<std::string>& visitingPaths, uint64_t& outHash);
+
+private:
+	ShaderCache(const ShaderCache& other) = delete;
+	ShaderCache(ShaderCache&& other) = delete;
+	ShaderCache& operator=(const ShaderCache& other) = delete;
+	ShaderCache& operator=(ShaderCache&& other) = delete;
+};
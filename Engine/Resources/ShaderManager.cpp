@@ -1,36 +1,87 @@
 #include "ShaderManager.h"
 
-#include <d3dcompiler.h>
+#include <chrono>
 
-#include "Core/ComHelper.h"
-#include "Core/StringHelper.h"
 #include "Core/LogHelper.h"
 #include "UI/ImGuiHeaders.h"
 #include "Core/CommonDefs.h"
+#include "Core/JobSystem.h"
 
 enum
 {
-	DEFAULT_BUFFER_SIZE = 32
+	DEFAULT_BUFFER_SIZE = 32,
+	MAX_SHADER_DEFINE_COUNT = 5
 };
 
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<float, std::milli>;
+
 ShaderManager* ShaderManager::spInstance = nullptr;
 
-ShaderManager::ShaderManager(ID3D11Device& device)
+// 같은 소스라도 백엔드와 빌드 구성에 따라 결과가 다름
+static std::string MakeShaderCacheSalt(const RHI::Device& device)
+{
+	std::string salt = device.GetName();
+
+#if defined(DEBUG) || defined(_DEBUG)
+	salt += "|Debug";
+#else
+	salt += "|Release";
+#endif
+
+	return salt;
+}
+
+ShaderManager::ShaderManager(RHI::Device& device)
 	: mDevice(device)
-	, mpInputLayout{ nullptr, }
+	, mInputLayouts{}
 	, mVertexShaderMap()
+	, mVertexShaderVariantPaths()
 	, mPixelShaderMap()
+	, mPixelShaderVariants()
+	, mPixelShaderVariantCount(0)
+	, mShaderCache(
+		SHADER_CACHE_PATH,
+		MakeShaderCacheSalt(device).c_str(),
+		[&device](const ShaderCache::Request& request, std::vector<uint8_t>& outBytecode)
+		{
+			return device.TryCompileShaderFromFile(
+				request.path,
+				request.entryPoint,
+				request.target,
+				request.pDefines,
+				request.defineCount,
+				outBytecode
+			);
+		})
+	, mLoadTimeMs(0.f)
+	, mFileWatcher()
+	, mChangedPaths()
+	, mReloadingPaths()
+	, mRequeuedPaths()
+	, mReloadMutex()
+	, mReloadCondition()
+	, mCompletedReloads()
+	, mInFlightReloadCount(0)
+	, mReloadCount(0)
+	, mReloadFailCount(0)
+	, mLastReloadTimeMs(0.f)
 {
+	const Clock::time_point loadStart = Clock::now();
+
 	mVertexShaderMap.reserve(DEFAULT_BUFFER_SIZE);
 	mPixelShaderMap.reserve(DEFAULT_BUFFER_SIZE);
+	mPixelShaderVariants.reserve(DEFAULT_BUFFER_SIZE);
 
-	// vs entry
+	// vs entry, 같은 셰이더를 다시 적으면 그 정점 형식의 입력 레이아웃만 만듦
 	const std::pair<const char*, Vertex::EType> vertexShaderEntries[] =
 	{
 		{ SHADER_PATH("VSBasic.hlsl"), Vertex::EType::POS_NORMAL_UV },
+		{ SHADER_PATH("VSBasic.hlsl"), Vertex::EType::POS_NORMAL_UV_SPLIT },
 		{ SHADER_PATH("VSSprite.hlsl"), Vertex::EType::POS_NORMAL_UV },
 		{ SHADER_PATH("VSFullScreen.hlsl"), Vertex::EType::POS_NORMAL_UV },
 		{ SHADER_PATH("VSBlinnPhong.hlsl"), Vertex::EType::POS_NORMAL_UV },
+		{ SHADER_PATH("VSDepthOnly.hlsl"), Vertex::EType::POS },
 	};
 
 	for (const std::pair<const char*, Vertex::EType>& entry : vertexShaderEntries)
@@ -38,101 +89,131 @@ ShaderManager::ShaderManager(ID3D11Device& device)
 		LoadVertexShaderAndInputLayout(entry.first, entry.second);
 	}
 
-	// ps entry
-	const char* const pixelShaderEntries[] =
+	// 양자화된 메쉬용 변형
+	const std::pair<const char*, const char*> quantizedVertexShaderEntries[] =
 	{
-		SHADER_PATH("PSBasic.hlsl"),
-		SHADER_PATH("PSSprite.hlsl"),
-		SHADER_PATH("PSFullScreen.hlsl"),
-		SHADER_PATH("PSDebugSphere.hlsl"),
-		SHADER_PATH("PSBlinnPhong.hlsl"),
+		{ SHADER_PATH("VSBasic.hlsl"), SHADER_PATH("VSBasicQuantized.hlsl") },
+		{ SHADER_PATH("VSBlinnPhong.hlsl"), SHADER_PATH("VSBlinnPhongQuantized.hlsl") },
 	};
 
-	for (const char* const entry : pixelShaderEntries)
+	for (const std::pair<const char*, const char*>& entry : quantizedVertexShaderEntries)
+	{
+		LoadVertexShaderVariant(entry.first, Vertex::EType::POS_NORMAL_UV_QUANTIZED, entry.second);
+	}
+
+	// ps entry, 셰이더가 #if로 나눠둔 기능만 지정
+	const std::pair<const char*, uint32_t> pixelShaderEntries[] =
+	{
+		{ SHADER_PATH("PSBasic.hlsl"), SHADER_FEATURE_TEXTURED | SHADER_FEATURE_TEXTURE_ARRAY },
+		{ SHADER_PATH("PSSprite.hlsl"), SHADER_FEATURE_NONE },
+		{ SHADER_PATH("PSFullScreen.hlsl"), SHADER_FEATURE_NONE },
+		{ SHADER_PATH("PSDebugSphere.hlsl"), SHADER_FEATURE_NONE },
+		{ SHADER_PATH("PSBlinnPhong.hlsl"), SHADER_FEATURE_TEXTURED | SHADER_FEATURE_TEXTURE_ARRAY | SHADER_FEATURE_LIGHTING },
+	};
+
+	for (const std::pair<const char*, uint32_t>& entry : pixelShaderEntries)
+	{
+		LoadPixelShader(entry.first, entry.second);
+	}
+
+	// 다음 실행부터는 컴파일 없이 아카이브에서 읽음
+	if (!mShaderCache.Save())
 	{
-		LoadPixelShader(entry);
+		LOG_SYSTEM_ERROR(E_FAIL, "ShaderCache - Save");
 	}
+
+	mLoadTimeMs = Milliseconds(Clock::now() - loadStart).count();
+
+	// 감시에 실패해도 재시작하면 반영되므로 계속 진행
+	mFileWatcher.TryStart(SHADER_DIRECTORY);
 }
 
 ShaderManager::~ShaderManager()
 {
-	for (std::pair<const std::string, ID3D11PixelShader*>& pair : mPixelShaderMap)
+	mFileWatcher.Stop();
+
+	// 컴파일 중인 작업이 디바이스를 쓰고 있으므로 끝날 때까지 기다림
 	{
-		SafeRelease(pair.second);
+		std::unique_lock<std::mutex> lock(mReloadMutex);
+
+		mReloadCondition.wait(lock, [this]()
+			{
+				return mInFlightReloadCount == 0;
+			});
 	}
 
-	for (std::pair<const std::string, ID3D11VertexShader*>& pair : mVertexShaderMap)
+	mShaderCache.Save();
+
+	std::vector<uint32_t> variantFeatures;
+
+	for (const PixelShaderVariants& variants : mPixelShaderVariants)
 	{
-		SafeRelease(pair.second);
+		getVariantFeatures(variants.featureMask, variantFeatures);
+
+		for (const uint32_t features : variantFeatures)
+		{
+			mDevice.DestroyPixelShader(variants.shaders[features]);
+		}
 	}
 
-	for (ID3D11InputLayout* pInputLayout : mpInputLayout)
+	for (std::pair<const std::string, RHI::VertexShaderHandle>& pair : mVertexShaderMap)
 	{
-		SafeRelease(pInputLayout);
+		mDevice.DestroyVertexShader(pair.second);
+	}
+
+	for (const RHI::InputLayoutHandle inputLayout : mInputLayouts)
+	{
+		if (inputLayout.IsValid())
+		{
+			mDevice.DestroyInputLayout(inputLayout);
+		}
 	}
 }
 
 void ShaderManager::LoadVertexShaderAndInputLayout(const std::string& path, const Vertex::EType eType)
 {
-	ID3DBlob* pVSBlob = compileShaderAlloc(path, EShaderType::VERTEX);
-	{
-		ASSERT(pVSBlob != nullptr);
+	const uint8_t* pBytecode;
+	size_t bytecodeSize;
 
-		ID3D11VertexShader* pVertexShader = nullptr;
-		{
-			const HRESULT hr = mDevice.CreateVertexShader(
-				pVSBlob->GetBufferPointer(),
-				pVSBlob->GetBufferSize(),
-				nullptr,
-				&pVertexShader
-			);
-
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreateVertexShader");
+	if (!tryGetShaderBytecode(path, EShaderType::VERTEX, SHADER_FEATURE_NONE, SHADER_FEATURE_NONE, pBytecode, bytecodeSize))
+	{
+		ASSERT(false);
 
-				ASSERT(false);
-			}
-		}
+		return;
+	}
 
-		mVertexShaderMap.insert(std::make_pair(path, pVertexShader));
+	if (mVertexShaderMap.find(path) == mVertexShaderMap.end())
+	{
+		const RHI::VertexShaderHandle vertexShader = mDevice.CreateVertexShader(pBytecode, bytecodeSize);
+		ASSERT(vertexShader.IsValid());
 
-		if (mpInputLayout[static_cast<int>(eType)] == nullptr)
-		{
-			const std::vector<D3D11_INPUT_ELEMENT_DESC> inputDescs = Vertex::GetInputLayoutDescs(eType);
+		mVertexShaderMap.insert(std::make_pair(path, vertexShader));
+	}
 
-			ID3D11InputLayout* pInputLayout = nullptr;
-			{
-				const HRESULT hr = mDevice.CreateInputLayout(
-					inputDescs.data(),
-					static_cast<UINT>(inputDescs.size()),
-					pVSBlob->GetBufferPointer(),
-					pVSBlob->GetBufferSize(),
-					&pInputLayout
-				);
-
-				if (FAILED(hr))
-				{
-					LOG_SYSTEM_ERROR(hr, "CreateInputLayout");
+	if (!mInputLayouts[static_cast<int>(eType)].IsValid())
+	{
+		const std::vector<RHI::InputElementDesc> inputDescs = Vertex::GetInputLayoutDescs(eType);
 
-					ASSERT(false);
-				}
-			}
+		const RHI::InputLayoutHandle inputLayout = mDevice.CreateInputLayout(
+			inputDescs.data(),
+			static_cast<uint32_t>(inputDescs.size()),
+			pBytecode,
+			bytecodeSize
+		);
+		ASSERT(inputLayout.IsValid());
 
-			mpInputLayout[static_cast<int>(eType)] = pInputLayout;
-		}
+		mInputLayouts[static_cast<int>(eType)] = inputLayout;
 	}
-	SafeRelease(pVSBlob);
 }
 
-ID3D11InputLayout* ShaderManager::GetInputLayoutOrNull(const Vertex::EType eType) const
+RHI::InputLayoutHandle ShaderManager::GetInputLayout(const Vertex::EType eType) const
 {
-	return mpInputLayout[static_cast<int>(eType)];
+	return mInputLayouts[static_cast<int>(eType)];
 }
 
-ID3D11VertexShader* ShaderManager::GetVertexShaderOrNull(const std::string& path) const
+RHI::VertexShaderHandle ShaderManager::GetVertexShader(const std::string& path) const
 {
-#define MAP_ITER std::unordered_map<std::string, ID3D11VertexShader*>::const_iterator
+#define MAP_ITER std::unordered_map<std::string, RHI::VertexShaderHandle>::const_iterator
 
 	MAP_ITER iter = mVertexShaderMap.find(path);
 
@@ -143,40 +224,89 @@ ID3D11VertexShader* ShaderManager::GetVertexShaderOrNull(const std::string& path
 
 #undef MAP_ITER
 
-	return nullptr;
+	return { 0 };
 }
 
-void ShaderManager::LoadPixelShader(const std::string& path)
+void ShaderManager::LoadVertexShaderVariant(const std::string& path, const Vertex::EType eType, const std::string& variantPath)
 {
-	ID3DBlob* pPSBlob = compileShaderAlloc(path, EShaderType::PIXEL);
+	ASSERT(mVertexShaderMap.find(path) != mVertexShaderMap.end());
+
+	LoadVertexShaderAndInputLayout(variantPath, eType);
+
+	mVertexShaderVariantPaths[static_cast<int>(eType)].insert(std::make_pair(path, variantPath));
+}
+
+RHI::VertexShaderHandle ShaderManager::GetVertexShader(const std::string& path, const Vertex::EType eType) const
+{
+	const std::unordered_map<std::string, std::string>& variantPaths = mVertexShaderVariantPaths[static_cast<int>(eType)];
+
+#define MAP_ITER std::unordered_map<std::string, std::string>::const_iterator
+
+	MAP_ITER iter = variantPaths.find(path);
+
+	if (iter != variantPaths.end())
 	{
-		ASSERT(pPSBlob != nullptr);
+		return GetVertexShader(iter->second);
+	}
 
-		ID3D11PixelShader* pPixelShader = nullptr;
-		{
-			const HRESULT hr = mDevice.CreatePixelShader(
-				pPSBlob->GetBufferPointer(),
-				pPSBlob->GetBufferSize(),
-				nullptr,
-				&pPixelShader
-			);
+#undef MAP_ITER
 
-			if (FAILED(hr))
-			{
-				LOG_SYSTEM_ERROR(hr, "CreatePixelShader");
+	return GetVertexShader(path);
+}
 
-				ASSERT(false);
-			}
+void ShaderManager::LoadPixelShader(const std::string& path, const uint32_t featureMask)
+{
+	ASSERT(featureMask < SHADER_VARIANT_COUNT);
+	ASSERT(mPixelShaderMap.find(path) == mPixelShaderMap.end());
+
+	PixelShaderVariants variants;
+	variants.path = path;
+	variants.featureMask = featureMask;
+
+	std::vector<uint32_t> variantFeatures;
+	getVariantFeatures(featureMask, variantFeatures);
+
+	for (const uint32_t features : variantFeatures)
+	{
+		const uint8_t* pBytecode;
+		size_t bytecodeSize;
+
+		if (!tryGetShaderBytecode(path, EShaderType::PIXEL, featureMask, features, pBytecode, bytecodeSize))
+		{
+			ASSERT(false);
+
+			return;
 		}
 
-		mPixelShaderMap.insert(std::make_pair(path, pPixelShader));
+		const RHI::PixelShaderHandle pixelShader = mDevice.CreatePixelShader(pBytecode, bytecodeSize);
+		ASSERT(pixelShader.IsValid());
+
+		variants.shaders[features] = pixelShader;
 	}
-	SafeRelease(pPSBlob);
+
+	fillVariantAliases(variants);
+
+	mPixelShaderMap.insert(std::make_pair(path, static_cast<uint32_t>(mPixelShaderVariants.size())));
+	mPixelShaderVariants.push_back(std::move(variants));
+
+	mPixelShaderVariantCount += static_cast<uint32_t>(variantFeatures.size());
 }
 
-ID3D11PixelShader* ShaderManager::GetPixelShaderOrNull(const std::string& path) const
+RHI::PixelShaderHandle ShaderManager::GetPixelShader(const std::string& path) const
 {
-#define MAP_ITER std::unordered_map<std::string, ID3D11PixelShader*>::const_iterator
+	const uint32_t shaderIndex = GetPixelShaderIndex(path);
+
+	if (shaderIndex == INVALID_SHADER_INDEX)
+	{
+		return { 0 };
+	}
+
+	return GetPixelShaderVariant(shaderIndex, SHADER_FEATURE_NONE);
+}
+
+uint32_t ShaderManager::GetPixelShaderIndex(const std::string& path) const
+{
+#define MAP_ITER std::unordered_map<std::string, uint32_t>::const_iterator
 
 	MAP_ITER iter = mPixelShaderMap.find(path);
 
@@ -187,20 +317,20 @@ ID3D11PixelShader* ShaderManager::GetPixelShaderOrNull(const std::string& path)
 
 #undef MAP_ITER
 
-	return nullptr;
+	return INVALID_SHADER_INDEX;
 }
 
 void ShaderManager::DrawEditorUI()
 {
 	ImGui::PushID("ShaderManager");
 
-	ImGui::Text(UTF8_TEXT(" ̴"));
+	ImGui::Text(UTF8_TEXT("정점 셰이더"));
 
-#define MAP_ITER std::unordered_map<std::string, ID3D11VertexShader*>::const_iterator
+#define MAP_ITER std::unordered_map<std::string, RHI::VertexShaderHandle>::const_iterator
 
 	for (MAP_ITER iter = mVertexShaderMap.cbegin(); iter != mVertexShaderMap.cend(); ++iter)
 	{
-		const std::pair<const std::string, ID3D11VertexShader*>& pair = *iter;
+		const std::pair<const std::string, RHI::VertexShaderHandle>& pair = *iter;
 		ImGui::Text("%s", pair.first.c_str());
 	}
 
@@ -208,17 +338,37 @@ void ShaderManager::DrawEditorUI()
 
 	ImGui::Separator();
 
-	ImGui::Text(UTF8_TEXT("ȼ ̴"));
+	ImGui::Text(UTF8_TEXT("픽셀 셰이더"));
 
-#define MAP_ITER std::unordered_map<std::string, ID3D11PixelShader*>::const_iterator
+	std::vector<uint32_t> variantFeatures;
 
-	for (MAP_ITER iter = mPixelShaderMap.cbegin(); iter != mPixelShaderMap.cend(); ++iter)
+	for (const PixelShaderVariants& variants : mPixelShaderVariants)
 	{
-		const std::pair<const std::string, ID3D11PixelShader*>& pair = *iter;
-		ImGui::Text("%s", pair.first.c_str());
+		getVariantFeatures(variants.featureMask, variantFeatures);
+
+		ImGui::Text("%s (Variants: %u)", variants.path.c_str(), static_cast<uint32_t>(variantFeatures.size()));
 	}
 
-#undef MAP_ITER
+	ImGui::Text("Total Variants: %u", mPixelShaderVariantCount);
+
+	ImGui::SeparatorText(UTF8_TEXT("바이트코드 캐시"));
+	{
+		const ShaderCache::Stats& cacheStats = mShaderCache.GetStats();
+
+		ImGui::Text("%s", mShaderCache.GetArchivePath().c_str());
+		ImGui::Text("Hits: %u / Misses: %u (Failed: %u)", cacheStats.hitCount, cacheStats.missCount, cacheStats.failCount);
+		ImGui::Text("Entries: %u (%.1f KB)", cacheStats.entryCount, cacheStats.archiveBytes / 1024.f);
+		ImGui::Text("Hash: %.3f ms / Compile: %.3f ms", cacheStats.hashTimeMs, cacheStats.compileTimeMs);
+		ImGui::Text("Startup Load: %.3f ms", mLoadTimeMs);
+	}
+
+	ImGui::SeparatorText(UTF8_TEXT("핫 리로드"));
+	{
+		ImGui::Text("Watching: %s", mFileWatcher.IsWatching() ? SHADER_DIRECTORY : "-");
+		ImGui::Text("Compiling: %u", static_cast<uint32_t>(mReloadingPaths.size()));
+		ImGui::Text("Reloaded: %u (Failed: %u)", mReloadCount, mReloadFailCount);
+		ImGui::Text("Last Reload: %.1f ms", mLastReloadTimeMs);
+	}
 
 	ImGui::PopID();
 }
@@ -227,7 +377,7 @@ bool ShaderManager::DrawShaderSelectorPopupAndSelectShaders(std::string& outPath
 {
 	ImGui::PushID("ShaderManager");
 
-	const char* const popupName = UTF8_TEXT("̴ ");
+	const char* const popupName = UTF8_TEXT("셰이더 목록");
 
 	ImGui::OpenPopup(popupName);
 
@@ -238,11 +388,11 @@ bool ShaderManager::DrawShaderSelectorPopupAndSelectShaders(std::string& outPath
 	{
 		if (bPixel)
 		{
-			for (const std::pair<const std::string, ID3D11PixelShader*>& pair : mPixelShaderMap)
+			for (const PixelShaderVariants& variants : mPixelShaderVariants)
 			{
-				if (ImGui::Button(pair.first.c_str()))
+				if (ImGui::Button(variants.path.c_str()))
 				{
-					outPath = pair.first;
+					outPath = variants.path;
 
 					bRet = true;
 				}
@@ -250,8 +400,24 @@ bool ShaderManager::DrawShaderSelectorPopupAndSelectShaders(std::string& outPath
 		}
 		else
 		{
-			for (const std::pair<const std::string, ID3D11VertexShader*>& pair : mVertexShaderMap)
+			for (const std::pair<const std::string, RHI::VertexShaderHandle>& pair : mVertexShaderMap)
 			{
+				// 변형은 메쉬 정점 형식에 따라 자동으로 고름
+				bool bVariant = false;
+
+				for (const std::unordered_map<std::string, std::string>& variantPaths : mVertexShaderVariantPaths)
+				{
+					for (const std::pair<const std::string, std::string>& variantPair : variantPaths)
+					{
+						bVariant = bVariant || variantPair.second == pair.first;
+					}
+				}
+
+				if (bVariant)
+				{
+					continue;
+				}
+
 				if (ImGui::Button(pair.first.c_str()))
 				{
 					outPath = pair.first;
@@ -269,62 +435,397 @@ bool ShaderManager::DrawShaderSelectorPopupAndSelectShaders(std::string& outPath
 	return bRet || ImGui::IsKeyPressed(ImGuiKey_Escape);
 }
 
-void ShaderManager::Initialize(ID3D11Device& device)
+void ShaderManager::Initialize(RHI::Device& device)
 {
 	ASSERT(spInstance == nullptr);
 
 	spInstance = new ShaderManager(device);
 }
 
-ID3DBlob* ShaderManager::compileShaderAlloc(const std::string& path, const EShaderType eType) const
+bool ShaderManager::tryGetShaderBytecode(
+	const std::string& path,
+	const EShaderType eType,
+	const uint32_t featureMask,
+	const uint32_t features,
+	const uint8_t*& outBytecode,
+	size_t& outSize
+)
 {
-	constexpr const char* const targets[static_cast<int>(EShaderType::COUNT)] =
+	RHI::ShaderDefine defines[MAX_SHADER_DEFINE_COUNT];
+	const uint32_t defineCount = makeShaderDefines(featureMask, features, defines);
+
+	const ShaderCache::Request request = { path.c_str(), "main", getShaderTarget(eType), defines, defineCount };
+
+	return mShaderCache.TryGetBytecode(request, outBytecode, outSize);
+}
+
+void ShaderManager::ApplyShaderReloads()
+{
+	// 1. 바뀐 파일을 include하는 셰이더를 다시 컴파일 요청
+	mFileWatcher.PollChangedFiles(mChangedPaths);
+
+	if (!mChangedPaths.empty())
 	{
-		#define SHADER_ENTRY(type, target) target,
-		SHADER_LIST
-		#undef SHADER_ENTRY
-	};
+		mShaderCache.InvalidateFileHashes();
+
+		for (const std::pair<const std::string, RHI::VertexShaderHandle>& pair : mVertexShaderMap)
+		{
+			for (const std::string& changedPath : mChangedPaths)
+			{
+				if (mShaderCache.DependsOn(pair.first, changedPath))
+				{
+					requestReload(pair.first, EShaderType::VERTEX);
+
+					break;
+				}
+			}
+		}
+
+		for (const PixelShaderVariants& variants : mPixelShaderVariants)
+		{
+			for (const std::string& changedPath : mChangedPaths)
+			{
+				if (mShaderCache.DependsOn(variants.path, changedPath))
+				{
+					requestReload(variants.path, EShaderType::PIXEL);
+
+					break;
+				}
+			}
+		}
+	}
+
+	// 2. 끝난 컴파일 결과로 교체
+	std::vector<ReloadResult> completedReloads;
 
-	ID3DBlob* pRetBlob = nullptr;
-	ID3DBlob* pErrorBlob = nullptr;
 	{
-		UINT shaderCompileFlags = 0;
+		std::lock_guard<std::mutex> lock(mReloadMutex);
 
-#if defined(DEBUG) || defined(_DEBUG)
-		shaderCompileFlags |= D3DCOMPILE_DEBUG;
-		shaderCompileFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
+		completedReloads.swap(mCompletedReloads);
+	}
 
-		TCHAR widePath[MAX_PATH];
-		ConvertMultiToWide(widePath, path.c_str());
-
-		const HRESULT hr = D3DCompileFromFile(
-			widePath,
-			nullptr,
-			D3D_COMPILE_STANDARD_FILE_INCLUDE,
-			"main",
-			targets[static_cast<int>(eType)],
-			shaderCompileFlags,
-			0,
-			&pRetBlob,
-			&pErrorBlob
-		);
+	for (ReloadResult& result : completedReloads)
+	{
+		mReloadingPaths.erase(result.path);
 
-		if (FAILED(hr))
+		if (result.bSucceeded && tryReplaceShaders(result))
 		{
-			if (pErrorBlob != nullptr)
+			++mReloadCount;
+			mLastReloadTimeMs = Milliseconds(Clock::now() - result.requestTime).count();
+
+			// 다음 실행에서도 다시 컴파일하지 않도록 캐시에 넣음
+			for (VariantBytecode& variant : result.variants)
 			{
-				LOG_SYSTEM_ERROR(hr, reinterpret_cast<const char*>(pErrorBlob->GetBufferPointer()));
+				if (variant.bKeyValid && !variant.bCached)
+				{
+					const uint8_t* pBytecode;
+					size_t bytecodeSize;
+
+					mShaderCache.StoreBytecode(variant.key, std::move(variant.bytecode), pBytecode, bytecodeSize);
+				}
 			}
-			else
+		}
+		else
+		{
+			// 컴파일 오류는 디바이스가 기록함, 이전 셰이더를 계속 사용
+			++mReloadFailCount;
+		}
+
+		// 컴파일하는 동안 또 바뀐 파일
+		if (mRequeuedPaths.erase(result.path) > 0)
+		{
+			requestReload(result.path, result.eType);
+		}
+	}
+}
+
+void ShaderManager::requestReload(const std::string& path, const EShaderType eType)
+{
+	if (mReloadingPaths.find(path) != mReloadingPaths.end())
+	{
+		mRequeuedPaths.insert(path);
+
+		return;
+	}
+
+	const char* const target = getShaderTarget(eType);
+
+	ReloadResult result;
+	result.path = path;
+	result.eType = eType;
+	result.featureMask = eType == EShaderType::PIXEL ? mPixelShaderVariants[mPixelShaderMap.at(path)].featureMask : SHADER_FEATURE_NONE;
+	result.bSucceeded = false;
+	result.requestTime = Clock::now();
+
+	std::vector<uint32_t> variantFeatures;
+	getVariantFeatures(result.featureMask, variantFeatures);
+
+	// 예전 내용으로 되돌린 경우 등 캐시에 있는 변형은 컴파일하지 않음
+	bool bAllCached = true;
+
+	for (const uint32_t features : variantFeatures)
+	{
+		RHI::ShaderDefine defines[MAX_SHADER_DEFINE_COUNT];
+		const uint32_t defineCount = makeShaderDefines(result.featureMask, features, defines);
+
+		const ShaderCache::Request request = { path.c_str(), "main", target, defines, defineCount };
+
+		VariantBytecode variant;
+		variant.features = features;
+		variant.bKeyValid = mShaderCache.TryComputeKey(request, variant.key);
+		variant.bCached = false;
+
+		const uint8_t* pBytecode;
+		size_t bytecodeSize;
+
+		if (variant.bKeyValid && mShaderCache.TryFindBytecode(variant.key, pBytecode, bytecodeSize))
+		{
+			variant.bCached = true;
+			variant.bytecode.assign(pBytecode, pBytecode + bytecodeSize);
+		}
+		else
+		{
+			bAllCached = false;
+		}
+
+		result.variants.push_back(std::move(variant));
+	}
+
+	if (bAllCached)
+	{
+		result.bSucceeded = true;
+
+		if (tryReplaceShaders(result))
+		{
+			++mReloadCount;
+			mLastReloadTimeMs = Milliseconds(Clock::now() - result.requestTime).count();
+		}
+		else
+		{
+			++mReloadFailCount;
+		}
+
+		return;
+	}
+
+	mReloadingPaths.insert(path);
+
+	{
+		std::lock_guard<std::mutex> lock(mReloadMutex);
+
+		++mInFlightReloadCount;
+	}
+
+	std::function<void()> job = [this, target, result = std::move(result)]() mutable
+		{
+			result.bSucceeded = true;
+
+			for (VariantBytecode& variant : result.variants)
 			{
-				LOG_SYSTEM_ERROR(hr, "D3DCompileFromFile");
+				if (variant.bCached)
+				{
+					continue;
+				}
+
+				RHI::ShaderDefine defines[MAX_SHADER_DEFINE_COUNT];
+				const uint32_t defineCount = makeShaderDefines(result.featureMask, variant.features, defines);
+
+				// 한 변형이라도 실패하면 전부 이전 것을 유지
+				if (!mDevice.TryCompileShaderFromFile(result.path.c_str(), "main", target, defines, defineCount, variant.bytecode)
+					|| variant.bytecode.empty())
+				{
+					result.bSucceeded = false;
+
+					break;
+				}
 			}
 
-			ASSERT(false);
+			std::lock_guard<std::mutex> lock(mReloadMutex);
+
+			mCompletedReloads.push_back(std::move(result));
+			--mInFlightReloadCount;
+
+			mReloadCondition.notify_all();
+		};
+
+	if (JobSystem::IsInitialized())
+	{
+		JobSystem::GetInstance().Submit(std::move(job));
+	}
+	else
+	{
+		job();
+	}
+}
+
+bool ShaderManager::tryReplaceShaders(const ReloadResult& result)
+{
+	ASSERT(result.bSucceeded);
+	ASSERT(!result.variants.empty());
+
+	// 이미 제출된 목록은 드라이버가 참조를 유지하므로 이전 셰이더를 바로 해제해도 됨
+	switch (result.eType)
+	{
+	case EShaderType::VERTEX:
+		{
+			const std::vector<uint8_t>& bytecode = result.variants[0].bytecode;
+
+			const RHI::VertexShaderHandle vertexShader = mDevice.CreateVertexShader(bytecode.data(), bytecode.size());
+
+			if (!vertexShader.IsValid())
+			{
+				return false;
+			}
+
+			RHI::VertexShaderHandle& slot = mVertexShaderMap[result.path];
+
+			if (slot.IsValid())
+			{
+				mDevice.DestroyVertexShader(slot);
+			}
+
+			slot = vertexShader;
+		}
+		break;
+
+	case EShaderType::PIXEL:
+		{
+			PixelShaderVariants& variants = mPixelShaderVariants[mPixelShaderMap.at(result.path)];
+
+			// 모두 만들어진 뒤에만 바꿔서 변형끼리 버전이 섞이지 않게 함
+			RHI::PixelShaderHandle newShaders[SHADER_VARIANT_COUNT] = {};
+
+			for (const VariantBytecode& variant : result.variants)
+			{
+				const RHI::PixelShaderHandle pixelShader = mDevice.CreatePixelShader(variant.bytecode.data(), variant.bytecode.size());
+
+				if (!pixelShader.IsValid())
+				{
+					for (const RHI::PixelShaderHandle createdShader : newShaders)
+					{
+						if (createdShader.IsValid())
+						{
+							mDevice.DestroyPixelShader(createdShader);
+						}
+					}
+
+					return false;
+				}
+
+				newShaders[variant.features] = pixelShader;
+			}
+
+			for (const VariantBytecode& variant : result.variants)
+			{
+				mDevice.DestroyPixelShader(variants.shaders[variant.features]);
+
+				variants.shaders[variant.features] = newShaders[variant.features];
+			}
+
+			fillVariantAliases(variants);
+		}
+		break;
+
+	default:
+		ASSERT(false);
+		break;
+	}
+
+	return true;
+}
+
+const char* ShaderManager::getShaderTarget(const EShaderType eType)
+{
+	constexpr const char* const targets[static_cast<int>(EShaderType::COUNT)] =
+	{
+		#define SHADER_ENTRY(type, target) target,
+		SHADER_LIST
+		#undef SHADER_ENTRY
+	};
+
+	return targets[static_cast<int>(eType)];
+}
+
+uint32_t ShaderManager::getCanonicalFeatures(const uint32_t features)
+{
+	uint32_t canonicalFeatures = features;
+
+	// 텍스처를 쓰지 않으면 배열 여부도 의미 없음
+	if ((canonicalFeatures & SHADER_FEATURE_TEXTURED) == 0)
+	{
+		canonicalFeatures &= ~SHADER_FEATURE_TEXTURE_ARRAY;
+	}
+
+	// 클러스터 경로는 빛 개수 구간을 쓰지 않음
+	if ((canonicalFeatures & SHADER_FEATURE_OBJECT_LIGHTS) == 0)
+	{
+		canonicalFeatures &= ~SHADER_FEATURE_LIGHT_BUCKET_MASK;
+	}
+	// 빛이 없으면 스포트라이트 계산도 없음
+	else if ((canonicalFeatures & SHADER_FEATURE_LIGHT_BUCKET_MASK) == 0)
+	{
+		canonicalFeatures &= ~SHADER_FEATURE_SPOT_LIGHTS;
+	}
+
+	return canonicalFeatures;
+}
+
+void ShaderManager::getVariantFeatures(const uint32_t featureMask, std::vector<uint32_t>& outFeatures)
+{
+	outFeatures.clear();
+
+	for (uint32_t features = 0; features < SHADER_VARIANT_COUNT; ++features)
+	{
+		if ((features & ~featureMask) == 0 && getCanonicalFeatures(features) == features)
+		{
+			outFeatures.push_back(features);
 		}
 	}
-	SafeRelease(pErrorBlob);
+}
+
+void ShaderManager::fillVariantAliases(PixelShaderVariants& variants)
+{
+	for (uint32_t features = 0; features < SHADER_VARIANT_COUNT; ++features)
+	{
+		variants.shaders[features] = variants.shaders[getCanonicalFeatures(features & variants.featureMask)];
+	}
+}
 
-	return pRetBlob;
-}
\ No newline at end of file
+uint32_t ShaderManager::makeShaderDefines(const uint32_t featureMask, const uint32_t features, RHI::ShaderDefine* const pOutDefines)
+{
+	ASSERT(pOutDefines != nullptr);
+
+	uint32_t defineCount = 0;
+
+	if ((featureMask & SHADER_FEATURE_TEXTURED) != 0)
+	{
+		pOutDefines[defineCount] = { "USE_TEXTURE", (features & SHADER_FEATURE_TEXTURED) != 0 ? "1" : "0" };
+		++defineCount;
+	}
+
+	if ((featureMask & SHADER_FEATURE_TEXTURE_ARRAY) != 0)
+	{
+		pOutDefines[defineCount] = { "USE_TEXTURE_ARRAY", (features & SHADER_FEATURE_TEXTURE_ARRAY) != 0 ? "1" : "0" };
+		++defineCount;
+	}
+
+	if ((featureMask & SHADER_FEATURE_LIGHTING) != 0)
+	{
+		const char* const lightCounts[] = { "0", "2", "4", "8" };
+
+		const uint32_t bucket = (features & SHADER_FEATURE_LIGHT_BUCKET_MASK) >> SHADER_FEATURE_LIGHT_BUCKET_SHIFT;
+
+		pOutDefines[defineCount] = { "USE_OBJECT_LIGHTS", (features & SHADER_FEATURE_OBJECT_LIGHTS) != 0 ? "1" : "0" };
+		++defineCount;
+
+		pOutDefines[defineCount] = { "USE_SPOT_LIGHTS", (features & SHADER_FEATURE_SPOT_LIGHTS) != 0 ? "1" : "0" };
+		++defineCount;
+
+		pOutDefines[defineCount] = { "MAX_OBJECT_LIGHT_COUNT", lightCounts[bucket] };
+		++defineCount;
+	}
+
+	ASSERT(defineCount <= MAX_SHADER_DEFINE_COUNT);
+
+	return defineCount;
+}
@@ -1,35 +1,102 @@
 #pragma once
 
 #include <unordered_map>
-
-#include <d3d11.h>
+#include <unordered_set>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
 
 #include "Core/Assert.h"
+#include "Core/FileWatcher.h"
 #include "Renderer/Vertex.h"
+#include "Renderer/RHI/RHIDevice.h"
 #include "UI/IEditorUIDrawable.h"
+#include "ShaderCache.h"
 
 #define SHADER_LIST \
 	SHADER_ENTRY(VERTEX, "vs_5_0") \
 	SHADER_ENTRY(PIXEL, "ps_5_0") \
 
-#define SHADER_PATH(filename) ("./Shaders/" filename)
+#define SHADER_DIRECTORY "./Shaders"
+#define SHADER_PATH(filename) (SHADER_DIRECTORY "/" filename)
+#define SHADER_CACHE_PATH ("./Cache/ShaderCache.bin")
+
+// 픽셀 셰이더 변형을 고르는 기능 비트, 비트마스크가 곧 변형 배열의 인덱스
+enum EShaderFeature : uint32_t
+{
+	SHADER_FEATURE_NONE = 0,
+	SHADER_FEATURE_TEXTURED = 1 << 0,
+	SHADER_FEATURE_OBJECT_LIGHTS = 1 << 1,
+	SHADER_FEATURE_SPOT_LIGHTS = 1 << 2,
+
+	// 오브젝트별 빛 개수 구간 0, ~2, ~4, ~8
+	SHADER_FEATURE_LIGHT_BUCKET_SHIFT = 3,
+	SHADER_FEATURE_LIGHT_BUCKET_MASK = 3 << SHADER_FEATURE_LIGHT_BUCKET_SHIFT,
+
+	SHADER_FEATURE_LIGHTING = SHADER_FEATURE_OBJECT_LIGHTS | SHADER_FEATURE_SPOT_LIGHTS | SHADER_FEATURE_LIGHT_BUCKET_MASK,
+
+	// 아틀라스 텍스처 배열에서 샘플링, SHADER_FEATURE_TEXTURED와 함께 씀
+	SHADER_FEATURE_TEXTURE_ARRAY = 1 << 5,
+
+	SHADER_VARIANT_COUNT = 1 << 6
+};
+
+// 빛 개수를 담을 수 있는 가장 작은 구간
+inline uint32_t GetLightBucketFeature(const uint32_t lightCount)
+{
+	ASSERT(lightCount <= 8);
+
+	const uint32_t bucket = lightCount == 0 ? 0 : (lightCount <= 2 ? 1 : (lightCount <= 4 ? 2 : 3));
+
+	return bucket << SHADER_FEATURE_LIGHT_BUCKET_SHIFT;
+}
 
 class ShaderManager final : public IEditorUIDrawable
 {
 public:
 	void LoadVertexShaderAndInputLayout(const std::string& path, const Vertex::EType eType);
-	ID3D11InputLayout* GetInputLayoutOrNull(const Vertex::EType eType) const;
-	ID3D11VertexShader* GetVertexShaderOrNull(const std::string& path) const;
+	RHI::InputLayoutHandle GetInputLayout(const Vertex::EType eType) const;
+	RHI::VertexShaderHandle GetVertexShader(const std::string& path) const;
+
+	// 정점 형식이 다른 메쉬용 변형 파일, 등록하지 않은 조합은 path를 그대로 씀
+	void LoadVertexShaderVariant(const std::string& path, const Vertex::EType eType, const std::string& variantPath);
+	RHI::VertexShaderHandle GetVertexShader(const std::string& path, const Vertex::EType eType) const;
 
-	void LoadPixelShader(const std::string& path);
-	ID3D11PixelShader* GetPixelShaderOrNull(const std::string& path) const;
+	// featureMask에 있는 기능의 조합마다 변형을 컴파일
+	void LoadPixelShader(const std::string& path, const uint32_t featureMask = SHADER_FEATURE_NONE);
+
+	// 기능을 하나도 켜지 않은 변형
+	RHI::PixelShaderHandle GetPixelShader(const std::string& path) const;
+
+	// 머터리얼이 한 번 찾아두고 그리기마다 GetPixelShaderVariant에 넘김
+	uint32_t GetPixelShaderIndex(const std::string& path) const;
+
+	// 셰이더가 지원하지 않는 기능 비트는 무시됨
+	inline RHI::PixelShaderHandle GetPixelShaderVariant(const uint32_t shaderIndex, const uint32_t features) const
+	{
+		ASSERT(shaderIndex < mPixelShaderVariants.size());
+		ASSERT(features < SHADER_VARIANT_COUNT);
+
+		return mPixelShaderVariants[shaderIndex].shaders[features];
+	}
+
+	// 프레임 경계에서 호출
+	// 바뀐 파일에 걸린 셰이더를 백그라운드에서 다시 컴파일하고 끝난 것만 교체
+	// 교체 전까지는 이전 바이트코드로 계속 그림
+	void ApplyShaderReloads();
 
 	virtual void DrawEditorUI() override;
 
 	bool DrawShaderSelectorPopupAndSelectShaders(std::string& outPath, const bool bPixel);
 
+	enum
+	{
+		INVALID_SHADER_INDEX = 0xFFFFFFFF
+	};
+
 	// static
-	static void Initialize(ID3D11Device& device);
+	static void Initialize(RHI::Device& device);
 
 	static ShaderManager& GetInstance()
 	{
@@ -53,20 +120,103 @@ private:
 		COUNT
 	};
 
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct PixelShaderVariants
+	{
+		std::string path;
+		uint32_t featureMask;
+
+		// 모든 비트 조합을 채워둠, 결과가 같은 조합은 같은 핸들을 가리킴
+		RHI::PixelShaderHandle shaders[SHADER_VARIANT_COUNT];
+	};
+
+	struct VariantBytecode
+	{
+		uint32_t features;
+
+		// 요청할 때의 소스 기준 키
+		uint64_t key;
+		bool bKeyValid;
+
+		// 캐시에서 찾은 것은 다시 저장하지 않음
+		bool bCached;
+		std::vector<uint8_t> bytecode;
+	};
+
+	struct ReloadResult
+	{
+		std::string path;
+		EShaderType eType;
+		uint32_t featureMask;
+
+		bool bSucceeded;
+		std::vector<VariantBytecode> variants;
+
+		std::chrono::steady_clock::time_point requestTime;
+	};
+#pragma warning(pop)
+
 private:
 	static ShaderManager* spInstance;
 
-	ID3D11Device& mDevice;
+	RHI::Device& mDevice;
 
-	ID3D11InputLayout* mpInputLayout[Vertex::GetVertexTypeCount()];
-	std::unordered_map<std::string, ID3D11VertexShader*> mVertexShaderMap;
-	std::unordered_map<std::string, ID3D11PixelShader*> mPixelShaderMap;
+	RHI::InputLayoutHandle mInputLayouts[Vertex::GetVertexTypeCount()];
+	std::unordered_map<std::string, RHI::VertexShaderHandle> mVertexShaderMap;
+
+	// 정점 형식마다 원래 경로 -> 변형 경로
+	std::unordered_map<std::string, std::string> mVertexShaderVariantPaths[Vertex::GetVertexTypeCount()];
+
+	std::unordered_map<std::string, uint32_t> mPixelShaderMap;
+	std::vector<PixelShaderVariants> mPixelShaderVariants;
+	uint32_t mPixelShaderVariantCount;
+
+	ShaderCache mShaderCache;
+	float mLoadTimeMs;
+
+	// hot reload
+	FileWatcher mFileWatcher;
+	std::vector<std::string> mChangedPaths;
+
+	std::unordered_set<std::string> mReloadingPaths;
+	std::unordered_set<std::string> mRequeuedPaths;
+
+	std::mutex mReloadMutex;
+	std::condition_variable mReloadCondition;
+	std::vector<ReloadResult> mCompletedReloads;
+	uint32_t mInFlightReloadCount;
+
+	uint32_t mReloadCount;
+	uint32_t mReloadFailCount;
+	float mLastReloadTimeMs;
 
 private:
-	ShaderManager(ID3D11Device& device);
+	ShaderManager(RHI::Device& device);
 	~ShaderManager();
 
-	ID3DBlob* compileShaderAlloc(const std::string& path, const EShaderType eType) const;
+	// 캐시에 없을 때만 컴파일, 바이트코드는 다음 Save 전까지 유효
+	bool tryGetShaderBytecode(
+		const std::string& path,
+		const EShaderType eType,
+		const uint32_t featureMask,
+		const uint32_t features,
+		const uint8_t*& outBytecode,
+		size_t& outSize
+	);
+
+	void requestReload(const std::string& path, const EShaderType eType);
+	bool tryReplaceShaders(const ReloadResult& result);
+
+	static const char* getShaderTarget(const EShaderType eType);
+
+	// 컴파일 결과가 같은 조합 중 대표 하나로 바꿈
+	static uint32_t getCanonicalFeatures(const uint32_t features);
+	static void getVariantFeatures(const uint32_t featureMask, std::vector<uint32_t>& outFeatures);
+	static void fillVariantAliases(PixelShaderVariants& variants);
+
+	// 반환값은 정의 개수, 값은 정적 문자열이라 계속 유효
+	static uint32_t makeShaderDefines(const uint32_t featureMask, const uint32_t features, RHI::ShaderDefine* const pOutDefines);
 
 private:
 	ShaderManager(const ShaderManager& other) = delete;
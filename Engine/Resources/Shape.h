@@ -47,37 +47,37 @@ public:
 	)
 	{
 		outVertices = {
-			// 
+			// 윗면
 			{ { -1.f, 1.f, -1.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f } },
 			{ { -1.f, 1.f, 1.f }, { 0.f, 1.f, 0.f }, { 1.f, 0.f } },
 			{ { 1.f, 1.f, 1.f }, { 0.f, 1.f, 0.f }, { 1.f, 1.f } },
 			{ { 1.f, 1.f, -1.f }, { 0.f, 1.f, 0.f }, { 0.f, 1.f } },
 
-			// Ʒ
+			// 아랫면
 			{ { -1.f, -1.f, -1.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f } },
 			{ { 1.f, -1.f, -1.f }, { 0.f, -1.f, 0.f }, { 1.f, 0.f } },
 			{ { 1.f, -1.f, 1.f }, { 0.f, -1.f, 0.f }, { 1.f, 1.f } },
 			{ { -1.f, -1.f, 1.f }, { 0.f, -1.f, 0.f }, { 0.f, 1.f } },
 
-			// ո
+			// 앞면
 			{ { -1.f, -1.f, -1.f }, { 0.f, 0.f, -1.f }, { 0.f, 0.f } },
 			{ { -1.f, 1.f, -1.f }, { 0.f, 0.f, -1.f }, { 1.f, 0.f } },
 			{ { 1.f, 1.f, -1.f }, { 0.f, 0.f, -1.f }, { 1.f, 1.f } },
 			{ { 1.f, -1.f, -1.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f } },
 
-			// ޸
+			// 뒷면
 			{ { -1.f, -1.f, 1.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f } },
 			{ { 1.f, -1.f, 1.f }, { 0.f, 0.f, 1.f }, { 1.f, 0.f } },
 			{ { 1.f, 1.f, 1.f }, { 0.f, 0.f, 1.f }, { 1.f, 1.f } },
 			{ { -1.f, 1.f, 1.f }, { 0.f, 0.f, 1.f }, { 0.f, 1.f } },
 
-			// 
+			// 왼쪽
 			{ { -1.f, -1.f, 1.f }, { -1.f, 1.f, 0.f }, { 0.f, 0.f } },
 			{ { -1.f, 1.f, 1.f }, { -1.f, 1.f, 0.f }, { 1.f, 0.f } },
 			{ { -1.f, 1.f, -1.f }, { -1.f, 1.f, 0.f }, { 1.f, 1.f } },
 			{ { -1.f, -1.f, -1.f }, { -1.f, 1.f, 0.f }, { 0.f, 1.f } },
 
-			// 
+			// 오른쪽
 			{ { 1.f, -1.f, 1.f }, { 1.f, 0.f, 0.f }, { 0.f, 0.f } },
 			{ { 1.f, -1.f, -1.f }, { 1.f, 0.f, 0.f }, { 1.f, 0.f } },
 			{ { 1.f, 1.f, -1.f }, { 1.f, 0.f, 0.f }, { 1.f, 1.f } },
@@ -85,27 +85,27 @@ public:
 		};
 
 		outIndices = {
-			// 
+			// 윗면
 			0,  1,  2,
 			0,  2,  3,
 
-			// Ʒ
+			// 아랫면
 			4,  5,  6,
 			4,  6,  7,
 
-			// ո
+			// 앞면
 			8,  9,  10,
 			8,  10, 11,
 
-			// ޸
+			// 뒷면
 			12, 13, 14,
 			12, 14, 15,
 
-			// 
+			// 왼쪽
 			16, 17, 18,
 			16, 18, 19,
 
-			// 
+			// 오른쪽
 			20, 21, 22,
 			20, 22, 23
 		};
@@ -140,7 +140,7 @@ public:
 				const Matrix rotationY = Matrix::CreateRotationY(DELTA_THETA * x);
 
 				const Vector3 currPoint = Vector3::Transform(sliceStart, rotationY);
-				Vector3 normal = currPoint; // from  to  ͷ 
+				Vector3 normal = currPoint; // from 원점 to 정점 벡터로 가정
 				normal.Normalize();
 
 				const Vector2 uv = Vector2(x / static_cast<float>(sliceCount), y / static_cast<float>(stackCount));
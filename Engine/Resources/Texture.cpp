@@ -1,26 +1,28 @@
 #include "Texture.h"
 
-#include <d3d11.h>
-
 #include "Core/Assert.h"
+#include "TextureStreamer.h"
+#include "Renderer/RHI/RHICommandList.h"
 
 Texture::Texture(
 	const std::string& path,
-	ComPtr<ID3D11ShaderResourceView>& pTextureViewGPU,
+	const RHI::TextureHandle textureHandle,
 	const int width,
 	const int height
 )
 	: mPath(path)
-	, mpTextureViewGPU(pTextureViewGPU)
+	, mTextureHandle(textureHandle)
 	, mWidth(width)
 	, mHeight(height)
+	, mStreamingID(TextureStreamer::INVALID_TEXTURE_ID)
+	, mbPlaceholder(false)
 {
-	ASSERT(pTextureViewGPU != nullptr);
+	ASSERT(textureHandle.IsValid());
 	ASSERT(width > 0);
 	ASSERT(height > 0);
 }
 
-void Texture::Bind(ID3D11DeviceContext& deviceContext)
+void Texture::Bind(RHI::CommandList& commandList) const
 {
-	deviceContext.PSSetShaderResources(0, 1, mpTextureViewGPU.GetAddressOf());
+	commandList.SetPSTexture(0, mTextureHandle);
 }
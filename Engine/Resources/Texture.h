@@ -2,29 +2,64 @@
 
 #include <string>
 
-#include "Core/ComHelper.h"
+#include "Core/Assert.h"
+#include "Renderer/RHI/RHITypes.h"
 
-struct ID3D11ShaderResourceView;
-struct ID3D11DeviceContext;
+namespace RHI
+{
+	class CommandList;
+}
 
 class Texture final
 {
 public:
 	Texture(
 		const std::string& path,
-		ComPtr<ID3D11ShaderResourceView>& pTextureViewGPU,
+		const RHI::TextureHandle textureHandle,
 		const int width,
 		const int height
 	);
 	~Texture() = default;
 
-	void Bind(ID3D11DeviceContext& deviceContext);
+	void Bind(RHI::CommandList& commandList) const;
 
 	inline const char* GetPath() const
 	{
 		return mPath.c_str();
 	}
 
+	inline RHI::TextureHandle GetHandle() const
+	{
+		return mTextureHandle;
+	}
+
+	// 스트리밍으로 밉이 바뀔 때 매니저가 교체, 이전 핸들은 매니저가 해제
+	inline void SetHandle(const RHI::TextureHandle textureHandle)
+	{
+		mTextureHandle = textureHandle;
+	}
+
+	// 불러오기가 끝날 때까지는 대체 텍스처의 핸들을 빌려 쓰므로 해제하면 안 됨
+	inline bool IsPlaceholder() const
+	{
+		return mbPlaceholder;
+	}
+
+	inline void SetPlaceholder(const bool bPlaceholder)
+	{
+		mbPlaceholder = bPlaceholder;
+	}
+
+	inline uint32_t GetStreamingID() const
+	{
+		return mStreamingID;
+	}
+
+	inline void SetStreamingID(const uint32_t streamingID)
+	{
+		mStreamingID = streamingID;
+	}
+
 	inline int GetWidth() const
 	{
 		return mWidth;
@@ -35,14 +70,28 @@ public:
 		return mHeight;
 	}
 
+	inline void SetSize(const int width, const int height)
+	{
+		ASSERT(width > 0);
+		ASSERT(height > 0);
+
+		mWidth = width;
+		mHeight = height;
+	}
+
 private:
 	std::string mPath;
 
-	ComPtr<ID3D11ShaderResourceView> mpTextureViewGPU;
+	RHI::TextureHandle mTextureHandle;
 
+	// 크기는 밉이 내려가 있어도 원본 기준
 	int mWidth;
 	int mHeight;
 
+	uint32_t mStreamingID;
+
+	bool mbPlaceholder;
+
 private:
 	Texture(const Texture& other) = delete;
 	Texture& operator=(const Texture& other) = delete;
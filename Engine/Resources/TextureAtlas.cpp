@@ -0,0 +1,167 @@
+#include "TextureAtlas.h"
+
+#include <cstring>
+
+#include "Core/Assert.h"
+#include "MipGenerator.h"
+
+// ImGui가 만든 구현은 static이라 여기서 따로 만듦
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+enum
+{
+	RGBA_BYTES_PER_PIXEL = 4
+};
+
+static_assert(ATLAS_SLICE_SIZE % ATLAS_CELL_ALIGNMENT == 0);
+static_assert(1 << (ATLAS_MIP_COUNT - 1) == ATLAS_CELL_ALIGNMENT);
+
+static uint32_t GetCellSize(const uint32_t size)
+{
+	return (size + ATLAS_GUTTER * 2 + ATLAS_CELL_ALIGNMENT - 1) / ATLAS_CELL_ALIGNMENT * ATLAS_CELL_ALIGNMENT;
+}
+
+uint32_t PackAtlasRects(std::vector<AtlasRect>& rects, const uint32_t maxSliceCount)
+{
+	std::vector<stbrp_rect> packRects;
+	packRects.reserve(rects.size());
+
+	std::vector<stbrp_node> nodes(ATLAS_SLICE_SIZE);
+
+	for (AtlasRect& rect : rects)
+	{
+		rect.bPacked = false;
+	}
+
+	uint32_t sliceCount = 0;
+
+	while (sliceCount < maxSliceCount)
+	{
+		packRects.clear();
+
+		for (uint32_t i = 0; i < rects.size(); ++i)
+		{
+			const AtlasRect& rect = rects[i];
+
+			const uint32_t cellWidth = GetCellSize(rect.width);
+			const uint32_t cellHeight = GetCellSize(rect.height);
+
+			if (!rect.bPacked && cellWidth <= ATLAS_SLICE_SIZE && cellHeight <= ATLAS_SLICE_SIZE)
+			{
+				stbrp_rect packRect = {};
+				packRect.id = static_cast<int>(i);
+				packRect.w = static_cast<stbrp_coord>(cellWidth);
+				packRect.h = static_cast<stbrp_coord>(cellHeight);
+
+				packRects.push_back(packRect);
+			}
+		}
+
+		if (packRects.empty())
+		{
+			break;
+		}
+
+		// 칸 크기가 정렬되어 있으므로 스카이라인 위치도 정렬됨
+		stbrp_context context;
+		stbrp_init_target(&context, ATLAS_SLICE_SIZE, ATLAS_SLICE_SIZE, nodes.data(), static_cast<int>(nodes.size()));
+		stbrp_pack_rects(&context, packRects.data(), static_cast<int>(packRects.size()));
+
+		for (const stbrp_rect& packRect : packRects)
+		{
+			if (packRect.was_packed)
+			{
+				ASSERT(packRect.x % ATLAS_CELL_ALIGNMENT == 0 && packRect.y % ATLAS_CELL_ALIGNMENT == 0);
+
+				AtlasRect& rect = rects[packRect.id];
+				rect.bPacked = true;
+				rect.slice = sliceCount;
+				rect.x = static_cast<uint32_t>(packRect.x) + ATLAS_GUTTER;
+				rect.y = static_cast<uint32_t>(packRect.y) + ATLAS_GUTTER;
+			}
+		}
+
+		++sliceCount;
+	}
+
+	return sliceCount;
+}
+
+void InitializeAtlasSlice(TextureMipChain& outSlice)
+{
+	outSlice.width = ATLAS_SLICE_SIZE;
+	outSlice.height = ATLAS_SLICE_SIZE;
+	outSlice.mipCount = 1;
+	outSlice.topMip = 0;
+	outSlice.format = RHI::EFormat::R8G8B8A8_UNORM;
+
+	ResizeTextureMips(outSlice);
+
+	memset(outSlice.data.data(), 0, outSlice.data.size());
+}
+
+void BlitAtlasRect(TextureMipChain& slice, const AtlasRect& rect, const TextureMipChain& source)
+{
+	ASSERT(rect.bPacked);
+	ASSERT(slice.mipCount == 1);
+	ASSERT(source.topMip == 0);
+	ASSERT(source.format == RHI::EFormat::R8G8B8A8_UNORM);
+	ASSERT(source.width == rect.width && source.height == rect.height);
+
+	const uint32_t cellX = rect.x - ATLAS_GUTTER;
+	const uint32_t cellY = rect.y - ATLAS_GUTTER;
+	const uint32_t cellWidth = GetCellSize(rect.width);
+	const uint32_t cellHeight = GetCellSize(rect.height);
+
+	for (uint32_t y = 0; y < cellHeight; ++y)
+	{
+		// 거터와 남는 부분은 가장 가까운 테두리 픽셀
+		const int sourceY = static_cast<int>(y) - ATLAS_GUTTER;
+		const uint32_t clampedY = sourceY < 0 ? 0 : (sourceY >= static_cast<int>(source.height) ? source.height - 1 : static_cast<uint32_t>(sourceY));
+
+		const uint8_t* const pSourceRow = source.data.data() + static_cast<size_t>(clampedY) * source.width * RGBA_BYTES_PER_PIXEL;
+		uint8_t* const pDestRow = slice.data.data() + (static_cast<size_t>(cellY + y) * slice.width + cellX) * RGBA_BYTES_PER_PIXEL;
+
+		for (uint32_t x = 0; x < ATLAS_GUTTER; ++x)
+		{
+			memcpy(pDestRow + x * RGBA_BYTES_PER_PIXEL, pSourceRow, RGBA_BYTES_PER_PIXEL);
+		}
+
+		memcpy(pDestRow + ATLAS_GUTTER * RGBA_BYTES_PER_PIXEL, pSourceRow, static_cast<size_t>(source.width) * RGBA_BYTES_PER_PIXEL);
+
+		const uint8_t* const pLastPixel = pSourceRow + static_cast<size_t>(source.width - 1) * RGBA_BYTES_PER_PIXEL;
+
+		for (uint32_t x = ATLAS_GUTTER + source.width; x < cellWidth; ++x)
+		{
+			memcpy(pDestRow + x * RGBA_BYTES_PER_PIXEL, pLastPixel, RGBA_BYTES_PER_PIXEL);
+		}
+	}
+}
+
+void GenerateAtlasMips(TextureMipChain& slice)
+{
+	ASSERT(slice.mipCount == 1);
+
+	// 박스 필터는 정렬된 칸 밖을 읽지 않음, 작은 밉은 칸이 섞이므로 버림
+	GenerateFilteredMips(slice, EMipFilter::BOX, true);
+
+	slice.mipCount = ATLAS_MIP_COUNT;
+	ResizeTextureMips(slice);
+}
+
+TextureAtlasRegion GetAtlasRegion(const AtlasRect& rect)
+{
+	ASSERT(rect.bPacked);
+
+	TextureAtlasRegion region;
+	region.arrayIndex = rect.slice / ATLAS_SLICES_PER_ARRAY;
+	region.slice = rect.slice % ATLAS_SLICES_PER_ARRAY;
+	region.uvRect[0] = static_cast<float>(rect.x) / ATLAS_SLICE_SIZE;
+	region.uvRect[1] = static_cast<float>(rect.y) / ATLAS_SLICE_SIZE;
+	region.uvRect[2] = static_cast<float>(rect.width) / ATLAS_SLICE_SIZE;
+	region.uvRect[3] = static_cast<float>(rect.height) / ATLAS_SLICE_SIZE;
+
+	return region;
+}
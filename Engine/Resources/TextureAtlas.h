@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "TextureLoader.h"
+
+// 작은 RGBA8 텍스처를 텍스처 배열의 슬라이스에 모아 담는 도구
+// 칸은 ATLAS_CELL_ALIGNMENT의 배수 위치와 크기라서 ATLAS_MIP_COUNT개 밉까지는 이웃 칸과 섞이지 않음
+// 칸의 남는 부분은 텍스처 테두리를 반복해서 채움
+
+enum
+{
+	ATLAS_SLICE_SIZE = 1024,
+	ATLAS_MAX_TEXTURE_SIZE = 256,
+	ATLAS_CELL_ALIGNMENT = 16,
+	ATLAS_GUTTER = 4,
+
+	// 16 -> 1
+	ATLAS_MIP_COUNT = 5,
+
+	// 넘으면 다음 배열
+	ATLAS_SLICES_PER_ARRAY = 16
+};
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct AtlasRect
+{
+	uint32_t width;
+	uint32_t height;
+
+	// PackAtlasRects가 채움, x, y는 거터를 뺀 텍스처 위치
+	bool bPacked;
+	uint32_t slice;
+	uint32_t x;
+	uint32_t y;
+};
+
+struct TextureAtlasRegion
+{
+	uint32_t arrayIndex;
+	uint32_t slice;
+
+	// u, v 오프셋과 크기
+	float uvRect[4];
+};
+#pragma warning(pop)
+
+// 슬라이스를 하나씩 채워가며 담고 쓴 슬라이스 수를 돌려줌
+// maxSliceCount를 넘거나 한 슬라이스보다 큰 것은 bPacked가 false
+uint32_t PackAtlasRects(std::vector<AtlasRect>& rects, const uint32_t maxSliceCount);
+
+// 빈 ATLAS_SLICE_SIZE 크기 슬라이스, 밉은 0번만
+void InitializeAtlasSlice(TextureMipChain& outSlice);
+
+// source의 0번 밉을 rect 자리에 복사하고 칸의 나머지를 테두리로 채움
+void BlitAtlasRect(TextureMipChain& slice, const AtlasRect& rect, const TextureMipChain& source);
+
+// 0번 밉에서 ATLAS_MIP_COUNT개까지 감마를 고려한 박스 필터로 만듦
+void GenerateAtlasMips(TextureMipChain& slice);
+
+TextureAtlasRegion GetAtlasRegion(const AtlasRect& rect);
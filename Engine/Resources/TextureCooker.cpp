@@ -0,0 +1,394 @@
+#include "TextureCooker.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "Core/Assert.h"
+#include "Core/JobSystem.h"
+#include "BlockCompression.h"
+
+enum
+{
+	MIN_BLOCK_ROWS_PER_CHUNK = 4,
+	RGBA_BYTES_PER_PIXEL = 4,
+
+	// 손실이 없을 때 표시용 상한
+	LOSSLESS_PSNR = 99
+};
+
+typedef void (*BlockFunction)(const uint8_t* const, uint8_t* const);
+
+#define COOKED_TEXTURE_SUFFIX ".cooked.dds"
+
+const char* GetTextureCompressionName(const ETextureCompression eCompression)
+{
+	static const char* const names[] =
+	{
+#define TEXTURE_COMPRESSION_ENTRY(type) #type,
+		TEXTURE_COMPRESSION_LIST
+#undef TEXTURE_COMPRESSION_ENTRY
+	};
+
+	ASSERT(static_cast<int>(eCompression) < GetTextureCompressionCount());
+
+	return names[static_cast<int>(eCompression)];
+}
+
+static uint32_t GetMipExtent(const uint32_t size, const uint32_t mip)
+{
+	const uint32_t extent = size >> mip;
+
+	return extent > 0 ? extent : 1;
+}
+
+static BlockFunction GetEncodeFunction(const RHI::EFormat format)
+{
+	switch (format)
+	{
+	case RHI::EFormat::BC1_UNORM:
+		return EncodeBC1Block;
+
+	case RHI::EFormat::BC3_UNORM:
+		return EncodeBC3Block;
+
+	case RHI::EFormat::BC5_UNORM:
+		return EncodeBC5Block;
+
+	case RHI::EFormat::BC7_UNORM:
+		return EncodeBC7Block;
+
+	default:
+		ASSERT(false, "not a block compressed format");
+		return nullptr;
+	}
+}
+
+static BlockFunction GetDecodeFunction(const RHI::EFormat format)
+{
+	switch (format)
+	{
+	case RHI::EFormat::BC1_UNORM:
+		return DecodeBC1Block;
+
+	case RHI::EFormat::BC3_UNORM:
+		return DecodeBC3Block;
+
+	case RHI::EFormat::BC5_UNORM:
+		return DecodeBC5Block;
+
+	case RHI::EFormat::BC7_UNORM:
+		return DecodeBC7Block;
+
+	default:
+		ASSERT(false, "not a block compressed format");
+		return nullptr;
+	}
+}
+
+// BC1은 알파를, BC5는 B와 알파를 담지 않음
+static uint32_t GetCompareChannelCount(const RHI::EFormat format)
+{
+	switch (format)
+	{
+	case RHI::EFormat::BC1_UNORM:
+		return 3;
+
+	case RHI::EFormat::BC5_UNORM:
+		return 2;
+
+	default:
+		return 4;
+	}
+}
+
+static void ReadBlock(const uint8_t* const pMip, const uint32_t width, const uint32_t blockX, const uint32_t blockY, uint8_t* const pOutPixels)
+{
+	const size_t rowPitch = static_cast<size_t>(width) * RGBA_BYTES_PER_PIXEL;
+	const uint8_t* pRow = pMip + static_cast<size_t>(blockY) * 4 * rowPitch + static_cast<size_t>(blockX) * 4 * RGBA_BYTES_PER_PIXEL;
+
+	for (uint32_t y = 0; y < 4; ++y)
+	{
+		memcpy(pOutPixels + y * 4 * RGBA_BYTES_PER_PIXEL, pRow, 4 * RGBA_BYTES_PER_PIXEL);
+
+		pRow += rowPitch;
+	}
+}
+
+static bool HasTransparency(const TextureMipChain& source)
+{
+	const size_t topMipBytes = static_cast<size_t>(source.width) * source.height * RGBA_BYTES_PER_PIXEL;
+
+	for (size_t i = 3; i < topMipBytes; i += RGBA_BYTES_PER_PIXEL)
+	{
+		if (source.data[i] != 255)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static float ComputePSNR(const TextureMipChain& source, const TextureMipChain& compressed)
+{
+	const BlockFunction decode = GetDecodeFunction(compressed.format);
+	const uint32_t blockBytes = RHI::GetFormatByteSize(compressed.format);
+	const uint32_t channelCount = GetCompareChannelCount(compressed.format);
+
+	const uint32_t blockCountX = source.width / 4;
+	const uint32_t blockCountY = source.height / 4;
+
+	uint8_t sourcePixels[BLOCK_RGBA_BYTE_SIZE];
+	uint8_t decodedPixels[BLOCK_RGBA_BYTE_SIZE];
+
+	double squaredErrorSum = 0.0;
+
+	for (uint32_t blockY = 0; blockY < blockCountY; ++blockY)
+	{
+		for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+		{
+			ReadBlock(source.data.data(), source.width, blockX, blockY, sourcePixels);
+			decode(compressed.data.data() + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockBytes, decodedPixels);
+
+			for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+			{
+				for (uint32_t c = 0; c < channelCount; ++c)
+				{
+					const double diff = static_cast<double>(sourcePixels[i * 4 + c]) - decodedPixels[i * 4 + c];
+
+					squaredErrorSum += diff * diff;
+				}
+			}
+		}
+	}
+
+	const double meanSquaredError = squaredErrorSum / (static_cast<double>(source.width) * source.height * channelCount);
+
+	if (meanSquaredError <= 0.0)
+	{
+		return static_cast<float>(LOSSLESS_PSNR);
+	}
+
+	return static_cast<float>(10.0 * log10(255.0 * 255.0 / meanSquaredError));
+}
+
+bool TryCompressTextureMips(const TextureMipChain& source, const RHI::EFormat format, TextureMipChain& outMipChain, TextureCookStats& outStats)
+{
+	ASSERT(source.format == RHI::EFormat::R8G8B8A8_UNORM);
+	ASSERT(source.topMip == 0);
+	ASSERT(RHI::IsBlockCompressedFormat(format));
+
+	if (source.width % 4 != 0 || source.height % 4 != 0)
+	{
+		return false;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point encodeStart = Clock::now();
+
+	outMipChain.width = source.width;
+	outMipChain.height = source.height;
+	outMipChain.mipCount = GetBlockAlignedMipCount(source.width, source.height, source.mipCount);
+	outMipChain.topMip = 0;
+	outMipChain.format = format;
+
+	ResizeTextureMips(outMipChain);
+
+	const BlockFunction encode = GetEncodeFunction(format);
+	const uint32_t blockBytes = RHI::GetFormatByteSize(format);
+
+	uint64_t pixelCount = 0;
+
+	for (uint32_t mip = 0; mip < outMipChain.mipCount; ++mip)
+	{
+		const uint32_t mipWidth = GetMipExtent(source.width, mip);
+		const uint32_t mipHeight = GetMipExtent(source.height, mip);
+
+		const uint32_t blockCountX = mipWidth / 4;
+		const uint32_t blockCountY = mipHeight / 4;
+
+		const uint8_t* const pSource = source.data.data() + source.mipOffsets[mip];
+		uint8_t* const pDest = outMipChain.data.data() + outMipChain.mipOffsets[mip];
+
+		const JobSystem::ChunkFunction encodeRows = [=](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
+			{
+				uint8_t pixels[BLOCK_RGBA_BYTE_SIZE];
+
+				for (uint32_t blockY = begin; blockY < end; ++blockY)
+				{
+					for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+					{
+						ReadBlock(pSource, mipWidth, blockX, blockY, pixels);
+						encode(pixels, pDest + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockBytes);
+					}
+				}
+			};
+
+		// 작은 밉은 나누는 비용이 더 큼
+		uint32_t chunkCount = blockCountY / MIN_BLOCK_ROWS_PER_CHUNK;
+
+		if (JobSystem::IsInitialized())
+		{
+			const uint32_t threadCount = JobSystem::GetInstance().GetWorkerCount() + 1;
+
+			chunkCount = chunkCount < threadCount ? chunkCount : threadCount;
+		}
+		else
+		{
+			chunkCount = 1;
+		}
+
+		if (chunkCount <= 1)
+		{
+			encodeRows(0, blockCountY, 0);
+		}
+		else
+		{
+			JobSystem::GetInstance().ParallelFor(blockCountY, chunkCount, encodeRows);
+		}
+
+		pixelCount += static_cast<uint64_t>(mipWidth) * mipHeight;
+	}
+
+	outStats.encodeTimeMs = Milliseconds(Clock::now() - encodeStart).count();
+	outStats.megapixelsPerSecond = outStats.encodeTimeMs > 0.f ? static_cast<float>(pixelCount) / (outStats.encodeTimeMs * 1000.f) : 0.f;
+
+	outStats.format = format;
+	outStats.width = outMipChain.width;
+	outStats.height = outMipChain.height;
+	outStats.mipCount = outMipChain.mipCount;
+	outStats.sourceBytes = source.data.size();
+	outStats.cookedBytes = outMipChain.data.size();
+	outStats.psnr = ComputePSNR(source, outMipChain);
+
+	return true;
+}
+
+std::string GetCookedTexturePath(const std::string& sourcePath)
+{
+	const size_t separatorPosition = sourcePath.find_last_of("/\\");
+	const size_t dotPosition = sourcePath.find_last_of('.');
+
+	if (dotPosition == std::string::npos || (separatorPosition != std::string::npos && dotPosition < separatorPosition))
+	{
+		return sourcePath + COOKED_TEXTURE_SUFFIX;
+	}
+
+	return sourcePath.substr(0, dotPosition) + COOKED_TEXTURE_SUFFIX;
+}
+
+bool IsCookedTextureUpToDate(const std::string& sourcePath)
+{
+	const std::string cookedPath = GetCookedTexturePath(sourcePath);
+
+	std::error_code errorCode;
+
+	const std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedPath, errorCode);
+
+	if (errorCode)
+	{
+		return false;
+	}
+
+	const std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourcePath, errorCode);
+
+	return !errorCode && cookedTime >= sourceTime;
+}
+
+bool TryCookTexture(const std::string& sourcePath, const ETextureCompression eCompression, const EMipFilter eMipFilter, TextureCookStats& outStats)
+{
+	const size_t suffixLength = sizeof(COOKED_TEXTURE_SUFFIX) - 1;
+
+	// 쿠킹된 파일을 다시 쿠킹하지 않음
+	if (sourcePath.size() >= suffixLength && sourcePath.compare(sourcePath.size() - suffixLength, suffixLength, COOKED_TEXTURE_SUFFIX) == 0)
+	{
+		return false;
+	}
+
+	const std::string cookedPath = GetCookedTexturePath(sourcePath);
+
+	TextureMipChain source;
+
+	if (!TryLoadTextureMips(sourcePath.c_str(), source) || source.format != RHI::EFormat::R8G8B8A8_UNORM)
+	{
+		return false;
+	}
+
+	RHI::EFormat format;
+
+	switch (eCompression)
+	{
+	case ETextureCompression::AUTO:
+		format = HasTransparency(source) ? RHI::EFormat::BC3_UNORM : RHI::EFormat::BC1_UNORM;
+		break;
+
+	case ETextureCompression::NONE:
+		format = RHI::EFormat::R8G8B8A8_UNORM;
+		break;
+
+	case ETextureCompression::BC1:
+		format = RHI::EFormat::BC1_UNORM;
+		break;
+
+	case ETextureCompression::BC3:
+		format = RHI::EFormat::BC3_UNORM;
+		break;
+
+	case ETextureCompression::BC5:
+		format = RHI::EFormat::BC5_UNORM;
+		break;
+
+	case ETextureCompression::BC7:
+		format = RHI::EFormat::BC7_UNORM;
+		break;
+
+	default:
+		ASSERT(false, "invalid texture compression");
+		return false;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point mipStart = Clock::now();
+
+	// 불러올 때 만든 밉은 버리고 0번 밉에서 다시 만듦
+	source.mipCount = 1;
+	ResizeTextureMips(source);
+
+	GenerateFilteredMips(source, eMipFilter, format != RHI::EFormat::BC5_UNORM);
+
+	const float mipTimeMs = Milliseconds(Clock::now() - mipStart).count();
+
+	if (format == RHI::EFormat::R8G8B8A8_UNORM)
+	{
+		outStats.format = format;
+		outStats.width = source.width;
+		outStats.height = source.height;
+		outStats.mipCount = source.mipCount;
+		outStats.sourceBytes = source.data.size();
+		outStats.cookedBytes = source.data.size();
+		outStats.mipTimeMs = mipTimeMs;
+		outStats.encodeTimeMs = 0.f;
+		outStats.megapixelsPerSecond = 0.f;
+		outStats.psnr = static_cast<float>(LOSSLESS_PSNR);
+
+		return TrySaveTextureMips(cookedPath.c_str(), source);
+	}
+
+	TextureMipChain compressed;
+
+	if (!TryCompressTextureMips(source, format, compressed, outStats))
+	{
+		return false;
+	}
+
+	outStats.mipTimeMs = mipTimeMs;
+
+	return TrySaveTextureMips(cookedPath.c_str(), compressed);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+
+#include "TextureLoader.h"
+#include "MipGenerator.h"
+
+// AUTO는 알파가 모두 255면 BC1, 아니면 BC3
+// NONE은 밉만 만들어 RGBA8로 저장
+#define TEXTURE_COMPRESSION_LIST \
+	TEXTURE_COMPRESSION_ENTRY(AUTO) \
+	TEXTURE_COMPRESSION_ENTRY(NONE) \
+	TEXTURE_COMPRESSION_ENTRY(BC1) \
+	TEXTURE_COMPRESSION_ENTRY(BC3) \
+	TEXTURE_COMPRESSION_ENTRY(BC5) \
+	TEXTURE_COMPRESSION_ENTRY(BC7) \
+
+enum class ETextureCompression : uint8_t
+{
+#define TEXTURE_COMPRESSION_ENTRY(type) type,
+	TEXTURE_COMPRESSION_LIST
+#undef TEXTURE_COMPRESSION_ENTRY
+
+	COUNT
+};
+
+consteval int GetTextureCompressionCount()
+{
+	return static_cast<int>(ETextureCompression::COUNT);
+}
+
+const char* GetTextureCompressionName(const ETextureCompression eCompression);
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct TextureCookStats
+{
+	RHI::EFormat format;
+
+	uint32_t width;
+	uint32_t height;
+	uint32_t mipCount;
+
+	uint64_t sourceBytes;
+	uint64_t cookedBytes;
+
+	float mipTimeMs;
+	float encodeTimeMs;
+	float megapixelsPerSecond;
+
+	// 0번 밉에서 형식이 담는 채널만 비교
+	float psnr;
+};
+#pragma warning(pop)
+
+// 압축되지 않은 밉 체인을 BC 형식으로 압축, 블록 줄 단위로 나눠 병렬 실행
+// 크기가 4의 배수가 아니면 false
+bool TryCompressTextureMips(const TextureMipChain& source, const RHI::EFormat format, TextureMipChain& outMipChain, TextureCookStats& outStats);
+
+// 원본 옆의 "<이름>.cooked.dds"
+std::string GetCookedTexturePath(const std::string& sourcePath);
+
+// 쿠킹된 파일이 있고 원본보다 새로우면 true
+bool IsCookedTextureUpToDate(const std::string& sourcePath);
+
+// 원본을 읽어 0번 밉에서 밉 체인을 다시 만들고 압축한 뒤 GetCookedTexturePath에 저장
+// BC5는 노멀 맵으로 보고 감마 없이, 나머지는 sRGB로 보고 선형 공간에서 밉을 거름
+bool TryCookTexture(const std::string& sourcePath, const ETextureCompression eCompression, const EMipFilter eMipFilter, TextureCookStats& outStats);
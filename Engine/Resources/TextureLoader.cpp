@@ -0,0 +1,651 @@
+#include "TextureLoader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <wincodec.h>
+
+#include "Core/Assert.h"
+#include "Core/ComHelper.h"
+#include "Core/LogHelper.h"
+#include "Core/MappedFile.h"
+#include "Core/StringHelper.h"
+
+enum
+{
+	DDS_MAGIC = 0x20534444, // "DDS "
+	DDS_FOURCC_DX10 = 0x30315844, // "DX10"
+	DDS_FOURCC_DXT1 = 0x31545844, // "DXT1"
+	DDS_FOURCC_DXT5 = 0x35545844, // "DXT5"
+	DDS_FOURCC_ATI2 = 0x32495441, // "ATI2"
+	DDS_FOURCC_BC5U = 0x55354342, // "BC5U"
+
+	DDSD_CAPS = 0x1,
+	DDSD_HEIGHT = 0x2,
+	DDSD_WIDTH = 0x4,
+	DDSD_PIXELFORMAT = 0x1000,
+	DDSD_MIPMAPCOUNT = 0x20000,
+	DDSD_LINEARSIZE = 0x80000,
+	DDSCAPS_COMPLEX = 0x8,
+	DDSCAPS_TEXTURE = 0x1000,
+	DDSCAPS_MIPMAP = 0x400000,
+	DDPF_ALPHAPIXELS = 0x1,
+	DDPF_FOURCC = 0x4,
+	DDPF_RGB = 0x40,
+	DDSCAPS2_CUBEMAP = 0x200,
+	DDSCAPS2_VOLUME = 0x200000,
+
+	DDS_DIMENSION_TEXTURE2D = 3,
+
+	DXGI_R8G8B8A8_UNORM = 28,
+	DXGI_R8G8B8A8_UNORM_SRGB = 29,
+	DXGI_BC1_UNORM = 71,
+	DXGI_BC1_UNORM_SRGB = 72,
+	DXGI_BC3_UNORM = 77,
+	DXGI_BC3_UNORM_SRGB = 78,
+	DXGI_BC5_UNORM = 83,
+	DXGI_B8G8R8A8_UNORM = 87,
+	DXGI_B8G8R8X8_UNORM = 88,
+	DXGI_B8G8R8A8_UNORM_SRGB = 91,
+	DXGI_BC7_UNORM = 98,
+	DXGI_BC7_UNORM_SRGB = 99,
+
+	RGBA_BYTES_PER_PIXEL = 4
+};
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct DDSPixelFormat
+{
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t rBitMask;
+	uint32_t gBitMask;
+	uint32_t bBitMask;
+	uint32_t aBitMask;
+};
+
+struct DDSHeader
+{
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11];
+	DDSPixelFormat pixelFormat;
+	uint32_t caps;
+	uint32_t caps2;
+	uint32_t caps3;
+	uint32_t caps4;
+	uint32_t reserved2;
+};
+static_assert(sizeof(DDSHeader) == 124);
+
+struct DDSHeaderDX10
+{
+	uint32_t dxgiFormat;
+	uint32_t resourceDimension;
+	uint32_t miscFlag;
+	uint32_t arraySize;
+	uint32_t miscFlags2;
+};
+#pragma warning(pop)
+
+static uint32_t GetMipExtent(const uint32_t size, const uint32_t mip)
+{
+	const uint32_t extent = size >> mip;
+
+	return extent > 0 ? extent : 1;
+}
+
+// 0번 밉만 채워진 체인에 나머지를 2x2 박스 필터로 만듦
+static void GenerateMips(TextureMipChain& mipChain)
+{
+	ASSERT(mipChain.topMip == 0);
+	ASSERT(mipChain.format == RHI::EFormat::R8G8B8A8_UNORM);
+
+	std::vector<uint8_t> topMipData;
+	topMipData.swap(mipChain.data);
+
+	mipChain.mipCount = GetFullMipCount(mipChain.width, mipChain.height);
+	ResizeTextureMips(mipChain);
+
+	memcpy(mipChain.data.data(), topMipData.data(), topMipData.size());
+
+	for (uint32_t mip = 1; mip < mipChain.mipCount; ++mip)
+	{
+		const uint32_t srcWidth = GetMipExtent(mipChain.width, mip - 1);
+		const uint32_t srcHeight = GetMipExtent(mipChain.height, mip - 1);
+		const uint32_t dstWidth = GetMipExtent(mipChain.width, mip);
+		const uint32_t dstHeight = GetMipExtent(mipChain.height, mip);
+
+		const uint8_t* const pSrc = mipChain.data.data() + mipChain.mipOffsets[mip - 1];
+		uint8_t* const pDst = mipChain.data.data() + mipChain.mipOffsets[mip];
+
+		for (uint32_t y = 0; y < dstHeight; ++y)
+		{
+			// 홀수 크기의 마지막 줄은 가장자리를 반복
+			const uint32_t y0 = y * 2 < srcHeight ? y * 2 : srcHeight - 1;
+			const uint32_t y1 = y0 + 1 < srcHeight ? y0 + 1 : y0;
+
+			for (uint32_t x = 0; x < dstWidth; ++x)
+			{
+				const uint32_t x0 = x * 2 < srcWidth ? x * 2 : srcWidth - 1;
+				const uint32_t x1 = x0 + 1 < srcWidth ? x0 + 1 : x0;
+
+				const uint8_t* const p00 = pSrc + (static_cast<size_t>(y0) * srcWidth + x0) * RGBA_BYTES_PER_PIXEL;
+				const uint8_t* const p01 = pSrc + (static_cast<size_t>(y0) * srcWidth + x1) * RGBA_BYTES_PER_PIXEL;
+				const uint8_t* const p10 = pSrc + (static_cast<size_t>(y1) * srcWidth + x0) * RGBA_BYTES_PER_PIXEL;
+				const uint8_t* const p11 = pSrc + (static_cast<size_t>(y1) * srcWidth + x1) * RGBA_BYTES_PER_PIXEL;
+
+				uint8_t* const pOut = pDst + (static_cast<size_t>(y) * dstWidth + x) * RGBA_BYTES_PER_PIXEL;
+
+				for (uint32_t c = 0; c < RGBA_BYTES_PER_PIXEL; ++c)
+				{
+					pOut[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+				}
+			}
+		}
+	}
+}
+
+static bool TryParseDDS(const uint8_t* const pData, const size_t size, TextureMipChain& outMipChain)
+{
+	ASSERT(pData != nullptr);
+
+	if (size < sizeof(uint32_t) + sizeof(DDSHeader))
+	{
+		return false;
+	}
+
+	uint32_t magic;
+	memcpy(&magic, pData, sizeof(magic));
+
+	DDSHeader header;
+	memcpy(&header, pData + sizeof(magic), sizeof(header));
+
+	if (magic != DDS_MAGIC || header.size != sizeof(DDSHeader) || header.width == 0 || header.height == 0)
+	{
+		return false;
+	}
+
+	if ((header.caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) != 0)
+	{
+		return false;
+	}
+
+	size_t dataOffset = sizeof(magic) + sizeof(header);
+
+	bool bSwizzle;
+	bool bOpaque;
+
+	const DDSPixelFormat& pixelFormat = header.pixelFormat;
+
+	RHI::EFormat format = RHI::EFormat::R8G8B8A8_UNORM;
+
+	if ((pixelFormat.flags & DDPF_FOURCC) != 0 && pixelFormat.fourCC != DDS_FOURCC_DX10)
+	{
+		switch (pixelFormat.fourCC)
+		{
+		case DDS_FOURCC_DXT1:
+			format = RHI::EFormat::BC1_UNORM;
+			break;
+
+		case DDS_FOURCC_DXT5:
+			format = RHI::EFormat::BC3_UNORM;
+			break;
+
+		case DDS_FOURCC_ATI2:
+		case DDS_FOURCC_BC5U:
+			format = RHI::EFormat::BC5_UNORM;
+			break;
+
+		default:
+			return false;
+		}
+
+		bSwizzle = false;
+		bOpaque = false;
+	}
+	else if ((pixelFormat.flags & DDPF_FOURCC) != 0)
+	{
+		if (size < dataOffset + sizeof(DDSHeaderDX10))
+		{
+			return false;
+		}
+
+		DDSHeaderDX10 headerDX10;
+		memcpy(&headerDX10, pData + dataOffset, sizeof(headerDX10));
+		dataOffset += sizeof(headerDX10);
+
+		if (headerDX10.resourceDimension != DDS_DIMENSION_TEXTURE2D || headerDX10.arraySize != 1)
+		{
+			return false;
+		}
+
+		switch (headerDX10.dxgiFormat)
+		{
+		case DXGI_R8G8B8A8_UNORM:
+		case DXGI_R8G8B8A8_UNORM_SRGB:
+			bSwizzle = false;
+			bOpaque = false;
+			break;
+
+		case DXGI_B8G8R8A8_UNORM:
+		case DXGI_B8G8R8A8_UNORM_SRGB:
+			bSwizzle = true;
+			bOpaque = false;
+			break;
+
+		case DXGI_B8G8R8X8_UNORM:
+			bSwizzle = true;
+			bOpaque = true;
+			break;
+
+		case DXGI_BC1_UNORM:
+		case DXGI_BC1_UNORM_SRGB:
+			format = RHI::EFormat::BC1_UNORM;
+			bSwizzle = false;
+			bOpaque = false;
+			break;
+
+		case DXGI_BC3_UNORM:
+		case DXGI_BC3_UNORM_SRGB:
+			format = RHI::EFormat::BC3_UNORM;
+			bSwizzle = false;
+			bOpaque = false;
+			break;
+
+		case DXGI_BC5_UNORM:
+			format = RHI::EFormat::BC5_UNORM;
+			bSwizzle = false;
+			bOpaque = false;
+			break;
+
+		case DXGI_BC7_UNORM:
+		case DXGI_BC7_UNORM_SRGB:
+			format = RHI::EFormat::BC7_UNORM;
+			bSwizzle = false;
+			bOpaque = false;
+			break;
+
+		default:
+			return false;
+		}
+	}
+	else
+	{
+		if ((pixelFormat.flags & DDPF_RGB) == 0 || pixelFormat.rgbBitCount != 32 || pixelFormat.gBitMask != 0x0000FF00)
+		{
+			return false;
+		}
+
+		if (pixelFormat.rBitMask == 0x000000FF && pixelFormat.bBitMask == 0x00FF0000)
+		{
+			bSwizzle = false;
+		}
+		else if (pixelFormat.rBitMask == 0x00FF0000 && pixelFormat.bBitMask == 0x000000FF)
+		{
+			bSwizzle = true;
+		}
+		else
+		{
+			return false;
+		}
+
+		bOpaque = (pixelFormat.flags & DDPF_ALPHAPIXELS) == 0;
+	}
+
+	uint32_t mipCount = (header.flags & DDSD_MIPMAPCOUNT) != 0 && header.mipMapCount > 0 ? header.mipMapCount : 1;
+
+	const uint32_t fullMipCount = GetFullMipCount(header.width, header.height);
+
+	if (mipCount > fullMipCount)
+	{
+		return false;
+	}
+
+	const bool bBlockCompressed = RHI::IsBlockCompressedFormat(format);
+
+	if (bBlockCompressed)
+	{
+		mipCount = GetBlockAlignedMipCount(header.width, header.height, mipCount);
+
+		if (mipCount == 0)
+		{
+			return false;
+		}
+	}
+
+	outMipChain.width = header.width;
+	outMipChain.height = header.height;
+	outMipChain.mipCount = mipCount;
+	outMipChain.topMip = 0;
+	outMipChain.format = format;
+
+	ResizeTextureMips(outMipChain);
+
+	// 밉은 0번부터 빈틈없이 이어짐
+	if (size - dataOffset < outMipChain.data.size())
+	{
+		return false;
+	}
+
+	memcpy(outMipChain.data.data(), pData + dataOffset, outMipChain.data.size());
+
+	if (bSwizzle || bOpaque)
+	{
+		for (size_t i = 0; i < outMipChain.data.size(); i += RGBA_BYTES_PER_PIXEL)
+		{
+			uint8_t* const pPixel = outMipChain.data.data() + i;
+
+			if (bSwizzle)
+			{
+				const uint8_t temp = pPixel[0];
+				pPixel[0] = pPixel[2];
+				pPixel[2] = temp;
+			}
+
+			if (bOpaque)
+			{
+				pPixel[3] = 0xFF;
+			}
+		}
+	}
+
+	if (mipCount == 1 && !bBlockCompressed)
+	{
+		GenerateMips(outMipChain);
+	}
+
+	return true;
+}
+
+static bool TryDecodeWIC(const char* const path, TextureMipChain& outMipChain)
+{
+	ASSERT(path != nullptr);
+
+	// 메인 스레드는 파일 대화상자가 이미 STA로 초기화해둠
+	const HRESULT hrInitialize = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	if (FAILED(hrInitialize) && hrInitialize != RPC_E_CHANGED_MODE)
+	{
+		LOG_SYSTEM_ERROR(hrInitialize, "CoInitializeEx");
+
+		return false;
+	}
+
+	bool bSucceeded = false;
+
+	// COM 객체는 CoUninitialize 전에 해제되어야 함
+	{
+		TCHAR widePath[MAX_PATH];
+		ConvertMultiToWide(widePath, path);
+
+		ComPtr<IWICImagingFactory> factory;
+		ComPtr<IWICBitmapDecoder> decoder;
+		ComPtr<IWICBitmapFrameDecode> frame;
+		ComPtr<IWICFormatConverter> converter;
+
+		HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(factory.GetAddressOf()));
+
+		if (SUCCEEDED(hr))
+		{
+			hr = factory->CreateDecoderFromFilename(widePath, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			hr = decoder->GetFrame(0, frame.GetAddressOf());
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			hr = factory->CreateFormatConverter(converter.GetAddressOf());
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+		}
+
+		UINT width = 0;
+		UINT height = 0;
+
+		if (SUCCEEDED(hr))
+		{
+			hr = converter->GetSize(&width, &height);
+		}
+
+		if (SUCCEEDED(hr) && width > 0 && height > 0)
+		{
+			outMipChain.width = width;
+			outMipChain.height = height;
+			outMipChain.mipCount = 1;
+			outMipChain.topMip = 0;
+			outMipChain.format = RHI::EFormat::R8G8B8A8_UNORM;
+
+			ResizeTextureMips(outMipChain);
+
+			const UINT stride = width * RGBA_BYTES_PER_PIXEL;
+
+			hr = converter->CopyPixels(nullptr, stride, static_cast<UINT>(outMipChain.data.size()), outMipChain.data.data());
+
+			if (SUCCEEDED(hr))
+			{
+				GenerateMips(outMipChain);
+
+				bSucceeded = true;
+			}
+		}
+
+		if (FAILED(hr))
+		{
+			LOG_SYSTEM_ERROR(hr, "WIC decode");
+		}
+	}
+
+	if (SUCCEEDED(hrInitialize))
+	{
+		CoUninitialize();
+	}
+
+	return bSucceeded;
+}
+
+bool TryLoadTextureMips(const char* const path, TextureMipChain& outMipChain)
+{
+	ASSERT(path != nullptr);
+
+	char extension[MAX_PATH];
+	GetExtension(path, extension);
+
+	for (char& c : extension)
+	{
+		c = static_cast<char>(tolower(c));
+	}
+
+	if (strcmp(extension, "dds") != 0)
+	{
+		return TryDecodeWIC(path, outMipChain);
+	}
+
+	MappedFile file;
+
+	if (!file.TryOpen(path))
+	{
+		return false;
+	}
+
+	return TryParseDDS(file.GetData(), file.GetSize(), outMipChain);
+}
+
+bool TrySaveTextureMips(const char* const path, const TextureMipChain& mipChain)
+{
+	ASSERT(path != nullptr);
+
+	uint32_t dxgiFormat;
+
+	switch (mipChain.format)
+	{
+	case RHI::EFormat::R8G8B8A8_UNORM:
+		dxgiFormat = DXGI_R8G8B8A8_UNORM;
+		break;
+
+	case RHI::EFormat::BC1_UNORM:
+		dxgiFormat = DXGI_BC1_UNORM;
+		break;
+
+	case RHI::EFormat::BC3_UNORM:
+		dxgiFormat = DXGI_BC3_UNORM;
+		break;
+
+	case RHI::EFormat::BC5_UNORM:
+		dxgiFormat = DXGI_BC5_UNORM;
+		break;
+
+	case RHI::EFormat::BC7_UNORM:
+		dxgiFormat = DXGI_BC7_UNORM;
+		break;
+
+	default:
+		ASSERT(false, "unsupported texture format");
+		return false;
+	}
+
+	const uint32_t width = GetMipExtent(mipChain.width, mipChain.topMip);
+	const uint32_t height = GetMipExtent(mipChain.height, mipChain.topMip);
+
+	DDSHeader header;
+	memset(&header, 0, sizeof(header));
+
+	header.size = sizeof(DDSHeader);
+	header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+	header.height = height;
+	header.width = width;
+	header.pitchOrLinearSize = static_cast<uint32_t>(RHI::GetSurfaceByteSize(mipChain.format, width, height));
+	header.mipMapCount = mipChain.mipCount - mipChain.topMip;
+	header.pixelFormat.size = sizeof(DDSPixelFormat);
+	header.pixelFormat.flags = DDPF_FOURCC;
+	header.pixelFormat.fourCC = DDS_FOURCC_DX10;
+	header.caps = DDSCAPS_TEXTURE | DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+
+	DDSHeaderDX10 headerDX10;
+	headerDX10.dxgiFormat = dxgiFormat;
+	headerDX10.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+	headerDX10.miscFlag = 0;
+	headerDX10.arraySize = 1;
+	headerDX10.miscFlags2 = 0;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	const uint32_t magic = DDS_MAGIC;
+
+	file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&headerDX10), sizeof(headerDX10));
+	file.write(reinterpret_cast<const char*>(mipChain.data.data()), static_cast<std::streamsize>(mipChain.data.size()));
+
+	const bool bSucceeded = file.good();
+
+	if (!bSucceeded)
+	{
+		file.close();
+		std::remove(path);
+	}
+
+	return bSucceeded;
+}
+
+uint32_t GetFullMipCount(const uint32_t width, const uint32_t height)
+{
+	uint32_t maxSize = width > height ? width : height;
+	uint32_t mipCount = 1;
+
+	while (maxSize > 1)
+	{
+		maxSize >>= 1;
+		++mipCount;
+	}
+
+	return mipCount;
+}
+
+uint32_t GetBlockAlignedMipCount(const uint32_t width, const uint32_t height, const uint32_t mipCount)
+{
+	uint32_t alignedMipCount = 0;
+
+	while (alignedMipCount < mipCount
+		&& GetMipExtent(width, alignedMipCount) % 4 == 0
+		&& GetMipExtent(height, alignedMipCount) % 4 == 0)
+	{
+		++alignedMipCount;
+	}
+
+	return alignedMipCount;
+}
+
+void ResizeTextureMips(TextureMipChain& mipChain)
+{
+	mipChain.mipOffsets.clear();
+
+	size_t offset = 0;
+
+	for (uint32_t mip = mipChain.topMip; mip < mipChain.mipCount; ++mip)
+	{
+		mipChain.mipOffsets.push_back(offset);
+
+		offset += static_cast<size_t>(RHI::GetSurfaceByteSize(mipChain.format, GetMipExtent(mipChain.width, mip), GetMipExtent(mipChain.height, mip)));
+	}
+
+	mipChain.data.resize(offset);
+}
+
+void TrimTextureMips(TextureMipChain& mipChain, const uint32_t topMip)
+{
+	ASSERT(topMip >= mipChain.topMip);
+	ASSERT(topMip < mipChain.mipCount);
+
+	if (topMip == mipChain.topMip)
+	{
+		return;
+	}
+
+	const size_t trimmedBytes = mipChain.mipOffsets[topMip - mipChain.topMip];
+
+	mipChain.data.erase(mipChain.data.begin(), mipChain.data.begin() + trimmedBytes);
+	mipChain.data.shrink_to_fit();
+
+	mipChain.topMip = topMip;
+
+	ResizeTextureMips(mipChain);
+}
+
+void GetTextureMipSubresources(const TextureMipChain& mipChain, std::vector<RHI::SubresourceData>& outSubresources)
+{
+	outSubresources.clear();
+
+	for (uint32_t mip = mipChain.topMip; mip < mipChain.mipCount; ++mip)
+	{
+		const uint32_t mipWidth = GetMipExtent(mipChain.width, mip);
+		const uint32_t mipHeight = GetMipExtent(mipChain.height, mip);
+
+		RHI::SubresourceData subresource;
+		subresource.pData = mipChain.data.data() + mipChain.mipOffsets[mip - mipChain.topMip];
+		subresource.rowPitch = RHI::GetRowPitch(mipChain.format, mipWidth);
+		subresource.slicePitch = static_cast<uint32_t>(RHI::GetSurfaceByteSize(mipChain.format, mipWidth, mipHeight));
+
+		outSubresources.push_back(subresource);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/RHI/RHITypes.h"
+
+// 스트리밍용으로 CPU에 올려둔 밉 체인, R8G8B8A8_UNORM 또는 BC 형식
+// 크기는 원본 기준이고 topMip보다 정밀한 밉은 들고 있지 않음
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct TextureMipChain
+{
+	uint32_t width;
+	uint32_t height;
+	uint32_t mipCount;
+	uint32_t topMip;
+
+	RHI::EFormat format;
+
+	std::vector<uint8_t> data;
+
+	// topMip부터 순서대로
+	std::vector<size_t> mipOffsets;
+};
+#pragma warning(pop)
+
+// 32비트 RGBA/BGRA, BC1/BC3/BC5/BC7 DDS와 WIC가 읽는 이미지를 지원
+// 압축되지 않은 이미지는 밉이 하나뿐이면 박스 필터로 끝까지 만듦
+// BC 형식은 크기가 4의 배수인 밉까지만 남김
+// 백그라운드 스레드에서 호출해도 됨
+bool TryLoadTextureMips(const char* const path, TextureMipChain& outMipChain);
+
+// topMip부터 DX10 헤더를 가진 DDS로 저장
+bool TrySaveTextureMips(const char* const path, const TextureMipChain& mipChain);
+
+// 1x1까지의 밉 개수
+uint32_t GetFullMipCount(const uint32_t width, const uint32_t height);
+
+// BC 형식은 맨 위 밉의 크기가 4의 배수여야 만들 수 있으므로 그런 밉까지의 개수
+uint32_t GetBlockAlignedMipCount(const uint32_t width, const uint32_t height, const uint32_t mipCount);
+
+// data를 형식과 크기에 맞게 다시 잡고 mipOffsets를 채움
+void ResizeTextureMips(TextureMipChain& mipChain);
+
+// topMip보다 정밀한 밉을 버림
+void TrimTextureMips(TextureMipChain& mipChain, const uint32_t topMip);
+
+// CreateTexture에 넘길 초기 데이터, mipChain이 살아 있는 동안만 유효
+void GetTextureMipSubresources(const TextureMipChain& mipChain, std::vector<RHI::SubresourceData>& outSubresources);
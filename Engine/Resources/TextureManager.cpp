@@ -1,95 +1,224 @@
 #include "TextureManager.h"
 
-#include <DDSTextureLoader.h>
-#include <WICTextureLoader.h>
-
 #include "Texture.h"
-#include "Core/StringHelper.h"
 #include "Core/LogHelper.h"
 #include "UI/ImGuiHeaders.h"
 #include "Core/CommonDefs.h"
+#include "Core/JobSystem.h"
+#include "Core/HashHelper.h"
+
+#include <chrono>
 
 enum
 {
-	DEFAULT_BUFFER_SIZE = 32
+	DEFAULT_BUFFER_SIZE = 32,
+
+	DEFAULT_STREAMING_BUDGET_MB = 256,
+	MIN_STREAMING_BUDGET_MB = 1,
+	MAX_STREAMING_BUDGET_MB = 2048,
+	MAX_PENDING_LOAD_COUNT = 4,
+
+	MAX_ATLAS_ARRAY_COUNT = 4
 };
 
 TextureManager* TextureManager::spInstance = nullptr;
 
-TextureManager::TextureManager(ID3D11Device& device)
+#define PLACEHOLDER_TEXTURE_PATH "./Assets/Default.dds"
+
+// 크기와 형식까지 넣어서 바이트가 같아도 배치가 다르면 구분
+static Hash128 HashTextureMips(const TextureMipChain& mipChain)
+{
+	Hash128 hash = HashCombine128({ FNV_OFFSET_BASIS, MIX_SEED }, (static_cast<uint64_t>(mipChain.width) << 32) | mipChain.height);
+	hash = HashCombine128(hash, (static_cast<uint64_t>(mipChain.mipCount) << 32) | mipChain.topMip);
+	hash = HashCombine128(hash, static_cast<uint64_t>(mipChain.format));
+	hash = HashBytes128(mipChain.data.data(), mipChain.data.size(), hash);
+
+	return hash;
+}
+
+TextureManager::TextureManager(RHI::Device& device)
 	: mDevice(device)
 	, mTextureMap()
+	, mpPlaceholderTexture(nullptr)
+	, mTextureStreamer(static_cast<uint64_t>(DEFAULT_STREAMING_BUDGET_MB) * 1024 * 1024, MAX_PENDING_LOAD_COUNT)
+	, mStreamedTextures()
+	, mLoadRequests()
+	, mEvictRequests()
+	, mLoadMutex()
+	, mLoadCondition()
+	, mCompletedLoads()
+	, mInFlightLoadCount(0)
+	, mDecodingPaths()
+	, mCompletedDecodes()
+	, mLoadedCount(0)
+	, mLoadFailCount(0)
+	, mCoalescedLoadCount(0)
+	, mLastLoadLatencyMs(0.f)
+	, mTexturesByContent()
+	, mTextureShares()
+	, mDedupLookupCount(0)
+	, mDedupHitCount(0)
+	, mDedupSavedBytes(0)
+	, mTextureResidency()
+	, mUnusedPaths()
+	, mEvictCount(0)
+	, mDecodeBenchmarks()
+	, mFrameIndex(1)
+	, mBudgetMB(DEFAULT_STREAMING_BUDGET_MB)
+	, mStreamingTimeMs(0.f)
+	, mAtlasArrays()
+	, mAtlasRegions()
+	, mAtlasSliceCount(0)
+	, mAtlasOccupancy(0.f)
+	, mAtlasPackTimeMs(0.f)
+	, mCookCompression(ETextureCompression::AUTO)
+	, mCookMipFilter(EMipFilter::KAISER)
+	, mCookTimeMs(0.f)
+	, mCookResults()
 {
 	mTextureMap.reserve(DEFAULT_BUFFER_SIZE);
+	mStreamedTextures.reserve(DEFAULT_BUFFER_SIZE);
+	mTextureResidency.reserve(DEFAULT_BUFFER_SIZE);
+
+	// 대체 텍스처는 다른 텍스처보다 먼저 있어야 하므로 바로 올림
+	const RHI::TextureHandle placeholderHandle = mDevice.CreateTextureFromFile(PLACEHOLDER_TEXTURE_PATH);
+
+	if (!placeholderHandle.IsValid())
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "CreateTextureFromFile");
+
+		ASSERT(false);
+	}
+
+	const RHI::TextureDesc placeholderDesc = mDevice.GetTextureDesc(placeholderHandle);
 
-	LoadTexture("./Assets/Default.dds");
+	mpPlaceholderTexture = new Texture(PLACEHOLDER_TEXTURE_PATH, placeholderHandle, placeholderDesc.width, placeholderDesc.height);
+
+	mTextureMap.insert(std::make_pair(std::string(PLACEHOLDER_TEXTURE_PATH), mpPlaceholderTexture));
 }
 
 TextureManager::~TextureManager()
 {
+	// 작업이 this를 참조하므로 모두 끝날 때까지 대기
+	{
+		std::unique_lock<std::mutex> lock(mLoadMutex);
+
+		mLoadCondition.wait(lock, [this]()
+			{
+				return mInFlightLoadCount == 0;
+			});
+	}
+
+	for (const RHI::TextureHandle textureArray : mAtlasArrays)
+	{
+		mDevice.DestroyTexture(textureArray);
+	}
+
 	for (std::pair<const std::string, Texture*>& pair : mTextureMap)
 	{
+		// 같이 쓰는 텍스처는 마지막 경로에서 해제
+		if (!releaseTextureShare(pair.second))
+		{
+			continue;
+		}
+
+		// 빌린 핸들은 대체 텍스처가 해제함
+		if (!pair.second->IsPlaceholder())
+		{
+			mDevice.DestroyTexture(pair.second->GetHandle());
+		}
+
 		delete pair.second;
 	}
 }
 
-void TextureManager::LoadTexture(const std::string& path)
+Texture* TextureManager::LoadTexture(const std::string& path)
 {
-	using namespace DirectX;
+#define RESIDENCY_MAP_ITER std::unordered_map<std::string, TextureResidency>::iterator
+
+	RESIDENCY_MAP_ITER residencyIter = mTextureResidency.find(path);
+
+	if (residencyIter == mTextureResidency.end())
+	{
+		mTextureResidency.insert(std::make_pair(path, TextureResidency{ 1, mUnusedPaths.end() }));
+	}
+	else
+	{
+		// 참조가 없어 LRU에 있던 것이면 꺼냄
+		if (residencyIter->second.refCount == 0)
+		{
+			mUnusedPaths.erase(residencyIter->second.lruIter);
+		}
+
+		++residencyIter->second.refCount;
+	}
+
+#undef RESIDENCY_MAP_ITER
 
 #define MAP_ITER std::unordered_map<std::string, Texture*>::iterator
 
 	MAP_ITER iter = mTextureMap.find(path);
 
-	if (iter == mTextureMap.end())
+	if (iter != mTextureMap.end())
 	{
-		char extension[MAX_PATH];
-		GetExtension(path, extension);
-
-		for (char& c : extension)
+		if (iter->second->IsPlaceholder())
 		{
-			c = static_cast<char>(tolower(c));
+			++mCoalescedLoadCount;
 		}
 
-		TCHAR widePath[MAX_PATH];
-		ConvertMultiToWide(widePath, path.c_str());
+		return iter->second;
+	}
 
-		ComPtr<ID3D11ShaderResourceView> shaderResourceViewGPU;
-		ID3D11Resource* pResource;
+#undef MAP_ITER
 
-		HRESULT hr;
-		if (strcmp(extension, "dds") == 0)
-		{
-			hr = CreateDDSTextureFromFile(&mDevice, widePath, &pResource, shaderResourceViewGPU.GetAddressOf());
-		}
-		else
-		{
-			hr = CreateWICTextureFromFile(&mDevice, widePath, &pResource, shaderResourceViewGPU.GetAddressOf());
-		}
+	Texture* const pTexture = new Texture(path, mpPlaceholderTexture->GetHandle(), mpPlaceholderTexture->GetWidth(), mpPlaceholderTexture->GetHeight());
+	pTexture->SetPlaceholder(true);
 
-		if (FAILED(hr))
-		{
-			LOG_SYSTEM_ERROR(hr, "CreateDDSTextureFromFile");
+	mTextureMap.insert(std::make_pair(path, pTexture));
 
-			ASSERT(false);
-		}
+	// 해제 후 다시 요청했는데 이전 디코딩이 아직 돌고 있으면 그 결과를 씀
+	if (!mDecodingPaths.insert(path).second)
+	{
+		++mCoalescedLoadCount;
+
+		return pTexture;
+	}
 
-		ID3D11Texture2D* const pTexture2D = reinterpret_cast<ID3D11Texture2D*>(pResource);
-		ASSERT(pTexture2D != nullptr);
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
 
-		D3D11_TEXTURE2D_DESC textureDesc;
-		ZeroMemory(&textureDesc, sizeof(D3D11_TEXTURE2D_DESC));
+		++mInFlightLoadCount;
+	}
+
+	std::function<void()> job = [this, path, requestTime = std::chrono::steady_clock::now()]()
+		{
+			DecodeResult result;
+			result.path = path;
 
-		pTexture2D->GetDesc(&textureDesc);
+			// 최신 쿠킹 결과가 있으면 그쪽을 읽음
+			result.filePath = IsCookedTextureUpToDate(path) ? GetCookedTexturePath(path) : path;
+			result.bSucceeded = TryLoadTextureMips(result.filePath.c_str(), result.mipChain);
+			result.contentHash = result.bSucceeded ? HashTextureMips(result.mipChain) : Hash128{ 0, 0 };
+			result.requestTime = requestTime;
 
-		Texture* const pTexture = new Texture(path, shaderResourceViewGPU, textureDesc.Width, textureDesc.Height);
+			std::lock_guard<std::mutex> lock(mLoadMutex);
 
-		mTextureMap.insert(std::make_pair(path, pTexture));
+			mCompletedDecodes.push_back(std::move(result));
+			--mInFlightLoadCount;
 
-		SafeRelease(pResource);
+			mLoadCondition.notify_all();
+		};
+
+	if (JobSystem::IsInitialized())
+	{
+		JobSystem::GetInstance().Submit(std::move(job));
+	}
+	else
+	{
+		job();
 	}
 
-#undef MAP_ITER
+	return pTexture;
 }
 
 Texture* TextureManager::GetTextureOrNull(const std::string& path) const
@@ -108,14 +237,78 @@ Texture* TextureManager::GetTextureOrNull(const std::string& path) const
 	return nullptr;
 }
 
-void TextureManager::UnloadTexture(const std::string& path)
+void TextureManager::ReleaseTexture(const std::string& path)
+{
+#define RESIDENCY_MAP_ITER std::unordered_map<std::string, TextureResidency>::iterator
+
+	RESIDENCY_MAP_ITER residencyIter = mTextureResidency.find(path);
+	ASSERT(residencyIter != mTextureResidency.end());
+
+	TextureResidency& residency = residencyIter->second;
+	ASSERT(residency.refCount > 0);
+
+	--residency.refCount;
+
+	if (residency.refCount == 0)
+	{
+		residency.lruIter = mUnusedPaths.insert(mUnusedPaths.end(), path);
+	}
+
+#undef RESIDENCY_MAP_ITER
+}
+
+void TextureManager::UpdateResidency()
+{
+	const uint64_t budgetBytes = static_cast<uint64_t>(mBudgetMB) * 1024 * 1024;
+
+	// 같이 쓰는 경로나 통째로 올린 텍스처는 해제해도 상주 크기가 줄지 않을 수 있음
+	while (mTextureStreamer.GetStats().residentBytes > budgetBytes && !mUnusedPaths.empty())
+	{
+		const std::string path = mUnusedPaths.front();
+
+		mUnusedPaths.pop_front();
+		mTextureResidency.erase(path);
+
+		unloadTexture(path);
+
+		++mEvictCount;
+	}
+}
+
+void TextureManager::unloadTexture(const std::string& path)
 {
 #define MAP_ITER std::unordered_map<std::string, Texture*>::iterator
 
 	MAP_ITER iter = mTextureMap.find(path);
 
-	if (iter != mTextureMap.end())
+	if (iter != mTextureMap.end() && iter->second != mpPlaceholderTexture)
 	{
+		if (!releaseTextureShare(iter->second))
+		{
+			mTextureMap.erase(iter);
+
+			return;
+		}
+
+		const uint32_t streamingID = iter->second->GetStreamingID();
+
+		// 불러오는 중인 결과는 도착해도 버려짐
+		if (streamingID != TextureStreamer::INVALID_TEXTURE_ID)
+		{
+			mTextureStreamer.Unregister(streamingID);
+
+			mStreamedTextures[streamingID] = { nullptr, std::string(), TextureMipChain() };
+		}
+
+		// 배열 안의 자리는 다음에 다시 묶을 때 비워짐
+		mAtlasRegions.erase(iter->second->GetPath());
+
+		// 디코딩 중이면 결과가 도착해도 버려짐
+		if (!iter->second->IsPlaceholder())
+		{
+			mDevice.DestroyTexture(iter->second->GetHandle());
+		}
+
 		delete iter->second;
 
 		mTextureMap.erase(iter);
@@ -124,11 +317,494 @@ void TextureManager::UnloadTexture(const std::string& path)
 #undef MAP_ITER
 }
 
+void TextureManager::ApplyTextureLoads()
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	std::vector<DecodeResult> completedDecodes;
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		completedDecodes.swap(mCompletedDecodes);
+	}
+
+	for (DecodeResult& result : completedDecodes)
+	{
+		mDecodingPaths.erase(result.path);
+
+		Texture* const pTexture = GetTextureOrNull(result.path);
+
+		if (pTexture == nullptr || !pTexture->IsPlaceholder())
+		{
+			continue;
+		}
+
+		if (result.bSucceeded)
+		{
+			++mDedupLookupCount;
+
+#define CONTENT_MAP_ITER std::unordered_map<uint64_t, Texture*>::const_iterator
+
+			CONTENT_MAP_ITER contentIter = mTexturesByContent.find(result.contentHash.low);
+
+			// 올린 픽셀은 GPU에만 있어서 비교할 수 없음, 128비트 해시와 크기가 모두 같아야 같은 텍스처로 봄
+			// 자리만 잡은 Texture는 아무도 들고 있지 않으므로 바로 버리고 경로를 옮김
+			if (contentIter != mTexturesByContent.end()
+				&& mTextureShares[contentIter->second].contentHash == result.contentHash
+				&& contentIter->second->GetWidth() == static_cast<int>(result.mipChain.width)
+				&& contentIter->second->GetHeight() == static_cast<int>(result.mipChain.height))
+			{
+				Texture* const pSharedTexture = contentIter->second;
+
+				++mTextureShares[pSharedTexture].refCount;
+
+				++mDedupHitCount;
+				mDedupSavedBytes += result.mipChain.data.size();
+
+				delete pTexture;
+				mTextureMap[result.path] = pSharedTexture;
+
+				++mLoadedCount;
+				mLastLoadLatencyMs = Milliseconds(Clock::now() - result.requestTime).count();
+
+				continue;
+			}
+
+#undef CONTENT_MAP_ITER
+		}
+
+		const Hash128 contentHash = result.contentHash;
+		const bool bDecoded = result.bSucceeded;
+
+		// 실패하면 대체 텍스처를 계속 씀
+		if (tryApplyLoadedTexture(*pTexture, result))
+		{
+			++mLoadedCount;
+			mLastLoadLatencyMs = Milliseconds(Clock::now() - result.requestTime).count();
+
+			// 디바이스가 파일을 직접 읽은 것은 내용을 모름
+			if (bDecoded)
+			{
+				mTextureShares.insert(std::make_pair(pTexture, TextureShare{ contentHash, 1 }));
+				mTexturesByContent.insert(std::make_pair(contentHash.low, pTexture));
+			}
+		}
+		else
+		{
+			++mLoadFailCount;
+		}
+	}
+}
+
+void TextureManager::MeasureDecodeThroughput()
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	std::vector<std::string> paths;
+	paths.reserve(mTextureMap.size());
+
+#define MAP_ITER std::unordered_map<std::string, Texture*>::const_iterator
+
+	for (MAP_ITER iter = mTextureMap.cbegin(); iter != mTextureMap.cend(); ++iter)
+	{
+		if (iter->second != mpPlaceholderTexture)
+		{
+			paths.push_back(iter->first);
+		}
+	}
+
+#undef MAP_ITER
+
+	mDecodeBenchmarks.clear();
+
+	if (paths.empty())
+	{
+		return;
+	}
+
+	const uint32_t maxThreadCount = JobSystem::IsInitialized() ? JobSystem::GetInstance().GetWorkerCount() + 1 : 1;
+
+	// 스레드 수만큼 청크를 나누면 동시에 도는 스레드도 그만큼
+	std::vector<uint64_t> chunkPixelCounts(maxThreadCount);
+
+	const JobSystem::ChunkFunction decodeTextures = [&paths, &chunkPixelCounts](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				TextureMipChain mipChain;
+
+				if (TryLoadTextureMips(paths[i].c_str(), mipChain))
+				{
+					chunkPixelCounts[chunkIndex] += static_cast<uint64_t>(mipChain.width) * mipChain.height;
+				}
+			}
+		};
+
+	const uint32_t textureCount = static_cast<uint32_t>(paths.size());
+
+	for (uint32_t threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+	{
+		for (uint64_t& pixelCount : chunkPixelCounts)
+		{
+			pixelCount = 0;
+		}
+
+		const Clock::time_point decodeStart = Clock::now();
+
+		if (threadCount == 1)
+		{
+			decodeTextures(0, textureCount, 0);
+		}
+		else
+		{
+			JobSystem::GetInstance().ParallelFor(textureCount, threadCount, decodeTextures);
+		}
+
+		DecodeBenchmark benchmark;
+		benchmark.threadCount = threadCount;
+		benchmark.timeMs = Milliseconds(Clock::now() - decodeStart).count();
+
+		uint64_t pixelCount = 0;
+
+		for (const uint64_t chunkPixelCount : chunkPixelCounts)
+		{
+			pixelCount += chunkPixelCount;
+		}
+
+		benchmark.megapixelsPerSecond = benchmark.timeMs > 0.f ? static_cast<float>(pixelCount) / (benchmark.timeMs * 1000.f) : 0.f;
+
+		mDecodeBenchmarks.push_back(benchmark);
+	}
+}
+
+void TextureManager::PackSmallTextures()
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point packStart = Clock::now();
+
+	// 1. 작은 텍스처의 원본을 다시 읽음, 쿠킹된 BC 파일은 형식이 달라 쓰지 않음
+	std::vector<std::string> paths;
+	std::vector<const Texture*> textures;
+	std::vector<TextureMipChain> sources;
+	std::vector<AtlasRect> rects;
+
+#define MAP_ITER std::unordered_map<std::string, Texture*>::const_iterator
+
+	for (MAP_ITER iter = mTextureMap.cbegin(); iter != mTextureMap.cend(); ++iter)
+	{
+		const Texture* const pTexture = iter->second;
+
+		if (pTexture == mpPlaceholderTexture
+			|| pTexture->IsPlaceholder()
+			|| pTexture->GetWidth() > ATLAS_MAX_TEXTURE_SIZE
+			|| pTexture->GetHeight() > ATLAS_MAX_TEXTURE_SIZE)
+		{
+			continue;
+		}
+
+		// 같이 쓰는 텍스처는 한 번만 담음, 원래 경로가 해제됐으면 남은 경로로 담음
+		if (iter->first != pTexture->GetPath() && GetTextureOrNull(pTexture->GetPath()) == pTexture)
+		{
+			continue;
+		}
+
+		TextureMipChain source;
+
+		if (!TryLoadTextureMips(iter->first.c_str(), source) || source.format != RHI::EFormat::R8G8B8A8_UNORM)
+		{
+			continue;
+		}
+
+		// 0번 밉만 씀
+		source.mipCount = 1;
+		ResizeTextureMips(source);
+
+		AtlasRect rect = {};
+		rect.width = source.width;
+		rect.height = source.height;
+
+		paths.push_back(iter->first);
+		textures.push_back(pTexture);
+		sources.push_back(std::move(source));
+		rects.push_back(rect);
+	}
+
+#undef MAP_ITER
+
+	// 2. 이전 아틀라스를 버리고 새로 담음
+	for (const RHI::TextureHandle textureArray : mAtlasArrays)
+	{
+		mDevice.DestroyTexture(textureArray);
+	}
+
+	mAtlasArrays.clear();
+	mAtlasRegions.clear();
+
+	const uint32_t sliceCount = PackAtlasRects(rects, MAX_ATLAS_ARRAY_COUNT * ATLAS_SLICES_PER_ARRAY);
+
+	std::vector<TextureMipChain> slices(sliceCount);
+
+	for (TextureMipChain& slice : slices)
+	{
+		InitializeAtlasSlice(slice);
+	}
+
+	uint64_t packedPixelCount = 0;
+
+	for (uint32_t i = 0; i < rects.size(); ++i)
+	{
+		if (rects[i].bPacked)
+		{
+			BlitAtlasRect(slices[rects[i].slice], rects[i], sources[i]);
+
+			packedPixelCount += static_cast<uint64_t>(rects[i].width) * rects[i].height;
+		}
+	}
+
+	// 3. 슬라이스마다 밉을 병렬로 만듦
+	const JobSystem::ChunkFunction generateMips = [&slices](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				GenerateAtlasMips(slices[i]);
+			}
+		};
+
+	if (JobSystem::IsInitialized())
+	{
+		JobSystem::GetInstance().ParallelFor(sliceCount, JobSystem::GetInstance().GetWorkerCount() + 1, generateMips);
+	}
+	else
+	{
+		generateMips(0, sliceCount, 0);
+	}
+
+	// 4. ATLAS_SLICES_PER_ARRAY장씩 배열로 올림, 초기 데이터는 슬라이스마다 밉 순서
+	std::vector<RHI::SubresourceData> subresources;
+	std::vector<RHI::SubresourceData> sliceSubresources;
+
+	for (uint32_t firstSlice = 0; firstSlice < sliceCount; firstSlice += ATLAS_SLICES_PER_ARRAY)
+	{
+		const uint32_t arraySize = sliceCount - firstSlice < ATLAS_SLICES_PER_ARRAY ? sliceCount - firstSlice : ATLAS_SLICES_PER_ARRAY;
+
+		subresources.clear();
+
+		for (uint32_t slice = firstSlice; slice < firstSlice + arraySize; ++slice)
+		{
+			GetTextureMipSubresources(slices[slice], sliceSubresources);
+			subresources.insert(subresources.end(), sliceSubresources.begin(), sliceSubresources.end());
+		}
+
+		RHI::TextureDesc textureDesc = {};
+		textureDesc.width = ATLAS_SLICE_SIZE;
+		textureDesc.height = ATLAS_SLICE_SIZE;
+		textureDesc.mipLevels = ATLAS_MIP_COUNT;
+		textureDesc.arraySize = arraySize;
+		textureDesc.sampleCount = 1;
+		textureDesc.bindFlags = RHI::BIND_SHADER_RESOURCE;
+		textureDesc.miscFlags = RHI::TEXTURE_MISC_ARRAY;
+		textureDesc.format = RHI::EFormat::R8G8B8A8_UNORM;
+		textureDesc.usage = RHI::EUsage::IMMUTABLE;
+
+		const RHI::TextureHandle textureArray = mDevice.CreateTexture(textureDesc, subresources.data());
+
+		// 하나라도 못 만들면 아틀라스 없이 그림
+		if (!textureArray.IsValid())
+		{
+			for (const RHI::TextureHandle createdArray : mAtlasArrays)
+			{
+				mDevice.DestroyTexture(createdArray);
+			}
+
+			mAtlasArrays.clear();
+			mAtlasSliceCount = 0;
+			mAtlasOccupancy = 0.f;
+
+			return;
+		}
+
+		mAtlasArrays.push_back(textureArray);
+	}
+
+	for (uint32_t i = 0; i < rects.size(); ++i)
+	{
+		if (rects[i].bPacked)
+		{
+			// 경로 대신 Texture의 원래 경로로 찾음
+			mAtlasRegions.insert(std::make_pair(std::string(textures[i]->GetPath()), GetAtlasRegion(rects[i])));
+		}
+	}
+
+	mAtlasSliceCount = sliceCount;
+	mAtlasOccupancy = sliceCount > 0 ? static_cast<float>(packedPixelCount) / (static_cast<float>(sliceCount) * ATLAS_SLICE_SIZE * ATLAS_SLICE_SIZE) : 0.f;
+	mAtlasPackTimeMs = Milliseconds(Clock::now() - packStart).count();
+}
+
+bool TextureManager::TryGetAtlasRegion(const std::string& path, TextureAtlasRegion& outRegion, RHI::TextureHandle& outTextureArray) const
+{
+	if (mAtlasRegions.empty())
+	{
+		return false;
+	}
+
+	const Texture* const pTexture = GetTextureOrNull(path);
+
+	if (pTexture == nullptr)
+	{
+		return false;
+	}
+
+#define MAP_ITER std::unordered_map<std::string, TextureAtlasRegion>::const_iterator
+
+	MAP_ITER iter = mAtlasRegions.find(pTexture->GetPath());
+
+	if (iter == mAtlasRegions.end())
+	{
+		return false;
+	}
+
+#undef MAP_ITER
+
+	outRegion = iter->second;
+	outTextureArray = mAtlasArrays[iter->second.arrayIndex];
+
+	return true;
+}
+
+void TextureManager::CookLoadedTextures(const ETextureCompression eCompression, const EMipFilter eMipFilter)
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point cookStart = Clock::now();
+
+	mCookResults.clear();
+
+#define MAP_ITER std::unordered_map<std::string, Texture*>::const_iterator
+
+	for (MAP_ITER iter = mTextureMap.cbegin(); iter != mTextureMap.cend(); ++iter)
+	{
+		mCookResults.push_back({ iter->first, false, {} });
+	}
+
+#undef MAP_ITER
+
+	const JobSystem::ChunkFunction cookTextures = [this, eCompression, eMipFilter](const uint32_t begin, const uint32_t end, const uint32_t chunkIndex)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				CookResult& result = mCookResults[i];
+
+				result.bSucceeded = TryCookTexture(result.path, eCompression, eMipFilter, result.stats);
+			}
+		};
+
+	const uint32_t textureCount = static_cast<uint32_t>(mCookResults.size());
+
+	// 압축 안에서도 ParallelFor를 쓰지만 기다리는 스레드가 남은 작업을 도우므로 겹쳐도 됨
+	if (JobSystem::IsInitialized())
+	{
+		JobSystem::GetInstance().ParallelFor(textureCount, JobSystem::GetInstance().GetWorkerCount() + 1, cookTextures);
+	}
+	else
+	{
+		cookTextures(0, textureCount, 0);
+	}
+
+	mCookTimeMs = Milliseconds(Clock::now() - cookStart).count();
+}
+
+void TextureManager::RequestTextureDetail(const std::string& path, const float screenPixels)
+{
+	const Texture* const pTexture = GetTextureOrNull(path);
+
+	// 아틀라스로 그리는 텍스처는 따로 올릴 필요 없음
+	if (pTexture == nullptr || pTexture->GetStreamingID() == TextureStreamer::INVALID_TEXTURE_ID || mAtlasRegions.find(pTexture->GetPath()) != mAtlasRegions.end())
+	{
+		return;
+	}
+
+	mTextureStreamer.RequestScreenSize(pTexture->GetStreamingID(), screenPixels, mFrameIndex);
+}
+
+void TextureManager::UpdateStreaming()
+{
+	using Clock = std::chrono::steady_clock;
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+
+	const Clock::time_point updateStart = Clock::now();
+
+	// 끝난 불러오기 교체
+	std::vector<LoadResult> completedLoads;
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		completedLoads.swap(mCompletedLoads);
+	}
+
+	for (const LoadResult& result : completedLoads)
+	{
+		Texture* const pTexture = mStreamedTextures[result.streamingID].pTexture;
+
+		if (pTexture == nullptr)
+		{
+			mTextureStreamer.CompleteLoad(result.streamingID, false);
+
+			continue;
+		}
+
+		const RHI::TextureHandle textureHandle = result.bSucceeded ? createTexture(result.mipChain) : RHI::TextureHandle{ 0 };
+
+		mTextureStreamer.CompleteLoad(result.streamingID, textureHandle.IsValid());
+
+		if (textureHandle.IsValid())
+		{
+			// 제출된 명령은 바로 실행되므로 이전 핸들을 바로 해제해도 됨
+			mDevice.DestroyTexture(pTexture->GetHandle());
+			pTexture->SetHandle(textureHandle);
+		}
+	}
+
+	mTextureStreamer.Update(mFrameIndex, mLoadRequests, mEvictRequests);
+
+	// 내리는 것은 남겨둔 기본 밉으로 바로 교체
+	for (const TextureStreamer::Request& request : mEvictRequests)
+	{
+		const StreamedTexture& streamedTexture = mStreamedTextures[request.textureID];
+		ASSERT(streamedTexture.pTexture != nullptr);
+
+		Texture* const pTexture = streamedTexture.pTexture;
+
+		const RHI::TextureHandle textureHandle = createTexture(streamedTexture.baseMipChain);
+
+		if (textureHandle.IsValid())
+		{
+			mDevice.DestroyTexture(pTexture->GetHandle());
+			pTexture->SetHandle(textureHandle);
+		}
+	}
+
+	for (const TextureStreamer::Request& request : mLoadRequests)
+	{
+		submitLoad(request);
+	}
+
+	++mFrameIndex;
+
+	mStreamingTimeMs = Milliseconds(Clock::now() - updateStart).count();
+}
+
 void TextureManager::DrawEditorUI()
 {
 	ImGui::PushID("TextureManager");
 
-	ImGui::Text(UTF8_TEXT("ؽó "));
+	ImGui::Text(UTF8_TEXT("텍스처 목록"));
 
 #define MAP_ITER std::unordered_map<std::string, Texture*>::const_iterator
 
@@ -143,15 +819,337 @@ void TextureManager::DrawEditorUI()
 		const int width = pTexture->GetWidth();
 		const int height = pTexture->GetHeight();
 
-		ImGui::Text("%s (%d x %d)", path, width, height);
+		const uint32_t streamingID = pTexture->GetStreamingID();
+
+		if (pTexture->IsPlaceholder())
+		{
+			ImGui::Text("%s %s", path, mDecodingPaths.find(pair.first) != mDecodingPaths.end() ? "Decoding" : "Failed");
+
+			continue;
+		}
+
+		// 같이 쓰는 텍스처는 상태를 원래 경로에서 보여줌
+		if (pair.first != path)
+		{
+			ImGui::Text("%s = %s", pair.first.c_str(), path);
+
+			continue;
+		}
+
+		if (streamingID == TextureStreamer::INVALID_TEXTURE_ID)
+		{
+			ImGui::Text("%s (%d x %d)", path, width, height);
+
+			continue;
+		}
+
+		ImGui::Text("%s (%d x %d) Mip: %u (Wanted: %u)%s",
+			path,
+			width,
+			height,
+			mTextureStreamer.GetResidentMip(streamingID),
+			mTextureStreamer.GetWantedMip(streamingID),
+			mTextureStreamer.IsPending(streamingID) ? " Loading" : ""
+		);
 	}
 
 #undef MAP_ITER
 
+	ImGui::SeparatorText(UTF8_TEXT("비동기 불러오기"));
+	{
+		ImGui::Text("Decoding: %u / Loaded: %u / Failed: %u / Coalesced: %u",
+			static_cast<uint32_t>(mDecodingPaths.size()),
+			mLoadedCount,
+			mLoadFailCount,
+			mCoalescedLoadCount
+		);
+		ImGui::Text("Last Latency: %.2f ms", mLastLoadLatencyMs);
+		ImGui::Text("Dedup Hits: %u / %u (%.1f%%) / Saved: %.2f MB",
+			mDedupHitCount,
+			mDedupLookupCount,
+			mDedupLookupCount > 0 ? 100.f * mDedupHitCount / mDedupLookupCount : 0.f,
+			mDedupSavedBytes / (1024.f * 1024.f)
+		);
+
+		if (ImGui::Button("Measure Decode Throughput"))
+		{
+			MeasureDecodeThroughput();
+		}
+
+		for (const DecodeBenchmark& benchmark : mDecodeBenchmarks)
+		{
+			ImGui::Text("Threads: %u / %.2f ms (%.2f MP/s)", benchmark.threadCount, benchmark.timeMs, benchmark.megapixelsPerSecond);
+		}
+	}
+
+	ImGui::SeparatorText(UTF8_TEXT("스트리밍"));
+	{
+		if (ImGui::SliderInt("Budget (MB)", &mBudgetMB, MIN_STREAMING_BUDGET_MB, MAX_STREAMING_BUDGET_MB))
+		{
+			mTextureStreamer.SetBudgetBytes(static_cast<uint64_t>(mBudgetMB) * 1024 * 1024);
+		}
+
+		const TextureStreamer::Stats& stats = mTextureStreamer.GetStats();
+
+		ImGui::Text("Resident: %.2f MB / Committed: %.2f MB", stats.residentBytes / (1024.f * 1024.f), stats.committedBytes / (1024.f * 1024.f));
+		ImGui::Text("Streamed Textures: %u / Pending: %u", stats.textureCount, stats.pendingCount);
+		ImGui::Text("Loads: %u / Evictions: %u / Deferred: %u", stats.loadCount, stats.evictCount, stats.deferredCount);
+		ImGui::Text("Update: %.3f ms", mStreamingTimeMs);
+		ImGui::Text("Referenced: %u / Unused (LRU): %u / Evicted: %u",
+			static_cast<uint32_t>(mTextureResidency.size() - mUnusedPaths.size()),
+			static_cast<uint32_t>(mUnusedPaths.size()),
+			mEvictCount
+		);
+	}
+
+	ImGui::SeparatorText(UTF8_TEXT("아틀라스"));
+	{
+		if (ImGui::Button("Pack Small Textures"))
+		{
+			PackSmallTextures();
+		}
+
+		ImGui::Text("Packed: %u / Arrays: %u / Slices: %u (%d x %d)",
+			static_cast<uint32_t>(mAtlasRegions.size()),
+			static_cast<uint32_t>(mAtlasArrays.size()),
+			mAtlasSliceCount,
+			ATLAS_SLICE_SIZE,
+			ATLAS_SLICE_SIZE
+		);
+		ImGui::Text("Occupancy: %.1f%% / Pack: %.2f ms", mAtlasOccupancy * 100.f, mAtlasPackTimeMs);
+	}
+
+	ImGui::SeparatorText(UTF8_TEXT("쿠킹"));
+	{
+		if (ImGui::BeginCombo("Compression", GetTextureCompressionName(mCookCompression)))
+		{
+			for (int i = 0; i < GetTextureCompressionCount(); ++i)
+			{
+				const ETextureCompression eCompression = static_cast<ETextureCompression>(i);
+
+				if (ImGui::Selectable(GetTextureCompressionName(eCompression), eCompression == mCookCompression))
+				{
+					mCookCompression = eCompression;
+				}
+			}
+
+			ImGui::EndCombo();
+		}
+
+		if (ImGui::BeginCombo("Mip Filter", GetMipFilterName(mCookMipFilter)))
+		{
+			for (int i = 0; i < GetMipFilterCount(); ++i)
+			{
+				const EMipFilter eMipFilter = static_cast<EMipFilter>(i);
+
+				if (ImGui::Selectable(GetMipFilterName(eMipFilter), eMipFilter == mCookMipFilter))
+				{
+					mCookMipFilter = eMipFilter;
+				}
+			}
+
+			ImGui::EndCombo();
+		}
+
+		if (ImGui::Button("Cook Loaded Textures"))
+		{
+			CookLoadedTextures(mCookCompression, mCookMipFilter);
+		}
+
+		ImGui::TextDisabled(UTF8_TEXT("쿠킹 결과는 다음에 불러올 때부터 적용"));
+
+		if (!mCookResults.empty())
+		{
+			ImGui::Text("Total: %.2f ms", mCookTimeMs);
+		}
+
+		for (const CookResult& result : mCookResults)
+		{
+			if (!result.bSucceeded)
+			{
+				ImGui::Text("%s: Failed", result.path.c_str());
+
+				continue;
+			}
+
+			const TextureCookStats& stats = result.stats;
+
+			ImGui::Text("%s: %s %ux%u Mips: %u", result.path.c_str(), RHI::GetFormatName(stats.format), stats.width, stats.height, stats.mipCount);
+			ImGui::Text("    Mips: %.2f ms / Encode: %.2f ms (%.2f MP/s) / PSNR: %.2f dB / Size: %.1f%%",
+				stats.mipTimeMs,
+				stats.encodeTimeMs,
+				stats.megapixelsPerSecond,
+				stats.psnr,
+				stats.sourceBytes > 0 ? 100.f * stats.cookedBytes / stats.sourceBytes : 0.f
+			);
+		}
+	}
+
 	ImGui::PopID();
 }
 
-void TextureManager::Initialize(ID3D11Device& device)
+bool TextureManager::tryApplyLoadedTexture(Texture& texture, DecodeResult& result)
+{
+	ASSERT(texture.IsPlaceholder());
+
+	// 처음에는 기본 밉만 올리고 나머지는 보일 때 스트리밍
+	if (result.bSucceeded)
+	{
+		TextureMipChain& mipChain = result.mipChain;
+
+		const uint32_t streamingID = mTextureStreamer.Register(mipChain.width, mipChain.height, mipChain.mipCount, mipChain.format);
+		ASSERT(streamingID == mStreamedTextures.size());
+
+		TrimTextureMips(mipChain, mTextureStreamer.GetBaseMip(streamingID));
+
+		const RHI::TextureHandle textureHandle = createTexture(mipChain);
+
+		if (textureHandle.IsValid())
+		{
+			texture.SetHandle(textureHandle);
+			texture.SetSize(static_cast<int>(mipChain.width), static_cast<int>(mipChain.height));
+			texture.SetStreamingID(streamingID);
+			texture.SetPlaceholder(false);
+
+			mStreamedTextures.push_back({ &texture, result.filePath, std::move(mipChain) });
+
+			return true;
+		}
+
+		// ID 자리는 비워두고 아래에서 통째로 다시 시도
+		mTextureStreamer.Unregister(streamingID);
+
+		mStreamedTextures.push_back({ nullptr, std::string(), TextureMipChain() });
+	}
+
+	// 읽지 못하는 형식은 스트리밍 없이 통째로 올림
+	const RHI::TextureHandle textureHandle = mDevice.CreateTextureFromFile(result.filePath.c_str());
+
+	if (!textureHandle.IsValid())
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "CreateTextureFromFile");
+
+		return false;
+	}
+
+	const RHI::TextureDesc textureDesc = mDevice.GetTextureDesc(textureHandle);
+
+	texture.SetHandle(textureHandle);
+	texture.SetSize(textureDesc.width, textureDesc.height);
+	texture.SetPlaceholder(false);
+
+	return true;
+}
+
+bool TextureManager::releaseTextureShare(Texture* const pTexture)
+{
+#define SHARE_MAP_ITER std::unordered_map<Texture*, TextureShare>::iterator
+
+	SHARE_MAP_ITER shareIter = mTextureShares.find(pTexture);
+
+	// 내용을 모르는 텍스처는 공유되지 않음
+	if (shareIter == mTextureShares.end())
+	{
+		return true;
+	}
+
+	ASSERT(shareIter->second.refCount > 0);
+
+	--shareIter->second.refCount;
+
+	if (shareIter->second.refCount > 0)
+	{
+		return false;
+	}
+
+#define CONTENT_MAP_ITER std::unordered_map<uint64_t, Texture*>::iterator
+
+	CONTENT_MAP_ITER contentIter = mTexturesByContent.find(shareIter->second.contentHash.low);
+
+	// 해시는 같은데 크기가 달라 따로 만든 텍스처면 내용 표에 없음
+	if (contentIter != mTexturesByContent.end() && contentIter->second == pTexture)
+	{
+		mTexturesByContent.erase(contentIter);
+	}
+
+#undef CONTENT_MAP_ITER
+
+	mTextureShares.erase(shareIter);
+
+#undef SHARE_MAP_ITER
+
+	return true;
+}
+
+RHI::TextureHandle TextureManager::createTexture(const TextureMipChain& mipChain)
+{
+	std::vector<RHI::SubresourceData> subresources;
+	GetTextureMipSubresources(mipChain, subresources);
+
+	const uint32_t topWidth = mipChain.width >> mipChain.topMip;
+	const uint32_t topHeight = mipChain.height >> mipChain.topMip;
+
+	RHI::TextureDesc textureDesc = {};
+	textureDesc.width = topWidth > 0 ? topWidth : 1;
+	textureDesc.height = topHeight > 0 ? topHeight : 1;
+	textureDesc.mipLevels = mipChain.mipCount - mipChain.topMip;
+	textureDesc.arraySize = 1;
+	textureDesc.sampleCount = 1;
+	textureDesc.bindFlags = RHI::BIND_SHADER_RESOURCE;
+	textureDesc.format = mipChain.format;
+	textureDesc.usage = RHI::EUsage::IMMUTABLE;
+
+	return mDevice.CreateTexture(textureDesc, subresources.data());
+}
+
+void TextureManager::submitLoad(const TextureStreamer::Request& request)
+{
+	const StreamedTexture& streamedTexture = mStreamedTextures[request.textureID];
+	ASSERT(streamedTexture.pTexture != nullptr);
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		++mInFlightLoadCount;
+	}
+
+	const TextureMipChain& baseMipChain = streamedTexture.baseMipChain;
+
+	std::function<void()> job = [this, request, path = streamedTexture.filePath, width = baseMipChain.width, height = baseMipChain.height, mipCount = baseMipChain.mipCount]()
+		{
+			LoadResult result;
+			result.streamingID = request.textureID;
+
+			// 파일이 바뀌어서 크기가 다르면 실패로 처리
+			result.bSucceeded = TryLoadTextureMips(path.c_str(), result.mipChain)
+				&& result.mipChain.width == width
+				&& result.mipChain.height == height
+				&& result.mipChain.mipCount == mipCount;
+
+			if (result.bSucceeded)
+			{
+				TrimTextureMips(result.mipChain, request.topMip);
+			}
+
+			std::lock_guard<std::mutex> lock(mLoadMutex);
+
+			mCompletedLoads.push_back(std::move(result));
+			--mInFlightLoadCount;
+
+			mLoadCondition.notify_all();
+		};
+
+	if (JobSystem::IsInitialized())
+	{
+		JobSystem::GetInstance().Submit(std::move(job));
+	}
+	else
+	{
+		job();
+	}
+}
+
+void TextureManager::Initialize(RHI::Device& device)
 {
 	ASSERT(spInstance == nullptr);
 
@@ -1,25 +1,82 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
 
-#include <d3d11.h>
+#include <string>
 
 #include "Core/Assert.h"
+#include "Core/HashHelper.h"
 #include "UI/IEditorUIDrawable.h"
+#include "Renderer/RHI/RHIDevice.h"
+#include "TextureStreamer.h"
+#include "TextureLoader.h"
+#include "TextureCooker.h"
+#include "TextureAtlas.h"
 
 class Texture;
 
+// LoadTexture마다 경로의 참조가 하나 늘고 ReleaseTexture로 놓음
+// 참조가 없는 경로는 LRU에 두었다가 상주 크기가 스트리밍 예산을 넘으면 오래된 것부터 해제
 class TextureManager final : public IEditorUIDrawable
 {
 public:
-	void LoadTexture(const std::string& path);
+	struct DecodeBenchmark
+	{
+		uint32_t threadCount;
+		float timeMs;
+		float megapixelsPerSecond;
+	};
+
+public:
+	// 대체 텍스처를 가리키는 Texture를 바로 돌려주고 디코딩은 백그라운드에서 함
+	// 이미 불러오는 중인 경로는 새로 요청하지 않고 같은 Texture를 돌려줌
+	Texture* LoadTexture(const std::string& path);
 	Texture* GetTextureOrNull(const std::string& path) const;
-	void UnloadTexture(const std::string& path);
+
+	// 참조가 없어지면 LRU로 옮김, 다시 불러오면 LRU에서 꺼내 씀
+	void ReleaseTexture(const std::string& path);
+
+	// 프레임 경계에서 호출, 예산을 넘었으면 참조 없는 텍스처를 오래된 것부터 해제
+	void UpdateResidency();
+
+	// 프레임 경계에서 호출, 디코딩이 끝난 텍스처를 만들어 핸들을 교체
+	// 디코딩한 픽셀이 이미 불러온 텍스처와 같으면 그 Texture를 같이 가리킴
+	void ApplyTextureLoads();
+
+	// 불러온 텍스처를 1개부터 워커 수 + 1개 스레드로 다시 디코딩해 처리량을 잼, GPU는 쓰지 않음
+	void MeasureDecodeThroughput();
+
+	inline const std::vector<DecodeBenchmark>& GetDecodeBenchmarks() const
+	{
+		return mDecodeBenchmarks;
+	}
+
+	// 불러온 작은 RGBA8 텍스처를 텍스처 배열 아틀라스로 다시 묶음, 이전 아틀라스는 버림
+	void PackSmallTextures();
+
+	// 아틀라스에 담긴 텍스처면 배열 핸들과 영역을 돌려줌
+	bool TryGetAtlasRegion(const std::string& path, TextureAtlasRegion& outRegion, RHI::TextureHandle& outTextureArray) const;
+
+	// 불러온 텍스처를 텍스처 단위로 병렬 쿠킹, 결과는 다음에 불러올 때부터 쓰임
+	void CookLoadedTextures(const ETextureCompression eCompression, const EMipFilter eMipFilter);
+
+	// 컬링에서 보인 물체마다 화면에 차지하는 픽셀 크기를 알림
+	void RequestTextureDetail(const std::string& path, const float screenPixels);
+
+	// 프레임마다 한 번, 요청을 모은 뒤 호출
+	// 끝난 불러오기를 교체하고 예산에 맞춰 내린 뒤 새 불러오기를 백그라운드로 보냄
+	void UpdateStreaming();
 
 	virtual void DrawEditorUI() override;
 
 	// static
-	static void Initialize(ID3D11Device& device);
+	static void Initialize(RHI::Device& device);
 
 	static TextureManager& GetInstance()
 	{
@@ -36,14 +93,146 @@ public:
 private:
 	static TextureManager* spInstance;
 
-	ID3D11Device& mDevice;
+	RHI::Device& mDevice;
 
+	// 내용이 같으면 여러 경로가 같은 Texture를 가리킴
 	std::unordered_map<std::string, Texture*> mTextureMap;
 
+	// 불러오는 동안 빌려주는 텍스처
+	Texture* mpPlaceholderTexture;
+
+	// streaming
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct LoadResult
+	{
+		uint32_t streamingID;
+		bool bSucceeded;
+		TextureMipChain mipChain;
+	};
+
+	struct DecodeResult
+	{
+		std::string path;
+
+		// 쿠킹된 파일이 있으면 그 경로
+		std::string filePath;
+
+		bool bSucceeded;
+		TextureMipChain mipChain;
+
+		// 디코딩한 밉 체인의 해시, 실패하면 쓰지 않음
+		Hash128 contentHash;
+
+		std::chrono::steady_clock::time_point requestTime;
+	};
+
+	struct TextureShare
+	{
+		Hash128 contentHash;
+
+		// 이 텍스처를 가리키는 경로 수
+		uint32_t refCount;
+	};
+
+	struct TextureResidency
+	{
+		// LoadTexture 수 - ReleaseTexture 수, 0이면 lruIter가 유효
+		uint32_t refCount;
+		std::list<std::string>::iterator lruIter;
+	};
+
+	struct StreamedTexture
+	{
+		// 해제된 자리는 nullptr
+		Texture* pTexture;
+
+		// 쿠킹된 파일이 있으면 그 경로
+		std::string filePath;
+
+		// 내릴 때 파일을 다시 읽지 않도록 기본 밉을 CPU에 남겨둠
+		TextureMipChain baseMipChain;
+	};
+
+	struct CookResult
+	{
+		std::string path;
+		bool bSucceeded;
+		TextureCookStats stats;
+	};
+#pragma warning(pop)
+
+	TextureStreamer mTextureStreamer;
+
+	// 스트리밍 ID로 인덱싱
+	std::vector<StreamedTexture> mStreamedTextures;
+
+	std::vector<TextureStreamer::Request> mLoadRequests;
+	std::vector<TextureStreamer::Request> mEvictRequests;
+
+	std::mutex mLoadMutex;
+	std::condition_variable mLoadCondition;
+	std::vector<LoadResult> mCompletedLoads;
+	uint32_t mInFlightLoadCount;
+
+	// async loading
+	std::unordered_set<std::string> mDecodingPaths;
+	std::vector<DecodeResult> mCompletedDecodes;
+
+	uint32_t mLoadedCount;
+	uint32_t mLoadFailCount;
+	uint32_t mCoalescedLoadCount;
+	float mLastLoadLatencyMs;
+
+	// dedup, 키는 해시의 low이고 찾은 뒤 TextureShare의 128비트 전체를 비교함
+	std::unordered_map<uint64_t, Texture*> mTexturesByContent;
+	std::unordered_map<Texture*, TextureShare> mTextureShares;
+
+	uint32_t mDedupLookupCount;
+	uint32_t mDedupHitCount;
+	uint64_t mDedupSavedBytes;
+
+	// residency, 앞쪽이 가장 오래전에 놓인 경로
+	std::unordered_map<std::string, TextureResidency> mTextureResidency;
+	std::list<std::string> mUnusedPaths;
+	uint32_t mEvictCount;
+
+	std::vector<DecodeBenchmark> mDecodeBenchmarks;
+
+	uint64_t mFrameIndex;
+	int mBudgetMB;
+	float mStreamingTimeMs;
+
+	// atlas
+	std::vector<RHI::TextureHandle> mAtlasArrays;
+	std::unordered_map<std::string, TextureAtlasRegion> mAtlasRegions;
+	uint32_t mAtlasSliceCount;
+	float mAtlasOccupancy;
+	float mAtlasPackTimeMs;
+
+	// cooking
+	ETextureCompression mCookCompression;
+	EMipFilter mCookMipFilter;
+	float mCookTimeMs;
+	std::vector<CookResult> mCookResults;
+
 private:
-	TextureManager(ID3D11Device& device);
+	TextureManager(RHI::Device& device);
 	~TextureManager();
 
+	RHI::TextureHandle createTexture(const TextureMipChain& mipChain);
+
+	// 디코딩한 밉 체인이 있으면 스트리밍에 등록하고 기본 밉만 올림
+	// 없으면 디바이스가 파일을 직접 읽음
+	bool tryApplyLoadedTexture(Texture& texture, DecodeResult& result);
+
+	// 같이 쓰는 경로가 남아 있으면 수만 줄이고 false, 마지막이면 공유 기록을 지우고 true
+	bool releaseTextureShare(Texture* const pTexture);
+
+	// 대체 텍스처는 해제하지 않음, 다른 경로가 같이 쓰는 텍스처는 남겨 둠
+	void unloadTexture(const std::string& path);
+	void submitLoad(const TextureStreamer::Request& request);
+
 private:
 	TextureManager(const TextureManager& other) = delete;
 	TextureManager(TextureManager&& other) = delete;
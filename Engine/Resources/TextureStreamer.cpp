@@ -0,0 +1,372 @@
+#include "TextureStreamer.h"
+
+#include <algorithm>
+
+enum
+{
+	DEFAULT_BUFFER_SIZE = 64
+};
+
+TextureStreamer::TextureStreamer(const uint64_t budgetBytes, const uint32_t maxPendingCount)
+	: mEntries()
+	, mMaxPendingCount(maxPendingCount)
+	, mLoadCandidates()
+	, mEvictCandidates()
+	, mStats{}
+{
+	ASSERT(maxPendingCount > 0);
+
+	mEntries.reserve(DEFAULT_BUFFER_SIZE);
+	mLoadCandidates.reserve(DEFAULT_BUFFER_SIZE);
+	mEvictCandidates.reserve(DEFAULT_BUFFER_SIZE);
+
+	mStats.budgetBytes = budgetBytes;
+}
+
+uint32_t TextureStreamer::Register(const uint32_t width, const uint32_t height, const uint32_t mipCount, const RHI::EFormat format)
+{
+	ASSERT(width > 0 && height > 0);
+	ASSERT(mipCount > 0);
+	ASSERT(format != RHI::EFormat::UNKNOWN);
+
+	Entry entry;
+	entry.width = width;
+	entry.height = height;
+	entry.mipCount = mipCount;
+	entry.format = format;
+	entry.baseMip = ComputeBaseMip(width, height, mipCount);
+	entry.residentMip = entry.baseMip;
+	entry.wantedMip = entry.baseMip;
+	entry.pendingMip = NO_PENDING_MIP;
+	entry.lastRequestFrame = 0;
+	entry.screenPixels = 0.f;
+	entry.bRegistered = true;
+
+	// 기본 밉은 예산과 상관없이 올라감
+	const uint64_t baseBytes = getBytes(entry, entry.baseMip);
+
+	mStats.residentBytes += baseBytes;
+	mStats.committedBytes += baseBytes;
+	++mStats.textureCount;
+
+	mEntries.push_back(entry);
+
+	return static_cast<uint32_t>(mEntries.size() - 1);
+}
+
+void TextureStreamer::Unregister(const uint32_t textureID)
+{
+	ASSERT(textureID < mEntries.size());
+
+	Entry& entry = mEntries[textureID];
+	ASSERT(entry.bRegistered);
+
+	const uint64_t residentBytes = getBytes(entry, entry.residentMip);
+
+	mStats.residentBytes -= residentBytes;
+	mStats.committedBytes -= residentBytes;
+
+	if (entry.pendingMip != NO_PENDING_MIP)
+	{
+		mStats.committedBytes -= getBytes(entry, entry.pendingMip) - residentBytes;
+		--mStats.pendingCount;
+	}
+
+	--mStats.textureCount;
+
+	entry.bRegistered = false;
+}
+
+void TextureStreamer::RequestScreenSize(const uint32_t textureID, const float screenPixels, const uint64_t frame)
+{
+	ASSERT(textureID < mEntries.size());
+
+	Entry& entry = mEntries[textureID];
+	ASSERT(entry.bRegistered);
+
+	if (entry.lastRequestFrame != frame || screenPixels > entry.screenPixels)
+	{
+		entry.screenPixels = screenPixels;
+	}
+
+	entry.lastRequestFrame = frame;
+
+	// 화면 크기보다 작아지지 않는 가장 거친 밉
+	const uint32_t maxSize = entry.width > entry.height ? entry.width : entry.height;
+
+	uint32_t wantedMip = 0;
+
+	while (wantedMip < entry.baseMip && static_cast<float>(maxSize >> (wantedMip + 1)) >= entry.screenPixels)
+	{
+		++wantedMip;
+	}
+
+	entry.wantedMip = wantedMip;
+}
+
+void TextureStreamer::Update(const uint64_t frame, std::vector<Request>& outLoads, std::vector<Request>& outEvictions)
+{
+	outLoads.clear();
+	outEvictions.clear();
+
+	mLoadCandidates.clear();
+
+	for (uint32_t i = 0; i < mEntries.size(); ++i)
+	{
+		Entry& entry = mEntries[i];
+
+		if (!entry.bRegistered)
+		{
+			continue;
+		}
+
+		// 오래 안 보인 텍스처는 기본 밉만 원함
+		if (frame - entry.lastRequestFrame > STALE_FRAME_COUNT)
+		{
+			entry.wantedMip = entry.baseMip;
+			entry.screenPixels = 0.f;
+		}
+
+		// 이번 프레임에 보인 것만 불러와서 내릴 후보와 겹치지 않게 함
+		if (entry.lastRequestFrame == frame && entry.pendingMip == NO_PENDING_MIP && entry.wantedMip < entry.residentMip)
+		{
+			mLoadCandidates.push_back(i);
+		}
+	}
+
+	// 모자란 밉이 많은 것, 화면에서 큰 것부터
+	std::sort(mLoadCandidates.begin(), mLoadCandidates.end(), [this](const uint32_t lhs, const uint32_t rhs)
+		{
+			const Entry& a = mEntries[lhs];
+			const Entry& b = mEntries[rhs];
+
+			const uint32_t deficitA = a.residentMip - a.wantedMip;
+			const uint32_t deficitB = b.residentMip - b.wantedMip;
+
+			if (deficitA != deficitB)
+			{
+				return deficitA > deficitB;
+			}
+
+			return a.screenPixels > b.screenPixels;
+		});
+
+	for (const uint32_t textureID : mLoadCandidates)
+	{
+		if (mStats.pendingCount >= mMaxPendingCount)
+		{
+			break;
+		}
+
+		Entry& entry = mEntries[textureID];
+
+		const uint64_t residentBytes = getBytes(entry, entry.residentMip);
+
+		// 원하는 밉이 안 들어가면 한 단계씩 거칠게 해서 들어가는 만큼만
+		uint32_t topMip = entry.wantedMip;
+
+		while (topMip < entry.residentMip)
+		{
+			const uint64_t extraBytes = getBytes(entry, topMip) - residentBytes;
+
+			if (mStats.committedBytes + extraBytes <= mStats.budgetBytes
+				|| tryMakeRoom(frame, mStats.committedBytes + extraBytes - mStats.budgetBytes, textureID, outEvictions))
+			{
+				break;
+			}
+
+			++topMip;
+		}
+
+		if (topMip == entry.residentMip)
+		{
+			++mStats.deferredCount;
+
+			continue;
+		}
+
+		entry.pendingMip = topMip;
+
+		mStats.committedBytes += getBytes(entry, topMip) - residentBytes;
+		++mStats.pendingCount;
+
+		outLoads.push_back({ textureID, topMip });
+	}
+
+	// 예산이 줄어든 경우
+	if (mStats.committedBytes > mStats.budgetBytes)
+	{
+		tryMakeRoom(frame, mStats.committedBytes - mStats.budgetBytes, INVALID_TEXTURE_ID, outEvictions);
+	}
+}
+
+void TextureStreamer::CompleteLoad(const uint32_t textureID, const bool bSucceeded)
+{
+	ASSERT(textureID < mEntries.size());
+
+	Entry& entry = mEntries[textureID];
+
+	// 불러오는 동안 해제된 텍스처
+	if (!entry.bRegistered)
+	{
+		return;
+	}
+
+	ASSERT(entry.pendingMip != NO_PENDING_MIP);
+
+	const uint64_t residentBytes = getBytes(entry, entry.residentMip);
+	const uint64_t extraBytes = getBytes(entry, entry.pendingMip) - residentBytes;
+
+	if (bSucceeded)
+	{
+		entry.residentMip = entry.pendingMip;
+
+		mStats.residentBytes += extraBytes;
+		++mStats.loadCount;
+	}
+	else
+	{
+		mStats.committedBytes -= extraBytes;
+	}
+
+	entry.pendingMip = NO_PENDING_MIP;
+	--mStats.pendingCount;
+}
+
+void TextureStreamer::SetBudgetBytes(const uint64_t budgetBytes)
+{
+	mStats.budgetBytes = budgetBytes;
+}
+
+uint32_t TextureStreamer::GetBaseMip(const uint32_t textureID) const
+{
+	ASSERT(textureID < mEntries.size());
+
+	return mEntries[textureID].baseMip;
+}
+
+uint32_t TextureStreamer::GetResidentMip(const uint32_t textureID) const
+{
+	ASSERT(textureID < mEntries.size());
+
+	return mEntries[textureID].residentMip;
+}
+
+uint32_t TextureStreamer::GetWantedMip(const uint32_t textureID) const
+{
+	ASSERT(textureID < mEntries.size());
+
+	return mEntries[textureID].wantedMip;
+}
+
+bool TextureStreamer::IsPending(const uint32_t textureID) const
+{
+	ASSERT(textureID < mEntries.size());
+
+	return mEntries[textureID].pendingMip != NO_PENDING_MIP;
+}
+
+uint64_t TextureStreamer::GetMipChainBytes(
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t mipCount,
+	const RHI::EFormat format,
+	const uint32_t topMip
+)
+{
+	uint64_t byteSize = 0;
+
+	for (uint32_t mip = topMip; mip < mipCount; ++mip)
+	{
+		const uint32_t mipWidth = (width >> mip) > 0 ? (width >> mip) : 1;
+		const uint32_t mipHeight = (height >> mip) > 0 ? (height >> mip) : 1;
+
+		byteSize += RHI::GetSurfaceByteSize(format, mipWidth, mipHeight);
+	}
+
+	return byteSize;
+}
+
+uint32_t TextureStreamer::ComputeBaseMip(const uint32_t width, const uint32_t height, const uint32_t mipCount)
+{
+	ASSERT(mipCount > 0);
+
+	const uint32_t maxSize = width > height ? width : height;
+
+	uint32_t baseMip = 0;
+
+	while (baseMip + 1 < mipCount && (maxSize >> baseMip) > BASE_MIP_SIZE)
+	{
+		++baseMip;
+	}
+
+	return baseMip;
+}
+
+uint64_t TextureStreamer::getBytes(const Entry& entry, const uint32_t topMip) const
+{
+	return GetMipChainBytes(entry.width, entry.height, entry.mipCount, entry.format, topMip);
+}
+
+bool TextureStreamer::tryMakeRoom(const uint64_t frame, const uint64_t byteSize, const uint32_t excludedID, std::vector<Request>& outEvictions)
+{
+	// 이번 프레임에 보인 것과 불러오는 중인 것은 건드리지 않음
+	mEvictCandidates.clear();
+
+	uint64_t freeableBytes = 0;
+
+	for (uint32_t i = 0; i < mEntries.size(); ++i)
+	{
+		const Entry& entry = mEntries[i];
+
+		if (!entry.bRegistered
+			|| i == excludedID
+			|| entry.pendingMip != NO_PENDING_MIP
+			|| entry.residentMip >= entry.baseMip
+			|| entry.lastRequestFrame >= frame)
+		{
+			continue;
+		}
+
+		mEvictCandidates.push_back(i);
+		freeableBytes += getBytes(entry, entry.residentMip) - getBytes(entry, entry.baseMip);
+	}
+
+	// 다 내려도 모자라면 아무것도 내리지 않음
+	if (freeableBytes < byteSize)
+	{
+		return false;
+	}
+
+	// LRU
+	std::sort(mEvictCandidates.begin(), mEvictCandidates.end(), [this](const uint32_t lhs, const uint32_t rhs)
+		{
+			return mEntries[lhs].lastRequestFrame < mEntries[rhs].lastRequestFrame;
+		});
+
+	uint64_t freedBytes = 0;
+
+	for (const uint32_t textureID : mEvictCandidates)
+	{
+		if (freedBytes >= byteSize)
+		{
+			break;
+		}
+
+		Entry& entry = mEntries[textureID];
+
+		const uint64_t evictedBytes = getBytes(entry, entry.residentMip) - getBytes(entry, entry.baseMip);
+
+		entry.residentMip = entry.baseMip;
+
+		mStats.residentBytes -= evictedBytes;
+		mStats.committedBytes -= evictedBytes;
+		++mStats.evictCount;
+
+		freedBytes += evictedBytes;
+
+		outEvictions.push_back({ textureID, entry.baseMip });
+	}
+
+	return true;
+}
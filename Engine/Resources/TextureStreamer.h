@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Core/Assert.h"
+#include "Renderer/RHI/RHITypes.h"
+
+// 텍스처마다 어느 밉까지 올라가 있는지와 다음에 무엇을 불러오고 내릴지만 결정
+// 디바이스와 파일을 모르므로 헤드리스로 검증할 수 있음
+// 밉 인덱스는 작을수록 정밀함, "topMip"은 올라가 있는 가장 정밀한 밉
+class TextureStreamer final
+{
+public:
+	enum
+	{
+		INVALID_TEXTURE_ID = 0xFFFFFFFF,
+
+		// 이 크기 이하의 밉은 항상 상주
+		BASE_MIP_SIZE = 64,
+
+		// 이만큼 요청이 없으면 오래된 것으로 보고 먼저 내림
+		STALE_FRAME_COUNT = 60
+	};
+
+	struct Request
+	{
+		uint32_t textureID;
+		uint32_t topMip;
+	};
+
+	struct Stats
+	{
+		uint64_t budgetBytes;
+		uint64_t residentBytes;
+
+		// 불러오는 중인 밉까지 더한 값, 예산은 이 값으로 지킴
+		uint64_t committedBytes;
+
+		uint32_t textureCount;
+		uint32_t pendingCount;
+		uint32_t loadCount;
+		uint32_t evictCount;
+
+		// 예산이 모자라서 미룬 요청
+		uint32_t deferredCount;
+	};
+
+public:
+	TextureStreamer(const uint64_t budgetBytes, const uint32_t maxPendingCount);
+	~TextureStreamer() = default;
+
+	// 처음에는 기본 밉만 올라가 있다고 봄
+	uint32_t Register(const uint32_t width, const uint32_t height, const uint32_t mipCount, const RHI::EFormat format);
+	void Unregister(const uint32_t textureID);
+
+	// 컬링 중에 보이는 물체마다 호출, 한 프레임에 여러 번 오면 가장 큰 크기를 씀
+	void RequestScreenSize(const uint32_t textureID, const float screenPixels, const uint64_t frame);
+
+	// 프레임마다 한 번, 새로 불러올 밉과 기본 밉으로 내릴 텍스처를 채움
+	// 내리는 것은 호출한 쪽이 바로 반영해야 함
+	void Update(const uint64_t frame, std::vector<Request>& outLoads, std::vector<Request>& outEvictions);
+
+	// 불러오기가 끝났을 때 호출, 실패하면 요청 전 상태로 돌아감
+	void CompleteLoad(const uint32_t textureID, const bool bSucceeded);
+
+	void SetBudgetBytes(const uint64_t budgetBytes);
+
+	uint32_t GetBaseMip(const uint32_t textureID) const;
+	uint32_t GetResidentMip(const uint32_t textureID) const;
+	uint32_t GetWantedMip(const uint32_t textureID) const;
+	bool IsPending(const uint32_t textureID) const;
+
+	inline const Stats& GetStats() const
+	{
+		return mStats;
+	}
+
+	// topMip부터 가장 작은 밉까지의 크기
+	static uint64_t GetMipChainBytes(
+		const uint32_t width,
+		const uint32_t height,
+		const uint32_t mipCount,
+		const RHI::EFormat format,
+		const uint32_t topMip
+	);
+
+	static uint32_t ComputeBaseMip(const uint32_t width, const uint32_t height, const uint32_t mipCount);
+
+private:
+	enum
+	{
+		NO_PENDING_MIP = 0xFFFFFFFF
+	};
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+	struct Entry
+	{
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipCount;
+		RHI::EFormat format;
+
+		uint32_t baseMip;
+		uint32_t residentMip;
+		uint32_t wantedMip;
+		uint32_t pendingMip;
+
+		uint64_t lastRequestFrame;
+		float screenPixels;
+
+		bool bRegistered;
+	};
+#pragma warning(pop)
+
+private:
+	// 불러오는 중인 결과가 다른 텍스처에 적용되지 않도록 ID는 다시 쓰지 않음
+	std::vector<Entry> mEntries;
+
+	uint32_t mMaxPendingCount;
+
+	// Update에서 매번 다시 채우는 작업 목록
+	std::vector<uint32_t> mLoadCandidates;
+	std::vector<uint32_t> mEvictCandidates;
+
+	Stats mStats;
+
+private:
+	uint64_t getBytes(const Entry& entry, const uint32_t topMip) const;
+	bool tryMakeRoom(const uint64_t frame, const uint64_t byteSize, const uint32_t excludedID, std::vector<Request>& outEvictions);
+
+private:
+	TextureStreamer(const TextureStreamer& other) = delete;
+	TextureStreamer(TextureStreamer&& other) = delete;
+	TextureStreamer& operator=(const TextureStreamer& other) = delete;
+	TextureStreamer& operator=(TextureStreamer&& other) = delete;
+};
@@ -0,0 +1,259 @@
+#include "VertexQuantizer.h"
+
+#include <cfloat>
+#include <cmath>
+
+#ifdef _WIN32
+#include <DirectXPackedVector.h>
+#endif
+
+#include "Core/Assert.h"
+
+enum
+{
+	UNORM16_MAX = 0xFFFF,
+	SNORM16_MAX = 0x7FFF
+};
+
+static uint16_t QuantizeUnorm16(const float value)
+{
+	const float clamped = value < 0.f ? 0.f : (value > 1.f ? 1.f : value);
+
+	return static_cast<uint16_t>(clamped * static_cast<float>(UNORM16_MAX) + 0.5f);
+}
+
+static float DequantizeUnorm16(const uint16_t value)
+{
+	return static_cast<float>(value) / static_cast<float>(UNORM16_MAX);
+}
+
+static int16_t ClampSnorm16(const float value)
+{
+	constexpr float MAX_VALUE = static_cast<float>(SNORM16_MAX);
+
+	const float clamped = value < -MAX_VALUE ? -MAX_VALUE : (value > MAX_VALUE ? MAX_VALUE : value);
+
+	return static_cast<int16_t>(clamped);
+}
+
+// D3D 규칙대로 -32768도 -1로 읽음
+static float DequantizeSnorm16(const int16_t value)
+{
+	const float decoded = static_cast<float>(value) / static_cast<float>(SNORM16_MAX);
+
+	return decoded < -1.f ? -1.f : decoded;
+}
+
+static float SignNotZero(const float value)
+{
+	return value >= 0.f ? 1.f : -1.f;
+}
+
+// 셰이더의 GetVertexNormal과 같은 복원
+static Vector3 DecodeOctahedral(const float x, const float y)
+{
+	Vector3 normal(x, y, 1.f - std::fabs(x) - std::fabs(y));
+
+	const float fold = normal.z < 0.f ? -normal.z : 0.f;
+	normal.x += normal.x >= 0.f ? -fold : fold;
+	normal.y += normal.y >= 0.f ? -fold : fold;
+
+	normal.Normalize();
+
+	return normal;
+}
+
+// 8면체에 투영한 뒤 내림/올림 네 조합 중 되돌렸을 때 가장 가까운 값을 고름
+static void EncodeOctahedral(const Vector3& normal, int16_t* const pOutEncoded)
+{
+	ASSERT(pOutEncoded != nullptr);
+
+	Vector3 unit = normal;
+	const float length = unit.Length();
+	if (length <= 0.f)
+	{
+		pOutEncoded[0] = 0;
+		pOutEncoded[1] = 0;
+
+		return;
+	}
+
+	unit /= length;
+
+	const float invL1 = 1.f / (std::fabs(unit.x) + std::fabs(unit.y) + std::fabs(unit.z));
+
+	float x = unit.x * invL1;
+	float y = unit.y * invL1;
+
+	if (unit.z < 0.f)
+	{
+		const float foldedX = (1.f - std::fabs(y)) * SignNotZero(x);
+		const float foldedY = (1.f - std::fabs(x)) * SignNotZero(y);
+
+		x = foldedX;
+		y = foldedY;
+	}
+
+	const float scaledX = x * static_cast<float>(SNORM16_MAX);
+	const float scaledY = y * static_cast<float>(SNORM16_MAX);
+
+	float bestDistanceSquared = FLT_MAX;
+
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		const int16_t candidateX = ClampSnorm16((i & 1) != 0 ? std::ceil(scaledX) : std::floor(scaledX));
+		const int16_t candidateY = ClampSnorm16((i & 2) != 0 ? std::ceil(scaledY) : std::floor(scaledY));
+
+		const Vector3 decoded = DecodeOctahedral(DequantizeSnorm16(candidateX), DequantizeSnorm16(candidateY));
+
+		// 거의 같은 방향끼리의 내적은 float로 구별되지 않아 차이의 길이로 비교
+		const float distanceSquared = (decoded - unit).LengthSquared();
+		if (distanceSquared < bestDistanceSquared)
+		{
+			bestDistanceSquared = distanceSquared;
+
+			pOutEncoded[0] = candidateX;
+			pOutEncoded[1] = candidateY;
+		}
+	}
+}
+
+void QuantizeVertices(
+	const std::vector<Vertex::PosNormalUV>& vertices,
+	const Vector3& boundsMin,
+	const Vector3& boundsMax,
+	std::vector<Vertex::PosNormalUVQuantized>& outVertices,
+	Vector3& outOffset,
+	Vector3& outScale
+)
+{
+	outOffset = boundsMin;
+	outScale = boundsMax - boundsMin;
+
+	// 두께가 없는 축은 모두 0으로 두고 오프셋만으로 복원
+	const Vector3 invScale(
+		outScale.x > 0.f ? 1.f / outScale.x : 0.f,
+		outScale.y > 0.f ? 1.f / outScale.y : 0.f,
+		outScale.z > 0.f ? 1.f / outScale.z : 0.f
+	);
+
+	outVertices.resize(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex::PosNormalUV& vertex = vertices[i];
+		Vertex::PosNormalUVQuantized& quantized = outVertices[i];
+
+		const Vector3 normalized = (vertex.pos - outOffset) * invScale;
+
+		quantized.pos[0] = QuantizeUnorm16(normalized.x);
+		quantized.pos[1] = QuantizeUnorm16(normalized.y);
+		quantized.pos[2] = QuantizeUnorm16(normalized.z);
+		quantized.pos[3] = 0;
+
+		EncodeOctahedral(vertex.normal, quantized.normal);
+
+		quantized.uv[0] = DirectX::PackedVector::XMConvertFloatToHalf(vertex.uv.x);
+		quantized.uv[1] = DirectX::PackedVector::XMConvertFloatToHalf(vertex.uv.y);
+	}
+}
+
+Vertex::PosNormalUV DequantizeVertex(const Vertex::PosNormalUVQuantized& vertex, const Vector3& offset, const Vector3& scale)
+{
+	Vertex::PosNormalUV decoded;
+
+	decoded.pos = Vector3(DequantizeUnorm16(vertex.pos[0]), DequantizeUnorm16(vertex.pos[1]), DequantizeUnorm16(vertex.pos[2])) * scale + offset;
+
+	decoded.normal = DecodeOctahedral(DequantizeSnorm16(vertex.normal[0]), DequantizeSnorm16(vertex.normal[1]));
+
+	decoded.uv.x = DirectX::PackedVector::XMConvertHalfToFloat(vertex.uv[0]);
+	decoded.uv.y = DirectX::PackedVector::XMConvertHalfToFloat(vertex.uv[1]);
+
+	return decoded;
+}
+
+void MeasureQuantizationError(
+	const std::vector<Vertex::PosNormalUV>& vertices,
+	const std::vector<Vertex::PosNormalUVQuantized>& quantizedVertices,
+	const Vector3& offset,
+	const Vector3& scale,
+	VertexQuantizationError& outError
+)
+{
+	ASSERT(vertices.size() == quantizedVertices.size());
+
+	constexpr float RADIAN_TO_DEGREE = 57.2957795f;
+
+	outError = {};
+
+	const float diagonal = scale.Length();
+	const float invDiagonal = diagonal > 0.f ? 1.f / diagonal : 0.f;
+
+	float maxNormalDot = 1.f;
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex::PosNormalUV& source = vertices[i];
+		const Vertex::PosNormalUV decoded = DequantizeVertex(quantizedVertices[i], offset, scale);
+
+		const float positionError = Vector3::Distance(source.pos, decoded.pos) * invDiagonal;
+		if (positionError > outError.maxPositionError)
+		{
+			outError.maxPositionError = positionError;
+		}
+
+		Vector3 sourceNormal = source.normal;
+		if (sourceNormal.LengthSquared() > 0.f)
+		{
+			sourceNormal.Normalize();
+
+			const float dot = sourceNormal.Dot(decoded.normal);
+			if (dot < maxNormalDot)
+			{
+				maxNormalDot = dot;
+			}
+		}
+
+		const float uvErrorU = std::fabs(source.uv.x - decoded.uv.x);
+		const float uvErrorV = std::fabs(source.uv.y - decoded.uv.y);
+		const float uvError = uvErrorU > uvErrorV ? uvErrorU : uvErrorV;
+		if (uvError > outError.maxUVError)
+		{
+			outError.maxUVError = uvError;
+		}
+	}
+
+	maxNormalDot = maxNormalDot < -1.f ? -1.f : (maxNormalDot > 1.f ? 1.f : maxNormalDot);
+
+	outError.maxNormalErrorDegrees = std::acos(maxNormalDot) * RADIAN_TO_DEGREE;
+}
+
+void AccumulateQuantizationError(VertexQuantizationError& inOutMax, const VertexQuantizationError& error)
+{
+	if (error.maxPositionError > inOutMax.maxPositionError)
+	{
+		inOutMax.maxPositionError = error.maxPositionError;
+	}
+
+	if (error.maxNormalErrorDegrees > inOutMax.maxNormalErrorDegrees)
+	{
+		inOutMax.maxNormalErrorDegrees = error.maxNormalErrorDegrees;
+	}
+
+	if (error.maxUVError > inOutMax.maxUVError)
+	{
+		inOutMax.maxUVError = error.maxUVError;
+	}
+}
+
+bool IsQuantizationErrorAcceptable(const VertexQuantizationError& error)
+{
+	// 범위 대각선의 1/10000, 0.1도, 2048 텍스처의 한 텍셀
+	constexpr float MAX_POSITION_ERROR = 1e-4f;
+	constexpr float MAX_NORMAL_ERROR_DEGREES = 0.1f;
+	constexpr float MAX_UV_ERROR = 1.f / 2048.f;
+
+	return error.maxPositionError <= MAX_POSITION_ERROR
+		&& error.maxNormalErrorDegrees <= MAX_NORMAL_ERROR_DEGREES
+		&& error.maxUVError <= MAX_UV_ERROR;
+}
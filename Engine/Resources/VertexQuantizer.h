@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "Core/MathHelper.h"
+#include "Renderer/Vertex.h"
+
+// Vertex::PosNormalUV를 Vertex::PosNormalUVQuantized로 줄이고 CPU에서 되돌려 오차를 잼
+
+#pragma warning(push)
+#pragma warning(disable : 26495)
+struct VertexQuantizationError
+{
+	// 범위 대각선에 대한 비율
+	float maxPositionError;
+
+	// 도 단위
+	float maxNormalErrorDegrees;
+
+	float maxUVError;
+};
+#pragma warning(pop)
+
+// 위치는 [boundsMin, boundsMax] 안의 UNORM16, 되돌릴 때는 값 * outScale + outOffset
+void QuantizeVertices(
+	const std::vector<Vertex::PosNormalUV>& vertices,
+	const Vector3& boundsMin,
+	const Vector3& boundsMax,
+	std::vector<Vertex::PosNormalUVQuantized>& outVertices,
+	Vector3& outOffset,
+	Vector3& outScale
+);
+
+// 입력 레이아웃의 UNORM, SNORM, half 변환과 셰이더의 8면체 복원을 그대로 따라함
+Vertex::PosNormalUV DequantizeVertex(const Vertex::PosNormalUVQuantized& vertex, const Vector3& offset, const Vector3& scale);
+
+void MeasureQuantizationError(
+	const std::vector<Vertex::PosNormalUV>& vertices,
+	const std::vector<Vertex::PosNormalUVQuantized>& quantizedVertices,
+	const Vector3& offset,
+	const Vector3& scale,
+	VertexQuantizationError& outError
+);
+
+// 여러 메쉬 중 가장 큰 오차를 남김
+void AccumulateQuantizationError(VertexQuantizationError& inOutMax, const VertexQuantizationError& error);
+
+// 모든 오차가 기준 안이면 true, 반복되는 큰 UV는 half 정밀도가 모자라 걸러짐
+bool IsQuantizationErrorAcceptable(const VertexQuantizationError& error);
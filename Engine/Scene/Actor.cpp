@@ -156,7 +156,7 @@ void Actor::DrawEditorUI()
 		ComponentFactory& componentFactory = ComponentFactory::GetInstance();
 		componentFactory.DrawAddComponentUI(this);
 
-		if (ImGui::TreeNodeEx(UTF8_TEXT("ȯ"), ImGuiTreeNodeFlags_DefaultOpen))
+		if (ImGui::TreeNodeEx(UTF8_TEXT("변환"), ImGuiTreeNodeFlags_DefaultOpen))
 		{
 			if (ImGui::BeginTable("XYZ", 3, ImGuiTableFlags_SizingStretchSame | ImGuiTableFlags_BordersInnerV))
 			{
@@ -168,9 +168,9 @@ void Actor::DrawEditorUI()
 			}
 			ImGui::EndTable();
 
-			ImGui::DragFloat3(UTF8_TEXT("ġ"), reinterpret_cast<float*>(&mPosition), 0.1f, -3000.f, 3000.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::DragFloat3(UTF8_TEXT("위치"), reinterpret_cast<float*>(&mPosition), 0.1f, -3000.f, 3000.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
 
-			ImGui::DragFloat3(UTF8_TEXT("Ȯ/"), reinterpret_cast<float*>(&mScale), 0.1f, -100.f, 100.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::DragFloat3(UTF8_TEXT("확대/축소"), reinterpret_cast<float*>(&mScale), 0.1f, -100.f, 100.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
 
 			constexpr float DEGREE_TO_RADIAN_COFF = XM_PI / 180.f;
 			constexpr float RADIAN_TO_DEGREE_COFF = 180.f / XM_PI;
@@ -178,7 +178,7 @@ void Actor::DrawEditorUI()
 			const float MAX_DEGREE = 360.f;
 
 			Vector3 rotation = mRotation.ToEuler() * RADIAN_TO_DEGREE_COFF;
-			ImGui::DragFloat3(UTF8_TEXT("ȸ"), reinterpret_cast<float*>(&rotation), 0.1f, -MAX_DEGREE, MAX_DEGREE, "%.1f", ImGuiSliderFlags_WrapAround);
+			ImGui::DragFloat3(UTF8_TEXT("회전"), reinterpret_cast<float*>(&rotation), 0.1f, -MAX_DEGREE, MAX_DEGREE, "%.1f", ImGuiSliderFlags_WrapAround);
 			mRotation = Quaternion::CreateFromYawPitchRoll(rotation * DEGREE_TO_RADIAN_COFF);
 
 			ImGui::TreePop();
@@ -189,7 +189,7 @@ void Actor::DrawEditorUI()
 			ImGui::PushID(i);
 
 			Component* const pComponent = mpComponents[i];
-			if (ImGui::Button(UTF8_TEXT("")))
+			if (ImGui::Button(UTF8_TEXT("삭제")))
 			{
 				delete pComponent;
 			}
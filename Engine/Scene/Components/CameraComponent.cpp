@@ -45,15 +45,16 @@ void CameraComponent::UpdateCameraInfomation()
 	}
 	else
 	{
-		const D3D11_VIEWPORT& viewport = renderer.GetViewport();
+		const RHI::Viewport& viewport = renderer.GetViewport();
 
-		const float aspectRatio = viewport.Width / viewport.Height;
+		const float aspectRatio = viewport.width / viewport.height;
 
 		proj = XMMatrixPerspectiveFovLH(mFov, aspectRatio, mNearZ, mFarZ);
 	}
 
 	mViewProj = view * proj;
 	renderer.UpdateCBFrame(position, view * proj);
+	renderer.UpdateClusterCamera(view, proj, mNearZ, mFarZ, mbOrhographic);
 
 	// https://copynull.tistory.com/265
 	const float r = mFarZ / (mFarZ - mNearZ);
@@ -64,7 +65,7 @@ void CameraComponent::UpdateCameraInfomation()
 
 	const Matrix mCullMatrix = view * tmpProj;
 
-	//  
+	// 가까운 평면
 	float x = mCullMatrix._14 + mCullMatrix._13;
 	float y = mCullMatrix._24 + mCullMatrix._23;
 	float z = mCullMatrix._34 + mCullMatrix._33;
@@ -75,7 +76,7 @@ void CameraComponent::UpdateCameraInfomation()
 
 	mFrustumPlanes[0] = nearPlane; // Near
 
-	//  
+	// 먼 평면
 	x = mCullMatrix._14 - mCullMatrix._13;
 	y = mCullMatrix._24 - mCullMatrix._23;
 	z = mCullMatrix._34 - mCullMatrix._33;
@@ -86,7 +87,7 @@ void CameraComponent::UpdateCameraInfomation()
 
 	mFrustumPlanes[1] = farPlane; // Far
 
-	//  
+	// 왼쪽 평면
 	x = mCullMatrix._14 + mCullMatrix._11;
 	y = mCullMatrix._24 + mCullMatrix._21;
 	z = mCullMatrix._34 + mCullMatrix._31;
@@ -97,7 +98,7 @@ void CameraComponent::UpdateCameraInfomation()
 
 	mFrustumPlanes[2] = leftPlane; // Left
 
-	//  
+	// 오른쪽 평면
 	x = mCullMatrix._14 - mCullMatrix._11;
 	y = mCullMatrix._24 - mCullMatrix._21;
 	z = mCullMatrix._34 - mCullMatrix._31;
@@ -108,7 +109,7 @@ void CameraComponent::UpdateCameraInfomation()
 
 	mFrustumPlanes[3] = rightPlane; // Right
 
-	//  
+	// 윗 평면
 	x = mCullMatrix._14 - mCullMatrix._12;
 	y = mCullMatrix._24 - mCullMatrix._22;
 	z = mCullMatrix._34 - mCullMatrix._32;
@@ -119,7 +120,7 @@ void CameraComponent::UpdateCameraInfomation()
 
 	mFrustumPlanes[4] = topPlane; // Top
 
-	// Ʒ 
+	// 아랫 평면
 	x = mCullMatrix._14 + mCullMatrix._12;
 	y = mCullMatrix._24 + mCullMatrix._22;
 	z = mCullMatrix._34 + mCullMatrix._32;
@@ -135,14 +136,14 @@ void CameraComponent::DrawEditorUI()
 {
 	if (ImGui::TreeNodeEx(GetLabel(), ImGuiTreeNodeFlags_DefaultOpen))
 	{
-		if (ImGui::RadioButton(UTF8_TEXT(" "), !mbOrhographic))
+		if (ImGui::RadioButton(UTF8_TEXT("원근 투영"), !mbOrhographic))
 		{
 			mbOrhographic = false;
 		}
 
 		ImGui::SameLine();
 
-		if (ImGui::RadioButton(UTF8_TEXT(""), mbOrhographic))
+		if (ImGui::RadioButton(UTF8_TEXT("정투영"), mbOrhographic))
 		{
 			mbOrhographic = true;
 		}
@@ -150,17 +151,17 @@ void CameraComponent::DrawEditorUI()
 		if (!mbOrhographic)
 		{
 			mFov = XMConvertToDegrees(mFov);
-			ImGui::DragFloat(UTF8_TEXT("þ߰"), &mFov, 0.5f, 1.f, 120.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::DragFloat(UTF8_TEXT("시야각"), &mFov, 0.5f, 1.f, 120.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
 			mFov = XMConvertToRadians(mFov);
 		}
 		else
 		{
 			Renderer& renderer = Renderer::GetInstance();
 
-			const D3D11_VIEWPORT& viewport = renderer.GetViewport();
+			const RHI::Viewport& viewport = renderer.GetViewport();
 
-			ImGui::DragFloat(UTF8_TEXT("þ ʺ"), &mViewWidth, 0.5f, 0.01f, viewport.Width, "%.2f", ImGuiSliderFlags_AlwaysClamp);
-			ImGui::DragFloat(UTF8_TEXT("þ "), &mViewHeight, 0.5f, 0.01f, viewport.Height, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::DragFloat(UTF8_TEXT("시야 너비"), &mViewWidth, 0.5f, 0.01f, viewport.width, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::DragFloat(UTF8_TEXT("시야 높이"), &mViewHeight, 0.5f, 0.01f, viewport.height, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 		}
 
 		ImGui::DragFloat(UTF8_TEXT("NearZ"), &mNearZ, 0.5f, 0.01f, mFarZ - 0.01f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
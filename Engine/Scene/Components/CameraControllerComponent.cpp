@@ -64,11 +64,11 @@ void CameraControllerComponent::Update(const float deltaTime)
 
 		Renderer& renderer = Renderer::GetInstance();
 
-		const D3D11_VIEWPORT& viewport = renderer.GetViewport();
+		const RHI::Viewport& viewport = renderer.GetViewport();
 
 		const Vector2 viewportSize = Vector2(
-			viewport.Width,
-			viewport.Height
+			viewport.width,
+			viewport.height
 		);
 
 		// dx - yaw, dy - pitch
@@ -92,7 +92,7 @@ void CameraControllerComponent::DrawEditorUI()
 {
 	if (ImGui::TreeNodeEx(GetLabel(), ImGuiTreeNodeFlags_DefaultOpen))
 	{
-		ImGui::DragFloat(UTF8_TEXT("̵ ӵ"), &mMoveSpeed, 0.1f, 0.1f, 100.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat(UTF8_TEXT("이동 속도"), &mMoveSpeed, 0.1f, 0.1f, 100.f, "%.1f", ImGuiSliderFlags_AlwaysClamp);
 		ImGui::TreePop();
 	}
 }
@@ -51,7 +51,7 @@ void ComponentFactory::DrawAddComponentUI(Actor* const pActor)
 {
 	ASSERT(pActor != nullptr);
 
-	const char* const label = UTF8_TEXT("##Ʈ");
+	const char* const label = UTF8_TEXT("##컴포넌트");
 
 	if (ImGui::BeginCombo(label, mComponentNames[mSelectedComponentIndex]))
 	{
@@ -63,7 +63,7 @@ void ComponentFactory::DrawAddComponentUI(Actor* const pActor)
 				mSelectedComponentIndex = i;
 			}
 
-			// õ ׸ ⺻ ǥ
+			// 선택된 항목을 기본으로 표시
 			if (isSelected)
 			{
 				ImGui::SetItemDefaultFocus();
@@ -74,8 +74,8 @@ void ComponentFactory::DrawAddComponentUI(Actor* const pActor)
 
 	ImGui::SameLine();
 
-	// Ʈ ߰ ư
-	if (ImGui::Button(UTF8_TEXT("߰")))
+	// 컴포넌트 추가 버튼
+	if (ImGui::Button(UTF8_TEXT("추가")))
 	{
 		const char* const selectedComponentName = mComponentNames[mSelectedComponentIndex];
 
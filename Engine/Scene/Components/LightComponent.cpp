@@ -44,10 +44,10 @@ void LightComponent::DrawEditorUI()
 		constexpr float FALL_OFF_MIN = 0.f;
 		constexpr float FALL_OFF_MAX = 1000.f;
 
-		ImGui::SliderFloat3(UTF8_TEXT(""), reinterpret_cast<float*>(&mLight.strength), 0.f, 1.f, "%.2f");
-		ImGui::SliderFloat(UTF8_TEXT(" "), &mLight.falloffStart, FALL_OFF_MIN, FALL_OFF_MAX, "%.2f");
-		ImGui::SliderFloat(UTF8_TEXT(" "), &mLight.falloffEnd, mLight.falloffStart + 1.f, FALL_OFF_MAX + 0.001f, "%.2f");
-		ImGui::SliderFloat(UTF8_TEXT(" Ŀ"), &mLight.spotPower, 0.f, 128.f);
+		ImGui::SliderFloat3(UTF8_TEXT("강도"), reinterpret_cast<float*>(&mLight.strength), 0.f, 1.f, "%.2f");
+		ImGui::SliderFloat(UTF8_TEXT("감쇠 시작"), &mLight.falloffStart, FALL_OFF_MIN, FALL_OFF_MAX, "%.2f");
+		ImGui::SliderFloat(UTF8_TEXT("감쇠 끝"), &mLight.falloffEnd, mLight.falloffStart + 1.f, FALL_OFF_MAX + 0.001f, "%.2f");
+		ImGui::SliderFloat(UTF8_TEXT("스팟 파워"), &mLight.spotPower, 0.f, 128.f);
 
 		ImGui::TreePop();
 	}
@@ -14,10 +14,13 @@
 MeshComponent::MeshComponent(Actor* const pOwner, const char* const label, const uint32_t updateOrder)
 	: Component(pOwner, label, updateOrder)
 	, mpModel(ModelManager::GetInstance().GetModelOrNull("Cube"))
+	, mModelRevision(mpModel->GetRevision())
 	, mbModelSelecting(false)
 	, mbVSSelecting(false)
 	, mbPSSelecting(false)
 {
+	ModelManager::GetInstance().AddRef(mpModel);
+
 	Scene& scene = pOwner->GetScene();
 
 	Renderer& renderer = Renderer::GetInstance();
@@ -48,6 +51,9 @@ MeshComponent::~MeshComponent()
 	Renderer& renderer = Renderer::GetInstance();
 
 	renderer.RemoveMeshComponent(scene.GetName(), this);
+
+	// 남은 참조가 없으면 다음 프레임 경계에서 해제 후보가 됨
+	ModelManager::GetInstance().Release(mpModel);
 }
 
 void MeshComponent::Update(const float deltaTime)
@@ -55,15 +61,31 @@ void MeshComponent::Update(const float deltaTime)
 	ASSERT(deltaTime > 0.f);
 }
 
-void MeshComponent::SubmitRenderCommand() const
+void MeshComponent::SubmitRenderCommand()
 {
 	const ModelData& modelData = mpModel->GetModelData();
 
 	Actor& owner = GetOwner();
 
+	// 화면 밖이면 고를 수도 없으므로 보일 때만 맞춰도 됨
+	if (mModelRevision != mpModel->GetRevision())
+	{
+		mModelRevision = mpModel->GetRevision();
+
+		InteractionSystem& interactionSystem = InteractionSystem::GetInstance();
+
+		interactionSystem.UpdateColliderRadius(
+			owner.GetScene().GetName(),
+			&owner,
+			mpModel->GetBoundingRadiusLocal()
+		);
+	}
+
 	const Matrix offset = Matrix::CreateTranslation(mpModel->GetBoundingRadiusLocal().Center * -1.0f);
 	const Matrix worldMatrix = offset * owner.GetTransform();
 
+	const BoundingSphere boundingSphereWorld = GetBoundingSphereWorld();
+
 	Renderer& renderer = Renderer::GetInstance();
 
 	for (const std::pair<Mesh*, Material*>& pair : modelData)
@@ -72,6 +94,9 @@ void MeshComponent::SubmitRenderCommand() const
 		renderCommand.pMesh = pair.first;
 		renderCommand.pMaterial = pair.second;
 		renderCommand.worldMatrix = worldMatrix;
+		renderCommand.boundingSphereWorld = boundingSphereWorld;
+		renderCommand.lightCount = 0;
+		renderCommand.shaderFeatures = SHADER_FEATURE_NONE;
 
 		renderer.EnqueueRenderCommand(renderCommand);
 	}
@@ -83,21 +108,21 @@ void MeshComponent::DrawEditorUI()
 	{
 		ImGui::Text("Model: %s", mpModel->GetPath().c_str());
 
-		if (ImGui::Button(UTF8_TEXT(" ")))
+		if (ImGui::Button(UTF8_TEXT("모델 변경")))
 		{
 			mbModelSelecting = true;
 		}
 
 		ImGui::SameLine();
 
-		if (ImGui::Button(UTF8_TEXT(" ̴ ")))
+		if (ImGui::Button(UTF8_TEXT("정점 셰이더 변경")))
 		{
 			mbVSSelecting = true;
 		}
 
 		ImGui::SameLine();
 
-		if (ImGui::Button(UTF8_TEXT("ȼ ̴ ")))
+		if (ImGui::Button(UTF8_TEXT("픽셀 셰이더 변경")))
 		{
 			mbPSSelecting = true;
 		}
@@ -111,6 +136,13 @@ void MeshComponent::DrawEditorUI()
 			if (modelManager.DrawModelSelectorPopupAndSelectModel(mpModel))
 			{
 				mbModelSelecting = false;
+				mModelRevision = mpModel->GetRevision();
+
+				if (pOldModel != mpModel)
+				{
+					modelManager.AddRef(mpModel);
+					modelManager.Release(pOldModel);
+				}
 
 				// update collider
 				Actor& owner = GetOwner();
@@ -133,18 +165,23 @@ void MeshComponent::DrawEditorUI()
 			std::string newPath = "";
 			if (shaderManager.DrawShaderSelectorPopupAndSelectShaders(/*out*/ newPath, mbPSSelecting))
 			{
-				if (!newPath.empty())
+				// 불러오는 중이면 빌려 쓰는 정육면체의 머티리얼이라 바꾸지 않음
+				if (!newPath.empty() && !mpModel->IsPlaceholder())
 				{
-					const ModelData& modelData = mpModel->GetModelData();
-					for (const std::pair<Mesh*, Material*>& pair : modelData)
+					ModelManager& modelManager = ModelManager::GetInstance();
+
+					const uint32_t submeshCount = static_cast<uint32_t>(mpModel->GetModelData().size());
+					for (uint32_t i = 0; i < submeshCount; ++i)
 					{
+						Material* const pMaterial = modelManager.DetachSubmeshMaterial(mpModel, i);
+
 						if (mbPSSelecting)
 						{
-							pair.second->SetPixelShaderPath(newPath);
+							pMaterial->SetPixelShaderPath(newPath);
 						}
 						else
 						{
-							pair.second->SetVertexShaderPath(newPath);
+							pMaterial->SetVertexShaderPath(newPath);
 						}
 					}
 				}
@@ -156,10 +193,31 @@ void MeshComponent::DrawEditorUI()
 
 		const ModelData& modelData = mpModel->GetModelData();
 
-		for (const std::pair<Mesh*, Material*>& pair : modelData)
+		for (uint32_t i = 0; i < modelData.size(); ++i)
 		{
-			pair.first->DrawEditorUI();
-			pair.second->DrawEditorUI();
+			ImGui::PushID(static_cast<int>(i));
+
+			modelData[i].first->DrawEditorUI();
+
+			// 불러오는 중이면 빌려 쓰는 정육면체의 머티리얼이라 편집하지 않음
+			if (!mpModel->IsPlaceholder())
+			{
+				Material* const pMaterial = modelData[i].second;
+
+				const uint64_t stateHash = pMaterial->CalculateStateHash();
+				const Material::EditorState state = pMaterial->GetEditorState();
+
+				pMaterial->DrawEditorUI();
+
+				// 같이 쓰던 것이면 편집된 값은 복사본으로 옮기고 원본은 되돌림
+				if (pMaterial->CalculateStateHash() != stateHash
+					&& ModelManager::GetInstance().DetachSubmeshMaterial(mpModel, i) != pMaterial)
+				{
+					pMaterial->SetEditorState(state);
+				}
+			}
+
+			ImGui::PopID();
 		}
 
 		ImGui::TreePop();
@@ -176,7 +234,13 @@ void MeshComponent::CloneFrom(const Component& other)
 
 		const MeshComponent& otherMeshComp = static_cast<const MeshComponent&>(other);
 
+		ModelManager& modelManager = ModelManager::GetInstance();
+
+		modelManager.AddRef(otherMeshComp.mpModel);
+		modelManager.Release(mpModel);
+
 		mpModel = otherMeshComp.mpModel;
+		mModelRevision = otherMeshComp.mModelRevision;
 	}
 }
 
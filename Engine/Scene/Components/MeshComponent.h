@@ -13,7 +13,7 @@ public:
 
 	virtual void Update(const float deltaTime) override;
 
-	void SubmitRenderCommand() const;
+	void SubmitRenderCommand();
 
 	virtual void DrawEditorUI() override;
 
@@ -24,6 +24,9 @@ public:
 private:
 	Model* mpModel;
 
+	// 불러오는 중이던 모델이 바뀌면 충돌체를 다시 맞춤
+	uint32_t mModelRevision;
+
 	bool mbModelSelecting;
 	bool mbVSSelecting;
 	bool mbPSSelecting;
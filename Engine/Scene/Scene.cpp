@@ -37,13 +37,13 @@ Scene::Scene(const std::string& name)
 
 	ComponentFactory& componentFactory = ComponentFactory::GetInstance();
 
-	// ⺻  ϳ 
+	// 기본 액터 하나 생성
 	Actor* const pActor = new Actor(this, "DefaultActor");
 
 	componentFactory.CreateComponentAlloc("MeshComponent", pActor);
 	mpActorOriginals.push_back(pActor);
 
-	//  ׽Ʈ   ٷ 
+	// 성능 테스트용 무작위 액터 다량 생성
 	//std::mt19937 rng{ std::random_device{}() };
 	//std::uniform_real_distribution<float> distPos(-2000.f, 2000.f);
 
@@ -54,10 +54,10 @@ Scene::Scene(const std::string& name)
 
 	//	Actor* const pRandActor = new Actor(this, nameBuf);
 
-	//	//  ġ 
+	//	// 무작위 위치 설정
 	//	pRandActor->SetPosition(Vector3(distPos(rng), distPos(rng), distPos(rng)));
 
-	//	// ޽ Ʈ 
+	//	// 메시 컴포넌트 부착
 	//	componentFactory.CreateComponentAlloc("MeshComponent", pRandActor);
 
 	//	mpActorOriginals.push_back(pRandActor);
@@ -123,7 +123,7 @@ void Scene::DrawEditorUI()
 	if (ImGui::Begin(mSceneName.c_str()))
 	{
 		// Add Actor button
-		if (ImGui::Button(UTF8_TEXT(" ߰")))
+		if (ImGui::Button(UTF8_TEXT("액터 추가")))
 		{
 			// generate unique name
 			char nameBuf[MAX_LABEL_LENGTH];
@@ -141,7 +141,7 @@ void Scene::DrawEditorUI()
 
 			Actor* const pActor = mpActorOriginals[i];
 
-			if (ImGui::Button(UTF8_TEXT(" ")))
+			if (ImGui::Button(UTF8_TEXT("액터 삭제")))
 			{
 				delete pActor;
 			}
@@ -61,21 +61,21 @@ void SceneManager::DrawEditorUI()
 {
 	ImGui::PushID("SceneManager");
 
-	// ܼ   ǥ  
-	//  õ   ưó ǥ
+	// 단순한 씬 목록 표시 및 선택
+	// 현재 선택된 씬은 라디오 버튼처럼 표시
 	for (int i = 0; i < static_cast<int>(mpScenes.size()); ++i)
 	{
 		ImGui::PushID(i);
 
 		bool selected = (i == mSelectedSceneIndex);
-		if (ImGui::Selectable(UTF8_TEXT(""), selected))
+		if (ImGui::Selectable(UTF8_TEXT("씬"), selected))
 		{
 			mSelectedSceneIndex = i;
 			GameCore::GetInstance().SetCurrentScene(mpScenes[mSelectedSceneIndex]);
 		}
 
 		ImGui::SameLine();
-		ImGui::Text("%d", i); // index ǥ (ڴ ״)
+		ImGui::Text("%d", i); // index 표시 (숫자는 그대로)
 
 		ImGui::PopID();
 	}
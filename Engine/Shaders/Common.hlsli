@@ -1,3 +1,30 @@
+// ShaderManager가 변형마다 정의함, 정의가 없으면 모든 기능을 켬
+#ifndef USE_TEXTURE
+#define USE_TEXTURE 1
+#endif
+
+#ifndef USE_OBJECT_LIGHTS
+#define USE_OBJECT_LIGHTS 1
+#endif
+
+#ifndef USE_SPOT_LIGHTS
+#define USE_SPOT_LIGHTS 1
+#endif
+
+#ifndef MAX_OBJECT_LIGHT_COUNT
+#define MAX_OBJECT_LIGHT_COUNT 8
+#endif
+
+// 스프라이트 등은 t0을 Texture2D로 읽으므로 이것만 기본으로 끔
+#ifndef USE_TEXTURE_ARRAY
+#define USE_TEXTURE_ARRAY 0
+#endif
+
+// Vertex::POS_NORMAL_UV_QUANTIZED 입력, *Quantized.hlsl 파일이 켬
+#ifndef USE_QUANTIZED_VERTEX
+#define USE_QUANTIZED_VERTEX 0
+#endif
+
 cbuffer CBFrame : register(b0)
 {
     float3 cameraPos;
@@ -9,6 +36,11 @@ cbuffer CBWorldMatrix : register(b1)
 {
     float4x4 world;
     float4x4 invTrans;
+    uint objectLightCount;
+    float3 dummy3;
+    uint4 objectLightIndices[2]; // Renderer::MAX_OBJECT_LIGHTS, 중요도 순
+    float4 positionScale; // 양자화된 위치를 메쉬 범위로 되돌림
+    float4 positionOffset;
 };
 
 cbuffer CBMaterial : register(b2)
@@ -19,21 +51,71 @@ cbuffer CBMaterial : register(b2)
     float dummy0;
     float3 specularColor;
     float dummy1;
-
-    bool bUseTexture;
+    float4 atlasRect; // u, v 오프셋과 크기
+    float atlasSlice;
+    float3 dummy4;
 };
 
+#if USE_TEXTURE_ARRAY
+Texture2DArray sTextureArray : register(t0);
+#else
 Texture2D sTexture : register(t0);
+#endif
 SamplerState sSampler : register(s0);
 
+// 아틀라스에 담긴 텍스처는 슬라이스의 UV 영역 안에서 반복
+// frac으로 끊긴 미분 대신 원래 UV의 미분을 영역 크기로 줄여서 밉을 고름
+float4 SampleMaterialTexture(const float2 uv)
+{
+#if USE_TEXTURE_ARRAY
+    const float2 atlasUV = frac(uv) * atlasRect.zw + atlasRect.xy;
+    
+    return sTextureArray.SampleGrad(sSampler, float3(atlasUV, atlasSlice), ddx(uv) * atlasRect.zw, ddy(uv) * atlasRect.zw);
+#else
+    return sTexture.Sample(sSampler, uv);
+#endif
+}
+
 struct VSInput
 {
+#if USE_QUANTIZED_VERTEX
+    float4 pos : POSITION; // UNORM16
+    float2 normal : NORMAL; // 8면체, SNORM16
+    float2 uv : TEXCOORD; // half
+#else
     float3 pos : POSITION;
     float3 normal : NORMAL;
     float2 uv : TEXCOORD;
+#endif
 };
 
-#define MAX_LIGHTS 8
+// 깊이 패스(VSDepthOnly)와 본 패스의 깊이가 비트 단위로 같아야 EQUAL 비교가 통과함
+// 두 패스 모두 이 함수로 위치를 변환하고 precise로 곱셈-덧셈 합치기와 순서 바꾸기를 막음
+// 양자화되지 않은 메쉬도 positionScale 1, positionOffset 0으로 같은 연산을 거침
+float4 TransformVertexPosition(const float3 storedPos, out float4 outWorldPos)
+{
+    precise float3 pos = storedPos * positionScale.xyz + positionOffset.xyz;
+    precise float4 worldPos = mul(float4(pos, 1.0f), world);
+    precise float4 clipPos = mul(worldPos, viewProj);
+    
+    outWorldPos = worldPos;
+    
+    return clipPos;
+}
+
+float3 GetVertexNormal(const VSInput input)
+{
+#if USE_QUANTIZED_VERTEX
+    // 아래 반구는 접힌 모서리를 다시 펼침
+    float3 normal = float3(input.normal, 1.0f - abs(input.normal.x) - abs(input.normal.y));
+    const float fold = saturate(-normal.z);
+    normal.xy += normal.xy >= 0.0f ? -fold : fold;
+    
+    return normalize(normal);
+#else
+    return input.normal;
+#endif
+}
 
 struct Light
 {
@@ -45,7 +127,30 @@ struct Light
     float spotPower;
 };
 
-cbuffer CBLight : register(b3)
+cbuffer CBCluster : register(b3)
+{
+    float3 cameraForward;
+    uint lightCount;
+    uint3 clusterCount;
+    float sliceScale;
+    float2 tileSize;
+    float sliceBias;
+    float dummy2;
+};
+
+StructuredBuffer<Light> lights : register(t1);
+StructuredBuffer<uint2> clusterRanges : register(t2); // offset, count
+StructuredBuffer<uint> lightIndices : register(t3);
+
+// 화면 타일과 지수 깊이 슬라이스로 클러스터 찾기
+uint GetClusterIndex(const float2 pixelPos, const float3 posWorld)
 {
-    Light lights[MAX_LIGHTS];
-};
\ No newline at end of file
+    const float viewZ = max(dot(posWorld - cameraPos, cameraForward), 1e-4f);
+    
+    const uint3 cluster = min(
+        uint3(uint2(pixelPos / tileSize), uint(max(log(viewZ) * sliceScale + sliceBias, 0.f))),
+        clusterCount - 1
+    );
+    
+    return (cluster.z * clusterCount.y + cluster.y) * clusterCount.x + cluster.x;
+}
\ No newline at end of file
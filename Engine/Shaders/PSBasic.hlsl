@@ -2,5 +2,9 @@
 
 float4 main(PSBasicInput input) : SV_TARGET
 {    
-    return bUseTexture ? sTexture.Sample(sSampler, input.uv) : float4(1.0f, 1.0f, 1.0f, 1.0f);
+#if USE_TEXTURE
+    return SampleMaterialTexture(input.uv);
+#else
+    return float4(1.0f, 1.0f, 1.0f, 1.0f);
+#endif
 }
\ No newline at end of file
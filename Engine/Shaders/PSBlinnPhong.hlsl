@@ -1,5 +1,39 @@
 #include "BlinnPhong.hlsli"
 
+float3 ShadeLight(const Light light, const float3 posWorld, const float3 normal, const float3 toEye)
+{
+    float3 posToLight = light.position - posWorld;
+    
+    const float dist = length(posToLight);
+    
+    if (dist > light.falloffEnd)
+    {
+        return float3(0.f, 0.f, 0.f);
+    }
+    
+    posToLight /= dist;
+    
+    const float nDotL = max(dot(posToLight, normal), 0.f);
+    float3 lightStrength = light.strength * nDotL;
+    
+    const float attenuation = (light.falloffEnd - dist) / (light.falloffEnd - light.falloffStart);
+    
+    lightStrength *= attenuation;
+    
+#if USE_SPOT_LIGHTS
+    const float3 lightDir = normalize(light.direction);
+    const float spotFactor = pow(max(dot(-posToLight, lightDir), 0.f), light.spotPower);
+    
+    lightStrength *= spotFactor;
+#endif
+    
+    const float3 halfway = normalize(posToLight + toEye);
+    
+    const float hDotN = max(dot(halfway, normal), 0.f);
+    
+    return ambientColor + (diffuseColor + specularColor * pow(hDotN, shininess)) * lightStrength;
+}
+
 float4 main(const PSBlinnPhongInput input) : SV_Target
 {
     float3 color = float3(0.f, 0.f, 0.f);
@@ -7,43 +41,33 @@ float4 main(const PSBlinnPhongInput input) : SV_Target
     const float3 toEye = normalize(cameraPos - input.posWorld);
     const float3 normal = normalize(input.normal);
     
-    [unroll]
-    for (int i = 0; i < MAX_LIGHTS; ++i)
+#if USE_OBJECT_LIGHTS
+#if MAX_OBJECT_LIGHT_COUNT > 0
+    // 렌더러가 물체마다 고른 빛만 계산, 구간 크기만큼 펼침
+    [unroll(MAX_OBJECT_LIGHT_COUNT)]
+    for (uint i = 0; i < objectLightCount; ++i)
     {
-        float3 posToLight = lights[i].position - input.posWorld;
-        
-        const float dist = length(posToLight);
-        
-        if (dist > lights[i].falloffEnd)
-        {
-            color += float3(0.f, 0.f, 0.f);
-        }
-        else
-        {
-            posToLight /= dist;
-            
-            const float nDotL = max(dot(posToLight, normal), 0.f);
-            float3 lightStrength = lights[i].strength * nDotL;
-            
-            const float attenuation = (lights[i].falloffEnd - dist) / (lights[i].falloffEnd - lights[i].falloffStart);
-            
-            lightStrength *= attenuation;
-            
-            const float3 lightDir = normalize(lights[i].direction);
-            const float spotFactor = pow(max(dot(-posToLight, lightDir), 0.f), lights[i].spotPower);
+        const Light light = lights[objectLightIndices[i / 4][i % 4]];
             
-            lightStrength *= spotFactor;
-            
-            const float3 halfway = normalize(posToLight + toEye);
-            
-            const float hDotN = max(dot(halfway, normal), 0.f);
+        color += ShadeLight(light, input.posWorld, normal, toEye);
+    }
+#endif
+#else
+    const uint2 clusterRange = clusterRanges[GetClusterIndex(input.pos.xy, input.posWorld)];
+    
+    for (uint i = 0; i < clusterRange.y; ++i)
+    {
+        const Light light = lights[lightIndices[clusterRange.x + i]];
             
-            color += ambientColor + (diffuseColor + specularColor * pow(hDotN, shininess)) * lightStrength;
-
-        }
+        color += ShadeLight(light, input.posWorld, normal, toEye);
     }
+#endif
     
     const float4 resultColor = float4(color, 1.f);
     
-    return bUseTexture ? sTexture.Sample(sSampler, input.uv) * resultColor : resultColor;
+#if USE_TEXTURE
+    return SampleMaterialTexture(input.uv) * resultColor;
+#else
+    return resultColor;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,4 @@
+// Vertex::POS_NORMAL_UV_QUANTIZED 메쉬용 변형
+#define USE_QUANTIZED_VERTEX 1
+
+#include "VSBasic.hlsl"
@@ -2,11 +2,11 @@
 
 VSBlinnPhongOutput main(const VSInput input)
 {
-	const float4 worldPos = mul(float4(input.pos, 1.0f), world);
-	const float4 worldNormal = mul(float4(input.normal, 0.0f), invTrans);
+	const float4 worldNormal = mul(float4(GetVertexNormal(input), 0.0f), invTrans);
 	
 	VSBlinnPhongOutput output;
-	output.pos = mul(worldPos, viewProj);
+	float4 worldPos;
+	output.pos = TransformVertexPosition(input.pos.xyz, worldPos);
 	output.posWorld = worldPos.xyz;
 	output.normal = worldNormal.xyz;
 	output.uv = input.uv;
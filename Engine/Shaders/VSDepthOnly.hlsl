@@ -0,0 +1,14 @@
+#include "Common.hlsli"
+
+// 위치 스트림만 읽음, 양자화된 메쉬는 전체 레이아웃에서 위치만 가져감
+struct VSDepthInput
+{
+    float3 pos : POSITION;
+};
+
+float4 main(const VSDepthInput input) : SV_POSITION
+{
+    float4 worldPos;
+    
+    return TransformVertexPosition(input.pos, worldPos);
+}
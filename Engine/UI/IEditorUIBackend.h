@@ -0,0 +1,12 @@
+#pragma once
+
+// 에디터 UI를 화면에 올리는 플랫폼/그래픽스 백엔드
+// 렌더러는 이 인터페이스만 알고 어떤 백엔드인지는 만드는 쪽이 정함
+class IEditorUIBackend
+{
+public:
+	virtual ~IEditorUIBackend() = default;
+
+	virtual void NewFrame() = 0;
+	virtual void Render() = 0;
+};
\ No newline at end of file
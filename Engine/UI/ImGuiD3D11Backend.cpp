@@ -0,0 +1,75 @@
+#include "ImGuiD3D11Backend.h"
+
+#include <imgui.h>
+#include <imgui_impl_win32.h>
+#include <imgui_impl_dx11.h>
+
+#include "Core/LogHelper.h"
+
+ImGuiD3D11Backend::~ImGuiD3D11Backend()
+{
+	ImGui_ImplDX11_Shutdown();
+	ImGui_ImplWin32_Shutdown();
+	ImGui::DestroyContext();
+}
+
+void ImGuiD3D11Backend::NewFrame()
+{
+	ImGui_ImplWin32_NewFrame();
+	ImGui_ImplDX11_NewFrame();
+	ImGui::NewFrame();
+}
+
+void ImGuiD3D11Backend::Render()
+{
+	ImGui::Render();
+	ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+}
+
+ImGuiD3D11Backend* ImGuiD3D11Backend::CreateBackendAllocOrNull(const HWND hWnd, RHI::D3D11Device& device)
+{
+	ASSERT(hWnd != nullptr);
+
+	IMGUI_CHECKVERSION();
+	ImGuiContext* pImGuiContext = ImGui::CreateContext();
+
+	if (pImGuiContext == nullptr)
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "ImGui - CreateContext");
+
+		ASSERT(false);
+
+		return nullptr;
+	}
+
+	ImGuiIO& io = ImGui::GetIO();
+	io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+	io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+	io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+	io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\malgun.ttf", 18.f, nullptr, io.Fonts->GetGlyphRangesKorean());
+
+	if (!ImGui_ImplWin32_Init(hWnd))
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "ImGui - Win32_Init");
+
+		ASSERT(false);
+
+		ImGui::DestroyContext();
+
+		return nullptr;
+	}
+
+	if (!ImGui_ImplDX11_Init(device.GetNativeDevice(), device.GetNativeDeviceContext()))
+	{
+		LOG_SYSTEM_ERROR(E_FAIL, "ImGui - DX11_Init");
+
+		ASSERT(false);
+
+		ImGui_ImplWin32_Shutdown();
+		ImGui::DestroyContext();
+
+		return nullptr;
+	}
+
+	return new ImGuiD3D11Backend();
+}
\ No newline at end of file
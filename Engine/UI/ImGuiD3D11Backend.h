@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Windows.h>
+
+#include "IEditorUIBackend.h"
+#include "Renderer/RHI/D3D11Device.h"
+
+// ImGui Win32 + DX11 백엔드, ImGui 컨텍스트도 여기서 만들고 해제함
+class ImGuiD3D11Backend final : public IEditorUIBackend
+{
+public:
+	virtual ~ImGuiD3D11Backend();
+
+	virtual void NewFrame() override;
+	virtual void Render() override;
+
+	// static
+	static ImGuiD3D11Backend* CreateBackendAllocOrNull(const HWND hWnd, RHI::D3D11Device& device);
+
+private:
+	ImGuiD3D11Backend() = default;
+
+private:
+	ImGuiD3D11Backend(const ImGuiD3D11Backend& other) = delete;
+	ImGuiD3D11Backend(ImGuiD3D11Backend&& other) = delete;
+	ImGuiD3D11Backend& operator=(const ImGuiD3D11Backend& other) = delete;
+	ImGuiD3D11Backend& operator=(ImGuiD3D11Backend&& other) = delete;
+};
\ No newline at end of file
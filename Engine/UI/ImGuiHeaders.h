@@ -1,5 +1,3 @@
 #pragma once
 
-#include <imgui.h>
-#include <imgui_impl_win32.h>
-#include <imgui_impl_dx11.h>
\ No newline at end of file
+#include <imgui.h>
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "TestHelper.h"
+
+#include <cstring>
+#include <vector>
+
+#include "Renderer/FrameGraph.h"
+#include "Renderer/RHI/NullDevice.h"
+
+enum
+{
+	BACK_BUFFER_WIDTH = 320,
+	BACK_BUFFER_HEIGHT = 180
+};
+
+static RHI::TextureDesc MakeTargetDesc(const RHI::EFormat format)
+{
+	RHI::TextureDesc desc = {};
+	desc.width = BACK_BUFFER_WIDTH;
+	desc.height = BACK_BUFFER_HEIGHT;
+	desc.mipLevels = 1;
+	desc.arraySize = 1;
+	desc.sampleCount = 1;
+	desc.bindFlags = RHI::BIND_RENDER_TARGET | RHI::BIND_SHADER_RESOURCE;
+	desc.format = format;
+	desc.usage = RHI::EUsage::DEFAULT;
+
+	return desc;
+}
+
+// GBuffer -> Lighting -> Bloom -> Composite(백 버퍼) 사이에
+// 아무도 읽지 않는 Unused 패스와 출력 없이 남아야 하는 Debug 패스를 끼움
+struct TestGraph
+{
+	enum
+	{
+		GBUFFER_PASS,
+		UNUSED_PASS,
+		LIGHTING_PASS,
+		BLOOM_PASS,
+		DEBUG_PASS,
+		COMPOSITE_PASS
+	};
+
+	FrameGraph::ResourceHandle backBuffer;
+	FrameGraph::ResourceHandle albedo;
+	FrameGraph::ResourceHandle unused;
+	FrameGraph::ResourceHandle lit;
+	FrameGraph::ResourceHandle bloom;
+};
+
+static TestGraph BuildTestGraph(FrameGraph& frameGraph, const RHI::Device& device, std::vector<const char*>& executedPasses)
+{
+	const RHI::TextureDesc colorDesc = MakeTargetDesc(RHI::EFormat::R8G8B8A8_UNORM);
+	const RHI::TextureDesc hdrDesc = MakeTargetDesc(RHI::EFormat::R16G16B16A16_FLOAT);
+
+	TestGraph graph;
+	graph.backBuffer = frameGraph.ImportTexture("BackBuffer", device.GetBackBuffer());
+	graph.albedo = frameGraph.CreateTexture("Albedo", colorDesc);
+	graph.unused = frameGraph.CreateTexture("Unused", colorDesc);
+	graph.lit = frameGraph.CreateTexture("Lit", hdrDesc);
+	graph.bloom = frameGraph.CreateTexture("Bloom", colorDesc);
+
+	const auto record = [&executedPasses](const char* const name)
+		{
+			return [&executedPasses, name](RHI::CommandList& commandList, const FrameGraph& frameGraph)
+				{
+					executedPasses.push_back(name);
+				};
+		};
+
+	{
+		FrameGraph::PassBuilder pass = frameGraph.AddPass("GBuffer", record("GBuffer"));
+		pass.Write(graph.albedo);
+	}
+
+	{
+		FrameGraph::PassBuilder pass = frameGraph.AddPass("Unused", record("Unused"));
+		pass.Read(graph.albedo);
+		pass.Write(graph.unused);
+	}
+
+	{
+		FrameGraph::PassBuilder pass = frameGraph.AddPass("Lighting", record("Lighting"));
+		pass.Read(graph.albedo);
+		pass.Write(graph.lit);
+	}
+
+	{
+		FrameGraph::PassBuilder pass = frameGraph.AddPass("Bloom", record("Bloom"));
+		pass.Read(graph.lit);
+		pass.Write(graph.bloom);
+	}
+
+	{
+		FrameGraph::PassBuilder pass = frameGraph.AddPass("Debug", record("Debug"));
+		pass.SetSideEffect();
+	}
+
+	{
+		FrameGraph::PassBuilder pass = frameGraph.AddPass("Composite", record("Composite"));
+		pass.Read(graph.bloom);
+		pass.Write(graph.backBuffer);
+	}
+
+	return graph;
+}
+
+static void TestCompileOrderAndCulling()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+	TransientTexturePool pool(device);
+	RHI::CommandList commandList;
+
+	std::vector<const char*> executedPasses;
+
+	FrameGraph frameGraph;
+	BuildTestGraph(frameGraph, device, executedPasses);
+
+	CHECK(frameGraph.Compile());
+
+	CHECK(!frameGraph.IsPassCulled(TestGraph::GBUFFER_PASS));
+	CHECK(frameGraph.IsPassCulled(TestGraph::UNUSED_PASS));
+	CHECK(!frameGraph.IsPassCulled(TestGraph::LIGHTING_PASS));
+	CHECK(!frameGraph.IsPassCulled(TestGraph::BLOOM_PASS));
+	CHECK(!frameGraph.IsPassCulled(TestGraph::DEBUG_PASS));
+	CHECK(!frameGraph.IsPassCulled(TestGraph::COMPOSITE_PASS));
+
+	const FrameGraph::CompileStats& stats = frameGraph.GetCompileStats();
+	CHECK(stats.passCount == 6);
+	CHECK(stats.culledPassCount == 1);
+
+	frameGraph.Execute(device, pool, commandList);
+
+	// 제거된 패스를 뺀 선언 순서대로 실행
+	const char* const expectedPasses[] = { "GBuffer", "Lighting", "Bloom", "Debug", "Composite" };
+	const size_t expectedCount = sizeof(expectedPasses) / sizeof(expectedPasses[0]);
+
+	CHECK(executedPasses.size() == expectedCount);
+
+	for (size_t i = 0; i < expectedCount && i < executedPasses.size(); ++i)
+	{
+		CHECK(strcmp(executedPasses[i], expectedPasses[i]) == 0);
+	}
+}
+
+static void TestTransientAliasing()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+	TransientTexturePool pool(device);
+	RHI::CommandList commandList;
+
+	std::vector<const char*> executedPasses;
+
+	FrameGraph frameGraph;
+	const TestGraph graph = BuildTestGraph(frameGraph, device, executedPasses);
+
+	CHECK(frameGraph.Compile());
+
+	// Albedo는 Lighting에서 끝나고 Bloom은 그 뒤에 시작하므로 같은 텍스처를 씀
+	// Lit은 형식이 달라서 따로 잡힘, 제거된 패스만 쓰는 Unused는 배정되지 않음
+	CHECK(frameGraph.GetPhysicalIndex(graph.albedo) == frameGraph.GetPhysicalIndex(graph.bloom));
+	CHECK(frameGraph.GetPhysicalIndex(graph.albedo) != frameGraph.GetPhysicalIndex(graph.lit));
+	CHECK(frameGraph.GetPhysicalIndex(graph.unused) == FrameGraph::INVALID_ID);
+	CHECK(frameGraph.GetPhysicalIndex(graph.backBuffer) == FrameGraph::INVALID_ID);
+
+	const FrameGraph::CompileStats& stats = frameGraph.GetCompileStats();
+	const uint64_t colorBytes = FrameGraph::GetTextureByteSize(MakeTargetDesc(RHI::EFormat::R8G8B8A8_UNORM));
+	const uint64_t hdrBytes = FrameGraph::GetTextureByteSize(MakeTargetDesc(RHI::EFormat::R16G16B16A16_FLOAT));
+
+	CHECK(stats.transientCount == 3);
+	CHECK(stats.physicalCount == 2);
+	CHECK(stats.requestedBytes == colorBytes * 2 + hdrBytes);
+	CHECK(stats.allocatedBytes == colorBytes + hdrBytes);
+
+	frameGraph.Execute(device, pool, commandList);
+
+	CHECK(frameGraph.GetTexture(graph.albedo) == frameGraph.GetTexture(graph.bloom));
+	CHECK(frameGraph.GetTexture(graph.backBuffer) == device.GetBackBuffer());
+	CHECK(pool.GetTextureCount() == 2);
+}
+
+static void TestTransientPoolReuse()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+	TransientTexturePool pool(device);
+	RHI::CommandList commandList;
+
+	std::vector<const char*> executedPasses;
+
+	const uint32_t baseTextureCount = device.GetResourceStats().textureCount;
+
+	// 같은 그래프를 매 프레임 다시 만들어도 풀의 텍스처를 그대로 씀
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		FrameGraph frameGraph;
+		BuildTestGraph(frameGraph, device, executedPasses);
+
+		CHECK(frameGraph.Compile());
+
+		frameGraph.Execute(device, pool, commandList);
+
+		CHECK(pool.GetTextureCount() == 2);
+		CHECK(device.GetResourceStats().textureCount == baseTextureCount + 2);
+	}
+
+	// 요청이 끊긴 텍스처는 몇 프레임 뒤에 해제
+	for (uint32_t frame = 0; frame < 8; ++frame)
+	{
+		pool.EndFrame();
+	}
+
+	CHECK(pool.GetTextureCount() == 0);
+	CHECK(device.GetResourceStats().textureCount == baseTextureCount);
+}
+
+int main()
+{
+	RUN_TEST(TestCompileOrderAndCulling);
+	RUN_TEST(TestTransientAliasing);
+	RUN_TEST(TestTransientPoolReuse);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
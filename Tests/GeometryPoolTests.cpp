@@ -0,0 +1,252 @@
+#include "TestHelper.h"
+
+#include <vector>
+
+#include "Renderer/RHI/NullDevice.h"
+#include "Resources/GeometryPool.h"
+
+// 할당기는 CPU 쪽 자료 구조만, 풀은 NullDevice의 버퍼 수로 페이지 생성과 해제를 확인
+enum
+{
+	BACK_BUFFER_WIDTH = 64,
+	BACK_BUFFER_HEIGHT = 64,
+
+	ELEMENT_STRIDE = 4,
+	PAGE_CAPACITY = 100,
+
+	MAX_ELEMENT_COUNT = 256
+};
+
+static uint32_t GetBufferCount(const RHI::NullDevice& device)
+{
+	return device.GetResourceStats().bufferCount;
+}
+
+static GeometryPool::Allocation AllocateFromPool(GeometryPool& pool, const uint32_t count)
+{
+	static const uint32_t data[MAX_ELEMENT_COUNT] = {};
+
+	ASSERT(count <= MAX_ELEMENT_COUNT);
+
+	const void* const pData = data;
+
+	GeometryPool::Allocation allocation;
+	CHECK(pool.TryAllocate(&pData, count, allocation));
+
+	return allocation;
+}
+
+static void TestBestFit()
+{
+	RangeAllocator allocator(PAGE_CAPACITY);
+
+	const uint32_t a = allocator.Allocate(10);
+	const uint32_t b = allocator.Allocate(20);
+	const uint32_t c = allocator.Allocate(5);
+	const uint32_t d = allocator.Allocate(30);
+	const uint32_t e = allocator.Allocate(10);
+
+	CHECK(a == 0 && b == 10 && c == 30 && d == 35 && e == 65);
+
+	// 빈 블록: [10, 20], [35, 30], [75, 25]
+	allocator.Free(b);
+	allocator.Free(d);
+
+	CHECK(allocator.GetFreeBlockCount() == 3);
+	CHECK(allocator.Validate());
+
+	// 들어가는 것 중 가장 작은 블록을 고름
+	CHECK(allocator.Allocate(18) == 10);
+	CHECK(allocator.Allocate(26) == 35);
+	CHECK(allocator.Allocate(25) == 75);
+
+	// 남은 조각은 2, 4
+	CHECK(allocator.Allocate(5) == RangeAllocator::INVALID_OFFSET);
+	CHECK(allocator.GetLargestFreeBlock() == 4);
+	CHECK(allocator.GetUsedSize() == PAGE_CAPACITY - 6);
+	CHECK(allocator.Validate());
+}
+
+static void TestCoalesceOnFree()
+{
+	RangeAllocator allocator(PAGE_CAPACITY);
+
+	uint32_t offsets[4];
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		offsets[i] = allocator.Allocate(10);
+	}
+
+	// 이웃이 할당이면 그대로
+	allocator.Free(offsets[1]);
+	CHECK(allocator.GetFreeBlockCount() == 2);
+
+	// 뒤쪽 빈 블록과 합침
+	allocator.Free(offsets[3]);
+	CHECK(allocator.GetFreeBlockCount() == 2);
+	CHECK(allocator.GetLargestFreeBlock() == 70);
+
+	// 앞뒤를 모두 합침
+	allocator.Free(offsets[2]);
+	CHECK(allocator.GetFreeBlockCount() == 1);
+	CHECK(allocator.GetLargestFreeBlock() == 90);
+
+	allocator.Free(offsets[0]);
+	CHECK(allocator.GetFreeBlockCount() == 1);
+	CHECK(allocator.GetLargestFreeBlock() == PAGE_CAPACITY);
+	CHECK(allocator.GetAllocationCount() == 0);
+	CHECK(allocator.Validate());
+}
+
+static void TestRelocate()
+{
+	RangeAllocator allocator(PAGE_CAPACITY);
+
+	const uint32_t a = allocator.Allocate(10);
+	allocator.Allocate(10);
+	allocator.Allocate(10);
+	const uint32_t d = allocator.Allocate(5);
+
+	allocator.Free(a);
+
+	uint32_t oldOffset;
+	uint32_t newOffset;
+	uint32_t size;
+
+	// 한도보다 큰 것은 옮기지 않음
+	CHECK(!allocator.TryRelocate(4, oldOffset, newOffset, size));
+
+	// 맨 위에서 구멍에 들어가는 것을 먼저 옮김
+	CHECK(allocator.TryRelocate(PAGE_CAPACITY, oldOffset, newOffset, size));
+	CHECK(oldOffset == d && newOffset == 0 && size == 5);
+	CHECK(allocator.Validate());
+
+	// 들어가는 것이 없으면 바로 뒤 할당을 당김
+	CHECK(allocator.TryRelocate(PAGE_CAPACITY, oldOffset, newOffset, size));
+	CHECK(oldOffset == 10 && newOffset == 5 && size == 10);
+	CHECK(allocator.Validate());
+
+	while (allocator.TryRelocate(PAGE_CAPACITY, oldOffset, newOffset, size))
+	{
+		CHECK(newOffset < oldOffset);
+		CHECK(allocator.Validate());
+	}
+
+	// 앞쪽으로 모두 모이고 빈 곳은 하나
+	CHECK(allocator.GetFreeBlockCount() == 1);
+	CHECK(allocator.GetLargestFreeBlock() == PAGE_CAPACITY - 25);
+	CHECK(allocator.GetAllocationCount() == 3);
+}
+
+static void TestFragmentationAndDefragment()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+
+	const uint32_t stride = ELEMENT_STRIDE;
+	GeometryPool pool(device, "Test", RHI::BIND_VERTEX_BUFFER, &stride, 1, PAGE_CAPACITY * ELEMENT_STRIDE);
+
+	GeometryPool::Allocation allocations[10];
+	for (GeometryPool::Allocation& allocation : allocations)
+	{
+		allocation = AllocateFromPool(pool, 10);
+	}
+
+	CHECK(pool.GetPageCount() == 1);
+	CHECK(pool.GetFragmentation() == 0.f);
+
+	// 10짜리 빈 블록 다섯 개, 가장 큰 것이 전체의 1/5
+	for (uint32_t i = 0; i < 10; i += 2)
+	{
+		pool.Free(allocations[i]);
+	}
+
+	CHECK(pool.GetFreeBlockCount() == 5);
+	CHECK(pool.GetLargestFreeBlock() == 10);
+	CHECK(pool.GetFragmentation() > 0.79f && pool.GetFragmentation() < 0.81f);
+
+	// 한도 안에서만 옮김
+	std::vector<GeometryPool::Relocation> relocations;
+	pool.Defragment(10 * ELEMENT_STRIDE, relocations);
+
+	CHECK(relocations.size() == 1);
+	CHECK(pool.GetTotalRelocatedBytes() == 10 * ELEMENT_STRIDE);
+
+	relocations.clear();
+	pool.Defragment(PAGE_CAPACITY * ELEMENT_STRIDE, relocations);
+
+	CHECK(!relocations.empty());
+	CHECK(pool.GetFreeBlockCount() == 1);
+	CHECK(pool.GetLargestFreeBlock() == 50);
+	CHECK(pool.GetFragmentation() == 0.f);
+	CHECK(pool.Validate());
+
+	for (const GeometryPool::Relocation& relocation : relocations)
+	{
+		CHECK(relocation.page == 0);
+		CHECK(relocation.newOffset < relocation.oldOffset);
+	}
+}
+
+static void TestEmptyPageReleased()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+
+	const uint32_t baseBufferCount = GetBufferCount(device);
+
+	const uint32_t stride = ELEMENT_STRIDE;
+	GeometryPool pool(device, "Test", RHI::BIND_VERTEX_BUFFER, &stride, 1, PAGE_CAPACITY * ELEMENT_STRIDE);
+
+	const GeometryPool::Allocation first = AllocateFromPool(pool, 60);
+	const GeometryPool::Allocation second = AllocateFromPool(pool, 60);
+
+	// 기본 크기보다 큰 것은 딱 맞는 페이지를 따로 받음
+	const GeometryPool::Allocation large = AllocateFromPool(pool, 200);
+
+	CHECK(first.page == 0 && second.page == 1 && large.page == 2);
+	CHECK(pool.GetPageCount() == 3);
+	CHECK(GetBufferCount(device) == baseBufferCount + 3);
+	CHECK(pool.GetCapacity() == PAGE_CAPACITY * 2 + 200);
+
+	pool.Free(second);
+
+	CHECK(pool.GetPageCount() == 2);
+	CHECK(GetBufferCount(device) == baseBufferCount + 2);
+	CHECK(pool.GetCapacity() == PAGE_CAPACITY + 200);
+
+	// 비운 번호를 다시 쓰고 다른 할당의 페이지 번호는 그대로
+	const GeometryPool::Allocation reused = AllocateFromPool(pool, 50);
+
+	CHECK(reused.page == 1);
+	CHECK(pool.GetPageCount() == 3);
+	CHECK(pool.GetBuffer(large.page, 0).IsValid());
+
+	// 배치 중에는 제출 전 업로드가 있을 수 있어 EndBatch에서 해제
+	pool.BeginBatch();
+	pool.Free(large);
+
+	CHECK(pool.GetPageCount() == 3);
+
+	pool.EndBatch();
+
+	CHECK(pool.GetPageCount() == 2);
+	CHECK(GetBufferCount(device) == baseBufferCount + 2);
+
+	pool.Free(first);
+	pool.Free(reused);
+
+	CHECK(pool.GetPageCount() == 0);
+	CHECK(pool.GetCapacity() == 0);
+	CHECK(pool.GetFragmentation() == 0.f);
+	CHECK(GetBufferCount(device) == baseBufferCount);
+}
+
+int main()
+{
+	RUN_TEST(TestBestFit);
+	RUN_TEST(TestCoalesceOnFree);
+	RUN_TEST(TestRelocate);
+	RUN_TEST(TestFragmentationAndDefragment);
+	RUN_TEST(TestEmptyPageReleased);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
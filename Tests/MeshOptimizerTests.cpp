@@ -0,0 +1,159 @@
+#include "TestHelper.h"
+
+#include <cmath>
+#include <vector>
+
+#include "Resources/MeshOptimizer.h"
+
+// WeldVertices가 오차 안의 정점만 합치고 넓이가 없어진 삼각형을 버리는지 확인
+static const float TOLERANCE = 1e-3f;
+
+static Vertex::PosNormalUV MakeVertex(const float x, const float y, const float z)
+{
+	Vertex::PosNormalUV vertex;
+	vertex.pos = Vector3(x, y, z);
+	vertex.normal = Vector3(0.f, 0.f, 1.f);
+	vertex.uv = Vector2(0.f, 0.f);
+
+	return vertex;
+}
+
+// 변 하나를 나눠 쓰는 사각형, 두 번째 삼각형의 정점은 offset만큼 밀어서 따로 둠
+static void MakeSplitQuad(const float offset, std::vector<Vertex::PosNormalUV>& outVertices, std::vector<uint32_t>& outIndices)
+{
+	outVertices = {
+		MakeVertex(0.f, 0.f, 0.f),
+		MakeVertex(1.f, 0.f, 0.f),
+		MakeVertex(1.f, 1.f, 0.f),
+
+		MakeVertex(0.f + offset, 0.f, 0.f),
+		MakeVertex(1.f + offset, 1.f, 0.f),
+		MakeVertex(0.f, 1.f, 0.f)
+	};
+
+	outIndices = { 0, 1, 2, 3, 4, 5 };
+}
+
+static void TestWeldWithinTolerance()
+{
+	std::vector<Vertex::PosNormalUV> vertices;
+	std::vector<uint32_t> indices;
+
+	MakeSplitQuad(TOLERANCE * 0.5f, vertices, indices);
+
+	CHECK(WeldVertices(vertices, indices, TOLERANCE) == 0);
+	CHECK(vertices.size() == 4);
+	CHECK(indices.size() == 6);
+	CHECK(indices[3] == indices[0]);
+	CHECK(indices[4] == indices[2]);
+}
+
+static void TestWeldOutsideTolerance()
+{
+	std::vector<Vertex::PosNormalUV> vertices;
+	std::vector<uint32_t> indices;
+
+	MakeSplitQuad(TOLERANCE * 1.1f, vertices, indices);
+
+	CHECK(WeldVertices(vertices, indices, TOLERANCE) == 0);
+	CHECK(vertices.size() == 6);
+	CHECK(indices.size() == 6);
+
+	// 법선이나 UV만 달라도 따로 둠
+	vertices = { MakeVertex(0.f, 0.f, 0.f), MakeVertex(1.f, 0.f, 0.f), MakeVertex(0.f, 1.f, 0.f), MakeVertex(0.f, 0.f, 0.f) };
+	vertices[3].uv.x = TOLERANCE * 1.1f;
+	indices = { 0, 1, 2, 3, 1, 2 };
+
+	CHECK(WeldVertices(vertices, indices, TOLERANCE) == 0);
+	CHECK(vertices.size() == 4);
+}
+
+static void TestWeldDropsCollapsedTriangles()
+{
+	std::vector<Vertex::PosNormalUV> vertices = {
+		MakeVertex(0.f, 0.f, 0.f),
+		MakeVertex(1.f, 0.f, 0.f),
+		MakeVertex(0.f, 1.f, 0.f),
+
+		// 두 정점이 오차 안이라 합치면 선이 됨
+		MakeVertex(2.f, 0.f, 0.f),
+		MakeVertex(2.f + TOLERANCE * 0.5f, 0.f, 0.f),
+		MakeVertex(3.f, 1.f, 0.f)
+	};
+
+	std::vector<uint32_t> indices = { 0, 1, 2, 3, 4, 5 };
+
+	CHECK(WeldVertices(vertices, indices, TOLERANCE) == 1);
+	CHECK(indices.size() == 3);
+	CHECK(indices[0] == 0);
+	CHECK(indices[1] == 1);
+	CHECK(indices[2] == 2);
+}
+
+// 2^31 * tolerance보다 먼 좌표, 칸 번호가 int32를 넘던 경우
+static void TestWeldLargeCoordinates()
+{
+	enum
+	{
+		GRID_SIZE = 64
+	};
+
+	const float tolerance = 1e-5f;
+	const float origins[2] = { -1e6f, 1e6f };
+
+	std::vector<Vertex::PosNormalUV> vertices;
+	std::vector<uint32_t> indices;
+
+	// 사각형마다 정점을 따로 둔 격자 두 개, 같은 자리의 정점은 모두 합쳐져야 함
+	for (const float origin : origins)
+	{
+		for (uint32_t y = 0; y < GRID_SIZE; ++y)
+		{
+			for (uint32_t x = 0; x < GRID_SIZE; ++x)
+			{
+				const uint32_t base = static_cast<uint32_t>(vertices.size());
+				const float left = origin + static_cast<float>(x);
+				const float bottom = origin + static_cast<float>(y);
+
+				vertices.push_back(MakeVertex(left, bottom, origin));
+				vertices.push_back(MakeVertex(left + 1.f, bottom, origin));
+				vertices.push_back(MakeVertex(left + 1.f, bottom + 1.f, origin));
+				vertices.push_back(MakeVertex(left, bottom + 1.f, origin));
+
+				indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+			}
+		}
+	}
+
+	// float 한 칸 차이는 tolerance보다 커서 합치지 않음
+	const float nextOrigin = nextafterf(origins[1], 2e6f);
+
+	vertices.push_back(MakeVertex(nextOrigin, origins[1], origins[1]));
+	vertices.push_back(MakeVertex(origins[1] + 1.f, origins[1], origins[1]));
+	vertices.push_back(MakeVertex(origins[1], origins[1] + 1.f, origins[1]));
+
+	const uint32_t extra = static_cast<uint32_t>(vertices.size()) - 3;
+
+	indices.insert(indices.end(), { extra, extra + 1, extra + 2 });
+
+	const size_t indexCount = indices.size();
+
+	CHECK(WeldVertices(vertices, indices, tolerance) == 0);
+	CHECK(indices.size() == indexCount);
+	CHECK(vertices.size() == 2 * (GRID_SIZE + 1) * (GRID_SIZE + 1) + 1);
+
+	for (const uint32_t index : indices)
+	{
+		CHECK(index < vertices.size());
+	}
+}
+
+int main()
+{
+	RUN_TEST(TestWeldWithinTolerance);
+	RUN_TEST(TestWeldOutsideTolerance);
+	RUN_TEST(TestWeldDropsCollapsedTriangles);
+	RUN_TEST(TestWeldLargeCoordinates);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
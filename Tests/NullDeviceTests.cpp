@@ -0,0 +1,204 @@
+#include "TestHelper.h"
+
+#include <cstdint>
+
+#include "Renderer/RHI/NullDevice.h"
+
+enum
+{
+	BACK_BUFFER_WIDTH = 320,
+	BACK_BUFFER_HEIGHT = 180
+};
+
+struct DrawResources
+{
+	RHI::BufferHandle vertexBuffer;
+	RHI::BufferHandle indexBuffer;
+	RHI::BufferHandle constantBuffer;
+	RHI::VertexShaderHandle vertexShader;
+	RHI::PixelShaderHandle pixelShader;
+	RHI::InputLayoutHandle inputLayout;
+	RHI::RasterizerStateHandle rasterizerState;
+	RHI::DepthStencilStateHandle depthStencilState;
+};
+
+static DrawResources CreateDrawResources(RHI::Device& device)
+{
+	const float vertices[] = { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f };
+	const uint16_t indices[] = { 0, 1, 2, 2, 1, 3 };
+	const float constants[16] = {};
+	const uint8_t bytecode[] = { 'v', 's' };
+
+	DrawResources resources;
+
+	RHI::BufferDesc bufferDesc = {};
+	bufferDesc.usage = RHI::EUsage::IMMUTABLE;
+
+	bufferDesc.byteWidth = sizeof(vertices);
+	bufferDesc.bindFlags = RHI::BIND_VERTEX_BUFFER;
+	resources.vertexBuffer = device.CreateBuffer(bufferDesc, vertices);
+
+	bufferDesc.byteWidth = sizeof(indices);
+	bufferDesc.bindFlags = RHI::BIND_INDEX_BUFFER;
+	resources.indexBuffer = device.CreateBuffer(bufferDesc, indices);
+
+	bufferDesc.usage = RHI::EUsage::DEFAULT;
+	bufferDesc.byteWidth = sizeof(constants);
+	bufferDesc.bindFlags = RHI::BIND_CONSTANT_BUFFER;
+	resources.constantBuffer = device.CreateBuffer(bufferDesc, constants);
+
+	resources.vertexShader = device.CreateVertexShader(bytecode, sizeof(bytecode));
+	resources.pixelShader = device.CreatePixelShader(bytecode, sizeof(bytecode));
+
+	const RHI::InputElementDesc element = { "POSITION", 0, RHI::EFormat::R32G32B32_FLOAT, 0, 0 };
+	resources.inputLayout = device.CreateInputLayout(&element, 1, bytecode, sizeof(bytecode));
+
+	resources.rasterizerState = device.CreateRasterizerState({ RHI::EFillMode::SOLID, RHI::ECullMode::BACK, true });
+	resources.depthStencilState = device.CreateDepthStencilState({ true, true, RHI::EComparison::LESS_EQUAL });
+
+	return resources;
+}
+
+static void DestroyDrawResources(RHI::Device& device, const DrawResources& resources)
+{
+	device.DestroyDepthStencilState(resources.depthStencilState);
+	device.DestroyRasterizerState(resources.rasterizerState);
+	device.DestroyInputLayout(resources.inputLayout);
+	device.DestroyPixelShader(resources.pixelShader);
+	device.DestroyVertexShader(resources.vertexShader);
+	device.DestroyBuffer(resources.constantBuffer);
+	device.DestroyBuffer(resources.indexBuffer);
+	device.DestroyBuffer(resources.vertexBuffer);
+}
+
+// 지연 컨텍스트처럼 목록마다 상태를 모두 다시 설정
+static void RecordDraw(RHI::CommandList& commandList, const RHI::Device& device, const DrawResources& resources)
+{
+	const RHI::Viewport viewport = { 0.f, 0.f, static_cast<float>(BACK_BUFFER_WIDTH), static_cast<float>(BACK_BUFFER_HEIGHT), 0.f, 1.f };
+	const float constants[16] = { 1.f };
+
+	commandList.SetViewport(viewport);
+	commandList.SetRenderTarget(device.GetBackBuffer(), { 0 });
+	commandList.SetRasterizerState(resources.rasterizerState);
+	commandList.SetDepthStencilState(resources.depthStencilState);
+	commandList.SetInputLayout(resources.inputLayout);
+	commandList.SetPrimitiveTopology(RHI::EPrimitiveTopology::TRIANGLE_LIST);
+	commandList.SetVertexBuffer(0, resources.vertexBuffer, sizeof(float) * 3, 0);
+	commandList.SetIndexBuffer(resources.indexBuffer, RHI::EFormat::R16_UINT, 0);
+	commandList.SetVertexShader(resources.vertexShader);
+	commandList.SetPixelShader(resources.pixelShader);
+	commandList.UpdateBuffer(resources.constantBuffer, constants, sizeof(constants));
+	commandList.SetVSConstantBuffer(0, resources.constantBuffer);
+	commandList.DrawIndexed(6, 0, 0);
+}
+
+static void TestHeadlessFrame()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+
+	const DrawResources resources = CreateDrawResources(device);
+
+	// 렌더러처럼 지우는 목록 하나와 스레드별 드로우 목록을 순서대로 제출
+	RHI::CommandList clearList;
+	const float clearColor[4] = { 1.f, 1.f, 1.f, 1.f };
+	clearList.ClearRenderTarget(device.GetBackBuffer(), clearColor);
+
+	RHI::CommandList drawLists[2];
+	RecordDraw(drawLists[0], device, resources);
+	RecordDraw(drawLists[1], device, resources);
+
+	device.Submit(clearList);
+	device.Submit(drawLists, 2);
+	device.Present(false);
+
+	const RHI::NullDevice::WorkStats& workStats = device.GetWorkStats();
+	CHECK(workStats.presentCount == 1);
+	CHECK(workStats.drawCount == 2);
+	CHECK(workStats.triangleCount == 4);
+	CHECK(workStats.invalidCommandCount == 0);
+	CHECK(workStats.incompleteDrawCount == 0);
+
+	const RHI::FrameStats& frameStats = device.GetFrameStats();
+	CHECK(frameStats.submitCount == 3);
+	CHECK(frameStats.drawCount == 2);
+	CHECK(frameStats.indexCount == 12);
+	CHECK(frameStats.bufferUpdateCount == 2);
+	CHECK(frameStats.uploadBytes == 2 * sizeof(float) * 16);
+
+	const size_t commandCount = clearList.GetCommands().size() + drawLists[0].GetCommands().size() + drawLists[1].GetCommands().size();
+	CHECK(device.GetLastFrameCommands().size() == commandCount);
+	CHECK(device.GetLastFrameCommands().front().type == RHI::ECommandType::CLEAR_RENDER_TARGET);
+	CHECK(device.GetLastFrameCommands().back().type == RHI::ECommandType::DRAW_INDEXED);
+
+	DestroyDrawResources(device, resources);
+}
+
+static void TestResourceLifetime()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+
+	// 백 버퍼만 있음
+	CHECK(device.GetResourceStats().textureCount == 1);
+
+	const DrawResources resources = CreateDrawResources(device);
+
+	const RHI::ResourceStats stats = device.GetResourceStats();
+	CHECK(stats.bufferCount == 3);
+	CHECK(stats.shaderCount == 2);
+	CHECK(stats.stateCount == 2);
+
+	DestroyDrawResources(device, resources);
+
+	const RHI::ResourceStats emptyStats = device.GetResourceStats();
+	CHECK(emptyStats.bufferCount == 0);
+	CHECK(emptyStats.shaderCount == 0);
+	CHECK(emptyStats.stateCount == 0);
+
+	// 해제한 id는 다시 쓰고 0은 나오지 않음
+	RHI::BufferDesc bufferDesc = {};
+	bufferDesc.byteWidth = 16;
+	bufferDesc.bindFlags = RHI::BIND_CONSTANT_BUFFER;
+	bufferDesc.usage = RHI::EUsage::DEFAULT;
+
+	const RHI::BufferHandle buffer = device.CreateBuffer(bufferDesc, nullptr);
+	CHECK(buffer.IsValid());
+	CHECK(buffer.id <= 3);
+
+	device.DestroyBuffer(buffer);
+}
+
+static void TestResizeAndRecording()
+{
+	RHI::NullDevice device(BACK_BUFFER_WIDTH, BACK_BUFFER_HEIGHT);
+
+	CHECK(device.TryResizeBackBuffer(BACK_BUFFER_WIDTH * 2, BACK_BUFFER_HEIGHT * 2));
+
+	const RHI::TextureDesc desc = device.GetTextureDesc(device.GetBackBuffer());
+	CHECK(desc.width == BACK_BUFFER_WIDTH * 2);
+	CHECK(desc.height == BACK_BUFFER_HEIGHT * 2);
+	CHECK(device.GetResourceStats().textureCount == 1);
+
+	const DrawResources resources = CreateDrawResources(device);
+
+	RHI::CommandList commandList;
+	RecordDraw(commandList, device, resources);
+
+	// 기록을 끄면 검사만 하고 명령은 남기지 않음
+	device.SetRecording(false);
+	device.Submit(commandList);
+	device.Present(false);
+
+	CHECK(device.GetWorkStats().drawCount == 1);
+	CHECK(device.GetLastFrameCommands().empty());
+
+	DestroyDrawResources(device, resources);
+}
+
+int main()
+{
+	RUN_TEST(TestHeadlessFrame);
+	RUN_TEST(TestResourceLifetime);
+	RUN_TEST(TestResizeAndRecording);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
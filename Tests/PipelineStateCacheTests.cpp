@@ -0,0 +1,63 @@
+#include "TestHelper.h"
+
+#include "Renderer/PipelineStateCache.h"
+#include "Renderer/RHI/NullDevice.h"
+
+static void TestStateAndPipelineCounters()
+{
+	RHI::NullDevice device(64, 64);
+	PipelineStateCache cache(device);
+
+	const RHI::RasterizerDesc solid = { RHI::EFillMode::SOLID, RHI::ECullMode::BACK, true };
+	const RHI::RasterizerDesc wireframe = { RHI::EFillMode::WIREFRAME, RHI::ECullMode::NONE, true };
+	const RHI::SamplerDesc linear = { RHI::EFilter::LINEAR, RHI::EAddressMode::WRAP, 16.f };
+	const RHI::BlendDesc opaque = {};
+	const RHI::DepthStencilDesc depth = { true, true, RHI::EComparison::LESS_EQUAL };
+
+	PipelineStateCache::PipelineDesc desc;
+	desc.rasterizer = cache.GetRasterizerStateID(solid);
+	desc.sampler = cache.GetSamplerStateID(linear);
+	desc.blend = cache.GetBlendStateID(opaque);
+	desc.depthStencil = cache.GetDepthStencilStateID(depth);
+
+	// 같은 설명은 같은 ID
+	CHECK(cache.GetRasterizerStateID(solid) == desc.rasterizer);
+	CHECK(cache.GetRasterizerStateID(wireframe) != desc.rasterizer);
+
+	const PipelineStateCache::PipelineID pipeline = cache.GetPipelineID(desc);
+
+	CHECK(cache.GetPipelineID(desc) == pipeline);
+	CHECK(cache.GetPipelineID(desc) == pipeline);
+
+	PipelineStateCache::PipelineDesc wireframeDesc = desc;
+	wireframeDesc.rasterizer = cache.GetRasterizerStateID(wireframe);
+
+	CHECK(cache.GetPipelineID(wireframeDesc) != pipeline);
+
+	// 상태 요청 7번(새로 만든 것 5개), 파이프라인 요청 4번(새로 만든 것 2개)
+	const PipelineStateCache::Stats& stats = cache.GetStats();
+
+	CHECK(stats.rasterizerCount == 2);
+	CHECK(stats.pipelineCount == 2);
+	CHECK(stats.stateRequestCount == 7);
+	CHECK(stats.stateHitCount == 2);
+	CHECK(stats.pipelineRequestCount == 4);
+	CHECK(stats.pipelineHitCount == 2);
+
+	const PipelineStateCache::PipelineState& state = cache.GetPipelineState(pipeline);
+
+	CHECK(state.rasterizer == cache.GetRasterizerState(desc.rasterizer));
+	CHECK(state.depthStencil == cache.GetDepthStencilState(desc.depthStencil));
+
+	cache.Clear();
+
+	CHECK(cache.GetStats().stateRequestCount == 0);
+	CHECK(cache.GetStats().pipelineRequestCount == 0);
+}
+
+int main()
+{
+	RUN_TEST(TestStateAndPipelineCounters);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "TestHelper.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "Resources/ShaderCache.h"
+
+static const char* const TEST_DIRECTORY = "ShaderCacheTestFiles";
+static const char* const SHADER_PATH = "ShaderCacheTestFiles/VSTest.hlsl";
+static const char* const INCLUDE_PATH = "ShaderCacheTestFiles/Common.hlsli";
+static const char* const ARCHIVE_PATH = "ShaderCacheTestFiles/Shaders.cache";
+
+static const char* const SHADER_SOURCE = "#include \"Common.hlsli\"\nfloat4 main(float3 p : POSITION) : SV_POSITION { return Transform(p); }\n";
+static const char* const INCLUDE_SOURCE = "float4 Transform(float3 p) { return float4(p, 1.f); }\n";
+
+static void WriteTextFile(const char* const path, const char* const text)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file << text;
+}
+
+static void ResetTestFiles()
+{
+	std::filesystem::remove_all(TEST_DIRECTORY);
+	std::filesystem::create_directories(TEST_DIRECTORY);
+
+	WriteTextFile(SHADER_PATH, SHADER_SOURCE);
+	WriteTextFile(INCLUDE_PATH, INCLUDE_SOURCE);
+}
+
+// 컴파일러 대신 호출 수만 세고 진입점 이름을 바이트코드로 돌려줌
+static ShaderCache::CompileFunction MakeFakeCompile(uint32_t& compileCount)
+{
+	return [&compileCount](const ShaderCache::Request& request, std::vector<uint8_t>& outBytecode)
+		{
+			++compileCount;
+
+			const std::string entryPoint = request.entryPoint;
+			outBytecode.assign(entryPoint.begin(), entryPoint.end());
+
+			return true;
+		};
+}
+
+static ShaderCache::Request MakeRequest(const RHI::ShaderDefine* const pDefines, const uint32_t defineCount)
+{
+	return { SHADER_PATH, "main", "vs_5_0", pDefines, defineCount };
+}
+
+static uint64_t ComputeKey(ShaderCache& cache, const ShaderCache::Request& request)
+{
+	uint64_t key = 0;
+
+	// 파일 내용을 다시 읽도록 매번 비움
+	cache.InvalidateFileHashes();
+	CHECK(cache.TryComputeKey(request, key));
+
+	return key;
+}
+
+static void TestKeyTracksSourceAndInclude()
+{
+	ResetTestFiles();
+
+	uint32_t compileCount = 0;
+	ShaderCache cache(ARCHIVE_PATH, "test", MakeFakeCompile(compileCount));
+
+	const ShaderCache::Request request = MakeRequest(nullptr, 0);
+	const uint64_t baseKey = ComputeKey(cache, request);
+
+	CHECK(ComputeKey(cache, request) == baseKey);
+
+	// 소스 수정
+	WriteTextFile(SHADER_PATH, "#include \"Common.hlsli\"\nfloat4 main(float3 p : POSITION) : SV_POSITION { return Transform(p * 2.f); }\n");
+	const uint64_t editedKey = ComputeKey(cache, request);
+
+	CHECK(editedKey != baseKey);
+
+	// 되돌리면 내용 기준이라 같은 키
+	WriteTextFile(SHADER_PATH, SHADER_SOURCE);
+	CHECK(ComputeKey(cache, request) == baseKey);
+
+	// include 파일만 수정
+	WriteTextFile(INCLUDE_PATH, "float4 Transform(float3 p) { return float4(p, 0.5f); }\n");
+	const uint64_t includeEditedKey = ComputeKey(cache, request);
+
+	CHECK(includeEditedKey != baseKey);
+	CHECK(includeEditedKey != editedKey);
+
+	CHECK(cache.DependsOn(SHADER_PATH, INCLUDE_PATH));
+	CHECK(!cache.DependsOn(INCLUDE_PATH, SHADER_PATH));
+
+	// include가 사라지면 키를 만들 수 없음
+	std::filesystem::remove(INCLUDE_PATH);
+
+	uint64_t key;
+	cache.InvalidateFileHashes();
+	CHECK(!cache.TryComputeKey(request, key));
+
+	CHECK(compileCount == 0);
+}
+
+static void TestKeyTracksDefines()
+{
+	ResetTestFiles();
+
+	uint32_t compileCount = 0;
+	ShaderCache cache(ARCHIVE_PATH, "test", MakeFakeCompile(compileCount));
+
+	const RHI::ShaderDefine defines[] = { { "USE_NORMAL_MAP", "1" }, { "LIGHT_COUNT", "4" } };
+	const RHI::ShaderDefine otherValue[] = { { "USE_NORMAL_MAP", "1" }, { "LIGHT_COUNT", "8" } };
+	const RHI::ShaderDefine otherOrder[] = { { "LIGHT_COUNT", "4" }, { "USE_NORMAL_MAP", "1" } };
+
+	const uint64_t noDefineKey = ComputeKey(cache, MakeRequest(nullptr, 0));
+	const uint64_t defineKey = ComputeKey(cache, MakeRequest(defines, 2));
+
+	CHECK(defineKey != noDefineKey);
+	CHECK(ComputeKey(cache, MakeRequest(defines, 2)) == defineKey);
+	CHECK(ComputeKey(cache, MakeRequest(defines, 1)) != defineKey);
+	CHECK(ComputeKey(cache, MakeRequest(otherValue, 2)) != defineKey);
+	CHECK(ComputeKey(cache, MakeRequest(otherOrder, 2)) != defineKey);
+
+	ShaderCache::Request otherEntry = MakeRequest(defines, 2);
+	otherEntry.entryPoint = "mainDepth";
+
+	CHECK(ComputeKey(cache, otherEntry) != defineKey);
+
+	// 솔트가 다르면 같은 요청도 다른 키
+	ShaderCache otherSaltCache(ARCHIVE_PATH, "other", MakeFakeCompile(compileCount));
+	CHECK(ComputeKey(otherSaltCache, MakeRequest(defines, 2)) != defineKey);
+}
+
+static void TestArchiveRoundTrip()
+{
+	ResetTestFiles();
+
+	const ShaderCache::Request request = MakeRequest(nullptr, 0);
+
+	const uint8_t* pBytecode = nullptr;
+	size_t byteSize = 0;
+
+	uint32_t compileCount = 0;
+
+	{
+		ShaderCache cache(ARCHIVE_PATH, "test", MakeFakeCompile(compileCount));
+
+		CHECK(cache.TryGetBytecode(request, pBytecode, byteSize));
+		CHECK(cache.TryGetBytecode(request, pBytecode, byteSize));
+		CHECK(compileCount == 1);
+		CHECK(byteSize == 4 && memcmp(pBytecode, "main", 4) == 0);
+
+		CHECK(cache.Save());
+		CHECK(cache.GetStats().entryCount == 1);
+	}
+
+	// 다시 열면 컴파일 없이 매핑된 아카이브에서 읽음
+	{
+		ShaderCache cache(ARCHIVE_PATH, "test", MakeFakeCompile(compileCount));
+
+		CHECK(cache.GetStats().entryCount == 1);
+		CHECK(cache.TryGetBytecode(request, pBytecode, byteSize));
+		CHECK(compileCount == 1);
+		CHECK(cache.GetStats().hitCount == 1);
+		CHECK(byteSize == 4 && memcmp(pBytecode, "main", 4) == 0);
+
+		// include가 바뀌면 아카이브에 있어도 다시 컴파일
+		WriteTextFile(INCLUDE_PATH, "float4 Transform(float3 p) { return float4(p, 0.5f); }\n");
+		cache.InvalidateFileHashes();
+
+		CHECK(cache.TryGetBytecode(request, pBytecode, byteSize));
+		CHECK(compileCount == 2);
+	}
+}
+
+int main()
+{
+	RUN_TEST(TestKeyTracksSourceAndInclude);
+	RUN_TEST(TestKeyTracksDefines);
+	RUN_TEST(TestArchiveRoundTrip);
+
+	std::filesystem::remove_all(TEST_DIRECTORY);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdio>
+
+// 실패해도 멈추지 않고 위치만 출력, main은 TEST_RESULT()로 실패 수를 돌려줌
+// 엔진의 ASSERT는 _DEBUG에서 그대로 멈추므로 잘못된 사용은 테스트하지 않음
+static int sTestFailCount = 0;
+
+#define CHECK(expr)                                                     \
+    if (!(expr))                                                        \
+    {                                                                   \
+        std::fprintf(stderr, "%s %d\n: CHECK(%s)\n", __FILE__, __LINE__, #expr); \
+        ++sTestFailCount;                                               \
+    }                                                                   \
+
+#define RUN_TEST(func)                        \
+    {                                         \
+        const int failCount = sTestFailCount; \
+        func();                               \
+        std::printf("%s %s\n", sTestFailCount == failCount ? "[PASS]" : "[FAIL]", #func); \
+    }                                         \
+
+#define TEST_RESULT() (sTestFailCount == 0 ? 0 : 1)
\ No newline at end of file
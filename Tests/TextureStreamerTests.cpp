@@ -0,0 +1,196 @@
+#include "TestHelper.h"
+
+#include <vector>
+
+#include "Resources/TextureStreamer.h"
+
+// 스트리머는 디바이스를 모르므로 불러오기 완료는 CompleteLoad로 흉내냄
+enum
+{
+	TEXTURE_SIZE = 1024,
+	TEXTURE_MIP_COUNT = 11,
+
+	MAX_PENDING_COUNT = 4
+};
+
+static uint64_t GetTextureBytes(const uint32_t topMip)
+{
+	return TextureStreamer::GetMipChainBytes(TEXTURE_SIZE, TEXTURE_SIZE, TEXTURE_MIP_COUNT, RHI::EFormat::R8G8B8A8_UNORM, topMip);
+}
+
+static uint32_t RegisterTexture(TextureStreamer& streamer)
+{
+	return streamer.Register(TEXTURE_SIZE, TEXTURE_SIZE, TEXTURE_MIP_COUNT, RHI::EFormat::R8G8B8A8_UNORM);
+}
+
+static void TestBaseMipSize()
+{
+	const uint32_t sizes[][3] =
+	{
+		{ 1024, 1024, 11 },
+		{ 2048, 512, 12 },
+		{ 300, 200, 9 },
+		{ 64, 64, 7 },
+		{ 16, 16, 5 },
+		{ 4096, 4096, 13 }
+	};
+
+	for (const uint32_t* const size : sizes)
+	{
+		const uint32_t baseMip = TextureStreamer::ComputeBaseMip(size[0], size[1], size[2]);
+		const uint32_t maxSize = size[0] > size[1] ? size[0] : size[1];
+
+		// 기본 밉은 64 이하, 그 바로 위 밉은 64보다 큼
+		CHECK((maxSize >> baseMip) <= TextureStreamer::BASE_MIP_SIZE);
+		CHECK(baseMip == 0 || (maxSize >> (baseMip - 1)) > TextureStreamer::BASE_MIP_SIZE);
+	}
+
+	// 밉이 모자라면 가장 작은 밉이 기본
+	CHECK(TextureStreamer::ComputeBaseMip(1024, 1024, 3) == 2);
+
+	TextureStreamer streamer(0, MAX_PENDING_COUNT);
+
+	const uint32_t textureID = RegisterTexture(streamer);
+	const uint32_t baseMip = streamer.GetBaseMip(textureID);
+
+	CHECK(baseMip == 4);
+	CHECK(streamer.GetResidentMip(textureID) == baseMip);
+
+	// 예산이 0이어도 기본 밉은 상주
+	CHECK(streamer.GetStats().residentBytes == GetTextureBytes(baseMip));
+}
+
+static void TestBudgetEnforcement()
+{
+	const uint64_t baseBytes = GetTextureBytes(4);
+	const uint64_t fullExtraBytes = GetTextureBytes(0) - baseBytes;
+
+	// 하나는 전부, 나머지 하나는 절반만 더 올릴 수 있는 예산
+	const uint64_t budgetBytes = baseBytes * 2 + fullExtraBytes + fullExtraBytes / 2;
+
+	TextureStreamer streamer(budgetBytes, MAX_PENDING_COUNT);
+
+	const uint32_t nearID = RegisterTexture(streamer);
+	const uint32_t farID = RegisterTexture(streamer);
+
+	std::vector<TextureStreamer::Request> loads;
+	std::vector<TextureStreamer::Request> evictions;
+
+	streamer.RequestScreenSize(nearID, 1024.f, 1);
+	streamer.RequestScreenSize(farID, 900.f, 1);
+	streamer.Update(1, loads, evictions);
+
+	CHECK(streamer.GetWantedMip(nearID) == 0);
+	CHECK(streamer.GetWantedMip(farID) == 0);
+
+	// 화면에서 큰 것이 먼저 전부 받고 나머지는 들어가는 밉까지만
+	CHECK(loads.size() == 2);
+	CHECK(evictions.empty());
+
+	if (loads.size() == 2)
+	{
+		CHECK(loads[0].textureID == nearID && loads[0].topMip == 0);
+		CHECK(loads[1].textureID == farID && loads[1].topMip == 1);
+	}
+
+	CHECK(streamer.GetStats().committedBytes <= budgetBytes);
+	CHECK(streamer.GetStats().pendingCount == 2);
+
+	streamer.CompleteLoad(nearID, true);
+	streamer.CompleteLoad(farID, true);
+
+	CHECK(streamer.GetResidentMip(nearID) == 0);
+	CHECK(streamer.GetResidentMip(farID) == 1);
+	CHECK(streamer.GetStats().residentBytes == streamer.GetStats().committedBytes);
+
+	// 예산을 줄이면 다음 Update에서 기본 밉까지 내림
+	streamer.SetBudgetBytes(baseBytes * 2);
+	streamer.Update(2, loads, evictions);
+
+	CHECK(loads.empty());
+	CHECK(evictions.size() == 2);
+	CHECK(streamer.GetResidentMip(nearID) == 4);
+	CHECK(streamer.GetResidentMip(farID) == 4);
+	CHECK(streamer.GetStats().committedBytes == baseBytes * 2);
+
+	// 실패한 불러오기는 예약한 바이트를 돌려줌
+	streamer.SetBudgetBytes(budgetBytes);
+	streamer.RequestScreenSize(nearID, 1024.f, 3);
+	streamer.Update(3, loads, evictions);
+
+	CHECK(streamer.IsPending(nearID));
+
+	streamer.CompleteLoad(nearID, false);
+
+	CHECK(!streamer.IsPending(nearID));
+	CHECK(streamer.GetResidentMip(nearID) == 4);
+	CHECK(streamer.GetStats().committedBytes == baseBytes * 2);
+}
+
+static void TestLRUEvictionOrder()
+{
+	const uint64_t baseBytes = GetTextureBytes(4);
+	const uint64_t fullExtraBytes = GetTextureBytes(0) - baseBytes;
+
+	// 세 개 중 두 개만 전부 올릴 수 있는 예산
+	TextureStreamer streamer(baseBytes * 3 + fullExtraBytes * 2, MAX_PENDING_COUNT);
+
+	const uint32_t textureIDs[] = { RegisterTexture(streamer), RegisterTexture(streamer), RegisterTexture(streamer) };
+
+	std::vector<TextureStreamer::Request> loads;
+	std::vector<TextureStreamer::Request> evictions;
+
+	// 0은 1프레임, 1은 2프레임에 마지막으로 보임
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		const uint64_t frame = i + 1;
+
+		streamer.RequestScreenSize(textureIDs[i], 1024.f, frame);
+		streamer.Update(frame, loads, evictions);
+
+		CHECK(loads.size() == 1);
+		CHECK(evictions.empty());
+
+		streamer.CompleteLoad(textureIDs[i], true);
+	}
+
+	// 2를 올리려면 하나를 내려야 하고 가장 오래 안 보인 0이 대상
+	streamer.RequestScreenSize(textureIDs[2], 1024.f, 10);
+	streamer.Update(10, loads, evictions);
+
+	CHECK(evictions.size() == 1);
+	CHECK(loads.size() == 1);
+
+	if (evictions.size() == 1 && loads.size() == 1)
+	{
+		CHECK(evictions[0].textureID == textureIDs[0]);
+		CHECK(evictions[0].topMip == 4);
+		CHECK(loads[0].textureID == textureIDs[2] && loads[0].topMip == 0);
+	}
+
+	CHECK(streamer.GetResidentMip(textureIDs[0]) == 4);
+	CHECK(streamer.GetResidentMip(textureIDs[1]) == 0);
+
+	streamer.CompleteLoad(textureIDs[2], true);
+
+	// 1과 2가 같은 프레임에 보이면 둘 다 내릴 수 없어서 0은 미뤄짐
+	const uint32_t deferredCount = streamer.GetStats().deferredCount;
+
+	streamer.RequestScreenSize(textureIDs[0], 1024.f, 11);
+	streamer.RequestScreenSize(textureIDs[1], 1024.f, 11);
+	streamer.RequestScreenSize(textureIDs[2], 1024.f, 11);
+	streamer.Update(11, loads, evictions);
+
+	CHECK(evictions.empty());
+	CHECK(streamer.GetStats().deferredCount == deferredCount + 1);
+	CHECK(streamer.GetStats().committedBytes <= streamer.GetStats().budgetBytes);
+}
+
+int main()
+{
+	RUN_TEST(TestBaseMipSize);
+	RUN_TEST(TestBudgetEnforcement);
+	RUN_TEST(TestLRUEvictionOrder);
+
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "TestHelper.h"
+
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "Resources/VertexQuantizer.h"
+
+// 알려진 메쉬를 줄였다 되돌려서 오차가 형식에서 나오는 이론 상한 안인지 확인
+// 정점마다 double로 다시 재서 MeasureQuantizationError의 float 반올림과 섞이지 않게 함
+enum
+{
+	RING_COUNT = 48,
+	SEGMENT_COUNT = 96
+};
+
+static const double UNORM16_MAX = 65535.0;
+static const double SNORM16_MAX = 32767.0;
+
+// 위치 한 축은 UNORM16 한 칸의 절반, 거리로는 범위 대각선의 0.5 / 65535
+static const double POSITION_ERROR_BOUND = 0.5 / UNORM16_MAX;
+
+// 8면체 좌표는 네 격자점 중 가장 가까운 것을 고르므로 격자 간격의 sqrt(2) / 2 안
+// 복원은 (x, y, 1 - |x| - |y|)의 기울기가 sqrt(3), 길이가 1 / sqrt(3) 이상이라 각도로는 3배
+static const double NORMAL_ERROR_BOUND_RADIANS = 3.0 * (std::sqrt(2.0) * 0.5) / SNORM16_MAX;
+
+// [0, 1]의 half는 가수 10비트, 가장 가까운 값으로 반올림
+static const double UV_ERROR_BOUND = 1.0 / 4096.0;
+
+// 타원체, 중심을 원점에서 떨어뜨려 오프셋 복원도 확인함
+static void MakeEllipsoid(const Vector3& center, const Vector3& radii, const float uvRepeat, std::vector<Vertex::PosNormalUV>& outVertices)
+{
+	constexpr float PI = 3.14159265f;
+
+	outVertices.clear();
+
+	for (uint32_t ring = 0; ring <= RING_COUNT; ++ring)
+	{
+		const float v = static_cast<float>(ring) / static_cast<float>(RING_COUNT);
+		const float theta = v * PI;
+
+		for (uint32_t segment = 0; segment <= SEGMENT_COUNT; ++segment)
+		{
+			const float u = static_cast<float>(segment) / static_cast<float>(SEGMENT_COUNT);
+			const float phi = u * 2.f * PI;
+
+			const Vector3 unit(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+
+			Vertex::PosNormalUV vertex;
+			vertex.pos = unit * radii + center;
+			vertex.normal = Vector3(unit.x / radii.x, unit.y / radii.y, unit.z / radii.z);
+			vertex.normal.Normalize();
+			vertex.uv = Vector2(u * uvRepeat, v * uvRepeat);
+
+			outVertices.push_back(vertex);
+		}
+	}
+}
+
+static void ComputeBounds(const std::vector<Vertex::PosNormalUV>& vertices, Vector3& outMin, Vector3& outMax)
+{
+	outMin = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+	outMax = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (const Vertex::PosNormalUV& vertex : vertices)
+	{
+		outMin = Vector3(fminf(outMin.x, vertex.pos.x), fminf(outMin.y, vertex.pos.y), fminf(outMin.z, vertex.pos.z));
+		outMax = Vector3(fmaxf(outMax.x, vertex.pos.x), fmaxf(outMax.y, vertex.pos.y), fmaxf(outMax.z, vertex.pos.z));
+	}
+}
+
+static double GetAngleRadians(const Vector3& lhs, const Vector3& rhs)
+{
+	const double crossX = static_cast<double>(lhs.y) * rhs.z - static_cast<double>(lhs.z) * rhs.y;
+	const double crossY = static_cast<double>(lhs.z) * rhs.x - static_cast<double>(lhs.x) * rhs.z;
+	const double crossZ = static_cast<double>(lhs.x) * rhs.y - static_cast<double>(lhs.y) * rhs.x;
+	const double dot = static_cast<double>(lhs.x) * rhs.x + static_cast<double>(lhs.y) * rhs.y + static_cast<double>(lhs.z) * rhs.z;
+
+	return std::atan2(std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot);
+}
+
+static void TestErrorWithinBound()
+{
+	std::vector<Vertex::PosNormalUV> vertices;
+	MakeEllipsoid(Vector3(10.f, -3.f, 5.f), Vector3(3.f, 1.f, 0.5f), 1.f, vertices);
+
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+	ComputeBounds(vertices, boundsMin, boundsMax);
+
+	std::vector<Vertex::PosNormalUVQuantized> quantizedVertices;
+	Vector3 offset;
+	Vector3 scale;
+	QuantizeVertices(vertices, boundsMin, boundsMax, quantizedVertices, offset, scale);
+
+	CHECK(quantizedVertices.size() == vertices.size());
+
+	const double diagonal = scale.Length();
+
+	// 좌표 크기만큼의 float 반올림은 상한에 더해 둠
+	const double positionSlack = 4.0 * FLT_EPSILON * 13.0 / diagonal;
+	const double floatSlackRadians = 1e-5;
+
+	double maxPositionError = 0.0;
+	double maxNormalError = 0.0;
+	double maxUVError = 0.0;
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex::PosNormalUV& source = vertices[i];
+		const Vertex::PosNormalUV decoded = DequantizeVertex(quantizedVertices[i], offset, scale);
+
+		const double positionError = static_cast<double>(Vector3::Distance(source.pos, decoded.pos)) / diagonal;
+		const double normalError = GetAngleRadians(source.normal, decoded.normal);
+		const double uvError = std::fmax(std::fabs(source.uv.x - decoded.uv.x), std::fabs(source.uv.y - decoded.uv.y));
+
+		maxPositionError = std::fmax(maxPositionError, positionError);
+		maxNormalError = std::fmax(maxNormalError, normalError);
+		maxUVError = std::fmax(maxUVError, uvError);
+	}
+
+	CHECK(maxPositionError <= POSITION_ERROR_BOUND + positionSlack);
+	CHECK(maxNormalError <= NORMAL_ERROR_BOUND_RADIANS + floatSlackRadians);
+	CHECK(maxUVError <= UV_ERROR_BOUND);
+
+	// 상한이 느슨하지 않은지, 실제로 줄어든 값인지
+	CHECK(maxPositionError > POSITION_ERROR_BOUND * 0.25);
+	CHECK(maxNormalError > 0.0);
+
+	// 에디터가 쓰는 측정도 같은 결과로 받아들여야 함
+	VertexQuantizationError error;
+	MeasureQuantizationError(vertices, quantizedVertices, offset, scale, error);
+
+	CHECK(error.maxPositionError <= POSITION_ERROR_BOUND + positionSlack);
+	CHECK(error.maxUVError <= UV_ERROR_BOUND);
+	CHECK(IsQuantizationErrorAcceptable(error));
+}
+
+static void TestFlatAxis()
+{
+	// 두께가 없는 축은 오프셋만으로 정확히 되돌아옴
+	std::vector<Vertex::PosNormalUV> vertices;
+	MakeEllipsoid(Vector3(1.f, 2.f, 3.f), Vector3(4.f, 0.f, 4.f), 1.f, vertices);
+
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+	ComputeBounds(vertices, boundsMin, boundsMax);
+
+	std::vector<Vertex::PosNormalUVQuantized> quantizedVertices;
+	Vector3 offset;
+	Vector3 scale;
+	QuantizeVertices(vertices, boundsMin, boundsMax, quantizedVertices, offset, scale);
+
+	CHECK(scale.y == 0.f);
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		CHECK(quantizedVertices[i].pos[1] == 0);
+		CHECK(DequantizeVertex(quantizedVertices[i], offset, scale).pos.y == 2.f);
+	}
+}
+
+static void TestRepeatedUVRejected()
+{
+	// [4, 8)의 half 간격은 1/256이라 2048 텍스처의 한 텍셀을 넘음
+	std::vector<Vertex::PosNormalUV> vertices;
+	MakeEllipsoid(Vector3(0.f, 0.f, 0.f), Vector3(1.f, 1.f, 1.f), 7.f, vertices);
+
+	Vector3 boundsMin;
+	Vector3 boundsMax;
+	ComputeBounds(vertices, boundsMin, boundsMax);
+
+	std::vector<Vertex::PosNormalUVQuantized> quantizedVertices;
+	Vector3 offset;
+	Vector3 scale;
+	QuantizeVertices(vertices, boundsMin, boundsMax, quantizedVertices, offset, scale);
+
+	VertexQuantizationError error;
+	MeasureQuantizationError(vertices, quantizedVertices, offset, scale, error);
+
+	CHECK(error.maxUVError <= 7.0 / 2048.0);
+	CHECK(!IsQuantizationErrorAcceptable(error));
+}
+
+int main()
+{
+	RUN_TEST(TestErrorWithinBound);
+	RUN_TEST(TestFlatAxis);
+	RUN_TEST(TestRepeatedUVRejected);
+
+	return TEST_RESULT();
+}
\ No newline at end of file